@@ -707,6 +707,7 @@ LOCAL_CFLAGS_x86 += \
 	-mfpmath=sse
 
 LOCAL_SRC_FILES_x86 += \
+	src/opts/SkBlitRow_opts_AVX2.cpp \
 	src/opts/SkBitmapFilter_opts_SSE2.cpp \
 	src/opts/SkBitmapProcState_opts_SSE2.cpp \
 	src/opts/SkBlitRow_opts_SSE2.cpp \
@@ -721,6 +722,7 @@ LOCAL_SRC_FILES_x86 += \
 	src/opts/SkBlitRow_opts_SSE4.cpp
 
 LOCAL_SRC_FILES_x86_64 += \
+	src/opts/SkBlitRow_opts_AVX2.cpp \
 	src/opts/SkBitmapFilter_opts_SSE2.cpp \
 	src/opts/SkBitmapProcState_opts_SSE2.cpp \
 	src/opts/SkBlitRow_opts_SSE2.cpp \
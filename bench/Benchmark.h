@@ -65,6 +65,12 @@ public:
         return backend != kNonRendering_Backend;
     }
 
+    // Call to determine whether --trackAllocs should count this benchmark's
+    // heap traffic.  Override to return false in benches whose measured
+    // operation allocates by design, so their rows don't bury regressions
+    // in code that shouldn't allocate at all.
+    virtual bool shouldCountAllocs() const { return true; }
+
     // Call before draw, allows the benchmark to do setup work outside of the
     // timer. When a benchmark is repeatedly drawn, this should be called once
     // before the initial draw.
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "CodecIOBench.h"
+#include "SkBitmap.h"
+#include "SkCodec.h"
+#include "SkImageGenerator.h"
+#include "SkOSFile.h"
+#include "SkStream.h"
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Ask the kernel to forget the file's cached pages, so the next read pays
+// the real I/O cost.  Only clean pages are dropped, which is all a read-only
+// file has.  A no-op on platforms without an explicit drop hint.
+static void drop_page_cache(const char path[]) {
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        (void) posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+CodecIOBench::CodecIOBench(SkString baseName, const SkString& path, Mode mode,
+                           Phase phase, int sampleSize)
+    : fPath(path)
+    , fMode(mode)
+    , fPhase(phase)
+    , fSampleSize(sampleSize)
+    , fData(SkData::NewFromFileName(path.c_str()))
+{
+    const char* modeName = "";
+    switch (mode) {
+        case kMemory_Mode:
+            modeName = "mem";
+            break;
+        case kFile_Mode:
+            modeName = "file";
+            break;
+        case kColdFile_Mode:
+            modeName = "cold";
+            break;
+    }
+    const char* phaseName = kHeader_Phase == phase ? "header" : "full";
+    fName.printf("CodecIO_%s_%s_s%d_%s", modeName, phaseName, sampleSize,
+                 baseName.c_str());
+#ifdef SK_DEBUG
+    // Ensure that we can create an SkCodec from this data.
+    SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(fData));
+    SkASSERT(codec);
+#endif
+}
+
+const char* CodecIOBench::onGetName() {
+    return fName.c_str();
+}
+
+bool CodecIOBench::isSuitableFor(Backend backend) {
+    return kNonRendering_Backend == backend;
+}
+
+SkCodec* CodecIOBench::createCodec() {
+    switch (fMode) {
+        case kMemory_Mode:
+            return SkCodec::NewFromData(fData);
+        case kColdFile_Mode:
+            drop_page_cache(fPath.c_str());
+            // Fall through: the decode itself reads through a file stream.
+        case kFile_Mode:
+            return SkCodec::NewFromStream(SkNEW_ARGS(SkFILEStream, (fPath.c_str())));
+    }
+    return NULL;
+}
+
+void CodecIOBench::onPreDraw() {
+    SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(fData));
+
+    const SkISize scaledSize = codec->getScaledDimensions(1.0f / fSampleSize);
+    fInfo = codec->getInfo().makeWH(scaledSize.width(), scaledSize.height())
+                            .makeColorType(kN32_SkColorType);
+    SkAlphaType alphaType;
+    SkAssertResult(SkColorTypeValidateAlphaType(kN32_SkColorType, fInfo.alphaType(),
+                                                &alphaType));
+    if (alphaType != fInfo.alphaType()) {
+        fInfo = fInfo.makeAlphaType(alphaType);
+    }
+
+    if (kFullDecode_Phase == fPhase) {
+        fPixelStorage.reset(fInfo.getSafeSize(fInfo.minRowBytes()));
+    }
+}
+
+void CodecIOBench::onDraw(const int n, SkCanvas* canvas) {
+    SkAutoTDelete<SkCodec> codec;
+    SkPMColor colorTable[256];
+    int colorCount;
+    for (int i = 0; i < n; i++) {
+        codec.reset(this->createCodec());
+        SkASSERT(codec);
+        if (kHeader_Phase == fPhase) {
+            // Timing stream setup and header parsing only.
+            continue;
+        }
+        colorCount = 256;
+#ifdef SK_DEBUG
+        const SkImageGenerator::Result result =
+#endif
+        codec->getPixels(fInfo, fPixelStorage.get(), fInfo.minRowBytes(),
+                         NULL, colorTable, &colorCount);
+        SkASSERT(result == SkImageGenerator::kSuccess
+                 || result == SkImageGenerator::kIncompleteInput);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef CodecIOBench_DEFINED
+#define CodecIOBench_DEFINED
+
+#include "Benchmark.h"
+#include "SkData.h"
+#include "SkImageInfo.h"
+#include "SkRefCnt.h"
+#include "SkString.h"
+
+class SkCodec;
+
+/**
+ *  Time SkCodec including its I/O behavior.  CodecBench decodes from memory
+ *  only, which hides the stream and readahead costs that dominate cold
+ *  production loads.  This bench adds file-backed stream modes (optionally
+ *  dropping the page cache before each decode), a header-parse-only phase so
+ *  the row-decode cost can be separated out, and sampled-size decodes.
+ */
+class CodecIOBench : public Benchmark {
+public:
+    enum Mode {
+        // Decode from memory-mapped SkData, like CodecBench.
+        kMemory_Mode,
+        // Decode through a buffered SkFILEStream.
+        kFile_Mode,
+        // As kFile_Mode, but hint the kernel to drop the file's page cache
+        // before each decode, so every iteration pays the cold I/O cost.
+        // Where no drop hint is available this behaves like kFile_Mode.
+        kColdFile_Mode,
+    };
+
+    enum Phase {
+        // Create the codec only, timing stream setup and header parsing.
+        kHeader_Phase,
+        // Create the codec and decode all rows.
+        kFullDecode_Phase,
+    };
+
+    CodecIOBench(SkString baseName, const SkString& path, Mode, Phase, int sampleSize);
+
+protected:
+    const char* onGetName() override;
+    bool isSuitableFor(Backend backend) override;
+    void onDraw(const int n, SkCanvas* canvas) override;
+    void onPreDraw() override;
+
+private:
+    SkCodec* createCodec();
+
+    SkString                fName;
+    const SkString          fPath;
+    const Mode              fMode;
+    const Phase             fPhase;
+    const int               fSampleSize;
+    SkAutoTUnref<SkData>    fData;          // Used by kMemory_Mode.
+    SkImageInfo             fInfo;          // Set in onPreDraw.
+    SkAutoMalloc            fPixelStorage;
+    typedef Benchmark INHERITED;
+};
+#endif // CodecIOBench_DEFINED
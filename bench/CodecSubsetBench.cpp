@@ -0,0 +1,92 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "CodecSubsetBench.h"
+#include "SkBitmap.h"
+#include "SkCodec.h"
+#include "SkImageGenerator.h"
+#include "SkOSFile.h"
+
+CodecSubsetBench::CodecSubsetBench(SkString baseName, SkData* encoded, SkColorType colorType,
+        const int divisor)
+    : fColorType(colorType)
+    , fDivisor(divisor)
+    , fData(SkRef(encoded))
+{
+    // Parse filename and the color type to give the benchmark a useful name
+    const char* colorName;
+    switch(colorType) {
+        case kN32_SkColorType:
+            colorName = "N32";
+            break;
+        case kRGB_565_SkColorType:
+            colorName = "565";
+            break;
+        case kAlpha_8_SkColorType:
+            colorName = "Alpha8";
+            break;
+        default:
+            colorName = "Unknown";
+    }
+    fName.printf("CodecSubset_%dx%d_%s_%s", fDivisor, fDivisor,
+            baseName.c_str(), colorName);
+#ifdef SK_DEBUG
+    // Ensure that we can create an SkCodec from this data.
+    SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(fData));
+    SkASSERT(codec);
+#endif
+}
+
+const char* CodecSubsetBench::onGetName() {
+    return fName.c_str();
+}
+
+bool CodecSubsetBench::isSuitableFor(Backend backend) {
+    return kNonRendering_Backend == backend;
+}
+
+void CodecSubsetBench::onPreDraw() {
+    SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(fData));
+
+    fInfo = codec->getInfo().makeColorType(fColorType);
+    SkAlphaType alphaType;
+    // Caller should not have created this CodecSubsetBench if the alpha type
+    // was invalid.
+    SkAssertResult(SkColorTypeValidateAlphaType(fColorType, fInfo.alphaType(),
+                                                &alphaType));
+    if (alphaType != fInfo.alphaType()) {
+        fInfo = fInfo.makeAlphaType(alphaType);
+    }
+
+    const SkImageInfo subsetInfo = SkImageInfo::Make(fInfo.width() / fDivisor,
+            fInfo.height() / fDivisor, fInfo.colorType(), fInfo.alphaType());
+    fPixelStorage.reset(subsetInfo.getSafeSize(subsetInfo.minRowBytes()));
+}
+
+void CodecSubsetBench::onDraw(const int n, SkCanvas* canvas) {
+    SkAutoTDelete<SkCodec> codec;
+    SkPMColor colorTable[256];
+    int colorCount;
+    const int sW = fInfo.width() / fDivisor;
+    const int sH = fInfo.height() / fDivisor;
+    const SkImageInfo subsetInfo = SkImageInfo::Make(sW, sH, fInfo.colorType(),
+            fInfo.alphaType());
+    for (int i = 0; i < n; i++) {
+        codec.reset(SkCodec::NewFromData(fData));
+        // Divide the image into subsets and decode each subset
+        for (int y = 0; y < fInfo.height(); y += sH) {
+            for (int x = 0; x < fInfo.width(); x += sW) {
+                colorCount = 256;
+                SkIRect subset = SkIRect::MakeXYWH(x, y, sW, sH);
+                SkImageGenerator::Options opts;
+                opts.fSubset = &subset;
+                codec->getPixels(subsetInfo, fPixelStorage.get(), subsetInfo.minRowBytes(),
+                        &opts, colorTable, &colorCount);
+            }
+        }
+    }
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkAtomics.h"
+#include "SkPaint.h"
+#include "SkResourceCache.h"
+#include "SkString.h"
+#include "SkTDArray.h"
+#include "SkTaskGroup.h"
+#include "SkThreadUtils.h"
+
+// Multithreaded contention benchmarks.  FontCacheBench and ImageCacheBench
+// run single threaded, so a regression in a cache's locking only shows up in
+// production.  Each bench here runs its work loop on 1/2/4/8/16 threads
+// released together; the per-loop times across the thread counts form a
+// scalability curve, where flat means the lock scales and rising means the
+// threads are serializing on it.
+
+namespace {
+
+class ContentionBench : public Benchmark {
+public:
+    ContentionBench(const char* name, int threads) : fThreads(threads) {
+        fName.printf("%s_contention_%d", name, threads);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    // Runs loops iterations of the contended operation on each worker thread.
+    virtual void work(int loops) = 0;
+
+    void onDraw(const int loops, SkCanvas*) override {
+        Launch launch = { this, loops, fThreads };
+        SkTDArray<SkThread*> threads;
+        for (int i = 0; i < fThreads; i++) {
+            SkThread* thread = SkNEW_ARGS(SkThread, (ThreadMain, &launch));
+            *threads.append() = thread;
+            thread->start();
+        }
+        for (int i = 0; i < threads.count(); i++) {
+            threads[i]->join();
+            SkDELETE(threads[i]);
+        }
+    }
+
+private:
+    struct Launch {
+        ContentionBench* fBench;
+        int              fLoops;
+        int32_t          fNotReady;
+    };
+
+    static void ThreadMain(void* arg) {
+        Launch* launch = static_cast<Launch*>(arg);
+        // Spin until every thread has started, so the work loops overlap.
+        sk_atomic_dec(&launch->fNotReady);
+        while (sk_acquire_load(&launch->fNotReady) > 0) {}
+        launch->fBench->work(launch->fLoops);
+    }
+
+    int      fThreads;
+    SkString fName;
+
+    typedef Benchmark INHERITED;
+};
+
+// Every thread measures the same text, so each lookup after the first warms
+// the same strike and the threads contend on its lock.
+class GlyphCacheContentionBench : public ContentionBench {
+public:
+    explicit GlyphCacheContentionBench(int threads)
+        : INHERITED("fontcache", threads) {}
+
+protected:
+    void work(int loops) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+        static const char text[] = "Hammer the glyph cache from every thread at once";
+        for (int i = 0; i < loops; i++) {
+            paint.measureText(text, sizeof(text) - 1);
+        }
+    }
+
+private:
+    typedef ContentionBench INHERITED;
+};
+
+static void* gContentionNamespace;
+
+class TestKey : public SkResourceCache::Key {
+public:
+    intptr_t fValue;
+
+    TestKey(intptr_t value) : fValue(value) {
+        this->init(&gContentionNamespace, 0, sizeof(fValue));
+    }
+};
+
+struct TestRec : public SkResourceCache::Rec {
+    TestKey  fKey;
+    intptr_t fValue;
+
+    TestRec(const TestKey& key, intptr_t value) : fKey(key), fValue(value) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(fKey) + sizeof(fValue); }
+
+    static bool Visitor(const SkResourceCache::Rec&, void*) {
+        return true;
+    }
+};
+
+// Unlike ImageCacheBench, which times a private cache, this goes through the
+// static Find/Add interface so the threads contend on the global cache's
+// locks the way production callers do.
+class ResourceCacheContentionBench : public ContentionBench {
+    enum { kCacheCount = 500 };
+
+public:
+    explicit ResourceCacheContentionBench(int threads)
+        : INHERITED("imagecache", threads) {}
+
+protected:
+    void onPreDraw() override {
+        for (intptr_t i = 0; i < kCacheCount; i++) {
+            TestKey key(i);
+            if (!SkResourceCache::Find(key, TestRec::Visitor, NULL)) {
+                SkResourceCache::Add(SkNEW_ARGS(TestRec, (key, i)));
+            }
+        }
+    }
+
+    void work(int loops) override {
+        for (int i = 0; i < loops; i++) {
+            TestKey key(i % kCacheCount);
+            if (!SkResourceCache::Find(key, TestRec::Visitor, NULL)) {
+                // Purged out from under us; put it back so later finds hit.
+                SkResourceCache::Add(SkNEW_ARGS(TestRec, (key, i)));
+            }
+        }
+    }
+
+private:
+    typedef ContentionBench INHERITED;
+};
+
+static void noop_task(void*) {}
+
+// Each worker owns its own SkTaskGroup; the contended state is the shared
+// thread pool every group dispatches into.  Without an SkTaskGroup::Enabler
+// the adds run inline, timing the uncontended fallback instead.
+class TaskGroupContentionBench : public ContentionBench {
+public:
+    explicit TaskGroupContentionBench(int threads)
+        : INHERITED("taskgroup", threads) {}
+
+protected:
+    void work(int loops) override {
+        SkTaskGroup group;
+        for (int i = 0; i < loops; i++) {
+            group.add(noop_task, (void*)NULL);
+        }
+        group.wait();
+    }
+
+private:
+    typedef ContentionBench INHERITED;
+};
+
+}  // namespace
+
+// There is no GrMemoryPool bench here: the pool is not thread safe (callers
+// serialize on the owning GrContext), so concurrent allocs would just race.
+
+DEF_BENCH( return new GlyphCacheContentionBench(1); )
+DEF_BENCH( return new GlyphCacheContentionBench(2); )
+DEF_BENCH( return new GlyphCacheContentionBench(4); )
+DEF_BENCH( return new GlyphCacheContentionBench(8); )
+DEF_BENCH( return new GlyphCacheContentionBench(16); )
+
+DEF_BENCH( return new ResourceCacheContentionBench(1); )
+DEF_BENCH( return new ResourceCacheContentionBench(2); )
+DEF_BENCH( return new ResourceCacheContentionBench(4); )
+DEF_BENCH( return new ResourceCacheContentionBench(8); )
+DEF_BENCH( return new ResourceCacheContentionBench(16); )
+
+DEF_BENCH( return new TaskGroupContentionBench(1); )
+DEF_BENCH( return new TaskGroupContentionBench(2); )
+DEF_BENCH( return new TaskGroupContentionBench(4); )
+DEF_BENCH( return new TaskGroupContentionBench(8); )
+DEF_BENCH( return new TaskGroupContentionBench(16); )
@@ -36,6 +36,8 @@ public:
         return backend == kNonRendering_Backend;
     }
 
+    bool shouldCountAllocs() const override { return false; }
+
 protected:
     virtual const char* onGetName() {
         return "grmemorypool_stack";
@@ -98,6 +100,8 @@ public:
         return backend == kNonRendering_Backend;
     }
 
+    bool shouldCountAllocs() const override { return false; }
+
 protected:
     virtual const char* onGetName() {
         return "grmemorypool_random";
@@ -146,6 +150,8 @@ public:
         return backend == kNonRendering_Backend;
     }
 
+    bool shouldCountAllocs() const override { return false; }
+
 protected:
     virtual const char* onGetName() {
         return "grmemorypool_queue";
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "MallocTracker.h"
+
+#if defined(__GLIBC__) && !defined(SK_BUILD_FOR_ANDROID)
+
+#include "SkAtomics.h"
+
+#include <malloc.h>
+
+// glibc deprecated the hooks without providing a replacement short of
+// interposing malloc itself; for an opt-in bench mode they're still the
+// simplest way in.
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+extern "C" {
+    void* __libc_malloc(size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void  __libc_free(void*);
+}
+
+static uint64_t gBytes;
+static uint64_t gCount;
+static int64_t  gLive;
+static uint64_t gPeak;
+
+static void* (*gOldMalloc)(size_t, const void*);
+static void* (*gOldRealloc)(void*, size_t, const void*);
+static void* (*gOldMemalign)(size_t, size_t, const void*);
+static void  (*gOldFree)(void*, const void*);
+
+static void count_alloc(size_t usable) {
+    sk_atomic_fetch_add(&gBytes, (uint64_t)usable, sk_memory_order_relaxed);
+    sk_atomic_fetch_add(&gCount, (uint64_t)1, sk_memory_order_relaxed);
+    int64_t live = sk_atomic_fetch_add(&gLive, (int64_t)usable, sk_memory_order_relaxed)
+                 + (int64_t)usable;
+    uint64_t peak = sk_atomic_load(&gPeak, sk_memory_order_relaxed);
+    while ((int64_t)peak < live &&
+           !sk_atomic_compare_exchange(&gPeak, &peak, (uint64_t)live,
+                                       sk_memory_order_relaxed, sk_memory_order_relaxed)) {}
+}
+
+static void count_free(size_t usable) {
+    sk_atomic_fetch_add(&gLive, -(int64_t)usable, sk_memory_order_relaxed);
+}
+
+// The hooks call __libc_* directly rather than juggling the hook pointers,
+// so they're reentrancy-safe and other threads can allocate concurrently.
+static void* malloc_hook(size_t size, const void*) {
+    void* ptr = __libc_malloc(size);
+    if (ptr) {
+        count_alloc(malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+static void* realloc_hook(void* ptr, size_t size, const void*) {
+    if (ptr) {
+        count_free(malloc_usable_size(ptr));
+    }
+    void* newPtr = __libc_realloc(ptr, size);
+    if (newPtr) {
+        count_alloc(malloc_usable_size(newPtr));
+    }
+    return newPtr;
+}
+
+static void* memalign_hook(size_t alignment, size_t size, const void*) {
+    void* ptr = __libc_memalign(alignment, size);
+    if (ptr) {
+        count_alloc(malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+static void free_hook(void* ptr, const void*) {
+    if (ptr) {
+        count_free(malloc_usable_size(ptr));
+    }
+    __libc_free(ptr);
+}
+
+bool MallocTracker::Supported() { return true; }
+
+void MallocTracker::Start() {
+    sk_atomic_store(&gBytes, (uint64_t)0, sk_memory_order_relaxed);
+    sk_atomic_store(&gCount, (uint64_t)0, sk_memory_order_relaxed);
+    sk_atomic_store(&gLive,  (int64_t)0,  sk_memory_order_relaxed);
+    sk_atomic_store(&gPeak,  (uint64_t)0, sk_memory_order_relaxed);
+
+    gOldMalloc   = __malloc_hook;
+    gOldRealloc  = __realloc_hook;
+    gOldMemalign = __memalign_hook;
+    gOldFree     = __free_hook;
+    __malloc_hook   = malloc_hook;
+    __realloc_hook  = realloc_hook;
+    __memalign_hook = memalign_hook;
+    __free_hook     = free_hook;
+}
+
+void MallocTracker::Stop() {
+    __malloc_hook   = gOldMalloc;
+    __realloc_hook  = gOldRealloc;
+    __memalign_hook = gOldMemalign;
+    __free_hook     = gOldFree;
+}
+
+uint64_t MallocTracker::BytesAllocated() {
+    return sk_atomic_load(&gBytes, sk_memory_order_relaxed);
+}
+
+uint64_t MallocTracker::AllocationCount() {
+    return sk_atomic_load(&gCount, sk_memory_order_relaxed);
+}
+
+uint64_t MallocTracker::PeakFootprint() {
+    return sk_atomic_load(&gPeak, sk_memory_order_relaxed);
+}
+
+#else  // No malloc hooks on this platform.
+
+bool MallocTracker::Supported() { return false; }
+void MallocTracker::Start() {}
+void MallocTracker::Stop() {}
+uint64_t MallocTracker::BytesAllocated() { return 0; }
+uint64_t MallocTracker::AllocationCount() { return 0; }
+uint64_t MallocTracker::PeakFootprint() { return 0; }
+
+#endif
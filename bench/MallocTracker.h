@@ -0,0 +1,40 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef MallocTracker_DEFINED
+#define MallocTracker_DEFINED
+
+#include "SkTypes.h"
+
+/**
+ *  Process-wide heap allocation accounting for the benchmark harness, so a
+ *  bench that quietly starts allocating per draw shows up as a changed row,
+ *  not just as noise in its times.
+ *
+ *  Built on glibc's malloc hooks; Supported() is false elsewhere (and on
+ *  Android's bionic) and the counters then read as zero.  The hooks are
+ *  global, so counts include every thread's allocations while tracking is
+ *  on.  Not reentrant: only one Start()/Stop() pair may be active.
+ */
+class MallocTracker {
+public:
+    static bool Supported();
+
+    static void Start();  // Zeroes the counters and installs the hooks.
+    static void Stop();   // Uninstalls the hooks, latching the counters.
+
+    /** Total bytes handed out between Start() and Stop(), as usable sizes. */
+    static uint64_t BytesAllocated();
+
+    /** Number of malloc/realloc/memalign calls that returned memory. */
+    static uint64_t AllocationCount();
+
+    /** High-water mark of outstanding bytes since Start(). */
+    static uint64_t PeakFootprint();
+};
+
+#endif  // MallocTracker_DEFINED
@@ -25,6 +25,9 @@ public:
         return backend == kNonRendering_Backend;
     }
 
+    // Allocating is the whole point here.
+    bool shouldCountAllocs() const override { return false; }
+
 protected:
     const char* onGetName() override {
         return fName.c_str();
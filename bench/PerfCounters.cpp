@@ -0,0 +1,111 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "PerfCounters.h"
+
+#include <string.h>
+
+static const char* gNames[PerfCounters::kCounterCount] = {
+    "instructions",
+    "cycles",
+    "l1_misses",
+    "llc_misses",
+    "branch_misses",
+};
+
+const char* PerfCounters::Name(Counter c) {
+    SkASSERT(c >= 0 && c < kCounterCount);
+    return gNames[c];
+}
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const struct {
+    uint32_t fType;
+    uint64_t fConfig;
+} gEvents[PerfCounters::kCounterCount] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+static int perf_event_open(perf_event_attr* attr, pid_t pid, int cpu, int group,
+                           unsigned long flags) {
+    return (int)syscall(__NR_perf_event_open, attr, pid, cpu, group, flags);
+}
+
+PerfCounters::PerfCounters() : fOK(true) {
+    memset(fValues, 0, sizeof(fValues));
+    // The first counter leads a group the rest join, so one ioctl toggles all
+    // five at once and every counter covers exactly the same instructions.
+    for (int i = 0; i < kCounterCount; i++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = gEvents[i].fType;
+        attr.config = gEvents[i].fConfig;
+        attr.disabled = 1;  // Group members follow the leader's enable state.
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        const int group = (i > 0 && fFDs[0] >= 0) ? fFDs[0] : -1;
+        fFDs[i] = perf_event_open(&attr, 0 /*this thread*/, -1 /*any cpu*/, group, 0);
+        if (fFDs[i] < 0) {
+            fOK = false;
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int i = 0; i < kCounterCount; i++) {
+        if (fFDs[i] >= 0) {
+            close(fFDs[i]);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    if (!fOK) {
+        return;
+    }
+    ioctl(fFDs[0], PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+    ioctl(fFDs[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::stop() {
+    if (!fOK) {
+        return;
+    }
+    ioctl(fFDs[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < kCounterCount; i++) {
+        uint64_t v;
+        fValues[i] = sizeof(v) == read(fFDs[i], &v, sizeof(v)) ? v : 0;
+    }
+}
+
+#else  // !(SK_BUILD_FOR_UNIX || SK_BUILD_FOR_ANDROID)
+
+PerfCounters::PerfCounters() : fOK(false) {
+    memset(fValues, 0, sizeof(fValues));
+    for (int i = 0; i < kCounterCount; i++) {
+        fFDs[i] = -1;
+    }
+}
+
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+void PerfCounters::stop() {}
+
+#endif
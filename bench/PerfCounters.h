@@ -0,0 +1,59 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef PerfCounters_DEFINED
+#define PerfCounters_DEFINED
+
+#include "SkTypes.h"
+
+/**
+ *  A fixed group of hardware performance counters read around a benchmark
+ *  run, so a regression can be attributed to instruction count, cache
+ *  misses, or branch mispredicts without rerunning the bench under perf
+ *  by hand.
+ *
+ *  Backed by perf_event_open() on Linux and Android.  On other platforms,
+ *  or when the kernel refuses the syscall (e.g. perf_event_paranoid or a
+ *  PMU-less VM), ok() returns false and every counter reads as zero.
+ *
+ *  The counters follow the thread that constructed them, so construct,
+ *  start(), and stop() on the thread doing the work you want measured.
+ */
+class PerfCounters {
+public:
+    enum Counter {
+        kInstructions_Counter,
+        kCycles_Counter,
+        kL1CacheMisses_Counter,
+        kLLCacheMisses_Counter,
+        kBranchMisses_Counter,
+
+        kCounterCount
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    /** True if every counter in the group opened successfully. */
+    bool ok() const { return fOK; }
+
+    /** The metric name this counter is reported under, e.g. "instructions". */
+    static const char* Name(Counter);
+
+    void start();  // Zeroes and enables all counters in the group.
+    void stop();   // Disables the group and latches the counter values.
+
+    /** The value latched by the last stop().  Always 0 if !ok(). */
+    uint64_t value(Counter c) const { return fValues[c]; }
+
+private:
+    int      fFDs[kCounterCount];
+    uint64_t fValues[kCounterCount];
+    bool     fOK;
+};
+
+#endif  // PerfCounters_DEFINED
@@ -11,10 +11,14 @@
 
 #include "Benchmark.h"
 #include "CodecBench.h"
+#include "CodecIOBench.h"
+#include "CodecSubsetBench.h"
 #include "CrashHandler.h"
 #include "DecodingBench.h"
 #include "DecodingSubsetBench.h"
 #include "GMBench.h"
+#include "MallocTracker.h"
+#include "PerfCounters.h"
 #include "ProcStats.h"
 #include "ResultsWriter.h"
 #include "RecordingBench.h"
@@ -89,6 +93,12 @@ DEFINE_bool(mpd, true, "Use MultiPictureDraw for the SKPs?");
 DEFINE_int32(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 DEFINE_bool(resetGpuContext, true, "Reset the GrContext before running each test.");
 DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
+DEFINE_bool(perfCounters, false, "Log hardware performance counters (instructions, cycles, "
+                                 "cache and branch misses) for each CPU bench?  Linux/Android "
+                                 "only; counted over one extra run after timing.");
+DEFINE_bool(trackAllocs, false, "Log heap allocation count, bytes, and peak footprint for each "
+                                "CPU bench?  glibc only; counted over one extra run after "
+                                "timing.  Benches may opt out via shouldCountAllocs().");
 
 static SkString humanize(double ms) {
     if (FLAGS_verbose) return SkStringPrintf("%llu", (uint64_t)(ms*1e6));
@@ -490,6 +500,9 @@ public:
                       , fCurrentSKP(0)
                       , fCurrentUseMPD(0)
                       , fCurrentCodec(0)
+                      , fCurrentCodecSubset(0)
+                      , fCurrentCodecIO(0)
+                      , fCurrentCodecIOVariant(0)
                       , fCurrentImage(0)
                       , fCurrentSubsetImage(0)
                       , fCurrentColorType(0)
@@ -716,6 +729,122 @@ public:
             fCurrentColorType = 0;
         }
 
+        // Run the CodecSubsetBenches
+        for (; fCurrentCodecSubset < fImages.count(); fCurrentCodecSubset++) {
+            const SkString& path = fImages[fCurrentCodecSubset];
+            SkAutoTUnref<SkData> encoded(SkData::NewFromFileName(path.c_str()));
+            SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(encoded));
+            if (!codec) {
+                // Nothing to time.
+                SkDebugf("Cannot find codec for %s\n", path.c_str());
+                continue;
+            }
+
+            if (fDivisor > codec->getInfo().width() || fDivisor > codec->getInfo().height()) {
+                SkDebugf("Divisor %d is too big for %s %dx%d\n", fDivisor, path.c_str(),
+                        codec->getInfo().width(), codec->getInfo().height());
+                continue;
+            }
+
+            while (fCurrentColorType < fColorTypes.count()) {
+                const SkColorType colorType = fColorTypes[fCurrentColorType];
+                fCurrentColorType++;
+
+                // Make sure we can decode to this color type.
+                SkImageInfo info = codec->getInfo().makeColorType(colorType);
+                SkAlphaType alphaType;
+                if (!SkColorTypeValidateAlphaType(colorType, info.alphaType(),
+                                                  &alphaType)) {
+                    continue;
+                }
+                if (alphaType != info.alphaType()) {
+                    info = info.makeAlphaType(alphaType);
+                }
+
+                // Make sure the codec can decode a subset natively before
+                // creating the benchmark.
+                SkIRect subset = SkIRect::MakeWH(info.width() / fDivisor,
+                                                 info.height() / fDivisor);
+                SkImageGenerator::Options opts;
+                opts.fSubset = &subset;
+                const SkImageInfo subsetInfo = SkImageInfo::Make(subset.width(),
+                        subset.height(), info.colorType(), info.alphaType());
+                const size_t rowBytes = subsetInfo.minRowBytes();
+                SkAutoMalloc storage(subsetInfo.getSafeSize(rowBytes));
+
+                // Used if fCurrentColorType is kIndex_8_SkColorType
+                int colorCount = 256;
+                SkPMColor colors[256];
+
+                const SkImageGenerator::Result result = codec->getPixels(
+                        subsetInfo, storage.get(), rowBytes, &opts, colors,
+                        &colorCount);
+                switch (result) {
+                    case SkImageGenerator::kSuccess:
+                    case SkImageGenerator::kIncompleteInput:
+                        return new CodecSubsetBench(SkOSPath::Basename(path.c_str()),
+                                encoded, colorType, fDivisor);
+                    case SkImageGenerator::kInvalidConversion:
+                    case SkImageGenerator::kUnimplemented:
+                        // This is okay. Not all conversions are valid, and
+                        // not all codecs support subsets.
+                        break;
+                    default:
+                        // This represents some sort of failure.
+                        SkASSERT(false);
+                        break;
+                }
+            }
+            fCurrentColorType = 0;
+        }
+
+        // Run the CodecIOBenches
+        static const struct {
+            CodecIOBench::Mode  fMode;
+            CodecIOBench::Phase fPhase;
+            int                 fSampleSize;
+        } gCodecIOVariants[] = {
+            { CodecIOBench::kMemory_Mode,   CodecIOBench::kHeader_Phase,     1 },
+            { CodecIOBench::kMemory_Mode,   CodecIOBench::kFullDecode_Phase, 1 },
+            { CodecIOBench::kFile_Mode,     CodecIOBench::kHeader_Phase,     1 },
+            { CodecIOBench::kFile_Mode,     CodecIOBench::kFullDecode_Phase, 1 },
+            { CodecIOBench::kColdFile_Mode, CodecIOBench::kFullDecode_Phase, 1 },
+            { CodecIOBench::kMemory_Mode,   CodecIOBench::kFullDecode_Phase, 2 },
+            { CodecIOBench::kMemory_Mode,   CodecIOBench::kFullDecode_Phase, 4 },
+            { CodecIOBench::kMemory_Mode,   CodecIOBench::kFullDecode_Phase, 8 },
+        };
+        for (; fCurrentCodecIO < fImages.count(); fCurrentCodecIO++) {
+            const SkString& path = fImages[fCurrentCodecIO];
+            SkAutoTUnref<SkData> encoded(SkData::NewFromFileName(path.c_str()));
+            SkAutoTDelete<SkCodec> codec(SkCodec::NewFromData(encoded));
+            if (!codec) {
+                // Nothing to time.
+                SkDebugf("Cannot find codec for %s\n", path.c_str());
+                continue;
+            }
+
+            while (fCurrentCodecIOVariant < (int) SK_ARRAY_COUNT(gCodecIOVariants)) {
+                const int variant = fCurrentCodecIOVariant;
+                fCurrentCodecIOVariant++;
+
+                // If the codec cannot scale, a sampled decode would just
+                // repeat the full-size one.
+                if (gCodecIOVariants[variant].fSampleSize > 1) {
+                    const SkISize scaled = codec->getScaledDimensions(
+                            1.0f / gCodecIOVariants[variant].fSampleSize);
+                    if (scaled == codec->getInfo().dimensions()) {
+                        continue;
+                    }
+                }
+
+                return new CodecIOBench(SkOSPath::Basename(path.c_str()), path,
+                                        gCodecIOVariants[variant].fMode,
+                                        gCodecIOVariants[variant].fPhase,
+                                        gCodecIOVariants[variant].fSampleSize);
+            }
+            fCurrentCodecIOVariant = 0;
+        }
+
         // Run the DecodingBenches
         while (fCurrentImage < fImages.count()) {
             while (fCurrentColorType < fColorTypes.count()) {
@@ -830,6 +959,9 @@ private:
     int fCurrentSKP;
     int fCurrentUseMPD;
     int fCurrentCodec;
+    int fCurrentCodecSubset;
+    int fCurrentCodecIO;
+    int fCurrentCodecIOVariant;
     int fCurrentImage;
     int fCurrentSubsetImage;
     int fCurrentColorType;
@@ -866,6 +998,21 @@ int nanobench_main() {
         }
     }
 
+    SkAutoTDelete<PerfCounters> counters;
+    if (FLAGS_perfCounters) {
+        counters.reset(SkNEW(PerfCounters));
+        if (!counters->ok()) {
+            SkDebugf("Couldn't open perf counters (unsupported platform, or check "
+                     "/proc/sys/kernel/perf_event_paranoid); continuing without them.\n");
+            counters.free();
+        }
+    }
+
+    if (FLAGS_trackAllocs && !MallocTracker::Supported()) {
+        SkDebugf("Malloc hooks aren't available on this platform; "
+                 "continuing without allocation tracking.\n");
+    }
+
     SkAutoTDelete<ResultsWriter> log(SkNEW(ResultsWriter));
     if (!FLAGS_outResultsFile.isEmpty()) {
         log.reset(SkNEW(NanoJSONResultsWriter(FLAGS_outResultsFile[0])));
@@ -955,6 +1102,31 @@ int nanobench_main() {
             benchStream.fillCurrentOptions(log.get());
             targets[j]->fillOptions(log.get());
             log->metric("min_ms",    stats.min);
+            if (counters.get() && !targets[j]->needsFrameTiming()) {
+                // One extra run with the counters enabled, reported per loop to
+                // match the per-loop times above.  GPU configs are skipped: the
+                // CPU side only records there, so the counts would mostly
+                // measure the driver.
+                counters->start();
+                time(loops, bench.get(), targets[j]);
+                counters->stop();
+                for (int c = 0; c < PerfCounters::kCounterCount; c++) {
+                    const PerfCounters::Counter counter = (PerfCounters::Counter)c;
+                    log->metric(PerfCounters::Name(counter),
+                                counters->value(counter) / (double)loops);
+                }
+            }
+            if (FLAGS_trackAllocs && MallocTracker::Supported() && bench->shouldCountAllocs() &&
+                    !targets[j]->needsFrameTiming()) {
+                // As with the perf counters: one extra run, reported per loop
+                // except for the peak, which is a property of the whole run.
+                MallocTracker::Start();
+                time(loops, bench.get(), targets[j]);
+                MallocTracker::Stop();
+                log->metric("allocs",      MallocTracker::AllocationCount() / (double)loops);
+                log->metric("alloc_bytes", MallocTracker::BytesAllocated() / (double)loops);
+                log->metric("peak_bytes",  (double)MallocTracker::PeakFootprint());
+            }
             if (runs++ % FLAGS_flushEvery == 0) {
                 log->flush();
             }
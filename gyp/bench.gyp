@@ -15,9 +15,13 @@
       'sources': [
         '../gm/gm.cpp',
         '../bench/CodecBench.cpp',
+        '../bench/CodecIOBench.cpp',
+        '../bench/CodecSubsetBench.cpp',
         '../bench/DecodingBench.cpp',
         '../bench/DecodingSubsetBench.cpp',
         '../bench/GMBench.cpp',
+        '../bench/MallocTracker.cpp',
+        '../bench/PerfCounters.cpp',
         '../bench/RecordingBench.cpp',
         '../bench/SKPAnimationBench.cpp',
         '../bench/SKPBench.cpp',
@@ -19,6 +19,7 @@
         'core.gyp:*',
         'giflib.gyp:giflib',
         'libjpeg.gyp:libjpeg',
+        'libwebp.gyp:libwebp',
       ],
       'cflags':[
         # FIXME: This gets around a longjmp warning. See
@@ -29,6 +30,7 @@
         '../include/codec',
         '../src/codec',
         '../src/core',
+        '../src/opts',
       ],
       'sources': [
         '../src/codec/SkCodec.cpp',
@@ -36,6 +38,7 @@
         '../src/codec/SkCodec_libgif.cpp',
         '../src/codec/SkCodec_libico.cpp',
         '../src/codec/SkCodec_libpng.cpp',
+        '../src/codec/SkCodec_libwebp.cpp',
         '../src/codec/SkCodec_wbmp.cpp',
         '../src/codec/SkGifInterlaceIter.cpp',
         '../src/codec/SkJpegCodec.cpp',
@@ -23,6 +23,8 @@
           ],
           'sources': [
             '../bench/CodecBench.cpp',
+            '../bench/CodecIOBench.cpp',
+        '../bench/CodecSubsetBench.cpp',
             '../bench/DecodingBench.cpp',
             '../bench/DecodingSubsetBench.cpp',
             '../bench/GMBench.cpp',
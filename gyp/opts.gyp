@@ -25,6 +25,8 @@
         'effects.gyp:*'
       ],
       'include_dirs': [
+        '../include/codec',
+        '../src/codec',
         '../src/core',
         '../src/opts',
         '../src/utils',
@@ -33,7 +35,7 @@
       'conditions': [
         [ '"x86" in skia_arch_type and skia_os != "ios"', {
           'cflags': [ '-msse2' ],
-          'dependencies': [ 'opts_ssse3', 'opts_sse41' ],
+          'dependencies': [ 'opts_ssse3', 'opts_sse41', 'opts_sse42', 'opts_f16c', 'opts_avx2' ],
           'sources': [ '<@(sse2_sources)' ],
         }],
 
@@ -88,7 +90,11 @@
       'type': 'static_library',
       'standalone_static_library': 1,
       'dependencies': [ 'core.gyp:*' ],
-      'include_dirs': [ '../src/core' ],
+      'include_dirs': [
+        '../include/codec',
+        '../src/codec',
+        '../src/core',
+      ],
       'sources': [ '<@(ssse3_sources)' ],
       'conditions': [
         [ 'skia_os == "win"', {
@@ -118,6 +124,54 @@
         }],
       ],
     },
+    {
+      'target_name': 'opts_sse42',
+      'product_name': 'skia_opts_sse42',
+      'type': 'static_library',
+      'standalone_static_library': 1,
+      'dependencies': [ 'core.gyp:*' ],
+      'sources': [ '<@(sse42_sources)' ],
+      'conditions': [
+        [ 'skia_os == "win"', {
+            'defines' : [ 'SK_CPU_SSE_LEVEL=42' ],
+        }],
+        [ 'not skia_android_framework', {
+          'cflags': [ '-msse4.2' ],
+        }],
+      ],
+    },
+    {
+      'target_name': 'opts_f16c',
+      'product_name': 'skia_opts_f16c',
+      'type': 'static_library',
+      'standalone_static_library': 1,
+      'dependencies': [ 'core.gyp:*' ],
+      'include_dirs': [
+        '../src/core',
+      ],
+      'sources': [ '<@(f16c_sources)' ],
+      'conditions': [
+        [ 'not skia_android_framework', {
+          'cflags': [ '-mf16c' ],
+        }],
+      ],
+    },
+    {
+      'target_name': 'opts_avx2',
+      'product_name': 'skia_opts_avx2',
+      'type': 'static_library',
+      'standalone_static_library': 1,
+      'dependencies': [ 'core.gyp:*' ],
+      'sources': [ '<@(avx2_sources)' ],
+      'conditions': [
+        [ 'skia_os == "win"', {
+            'defines' : [ 'SK_CPU_SSE_LEVEL=52' ],
+        }],
+        [ 'not skia_android_framework', {
+          'cflags': [ '-mavx2' ],
+        }],
+      ],
+    },
     {
       'target_name': 'opts_neon',
       'product_name': 'skia_opts_neon',
@@ -128,6 +182,8 @@
         'effects.gyp:*'
       ],
       'include_dirs': [
+        '../include/codec',
+        '../src/codec',
         '../src/core',
         '../src/opts',
         '../src/utils',
@@ -15,10 +15,55 @@
 
 class SkScanlineDecoder : public SkNoncopyable {
 public:
+    /**
+     *  The order in which rows are output from the scanline decoder is not
+     *  the same for all variations of all image types.  This explains the
+     *  possible output row orderings.
+     */
+    enum ScanlineOrder {
+        /**
+         *  By far the most common, and the only ordering for which
+         *  getScanlines() can be called with countLines greater than one and
+         *  write directly into the final destination.  The image is decoded
+         *  a row at a time, from the top down.
+         */
+        kTopDown_ScanlineOrder,
+
+        /**
+         *  The rows of the image are decoded in an order determined by the
+         *  encoded data (e.g. interlaced gifs).  Each call to getScanlines()
+         *  writes the decoded rows consecutively into dst.  Clients should
+         *  request a single scanline at a time and use nextScanline() to
+         *  determine the destination row of the next decoded scanline.
+         */
+        kOutOfOrder_ScanlineOrder,
+
+        /**
+         *  There is no meaningful single pass over the rows (e.g. interlaced
+         *  pngs, where each pass updates every row).  Rows are reported from
+         *  the top down, as in kTopDown, but the entire image must be decoded
+         *  before any row can be produced, so requesting a small number of
+         *  rows is not cheaper than a full decode.
+         */
+        kNone_ScanlineOrder,
+    };
+
     // Note for implementations: An SkScanlineDecoder will be deleted by (and
     // therefore *before*) its associated SkCodec, in case the order matters.
     virtual ~SkScanlineDecoder() {}
 
+    /**
+     *  The order in which this decoder outputs rows.
+     */
+    ScanlineOrder getScanlineOrder() const { return this->onGetScanlineOrder(); }
+
+    /**
+     *  Return the destination row of the next scanline that getScanlines()
+     *  will decode.  For kTopDown and kNone this simply counts up from zero;
+     *  for kOutOfOrder it reflects the encoded row ordering.
+     */
+    int nextScanline() const { return this->onNextScanline(fCurrScanline); }
+
     /**
      *  Write the next countLines scanlines into dst.
      *
@@ -77,6 +122,14 @@ protected:
 
     virtual bool onReallyHasAlpha() const { return false; }
 
+    virtual ScanlineOrder onGetScanlineOrder() const { return kTopDown_ScanlineOrder; }
+
+    /**
+     *  Map the index of the next line to decode to its destination row.
+     *  Must be overridden by kOutOfOrder decoders.
+     */
+    virtual int onNextScanline(int nextDecodedLine) const { return nextDecodedLine; }
+
     const SkImageInfo& dstInfo() const { return fDstInfo; }
 
 private:
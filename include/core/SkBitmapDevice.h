@@ -50,6 +50,8 @@ protected:
                             const SkPoint[], const SkPaint& paint) override;
     virtual void drawRect(const SkDraw&, const SkRect& r,
                           const SkPaint& paint) override;
+    virtual void drawRects(const SkDraw&, const SkRect rects[], int count,
+                           const SkPaint& paint) override;
     virtual void drawOval(const SkDraw&, const SkRect& oval,
                           const SkPaint& paint) override;
     virtual void drawRRect(const SkDraw&, const SkRRect& rr,
@@ -74,6 +76,9 @@ protected:
                             const SkMatrix& matrix, const SkPaint& paint) override;
     virtual void drawSprite(const SkDraw&, const SkBitmap& bitmap,
                             int x, int y, const SkPaint& paint) override;
+    virtual void drawSprites(const SkDraw&, const SkBitmap& bitmap,
+                             const SkIRect src[], const SkIPoint dst[],
+                             int count, const SkPaint& paint) override;
 
     /**
      *  The default impl. will create a bitmap-shader from the bitmap,
@@ -83,6 +88,8 @@ protected:
                                 const SkRect* srcOrNull, const SkRect& dst,
                                 const SkPaint& paint,
                                 SkCanvas::DrawBitmapRectFlags flags) override;
+    virtual void drawBitmapNine(const SkDraw&, const SkBitmap&, const SkIRect& center,
+                                const SkRect& dst, const SkPaint& paint) override;
 
     /**
      *  Does not handle text decoration.
@@ -93,6 +100,13 @@ protected:
     virtual void drawPosText(const SkDraw&, const void* text, size_t len,
                              const SkScalar pos[], int scalarsPerPos,
                              const SkPoint& offset, const SkPaint& paint) override;
+
+    /**
+     *  For repeatedly-drawn blobs, blits a cached A8 mask of the whole blob
+     *  (see SkTextBlobMaskCache) instead of re-rasterizing every glyph.
+     */
+    virtual void drawTextBlob(const SkDraw&, const SkTextBlob*, SkScalar x, SkScalar y,
+                              const SkPaint& paint, SkDrawFilter* drawFilter) override;
     virtual void drawVertices(const SkDraw&, SkCanvas::VertexMode, int vertexCount,
                               const SkPoint verts[], const SkPoint texs[],
                               const SkColor colors[], SkXfermode* xmode,
@@ -76,6 +76,14 @@ public:
      */
     static void Color32(SkPMColor dst[], const SkPMColor src[], int count, SkPMColor color) QTI_WEAK;
 
+    /** Resolves every blit-row dispatch table (platform override or portable default) in one
+        pass, so the factories become plain table loads instead of re-querying the platform
+        procs on each blitter creation. Called by SkGraphics::Init(); the factories also
+        self-resolve on first use, so calling this is an optimization, not a requirement.
+        Safe to call more than once.
+     */
+    static void InitProcTables();
+
     /** These static functions are called by the Factory and Factory32
         functions, and should return either NULL, or a
         platform-specific function-ptr to be used in place of the
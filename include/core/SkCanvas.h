@@ -681,6 +681,16 @@ public:
     */
     void drawRect(const SkRect& rect, const SkPaint& paint);
 
+    /** Draw an array of rectangles, all with the same paint. The result is
+        identical to calling drawRect once per rectangle (overlaps are drawn
+        multiple times), but the backend can share paint and blitter setup
+        across the whole batch, which is much cheaper for large counts.
+        @param rects    Array of rects to be drawn
+        @param count    The number of rects in the array
+        @param paint    The paint used to draw the rects
+    */
+    void drawRects(const SkRect rects[], int count, const SkPaint& paint);
+
     /** Draw the specified rectangle using the specified paint. The rectangle
         will be filled or framed based on the Style in the paint.
         @param rect     The rect to be drawn
@@ -876,6 +886,20 @@ public:
     */
     void drawSprite(const SkBitmap& bitmap, int left, int top, const SkPaint* paint = NULL);
 
+    /** Draw a batch of subsets of one bitmap (an atlas of sprites), each at
+        its own integer position, NOT transformed by the current matrix (like
+        drawSprite). Batching lets the raster backend choose its blit state
+        once for the whole set and lets recording canvases capture the batch
+        as a single op.
+        @param bitmap   The bitmap holding the sprites
+        @param src      Array of count subsets of bitmap, one per sprite
+        @param dst      Array of count positions, one per sprite
+        @param count    The number of sprites to draw
+        @param paint    The paint used to draw the sprites, or NULL
+    */
+    void drawSpriteBatch(const SkBitmap& bitmap, const SkIRect src[], const SkIPoint dst[],
+                         int count, const SkPaint* paint = NULL);
+
     /** Draw the text, with origin at (x,y), using the specified paint.
         The origin is interpreted based on the Align setting in the paint.
         @param text The text to be drawn
@@ -1104,6 +1128,69 @@ public:
 
     ///////////////////////////////////////////////////////////////////////////
 
+    /**
+     *  Lightweight draw accounting, gathered only while setCollectDrawStats(true) is in
+     *  effect.  The counters are bumped in the common draw funnel, so the cost per draw is
+     *  a branch and a handful of adds -- cheap enough to leave on in production builds.
+     */
+    struct DrawStats {
+        // Mirrors SkDrawFilter::Type, which is what the draw funnel already reports.
+        enum DrawType {
+            kPaint_DrawType,
+            kPoint_DrawType,
+            kLine_DrawType,
+            kBitmap_DrawType,   // bitmaps, images and sprites
+            kRect_DrawType,
+            kRRect_DrawType,
+            kOval_DrawType,
+            kPath_DrawType,
+            kText_DrawType,
+
+            kDrawTypeCount
+        };
+
+        uint32_t fDrawCalls[kDrawTypeCount];
+        uint64_t fPixelsTouched;    // sum over draws of the clipped device-bounds area of each
+                                    // draw; an upper-bound estimate, ignoring overdraw and
+                                    // pixels the draw leaves untouched inside its bounds.
+        uint32_t fSaves;
+        uint32_t fSaveLayers;
+        uint32_t fMaxSaveDepth;     // deepest save/saveLayer nesting seen
+
+        void reset() { sk_bzero(this, sizeof(*this)); }
+    };
+
+    /** Enable (or disable) draw accounting on this canvas.  Off by default. */
+    void setCollectDrawStats(bool collect) { fCollectDrawStats = collect; }
+
+    /** The stats accumulated since construction or the last resetDrawStats(). */
+    const DrawStats& drawStats() const { return fDrawStats; }
+
+    /** Typically called once per frame, after the previous frame's stats are harvested. */
+    void resetDrawStats() { fDrawStats.reset(); }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    /**
+     *  Enable (or disable) damage tracking on this canvas.  Off by default.
+     *  While enabled, the device-space bounds of every draw, clipped to the
+     *  clip in effect at the time, are accumulated into a region retrievable
+     *  with damageRegion().  Draws whose bounds cannot be computed cheaply
+     *  (e.g. a paint with an unbounded looper) conservatively accumulate the
+     *  whole clip.  The bookkeeping shares the quick-reject bounds the draw
+     *  funnel already computes, so the per-draw cost is a branch plus a
+     *  region union.
+     */
+    void setTrackDamage(bool track) { fTrackDamage = track; }
+
+    /** The damage accumulated since construction or the last resetDamageRegion(). */
+    const SkRegion& damageRegion() const { return fDamage; }
+
+    /** Typically called once per frame, after the previous frame's damage is harvested. */
+    void resetDamageRegion() { fDamage.setEmpty(); }
+
+    ///////////////////////////////////////////////////////////////////////////
+
     /** After calling saveLayer(), there can be any number of devices that make
         up the top-most drawing area. LayerIter can be used to iterate through
         those devices. Note that the iterator is only valid until the next API
@@ -1202,6 +1289,7 @@ protected:
 
     virtual void onDrawPaint(const SkPaint&);
     virtual void onDrawRect(const SkRect&, const SkPaint&);
+    virtual void onDrawRects(const SkRect[], int count, const SkPaint&);
     virtual void onDrawOval(const SkRect&, const SkPaint&);
     virtual void onDrawRRect(const SkRRect&, const SkPaint&);
     virtual void onDrawPoints(PointMode, size_t count, const SkPoint pts[], const SkPaint&);
@@ -1217,6 +1305,8 @@ protected:
     virtual void onDrawBitmapNine(const SkBitmap&, const SkIRect& center, const SkRect& dst,
                                   const SkPaint*);
     virtual void onDrawSprite(const SkBitmap&, int left, int top, const SkPaint*);
+    virtual void onDrawSpriteBatch(const SkBitmap&, const SkIRect src[], const SkIPoint dst[],
+                                   int count, const SkPaint*);
 
     enum ClipEdgeStyle {
         kHard_ClipEdgeStyle,
@@ -1283,6 +1373,17 @@ private:
     bool fDeviceCMDirty;            // cleared by updateDeviceCMCache()
     void updateDeviceCMCache();
 
+    DrawStats fDrawStats;
+    bool      fCollectDrawStats;
+    // Callers check fCollectDrawStats first, so the disabled cost is one branch per draw.
+    void bumpDrawStats(DrawStats::DrawType, const SkRect* localBounds);
+    void bumpSaveStats(bool isLayer);
+
+    SkRegion fDamage;
+    bool     fTrackDamage;
+    // As with draw stats, callers check fTrackDamage before calling.
+    void accumulateDamage(const SkRect* localBounds);
+
     void doSave();
     void checkForDeferredSave();
 
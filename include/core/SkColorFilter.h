@@ -70,6 +70,22 @@ public:
     */
     virtual void filterSpan(const SkPMColor src[], int count, SkPMColor result[]) const = 0;
 
+    /**
+     *  A bare function equivalent to filterSpan(), plus the context it was resolved with.
+     *  src and result follow the same rules as filterSpan() (they may alias).
+     */
+    typedef void (*SpanProc)(const void* ctx, const SkPMColor src[], int count,
+                             SkPMColor result[]);
+
+    /**
+     *  If the subclass can express filterSpan() as a bare function over some precomputed
+     *  state, return that function and set *ctx to the state it needs. Blitters that filter
+     *  many spans fetch this once and splice it into their inner loop, avoiding a virtual
+     *  call per span and letting the filter bind any per-filter setup up front. *ctx must
+     *  remain valid for the lifetime of this filter. The default returns NULL.
+     */
+    virtual SpanProc asSpanProc(const void** /*ctx*/) const { return NULL; }
+
     enum Flags {
         /** If set the filter methods will not change the alpha channel of the colors.
         */
@@ -1037,4 +1037,56 @@ static inline void SkBlitLCD16OpaqueRow(SkPMColor dst[], const uint16_t mask[],
     }
 }
 
+/*  Variants of SkBlendLCD16/SkBlendLCD16Opaque for the SkBlitMask::RowProc
+    paths, where src is a premultiplied per-pixel color instead of one solid
+    (unpremultiplied) color, so the source alpha is applied per pixel.
+ */
+static inline SkPMColor SkBlendLCD16PMSrc(SkPMColor src, SkPMColor dst,
+                                          uint16_t mask) {
+    if (mask == 0) {
+        return dst;
+    }
+
+    int srcA = SkGetPackedA32(src);
+    srcA += srcA >> 7;  // 0..256
+
+    int maskR = SkUpscale31To32(SkGetPackedR16(mask) >> (SK_R16_BITS - 5));
+    int maskG = SkUpscale31To32(SkGetPackedG16(mask) >> (SK_G16_BITS - 5));
+    int maskB = SkUpscale31To32(SkGetPackedB16(mask) >> (SK_B16_BITS - 5));
+
+    int dstR = SkGetPackedR32(dst);
+    int dstG = SkGetPackedG32(dst);
+    int dstB = SkGetPackedB32(dst);
+
+    // dst + mask * (src - srcA * dst), with every product kept within 16
+    // bits. The truncation of srcA * dst can overshoot the blend by a bit,
+    // so clamp each channel.
+    int resR = dstR + ((maskR * (SkGetPackedR32(src) - (srcA * dstR >> 8))) >> 5);
+    int resG = dstG + ((maskG * (SkGetPackedG32(src) - (srcA * dstG >> 8))) >> 5);
+    int resB = dstB + ((maskB * (SkGetPackedB32(src) - (srcA * dstB >> 8))) >> 5);
+
+    // LCD blitting is only supported if the dst is known/required
+    // to be opaque
+    return SkPackARGB32(0xFF, SkClampMax(resR, 255), SkClampMax(resG, 255),
+                        SkClampMax(resB, 255));
+}
+
+static inline SkPMColor SkBlendLCD16OpaquePMSrc(SkPMColor src, SkPMColor dst,
+                                                uint16_t mask) {
+    if (mask == 0) {
+        return dst;
+    }
+
+    int maskR = SkUpscale31To32(SkGetPackedR16(mask) >> (SK_R16_BITS - 5));
+    int maskG = SkUpscale31To32(SkGetPackedG16(mask) >> (SK_G16_BITS - 5));
+    int maskB = SkUpscale31To32(SkGetPackedB16(mask) >> (SK_B16_BITS - 5));
+
+    // LCD blitting is only supported if the dst is known/required
+    // to be opaque
+    return SkPackARGB32(0xFF,
+                        SkBlend32(SkGetPackedR32(src), SkGetPackedR32(dst), maskR),
+                        SkBlend32(SkGetPackedG32(src), SkGetPackedG32(dst), maskG),
+                        SkBlend32(SkGetPackedB32(src), SkGetPackedB32(dst), maskB));
+}
+
 #endif
@@ -114,11 +114,24 @@ public:
      */
     static SkData* NewFromMalloc(const void* data, size_t length);
 
+    /**
+     *  When a dataref is backed by a memory-mapped file (NewFromFileName and
+     *  friends), this describes how its contents are expected to be read, so
+     *  the kernel can tune read-ahead for the mapping. It is purely a hint:
+     *  platforms without such control ignore it.
+     */
+    enum AccessPattern {
+        kNormal_AccessPattern,      //!< no particular access order
+        kSequential_AccessPattern,  //!< will be read front to back
+        kRandom_AccessPattern       //!< will be read in no particular order
+    };
+
     /**
      *  Create a new dataref the file with the specified path.
      *  If the file cannot be opened, this returns NULL.
      */
-    static SkData* NewFromFileName(const char path[]);
+    static SkData* NewFromFileName(const char path[],
+                                   AccessPattern pattern = kNormal_AccessPattern);
 
     /**
      *  Create a new dataref from a SkFILE.
@@ -127,7 +140,7 @@ public:
      *  The SkFILE must be open for reading only.
      *  Returns NULL on failure.
      */
-    static SkData* NewFromFILE(SkFILE* f);
+    static SkData* NewFromFILE(SkFILE* f, AccessPattern pattern = kNormal_AccessPattern);
 
     /**
      *  Create a new dataref from a file descriptor.
@@ -136,7 +149,23 @@ public:
      *  The file descriptor must be open for reading only.
      *  Returns NULL on failure.
      */
-    static SkData* NewFromFD(int fd);
+    static SkData* NewFromFD(int fd, AccessPattern pattern = kNormal_AccessPattern);
+
+    /**
+     *  If this dataref is backed by a memory-mapped file, ask the kernel to
+     *  page in the given byte range (clamped to size()) ahead of its use.
+     *  No-op for other datarefs.
+     */
+    void prefetch(size_t offset, size_t length) const;
+
+    /**
+     *  If this dataref is backed by a memory-mapped file, tell the kernel the
+     *  given byte range (clamped to size()) will not be needed again soon,
+     *  allowing its pages to be reclaimed. The bytes remain valid to read;
+     *  they are just refetched from the file on the next access. No-op for
+     *  other datarefs.
+     */
+    void purge(size_t offset, size_t length) const;
 
     /**
      *  Attempt to read size bytes into a SkData. If the read succeeds, return the data,
@@ -171,6 +171,12 @@ protected:
                             const SkPoint[], const SkPaint& paint) = 0;
     virtual void drawRect(const SkDraw&, const SkRect& r,
                           const SkPaint& paint) = 0;
+
+    // Default impl calls drawRect() once per rect; raster overrides share
+    // one blitter across the batch.
+    virtual void drawRects(const SkDraw&, const SkRect rects[], int count,
+                           const SkPaint& paint);
+
     virtual void drawOval(const SkDraw&, const SkRect& oval,
                           const SkPaint& paint) = 0;
     virtual void drawRRect(const SkDraw&, const SkRRect& rr,
@@ -200,6 +206,15 @@ protected:
     virtual void drawSprite(const SkDraw&, const SkBitmap& bitmap,
                             int x, int y, const SkPaint& paint) = 0;
 
+    /**
+     *  Draw a batch of unscaled subsets of one bitmap, each at its own
+     *  device position. The default impl. extracts each subset and calls
+     *  drawSprite.
+     */
+    virtual void drawSprites(const SkDraw&, const SkBitmap& bitmap,
+                             const SkIRect src[], const SkIPoint dst[],
+                             int count, const SkPaint& paint);
+
     /**
      *  The default impl. will create a bitmap-shader from the bitmap,
      *  and call drawRect with it.
@@ -209,6 +224,13 @@ protected:
                                 const SkPaint& paint,
                                 SkCanvas::DrawBitmapRectFlags flags) = 0;
 
+    /**
+     *  The default impl. decomposes the nine-patch into nine drawBitmapRect
+     *  calls.  center has already been pinned to the bitmap's bounds.
+     */
+    virtual void drawBitmapNine(const SkDraw&, const SkBitmap&, const SkIRect& center,
+                                const SkRect& dst, const SkPaint& paint);
+
     virtual void drawImage(const SkDraw&, const SkImage*, SkScalar x, SkScalar y, const SkPaint&);
     virtual void drawImageRect(const SkDraw&, const SkImage*, const SkRect* src, const SkRect& dst,
                                const SkPaint&);
@@ -63,6 +63,17 @@ public:
     static SkDocument* CreatePDF(const char outputFilePath[],
                                  SkScalar dpi = SK_ScalarDefaultRasterDPI);
 
+    /**
+     *  Like CreatePDF(), but writes each page's content to the stream as
+     *  soon as the page is closed instead of accumulating the whole document
+     *  in memory.  Only the cross-reference table and the resources shared
+     *  between pages (fonts, images, graphic states) are held until close(),
+     *  so peak memory is proportional to a page rather than the document.
+     *  The stream contents are not a valid PDF until close() returns true.
+     */
+    static SkDocument* CreateStreamingPDF(
+            SkWStream*, SkScalar dpi = SK_ScalarDefaultRasterDPI);
+
     /**
      *  Create a XPS-backed document, writing the results into the stream.
      *  Returns NULL if XPS is not supported.
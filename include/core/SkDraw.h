@@ -39,6 +39,12 @@ public:
     void    drawRect(const SkRect& rect, const SkPaint& paint) const {
         this->drawRect(rect, paint, NULL, NULL);
     }
+    /**
+     *  Draw a batch of rects sharing one paint. Simple fills map all the
+     *  rects to device space, sort them into scanline order, and blit them
+     *  through a single blitter; everything else falls back to drawRect().
+     */
+    void    drawRects(const SkRect rects[], int count, const SkPaint&) const;
     void    drawRRect(const SkRRect&, const SkPaint&) const;
     /**
      *  To save on mallocs, we allow a flag that tells us that srcPath is
@@ -63,6 +69,24 @@ public:
     void    drawBitmap(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
                        const SkPaint&) const;
     void    drawSprite(const SkBitmap&, int x, int y, const SkPaint&) const;
+    /**
+     *  Blit a batch of unscaled subsets of one bitmap, each at its own
+     *  device position.  The sprite blitter is chosen once for the whole
+     *  batch and just repositioned per placement, and placements are
+     *  processed in increasing dst-row order so the destination is walked
+     *  monotonically.
+     */
+    void    drawSprites(const SkBitmap&, const SkIRect src[], const SkIPoint dst[],
+                        int count, const SkPaint&) const;
+    /**
+     *  Fast path for nine-patch draws: sets up blit state once and blits all
+     *  nine patches row by row, re-using the previously scaled row whenever a
+     *  stretched patch repeats it.  Returns false without drawing anything
+     *  when the draw is too complex for this loop; the caller should then
+     *  fall back to decomposing into drawBitmapRect-style calls.
+     */
+    bool    drawBitmapNine(const SkBitmap&, const SkIRect& center,
+                           const SkRect& dst, const SkPaint&) const;
     void    drawText(const char text[], size_t byteLength, SkScalar x,
                      SkScalar y, const SkPaint& paint) const;
     void    drawPosText(const char text[], size_t byteLength,
@@ -120,8 +144,12 @@ public:
                                     const SkScalar pos[], int scalarsPerPosition,
                                     const SkPoint& offset, const SkPaint&) const;
 
-private:
+    /** Blit a mask that is already in device coordinates, applying the
+        paint's color/shader/xfermode (and mask filter, if any).
+    */
     void    drawDevMask(const SkMask& mask, const SkPaint&) const;
+
+private:
     void    drawBitmapAsMask(const SkBitmap&, const SkPaint&) const;
 
     void    drawPath(const SkPath&, const SkPaint&, const SkMatrix* preMatrix,
@@ -24,6 +24,7 @@ struct SkRect;
 class SkDrawable : public SkRefCnt {
 public:
     SkDrawable();
+    virtual ~SkDrawable();
 
     /**
      *  Draws into the specified content. The drawing sequence will be balanced upon return
@@ -32,6 +33,16 @@ public:
      */
     void draw(SkCanvas*);
 
+    /**
+     *  Opt in to (or out of) built-in snapshot caching. When enabled, draw() records this
+     *  drawable's output into a retained SkPicture and replays that on subsequent draws,
+     *  so unchanged drawables never re-execute their onDraw() code. The snapshot is
+     *  re-recorded automatically after notifyDrawingChanged() invalidates the generation
+     *  ID. Off by default.
+     */
+    void setSnapshotCachingEnabled(bool);
+    bool isSnapshotCachingEnabled() const { return fCachingEnabled; }
+
     SkPicture* newPictureSnapshot();
 
     /**
@@ -70,7 +81,12 @@ protected:
     virtual SkPicture* onNewPictureSnapshot();
 
 private:
-    int32_t fGenerationID;
+    int32_t          fGenerationID;
+
+    // Snapshot cache, used only when fCachingEnabled is set.
+    const SkPicture* fCachedPicture;
+    uint32_t         fCachedGenerationID;
+    bool             fCachingEnabled;
 };
 
 #endif
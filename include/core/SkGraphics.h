@@ -111,6 +111,63 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  A snapshot of one of the process-global caches (resource cache, font
+     *  cache, discardable memory pool).
+     */
+    struct CacheStats {
+        const char* fName;      //!< identifies the cache; valid for the life of the process
+        size_t      fBytesUsed;
+        size_t      fByteLimit;
+        uint32_t    fHits;      //!< successful lookups since process start
+        uint32_t    fMisses;    //!< failed lookups since process start
+    };
+
+    /**
+     *  Fill in up to maxCount entries of stats[] and return the number of
+     *  process-global caches. Call with maxCount 0 (stats may then be NULL)
+     *  to learn how many entries to allocate.
+     */
+    static int GetCacheStats(CacheStats stats[], int maxCount);
+
+    /**
+     *  Rebalance the process-global caches so that their combined byte limit
+     *  does not exceed totalBytes, purging entries as needed to fit. The new
+     *  budget is split in proportion to each cache's observed hit rate, so
+     *  shrinking a cold cache automatically grants its share to the hottest
+     *  one. Caches are shrunk before any cache is grown, so the process is
+     *  never over totalBytes for longer than necessary.
+     */
+    static void PurgeToFit(size_t totalBytes);
+
+    /**
+     *  A unit of incremental background work for PerformIdleWork().  A proc
+     *  should do one small, bounded slice of work and return true if it has
+     *  more to do; deadlineNanos is in the SkTime::GetNSecs() timebase, so a
+     *  proc doing several steps can check it between them.
+     */
+    typedef bool (*IdleWorkProc)(void* context, double deadlineNanos);
+
+    /**
+     *  Add (or remove) an idle work source.  The same proc/context pair may
+     *  be registered only once.  Procs run on whichever thread calls
+     *  PerformIdleWork().
+     */
+    static void RegisterIdleWorkProc(IdleWorkProc, void* context);
+    static void UnregisterIdleWorkProc(IdleWorkProc, void* context);
+
+    /**
+     *  Use idle time (e.g. the gap between finishing a frame and the next
+     *  vsync) for deferred housekeeping: processing cache invalidation
+     *  messages, purging over-budget cache and discardable-pool entries,
+     *  running idle-priority predecodes, and draining any registered
+     *  IdleWorkProcs.  Returns when there is nothing left to do or when
+     *  deadlineNanos (SkTime::GetNSecs() timebase) nears.  Work items are
+     *  cooperative, not preemptible: a single oversized item (say, a large
+     *  predecode) can overrun the deadline.
+     */
+    static void PerformIdleWork(double deadlineNanos);
+
     /**
      *  Applications with command line options may pass optional state, such
      *  as cache sizes, here, for instance:
@@ -108,6 +108,19 @@ public:
     bool filterImage(Proxy*, const SkBitmap& src, const Context&,
                      SkBitmap* result, SkIPoint* offset) const;
 
+    /**
+     *  Like filterImage(), but evaluates the filter DAG in horizontal bands
+     *  sized to stay cache-resident, so that the intermediate bitmap each
+     *  node materializes is O(band) rather than O(layer). Each band is
+     *  computed by re-running the DAG with the clip restricted to the band;
+     *  filters with bounded lookback (blurs, morphology, ...) pull in the
+     *  extra source rows they need through onFilterBounds(). Falls back to a
+     *  single filterImage() call when banding does not apply (GPU-backed
+     *  source, small output, or filter bounds that cannot be computed).
+     */
+    bool filterImageBanded(Proxy*, const SkBitmap& src, const Context&,
+                           SkBitmap* result, SkIPoint* offset) const;
+
     /**
      *  Given the src bounds of an image, this returns the bounds of the result
      *  image after the filter has been applied.
@@ -11,9 +11,12 @@
 #include "SkColor.h"
 #include "SkImageInfo.h"
 
+class GrContext;
+class GrTexture;
 class SkBitmap;
 class SkData;
 class SkImageGenerator;
+struct SkIRect;
 
 //#define SK_SUPPORT_LEGACY_OPTIONLESS_GET_PIXELS
 
@@ -135,9 +138,21 @@ public:
      */
     struct Options {
         Options()
-            : fZeroInitialized(kNo_ZeroInitialized) {}
+            : fZeroInitialized(kNo_ZeroInitialized)
+            , fSubset(NULL) {}
 
         ZeroInitialized fZeroInitialized;
+        /**
+         *  If not NULL, decode only the region of the image it describes,
+         *  in the coordinates of the full image. The dimensions of the info
+         *  passed to getPixels must match the dimensions of the subset, and
+         *  the subset must be contained by the full image.
+         *
+         *  Not all generators support subset decoding; those that do not
+         *  will return kUnimplemented, and the caller should decode the
+         *  full image and crop.
+         */
+        const SkIRect*  fSubset;
     };
 
     /**
@@ -192,6 +207,18 @@ public:
     bool getYUV8Planes(SkISize sizes[3], void* planes[3], size_t rowBytes[3],
                        SkYUVColorSpace* colorSpace);
 
+    /**
+     *  If the generator can produce its content directly as a GrTexture for
+     *  this context -- e.g. it wraps a hardware decoder's output buffer that
+     *  can be imported as an EGLImage -- returns that texture without the
+     *  pixels ever touching system memory. The caller owns a ref on the
+     *  returned texture.
+     *
+     *  Returns NULL when no such zero-copy path exists; the caller should
+     *  fall back to getPixels() and upload.
+     */
+    GrTexture* generateTexture(GrContext*);
+
     /**
      *  If the default image decoder system can interpret the specified (encoded) data, then
      *  this returns a new ImageGenerator for it. Otherwise this returns NULL. Either way
@@ -215,6 +242,7 @@ protected:
     virtual bool onGetYUV8Planes(SkISize sizes[3], void* planes[3], size_t rowBytes[3]);
     virtual bool onGetYUV8Planes(SkISize sizes[3], void* planes[3], size_t rowBytes[3],
                                  SkYUVColorSpace* colorSpace);
+    virtual GrTexture* onGenerateTexture(GrContext*);
 
 private:
     const SkImageInfo fInfo;
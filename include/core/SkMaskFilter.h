@@ -208,6 +208,16 @@ protected:
                                            const SkIRect& clipBounds,
                                            NinePatch*) const;
 
+    /**
+     *  Similar to filterRectsToNine, except it performs the work on round rects: either a
+     *  single filled round rect, or (count == 2) the ring between a round rect and a second,
+     *  nested one -- the shape left by a uniform stroke.
+     */
+    virtual FilterReturn filterRRectsToNine(const SkRRect[], int count,
+                                            const SkMatrix&,
+                                            const SkIRect& clipBounds,
+                                            NinePatch*) const;
+
 private:
     friend class SkDraw;
 
@@ -222,9 +232,11 @@ private:
     /** Helper method that, given a roundRect in device space, will rasterize it into a kA8_Format
      mask and then call filterMask(). If this returns true, the specified blitter will be called
      to render that mask. Returns false if filterMask() returned false.
+     For kStroke_Style, devStrokeWidth must be the stroke width already mapped into device
+     space; the filter then covers the ring the stroke would leave, not the filled shape.
      */
     bool filterRRect(const SkRRect& devRRect, const SkMatrix& ctm, const SkRasterClip&,
-                     SkBlitter*, SkPaint::Style style) const;
+                     SkBlitter*, SkPaint::Style style, SkScalar devStrokeWidth = 0) const;
 
     typedef SkFlattenable INHERITED;
 };
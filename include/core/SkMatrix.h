@@ -539,6 +539,15 @@ public:
         return this->mapRect(rect, *rect);
     }
 
+    /** Apply this matrix to the src rectangle, and write the transformed
+        rectangle into dst. The caller must check isScaleTranslate() first;
+        given that, this is faster than mapRect() since only the two corners
+        need to be transformed (and no proc dispatch is needed).
+        @param dst  Where the transformed rectangle is written.
+        @param src  The original rectangle to be transformed.
+    */
+    void mapRectScaleTranslate(SkRect* dst, const SkRect& src) const;
+
     /** Apply this matrix to the src rectangle, and write the four transformed
         points into dst. The points written to dst will be the original top-left, top-right,
         bottom-right, and bottom-left points transformed by the matrix.
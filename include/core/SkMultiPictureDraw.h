@@ -43,10 +43,49 @@ public:
              const SkMatrix* matrix = NULL,
              const SkPaint* paint = NULL);
 
+    /**
+     *  Add a single picture to be rendered tile-parallel: the canvas' clip is
+     *  partitioned into tileSize x tileSize tiles and each tile is replayed as
+     *  its own task during draw(), relying on the picture's bounding box
+     *  hierarchy to cull each tile down to the ops that intersect it.
+     *
+     *  This requires a canvas with directly accessible raster pixels; for any
+     *  other target (or if paint carries an image filter, which may sample
+     *  across tile boundaries) this falls back to add(), i.e. serial playback.
+     *  The canvas and its pixels must stay valid and untouched until draw()
+     *  returns.
+     *
+     *  @param canvas   the canvas in which to draw picture
+     *  @param picture  the picture to draw into canvas
+     *  @param matrix   if non-NULL, applied to the CTM when drawing
+     *  @param paint    if non-NULL, applied when each tile is drawn
+     *  @param tileSize edge length in pixels of the square tiles
+     */
+    void addTiled(SkCanvas* canvas,
+                  const SkPicture* picture,
+                  const SkMatrix* matrix = NULL,
+                  const SkPaint* paint = NULL,
+                  int tileSize = 256);
+
+    /**
+     *  Callback invoked as each added draw completes. 'index' counts the draws in
+     *  submission order; addTiled() consumes one index per tile, in row-major order.
+     *  For the thread-safe (non-GPU) draws the callback fires on a worker thread as
+     *  soon as that draw's picture has been rendered, so the caller can pipeline
+     *  work that depends on it (e.g. readbacks) instead of waiting for draw() to
+     *  finish everything.
+     */
+    typedef void (*CompletionProc)(void* context, int index);
+    void setCompletionCallback(CompletionProc, void* context);
+
     /**
      *  Perform all the previously added draws. This will reset the state
      *  of this object. If flush is true, all canvases are flushed after
      *  draw.
+     *
+     *  The thread-safe draws are handed to the task group largest picture first
+     *  (by approximateOpCount), so a long straggler isn't picked up last and
+     *  left running alone at the end.
      */
     void draw(bool flush = false);
 
@@ -61,8 +100,11 @@ private:
         const SkPicture* fPicture; // reffed
         SkMatrix         fMatrix;
         SkPaint*         fPaint;   // owned
+        int              fIndex;   // submission order, reported to fDoneProc
+        CompletionProc   fDoneProc; // stamped in draw(); may be NULL
+        void*            fDoneCtx;
 
-        void init(SkCanvas*, const SkPicture*, const SkMatrix*, const SkPaint*);
+        void init(SkCanvas*, const SkPicture*, const SkMatrix*, const SkPaint*, int index);
         void draw();
 
         static void Reset(SkTDArray<DrawData>&);
@@ -72,6 +114,9 @@ private:
 
     SkTDArray<DrawData> fThreadSafeDrawData;
     SkTDArray<DrawData> fGPUDrawData;
+    CompletionProc      fDoneProc;
+    void*               fDoneCtx;
+    int                 fNextIndex;
 };
 
 #endif
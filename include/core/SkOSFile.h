@@ -63,6 +63,21 @@ void*   sk_fdmmap(int fd, size_t* length);
  */
 void    sk_fmunmap(const void* addr, size_t length);
 
+enum SkFILE_MemoryAdvice {
+    kNormal_SkFILE_MemoryAdvice,      //!< no particular access pattern
+    kSequential_SkFILE_MemoryAdvice,  //!< will be read front to back; read ahead aggressively
+    kRandom_SkFILE_MemoryAdvice,      //!< will be read in no particular order; don't read ahead
+    kWillNeed_SkFILE_MemoryAdvice,    //!< will be needed soon; page it in now
+    kDontNeed_SkFILE_MemoryAdvice     //!< not needed any time soon; its pages may be reclaimed
+};
+
+/** Advises the kernel of the expected access pattern for a range inside a
+ *  mapping created by sk_fmmap or sk_fdmmap. The hint is best-effort: it
+ *  returns false where the platform offers no such control, and the contents
+ *  of the mapping are unaffected either way.
+ */
+bool    sk_fmadvise(const void* addr, size_t length, SkFILE_MemoryAdvice advice);
+
 /** Returns true if the two point at the exact same filesystem object. */
 bool    sk_fidentical(SkFILE* a, SkFILE* b);
 
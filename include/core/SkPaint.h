@@ -70,6 +70,13 @@ public:
      */
     uint32_t getHash() const;
 
+    /** Returns a non-zero value unique among paints with different contents. The value is
+     *  invalidated whenever the paint is modified, so it can be used to key caches of state
+     *  derived from the paint. Copying a paint copies its generation ID, since the copy has
+     *  the same contents.
+     */
+    uint32_t getGenerationID() const;
+
     void flatten(SkWriteBuffer&) const;
     void unflatten(SkReadBuffer&);
 
@@ -1055,6 +1062,7 @@ private:
         } fBitfields;
         uint32_t fBitfieldsUInt;
     };
+    mutable uint32_t fGenerationID;     // 0 means "needs a new ID"; see getGenerationID()
 
     SkDrawCacheProc    getDrawCacheProc() const;
     SkMeasureCacheProc getMeasureCacheProc(bool needFullMetrics) const;
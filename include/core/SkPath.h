@@ -296,6 +296,13 @@ public:
         this->getBounds();
     }
 
+    /** Compute the bounds of each of the count paths in a single pass,
+        writing the bounds of paths[i] into bounds[i]. Equivalent to calling
+        getBounds() on each path in turn (including caching the answer on the
+        path), for callers binning many freshly-built paths.
+    */
+    static void GetBounds(const SkPath paths[], int count, SkRect bounds[]);
+
     /**
      * Does a conservative test to see whether a rectangle is inside a path. Currently it only
      * will ever return true for single convex contour paths. The empty-status of the rect is not
@@ -957,6 +964,14 @@ public:
     static const int kPathRefGenIDBitCnt = 32;
 #endif
 
+    /** Registers a listener to be notified when the path's generation ID changes or the path is
+        deleted. This can be used to purge caches keyed by the generation ID. The path takes
+        ownership of the listener.
+    */
+    void addGenIDChangeListener(SkPathRef::GenIDChangeListener* listener) {
+        fPathRef->addGenIDChangeListener(listener);
+    }
+
     SkDEBUGCODE(void validate() const;)
     SkDEBUGCODE(void experimentalValidateRef() const { fPathRef->validate(); } )
 
@@ -84,6 +84,8 @@ private:
     const SkPath*   fPath;
     SkScalar        fLength;            // relative to the current contour
     int             fFirstPtIndex;      // relative to the current contour
+    int             fContourIndex;      // which contour buildSegments() will measure next
+    int             fCursor;            // last segment index found by distanceToSegment
     bool            fIsClosed;          // relative to the current contour
     bool            fForceClosed;
 
@@ -107,6 +109,8 @@ private:
     SkScalar compute_cubic_segs(const SkPoint pts[3], SkScalar distance,
                                 int mint, int maxt, int ptIndex);
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t);
+
+    friend class SkPathMeasureCache;
 };
 
 #endif
@@ -109,6 +109,16 @@ public:
     };
 
 public:
+    /**
+     * Gets called when the path ref's generation ID changes or the path ref is deleted. This can
+     * be used to invalidate caches keyed by the generation ID.
+     */
+    struct GenIDChangeListener {
+        virtual ~GenIDChangeListener() {}
+        virtual void onChange() = 0;
+    };
+
+
     /**
      * Gets a path ref with no verbs or points.
      */
@@ -183,6 +193,7 @@ public:
     static void Rewind(SkAutoTUnref<SkPathRef>* pathRef);
 
     virtual ~SkPathRef() {
+        this->callGenIDChangeListeners();
         SkDEBUGCODE(this->validate();)
         sk_free(fPoints);
 
@@ -253,6 +264,13 @@ public:
      */
     uint32_t genID() const;
 
+    /**
+     * Registers a listener to be notified the next time the generation ID changes or the path ref
+     * is deleted. Listeners fire at most once; register again after each notification if repeat
+     * notifications are needed. Takes ownership of the listener.
+     */
+    void addGenIDChangeListener(GenIDChangeListener* listener);
+
     SkDEBUGCODE(void validate() const;)
 
 private:
@@ -430,6 +448,9 @@ private:
         return fPoints;
     }
 
+    // Called before the generation ID changes or the path ref is deleted.
+    void callGenIDChangeListeners();
+
     enum {
         kMinSize = 256,
     };
@@ -454,6 +475,8 @@ private:
     mutable uint32_t    fGenerationID;
     SkDEBUGCODE(int32_t fEditorsAttached;) // assert that only one editor in use at any time.
 
+    SkTDArray<GenIDChangeListener*> fGenIDChangeListeners;  // pointers are owned
+
     friend class PathRefTest_Private;
     typedef SkRefCnt INHERITED;
 };
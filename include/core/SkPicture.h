@@ -24,10 +24,12 @@ class SkCanvas;
 class SkData;
 class SkPictureData;
 class SkPixelSerializer;
+class SkRegion;
 class SkStream;
 class SkWStream;
 
 struct SkPictInfo;
+struct SkRecordDrawProfile;
 
 class SkRecord;
 
@@ -86,6 +88,20 @@ public:
     static SkPicture* CreateFromStream(SkStream*,
                                        InstallPixelRefProc proc = &SkImageDecoder::DecodeMemory);
 
+    /**
+     *  Like CreateFromStream(), but for a complete picture stream already held in memory.
+     *  This is the trusted fast path for same-process round trips: the op and buffer blocks
+     *  are not copied out of data but ref it and alias its storage directly, so only the
+     *  stream header is checked up front and each record is read in place.
+     *  @param data A complete serialized picture, starting at byte 0.
+     *  @param proc Function pointer for installing pixelrefs on SkBitmaps representing the
+     *              encoded bitmap data from the stream.
+     *  @return A new SkPicture representing the serialized data, or NULL if the data is
+     *          invalid.
+     */
+    static SkPicture* CreateFromData(SkData* data,
+                                     InstallPixelRefProc proc = &SkImageDecoder::DecodeMemory);
+
     /**
      *  Recreate a picture that was serialized into a buffer. If the creation requires bitmap
      *  decoding, the decoder must be set on the SkReadBuffer parameter by calling
@@ -125,6 +141,28 @@ public:
     */
     void playback(SkCanvas* canvas, AbortCallback* = NULL) const;
 
+    /** Replays the drawing commands on the specified canvas, restricted to a
+        damage region (in the canvas' device space).  The canvas is clipped to
+        the region for the duration of the playback, and commands that do not
+        intersect any of the region's rectangles are culled using the
+        picture's bounding-box hierarchy, so redrawing a few small dirty areas
+        of a large picture costs roughly in proportion to the damage.
+        @param canvas the canvas receiving the drawing commands.
+        @param damage device-space region to redraw
+        @param callback a callback that allows interruption of playback
+    */
+    void playback(SkCanvas* canvas, const SkRegion& damage, AbortCallback* = NULL) const;
+
+    /** Replays the drawing commands as playback() does, timing each command and
+        accumulating the results into profile (see SkRecordDraw.h for what is
+        collected). Intended for performance tooling; reading the clock around
+        every command makes this slower than playback().
+        @param canvas the canvas receiving the drawing commands.
+        @param profile receives per-command timing; not reset first, so the
+                       results of several playbacks may be pooled
+    */
+    void EXPERIMENTAL_playbackWithProfile(SkCanvas* canvas, SkRecordDrawProfile* profile) const;
+
     /** Return the cull rect used when creating this picture: { 0, 0, cullWidth, cullHeight }.
         It does not necessarily reflect the bounds of what has been recorded into the picture.
         @return the cull rect used to create this picture
@@ -301,6 +339,7 @@ private:
     friend class SkPictureRecorder;            // SkRecord-based constructor.
     friend class GrLayerHoister;               // access to fRecord
     friend class ReplaceDraw;
+    friend class ReplaceLayerDraw;             // access to fRecord/fBBH (raster layer cache)
     friend class SkPictureUtils;
     friend class SkRecordedDrawable;
 };
@@ -32,7 +32,15 @@ public:
     enum RecordFlags {
         // This flag indicates that, if some BHH is being computed, saveLayer
         // information should also be extracted at the same time.
-        kComputeSaveLayerInfo_RecordFlag = 0x01
+        kComputeSaveLayerInfo_RecordFlag = 0x01,
+
+        // Keep the recording's backing memory (the SkRecord's allocator pages and
+        // the BBH's node storage) alive across endRecording*()/beginRecording()
+        // cycles, and reuse it once the picture or drawable made from it has been
+        // deleted. A recorder re-recording frames of similar complexity with this
+        // flag settles into doing no heap allocation at all. Callers should pass
+        // the same BBH factory (if any) on every beginRecording() call.
+        kRecycleResources_RecordFlag     = 0x02
     };
 
     /** Returns the canvas that records the drawing commands.
@@ -52,6 +60,22 @@ public:
         return this->beginRecording(SkRect::MakeWH(width, height), bbhFactory, recordFlags);
     }
 
+    /** Begin re-recording just the invalidated part of a previous frame. The previous
+        picture is carried over by reference and clipped out of invalidRect; the returned
+        canvas is clipped to invalidRect, so the caller only records the draws that changed.
+        The cost of producing the new frame is therefore proportional to the damage, not
+        the scene. endRecordingAsPicture() returns the merged frame as usual.
+        @param previous the frame to update; it must outlive the recording only until
+                        endRecording*() is called (the result keeps its own reference).
+        @param invalidRect the region being re-recorded, in the previous picture's coordinates.
+        @param bbhFactory factory to create desired acceleration structure
+        @param recordFlags optional flags that control recording.
+        @return the canvas, already clipped to invalidRect.
+    */
+    SkCanvas* beginRecordingUpdate(const SkPicture* previous, const SkRect& invalidRect,
+                                   SkBBHFactory* bbhFactory = NULL,
+                                   uint32_t recordFlags = 0);
+
     /** Returns the recording canvas if one is active, or NULL if recording is
         not active. This does not alter the refcnt on the canvas (if present).
     */
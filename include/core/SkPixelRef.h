@@ -37,6 +37,7 @@ class SkColorTable;
 class SkData;
 struct SkIRect;
 
+class GrContext;
 class GrTexture;
 
 /** \class SkPixelRef
@@ -135,6 +136,15 @@ public:
     uint32_t getStableID() const { return fStableID; }
 #endif
 
+    /**
+     *  Hint that the caller's next lockPixels() only needs valid pixels inside the given
+     *  rect (in pixelref coordinates). PixelRefs that decode lazily may use this to limit
+     *  how much work the lock performs; most ignore it. This is purely advisory: callers
+     *  still observe the normal lock/unlock contract, and a lock that was not preceded by
+     *  a hint always produces the full image.
+     */
+    void ensureRegionResident(const SkIRect& region);
+
     /**
      *  Call this if you have changed the contents of the pixels. This will in-
      *  turn cause a different generation ID value to be returned from
@@ -197,6 +207,15 @@ public:
      */
     virtual GrTexture* getTexture() { return NULL; }
 
+    /**
+     *  If the pixel ref can produce its content directly as a GrTexture for
+     *  this context (e.g. it is backed by a hardware decoder's output
+     *  buffer), returns that texture; the caller owns a ref on it. Unlike
+     *  getTexture(), the wrapping texture may be created on demand. Returns
+     *  NULL when no such zero-copy path exists.
+     */
+    virtual GrTexture* generateTexture(GrContext*) { return NULL; }
+
     /**
      *  If any planes or rowBytes is NULL, this should output the sizes and return true
      *  if it can efficiently return YUV planar data. If it cannot, it should return false.
@@ -271,6 +290,13 @@ protected:
      */
     virtual void onUnlockPixels() = 0;
 
+    /**
+     *  Advisory residency hint; see ensureRegionResident(). The region has already been
+     *  clamped to the pixelref's bounds and is non-empty, and the caller will have already
+     *  acquired a mutex for thread safety. The default implementation does nothing.
+     */
+    virtual void onEnsureRegionResident(const SkIRect&) {}
+
     /** Default impl returns true */
     virtual bool onLockPixelsAreWritable() const;
 
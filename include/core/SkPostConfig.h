@@ -293,6 +293,13 @@
 #  define SK_ATTR_DEPRECATED(msg) SK_ATTRIBUTE(deprecated)
 #endif
 
+#if !defined(SK_ATTR_HOT)
+   // Groups the annotated function into the linker's hot text section (.text.hot on gcc and
+   // clang) so blit loops that run back-to-back share i-cache and iTLB pages instead of being
+   // scattered across the binary.
+#  define SK_ATTR_HOT SK_ATTRIBUTE(hot)
+#endif
+
 #if !defined(SK_ATTR_EXTERNALLY_DEPRECATED)
 #  if !defined(SK_INTERNAL)
 #    define SK_ATTR_EXTERNALLY_DEPRECATED(msg) SK_ATTR_DEPRECATED(msg)
@@ -275,6 +275,16 @@ public:
      */
     bool op(const SkRegion& rgn, Op op) { return this->op(*this, rgn, op); }
 
+    /**
+     *  Set this region to the result of applying the Op to this region and
+     *  the union of the specified rectangles: this = (this op union(rects)).
+     *  The union is built in a single sort-and-sweep pass, which is much
+     *  cheaper than applying count individual rect ops when count is large
+     *  (e.g. accumulating damage rects).
+     *  Return true if the resulting region is non-empty.
+     */
+    bool op(const SkIRect rects[], int count, Op);
+
     /**
      *  Set this region to the result of applying the Op to the specified
      *  rectangle and region: this = (rect op rgn).
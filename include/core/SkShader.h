@@ -229,6 +229,15 @@ public:
      */
     virtual size_t contextSize() const;
 
+    /**
+     *  Returns true if a Context made by this shader captures everything it needs from the
+     *  ContextRec at construction (no pointers back into the rec's paint or device, no
+     *  resources that must be released between draws). Callers may then keep the context
+     *  alive and reuse it for a later draw with an equivalent rec instead of constructing
+     *  a new one. The default is false.
+     */
+    virtual bool isContextPoolable() const { return false; }
+
     /**
      *  Helper to check the flags to know if it is legal to call shadeSpan16()
      */
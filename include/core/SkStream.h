@@ -77,6 +77,19 @@ public:
      */
     virtual bool peek(void* /* buffer */, size_t /* size */) const { return false; }
 
+    /**
+     *  Attempt to peek at size bytes without copying them.
+     *  If this stream can provide the next size bytes from its own storage,
+     *  return a pointer to them without advancing the stream.  The pointer is
+     *  only valid until the next call that reads from, rewinds, repositions,
+     *  or deletes the stream.
+     *  Returns NULL if the bytes cannot be provided without copying; callers
+     *  must be prepared to fall back to peek() or read().
+     *  @param size Number of bytes the returned pointer must cover.
+     *  @return A pointer to the next size bytes, or NULL.
+     */
+    virtual const void* peekBytes(size_t /* size */) const { return NULL; }
+
     /** Returns true when all the bytes in the stream have been read.
      *  This may return true early (when there are no more bytes to be read)
      *  or late (after the first unsuccessful read).
@@ -334,6 +347,7 @@ public:
     bool isAtEnd() const override;
 
     bool peek(void* buffer, size_t size) const override;
+    const void* peekBytes(size_t size) const override;
 
     bool rewind() override;
     SkMemoryStream* duplicate() const override;
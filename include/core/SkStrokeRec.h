@@ -69,6 +69,10 @@ public:
         fResScale = rs;
     }
 
+    SkScalar getResScale() const {
+        return fResScale;
+    }
+
     /**
      *  Returns true if this specifes any thick stroking, i.e. applyToPath()
      *  will return true.
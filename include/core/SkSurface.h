@@ -8,11 +8,11 @@
 #ifndef SkSurface_DEFINED
 #define SkSurface_DEFINED
 
+#include "SkCanvas.h"
 #include "SkRefCnt.h"
 #include "SkImage.h"
 #include "SkSurfaceProps.h"
 
-class SkCanvas;
 class SkPaint;
 class GrContext;
 class GrRenderTarget;
@@ -156,6 +156,22 @@ public:
      */
     SkCanvas* getCanvas();
 
+    /**
+     *  Enable (or disable) draw accounting on this surface's canvas.  Off by default.
+     *  See SkCanvas::DrawStats.
+     */
+    void setCollectDrawStats(bool);
+
+    /**
+     *  The stats this surface's canvas has accumulated since the last resetDrawStats().
+     */
+    const SkCanvas::DrawStats& drawStats();
+
+    /**
+     *  Typically called once per frame, after the previous frame's stats are harvested.
+     */
+    void resetDrawStats();
+
     /**
      *  Return a new surface that is "compatible" with this one, in that it will
      *  efficiently be able to be drawn into this surface. Typical calling
@@ -54,6 +54,12 @@ public:
         kDisallowAntiAlias_Flag     = 1 << 0,
         kDisallowDither_Flag        = 1 << 1,
         kUseDistanceFieldFonts_Flag = 1 << 2,
+        /**
+         *  Allow raster draws into this surface to be split into bands and
+         *  run on SkTaskGroup workers. Only has an effect when SkTaskGroup
+         *  has been enabled (see SkTaskGroup::Enabler).
+         */
+        kAllowThreadedRaster_Flag   = 1 << 3,
     };
     SkSurfaceProps(uint32_t flags, SkPixelGeometry);
 
@@ -70,6 +76,7 @@ public:
     bool isDisallowAA() const { return SkToBool(fFlags & kDisallowAntiAlias_Flag); }
     bool isDisallowDither() const { return SkToBool(fFlags & kDisallowDither_Flag); }
     bool isUseDistanceFieldFonts() const { return SkToBool(fFlags & kUseDistanceFieldFonts_Flag); }
+    bool isAllowThreadedRaster() const { return SkToBool(fFlags & kAllowThreadedRaster_Flag); }
 
 private:
     SkSurfaceProps();
@@ -35,6 +35,11 @@ public:
     static void GetDateTime(DateTime*);
 
     static SkMSec GetMSecs();
+
+    /** Return the number of nanoseconds from some arbitrary, monotonic epoch.
+        Suitable for measuring elapsed time, not for telling wall-clock time.
+    */
+    static double GetNSecs();
 };
 
 #if defined(SK_DEBUG) && defined(SK_BUILD_FOR_WIN32)
@@ -33,6 +33,7 @@ public:
 
 protected:
     SkColorCubeFilter(SkData* cubeData, int cubeDimension);
+    virtual ~SkColorCubeFilter();
     void flatten(SkWriteBuffer&) const override;
 
 private:
@@ -21,6 +21,7 @@ public:
     }
 
     void filterSpan(const SkPMColor src[], int count, SkPMColor[]) const override;
+    SpanProc asSpanProc(const void** ctx) const override;
     uint32_t getFlags() const override;
     bool asColorMatrix(SkScalar matrix[20]) const override;
     SkColorFilter* newComposed(const SkColorFilter*) const override;
@@ -46,6 +47,7 @@ protected:
 private:
     SkColorMatrix   fMatrix;
     float           fTranspose[SkColorMatrix::kCount]; // for Sk4s
+    SkPMColor       fTranslatePMColor;  // the matrix applied to transparent black
 
     typedef void (*Proc)(const State&, unsigned r, unsigned g, unsigned b,
                          unsigned a, int32_t result[4]);
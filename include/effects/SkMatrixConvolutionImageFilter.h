@@ -95,8 +95,16 @@ private:
     SkIPoint  fKernelOffset;
     TileMode  fTileMode;
     bool      fConvolveAlpha;
+    // Set when fKernel is rank-1, i.e. the outer product of fColKernel and
+    // fRowKernel; such kernels convolve as a row pass followed by a column
+    // pass.  Derived from fKernel, so not serialized.
+    bool      fSeparable;
+    SkScalar* fRowKernel;
+    SkScalar* fColKernel;
     typedef SkImageFilter INHERITED;
 
+    void initSeparable();
+
     template <class PixelFetcher, bool convolveAlpha>
     void filterPixels(const SkBitmap& src,
                       SkBitmap* result,
@@ -107,6 +115,11 @@ private:
                       SkBitmap* result,
                       const SkIRect& rect,
                       const SkIRect& bounds) const;
+    template <bool convolveAlpha>
+    void filterInteriorPixelsSeparable(const SkBitmap& src,
+                                       SkBitmap* result,
+                                       const SkIRect& rect,
+                                       const SkIRect& bounds) const;
     void filterInteriorPixels(const SkBitmap& src,
                               SkBitmap* result,
                               const SkIRect& rect,
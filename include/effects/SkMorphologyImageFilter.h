@@ -31,7 +31,7 @@ public:
 protected:
     SkMorphologyImageFilter(int radiusX, int radiusY, SkImageFilter* input,
                             const CropRect* cropRect);
-    bool filterImageGeneric(Proc procX, Proc procY,
+    bool filterImageGeneric(bool dilate, Proc procX, Proc procY,
                             Proxy*, const SkBitmap& src, const Context&,
                             SkBitmap* result, SkIPoint* offset) const;
     void flatten(SkWriteBuffer&) const override;
@@ -84,6 +84,7 @@ public:
 
     private:
         SkPMColor shade(const SkPoint& point, StitchData& stitchData) const;
+        void shade4(const SkPoint& point, StitchData& stitchData, SkPMColor result[4]) const;
         SkScalar calculateTurbulenceValueForPoint(
             int channel,
             StitchData& stitchData, const SkPoint& point) const;
@@ -16,6 +16,7 @@
 #include "GrTextureProvider.h"
 #include "SkMatrix.h"
 #include "SkPathEffect.h"
+#include "SkString.h"
 #include "SkTypes.h"
 
 class GrAARectRenderer;
@@ -41,6 +42,9 @@ class GrVertexBuffer;
 class GrStrokeInfo;
 class GrSoftwarePathRenderer;
 class SkGpuDevice;
+class SkPicture;
+class SkTypeface;
+struct SkImageInfo;
 
 class SK_API GrContext : public SkRefCnt {
 public:
@@ -162,6 +166,21 @@ public:
      */
     void purgeAllUnlockedResources();
 
+    /**
+     * Purge GPU resources that haven't been used in the past 'msNotUsed' milliseconds,
+     * regardless of whether the context is currently under budget. Intended to be called from
+     * the client's idle loop so the 3D API deletions happen between frames.
+     */
+    void performDeferredCleanup(SkMSec msNotUsed);
+
+    /**
+     * Purge unlocked resources from the cache until the provided byte count has been reached
+     * or we have purged all unlocked resources. Resources are purged in LRU order unless
+     * 'preferScratchResources' is true, in which case scratch resources are purged first.
+     * Intended for memory pressure events.
+     */
+    void purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources);
+
     //////////////////////////////////////////////////////////////////////////
     /// Texture and Render Target Queries
 
@@ -405,6 +424,70 @@ public:
      */
     void flush(int flagsBitfield = 0);
 
+    /**
+     * Like flush(), but additionally inserts a fence into the underlying 3D API's command
+     * stream. The caller can poll or wait on the fence with waitFence() instead of stalling on
+     * the GPU, and must eventually release it with deleteFence(). Returns 0 if the backend
+     * cannot create fences; the flushed work should then be treated as already complete.
+     */
+    GrFence flushAndInsertFence(int flagsBitfield = 0);
+
+    /**
+     * Returns true once the GPU has consumed all commands preceding the fence. A timeout of
+     * zero polls without blocking.
+     */
+    bool waitFence(GrFence, uint64_t timeoutNanos);
+
+    /**
+     * Releases the resources owned by a fence returned from flushAndInsertFence().
+     */
+    void deleteFence(GrFence);
+
+    /**
+     * Called when a readback started with asyncReadRenderTargetPixels() completes. pixels
+     * points at the rows top-to-bottom with the stride requested at insert time and is only
+     * valid for the duration of the call; the proc must copy (or consume) them before
+     * returning. The proc is always invoked on the context's thread, from
+     * processAsyncReadPixels().
+     */
+    typedef void (*AsyncReadPixelsProc)(void* ctx, const void* pixels, size_t rowBytes);
+
+    /**
+     * Begins an asynchronous readback of a rectangle of pixels from a render target. The
+     * context is flushed and the copy into driver-owned memory is fenced behind it, so this
+     * call returns without draining the GPU. Returns 0 if the backend cannot read this rect
+     * and config asynchronously; callers should then use readRenderTargetPixels().
+     *
+     * Without a proc the caller owns completion: poll with asyncReadPixelsIsReady() and fetch
+     * the pixels with finishAsyncReadPixels(). With a proc, the readback is delivered by a
+     * later processAsyncReadPixels() call; the proc may hand the rows off to another thread
+     * (e.g. an encoder), keeping this thread from ever blocking on the transfer.
+     */
+    GrAsyncPixelRead asyncReadRenderTargetPixels(GrRenderTarget* target,
+                                                 int left, int top, int width, int height,
+                                                 GrPixelConfig config, size_t rowBytes = 0,
+                                                 AsyncReadPixelsProc proc = NULL,
+                                                 void* procCtx = NULL);
+
+    /**
+     * Returns true once an asynchronous readback's pixels are available, without blocking.
+     */
+    bool asyncReadPixelsIsReady(GrAsyncPixelRead);
+
+    /**
+     * Completes an asynchronous readback begun without a proc, copying the pixels into buffer
+     * and retiring the handle. If wait is false and the GPU has not finished, returns false
+     * and the handle stays live so the caller can try again later.
+     */
+    bool finishAsyncReadPixels(GrAsyncPixelRead, void* buffer, bool wait);
+
+    /**
+     * Delivers every proc-based asynchronous readback that is ready (all of them, when wait is
+     * true), oldest first. Returns the number of readbacks still in flight. Intended to be
+     * called once per frame by the rendering loop.
+     */
+    int processAsyncReadPixels(bool wait = false);
+
    /**
     * These flags can be used with the read/write pixels functions below.
     */
@@ -418,6 +501,10 @@ public:
         /** The src for write or dst read is unpremultiplied. This is only respected if both the
             config src and dst configs are an RGBA/BGRA 8888 format. */
         kUnpremul_PixelOpsFlag  = 0x4,
+        /** Hints that the src buffer for a write holds transient streamed data (e.g. video
+            frames). The backend may stage the upload through a pixel buffer ring so the transfer
+            overlaps with rendering rather than copying client memory synchronously. */
+        kStreamingSrc_PixelOpsFlag = 0x8,
     };
 
     /**
@@ -562,6 +649,27 @@ public:
     void dumpGpuStats(SkString*) const;
     void printGpuStats() const;
 
+    /** Accumulated GPU time for one batch type while GPU batch timing is enabled. */
+    struct GpuBatchTiming {
+        SkString fName;      //!< name of the batch type
+        uint64_t fGpuNanos;  //!< total GPU nanoseconds across timed submissions
+        int      fCount;     //!< number of timed submissions
+    };
+
+    /**
+     * Enables or disables GPU-side timing of batch submissions. When enabled and the backend
+     * exposes a GPU timer, each batch's draws are bracketed in a timer query and the elapsed
+     * time is aggregated per batch name. Timing is off by default and has its own GPU cost, so
+     * it is intended for diagnostics. Has no effect if the backend has no timer support.
+     */
+    void setGpuBatchTimingEnabled(bool enabled);
+    bool gpuBatchTimingEnabled() const;
+
+    /** Appends the accumulated batch timings to 'timings'. Results are best effort: submissions
+        whose timer results the GPU hasn't produced yet are not included. */
+    void getGpuBatchTimings(SkTArray<GpuBatchTiming>* timings) const;
+    void resetGpuBatchTimings();
+
 private:
     GrGpu*                          fGpu;
     GrResourceCache*                fResourceCache;
@@ -639,6 +747,24 @@ private:
                                      const SkDeviceProperties&,
                                      bool enableDistanceFieldFonts);
 
+    /**
+     * Builds the GPU glyph path range for the given typeface ahead of time, so that the
+     * first text draw using it does not stall on glyph path creation. Clients that know
+     * which fonts they will use can call this right after context creation. No-op unless
+     * the GPU supports path rendering.
+     */
+    void preloadFontGlyphs(SkTypeface*);
+
+    /**
+     * Compiles the GPU programs a picture's playback will need before it is first drawn.
+     * The picture is replayed once into a scratch render target with the given properties
+     * (pass the info and sample count of the surface it will later be drawn to, since
+     * program keys depend on target traits), so shader compiles, glyph uploads, and other
+     * first-use work happen here instead of mid-frame. The scratch target is budgeted and
+     * returns to the resource cache afterwards.
+     */
+    void prewarmPicturePrograms(const SkPicture*, const SkImageInfo&, int sampleCount = 0);
+
 
     /**
      * These functions create premul <-> unpremul effects if it is possible to generate a pair
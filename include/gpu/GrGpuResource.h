@@ -308,6 +308,9 @@ private:
     // This value reflects how recently this resource was accessed in the cache. This is maintained
     // by the cache.
     uint32_t                    fTimestamp;
+    // The wall clock time (SkTime::GetMSecs()) when this resource last became purgeable. This is
+    // maintained by the cache.
+    SkMSec                      fTimeWhenBecamePurgeable;
 
     static const size_t kInvalidGpuMemorySize = ~static_cast<size_t>(0);
     GrScratchKey                fScratchKey;
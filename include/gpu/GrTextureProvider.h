@@ -97,6 +97,15 @@ public:
     GrTexture* refScratchTexture(const GrSurfaceDesc&, ScratchTexMatch match,
                                  bool internalFlag = false);
 
+    /**
+     * Allocates a scratch texture for each desc (sized as a kApprox_ScratchTexMatch request
+     * would be) and immediately returns them all to the cache. Clients that know the sizes
+     * they will soon render to (e.g. their saveLayer targets) can call this at startup so
+     * those first scratch requests are cache hits instead of allocation stalls mid-frame.
+     * The textures are budgeted and will be purged normally if they go unused.
+     */
+    void prewarmScratchTextures(const GrSurfaceDesc descs[], int count);
+
     ///////////////////////////////////////////////////////////////////////////
     // Wrapped Backend Surfaces
 
@@ -608,6 +608,18 @@ static inline size_t GrCompressedFormatDataSize(GrPixelConfig config,
  */
 static const uint32_t kAll_GrBackendState = 0xffffffff;
 
+/**
+ * An opaque handle to a fence inserted into the GPU's command stream (see
+ * GrContext::flushAndInsertFence). The zero value is reserved to mean "no fence".
+ */
+typedef intptr_t GrFence;
+
+/**
+ * An opaque handle to an in-flight asynchronous pixel readback (see
+ * GrContext::asyncReadRenderTargetPixels). The zero value is reserved to mean "no readback".
+ */
+typedef intptr_t GrAsyncPixelRead;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #if GR_ALWAYS_ALLOCATE_ON_HEAP
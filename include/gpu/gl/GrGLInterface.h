@@ -150,6 +150,7 @@ public:
         GLPtr<GrGLBeginQueryProc> fBeginQuery;
         GLPtr<GrGLBindAttribLocationProc> fBindAttribLocation;
         GLPtr<GrGLBindBufferProc> fBindBuffer;
+        GLPtr<GrGLBindBufferRangeProc> fBindBufferRange;
         GLPtr<GrGLBindFragDataLocationProc> fBindFragDataLocation;
         GLPtr<GrGLBindFragDataLocationIndexedProc> fBindFragDataLocationIndexed;
         GLPtr<GrGLBindFramebufferProc> fBindFramebuffer;
@@ -162,11 +163,13 @@ public:
         GLPtr<GrGLBlendFuncProc> fBlendFunc;
         GLPtr<GrGLBlitFramebufferProc> fBlitFramebuffer;
         GLPtr<GrGLBufferDataProc> fBufferData;
+        GLPtr<GrGLBufferStorageProc> fBufferStorage;
         GLPtr<GrGLBufferSubDataProc> fBufferSubData;
         GLPtr<GrGLCheckFramebufferStatusProc> fCheckFramebufferStatus;
         GLPtr<GrGLClearProc> fClear;
         GLPtr<GrGLClearColorProc> fClearColor;
         GLPtr<GrGLClearStencilProc> fClearStencil;
+        GLPtr<GrGLClientWaitSyncProc> fClientWaitSync;
         GLPtr<GrGLColorMaskProc> fColorMask;
         GLPtr<GrGLCompileShaderProc> fCompileShader;
         GLPtr<GrGLCompressedTexImage2DProc> fCompressedTexImage2D;
@@ -182,18 +185,21 @@ public:
         GLPtr<GrGLDeleteQueriesProc> fDeleteQueries;
         GLPtr<GrGLDeleteRenderbuffersProc> fDeleteRenderbuffers;
         GLPtr<GrGLDeleteShaderProc> fDeleteShader;
+        GLPtr<GrGLDeleteSyncProc> fDeleteSync;
         GLPtr<GrGLDeleteTexturesProc> fDeleteTextures;
         GLPtr<GrGLDeleteVertexArraysProc> fDeleteVertexArrays;
         GLPtr<GrGLDepthMaskProc> fDepthMask;
         GLPtr<GrGLDisableProc> fDisable;
         GLPtr<GrGLDisableVertexAttribArrayProc> fDisableVertexAttribArray;
         GLPtr<GrGLDrawArraysProc> fDrawArrays;
+        GLPtr<GrGLDrawArraysInstancedProc> fDrawArraysInstanced;
         GLPtr<GrGLDrawBufferProc> fDrawBuffer;
         GLPtr<GrGLDrawBuffersProc> fDrawBuffers;
         GLPtr<GrGLDrawElementsProc> fDrawElements;
         GLPtr<GrGLEnableProc> fEnable;
         GLPtr<GrGLEnableVertexAttribArrayProc> fEnableVertexAttribArray;
         GLPtr<GrGLEndQueryProc> fEndQuery;
+        GLPtr<GrGLFenceSyncProc> fFenceSync;
         GLPtr<GrGLFinishProc> fFinish;
         GLPtr<GrGLFlushProc> fFlush;
         GLPtr<GrGLFlushMappedBufferRangeProc> fFlushMappedBufferRange;
@@ -217,6 +223,7 @@ public:
         GLPtr<GrGLGetQueryObjectui64vProc> fGetQueryObjectui64v;
         GLPtr<GrGLGetQueryObjectuivProc> fGetQueryObjectuiv;
         GLPtr<GrGLGetQueryivProc> fGetQueryiv;
+        GLPtr<GrGLGetProgramBinaryProc> fGetProgramBinary;
         GLPtr<GrGLGetProgramInfoLogProc> fGetProgramInfoLog;
         GLPtr<GrGLGetProgramivProc> fGetProgramiv;
         GLPtr<GrGLGetRenderbufferParameterivProc> fGetRenderbufferParameteriv;
@@ -226,6 +233,7 @@ public:
         GLPtr<GrGLGetStringProc> fGetString;
         GLPtr<GrGLGetStringiProc> fGetStringi;
         GLPtr<GrGLGetTexLevelParameterivProc> fGetTexLevelParameteriv;
+        GLPtr<GrGLGetUniformBlockIndexProc> fGetUniformBlockIndex;
         GLPtr<GrGLGetUniformLocationProc> fGetUniformLocation;
         GLPtr<GrGLInsertEventMarkerProc> fInsertEventMarker;
         GLPtr<GrGLInvalidateBufferDataProc> fInvalidateBufferData;
@@ -242,8 +250,11 @@ public:
         GLPtr<GrGLMapTexSubImage2DProc> fMapTexSubImage2D;
         GLPtr<GrGLMatrixLoadfProc> fMatrixLoadf;
         GLPtr<GrGLMatrixLoadIdentityProc> fMatrixLoadIdentity;
+        GLPtr<GrGLMultiDrawArraysIndirectProc> fMultiDrawArraysIndirect;
+        GLPtr<GrGLMultiDrawElementsIndirectProc> fMultiDrawElementsIndirect;
         GLPtr<GrGLPixelStoreiProc> fPixelStorei;
         GLPtr<GrGLPopGroupMarkerProc> fPopGroupMarker;
+        GLPtr<GrGLProgramBinaryProc> fProgramBinary;
         GLPtr<GrGLPushGroupMarkerProc> fPushGroupMarker;
         GLPtr<GrGLQueryCounterProc> fQueryCounter;
         GLPtr<GrGLReadBufferProc> fReadBuffer;
@@ -308,6 +319,7 @@ public:
         GLPtr<GrGLUniform4iProc> fUniform4i;
         GLPtr<GrGLUniform4fvProc> fUniform4fv;
         GLPtr<GrGLUniform4ivProc> fUniform4iv;
+        GLPtr<GrGLUniformBlockBindingProc> fUniformBlockBinding;
         GLPtr<GrGLUniformMatrix2fvProc> fUniformMatrix2fv;
         GLPtr<GrGLUniformMatrix3fvProc> fUniformMatrix3fv;
         GLPtr<GrGLUniformMatrix4fvProc> fUniformMatrix4fv;
@@ -319,6 +331,7 @@ public:
         GLPtr<GrGLVertexAttrib2fvProc> fVertexAttrib2fv;
         GLPtr<GrGLVertexAttrib3fvProc> fVertexAttrib3fv;
         GLPtr<GrGLVertexAttrib4fvProc> fVertexAttrib4fv;
+        GLPtr<GrGLVertexAttribDivisorProc> fVertexAttribDivisor;
         GLPtr<GrGLVertexAttribPointerProc> fVertexAttribPointer;
         GLPtr<GrGLViewportProc> fViewport;
 
@@ -12,6 +12,7 @@
 #include "SkImageGenerator.h"
 
 class SkData;
+class SkRWBuffer;
 class SkStreamRewindable;
 
 /**
@@ -101,6 +102,22 @@ namespace SkDecodingImageGenerator {
      *         SkImageGenerator constructor and and unref()ed on deletion.
      */
     SkImageGenerator* Create(SkData* data, const Options& opt);
+
+    /**
+     *  Like the stream version, but reads from an SkRWBuffer that may still
+     *  be growing (e.g. a download in progress), so decoding can begin while
+     *  bytes arrive.  Each decode re-polls the buffer for appended data
+     *  instead of failing at the old end; decodes of an incomplete image
+     *  report kIncompleteInput with the rows decoded so far, so installing
+     *  the generator in a discardable pixel ref and redrawing as data
+     *  arrives gives progressive display.
+     *
+     *  Returns NULL if the bytes appended so far do not yet contain a
+     *  decodable header; callers should retry once more data has arrived.
+     *
+     *  @param buffer Not owned; must outlive the returned generator.
+     */
+    SkImageGenerator* Create(const SkRWBuffer* buffer, const Options& opt);
 };
 
 //  // Example of most basic use case:
@@ -14,7 +14,9 @@
 #include "SkPicture.h"
 #include "SkWriter32.h"
 
+class SkBitmap;
 class SkCanvas;
+struct SkImageInfo;
 
 // XLib.h might have defined Status already (ugh)
 #ifdef Status
@@ -46,6 +48,28 @@ public:
      */
     void setBitmapDecoder(SkPicture::InstallPixelRefProc proc) { fProc = proc; }
 
+    /**
+     *  Proc for rebuilding a bitmap whose pixels were moved out-of-band by
+     *  SkGPipeController::transportBitmap(). handle is the value the
+     *  controller returned for this bitmap. The proc must install pixels
+     *  matching info and rowBytes into bitmap (typically by mapping the
+     *  shared memory block that handle names), and return false if the
+     *  handle cannot be resolved.
+     */
+    typedef bool (*BitmapHandleProc)(void* context, int32_t handle, const SkImageInfo& info,
+                                     size_t rowBytes, SkBitmap* bitmap);
+
+    /**
+     *  Set the proc (and a caller-owned context passed back to it) used to
+     *  resolve bitmap handles recorded by the writer's controller. Must be
+     *  installed before playback() if the writer's controller transports
+     *  bitmaps out-of-band.
+     */
+    void setBitmapHandleResolver(BitmapHandleProc proc, void* context) {
+        fHandleProc = proc;
+        fHandleContext = context;
+    }
+
     // data must be 4-byte aligned
     // length must be a multiple of 4
     Status playback(const void* data, size_t length, uint32_t playbackFlags = 0,
@@ -54,6 +78,8 @@ private:
     SkCanvas*                       fCanvas;
     class SkGPipeState*             fState;
     SkPicture::InstallPixelRefProc  fProc;
+    BitmapHandleProc                fHandleProc;
+    void*                           fHandleContext;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -87,6 +113,19 @@ public:
     virtual void notifyWritten(size_t bytes) = 0;
     virtual int numberOfReaders() const { return 1; }
 
+    /**
+     *  When bitmaps are being flattened for a cross process reader (see
+     *  SkGPipeWriter::kCrossProcess_Flag), this is called before a bitmap's
+     *  pixels are copied into the pipe. A controller whose transport can
+     *  share memory between the two processes (e.g. ashmem or shm) may move
+     *  the pixels out-of-band and return a non-negative handle naming them;
+     *  the pipe then records only the handle and the bitmap's geometry, and
+     *  the reader rebuilds the bitmap with the proc installed via
+     *  SkGPipeReader::setBitmapHandleResolver(). Return a negative value
+     *  (the default) to have the pixels copied into the stream as usual.
+     */
+    virtual int32_t transportBitmap(const SkBitmap&) { return -1; }
+
 private:
     friend class SkGPipeWriter;
     void setCanvas(SkGPipeCanvas*);
@@ -12,6 +12,7 @@
 #include "SkFontStyle.h"
 
 class SkData;
+class SkFontFallbackCache;
 class SkStreamAsset;
 class SkString;
 class SkTypeface;
@@ -37,6 +38,9 @@ class SK_API SkFontMgr : public SkRefCnt {
 public:
     SK_DECLARE_INST_COUNT(SkFontMgr)
 
+    SkFontMgr();
+    virtual ~SkFontMgr();
+
     int countFamilies() const;
     void getFamilyName(int index, SkString* familyName) const;
     SkFontStyleSet* createStyleSet(int index) const;
@@ -73,6 +77,9 @@ public:
      *  bcp47[0] is the least significant fallback, bcp47[bcp47Count-1] is the
      *  most significant. If no specified bcp47 codes match, any font with the
      *  requested character will be matched.
+     *
+     *  Matches are memoized per unicode block/style/locale, so repeated
+     *  queries for nearby characters do not re-run the port's fallback scan.
      */
     SkTypeface* matchFamilyStyleCharacter(const char familyName[], const SkFontStyle&,
                                           const char* bcp47[], int bcp47Count,
@@ -137,6 +144,9 @@ private:
     static SkFontMgr* Factory();    // implemented by porting layer
     friend SkFontMgr* sk_fontmgr_create_default();
 
+    // Memoizes onMatchFamilyStyleCharacter results; see SkFontMgr.cpp.
+    SkFontFallbackCache* fFallbackCache;
+
     typedef SkRefCnt INHERITED;
 };
 
@@ -116,6 +116,30 @@ public:
      */
     void setMaxRecordingStorage(size_t maxStorage);
 
+    /**
+     *  Enable or disable asynchronous playback.  When enabled, batches of
+     *  recorded commands are handed off to a dedicated playback thread over
+     *  a bounded queue, and recording immediately resumes into fresh storage,
+     *  so the calling thread no longer blocks for the duration of a playback
+     *  on flush or when the recording storage limit is reached.  The skip
+     *  optimization for hidden (overdrawn) frames still applies: chunks that
+     *  are waiting in the queue when skipping occurs are demoted to silent
+     *  playback on the playback thread.
+     *  While this mode is active, the surface is only guaranteed to be up to
+     *  date after an operation that reads it back (readPixels, accessBitmap,
+     *  newImageSnapshot), after disabling the mode, or after destruction;
+     *  results are then indistinguishable from synchronous playback.  The
+     *  NotificationClient callbacks that accompany a playback
+     *  (flushedDrawCommands, skippedPendingDrawCommands) are invoked on the
+     *  playback thread.
+     *  Asynchronous playback requires a raster surface and a platform with
+     *  condition variable support; on other configurations this call fails
+     *  and playback remains synchronous.
+     *  @param enable whether playback should be asynchronous.
+     *  @return true if asynchronous playback is active after the call.
+     */
+    bool setAsyncPlayback(bool enable);
+
     /**
      *  Returns the number of bytes currently allocated for the purpose of
      *  recording draw commands.
@@ -183,6 +207,8 @@ protected:
     void onDrawBitmapNine(const SkBitmap&, const SkIRect& center, const SkRect& dst,
                           const SkPaint*) override;
     void onDrawSprite(const SkBitmap&, int left, int top, const SkPaint*) override;
+    void onDrawSpriteBatch(const SkBitmap&, const SkIRect src[], const SkIPoint dst[],
+                           int count, const SkPaint*) override;
     void onDrawVertices(VertexMode vmode, int vertexCount,
                         const SkPoint vertices[], const SkPoint texs[],
                         const SkColor colors[], SkXfermode* xmode,
@@ -29,9 +29,15 @@ public:
      *      stream, so it should no be longer used directly.
      *      SkFrontBufferedStream will delete stream upon deletion.
      *  @param minBufferSize Minimum size of buffer required.
+     *  @param readAheadBytes If nonzero, a background thread keeps the
+     *      buffer filled this many bytes ahead of the read cursor (capped
+     *      at the buffer size), so reads of already fetched data do not
+     *      wait on a slow underlying stream. Silently ignored on platforms
+     *      without thread support.
      *  @return An SkStream that can buffer at least minBufferSize, or
      *      NULL on failure. The caller is required to delete when finished with
      *      this object.
      */
-    static SkStreamRewindable* Create(SkStream* stream, size_t minBufferSize);
+    static SkStreamRewindable* Create(SkStream* stream, size_t minBufferSize,
+                                      size_t readAheadBytes = 0);
 };
@@ -41,13 +41,33 @@ public:
     void print(SkWStream *o) const;
     bool equals(const SkRTConfBase *conf) const;
     bool isDefault() const { return fDefault == fValue; }
-    void set(const T& value) { fValue = value; }
+    void set(const T& value) {
+        fValue = value;
+        if (fChangeProc) {
+            fChangeProc(fValue, fChangeContext);
+        }
+    }
+
+    /** Called with the new value (and the registered context) every time set()
+        changes this variable, so knobs can be applied without polling.  If the
+        config file already overrode the default, the proc is invoked right away
+        with that startup value. */
+    typedef void (*ChangeProc)(const T &newValue, void *context);
+    void setChangeProc(ChangeProc proc, void *context) {
+        fChangeProc = proc;
+        fChangeContext = context;
+        if (fChangeProc && !this->isDefault()) {
+            fChangeProc(fValue, fChangeContext);
+        }
+    }
 protected:
     void doPrint(char *s) const;
 
-    T        fValue;
-    T        fDefault;
-    SkString fDescription;
+    T          fValue;
+    T          fDefault;
+    SkString   fDescription;
+    ChangeProc fChangeProc;
+    void      *fChangeContext;
 };
 
 #ifdef SK_DEVELOPER
@@ -59,10 +79,13 @@ protected:
    inside a source file whose linkage is dependent on the system. */
 #define SK_CONF_TRY_SET(confname, value) \
     skRTConfRegistry().set(confname, value, false)
+#define SK_CONF_SET_CHANGE_PROC(varName, proc, context) \
+    varName.setChangeProc(proc, context)
 #else
 #define SK_CONF_DECLARE(confType, varName, confName, defaultValue, description) static confType varName = defaultValue
 #define SK_CONF_SET(confname, value) (void) confname, (void) value
 #define SK_CONF_TRY_SET(confname, value) (void) confname, (void) value
+#define SK_CONF_SET_CHANGE_PROC(varName, proc, context) (void) proc, (void) context
 #endif
 
 /** \class SkRTConfRegistry
@@ -109,7 +132,9 @@ SkRTConf<T>::SkRTConf(const char *name, const T &defaultValue, const char *descr
     : SkRTConfBase(name)
     , fValue(defaultValue)
     , fDefault(defaultValue)
-    , fDescription(description) {
+    , fDescription(description)
+    , fChangeProc(NULL)
+    , fChangeContext(NULL) {
 
     T value;
     if (skRTConfRegistry().parse(fName.c_str(), &value)) {
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRingBufferEventTracer_DEFINED
+#define SkRingBufferEventTracer_DEFINED
+
+#include "SkEventTracer.h"
+#include "SkSpinlock.h"
+#include "SkString.h"
+
+class SkWStream;
+
+/**
+ *  A built-in SkEventTracer that records the SkTraceEvent macros into fixed-size
+ *  per-thread ring buffers, cheap enough to leave installed in release builds.
+ *
+ *  Each thread that emits an event gets its own ring, so recording an event is a
+ *  timestamp read plus a couple of stores under an uncontended spinlock; old events
+ *  are silently overwritten once a ring fills.  Categories that don't pass the
+ *  filter report themselves as disabled, so filtered-out macro sites never call
+ *  into the tracer at all.
+ *
+ *  Install it like any other tracer:
+ *      SkRingBufferEventTracer* tracer = SkNEW(SkRingBufferEventTracer);
+ *      SkEventTracer::SetInstance(tracer);  // takes ownership
+ *  and call snapshot() whenever telemetry is wanted; the output is JSON loadable
+ *  by chrome://tracing.
+ */
+class SK_API SkRingBufferEventTracer : public SkEventTracer {
+public:
+    explicit SkRingBufferEventTracer(int eventsPerThread = 4096);
+    virtual ~SkRingBufferEventTracer();
+
+    /**
+     *  Record only category groups whose name contains one of the given
+     *  comma-separated strings.  "*" (the default) records everything; ""
+     *  records nothing.  Takes effect for macro sites as they re-query their
+     *  category flag, so it is best set before tracing starts.
+     */
+    void setEnabledCategories(const char* categories);
+
+    /**
+     *  Serialize the current contents of every thread's ring (including threads
+     *  that have exited) as chrome://tracing JSON.  Recording can continue while
+     *  a snapshot is taken; each ring is briefly locked while it is copied out.
+     */
+    void snapshot(SkWStream*);
+
+    // SkEventTracer interface.
+    SkEventTracer::Handle addTraceEvent(char phase,
+                                        const uint8_t* categoryEnabledFlag,
+                                        const char* name,
+                                        uint64_t id,
+                                        int32_t numArgs,
+                                        const char** argNames,
+                                        const uint8_t* argTypes,
+                                        const uint64_t* argValues,
+                                        uint8_t flags) override;
+    void updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                  const char* name,
+                                  SkEventTracer::Handle handle) override;
+    const uint8_t* getCategoryGroupEnabled(const char* name) override;
+    const char* getCategoryGroupName(const uint8_t* categoryEnabledFlag) override;
+
+private:
+    struct Event {
+        uint64_t       fTicks;
+        const char*    fName;             // always a string literal at the macro site
+        const uint8_t* fCategoryEnabled;
+        char           fPhase;
+    };
+
+    struct Ring {
+        Ring*         fNext;     // fRings list, guarded by fRingsLock
+        SkPODSpinlock fLock;     // guards fCursor/fEvents against snapshot()
+        int32_t       fTid;
+        uint32_t      fCursor;   // total events ever written; slot is fCursor % capacity
+        Event*        fEvents;
+    };
+
+    // The macros cache the pointer we hand out from getCategoryGroupEnabled(), so
+    // entries live in a fixed array and are never moved or freed.
+    struct CategoryState {
+        const char* fName;
+        uint8_t     fEnabled;
+    };
+    enum { kMaxCategories = 64 };
+
+    static void* CreateRing();
+    Ring* currentRing();
+    void append(Ring*, char phase, const uint8_t* categoryEnabledFlag, const char* name);
+    bool categoryPassesFilter(const char* name) const;
+
+    const int     fEventsPerThread;
+    uint64_t      fBaseTicks;   // tick/wall-clock pair from the constructor, used with a
+    double        fBaseNSecs;   // second pair at snapshot() time to scale ticks to microseconds
+
+    SkSpinlock    fRingsLock;
+    Ring*         fRings;       // all rings ever created, newest first
+    int32_t       fNextTid;
+
+    SkSpinlock    fCategoryLock;
+    CategoryState fCategories[kMaxCategories];
+    int           fCategoryCount;
+    SkString      fFilter;
+
+    typedef SkEventTracer INHERITED;
+};
+
+#endif  // SkRingBufferEventTracer_DEFINED
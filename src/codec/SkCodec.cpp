@@ -11,6 +11,7 @@
 #include "SkCodec_libgif.h"
 #include "SkCodec_libico.h"
 #include "SkCodec_libpng.h"
+#include "SkCodec_libwebp.h"
 #include "SkCodec_wbmp.h"
 #include "SkCodecPriv.h"
 #include "SkJpegCodec.h"
@@ -24,6 +25,7 @@ struct DecoderProc {
 static const DecoderProc gDecoderProcs[] = {
     { SkPngCodec::IsPng, SkPngCodec::NewFromStream },
     { SkJpegCodec::IsJpeg, SkJpegCodec::NewFromStream },
+    { SkWebpCodec::IsWebp, SkWebpCodec::NewFromStream },
     { SkGifCodec::IsGif, SkGifCodec::NewFromStream },
     { SkIcoCodec::IsIco, SkIcoCodec::NewFromStream },
     { SkBmpCodec::IsBmp, SkBmpCodec::NewFromStream },
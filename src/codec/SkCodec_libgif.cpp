@@ -12,6 +12,7 @@
 #include "SkGifInterlaceIter.h"
 #include "SkStream.h"
 #include "SkSwizzler.h"
+#include "SkTDArray.h"
 #include "SkUtils.h"
 
 /*
@@ -208,6 +209,12 @@ SkGifCodec::SkGifCodec(const SkImageInfo& srcInfo, SkStream* stream,
                        GifFileType* gif)
     : INHERITED(srcInfo, stream)
     , fGif(gif)
+    , fFillIndex(0)
+    , fFrameLeft(0)
+    , fFrameTop(0)
+    , fFrameWidth(0)
+    , fFrameHeight(0)
+    , fFrameIsSubset(false)
 {}
 
 /*
@@ -235,13 +242,13 @@ static bool conversion_possible(const SkImageInfo& dst,
 }
 
 /*
- * Initiates the gif decode
+ * Performs the decode setup shared between onGetPixels and the scanline
+ * decoder
  */
-SkCodec::Result SkGifCodec::onGetPixels(const SkImageInfo& dstInfo,
-                                        void* dst, size_t dstRowBytes,
-                                        const Options& opts,
-                                        SkPMColor* inputColorPtr,
-                                        int* inputColorCount) {
+SkCodec::Result SkGifCodec::prepareToDecode(const SkImageInfo& dstInfo,
+                                            SkPMColor* inputColorPtr,
+                                            int* inputColorCount,
+                                            const Options& opts) {
     // Rewind if necessary
     SkCodec::RewindState rewindState = this->rewindIfNeeded();
     if (rewindState == kCouldNotRewind_RewindState) {
@@ -336,17 +343,10 @@ SkCodec::Result SkGifCodec::onGetPixels(const SkImageInfo& dstInfo,
                     imageTop = 0;
                 }
 
-                // Create a color table to store colors the giflib colorMap
-                SkPMColor alternateColorPtr[256];
-                SkPMColor* colorTable;
-                SkColorType dstColorType = dstInfo.colorType();
-                if (kIndex_8_SkColorType == dstColorType) {
-                    SkASSERT(NULL != inputColorPtr);
-                    SkASSERT(NULL != inputColorCount);
-                    colorTable = inputColorPtr;
-                } else {
-                    colorTable = alternateColorPtr;
-                }
+                // Build the color table from the giflib colorMap.  It is
+                // stored on the codec so that it outlives this call; the
+                // scanline decoder swizzles from it lazily.
+                SkPMColor* colorTable = fColorTable;
 
                 // Set up the color table
                 uint32_t colorCount = 0;
@@ -372,7 +372,6 @@ SkCodec::Result SkGifCodec::onGetPixels(const SkImageInfo& dstInfo,
 
                 // This is used to fill unspecified pixels in the image data.
                 uint32_t fillIndex = fGif->SBackGroundColor;
-                ZeroInitialized zeroInit = opts.fZeroInitialized;
 
                 // Gifs have the option to specify the color at a single
                 // index of the color table as transparent.
@@ -397,96 +396,27 @@ SkCodec::Result SkGifCodec::onGetPixels(const SkImageInfo& dstInfo,
                     }
                 }
 
-                // Check if we can skip filling the background of the image.  We
-                // may be able to if the memory is zero initialized.
-                bool skipBackground =
-                        ((kN32_SkColorType == dstColorType && colorTable[fillIndex] == 0) ||
-                        (kIndex_8_SkColorType == dstColorType && fillIndex == 0)) &&
-                        kYes_ZeroInitialized == zeroInit;
-
-
                 // Fill in the color table for indices greater than color count.
                 // This allows for predictable, safe behavior.
                 for (uint32_t i = colorCount; i < maxColors; i++) {
                     colorTable[i] = colorTable[fillIndex];
                 } 
 
-                // Check if image is only a subset of the image frame
-                SkAutoTDelete<SkSwizzler> swizzler(NULL);
-                if (innerWidth < width || innerHeight < height) {
-
-                    // Modify the destination info
-                    const SkImageInfo subsetDstInfo =
-                            dstInfo.makeWH(innerWidth, innerHeight);
-
-                    // Fill the destination with the fill color
-                    // FIXME: This may not be the behavior that we want for
-                    //        animated gifs where we draw on top of the
-                    //        previous frame.
-                    if (!skipBackground) {
-                        SkSwizzler::Fill(dst, dstInfo, dstRowBytes, height, fillIndex, colorTable);
-                    }
-
-                    // Modify the dst pointer
-                    const int32_t dstBytesPerPixel =
-                            SkColorTypeBytesPerPixel(dstColorType);
-                    void* subsetDst = SkTAddOffset<void*>(dst,
-                            dstRowBytes * imageTop +
-                            dstBytesPerPixel * imageLeft);
-
-                    // Create the subset swizzler
-                    swizzler.reset(SkSwizzler::CreateSwizzler(
-                            SkSwizzler::kIndex, colorTable, subsetDstInfo,
-                            subsetDst, dstRowBytes, zeroInit));
-                } else {
-                    // Create the fully dimensional swizzler
-                    swizzler.reset(SkSwizzler::CreateSwizzler(
-                            SkSwizzler::kIndex, colorTable, dstInfo, dst,
-                            dstRowBytes, zeroInit));
+                // Copy the color table to the client if they requested kIndex8
+                if (kIndex_8_SkColorType == dstInfo.colorType()) {
+                    SkASSERT(NULL != inputColorPtr);
+                    SkASSERT(NULL != inputColorCount);
+                    memcpy(inputColorPtr, colorTable, maxColors * sizeof(SkPMColor));
                 }
 
-                // Stores output from dgiflib and input to the swizzler
-                SkAutoTDeleteArray<uint8_t>
-                        buffer(SkNEW_ARRAY(uint8_t, innerWidth));
-
-                // Check the interlace flag and iterate over rows of the input
-                if (fGif->Image.Interlace) {
-                    // In interlace mode, the rows of input are rearranged in
-                    // the output image.  We use an iterator to take care of
-                    // the rearranging.
-                    SkGifInterlaceIter iter(innerHeight);
-                    for (int32_t y = 0; y < innerHeight; y++) {
-                        if (GIF_ERROR == DGifGetLine(fGif, buffer.get(),
-                                innerWidth)) {
-                            // Recover from error by filling remainder of image
-                            if (!skipBackground) {
-                                memset(buffer.get(), fillIndex, innerWidth);
-                                for (; y < innerHeight; y++) {
-                                    swizzler->next(buffer.get(), iter.nextY());
-                                }
-                            }
-                            return gif_error(SkStringPrintf(
-                                    "Could not decode line %d of %d.\n",
-                                    y, height - 1).c_str(), kIncompleteInput);
-                        }
-                        swizzler->next(buffer.get(), iter.nextY());
-                    }
-                } else {
-                    // Standard mode
-                    for (int32_t y = 0; y < innerHeight; y++) {
-                        if (GIF_ERROR == DGifGetLine(fGif, buffer.get(),
-                                innerWidth)) {
-                            if (!skipBackground) {
-                                SkSwizzler::Fill(swizzler->getDstRow(), dstInfo, dstRowBytes,
-                                        innerHeight - y, fillIndex, colorTable);
-                            }
-                            return gif_error(SkStringPrintf(
-                                    "Could not decode line %d of %d.\n",
-                                    y, height - 1).c_str(), kIncompleteInput);
-                        }
-                        swizzler->next(buffer.get());
-                    }
-                }
+                // Save the state that onGetPixels and the scanline decoder
+                // need to perform the decode.
+                fFillIndex = fillIndex;
+                fFrameLeft = imageLeft;
+                fFrameTop = imageTop;
+                fFrameWidth = innerWidth;
+                fFrameHeight = innerHeight;
+                fFrameIsSubset = (innerWidth < width || innerHeight < height);
 
                 // FIXME: Gif files may have multiple images stored in a single
                 //        file.  This is most commonly used to enable
@@ -568,3 +498,183 @@ SkCodec::Result SkGifCodec::onGetPixels(const SkImageInfo& dstInfo,
     return gif_error("Could not find any images to decode in gif file.\n",
             kInvalidInput);
 }
+
+/*
+ * Initiates the gif decode
+ */
+SkCodec::Result SkGifCodec::onGetPixels(const SkImageInfo& dstInfo,
+                                        void* dst, size_t dstRowBytes,
+                                        const Options& opts,
+                                        SkPMColor* inputColorPtr,
+                                        int* inputColorCount) {
+    const Result result = this->prepareToDecode(dstInfo, inputColorPtr, inputColorCount, opts);
+    if (kSuccess != result) {
+        return result;
+    }
+
+    const int32_t height = dstInfo.height();
+    const SkColorType dstColorType = dstInfo.colorType();
+
+    // Check if we can skip filling the background of the image.  We
+    // may be able to if the memory is zero initialized.
+    const bool skipBackground =
+            ((kN32_SkColorType == dstColorType && fColorTable[fFillIndex] == 0) ||
+            (kIndex_8_SkColorType == dstColorType && fFillIndex == 0)) &&
+            kYes_ZeroInitialized == opts.fZeroInitialized;
+
+    // Check if image is only a subset of the image frame
+    SkAutoTDelete<SkSwizzler> swizzler(NULL);
+    if (fFrameIsSubset) {
+
+        // Modify the destination info
+        const SkImageInfo subsetDstInfo =
+                dstInfo.makeWH(fFrameWidth, fFrameHeight);
+
+        // Fill the destination with the fill color
+        // FIXME: This may not be the behavior that we want for
+        //        animated gifs where we draw on top of the
+        //        previous frame.
+        if (!skipBackground) {
+            SkSwizzler::Fill(dst, dstInfo, dstRowBytes, height, fFillIndex, fColorTable);
+        }
+
+        // Modify the dst pointer
+        const int32_t dstBytesPerPixel =
+                SkColorTypeBytesPerPixel(dstColorType);
+        void* subsetDst = SkTAddOffset<void*>(dst,
+                dstRowBytes * fFrameTop +
+                dstBytesPerPixel * fFrameLeft);
+
+        // Create the subset swizzler
+        swizzler.reset(SkSwizzler::CreateSwizzler(
+                SkSwizzler::kIndex, fColorTable, subsetDstInfo,
+                subsetDst, dstRowBytes, opts.fZeroInitialized));
+    } else {
+        // Create the fully dimensional swizzler
+        swizzler.reset(SkSwizzler::CreateSwizzler(
+                SkSwizzler::kIndex, fColorTable, dstInfo, dst,
+                dstRowBytes, opts.fZeroInitialized));
+    }
+
+    // Stores output from dgiflib and input to the swizzler
+    SkAutoTDeleteArray<uint8_t>
+            buffer(SkNEW_ARRAY(uint8_t, fFrameWidth));
+
+    // Check the interlace flag and iterate over rows of the input
+    if (fGif->Image.Interlace) {
+        // In interlace mode, the rows of input are rearranged in
+        // the output image.  We use an iterator to take care of
+        // the rearranging.
+        SkGifInterlaceIter iter(fFrameHeight);
+        for (int32_t y = 0; y < fFrameHeight; y++) {
+            if (GIF_ERROR == DGifGetLine(fGif, buffer.get(),
+                    fFrameWidth)) {
+                // Recover from error by filling remainder of image
+                if (!skipBackground) {
+                    memset(buffer.get(), fFillIndex, fFrameWidth);
+                    for (; y < fFrameHeight; y++) {
+                        swizzler->next(buffer.get(), iter.nextY());
+                    }
+                }
+                return gif_error(SkStringPrintf(
+                        "Could not decode line %d of %d.\n",
+                        y, height - 1).c_str(), kIncompleteInput);
+            }
+            swizzler->next(buffer.get(), iter.nextY());
+        }
+    } else {
+        // Standard mode
+        for (int32_t y = 0; y < fFrameHeight; y++) {
+            if (GIF_ERROR == DGifGetLine(fGif, buffer.get(),
+                    fFrameWidth)) {
+                if (!skipBackground) {
+                    SkSwizzler::Fill(swizzler->getDstRow(), dstInfo, dstRowBytes,
+                            fFrameHeight - y, fFillIndex, fColorTable);
+                }
+                return gif_error(SkStringPrintf(
+                        "Could not decode line %d of %d.\n",
+                        y, height - 1).c_str(), kIncompleteInput);
+            }
+            swizzler->next(buffer.get());
+        }
+    }
+
+    return kSuccess;
+}
+
+/*
+ * Enables scanline decoding for gifs.  For interlaced gifs, rows are output
+ * in the encoded order and nextScanline() reports where each decoded row
+ * belongs in the destination image.
+ */
+class SkGifScanlineDecoder : public SkScanlineDecoder {
+public:
+    SkGifScanlineDecoder(const SkImageInfo& dstInfo, SkGifCodec* codec)
+        : INHERITED(dstInfo)
+        , fCodec(codec)
+        , fBuffer(SkNEW_ARRAY(uint8_t, dstInfo.width()))
+    {
+        if (fCodec->fGif->Image.Interlace) {
+            // Precompute the destination row of each decoded row so that
+            // onNextScanline can report it without consuming the iterator.
+            SkGifInterlaceIter iter(dstInfo.height());
+            fRowMap.setCount(dstInfo.height());
+            for (int32_t y = 0; y < dstInfo.height(); y++) {
+                fRowMap[y] = iter.nextY();
+            }
+        }
+    }
+
+    SkImageGenerator::Result onGetScanlines(void* dst, int count, size_t rowBytes) override {
+        for (int i = 0; i < count; i++) {
+            if (GIF_ERROR == DGifGetLine(fCodec->fGif, fBuffer.get(),
+                    this->dstInfo().width())) {
+                SkCodecPrintf("Gif Error: Could not decode line.\n");
+                return SkImageGenerator::kIncompleteInput;
+            }
+            fCodec->fSwizzler->setDstRow(dst);
+            fCodec->fSwizzler->next(fBuffer.get());
+            dst = SkTAddOffset<void>(dst, rowBytes);
+        }
+        return SkImageGenerator::kSuccess;
+    }
+
+    ScanlineOrder onGetScanlineOrder() const override {
+        return fRowMap.isEmpty() ? kTopDown_ScanlineOrder : kOutOfOrder_ScanlineOrder;
+    }
+
+    int onNextScanline(int nextDecodedLine) const override {
+        return fRowMap.isEmpty() ? nextDecodedLine : fRowMap[nextDecodedLine];
+    }
+
+private:
+    SkGifCodec*                 fCodec;     // Unowned.
+    SkAutoTDeleteArray<uint8_t> fBuffer;
+    SkTDArray<int32_t>          fRowMap;    // Empty unless the gif is interlaced.
+
+    typedef SkScanlineDecoder INHERITED;
+};
+
+SkScanlineDecoder* SkGifCodec::onGetScanlineDecoder(const SkImageInfo& dstInfo,
+        const Options& opts, SkPMColor inputColorPtr[], int* inputColorCount) {
+    if (kSuccess != this->prepareToDecode(dstInfo, inputColorPtr, inputColorCount, opts)) {
+        return NULL;
+    }
+
+    if (fFrameIsSubset) {
+        // The scanline decoder does not (yet) support frames that cover only
+        // a subset of the image.  Clients will fall back to a full decode.
+        SkCodecPrintf("Cannot decode subset gif frames a scanline at a time.\n");
+        return NULL;
+    }
+
+    // The destination is not known yet; each row is set with setDstRow() as
+    // it is decoded.
+    fSwizzler.reset(SkSwizzler::CreateSwizzler(SkSwizzler::kIndex, fColorTable, dstInfo,
+            NULL, dstInfo.minRowBytes(), opts.fZeroInitialized));
+    if (NULL == fSwizzler.get()) {
+        return NULL;
+    }
+
+    return SkNEW_ARGS(SkGifScanlineDecoder, (dstInfo, this));
+}
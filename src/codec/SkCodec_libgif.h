@@ -7,6 +7,7 @@
 
 #include "SkCodec.h"
 #include "SkImageInfo.h"
+#include "SkSwizzler.h"
 
 #include "gif_lib.h"
 
@@ -64,6 +65,9 @@ protected:
         return kGIF_SkEncodedFormat;
     }
 
+    SkScanlineDecoder* onGetScanlineDecoder(const SkImageInfo& dstInfo, const Options& options,
+            SkPMColor ctable[], int* ctableCount) override;
+
 private:
 
     /*
@@ -89,7 +93,30 @@ private:
      */
     SkGifCodec(const SkImageInfo& srcInfo, SkStream* stream, GifFileType* gif);
 
+    /*
+     * Performs the shared work at the start of a decode: rewinds the stream
+     * if necessary, validates the requested conversion, reads records up to
+     * and including the first image descriptor, and sets up the color table
+     * and the frame geometry fields below.  On success the gif is positioned
+     * so that DGifGetLine may be called.
+     */
+    Result prepareToDecode(const SkImageInfo& dstInfo, SkPMColor* inputColorPtr,
+            int* inputColorCount, const Options& opts);
+
     SkAutoTCallVProc<GifFileType, CloseGif> fGif; // owned
 
+    // These fields are set by prepareToDecode.
+    SkPMColor                   fColorTable[256];
+    uint32_t                    fFillIndex;
+    int32_t                     fFrameLeft;
+    int32_t                     fFrameTop;
+    int32_t                     fFrameWidth;
+    int32_t                     fFrameHeight;
+    bool                        fFrameIsSubset;
+    // Used by the scanline decoder; rows are set with setDstRow().
+    SkAutoTDelete<SkSwizzler>   fSwizzler;
+
+    friend class SkGifScanlineDecoder;
+
     typedef SkCodec INHERITED;
 };
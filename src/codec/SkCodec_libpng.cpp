@@ -428,7 +428,8 @@ SkCodec::Result SkPngCodec::initializeSwizzler(const SkImageInfo& requestedInfo,
                                                void* dst, size_t rowBytes,
                                                const Options& options,
                                                SkPMColor ctable[],
-                                               int* ctableCount) {
+                                               int* ctableCount,
+                                               int sampleX) {
     // FIXME: Could we use the return value of setjmp to specify the type of
     // error?
     if (setjmp(png_jmpbuf(fPng_ptr))) {
@@ -470,7 +471,7 @@ SkCodec::Result SkPngCodec::initializeSwizzler(const SkImageInfo& requestedInfo,
     // Create the swizzler.  SkPngCodec retains ownership of the color table.
     const SkPMColor* colors = fColorTable ? fColorTable->readColors() : NULL;
     fSwizzler.reset(SkSwizzler::CreateSwizzler(fSrcConfig, colors, requestedInfo,
-            dst, rowBytes, options.fZeroInitialized));
+            dst, rowBytes, options.fZeroInitialized, sampleX));
     if (!fSwizzler) {
         // FIXME: CreateSwizzler could fail for another reason.
         return kUnimplemented;
@@ -517,8 +518,20 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& requestedInfo, void*
     if (!this->handleRewind()) {
         return kCouldNotRewind;
     }
-    if (requestedInfo.dimensions() != this->getInfo().dimensions()) {
-        return kInvalidScale;
+    // A subset request sizes requestedInfo to the subset; the two have
+    // already been validated against each other.
+    int sampleX = 1;
+    int sampleY = 1;
+    if (NULL == options.fSubset &&
+            requestedInfo.dimensions() != this->getInfo().dimensions()) {
+        // Nearest-neighbor sampled decode.  Interlaced images are rejected
+        // below, once the number of passes is known.
+        if (requestedInfo.width() > this->getInfo().width() ||
+                requestedInfo.height() > this->getInfo().height()) {
+            return kInvalidScale;
+        }
+        sampleX = this->getInfo().width() / requestedInfo.width();
+        sampleY = this->getInfo().height() / requestedInfo.height();
     }
     if (!conversion_possible(requestedInfo, this->getInfo())) {
         return kInvalidConversion;
@@ -526,7 +539,7 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& requestedInfo, void*
 
     // Note that ctable and ctableCount may be modified if there is a color table
     const Result result = this->initializeSwizzler(requestedInfo, dst, rowBytes,
-                                                   options, ctable, ctableCount);
+                                                   options, ctable, ctableCount, sampleX);
 
     if (result != kSuccess) {
         return result;
@@ -541,6 +554,63 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& requestedInfo, void*
 
     SkASSERT(fNumberPasses != INVALID_NUMBER_PASSES);
     SkAutoMalloc storage;
+    if (options.fSubset) {
+        if (fNumberPasses > 1) {
+            // Every pass of an interlaced png touches every row, so there is
+            // nothing to save by decoding a subset.  The caller should decode
+            // the full image and crop.
+            return kUnimplemented;
+        }
+
+        const SkIRect& subset = *options.fSubset;
+        const int srcBPP = SkSwizzler::BytesPerPixel(fSrcConfig);
+        storage.reset(this->getInfo().width() * srcBPP);
+        uint8_t* srcRow = static_cast<uint8_t*>(storage.get());
+
+        // Decode and discard the rows above the subset
+        if (subset.top() > 0) {
+            png_read_rows(fPng_ptr, png_bytepp_NULL, png_bytepp_NULL, subset.top());
+        }
+
+        // Rows are decoded at full width; the swizzle starts at the subset's
+        // left edge.
+        for (int y = 0; y < subset.height(); y++) {
+            png_read_rows(fPng_ptr, &srcRow, png_bytepp_NULL, 1);
+            fReallyHasAlpha |= !SkSwizzler::IsOpaque(
+                    fSwizzler->next(srcRow + subset.left() * srcBPP));
+        }
+
+        // The rows below the subset are left undecoded, so do not call
+        // finish; the stream will be rewound before its next use.
+        return kSuccess;
+    }
+    if (1 != sampleX || 1 != sampleY) {
+        if (fNumberPasses > 1) {
+            // Every pass of an interlaced png touches every row, so a
+            // sampled decode saves nothing.
+            return kInvalidScale;
+        }
+
+        const int srcBPP = SkSwizzler::BytesPerPixel(fSrcConfig);
+        storage.reset(this->getInfo().width() * srcBPP);
+        uint8_t* srcRow = static_cast<uint8_t*>(storage.get());
+
+        // Nearest-neighbor row selection, centered like the column sampler
+        const int y0 = sampleY / 2;
+        int dstY = 0;
+        for (int y = 0; dstY < requestedInfo.height(); y++) {
+            png_read_rows(fPng_ptr, &srcRow, png_bytepp_NULL, 1);
+            if (y < y0 || 0 != (y - y0) % sampleY) {
+                continue;
+            }
+            fReallyHasAlpha |= !SkSwizzler::IsOpaque(fSwizzler->next(srcRow));
+            dstY++;
+        }
+
+        // The rows below the last sampled row are left undecoded, so do not
+        // call finish; the stream will be rewound before its next use.
+        return kSuccess;
+    }
     if (fNumberPasses > 1) {
         const int width = requestedInfo.width();
         const int height = requestedInfo.height();
@@ -644,6 +714,91 @@ private:
     typedef SkScanlineDecoder INHERITED;
 };
 
+class SkPngInterlacedScanlineDecoder : public SkScanlineDecoder {
+public:
+    SkPngInterlacedScanlineDecoder(const SkImageInfo& dstInfo, SkPngCodec* codec)
+        : INHERITED(dstInfo)
+        , fCodec(codec)
+        , fHasAlpha(false)
+        , fSrcRowBytes(dstInfo.width() * SkSwizzler::BytesPerPixel(codec->fSrcConfig))
+        , fCurrentRow(0)
+    {}
+
+    SkImageGenerator::Result onGetScanlines(void* dst, int count, size_t rowBytes) override {
+        if (NULL == fStorage.get()) {
+            const SkImageGenerator::Result result = this->decodeAllPasses();
+            if (SkImageGenerator::kSuccess != result) {
+                return result;
+            }
+        }
+
+        uint8_t* srcRow = static_cast<uint8_t*>(fStorage.get()) + fCurrentRow * fSrcRowBytes;
+        for (int i = 0; i < count; i++) {
+            fCodec->fSwizzler->setDstRow(dst);
+            fHasAlpha |= !SkSwizzler::IsOpaque(fCodec->fSwizzler->next(srcRow));
+            dst = SkTAddOffset<void>(dst, rowBytes);
+            srcRow += fSrcRowBytes;
+        }
+        fCurrentRow += count;
+        return SkImageGenerator::kSuccess;
+    }
+
+    SkImageGenerator::Result onSkipScanlines(int count) override {
+        // All of the decoding happens in decodeAllPasses, so skipping is just
+        // an advance within the buffered image.
+        if (NULL == fStorage.get()) {
+            const SkImageGenerator::Result result = this->decodeAllPasses();
+            if (SkImageGenerator::kSuccess != result) {
+                return result;
+            }
+        }
+
+        fCurrentRow += count;
+        return SkImageGenerator::kSuccess;
+    }
+
+    bool onReallyHasAlpha() const override { return fHasAlpha; }
+
+    ScanlineOrder onGetScanlineOrder() const override { return kNone_ScanlineOrder; }
+
+private:
+    /**
+     *  Each pass of an interlaced png touches every row, so producing any
+     *  final row requires reading the entire image. Decode all of the passes
+     *  into fStorage up front; getScanlines then only swizzles from there.
+     */
+    SkImageGenerator::Result decodeAllPasses() {
+        if (setjmp(png_jmpbuf(fCodec->fPng_ptr))) {
+            SkCodecPrintf("setjmp long jump!\n");
+            return SkImageGenerator::kInvalidInput;
+        }
+
+        const int height = this->dstInfo().height();
+        fStorage.reset(height * fSrcRowBytes);
+        uint8_t* const base = static_cast<uint8_t*>(fStorage.get());
+
+        for (int i = 0; i < fCodec->fNumberPasses; i++) {
+            uint8_t* row = base;
+            for (int y = 0; y < height; y++) {
+                uint8_t* srcRow = row;
+                png_read_rows(fCodec->fPng_ptr, &srcRow, png_bytepp_NULL, 1);
+                row += fSrcRowBytes;
+            }
+        }
+
+        fCodec->finish();
+        return SkImageGenerator::kSuccess;
+    }
+
+    SkPngCodec*         fCodec;     // Unowned.
+    bool                fHasAlpha;
+    const size_t        fSrcRowBytes;
+    int                 fCurrentRow;
+    SkAutoMalloc        fStorage;
+
+    typedef SkScanlineDecoder INHERITED;
+};
+
 SkScanlineDecoder* SkPngCodec::onGetScanlineDecoder(const SkImageInfo& dstInfo,
         const Options& options, SkPMColor ctable[], int* ctableCount) {
     if (!this->handleRewind()) {
@@ -664,15 +819,16 @@ SkScanlineDecoder* SkPngCodec::onGetScanlineDecoder(const SkImageInfo& dstInfo,
     // since we'll be manually updating the dstRow, but the SkSwizzler requires it to
     // be at least dstInfo.minRowBytes.
     if (this->initializeSwizzler(dstInfo, NULL, dstInfo.minRowBytes(), options, ctable,
-            ctableCount) != kSuccess) {
+            ctableCount, 1) != kSuccess) {
         SkCodecPrintf("failed to initialize the swizzler.\n");
         return NULL;
     }
 
     SkASSERT(fNumberPasses != INVALID_NUMBER_PASSES);
     if (fNumberPasses > 1) {
-        // We cannot efficiently do scanline decoding.
-        return NULL;
+        // Interlaced pngs cannot hand out rows as they are decoded; the
+        // interlaced decoder buffers the full image and reports kNone order.
+        return SkNEW_ARGS(SkPngInterlacedScanlineDecoder, (dstInfo, this));
     }
 
     return SkNEW_ARGS(SkPngScanlineDecoder, (dstInfo, this));
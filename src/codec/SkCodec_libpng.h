@@ -50,7 +50,8 @@ private:
 
     // Helper to set up swizzler and color table. Also calls png_read_update_info.
     Result initializeSwizzler(const SkImageInfo& requestedInfo, void* dst,
-                              size_t rowBytes, const Options&, SkPMColor*, int* ctableCount);
+                              size_t rowBytes, const Options&, SkPMColor*, int* ctableCount,
+                              int sampleX);
     // Calls rewindIfNeeded, and returns true if the decoder can continue.
     bool handleRewind();
     bool decodePalette(bool premultiply, int bitDepth, int* ctableCount);
@@ -58,6 +59,7 @@ private:
     void destroyReadStruct();
 
     friend class SkPngScanlineDecoder;
+    friend class SkPngInterlacedScanlineDecoder;
 
     typedef SkCodec INHERITED;
 };
@@ -0,0 +1,317 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCodec_libwebp.h"
+#include "SkColorPriv.h"
+#include "SkScanlineDecoder.h"
+#include "SkStream.h"
+#include "SkTemplates.h"
+
+// The RIFF container header plus enough of the VP8/VP8L/VP8X payload for
+// WebPGetFeatures.
+static const size_t WEBP_VP8_HEADER_SIZE = 64;
+
+// Default number of encoded bytes appended to the incremental decoder at a
+// time.
+static const size_t WEBP_IDECODE_BUFFER_SZ = 1 << 16;
+
+bool SkWebpCodec::IsWebp(SkStream* stream) {
+    // A webp file is a RIFF container: "RIFF" <file size> "WEBP".
+    char buffer[12];
+    if (stream->read(buffer, sizeof(buffer)) != sizeof(buffer)) {
+        return false;
+    }
+    return !memcmp(buffer, "RIFF", 4) && !memcmp(buffer + 8, "WEBP", 4);
+}
+
+SkCodec* SkWebpCodec::NewFromStream(SkStream* stream) {
+    SkAutoTDelete<SkStream> streamDeleter(stream);
+
+    unsigned char buffer[WEBP_VP8_HEADER_SIZE];
+    const size_t bytesRead = stream->read(buffer, WEBP_VP8_HEADER_SIZE);
+
+    WebPBitstreamFeatures features;
+    if (VP8_STATUS_OK != WebPGetFeatures(buffer, bytesRead, &features)) {
+        return NULL;
+    }
+
+    const SkAlphaType alphaType = features.has_alpha ? kPremul_SkAlphaType
+                                                     : kOpaque_SkAlphaType;
+    const SkImageInfo info = SkImageInfo::Make(features.width, features.height,
+                                               kN32_SkColorType, alphaType);
+    return SkNEW_ARGS(SkWebpCodec, (info, streamDeleter.detach(),
+                                    SkToBool(features.has_alpha)));
+}
+
+SkWebpCodec::SkWebpCodec(const SkImageInfo& srcInfo, SkStream* stream, bool hasAlpha)
+    : INHERITED(srcInfo, stream)
+    , fHasAlpha(hasAlpha)
+    , fUseThreads(true)
+    , fBufferSize(WEBP_IDECODE_BUFFER_SZ)
+{}
+
+SkISize SkWebpCodec::onGetScaledDimensions(float desiredScale) const {
+    SkISize dim = this->getInfo().dimensions();
+    dim.fWidth = SkTMax(1, SkScalarRoundToInt(desiredScale * dim.fWidth));
+    dim.fHeight = SkTMax(1, SkScalarRoundToInt(desiredScale * dim.fHeight));
+    return dim;
+}
+
+static WEBP_CSP_MODE webp_decode_mode(const SkImageInfo& dstInfo) {
+    const bool premultiply = kPremul_SkAlphaType == dstInfo.alphaType();
+    switch (dstInfo.colorType()) {
+        case kN32_SkColorType:
+            #if SK_PMCOLOR_BYTE_ORDER(B,G,R,A)
+                return premultiply ? MODE_bgrA : MODE_BGRA;
+            #elif SK_PMCOLOR_BYTE_ORDER(R,G,B,A)
+                return premultiply ? MODE_rgbA : MODE_RGBA;
+            #else
+                #error "Skia uses BGRA or RGBA byte order"
+            #endif
+        case kARGB_4444_SkColorType:
+            return premultiply ? MODE_rgbA_4444 : MODE_RGBA_4444;
+        case kRGB_565_SkColorType:
+            return MODE_RGB_565;
+        default:
+            return MODE_LAST;
+    }
+}
+
+bool SkWebpCodec::initializeConfig(WebPDecoderConfig* config, const SkImageInfo& dstInfo,
+                                   const Options& options) const {
+    // An image with alpha cannot drop it by decoding to an opaque color type.
+    if (fHasAlpha && kOpaque_SkAlphaType == dstInfo.alphaType()) {
+        return false;
+    }
+
+    const WEBP_CSP_MODE mode = webp_decode_mode(dstInfo);
+    if (MODE_LAST == mode) {
+        return false;
+    }
+
+    if (0 == WebPInitDecoderConfig(config)) {
+        return false;
+    }
+
+    config->output.colorspace = mode;
+    config->options.use_threads = fUseThreads ? 1 : 0;
+
+    if (options.fSubset) {
+        // getPixels already validated the subset against the image bounds and
+        // checked that the destination dimensions match it.
+        config->options.use_cropping = 1;
+        config->options.crop_left = options.fSubset->left();
+        config->options.crop_top = options.fSubset->top();
+        config->options.crop_width = options.fSubset->width();
+        config->options.crop_height = options.fSubset->height();
+    } else if (dstInfo.dimensions() != this->getInfo().dimensions()) {
+        config->options.use_scaling = 1;
+        config->options.scaled_width = dstInfo.width();
+        config->options.scaled_height = dstInfo.height();
+    }
+
+    return true;
+}
+
+SkImageGenerator::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
+                                                  size_t dstRowBytes, const Options& options,
+                                                  SkPMColor*, int*) {
+    if (kCouldNotRewind_RewindState == this->rewindIfNeeded()) {
+        return kCouldNotRewind;
+    }
+    // The incremental decoder consumes the whole stream, including the header
+    // bytes read by NewFromStream, so always restart from the beginning.
+    if (!this->stream()->rewind()) {
+        return kCouldNotRewind;
+    }
+
+    if (!options.fSubset
+            && (dstInfo.width() > this->getInfo().width()
+                || dstInfo.height() > this->getInfo().height())) {
+        return kInvalidScale;
+    }
+
+    WebPDecoderConfig config;
+    if (!this->initializeConfig(&config, dstInfo, options)) {
+        return kInvalidConversion;
+    }
+    config.output.u.RGBA.rgba = (uint8_t*) dst;
+    config.output.u.RGBA.stride = (int) dstRowBytes;
+    config.output.u.RGBA.size = dstInfo.getSafeSize(dstRowBytes);
+    config.output.is_external_memory = 1;
+
+    WebPIDecoder* idec = WebPIDecode(NULL, 0, &config);
+    if (NULL == idec) {
+        WebPFreeDecBuffer(&config.output);
+        return kInvalidInput;
+    }
+
+    SkAutoMalloc storage(fBufferSize);
+    uint8_t* buffer = (uint8_t*) storage.get();
+    VP8StatusCode status = VP8_STATUS_SUSPENDED;
+    while (VP8_STATUS_OK != status) {
+        const size_t bytesRead = this->stream()->read(buffer, fBufferSize);
+        if (0 == bytesRead) {
+            break;
+        }
+        status = WebPIAppend(idec, buffer, bytesRead);
+        if (VP8_STATUS_OK != status && VP8_STATUS_SUSPENDED != status) {
+            break;
+        }
+    }
+
+    Result result;
+    if (VP8_STATUS_OK == status) {
+        result = kSuccess;
+    } else if (VP8_STATUS_SUSPENDED == status) {
+        // The stream ended mid-image.  The rows decoded so far were written
+        // top-down directly into dst; clear the rest unless the caller told
+        // us the memory is already zeroed.
+        if (kNo_ZeroInitialized == options.fZeroInitialized) {
+            int rowsDecoded = 0;
+            if (NULL == WebPIDecGetRGB(idec, &rowsDecoded, NULL, NULL, NULL)) {
+                rowsDecoded = 0;
+            }
+            const size_t rowFill = dstInfo.width()
+                    * SkColorTypeBytesPerPixel(dstInfo.colorType());
+            for (int y = rowsDecoded; y < dstInfo.height(); y++) {
+                sk_bzero(SkTAddOffset<void>(dst, y * dstRowBytes), rowFill);
+            }
+        }
+        result = kIncompleteInput;
+    } else {
+        result = kInvalidInput;
+    }
+
+    WebPIDelete(idec);
+    WebPFreeDecBuffer(&config.output);
+    return result;
+}
+
+/*
+ * Scanline decoding feeds the incremental decoder only as far as needed for
+ * the requested rows, so callers can paint top-down while bytes arrive.
+ * libwebp owns the decoded buffer here (no external memory), since the full
+ * destination is not known up front.
+ */
+class SkWebpScanlineDecoder : public SkScanlineDecoder {
+public:
+    SkWebpScanlineDecoder(const SkImageInfo& dstInfo, SkWebpCodec* codec)
+        : INHERITED(dstInfo)
+        , fCodec(codec)
+        , fIdec(NULL)
+        , fNextRow(0)
+        , fFinished(false)
+    {}
+
+    ~SkWebpScanlineDecoder() {
+        if (fIdec != NULL) {
+            WebPIDelete(fIdec);
+            WebPFreeDecBuffer(&fConfig.output);
+        }
+    }
+
+    bool start(const SkWebpCodec::Options& options) {
+        if (!fCodec->initializeConfig(&fConfig, this->dstInfo(), options)) {
+            return false;
+        }
+        fIdec = WebPIDecode(NULL, 0, &fConfig);
+        return fIdec != NULL;
+    }
+
+protected:
+    SkImageGenerator::Result onGetScanlines(void* dst, int countLines,
+                                            size_t rowBytes) override {
+        const SkImageGenerator::Result result = this->decodeRows(fNextRow + countLines);
+
+        int rowsDecoded = 0;
+        int stride = 0;
+        const uint8_t* src = WebPIDecGetRGB(fIdec, &rowsDecoded, NULL, NULL, &stride);
+        const size_t rowFill = this->dstInfo().width()
+                * SkColorTypeBytesPerPixel(this->dstInfo().colorType());
+        for (int i = 0; i < countLines; i++) {
+            void* dstRow = SkTAddOffset<void>(dst, i * rowBytes);
+            const int row = fNextRow + i;
+            if (src != NULL && row < rowsDecoded) {
+                memcpy(dstRow, src + row * stride, rowFill);
+            } else {
+                sk_bzero(dstRow, rowFill);
+            }
+        }
+        fNextRow += countLines;
+        return result;
+    }
+
+    SkImageGenerator::Result onSkipScanlines(int countLines) override {
+        // The decoded rows stay in libwebp's internal buffer, so skipping is
+        // only bookkeeping.
+        fNextRow += countLines;
+        return SkImageGenerator::kSuccess;
+    }
+
+private:
+    /*
+     * Feeds the stream to the incremental decoder until at least neededRows
+     * rows are available or the input ends.
+     */
+    SkImageGenerator::Result decodeRows(int neededRows) {
+        while (!fFinished && this->rowsDecoded() < neededRows) {
+            SkAutoMalloc storage(fCodec->fBufferSize);
+            uint8_t* buffer = (uint8_t*) storage.get();
+            const size_t bytesRead = fCodec->stream()->read(buffer, fCodec->fBufferSize);
+            if (0 == bytesRead) {
+                fFinished = true;
+                return SkImageGenerator::kIncompleteInput;
+            }
+            const VP8StatusCode status = WebPIAppend(fIdec, buffer, bytesRead);
+            if (VP8_STATUS_OK == status) {
+                fFinished = true;
+            } else if (VP8_STATUS_SUSPENDED != status) {
+                fFinished = true;
+                return SkImageGenerator::kInvalidInput;
+            }
+        }
+        return this->rowsDecoded() >= neededRows ? SkImageGenerator::kSuccess
+                                                 : SkImageGenerator::kIncompleteInput;
+    }
+
+    int rowsDecoded() const {
+        int rows = 0;
+        return WebPIDecGetRGB(fIdec, &rows, NULL, NULL, NULL) != NULL ? rows : 0;
+    }
+
+    SkWebpCodec*      fCodec;     // Unowned.
+    WebPIDecoder*     fIdec;
+    WebPDecoderConfig fConfig;
+    int               fNextRow;
+    bool              fFinished;
+
+    typedef SkScanlineDecoder INHERITED;
+};
+
+SkScanlineDecoder* SkWebpCodec::onGetScanlineDecoder(const SkImageInfo& dstInfo,
+                                                     const Options& options,
+                                                     SkPMColor*, int*) {
+    if (kCouldNotRewind_RewindState == this->rewindIfNeeded()) {
+        return NULL;
+    }
+    if (!this->stream()->rewind()) {
+        return NULL;
+    }
+
+    if (dstInfo.width() > this->getInfo().width()
+            || dstInfo.height() > this->getInfo().height()) {
+        return NULL;
+    }
+
+    SkAutoTDelete<SkWebpScanlineDecoder> decoder(
+            SkNEW_ARGS(SkWebpScanlineDecoder, (dstInfo, this)));
+    if (!decoder->start(options)) {
+        return NULL;
+    }
+    return decoder.detach();
+}
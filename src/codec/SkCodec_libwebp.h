@@ -0,0 +1,99 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCodec_libwebp_DEFINED
+#define SkCodec_libwebp_DEFINED
+
+#include "SkCodec.h"
+#include "SkEncodedFormat.h"
+#include "SkImageInfo.h"
+
+#include "webp/decode.h"
+
+class SkScanlineDecoder;
+class SkStream;
+
+/*
+ * This class implements the decoding for webp images, built on libwebp's
+ * incremental API so rows can be consumed top-down while bytes arrive.
+ */
+class SkWebpCodec : public SkCodec {
+public:
+    /*
+     * Checks the start of the stream for the RIFF/WEBP signature.
+     * Does not take ownership of the stream.
+     */
+    static bool IsWebp(SkStream*);
+
+    /*
+     * Assumes IsWebp was called and returned true.
+     * Takes ownership of the stream.
+     */
+    static SkCodec* NewFromStream(SkStream*);
+
+    /*
+     * Controls libwebp's internal multi-threaded decode, on by default.
+     * This version of libwebp treats the request as a boolean and chooses
+     * the worker count itself.
+     */
+    void setUseThreads(bool useThreads) { fUseThreads = useThreads; }
+
+    /*
+     * Sets how many encoded bytes are handed to the incremental decoder per
+     * append.  Smaller buffers surface decoded rows sooner while the stream
+     * is still arriving; larger ones reduce per-append overhead.
+     */
+    void setIncrementalBufferSize(size_t size) {
+        fBufferSize = SkTMax<size_t>(size, 1);
+    }
+
+protected:
+    /*
+     * Initiates the webp decode
+     */
+    Result onGetPixels(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes, const Options&,
+            SkPMColor*, int*) override;
+
+    SkEncodedFormat onGetEncodedFormat() const override {
+        return kWEBP_SkEncodedFormat;
+    }
+
+    /*
+     * libwebp can rescale to any smaller dimensions on the fly
+     */
+    SkISize onGetScaledDimensions(float desiredScale) const override;
+
+    SkScanlineDecoder* onGetScanlineDecoder(const SkImageInfo& dstInfo, const Options& options,
+            SkPMColor ctable[], int* ctableCount) override;
+
+    bool onReallyHasAlpha() const override { return fHasAlpha; }
+
+private:
+    /*
+     * Creates an instance of the decoder
+     * Called only by NewFromStream
+     */
+    SkWebpCodec(const SkImageInfo& srcInfo, SkStream* stream, bool hasAlpha);
+
+    /*
+     * Fills in config for a decode to dstInfo, including the output color
+     * mode, the thread hint, and any cropping or scaling.  Returns false if
+     * the requested conversion is not supported.
+     */
+    bool initializeConfig(WebPDecoderConfig* config, const SkImageInfo& dstInfo,
+            const Options& options) const;
+
+    const bool fHasAlpha;
+    bool       fUseThreads;
+    size_t     fBufferSize;
+
+    friend class SkWebpScanlineDecoder;
+
+    typedef SkCodec INHERITED;
+};
+
+#endif
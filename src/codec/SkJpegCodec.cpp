@@ -12,6 +12,8 @@
 #include "SkCodecPriv.h"
 #include "SkColorPriv.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
+#include "SkTDArray.h"
 #include "SkTemplates.h"
 #include "SkTypes.h"
 
@@ -278,16 +280,460 @@ bool SkJpegCodec::scaleToDimensions(uint32_t dstWidth, uint32_t dstHeight) {
     return true;
 }
 
+/*
+ * Chooses the IDCT scale and sampling rates for the requested dimensions
+ */
+bool SkJpegCodec::scaleToCoveringDimensions(uint32_t dstWidth, uint32_t dstHeight,
+                                            int* sampleX, int* sampleY) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    SkASSERT(1 == dinfo->scale_num);
+    SkASSERT(1 == dinfo->scale_denom);
+    jpeg_calc_output_dimensions(dinfo);
+    if (dstWidth > dinfo->output_width || dstHeight > dinfo->output_height) {
+        return fDecoderMgr->returnFalse("cannot upscale");
+    }
+
+    // Shrink the IDCT output as far as it goes while still covering the
+    // request; sampling closes the remaining gap.
+    while (dinfo->scale_denom < 8) {
+        dinfo->scale_denom *= 2;
+        jpeg_calc_output_dimensions(dinfo);
+        if (dinfo->output_width < dstWidth || dinfo->output_height < dstHeight) {
+            // Gone too far; back up to the last covering scale
+            dinfo->scale_denom /= 2;
+            jpeg_calc_output_dimensions(dinfo);
+            break;
+        }
+    }
+
+    *sampleX = dinfo->output_width / dstWidth;
+    *sampleY = dinfo->output_height / dstHeight;
+    return true;
+}
+
 /*
  * Create the swizzler based on the encoded format
  */
 void SkJpegCodec::initializeSwizzler(const SkImageInfo& dstInfo,
                                      void* dst, size_t dstRowBytes,
-                                     const Options& options) {
+                                     const Options& options, int sampleX) {
     SkSwizzler::SrcConfig srcConfig = get_src_config(*fDecoderMgr->dinfo());
+    fSwizzler.reset(SkSwizzler::CreateSwizzler(srcConfig, NULL, dstInfo, dst, dstRowBytes,
+            options.fZeroInitialized, sampleX));
+    fSrcRowBytes = SkSwizzler::BytesPerPixel(srcConfig) * fDecoderMgr->dinfo()->output_width;
+}
+
+/*
+ * Parses the marker segments that precede the entropy-coded data of a
+ * baseline jpeg and locates its restart markers.
+ *
+ * On success:
+ * header holds a copy of the segments a standalone decoder needs to decode
+ * any slice of the scan (everything from SOI through the SOS header, minus
+ * comment and metadata segments).
+ * restartOffsets holds the offset of the first entropy byte following each
+ * RSTn marker.
+ * entropyStart and entropyEnd bound the entropy-coded data of the scan.
+ *
+ * Returns false for anything unexpected, including a scan that is not
+ * terminated by EOI (a multi-scan image cannot be partitioned).
+ */
+static bool scan_restart_markers(const uint8_t* data, size_t size, SkTDArray<uint8_t>* header,
+                                 SkTDArray<size_t>* restartOffsets, size_t* entropyStart,
+                                 size_t* entropyEnd) {
+    if (size < 4 || 0xFF != data[0] || 0xD8 != data[1]) {
+        return false;
+    }
+
+    // Copy SOI
+    header->append(2, data);
+    size_t pos = 2;
+
+    // Walk the marker segments up to and including the SOS header
+    for (;;) {
+        if (pos + 4 > size || 0xFF != data[pos]) {
+            return false;
+        }
+        const uint8_t marker = data[pos + 1];
+        if (0xFF == marker) {
+            // Fill byte
+            pos++;
+            continue;
+        }
+
+        // Standalone markers should not appear before the entropy data
+        if ((marker >= JPEG_RST0 && marker <= JPEG_RST0 + 7) || 0xD8 == marker ||
+                0xD9 == marker || 0x01 == marker) {
+            return false;
+        }
+
+        const size_t length = 2 + ((data[pos + 2] << 8) | data[pos + 3]);
+        if (pos + length > size) {
+            return false;
+        }
+
+        // Comments and metadata are not needed to decode a slice.  APP0
+        // (JFIF) and APP14 (Adobe) are kept because they affect the color
+        // space negotiation.
+        bool keep = true;
+        if (JPEG_COM == marker) {
+            keep = false;
+        } else if (marker > JPEG_APP0 && marker <= JPEG_APP0 + 15 &&
+                JPEG_APP0 + 14 != marker) {
+            keep = false;
+        }
+        if (keep) {
+            header->append(length, data + pos);
+        }
+
+        pos += length;
+        if (0xDA == marker) {
+            // SOS: the entropy-coded data follows
+            *entropyStart = pos;
+            break;
+        }
+    }
+
+    // Walk the entropy-coded data recording the restart markers
+    while (pos + 1 < size) {
+        if (0xFF != data[pos]) {
+            pos++;
+            continue;
+        }
+        const uint8_t marker = data[pos + 1];
+        if (0x00 == marker) {
+            // Stuffed byte
+            pos += 2;
+            continue;
+        }
+        if (0xFF == marker) {
+            // Fill byte
+            pos++;
+            continue;
+        }
+        if (marker >= JPEG_RST0 && marker <= JPEG_RST0 + 7) {
+            *restartOffsets->append() = pos + 2;
+            pos += 2;
+            continue;
+        }
+
+        // Only a single-scan image can be partitioned, so the scan must be
+        // terminated by EOI.
+        if (0xD9 != marker) {
+            return false;
+        }
+        *entropyEnd = pos;
+        return true;
+    }
+
+    // Ran off the end of the data without finding EOI
+    return false;
+}
+
+/*
+ * Work descriptor for one parallel decode slice.  fData holds a synthesized
+ * jpeg: the shared header followed by the entropy data of a run of restart
+ * intervals and a trailing EOI.
+ */
+struct JpegSliceTask {
+    SkAutoMalloc                    fData;
+    size_t                          fSize;
+    J_COLOR_SPACE                   fColorSpace;
+    SkImageInfo                     fDstInfo;
+    void*                           fDst;
+    size_t                          fDstRowBytes;
+    uint32_t                        fSkipRows;
+    uint32_t                        fRows;
+    SkImageGenerator::ZeroInitialized fZeroInitialized;
+    bool                            fSuccess;
+};
+
+/*
+ * Decodes one slice on a worker thread using its own decompress struct
+ */
+static void decode_jpeg_slice(JpegSliceTask* task) {
+    task->fSuccess = false;
+
+    SkMemoryStream stream(task->fData.get(), task->fSize, false);
+    JpegDecoderMgr decoderMgr(&stream);
+    if (setjmp(decoderMgr.getJmpBuf())) {
+        return;
+    }
+    decoderMgr.init();
+
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return;
+    }
+
+    // Match the color space negotiated by the owning codec so that every
+    // slice produces rows in the same source format
+    dinfo->out_color_space = task->fColorSpace;
+    if (!jpeg_start_decompress(dinfo)) {
+        return;
+    }
+
+    const SkSwizzler::SrcConfig srcConfig = get_src_config(*dinfo);
+    SkAutoTDelete<SkSwizzler> swizzler(SkSwizzler::CreateSwizzler(srcConfig, NULL,
+            task->fDstInfo, task->fDst, task->fDstRowBytes, task->fZeroInitialized));
+    if (NULL == swizzler.get()) {
+        return;
+    }
+
+    const size_t srcRowBytes = SkSwizzler::BytesPerPixel(srcConfig) * task->fDstInfo.width();
+    const uint32_t rowsPerDecode = dinfo->rec_outbuf_height;
+    SkASSERT(rowsPerDecode <= 4);
+    SkAutoTDeleteArray<uint8_t> srcBuffer(SkNEW_ARRAY(uint8_t, srcRowBytes * rowsPerDecode));
+    JSAMPLE* srcRows[4];
+    uint8_t* srcPtr = srcBuffer.get();
+    for (uint8_t i = 0; i < rowsPerDecode; i++) {
+        srcRows[i] = (JSAMPLE*) srcPtr;
+        srcPtr += srcRowBytes;
+    }
+
+    // Rows that exist only as above-context for fancy upsampling (see
+    // decodeParallel) are decoded and thrown away; the swizzler never sees
+    // them.
+    uint32_t toSkip = task->fSkipRows;
+    while (toSkip > 0) {
+        const uint32_t rowsToRead = SkTMin(rowsPerDecode, toSkip);
+        const uint32_t rowsDecoded = jpeg_read_scanlines(dinfo, srcRows, rowsToRead);
+        if (rowsDecoded < 1) {
+            return;
+        }
+        toSkip -= rowsDecoded;
+    }
+
+    uint32_t y = 0;
+    while (y < task->fRows) {
+        const uint32_t rowsToRead = SkTMin(rowsPerDecode, task->fRows - y);
+        const uint32_t rowsDecoded = jpeg_read_scanlines(dinfo, srcRows, rowsToRead);
+        if (rowsDecoded < 1) {
+            return;
+        }
+
+        // Convert to RGB if necessary
+        if (JCS_CMYK == dinfo->out_color_space) {
+            convert_CMYK_to_RGB(srcRows[0], task->fDstInfo.width() * rowsDecoded);
+        }
+
+        // Swizzle to output destination
+        for (uint32_t i = 0; i < rowsDecoded; i++) {
+            swizzler->next(srcRows[i]);
+        }
+        y += rowsDecoded;
+    }
+
+    // The synthesized stream ends at the slice boundary, so abort rather
+    // than asking jpeg_finish_decompress to consume the rest of the scan
+    jpeg_abort_decompress(dinfo);
+    task->fSuccess = true;
+}
+
+/*
+ * Attempts the restart-marker parallel decode
+ */
+bool SkJpegCodec::decodeParallel(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
+                                 const Options& options) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Slices are assigned by full-size row ranges
+    if (dstInfo.dimensions() != this->getInfo().dimensions()) {
+        return false;
+    }
+
+    // Restart markers are only usable as entry points in a single-scan
+    // Huffman image: they reset the DC predictors, making each restart
+    // interval independently decodable.
+    if (dinfo->progressive_mode || dinfo->arith_code || 0 == dinfo->restart_interval) {
+        return false;
+    }
+
+    // Partitioning assigns whole rows of the full-size image to each slice
+    if (1 != dinfo->scale_num || 1 != dinfo->scale_denom) {
+        return false;
+    }
+
+    // We need random access to the encoded data to find the restart markers
+    const uint8_t* base = static_cast<const uint8_t*>(this->stream()->getMemoryBase());
+    const size_t size = this->stream()->getLength();
+    if (NULL == base || 0 == size) {
+        return false;
+    }
+
+    // Compute the MCU geometry of the scan.  A single-component scan always
+    // uses one block per MCU regardless of the sampling factors.
+    int maxH = 1;
+    int maxV = 1;
+    if (dinfo->num_components > 1) {
+        for (int i = 0; i < dinfo->num_components; i++) {
+            maxH = SkTMax(maxH, dinfo->comp_info[i].h_samp_factor);
+            maxV = SkTMax(maxV, dinfo->comp_info[i].v_samp_factor);
+        }
+    }
+    const uint32_t mcuWidth = maxH * DCTSIZE;
+    const uint32_t mcuHeight = maxV * DCTSIZE;
+    const uint32_t mcusPerRow = (dinfo->image_width + mcuWidth - 1) / mcuWidth;
+    const uint32_t mcuRows = (dinfo->image_height + mcuHeight - 1) / mcuHeight;
+
+    // Each slice decodes whole rows, so the restart interval must cover
+    // whole MCU rows
+    if (0 != dinfo->restart_interval % mcusPerRow) {
+        return false;
+    }
+    const uint32_t mcuRowsPerInterval = dinfo->restart_interval / mcusPerRow;
+    const uint32_t numIntervals = (mcuRows + mcuRowsPerInterval - 1) / mcuRowsPerInterval;
+    if (numIntervals < 2) {
+        return false;
+    }
+
+    SkTDArray<uint8_t> header;
+    SkTDArray<size_t> restartOffsets;
+    size_t entropyStart = 0;
+    size_t entropyEnd = 0;
+    if (!scan_restart_markers(base, size, &header, &restartOffsets, &entropyStart,
+            &entropyEnd)) {
+        return false;
+    }
+
+    // A corrupt or truncated file may not contain the markers that its DRI
+    // segment promises.  Leave those for the serial path, which already
+    // handles incomplete input.
+    if (restartOffsets.count() != (int) (numIntervals - 1)) {
+        return false;
+    }
+
+    // Over-decompose relative to a typical core count for load balancing,
+    // but not by much: each task pays for a header reparse.
+    const uint32_t maxTasks = SkTMin(numIntervals, 16u);
+    const uint32_t intervalsPerTask = (numIntervals + maxTasks - 1) / maxTasks;
+    const uint32_t numTasks = (numIntervals + intervalsPerTask - 1) / intervalsPerTask;
+
+    SkAutoTDeleteArray<JpegSliceTask> tasks(SkNEW_ARRAY(JpegSliceTask, numTasks));
+    for (uint32_t t = 0; t < numTasks; t++) {
+        const uint32_t firstInterval = t * intervalsPerTask;
+        const uint32_t endInterval = SkTMin(firstInterval + intervalsPerTask, numIntervals);
+
+        // Include one interval of entropy data on each side of the slice
+        // when available: fancy upsampling reads one row group of context
+        // below the last row group it outputs, and needs the row group above
+        // the first one to compute it the same way the serial path would.
+        // The extra rows above are decoded and discarded (fSkipRows).
+        const uint32_t firstDataInterval = (0 == firstInterval) ? 0 : firstInterval - 1;
+        const uint32_t lastDataInterval = SkTMin(endInterval + 1, numIntervals);
+
+        const size_t sliceStart = (0 == firstDataInterval) ?
+                entropyStart : restartOffsets[firstDataInterval - 1];
+        // Exclude the RSTn that terminates the last included interval
+        const size_t sliceEnd = (numIntervals == lastDataInterval) ?
+                entropyEnd : restartOffsets[lastDataInterval - 1] - 2;
+
+        JpegSliceTask* task = &tasks.get()[t];
+        const size_t sliceLen = sliceEnd - sliceStart;
+        task->fSize = header.count() + sliceLen + 2;
+        uint8_t* out = static_cast<uint8_t*>(task->fData.reset(task->fSize));
+        memcpy(out, header.begin(), header.count());
+        memcpy(out + header.count(), base + sliceStart, sliceLen);
+
+        // Renumber the restart markers inside the slice to match the
+        // sequence that a decoder starting at this slice expects
+        for (uint32_t j = firstDataInterval; j + 1 < lastDataInterval; j++) {
+            out[header.count() + (restartOffsets[j] - 1 - sliceStart)] =
+                    JPEG_RST0 + ((j - firstDataInterval) & 7);
+        }
+        out[task->fSize - 2] = 0xFF;
+        out[task->fSize - 1] = 0xD9;
+
+        const uint32_t rowStart = firstInterval * mcuRowsPerInterval * mcuHeight;
+        const uint32_t rowEnd = SkTMin(endInterval * mcuRowsPerInterval * mcuHeight,
+                                       dinfo->image_height);
+        task->fColorSpace = dinfo->out_color_space;
+        task->fDstInfo = dstInfo;
+        task->fDst = SkTAddOffset<void>(dst, rowStart * dstRowBytes);
+        task->fDstRowBytes = dstRowBytes;
+        // Only the last interval can be short, and the context interval is
+        // never the last one, so it always spans full MCU rows.
+        task->fSkipRows = (firstInterval - firstDataInterval) * mcuRowsPerInterval * mcuHeight;
+        task->fRows = rowEnd - rowStart;
+        task->fZeroInitialized = options.fZeroInitialized;
+        task->fSuccess = false;
+    }
+
+    SkTaskGroup tg;
+    tg.batch(decode_jpeg_slice, tasks.get(), numTasks);
+    tg.wait();
+
+    for (uint32_t t = 0; t < numTasks; t++) {
+        if (!tasks.get()[t].fSuccess) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Performs a subset decode
+ */
+SkCodec::Result SkJpegCodec::decodeSubset(const SkImageInfo& dstInfo, void* dst,
+                                          size_t dstRowBytes, const SkIRect& subset,
+                                          const Options& options) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Subsets are decoded at the native size only
+    SkASSERT(1 == dinfo->scale_num && 1 == dinfo->scale_denom);
+    if (!jpeg_start_decompress(dinfo)) {
+        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
+    }
+
+    // The swizzler is sized to the subset.  Rows are decoded at full width,
+    // and the swizzle starts at the subset's left edge.
+    const SkSwizzler::SrcConfig srcConfig = get_src_config(*dinfo);
+    const int srcBPP = SkSwizzler::BytesPerPixel(srcConfig);
     fSwizzler.reset(SkSwizzler::CreateSwizzler(srcConfig, NULL, dstInfo, dst, dstRowBytes,
             options.fZeroInitialized));
-    fSrcRowBytes = SkSwizzler::BytesPerPixel(srcConfig) * dstInfo.width();
+    if (NULL == fSwizzler.get()) {
+        return fDecoderMgr->returnFailure("getSwizzler", kUnimplemented);
+    }
+    fSrcRowBytes = srcBPP * dinfo->output_width;
+
+    SkAutoTDeleteArray<uint8_t> srcBuffer(SkNEW_ARRAY(uint8_t, fSrcRowBytes));
+    uint8_t* srcRow = srcBuffer.get();
+
+    // Decode and discard the rows above the subset.  This libjpeg does not
+    // offer a scanline skipping entry point, so the rows must be fully
+    // decoded even though their output is unused.
+    for (int y = 0; y < subset.top(); y++) {
+        if (1 != jpeg_read_scanlines(dinfo, &srcRow, 1)) {
+            SkSwizzler::Fill(dst, dstInfo, dstRowBytes, dstInfo.height(), SK_ColorBLACK, NULL);
+            dinfo->output_scanline = dinfo->output_height;
+            jpeg_finish_decompress(dinfo);
+            return fDecoderMgr->returnFailure("Incomplete image data", kIncompleteInput);
+        }
+    }
+
+    // Decode the rows of the subset
+    for (int y = 0; y < subset.height(); y++) {
+        if (1 != jpeg_read_scanlines(dinfo, &srcRow, 1)) {
+            SkSwizzler::Fill(fSwizzler->getDstRow(), dstInfo, dstRowBytes,
+                    subset.height() - y, SK_ColorBLACK, NULL);
+            dinfo->output_scanline = dinfo->output_height;
+            jpeg_finish_decompress(dinfo);
+            return fDecoderMgr->returnFailure("Incomplete image data", kIncompleteInput);
+        }
+
+        // Convert to RGB if necessary
+        if (JCS_CMYK == dinfo->out_color_space) {
+            convert_CMYK_to_RGB(srcRow + subset.left() * srcBPP, subset.width());
+        }
+
+        // Swizzle to output destination
+        fSwizzler->next(srcRow + subset.left() * srcBPP);
+    }
+
+    // The rows below the subset are never decoded; abort rather than
+    // consuming the rest of the scan
+    jpeg_abort_decompress(dinfo);
+    return kSuccess;
 }
 
 /*
@@ -315,9 +761,25 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return fDecoderMgr->returnFailure("conversion_possible", kInvalidConversion);
     }
 
-    // Perform the necessary scaling
-    if (!this->scaleToDimensions(dstInfo.width(), dstInfo.height())) {
-        fDecoderMgr->returnFailure("cannot scale to requested dims", kInvalidScale);
+    // Decode only the requested region.  The subset and the dimensions of
+    // dstInfo have already been validated against each other.
+    if (options.fSubset) {
+        return this->decodeSubset(dstInfo, dst, dstRowBytes, *options.fSubset, options);
+    }
+
+    // Choose the IDCT scale and the sampling rates that produce the
+    // requested dimensions without materializing full resolution rows
+    int sampleX;
+    int sampleY;
+    if (!this->scaleToCoveringDimensions(dstInfo.width(), dstInfo.height(),
+            &sampleX, &sampleY)) {
+        return fDecoderMgr->returnFailure("cannot scale to requested dims", kInvalidScale);
+    }
+
+    // If the image is partitioned by restart markers, decode the restart
+    // intervals in parallel
+    if (this->decodeParallel(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
     }
 
     // Now, given valid output dimensions, we can start the decompress
@@ -326,11 +788,47 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     }
 
     // Create the swizzler
-    this->initializeSwizzler(dstInfo, dst, dstRowBytes, options);
+    this->initializeSwizzler(dstInfo, dst, dstRowBytes, options, sampleX);
     if (NULL == fSwizzler) {
         return fDecoderMgr->returnFailure("getSwizzler", kUnimplemented);
     }
 
+    // Nearest-neighbor sampled decode.  The source rows above the last
+    // sampled row must still be decoded, but they never reach the
+    // destination, and the rows below it are never decoded at all.
+    if (1 != sampleX || 1 != sampleY) {
+        SkASSERT(0 != fSrcRowBytes);
+        SkAutoTDeleteArray<uint8_t> srcBuffer(SkNEW_ARRAY(uint8_t, fSrcRowBytes));
+        uint8_t* srcRow = srcBuffer.get();
+        const int y0 = sampleY / 2;
+        int dstY = 0;
+        for (int y = 0; dstY < dstInfo.height(); y++) {
+            if (1 != jpeg_read_scanlines(dinfo, &srcRow, 1)) {
+                SkSwizzler::Fill(fSwizzler->getDstRow(), dstInfo, dstRowBytes,
+                        dstInfo.height() - dstY, SK_ColorBLACK, NULL);
+                dinfo->output_scanline = dinfo->output_height;
+                jpeg_finish_decompress(dinfo);
+                return fDecoderMgr->returnFailure("Incomplete image data", kIncompleteInput);
+            }
+            if (y < y0 || 0 != (y - y0) % sampleY) {
+                continue;
+            }
+
+            // Convert to RGB if necessary
+            if (JCS_CMYK == dinfo->out_color_space) {
+                convert_CMYK_to_RGB(srcRow, dinfo->output_width);
+            }
+
+            // Swizzle to output destination
+            fSwizzler->next(srcRow);
+            dstY++;
+        }
+
+        // The rows below the last sampled row are never decoded
+        jpeg_abort_decompress(dinfo);
+        return kSuccess;
+    }
+
     // This is usually 1, but can also be 2 or 4.
     // If we wanted to always read one row at a time, we could, but we will save space and time
     // by using the recommendation from libjpeg.
@@ -494,7 +992,7 @@ SkScanlineDecoder* SkJpegCodec::onGetScanlineDecoder(const SkImageInfo& dstInfo,
     }
 
     // Create the swizzler
-    this->initializeSwizzler(dstInfo, NULL, dstInfo.minRowBytes(), options);
+    this->initializeSwizzler(dstInfo, NULL, dstInfo.minRowBytes(), options, 1);
     if (NULL == fSwizzler) {
         SkCodecPrintf("Could not create swizzler\n");
         return NULL;
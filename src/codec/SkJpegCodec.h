@@ -105,12 +105,43 @@ private:
      */
     bool scaleToDimensions(uint32_t width, uint32_t height);
 
+    /*
+     * Chooses the smallest scaled IDCT output that still covers the requested
+     * dimensions, then computes the nearest-neighbor sampling rates that
+     * reach the request exactly.  sampleX and sampleY are 1 when the scaled
+     * IDCT alone produces the requested dimensions.
+     */
+    bool scaleToCoveringDimensions(uint32_t width, uint32_t height, int* sampleX,
+            int* sampleY);
+
     /*
      * Create the swizzler based on the encoded format
      */
     void initializeSwizzler(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
+            const Options& options, int sampleX);
+
+    /*
+     * Attempts to partition the image at its restart markers and decode the
+     * resulting slices in parallel on SkTaskGroup workers, each with its own
+     * decompress struct.
+     *
+     * Returns false without modifying the decompress state if the image
+     * cannot be partitioned (progressive, scaled, no restart markers, or the
+     * encoded data is not memory backed).  The caller should then fall back
+     * to the serial decode.
+     */
+    bool decodeParallel(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
             const Options& options);
 
+    /*
+     * Decodes only the region of the image described by subset.  The rows
+     * above the subset are decoded and discarded, the rows below it are
+     * never entropy decoded, and the columns outside it are cropped at the
+     * swizzle step.
+     */
+    Result decodeSubset(const SkImageInfo& dstInfo, void* dst, size_t dstRowBytes,
+            const SkIRect& subset, const Options& options);
+
     SkAutoTDelete<JpegDecoderMgr> fDecoderMgr;
     SkAutoTDelete<SkSwizzler>     fSwizzler;
     size_t                        fSrcRowBytes;
@@ -8,6 +8,7 @@
 #include "SkCodecPriv.h"
 #include "SkColorPriv.h"
 #include "SkSwizzler.h"
+#include "SkSwizzler_opts.h"
 #include "SkTemplates.h"
 #include "SkUtils.h"
 
@@ -275,7 +276,8 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
                                        const SkPMColor* ctable,
                                        const SkImageInfo& info, void* dst,
                                        size_t dstRowBytes,
-                                       SkImageGenerator::ZeroInitialized zeroInit) {
+                                       SkImageGenerator::ZeroInitialized zeroInit,
+                                       int sampleX) {
     if (info.colorType() == kUnknown_SkColorType || kUnknown == sc) {
         return NULL;
     }
@@ -286,6 +288,11 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
             && NULL == ctable) {
         return NULL;
     }
+    // Sampling is done by widening the stride between source pixels, which
+    // requires whole-byte pixels.
+    if (sampleX < 1 || (sampleX > 1 && !SkIsAlign8(BitsPerPixel(sc)))) {
+        return NULL;
+    }
     RowProc proc = NULL;
     switch (sc) {
         case kIndex1:
@@ -324,7 +331,14 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
         case kGray:
             switch (info.colorType()) {
                 case kN32_SkColorType:
-                    proc = &swizzle_gray_to_n32;
+                    // The platform procs assume the packed source stride;
+                    // sampled decodes use the portable procs.
+                    if (1 == sampleX) {
+                        proc = SkSwizzlerGetPlatformProc(kGray_To_N32_SwizzlerProcType);
+                    }
+                    if (NULL == proc) {
+                        proc = &swizzle_gray_to_n32;
+                    }
                     break;
                 case kGray_8_SkColorType:
                     proc = &swizzle_gray_to_gray;
@@ -364,7 +378,12 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
             // TODO: Support other swizzles.
             switch (info.colorType()) {
                 case kN32_SkColorType:
-                    proc = &swizzle_rgbx_to_n32;
+                    if (1 == sampleX) {
+                        proc = SkSwizzlerGetPlatformProc(kRGBX_To_N32_SwizzlerProcType);
+                    }
+                    if (NULL == proc) {
+                        proc = &swizzle_rgbx_to_n32;
+                    }
                     break;
                 default:
                     break;
@@ -375,12 +394,30 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
                 case kN32_SkColorType:
                     if (info.alphaType() == kUnpremul_SkAlphaType) {
                         // Respect zeroInit?
-                        proc = &swizzle_rgba_to_n32_unpremul;
+                        if (1 == sampleX) {
+                            proc = SkSwizzlerGetPlatformProc(
+                                    kRGBA_To_N32_Unpremul_SwizzlerProcType);
+                        }
+                        if (NULL == proc) {
+                            proc = &swizzle_rgba_to_n32_unpremul;
+                        }
                     } else {
                         if (SkImageGenerator::kYes_ZeroInitialized == zeroInit) {
-                            proc = &swizzle_rgba_to_n32_premul_skipZ;
+                            if (1 == sampleX) {
+                                proc = SkSwizzlerGetPlatformProc(
+                                        kRGBA_To_N32_Premul_SkipZ_SwizzlerProcType);
+                            }
+                            if (NULL == proc) {
+                                proc = &swizzle_rgba_to_n32_premul_skipZ;
+                            }
                         } else {
-                            proc = &swizzle_rgba_to_n32_premul;
+                            if (1 == sampleX) {
+                                proc = SkSwizzlerGetPlatformProc(
+                                        kRGBA_To_N32_Premul_SwizzlerProcType);
+                            }
+                            if (NULL == proc) {
+                                proc = &swizzle_rgba_to_n32_premul;
+                            }
                         }
                     }
                     break;
@@ -391,7 +428,12 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
         case kRGB:
             switch (info.colorType()) {
                 case kN32_SkColorType:
-                    proc = &swizzle_rgbx_to_n32;
+                    if (1 == sampleX) {
+                        proc = SkSwizzlerGetPlatformProc(kRGBX_To_N32_SwizzlerProcType);
+                    }
+                    if (NULL == proc) {
+                        proc = &swizzle_rgbx_to_n32;
+                    }
                     break;
                 default:
                     break;
@@ -404,19 +446,29 @@ SkSwizzler* SkSwizzler::CreateSwizzler(SkSwizzler::SrcConfig sc,
         return NULL;
     }
 
-    // Store deltaSrc in bytes if it is an even multiple, otherwise use bits
-    int deltaSrc = SkIsAlign8(BitsPerPixel(sc)) ? BytesPerPixel(sc) :
-            BitsPerPixel(sc);
-    return SkNEW_ARGS(SkSwizzler, (proc, ctable, deltaSrc, info, dst,
+    // Store deltaSrc in bytes if it is an even multiple, otherwise use bits.
+    // Sampling widens the stride and centers the first sample.
+    int deltaSrc;
+    int srcOffset;
+    if (SkIsAlign8(BitsPerPixel(sc))) {
+        deltaSrc = BytesPerPixel(sc) * sampleX;
+        srcOffset = BytesPerPixel(sc) * (sampleX / 2);
+    } else {
+        SkASSERT(1 == sampleX);
+        deltaSrc = BitsPerPixel(sc);
+        srcOffset = 0;
+    }
+    return SkNEW_ARGS(SkSwizzler, (proc, ctable, deltaSrc, srcOffset, info, dst,
                                    dstRowBytes));
 }
 
 SkSwizzler::SkSwizzler(RowProc proc, const SkPMColor* ctable,
-                       int deltaSrc, const SkImageInfo& info, void* dst,
+                       int deltaSrc, int srcOffset, const SkImageInfo& info, void* dst,
                        size_t rowBytes)
     : fRowProc(proc)
     , fColorTable(ctable)
     , fDeltaSrc(deltaSrc)
+    , fSrcOffset(srcOffset)
     , fDstInfo(info)
     , fDstRow(dst)
     , fDstRowBytes(rowBytes)
@@ -432,7 +484,7 @@ SkSwizzler::ResultAlpha SkSwizzler::next(const uint8_t* SK_RESTRICT src) {
     SkDEBUGCODE(fNextMode = kConsecutive_NextMode);
 
     // Decode a row
-    const ResultAlpha result = fRowProc(fDstRow, src, fDstInfo.width(),
+    const ResultAlpha result = fRowProc(fDstRow, src + fSrcOffset, fDstInfo.width(),
             fDeltaSrc, fCurrY, fColorTable);
 
     // Move to the next row and return the result
@@ -451,7 +503,7 @@ SkSwizzler::ResultAlpha SkSwizzler::next(const uint8_t* SK_RESTRICT src,
     void* row = SkTAddOffset<void>(fDstRow, y*fDstRowBytes);
 
     // Decode the row
-    return fRowProc(row, src, fDstInfo.width(), fDeltaSrc, fCurrY,
+    return fRowProc(row, src + fSrcOffset, fDstInfo.width(), fDeltaSrc, fCurrY,
             fColorTable);
 }
 
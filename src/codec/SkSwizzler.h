@@ -122,12 +122,18 @@ public:
      *  @param ZeroInitialized Whether dst is zero-initialized. The
                                implementation may choose to skip writing zeroes
      *                         if set to kYes_ZeroInitialized.
+     *  @param sampleX If greater than 1, decode every sampleX'th pixel of the
+     *                 source row (centered, nearest-neighbor) into the dst
+     *                 row.  The source row must hold at least
+     *                 dstInfo.width() * sampleX pixels.  Only supported for
+     *                 source configs with whole-byte pixels.
      *  @return A new SkSwizzler or NULL on failure.
      */
     static SkSwizzler* CreateSwizzler(SrcConfig, const SkPMColor* ctable,
                                       const SkImageInfo&, void* dst,
                                       size_t dstRowBytes,
-                                      SkImageGenerator::ZeroInitialized);
+                                      SkImageGenerator::ZeroInitialized,
+                                      int sampleX = 1);
 
     /**
      * Fill the remainder of the destination with a single color
@@ -203,6 +209,24 @@ public:
         return fDstRow;
     }
 
+    /**
+     *  Method for converting raw data to Skia pixels.
+     *  @param dstRow Row in which to write the resulting pixels.
+     *  @param src Row of src data, in format specified by SrcConfig
+     *  @param width Width in pixels
+     *  @param deltaSrc if bitsPerPixel % 8 == 0, deltaSrc is bytesPerPixel
+     *                  else, deltaSrc is bitsPerPixel
+     *  @param y Line of source.
+     *  @param ctable Colors (used for kIndex source).
+     *
+     *  This is public so that the platform-specific implementations in
+     *  src/opts can share the signature.
+     */
+    typedef ResultAlpha (*RowProc)(void* SK_RESTRICT dstRow,
+                                   const uint8_t* SK_RESTRICT src,
+                                   int width, int deltaSrc, int y,
+                                   const SkPMColor ctable[]);
+
 private:
 
 #ifdef SK_DEBUG
@@ -220,33 +244,21 @@ private:
     NextMode fNextMode;
 #endif
 
-    /**
-     *  Method for converting raw data to Skia pixels.
-     *  @param dstRow Row in which to write the resulting pixels.
-     *  @param src Row of src data, in format specified by SrcConfig
-     *  @param width Width in pixels
-     *  @param deltaSrc if bitsPerPixel % 8 == 0, deltaSrc is bytesPerPixel
-     *                  else, deltaSrc is bitsPerPixel
-     *  @param y Line of source.
-     *  @param ctable Colors (used for kIndex source).
-     */
-    typedef ResultAlpha (*RowProc)(void* SK_RESTRICT dstRow,
-                                   const uint8_t* SK_RESTRICT src,
-                                   int width, int deltaSrc, int y,
-                                   const SkPMColor ctable[]);
-
     const RowProc       fRowProc;
     const SkPMColor*    fColorTable;      // Unowned pointer
     const int           fDeltaSrc;        // if bitsPerPixel % 8 == 0
                                           //     deltaSrc is bytesPerPixel
+                                          //     (times sampleX when sampling)
                                           // else
                                           //     deltaSrc is bitsPerPixel
+    const int           fSrcOffset;       // bytes to skip into each source
+                                          // row to center the first sample
     const SkImageInfo   fDstInfo;
     void*               fDstRow;
     const size_t        fDstRowBytes;
     int                 fCurrY;
 
-    SkSwizzler(RowProc proc, const SkPMColor* ctable, int deltaSrc,
+    SkSwizzler(RowProc proc, const SkPMColor* ctable, int deltaSrc, int srcOffset,
                const SkImageInfo& info, void* dst, size_t rowBytes);
 
 };
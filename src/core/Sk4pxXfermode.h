@@ -9,6 +9,7 @@
 #define Sk4pxXfermode_DEFINED
 
 #include "Sk4px.h"
+#include "SkPMFloat.h"
 
 // This file is possibly included into multiple .cpp files.
 // Each gets its own independent instantiation by wrapping in an anonymous namespace.
@@ -114,6 +115,72 @@ XFERMODE(Lighten) {
 
 #undef XFERMODE
 
+// The remaining separable modes (ColorDodge, ColorBurn, SoftLight) need division
+// or square roots, which don't fit Sk4px's 8-bit fixed point.  We do those in
+// floats, one pixel at a time, with all four channels in the lanes of an Sk4f.
+// The formulas are transliterated from the scalar *_byte() procs in SkXfermode.cpp;
+// conveniently, evaluating the color formula on the alpha lane works out to
+// srcover alpha in every branch, so no lane needs special-casing afterwards.
+// SkPMFloat keeps its components in [0,255], so products of two components pick
+// up a factor of 255 that we divide out at the end.
+#define XFERMODE(Name)                                                    \
+    struct Name {                                                         \
+        static SkPMFloat Xfer(const SkPMFloat&, const SkPMFloat&);        \
+        static const SkXfermode::Mode kMode = SkXfermode::k##Name##_Mode; \
+    };                                                                    \
+    inline SkPMFloat Name::Xfer(const SkPMFloat& s, const SkPMFloat& d)
+
+XFERMODE(ColorDodge) {
+    auto sa = Sk4f(s.a()), da = Sk4f(d.a()),
+         isa = Sk4f(255)-sa, ida = Sk4f(255)-da;
+
+    auto common = s*ida + d*isa;
+    // The division can produce NaN or infinity on the lanes where s == sa,
+    // but thenElse() selects bitwise, so those lanes are simply discarded.
+    auto dodge  = sa*Sk4f::Min(da, d*sa / (sa - s)) + common;
+
+    return (d == Sk4f(0)).thenElse(s*ida,
+           (s ==      sa).thenElse(sa*da + common,
+                                   dodge)) * Sk4f(1.0f/255);
+}
+
+XFERMODE(ColorBurn) {
+    auto sa = Sk4f(s.a()), da = Sk4f(d.a()),
+         isa = Sk4f(255)-sa, ida = Sk4f(255)-da;
+
+    auto common = s*ida + d*isa;
+    auto burn   = sa*(da - Sk4f::Min(da, (da - d)*sa / s)) + common;
+
+    return (d ==      da).thenElse(sa*da + common,
+           (s == Sk4f(0)).thenElse(d*isa,
+                                   burn)) * Sk4f(1.0f/255);
+}
+
+XFERMODE(SoftLight) {
+    auto sa = Sk4f(s.a()), da = Sk4f(d.a()),
+         isa = Sk4f(255)-sa, ida = Sk4f(255)-da;
+
+    // Some common terms.  m is the dst coverage ratio Dc/Da, in [0,1].
+    auto m  = (da > Sk4f(0)).thenElse(d / da, Sk4f(0)),
+         s2 = Sk4f(2)*s,
+         m4 = Sk4f(4)*m;
+
+    // The logic forks three ways:
+    //    1. dark src?
+    //    2. light src, dark dst?
+    //    3. light src, light dst?
+    auto darkSrc = d*(sa + (s2 - sa)*(Sk4f(1) - m)),         // Used in case 1.
+         darkDst = (m4*m4 + m4)*(m - Sk4f(1)) + Sk4f(7)*m,   // Used in case 2.
+         liteDst = m.sqrt() - m,                             // Used in case 3.
+         liteSrc = d*sa + da*(s2 - sa)
+                   * (Sk4f(4)*d <= da).thenElse(darkDst, liteDst);  // Case 2 or 3?
+
+    return (s*ida + d*isa
+            + (s2 <= sa).thenElse(darkSrc, liteSrc)) * Sk4f(1.0f/255);  // Case 1 or (2 or 3)?
+}
+
+#undef XFERMODE
+
 // A reasonable fallback mode for doing AA is to simply apply the transfermode first,
 // then linearly interpolate the AA.
 template <typename Mode>
@@ -159,6 +226,34 @@ private:
     typedef SkProcCoeffXfermode INHERITED;
 };
 
+template <typename ProcType>
+class SkTPMFloatXfermode : public SkProcCoeffXfermode {
+public:
+    static SkProcCoeffXfermode* Create(const ProcCoeff& rec) {
+        return SkNEW_ARGS(SkTPMFloatXfermode, (rec));
+    }
+
+    void xfer32(SkPMColor dst[], const SkPMColor src[], int n, const SkAlpha aa[]) const override {
+        for (int i = 0; i < n; i++) {
+            SkPMFloat s(src[i]),
+                      d(dst[i]),
+                      b(ProcType::Xfer(s,d));
+            if (aa) {
+                // We do aa in full float precision before going back down to bytes, because
+                // we can!
+                Sk4f aa4 = Sk4f(aa[i]) * Sk4f(1.0f/255);
+                b = b*aa4 + d*(Sk4f(1)-aa4);
+            }
+            dst[i] = b.roundClamp();
+        }
+    }
+
+private:
+    SkTPMFloatXfermode(const ProcCoeff& rec) : SkProcCoeffXfermode(rec, ProcType::kMode) {}
+
+    typedef SkProcCoeffXfermode INHERITED;
+};
+
 static SkProcCoeffXfermode* SkCreate4pxXfermode(const ProcCoeff& rec, SkXfermode::Mode mode) {
 #if !defined(SK_CPU_ARM32) || defined(SK_ARM_HAS_NEON)
     switch (mode) {
@@ -185,6 +280,9 @@ static SkProcCoeffXfermode* SkCreate4pxXfermode(const ProcCoeff& rec, SkXfermode
         case SkXfermode::kOverlay_Mode:    return SkT4pxXfermode<Overlay>::Create(rec);
         case SkXfermode::kDarken_Mode:     return SkT4pxXfermode<Darken>::Create(rec);
         case SkXfermode::kLighten_Mode:    return SkT4pxXfermode<Lighten>::Create(rec);
+        case SkXfermode::kColorDodge_Mode: return SkTPMFloatXfermode<ColorDodge>::Create(rec);
+        case SkXfermode::kColorBurn_Mode:  return SkTPMFloatXfermode<ColorBurn>::Create(rec);
+        case SkXfermode::kSoftLight_Mode:  return SkTPMFloatXfermode<SoftLight>::Create(rec);
 #endif
         default: break;
     }
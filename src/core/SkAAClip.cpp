@@ -93,7 +93,7 @@ struct SkAAClip::RunHead {
         return segments * 2;    // each segment is row[0] + row[1] (n + alpha)
     }
 
-    static RunHead* AllocRect(const SkIRect& bounds) {
+    static RunHead* AllocRect(const SkIRect& bounds, U8CPU alpha = 0xFF) {
         SkASSERT(!bounds.isEmpty());
         int width = bounds.width();
         size_t rowSize = ComputeRowSizeForWidth(width);
@@ -105,7 +105,7 @@ struct SkAAClip::RunHead {
         while (width > 0) {
             int n = SkMin32(width, 255);
             row[0] = n;
-            row[1] = 0xFF;
+            row[1] = SkToU8(alpha);
             width -= n;
             row += 2;
         }
@@ -133,6 +133,7 @@ private:
 };
 
 SkAAClip::Iter::Iter(const SkAAClip& clip) {
+    clip.materializeIfLazy();
     if (clip.isEmpty()) {
         fDone = true;
         fTop = fBottom = clip.fBounds.fBottom;
@@ -614,7 +615,19 @@ bool SkAAClip::trimBounds() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void SkAAClip::freeLazy() {
+    if (fLazyPath) {
+        SkDELETE(fLazyPath);
+        fLazyPath = NULL;
+    }
+    if (fLazyClip) {
+        SkDELETE(fLazyClip);
+        fLazyClip = NULL;
+    }
+}
+
 void SkAAClip::freeRuns() {
+    this->freeLazy();
     if (fRunHead) {
         SkASSERT(fRunHead->fRefCnt >= 1);
         if (1 == sk_atomic_dec(&fRunHead->fRefCnt)) {
@@ -626,11 +639,17 @@ void SkAAClip::freeRuns() {
 SkAAClip::SkAAClip() {
     fBounds.setEmpty();
     fRunHead = NULL;
+    fLazyPath = NULL;
+    fLazyClip = NULL;
+    fLazyDoAA = false;
 }
 
 SkAAClip::SkAAClip(const SkAAClip& src) {
     SkDEBUGCODE(fBounds.setEmpty();)    // need this for validate
     fRunHead = NULL;
+    fLazyPath = NULL;
+    fLazyClip = NULL;
+    fLazyDoAA = false;
     *this = src;
 }
 
@@ -649,11 +668,18 @@ SkAAClip& SkAAClip::operator=(const SkAAClip& src) {
         if (fRunHead) {
             sk_atomic_inc(&fRunHead->fRefCnt);
         }
+        // Copies stay lazy: the path/region copies are cheap (COW), and each
+        // copy materializes independently on first row access.
+        fLazyPath = src.fLazyPath ? SkNEW_ARGS(SkPath, (*src.fLazyPath)) : NULL;
+        fLazyClip = src.fLazyClip ? SkNEW_ARGS(SkRegion, (*src.fLazyClip)) : NULL;
+        fLazyDoAA = src.fLazyDoAA;
     }
     return *this;
 }
 
 bool operator==(const SkAAClip& a, const SkAAClip& b) {
+    a.materializeIfLazy();
+    b.materializeIfLazy();
     a.validate();
     b.validate();
 
@@ -688,6 +714,9 @@ void SkAAClip::swap(SkAAClip& other) {
 
     SkTSwap(fBounds, other.fBounds);
     SkTSwap(fRunHead, other.fRunHead);
+    SkTSwap(fLazyPath, other.fLazyPath);
+    SkTSwap(fLazyClip, other.fLazyClip);
+    SkTSwap(fLazyDoAA, other.fLazyDoAA);
 }
 
 bool SkAAClip::set(const SkAAClip& src) {
@@ -728,6 +757,12 @@ bool SkAAClip::isRect() const {
     if (this->isEmpty()) {
         return false;
     }
+    // Don't rasterize just to answer a cache query; while lazy we simply
+    // don't know, so say no. This costs the AA-rect -> BW demotion in
+    // SkRasterClip for lazy clips, which is the price of the deferral.
+    if (this->isLazy()) {
+        return false;
+    }
 
     const RunHead* head = fRunHead;
     if (head->fRowCount != 1) {
@@ -866,6 +901,7 @@ bool SkAAClip::setRegion(const SkRegion& rgn) {
 ///////////////////////////////////////////////////////////////////////////////
 
 const uint8_t* SkAAClip::findRow(int y, int* lastYForRow) const {
+    this->materializeIfLazy();
     SkASSERT(fRunHead);
 
     if (!y_in_rect(y, fBounds)) {
@@ -1407,6 +1443,55 @@ bool SkAAClip::setPath(const SkPath& path, const SkRegion* clip, bool doAA) {
     return builder.finish(this);
 }
 
+bool SkAAClip::setPathLazy(const SkPath& path, const SkRegion* clip, bool doAA) {
+    AUTO_AACLIP_VALIDATE(*this);
+
+    if (clip && clip->isEmpty()) {
+        return this->setEmpty();
+    }
+
+    SkIRect ibounds;
+    path.getBounds().roundOut(&ibounds);
+
+    if (path.isInverseFillType()) {
+        if (clip) {
+            ibounds = clip->getBounds();
+        }
+    } else {
+        if (ibounds.isEmpty() || (clip && !ibounds.intersect(clip->getBounds()))) {
+            return this->setEmpty();
+        }
+    }
+
+    this->freeRuns();
+    fBounds = ibounds;
+    // Conservative placeholder so bounds queries work before materialization.
+    fRunHead = RunHead::AllocRect(ibounds);
+    fLazyPath = SkNEW_ARGS(SkPath, (path));
+    fLazyClip = clip ? SkNEW_ARGS(SkRegion, (*clip)) : NULL;
+    fLazyDoAA = doAA;
+    return true;
+}
+
+void SkAAClip::materialize() {
+    SkASSERT(fLazyPath);
+
+    SkAutoTDelete<SkPath> path(fLazyPath);
+    SkAutoTDelete<SkRegion> clip(fLazyClip);
+    fLazyPath = NULL;
+    fLazyClip = NULL;
+    const SkIRect bounds = fBounds;
+
+    if (!this->setPath(*path, clip.get(), fLazyDoAA)) {
+        // The rasterization came up empty, but we've already told callers we
+        // were non-empty. Keep a fully transparent row so row accesses stay
+        // valid; blits through it produce nothing.
+        this->freeRuns();
+        fBounds = bounds;
+        fRunHead = RunHead::AllocRect(bounds, 0);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 typedef void (*RowProc)(SkAAClip::Builder&, int bottom,
@@ -1659,7 +1744,7 @@ static void operateY(SkAAClip::Builder& builder, const SkAAClip& A,
     } while (!iterA.done() || !iterB.done());
 }
 
-bool SkAAClip::op(const SkAAClip& clipAOrig, const SkAAClip& clipBOrig,
+bool SkAAClip::op_materialized(const SkAAClip& clipAOrig, const SkAAClip& clipBOrig,
                   SkRegion::Op op) {
     AUTO_AACLIP_VALIDATE(*this);
 
@@ -1796,6 +1881,12 @@ bool SkAAClip::op(const SkRect& rOrig, SkRegion::Op op, bool doAA) {
     return this->op(*this, clip, op);
 }
 
+bool SkAAClip::op(const SkAAClip& clipA, const SkAAClip& clipB, SkRegion::Op op) {
+    clipA.materializeIfLazy();
+    clipB.materializeIfLazy();
+    return this->op_materialized(clipA, clipB, op);
+}
+
 bool SkAAClip::op(const SkAAClip& clip, SkRegion::Op op) {
     return this->op(*this, clip, op);
 }
@@ -1806,6 +1897,7 @@ bool SkAAClip::translate(int dx, int dy, SkAAClip* dst) const {
     if (NULL == dst) {
         return !this->isEmpty();
     }
+    this->materializeIfLazy();
 
     if (this->isEmpty()) {
         return dst->setEmpty();
@@ -1836,6 +1928,7 @@ static void expand_row_to_mask(uint8_t* SK_RESTRICT mask,
 }
 
 void SkAAClip::copyToMask(SkMask* mask) const {
+    this->materializeIfLazy();
     mask->fFormat = SkMask::kA8_Format;
     if (this->isEmpty()) {
         mask->fBounds.setEmpty();
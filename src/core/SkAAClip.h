@@ -31,12 +31,26 @@ public:
 
     // Returns true iff the clip is not empty, and is just a hard-edged rect (no partial alpha).
     // If true, getBounds() can be used in place of this clip.
+    // Conservative: a clip that is still lazy (see setPathLazy) reports false rather than
+    // rasterizing just to answer; callers must treat false as "not known to be a rect".
     bool isRect() const;
 
+    // True while a setPathLazy() clip has not yet been rasterized.
+    bool isLazy() const { return NULL != fLazyPath; }
+
     bool setEmpty();
     bool setRect(const SkIRect&);
     bool setRect(const SkRect&, bool doAA = true);
     bool setPath(const SkPath&, const SkRegion* clip = NULL, bool doAA = true);
+
+    /**
+     *  Like setPath(), but defers rasterizing the clip into RLE until the
+     *  first time someone reads coverage rows. Until then the clip reports
+     *  conservative (unrasterized path bounds) geometry. Saves the full
+     *  build cost for clips that are set and then never consulted, e.g.
+     *  when the subsequent draws are quick-rejected.
+     */
+    bool setPathLazy(const SkPath&, const SkRegion* clip = NULL, bool doAA = true);
     bool setRegion(const SkRegion&);
     bool set(const SkAAClip&);
 
@@ -85,6 +99,22 @@ private:
     SkIRect  fBounds;
     RunHead* fRunHead;
 
+    // Deferred clip-path state from setPathLazy(). While fLazyPath is
+    // non-NULL, fRunHead holds a conservative full-bounds rect; the real
+    // RLE is built by materialize() on first row access.
+    SkPath*   fLazyPath;
+    SkRegion* fLazyClip;
+    bool      fLazyDoAA;
+
+    void materializeIfLazy() const {
+        if (fLazyPath) {
+            const_cast<SkAAClip*>(this)->materialize();
+        }
+    }
+    void materialize();
+    void freeLazy();
+    bool op_materialized(const SkAAClip&, const SkAAClip&, SkRegion::Op);
+
     void freeRuns();
     bool trimBounds();
     bool trimTopBottom();
@@ -12,6 +12,12 @@
 
 #include "SkBlitter.h"
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
 /** Sparse array of run-length-encoded alpha (supersampling coverage) values.
     Sparseness allows us to independently compose several paths into the
     same SkAlphaRuns buffer.
@@ -80,14 +86,9 @@ public:
             alpha += x;
             runs += x;
             x = 0;
-            do {
-                alpha[0] = SkToU8(alpha[0] + maxValue);
-                int n = runs[0];
-                SkASSERT(n <= middleCount);
-                alpha += n;
-                runs += n;
-                middleCount -= n;
-            } while (middleCount > 0);
+            SkAlphaRuns::AddConstant(runs, alpha, middleCount, maxValue);
+            runs += middleCount;
+            alpha += middleCount;
             SkDEBUGCODE(this->validate();)
             lastAlpha = alpha;
         }
@@ -103,6 +104,60 @@ public:
         return SkToS32(lastAlpha - fAlpha);  // new offsetX
     }
 
+    /**
+     *  Add maxValue to the head coverage cell of each run in
+     *  [alpha, alpha + count). Along antialiased edges the runs degenerate
+     *  to unit length -- one coverage cell per run -- which turns this into
+     *  a straight per-cell add; we detect stretches of 16 unit runs and do
+     *  those adds vector-wide. The caller guarantees that no cell can
+     *  overflow 255 (each add() contributes at most maxValue per sample
+     *  pass), so a plain byte add is safe.
+     */
+    static void AddConstant(int16_t runs[], uint8_t alpha[], int count, U8CPU maxValue) {
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128i vmax = _mm_set1_epi8((char)maxValue);
+        while (count >= 16) {
+            __m128i r0 = _mm_loadu_si128((const __m128i*)(runs + 0));
+            __m128i r1 = _mm_loadu_si128((const __m128i*)(runs + 8));
+            __m128i allUnit = _mm_and_si128(_mm_cmpeq_epi16(r0, ones),
+                                            _mm_cmpeq_epi16(r1, ones));
+            if (0xFFFF != _mm_movemask_epi8(allUnit)) {
+                break;
+            }
+            __m128i a = _mm_loadu_si128((const __m128i*)alpha);
+            _mm_storeu_si128((__m128i*)alpha, _mm_add_epi8(a, vmax));
+            runs += 16;
+            alpha += 16;
+            count -= 16;
+        }
+#elif defined(SK_ARM_HAS_NEON)
+        const int16x8_t ones = vdupq_n_s16(1);
+        const uint8x16_t vmax = vdupq_n_u8((uint8_t)maxValue);
+        while (count >= 16) {
+            uint16x8_t e0 = vceqq_s16(vld1q_s16(runs + 0), ones);
+            uint16x8_t e1 = vceqq_s16(vld1q_s16(runs + 8), ones);
+            uint8x16_t allUnit = vcombine_u8(vmovn_u16(e0), vmovn_u16(e1));
+            if (0xFFFFFFFFFFFFFFFFULL != vget_lane_u64(vreinterpret_u64_u8(
+                    vand_u8(vget_low_u8(allUnit), vget_high_u8(allUnit))), 0)) {
+                break;
+            }
+            vst1q_u8(alpha, vaddq_u8(vld1q_u8(alpha), vmax));
+            runs += 16;
+            alpha += 16;
+            count -= 16;
+        }
+#endif
+        while (count > 0) {
+            alpha[0] = SkToU8(alpha[0] + maxValue);
+            int n = runs[0];
+            SkASSERT(n <= count);
+            alpha += n;
+            runs += n;
+            count -= n;
+        }
+    }
+
     SkDEBUGCODE(void assertValid(int y, int maxStep) const;)
     SkDEBUGCODE(void dump() const;)
 
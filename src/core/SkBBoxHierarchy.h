@@ -32,6 +32,30 @@ public:
      */
     virtual void search(const SkRect& query, SkTDArray<unsigned>* results) const = 0;
 
+    /**
+     * Visit the indices of bounding boxes intersecting the query, in insertion
+     * (i.e. draw) order, without building a result array. proc returns false to
+     * end the search early. The default implementation is layered on the array
+     * search(); subclasses that can walk their own structure should override.
+     */
+    typedef bool (*SearchProc)(unsigned opIndex, void* context);
+    virtual void search(const SkRect& query, SearchProc proc, void* context) const {
+        SkTDArray<unsigned> results;
+        this->search(query, &results);
+        for (int i = 0; i < results.count(); ++i) {
+            if (!proc(results[i], context)) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * Remove all insert()ed boxes so the hierarchy can be refilled, keeping any
+     * allocated storage for reuse. Implementations whose insert() replaces all
+     * prior content may rely on this default, which does nothing.
+     */
+    virtual void reset() {}
+
     virtual size_t bytesUsed() const = 0;
 
     // Get the root bound.
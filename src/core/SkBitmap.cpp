@@ -721,9 +721,15 @@ void SkBitmap::internalErase(const SkIRect& area,
                                 g >> (8 - SK_G16_BITS),
                                 b >> (8 - SK_B16_BITS));
             }
-            while (--height >= 0) {
-                sk_memset16(p, v, width);
-                p = (uint16_t*)((char*)p + rowBytes);
+            if (width << 1 == rowBytes && (int64_t)width * height <= SK_MaxS32) {
+                // Contiguous rows: erase with a single call, which lets wide
+                // (streaming) memset variants kick in for large fills.
+                sk_memset16(p, v, width * height);
+            } else {
+                while (--height >= 0) {
+                    sk_memset16(p, v, width);
+                    p = (uint16_t*)((char*)p + rowBytes);
+                }
             }
             break;
         }
@@ -739,9 +745,15 @@ void SkBitmap::internalErase(const SkIRect& area,
             uint32_t v = kRGBA_8888_SkColorType == this->colorType() ?
                          SkPackARGB_as_RGBA(a, r, g, b) : SkPackARGB_as_BGRA(a, r, g, b);
 
-            while (--height >= 0) {
-                sk_memset32(p, v, width);
-                p = (uint32_t*)((char*)p + rowBytes);
+            if (width << 2 == rowBytes && (int64_t)width * height <= SK_MaxS32) {
+                // Contiguous rows: erase with a single call, which lets wide
+                // (streaming) memset variants kick in for large fills.
+                sk_memset32(p, v, width * height);
+            } else {
+                while (--height >= 0) {
+                    sk_memset32(p, v, width);
+                    p = (uint32_t*)((char*)p + rowBytes);
+                }
             }
             break;
         }
@@ -142,6 +142,71 @@ bool SkBitmapCache::Add(SkPixelRef* pr, const SkIRect& subset, const SkBitmap& r
     }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gContentKeyNamespaceLabel;
+
+// Like BitmapKey, but keyed on a caller-supplied content ID instead of a generation ID.
+// Content IDs (and so these keys) are stable across processes; generation IDs are not.
+struct ContentKey : public SkResourceCache::Key {
+public:
+    ContentKey(uint64_t contentID, SkScalar sx, SkScalar sy)
+        : fContentID_lo(SkToU32(contentID & 0xFFFFFFFF))
+        , fContentID_hi(SkToU32(contentID >> 32))
+        , fScaleX(sx)
+        , fScaleY(sy)
+    {
+        this->init(&gContentKeyNamespaceLabel, contentID,
+                   sizeof(fContentID_lo) + sizeof(fContentID_hi) +
+                   sizeof(fScaleX) + sizeof(fScaleY));
+    }
+
+    uint32_t    fContentID_lo;
+    uint32_t    fContentID_hi;
+    SkScalar    fScaleX;
+    SkScalar    fScaleY;
+};
+
+struct ContentRec : public SkResourceCache::Rec {
+    ContentRec(uint64_t contentID, SkScalar scaleX, SkScalar scaleY, const SkBitmap& result)
+        : fKey(contentID, scaleX, scaleY)
+        , fBitmap(result)
+    {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(fKey) + fBitmap.getSize(); }
+
+    static bool Finder(const SkResourceCache::Rec& baseRec, void* contextBitmap) {
+        const ContentRec& rec = static_cast<const ContentRec&>(baseRec);
+        SkBitmap* result = (SkBitmap*)contextBitmap;
+
+        *result = rec.fBitmap;
+        result->lockPixels();
+        return SkToBool(result->getPixels());
+    }
+
+private:
+    ContentKey  fKey;
+    SkBitmap    fBitmap;
+};
+} // namespace
+
+bool SkBitmapCache::FindByContentID(uint64_t contentID, SkScalar invScaleX, SkScalar invScaleY,
+                                    SkBitmap* result, SkResourceCache* localCache) {
+    ContentKey key(contentID, invScaleX, invScaleY);
+
+    return CHECK_LOCAL(localCache, find, Find, key, ContentRec::Finder, result);
+}
+
+void SkBitmapCache::AddByContentID(uint64_t contentID, SkScalar invScaleX, SkScalar invScaleY,
+                                   const SkBitmap& result, SkResourceCache* localCache) {
+    SkASSERT(result.isImmutable());
+    ContentRec* rec = SkNEW_ARGS(ContentRec, (contentID, invScaleX, invScaleY, result));
+    CHECK_LOCAL(localCache, add, Add, rec);
+    result.pixelRef()->notifyAddedToCache();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 
@@ -52,6 +52,25 @@ public:
      */
     static bool Add(SkPixelRef*, const SkIRect& subset, const SkBitmap& result,
                     SkResourceCache* localCache = NULL);
+
+    /**
+     *  Search keyed on a caller-supplied content ID (e.g. a hash of the encoded asset) and
+     *  inverse scales in X and Y, rather than on a pixelref's generation ID. Content IDs are
+     *  stable across processes, so when the cache is backed by shared discardable memory
+     *  (see SkResourceCache::SetDiscardableFactory) a bitmap decoded or scaled by one process
+     *  can be found by the others. If found, returns true and result will be set to the
+     *  matching bitmap with its pixels already locked.
+     */
+    static bool FindByContentID(uint64_t contentID, SkScalar invScaleX, SkScalar invScaleY,
+                                SkBitmap* result, SkResourceCache* localCache = NULL);
+
+    /*
+     *  result must be marked isImmutable(). The entry's sharedID is the contentID, so all
+     *  scaled variants of an asset can be purged together with
+     *  SkResourceCache::PostPurgeSharedID(contentID).
+     */
+    static void AddByContentID(uint64_t contentID, SkScalar invScaleX, SkScalar invScaleY,
+                               const SkBitmap& result, SkResourceCache* localCache = NULL);
 };
 
 class SkMipMapCache {
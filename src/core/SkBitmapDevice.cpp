@@ -6,12 +6,16 @@
  */
 
 #include "SkBitmapDevice.h"
+#include "SkBitmapCache.h"
 #include "SkConfig8888.h"
 #include "SkDeviceProperties.h"
 #include "SkDraw.h"
+#include "SkDrawTiler.h"
 #include "SkRasterClip.h"
 #include "SkShader.h"
 #include "SkSurface.h"
+#include "SkTextBlob.h"
+#include "SkTextBlobMaskCache.h"
 
 #define CHECK_FOR_ANNOTATION(paint) \
     do { if (paint.getAnnotation()) { return; } } while (0)
@@ -189,6 +193,12 @@ void SkBitmapDevice::drawRect(const SkDraw& draw, const SkRect& r, const SkPaint
     draw.drawRect(r, paint);
 }
 
+void SkBitmapDevice::drawRects(const SkDraw& draw, const SkRect rects[], int count,
+                               const SkPaint& paint) {
+    CHECK_FOR_ANNOTATION(paint);
+    draw.drawRects(rects, count, paint);
+}
+
 void SkBitmapDevice::drawOval(const SkDraw& draw, const SkRect& oval, const SkPaint& paint) {
     CHECK_FOR_ANNOTATION(paint);
 
@@ -218,11 +228,19 @@ void SkBitmapDevice::drawPath(const SkDraw& draw, const SkPath& path,
                               const SkPaint& paint, const SkMatrix* prePathMatrix,
                               bool pathIsMutable) {
     CHECK_FOR_ANNOTATION(paint);
+    if (this->getLeakyProperties().allowThreadedRaster() && SkDrawTiler::Usable(draw, paint)) {
+        SkDrawTiler::DrawPath(draw, path, paint, prePathMatrix, pathIsMutable);
+        return;
+    }
     draw.drawPath(path, paint, prePathMatrix, pathIsMutable);
 }
 
 void SkBitmapDevice::drawBitmap(const SkDraw& draw, const SkBitmap& bitmap,
                                 const SkMatrix& matrix, const SkPaint& paint) {
+    if (this->getLeakyProperties().allowThreadedRaster() && SkDrawTiler::Usable(draw, paint)) {
+        SkDrawTiler::DrawBitmap(draw, bitmap, matrix, NULL, paint);
+        return;
+    }
     draw.drawBitmap(bitmap, matrix, NULL, paint);
 }
 
@@ -260,29 +278,42 @@ void SkBitmapDevice::drawBitmapRect(const SkDraw& draw, const SkBitmap& bitmap,
         }
 
         // since we may need to clamp to the borders of the src rect within
-        // the bitmap, we extract a subset.
+        // the bitmap, we extract a subset. If the rounded-out src covers the
+        // whole bitmap there is nothing to window, so keep drawing from the
+        // original (a common case when slicing with fractional src rects).
         const SkIRect srcIR = tmpSrc.roundOut();
-        if(bitmap.pixelRef()->getTexture()) {
-            // Accelerated source canvas, don't use extractSubset but readPixels to get the subset.
-            // This way, the pixels are copied in CPU memory instead of GPU memory.
-            bitmap.pixelRef()->readPixels(&tmpBitmap, &srcIR);
-        } else {
-            if (!bitmap.extractSubset(&tmpBitmap, srcIR)) {
-                return;
+        if (srcIR != SkIRect::MakeWH(bitmap.width(), bitmap.height())) {
+            if (bitmap.pixelRef()->getTexture()) {
+                // Accelerated source canvas, don't use extractSubset but readPixels to get the
+                // subset. This way, the pixels are copied in CPU memory instead of GPU memory.
+                // The read-back window is cached keyed on (genID, bounds within the pixelRef),
+                // so repeatedly slicing the same source pays for each copy once, not per draw.
+                SkIRect prSubset = srcIR;
+                prSubset.offset(bitmap.pixelRefOrigin());
+                if (!SkBitmapCache::Find(bitmap.getGenerationID(), prSubset, &tmpBitmap)) {
+                    bitmap.pixelRef()->readPixels(&tmpBitmap, &srcIR);
+                    tmpBitmap.setImmutable();
+                    SkBitmapCache::Add(bitmap.pixelRef(), prSubset, tmpBitmap);
+                }
+            } else {
+                // This shares the pixelRef at an offset -- no pixels are copied.
+                if (!bitmap.extractSubset(&tmpBitmap, srcIR)) {
+                    return;
+                }
             }
-        }
-        bitmapPtr = &tmpBitmap;
+            bitmapPtr = &tmpBitmap;
 
-        // Since we did an extract, we need to adjust the matrix accordingly
-        SkScalar dx = 0, dy = 0;
-        if (srcIR.fLeft > 0) {
-            dx = SkIntToScalar(srcIR.fLeft);
-        }
-        if (srcIR.fTop > 0) {
-            dy = SkIntToScalar(srcIR.fTop);
-        }
-        if (dx || dy) {
-            matrix.preTranslate(dx, dy);
+            // Since we did an extract, we need to adjust the matrix accordingly
+            SkScalar dx = 0, dy = 0;
+            if (srcIR.fLeft > 0) {
+                dx = SkIntToScalar(srcIR.fLeft);
+            }
+            if (srcIR.fTop > 0) {
+                dy = SkIntToScalar(srcIR.fTop);
+            }
+            if (dx || dy) {
+                matrix.preTranslate(dx, dy);
+            }
         }
 
         SkRect extractedBitmapBounds;
@@ -318,11 +349,25 @@ void SkBitmapDevice::drawBitmapRect(const SkDraw& draw, const SkBitmap& bitmap,
     this->drawRect(draw, *dstPtr, paintWithShader);
 }
 
+void SkBitmapDevice::drawBitmapNine(const SkDraw& draw, const SkBitmap& bitmap,
+                                    const SkIRect& center, const SkRect& dst,
+                                    const SkPaint& paint) {
+    if (!draw.drawBitmapNine(bitmap, center, dst, paint)) {
+        this->INHERITED::drawBitmapNine(draw, bitmap, center, dst, paint);
+    }
+}
+
 void SkBitmapDevice::drawSprite(const SkDraw& draw, const SkBitmap& bitmap,
                                 int x, int y, const SkPaint& paint) {
     draw.drawSprite(bitmap, x, y, paint);
 }
 
+void SkBitmapDevice::drawSprites(const SkDraw& draw, const SkBitmap& bitmap,
+                                 const SkIRect src[], const SkIPoint dst[],
+                                 int count, const SkPaint& paint) {
+    draw.drawSprites(bitmap, src, dst, count, paint);
+}
+
 void SkBitmapDevice::drawText(const SkDraw& draw, const void* text, size_t len,
                               SkScalar x, SkScalar y, const SkPaint& paint) {
     draw.drawText((const char*)text, len, x, y, paint);
@@ -334,6 +379,82 @@ void SkBitmapDevice::drawPosText(const SkDraw& draw, const void* text, size_t le
     draw.drawPosText((const char*)text, len, xpos, scalarsPerPos, offset, paint);
 }
 
+void SkBitmapDevice::drawTextBlob(const SkDraw& draw, const SkTextBlob* blob, SkScalar x,
+                                  SkScalar y, const SkPaint& paint, SkDrawFilter* drawFilter) {
+    SkMatrix matrix = *draw.fMatrix;
+    matrix.preTranslate(x, y);
+
+    // A draw filter may change the paint per run, which the cache key cannot
+    // describe.
+    if (drawFilter || !SkTextBlobMaskCache::IsCacheable(blob, matrix, paint)) {
+        this->INHERITED::drawTextBlob(draw, blob, x, y, paint, drawFilter);
+        return;
+    }
+
+    // The cached mask is positioned with the translation reduced to its
+    // fractional part; the integer part is reapplied when blitting.
+    const int intX = SkScalarFloorToInt(matrix.getTranslateX());
+    const int intY = SkScalarFloorToInt(matrix.getTranslateY());
+
+    SkMask mask;
+    SkAutoTUnref<SkCachedData> data(
+            SkTextBlobMaskCache::FindAndRef(blob->uniqueID(), matrix, paint, &mask));
+    if (NULL == data) {
+        SkMatrix localMatrix(matrix);
+        localMatrix.postTranslate(-SkIntToScalar(intX), -SkIntToScalar(intY));
+
+        SkRect localBounds;
+        localMatrix.mapRect(&localBounds, blob->bounds());
+        SkIRect ir;
+        localBounds.roundOut(&ir);
+        if (ir.isEmpty()) {
+            return;
+        }
+
+        mask.fBounds = ir;
+        mask.fFormat = SkMask::kA8_Format;
+        mask.fRowBytes = ir.width();
+        const size_t size = mask.computeImageSize();
+        if (0 == size) {
+            this->INHERITED::drawTextBlob(draw, blob, x, y, paint, drawFilter);
+            return;
+        }
+        data.reset(SkResourceCache::NewCachedData(size));
+        mask.fImage = (uint8_t*)data->writable_data();
+        sk_bzero(mask.fImage, size);
+
+        SkBitmap maskBitmap;
+        maskBitmap.installPixels(SkImageInfo::MakeA8(ir.width(), ir.height()),
+                                 mask.fImage, mask.fRowBytes);
+
+        SkMatrix maskMatrix(localMatrix);
+        maskMatrix.postTranslate(-SkIntToScalar(ir.left()), -SkIntToScalar(ir.top()));
+        SkRasterClip maskClip(SkIRect::MakeWH(ir.width(), ir.height()));
+
+        SkDraw maskDraw(draw);
+        maskDraw.fBitmap = &maskBitmap;
+        maskDraw.fMatrix = &maskMatrix;
+        maskDraw.fRC = &maskClip;
+        maskDraw.fClip = &maskClip.bwRgn();
+
+        // The mask captures coverage only; color (and any shader or transfer
+        // mode) is applied when the mask is blitted below.
+        SkPaint maskPaint(paint);
+        maskPaint.setColor(SK_ColorBLACK);
+        maskPaint.setShader(NULL);
+        maskPaint.setColorFilter(NULL);
+        maskPaint.setXfermode(NULL);
+
+        // x/y are already folded into the matrices.
+        this->INHERITED::drawTextBlob(maskDraw, blob, 0, 0, maskPaint, NULL);
+
+        SkTextBlobMaskCache::Add(blob->uniqueID(), matrix, paint, mask, data);
+    }
+
+    mask.fBounds.offset(intX, intY);
+    draw.drawDevMask(mask, paint);
+}
+
 void SkBitmapDevice::drawVertices(const SkDraw& draw, SkCanvas::VertexMode vmode,
                                   int vertexCount,
                                   const SkPoint verts[], const SkPoint textures[],
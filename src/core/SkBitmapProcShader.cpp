@@ -11,6 +11,8 @@
 #include "SkPixelRef.h"
 #include "SkErrorInternals.h"
 #include "SkBitmapProcShader.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #include "SkUtilsArm.h"
 #if SK_SUPPORT_GPU
 #include "effects/GrSimpleTextureEffect.h"
@@ -214,26 +216,16 @@ bool checkDecal(const SkBitmapProcState& s, int x, int y, int count) {
     return false;
 }
 
-void SkBitmapProcShader::BitmapProcShaderContext::shadeSpan(int x, int y, SkPMColor dstC[],
-                                                            int count) {
-    const SkBitmapProcState& state = *fState;
-    if (state.getShaderProc32()) {
-#if !SK_ARM_NEON_IS_NONE
-#if !defined(__LP64__)
-        if (state.getShaderProc32() == SK_ARM_NEON_WRAP(Clamp_S32_Opaque_D32_filter_DX_shaderproc)) {
-            if (checkDecal(state, x, y, count)) {
-                state.getShaderProc32()(state, x, y, dstC, count);
-                return;
-            }
-        } else
-#endif
-#endif
-        {
-            state.getShaderProc32()(state, x, y, dstC, count);
-            return;
-        }
-    }
+enum {
+    // Spans at least this long are split across the task group threads.
+    kMinPixelsForParallelShade = 4096,
+    // Aim for chunks roughly this long; the minimum above guarantees at least two.
+    kParallelShadeChunk = 2048,
+    kMaxShadeChunks = 8,
+};
 
+static void shade_span32(const SkBitmapProcState& state, int x, int y,
+                         SkPMColor dstC[], int count) {
     uint32_t buffer[BUF_MAX + TEST_BUFFER_EXTRA];
     SkBitmapProcState::MatrixProc   mproc = state.getMatrixProc();
     SkBitmapProcState::SampleProc32 sproc = state.getSampleProc32();
@@ -271,6 +263,60 @@ void SkBitmapProcShader::BitmapProcShaderContext::shadeSpan(int x, int y, SkPMCo
     }
 }
 
+// One stretch of a long span being shaded by the task group.
+struct SpanChunk {
+    const SkBitmapProcState* fState;
+    int fX, fY, fCount;
+    SkPMColor* fColors;
+};
+
+static void shade_span_chunk(SpanChunk* chunk) {
+    shade_span32(*chunk->fState, chunk->fX, chunk->fY, chunk->fColors, chunk->fCount);
+}
+
+void SkBitmapProcShader::BitmapProcShaderContext::shadeSpan(int x, int y, SkPMColor dstC[],
+                                                            int count) {
+    const SkBitmapProcState& state = *fState;
+    if (state.getShaderProc32()) {
+#if !SK_ARM_NEON_IS_NONE
+#if !defined(__LP64__)
+        if (state.getShaderProc32() == SK_ARM_NEON_WRAP(Clamp_S32_Opaque_D32_filter_DX_shaderproc)) {
+            if (checkDecal(state, x, y, count)) {
+                state.getShaderProc32()(state, x, y, dstC, count);
+                return;
+            }
+        } else
+#endif
+#endif
+        {
+            state.getShaderProc32()(state, x, y, dstC, count);
+            return;
+        }
+    }
+
+    if (count >= kMinPixelsForParallelShade) {
+        // Long spans are sampling-bound; carve them up for the task group threads.
+        // The state is read-only during shading and each chunk writes only its own
+        // slice of dstC, so the chunks are independent.
+        int chunkCount = SkMin32(count / kParallelShadeChunk, (int)kMaxShadeChunks);
+        SkASSERT(chunkCount >= 2);
+        SkAutoSTMalloc<kMaxShadeChunks, SpanChunk> storage(chunkCount);
+        SpanChunk* chunks = storage.get();
+        const int chunkLen = count / chunkCount;
+        for (int i = 0; i < chunkCount; i++) {
+            chunks[i].fState = fState;
+            chunks[i].fX = x + i * chunkLen;
+            chunks[i].fY = y;
+            chunks[i].fColors = dstC + i * chunkLen;
+            chunks[i].fCount = (i == chunkCount - 1) ? count - i * chunkLen : chunkLen;
+        }
+        SkTaskGroup().batch(shade_span_chunk, chunks, chunkCount);
+        return;
+    }
+
+    shade_span32(state, x, y, dstC, count);
+}
+
 SkShader::Context::ShadeProc SkBitmapProcShader::BitmapProcShaderContext::asAShadeProc(void** ctx) {
     if (fState->getShaderProc32()) {
         *ctx = fState;
@@ -78,12 +78,13 @@ private:
     typedef SkShader INHERITED;
 };
 
-// Commonly used allocator. It currently is only used to allocate up to 3 objects. The total
+// Commonly used allocator. It currently is only used to allocate up to 5 objects. The total
 // bytes requested is calculated using one of our large shaders, its context size plus the size of
-// an Sk3DBlitter in SkDraw.cpp
+// an Sk3DBlitter in SkDraw.cpp, plus the wrapper shaders SkBlitter::Choose may interpose
+// (SkColorShader/SkFilterShader/Sk3DShader), which are allocated here rather than on the heap.
 // Note that some contexts may contain other contexts (e.g. for compose shaders), but we've not
 // yet found a situation where the size below isn't big enough.
-typedef SkSmallAllocator<3, 1024> SkTBlitterAllocator;
+typedef SkSmallAllocator<5, 1536> SkTBlitterAllocator;
 
 // If alloc is non-NULL, it will be used to allocate the returned SkShader, and MUST outlive
 // the SkShader.
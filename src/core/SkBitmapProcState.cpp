@@ -25,6 +25,9 @@ extern const SkBitmapProcState::SampleProc32 gSkBitmapProcStateSample32_neon[];
 extern void  S16_D16_filter_DX_neon(const SkBitmapProcState&, const uint32_t*, int, uint16_t*);
 extern void  Clamp_S16_D16_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint16_t*, int);
 extern void  Repeat_S16_D16_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint16_t*, int);
+extern void  Mirror_S16_D16_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint16_t*, int);
+extern void  Repeat_S32_opaque_D32_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint32_t*, int);
+extern void  Mirror_S32_opaque_D32_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint32_t*, int);
 extern void  SI8_opaque_D32_filter_DX_neon(const SkBitmapProcState&, const uint32_t*, int, SkPMColor*);
 extern void  SI8_opaque_D32_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint32_t*, int);
 extern void  Clamp_SI8_opaque_D32_filter_DX_shaderproc_neon(const SkBitmapProcState&, int, int, uint32_t*, int);
@@ -517,9 +520,20 @@ bool SkBitmapProcState::chooseScanlineProcs(bool trivialMatrix, bool clampClamp,
             } else if (SkShader::kRepeat_TileMode == fTileModeX &&
                        SkShader::kRepeat_TileMode == fTileModeY) {
                 fShaderProc16 = SK_ARM_NEON_WRAP(Repeat_S16_D16_filter_DX_shaderproc);
+            } else if (SkShader::kMirror_TileMode == fTileModeX &&
+                       SkShader::kMirror_TileMode == fTileModeY) {
+                fShaderProc16 = SK_ARM_NEON_WRAP(Mirror_S16_D16_filter_DX_shaderproc);
             }
         } else if (SK_ARM_NEON_WRAP(SI8_opaque_D32_filter_DX) == fSampleProc32 && clampClamp) {
             fShaderProc32 = SK_ARM_NEON_WRAP(Clamp_SI8_opaque_D32_filter_DX_shaderproc);
+        } else if (SK_ARM_NEON_WRAP(S32_opaque_D32_filter_DX) == fSampleProc32) {
+            if (SkShader::kRepeat_TileMode == fTileModeX &&
+                SkShader::kRepeat_TileMode == fTileModeY) {
+                fShaderProc32 = SK_ARM_NEON_WRAP(Repeat_S32_opaque_D32_filter_DX_shaderproc);
+            } else if (SkShader::kMirror_TileMode == fTileModeX &&
+                       SkShader::kMirror_TileMode == fTileModeY) {
+                fShaderProc32 = SK_ARM_NEON_WRAP(Mirror_S32_opaque_D32_filter_DX_shaderproc);
+            }
         } else if (S32_opaque_D32_nofilter_DX == fSampleProc32 && clampClamp) {
             fShaderProc32 = Clamp_S32_opaque_D32_nofilter_DX_shaderproc;
         }
@@ -2,6 +2,8 @@
 #include "SkBitmapFilter.h"
 #include "SkRect.h"
 #include "SkTArray.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #include "SkErrorInternals.h"
 #include "SkConvolver.h"
 
@@ -207,6 +209,40 @@ void SkResizeFilter::computeFilters(int srcSize,
   }
 }
 
+namespace {
+
+// One horizontal band of output rows. Bands write disjoint rows of the same
+// destination and only read the filters and the source, so they can be
+// convolved on different threads.
+struct ConvolveBand {
+    const unsigned char* fSource;
+    int fSourceRowBytes;
+    bool fHasAlpha;
+    const SkConvolutionFilter1D* fXFilter;
+    const SkConvolutionFilter1D* fYFilter;
+    int fOutputRowBytes;
+    unsigned char* fOutput;
+    const SkConvolutionProcs* fConvolveProcs;
+    int fOutYStart;
+    int fOutYEnd;
+};
+
+}  // namespace
+
+static void convolve_band(ConvolveBand* band) {
+    BGRAConvolve2DBand(band->fSource, band->fSourceRowBytes, band->fHasAlpha,
+                       *band->fXFilter, *band->fYFilter,
+                       band->fOutputRowBytes, band->fOutput,
+                       *band->fConvolveProcs, true,
+                       band->fOutYStart, band->fOutYEnd);
+}
+
+// Neighboring bands redo the horizontal convolutions their vertical filter
+// windows share, so bands are kept several filter-heights tall to bound the
+// redundant work, and resizes that only yield one band stay on the caller's
+// thread.
+static const int kMinRowsPerBand = 32;
+
 static SkBitmapScaler::ResizeMethod ResizeMethodToAlgorithmMethod(
                                     SkBitmapScaler::ResizeMethod method) {
     // Convert any "Quality Method" into an "Algorithm Method"
@@ -299,11 +335,34 @@ bool SkBitmapScaler::Resize(SkBitmap* resultPtr,
       return false;
   }
 
-  BGRAConvolve2D(sourceSubset, static_cast<int>(source.rowBytes()),
-      !source.isOpaque(), filter.xFilter(), filter.yFilter(),
-      static_cast<int>(result.rowBytes()),
-      static_cast<unsigned char*>(result.getPixels()),
-      convolveProcs, true);
+  const int numOutputRows = filter.yFilter().numValues();
+  const int rowsPerBand = SkTMax(kMinRowsPerBand, filter.yFilter().maxFilter() * 4);
+  const int bandCount = numOutputRows / rowsPerBand;  // remainder folds into the last band
+
+  if (bandCount < 2) {
+      BGRAConvolve2D(sourceSubset, static_cast<int>(source.rowBytes()),
+          !source.isOpaque(), filter.xFilter(), filter.yFilter(),
+          static_cast<int>(result.rowBytes()),
+          static_cast<unsigned char*>(result.getPixels()),
+          convolveProcs, true);
+  } else {
+      SkAutoSTMalloc<8, ConvolveBand> bands(bandCount);
+      for (int i = 0; i < bandCount; i++) {
+          ConvolveBand* band = &bands.get()[i];
+          band->fSource = sourceSubset;
+          band->fSourceRowBytes = static_cast<int>(source.rowBytes());
+          band->fHasAlpha = !source.isOpaque();
+          band->fXFilter = &filter.xFilter();
+          band->fYFilter = &filter.yFilter();
+          band->fOutputRowBytes = static_cast<int>(result.rowBytes());
+          band->fOutput = static_cast<unsigned char*>(result.getPixels());
+          band->fConvolveProcs = &convolveProcs;
+          band->fOutYStart = i * rowsPerBand;
+          band->fOutYEnd = (i + 1 == bandCount) ? numOutputRows
+                                                : (i + 1) * rowsPerBand;
+      }
+      SkTaskGroup().batch(convolve_band, bands.get(), bandCount);
+  }
 
   *resultPtr = result;
   resultPtr->lockPixels();
@@ -7,12 +7,13 @@
 
 #include "SkBlitRow.h"
 #include "SkColorPriv.h"
+#include "SkOnce.h"
 #include "SkDither.h"
 #include "SkMathPriv.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static void S32_D565_Opaque(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32_D565_Opaque(uint16_t* SK_RESTRICT dst,
                             const SkPMColor* SK_RESTRICT src, int count,
                             U8CPU alpha, int /*x*/, int /*y*/) {
     SkASSERT(255 == alpha);
@@ -26,7 +27,7 @@ static void S32_D565_Opaque(uint16_t* SK_RESTRICT dst,
     }
 }
 
-static void S32_D565_Blend(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32_D565_Blend(uint16_t* SK_RESTRICT dst,
                              const SkPMColor* SK_RESTRICT src, int count,
                              U8CPU alpha, int /*x*/, int /*y*/) {
     SkASSERT(255 > alpha);
@@ -45,7 +46,7 @@ static void S32_D565_Blend(uint16_t* SK_RESTRICT dst,
     }
 }
 
-static void S32A_D565_Opaque(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32A_D565_Opaque(uint16_t* SK_RESTRICT dst,
                                const SkPMColor* SK_RESTRICT src, int count,
                                U8CPU alpha, int /*x*/, int /*y*/) {
     SkASSERT(255 == alpha);
@@ -63,7 +64,7 @@ static void S32A_D565_Opaque(uint16_t* SK_RESTRICT dst,
     }
 }
 
-static void S32A_D565_Blend(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32A_D565_Blend(uint16_t* SK_RESTRICT dst,
                               const SkPMColor* SK_RESTRICT src, int count,
                                U8CPU alpha, int /*x*/, int /*y*/) {
     SkASSERT(255 > alpha);
@@ -84,7 +85,7 @@ static void S32A_D565_Blend(uint16_t* SK_RESTRICT dst,
 
 /////////////////////////////////////////////////////////////////////////////
 
-static void S32_D565_Opaque_Dither(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32_D565_Opaque_Dither(uint16_t* SK_RESTRICT dst,
                                      const SkPMColor* SK_RESTRICT src,
                                      int count, U8CPU alpha, int x, int y) {
     SkASSERT(255 == alpha);
@@ -102,7 +103,7 @@ static void S32_D565_Opaque_Dither(uint16_t* SK_RESTRICT dst,
     }
 }
 
-static void S32_D565_Blend_Dither(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32_D565_Blend_Dither(uint16_t* SK_RESTRICT dst,
                                     const SkPMColor* SK_RESTRICT src,
                                     int count, U8CPU alpha, int x, int y) {
     SkASSERT(255 > alpha);
@@ -131,7 +132,7 @@ static void S32_D565_Blend_Dither(uint16_t* SK_RESTRICT dst,
     }
 }
 
-static void S32A_D565_Opaque_Dither(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32A_D565_Opaque_Dither(uint16_t* SK_RESTRICT dst,
                                       const SkPMColor* SK_RESTRICT src,
                                       int count, U8CPU alpha, int x, int y) {
     SkASSERT(255 == alpha);
@@ -165,7 +166,7 @@ static void S32A_D565_Opaque_Dither(uint16_t* SK_RESTRICT dst,
     }
 }
 
-static void S32A_D565_Blend_Dither(uint16_t* SK_RESTRICT dst,
+static SK_ATTR_HOT void S32A_D565_Blend_Dither(uint16_t* SK_RESTRICT dst,
                                      const SkPMColor* SK_RESTRICT src,
                                      int count, U8CPU alpha, int x, int y) {
     SkASSERT(255 > alpha);
@@ -240,18 +241,6 @@ static const SkBlitRow::Proc16 gDefault_565_Procs[] = {
     S32A_D565_Blend_Dither
 };
 
-SkBlitRow::Proc16 SkBlitRow::Factory16(unsigned flags) {
-    SkASSERT(flags < SK_ARRAY_COUNT(gDefault_565_Procs));
-    // just so we don't crash
-    flags &= kFlags16_Mask;
-
-    SkBlitRow::Proc16 proc = PlatformFactory565(flags);
-    if (NULL == proc) {
-        proc = gDefault_565_Procs[flags];
-    }
-    return proc;
-}
-
 static const SkBlitRow::ColorProc16 gDefault_565_ColorProcs[] = {
 #if 0
     Color32A_D565,
@@ -263,6 +252,36 @@ static const SkBlitRow::ColorProc16 gDefault_565_ColorProcs[] = {
 #endif
 };
 
+static SkBlitRow::Proc16 gResolved_565_Procs[SK_ARRAY_COUNT(gDefault_565_Procs)];
+static SkBlitRow::ColorProc16 gResolved_565_ColorProcs[SK_ARRAY_COUNT(gDefault_565_ColorProcs)];
+
+static void init_565_procs() {
+    for (unsigned flags = 0; flags < SK_ARRAY_COUNT(gDefault_565_Procs); flags++) {
+        SkBlitRow::Proc16 proc = SkBlitRow::PlatformFactory565(flags);
+        gResolved_565_Procs[flags] = proc ? proc : gDefault_565_Procs[flags];
+    }
+    for (unsigned flags = 0; flags < SK_ARRAY_COUNT(gDefault_565_ColorProcs); flags++) {
+        SkBlitRow::ColorProc16 proc = SkBlitRow::PlatformColorFactory565(flags);
+        gResolved_565_ColorProcs[flags] = proc ? proc : gDefault_565_ColorProcs[flags];
+    }
+}
+
+SK_DECLARE_STATIC_ONCE(gOnce565Procs);
+
+// Called by SkBlitRow::InitProcTables() in SkBlitRow_D32.cpp.
+void SkBlitRow_Init565Procs() {
+    SkOnce(&gOnce565Procs, init_565_procs);
+}
+
+SkBlitRow::Proc16 SkBlitRow::Factory16(unsigned flags) {
+    SkASSERT(flags < SK_ARRAY_COUNT(gDefault_565_Procs));
+    // just so we don't crash
+    flags &= kFlags16_Mask;
+
+    SkBlitRow_Init565Procs();
+    return gResolved_565_Procs[flags];
+}
+
 SkBlitRow::ColorProc16 SkBlitRow::ColorFactory16(unsigned flags) {
     SkASSERT((flags & ~kFlags16_Mask) == 0);
     // just so we don't crash
@@ -273,9 +292,6 @@ SkBlitRow::ColorProc16 SkBlitRow::ColorFactory16(unsigned flags) {
 
     SkASSERT(flags < SK_ARRAY_COUNT(gDefault_565_ColorProcs));
 
-    SkBlitRow::ColorProc16 proc = PlatformColorFactory565(flags);
-    if (NULL == proc) {
-        proc = gDefault_565_ColorProcs[flags];
-    }
-    return proc;
+    SkBlitRow_Init565Procs();
+    return gResolved_565_ColorProcs[flags];
 }
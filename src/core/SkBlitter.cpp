@@ -777,6 +777,106 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SkCoreBlitters.h"
+#include "SkTLS.h"
+
+namespace {
+
+/*  Per-thread, single-entry pool of shader contexts (see SkShader::isContextPoolable).
+ *  Keeps the most recently built poolable context alive across draws, so a steady run of
+ *  draws with the same shader, paint and matrix reuses the constructed context (and, for
+ *  gradients, its bound color cache) instead of rebuilding it each time.
+ */
+class ShaderContextPool {
+public:
+    SkShader::Context* acquire(const SkShader* shader, const SkShader::ContextRec& rec) {
+        if (fContext && !fInUse && !fDirty &&
+            fShader == shader &&
+            fPaintGenID == rec.fPaint->getGenerationID() &&
+            fDeviceColorType == rec.fDevice->colorType() &&
+            fMatrix == *rec.fMatrix) {
+            fInUse = true;
+            return fContext;
+        }
+        return NULL;
+    }
+
+    bool canInstall() const { return !fInUse; }
+
+    /* Takes ownership of storage (and the context constructed in it). */
+    void install(SkShader* shader, const SkShader::ContextRec& rec,
+                 SkShader::Context* context, void* storage) {
+        SkASSERT(this->canInstall());
+        this->evict();
+        fShader = SkRef(shader);
+        fPaintGenID = rec.fPaint->getGenerationID();
+        fDeviceColorType = rec.fDevice->colorType();
+        fMatrix = *rec.fMatrix;
+        fContext = context;
+        fStorage = storage;
+        fInUse = true;
+        fDirty = false;
+    }
+
+    /* No-op (returning false) for contexts that do not belong to the pool. */
+    bool release(SkShader::Context* context) {
+        if (context != fContext) {
+            return false;
+        }
+        SkASSERT(fInUse);
+        fInUse = false;
+        if (fDirty) {
+            this->evict();
+        }
+        return true;
+    }
+
+    /* Call when a pooled context is rebuilt in place for a different rec: its cached key
+     * no longer matches, so it must be torn down once its current draw releases it.
+     */
+    void markDirty(SkShader::Context* context) {
+        if (context == fContext) {
+            fDirty = true;
+        }
+    }
+
+    static ShaderContextPool* Get() {
+        return (ShaderContextPool*)SkTLS::Get(Create, Delete);
+    }
+
+private:
+    ShaderContextPool()
+        : fShader(NULL), fContext(NULL), fStorage(NULL), fInUse(false), fDirty(false) {}
+
+    ~ShaderContextPool() {
+        SkASSERT(!fInUse);
+        this->evict();
+    }
+
+    void evict() {
+        if (fContext) {
+            fContext->~Context();
+            sk_free(fStorage);
+            fShader->unref();
+            fShader = NULL;
+            fContext = NULL;
+            fStorage = NULL;
+        }
+    }
+
+    static void* Create() { return SkNEW(ShaderContextPool); }
+    static void Delete(void* ptr) { SkDELETE((ShaderContextPool*)ptr); }
+
+    SkShader*          fShader;           // ref'd; part of the key
+    uint32_t           fPaintGenID;
+    SkColorType        fDeviceColorType;
+    SkMatrix           fMatrix;
+    SkShader::Context* fContext;          // lives in fStorage
+    void*              fStorage;
+    bool               fInUse;
+    bool               fDirty;
+};
+
+}  // namespace
 
 SkBlitter* SkBlitter::Choose(const SkBitmap& device,
                              const SkMatrix& matrix,
@@ -801,9 +901,11 @@ SkBlitter* SkBlitter::Choose(const SkBitmap& device,
 
     if (origPaint.getMaskFilter() != NULL &&
             origPaint.getMaskFilter()->getFormat() == SkMask::k3D_Format) {
-        shader3D = SkNEW_ARGS(Sk3DShader, (shader));
+        shader3D = allocator->createT<Sk3DShader>(shader);
         // we know we haven't initialized lazyPaint yet, so just do it
-        paint.writable()->setShader(shader3D)->unref();
+        // As in SkAutoBitmapShaderInstall, the shader deliberately keeps an
+        // owner-count of 2; the allocator, not unref(), destroys it.
+        paint.writable()->setShader(shader3D);
         shader = shader3D;
     }
 
@@ -838,8 +940,9 @@ SkBlitter* SkBlitter::Choose(const SkBitmap& device,
     if (NULL == shader) {
         if (mode) {
             // xfermodes (and filters) require shaders for our current blitters
-            shader = SkNEW_ARGS(SkColorShader, (paint->getColor()));
-            paint.writable()->setShader(shader)->unref();
+            shader = allocator->createT<SkColorShader>(paint->getColor());
+            // owner-count stays 2; the allocator destroys the shader
+            paint.writable()->setShader(shader);
             paint.writable()->setAlpha(0xFF);
         } else if (cf) {
             // if no shader && no xfermode, we just apply the colorfilter to
@@ -853,8 +956,9 @@ SkBlitter* SkBlitter::Choose(const SkBitmap& device,
 
     if (cf) {
         SkASSERT(shader);
-        shader = SkNEW_ARGS(SkFilterShader, (shader, cf));
-        paint.writable()->setShader(shader)->unref();
+        shader = allocator->createT<SkFilterShader>(shader, cf);
+        // owner-count stays 2; the allocator destroys the shader
+        paint.writable()->setShader(shader);
         // blitters should ignore the presence/absence of a filter, since
         // if there is one, the shader will take care of it.
     }
@@ -866,7 +970,23 @@ SkBlitter* SkBlitter::Choose(const SkBitmap& device,
     if (shader) {
         SkShader::ContextRec rec(device, *paint, matrix);
         size_t contextSize = shader->contextSize();
-        if (contextSize) {
+        if (0 == contextSize) {
+            return allocator->createT<SkNullBlitter>();
+        }
+        if (shader->isContextPoolable()) {
+            ShaderContextPool* pool = ShaderContextPool::Get();
+            shaderContext = pool->acquire(shader, rec);
+            if (NULL == shaderContext && pool->canInstall()) {
+                void* storage = sk_malloc_throw(contextSize);
+                shaderContext = shader->createContext(rec, storage);
+                if (NULL == shaderContext) {
+                    sk_free(storage);
+                    return allocator->createT<SkNullBlitter>();
+                }
+                pool->install(shader, rec, shaderContext, storage);
+            }
+        }
+        if (NULL == shaderContext) {
             // Try to create the ShaderContext
             void* storage = allocator->reserveT<SkShader::Context>(contextSize);
             shaderContext = shader->createContext(rec, storage);
@@ -876,8 +996,6 @@ SkBlitter* SkBlitter::Choose(const SkBitmap& device,
             }
             SkASSERT(shaderContext);
             SkASSERT((void*) shaderContext == storage);
-        } else {
-            return allocator->createT<SkNullBlitter>();
         }
     }
 
@@ -912,6 +1030,23 @@ SkBlitter* SkBlitter::Choose(const SkBitmap& device,
             }
             break;
 
+        case kRGBA_F16_SkColorType:
+            if (paint->getXfermode()) {
+                // The F16 blitters only speak srcover (and src, via opaque
+                // sources); don't render other transfer modes wrong.
+                if (shaderContext) {
+                    // No blitter will own (and later release) the context.
+                    ShaderContextPool::Get()->release(shaderContext);
+                }
+                blitter = allocator->createT<SkNullBlitter>();
+            } else if (shader) {
+                blitter = allocator->createT<SkRGBA_F16_Shader_Blitter>(
+                        device, *paint, shaderContext);
+            } else {
+                blitter = allocator->createT<SkRGBA_F16_Blitter>(device, *paint);
+            }
+            break;
+
         default:
             SkDEBUGFAIL("unsupported device config");
             blitter = allocator->createT<SkNullBlitter>();
@@ -957,10 +1092,16 @@ SkShaderBlitter::SkShaderBlitter(const SkBitmap& device, const SkPaint& paint,
 }
 
 SkShaderBlitter::~SkShaderBlitter() {
+    // Hand the context back to the per-thread pool if it came from there; a no-op for
+    // contexts owned by the draw's allocator.
+    ShaderContextPool::Get()->release(fShaderContext);
     fShader->unref();
 }
 
 bool SkShaderBlitter::resetShaderContext(const SkShader::ContextRec& rec) {
+    // The rebuilt context no longer matches the pool's cached key (if it is pooled at all);
+    // make sure the pool tears it down instead of reusing it.
+    ShaderContextPool::Get()->markDirty(fShaderContext);
     // Only destroy the old context if we have a new one. We need to ensure to have a
     // live context in fShaderContext because the storage is owned by an SkSmallAllocator
     // outside of this class.
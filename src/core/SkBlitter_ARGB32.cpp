@@ -360,6 +360,11 @@ SkARGB32_Shader_Blitter::~SkARGB32_Shader_Blitter() {
     sk_free(fBuffer);
 }
 
+// When we can't shade directly into the device we run the shader and the
+// blend fused over small stack chunks, so the intermediate span never leaves
+// L1 (vs. streaming a full device-width heap buffer through both stages).
+enum { kFusedChunkSize = 64 };
+
 void SkARGB32_Shader_Blitter::blitH(int x, int y, int width) {
     SkASSERT(x >= 0 && y >= 0 && x + width <= fDevice.width());
 
@@ -368,12 +373,18 @@ void SkARGB32_Shader_Blitter::blitH(int x, int y, int width) {
     if (fShadeDirectlyIntoDevice) {
         fShaderContext->shadeSpan(x, y, device, width);
     } else {
-        SkPMColor*  span = fBuffer;
-        fShaderContext->shadeSpan(x, y, span, width);
-        if (fXfermode) {
-            fXfermode->xfer32(device, span, width, NULL);
-        } else {
-            fProc32(device, span, width, 255);
+        SkPMColor chunk[kFusedChunkSize];
+        while (width > 0) {
+            const int n = SkMin32(width, kFusedChunkSize);
+            fShaderContext->shadeSpan(x, y, chunk, n);
+            if (fXfermode) {
+                fXfermode->xfer32(device, chunk, n, NULL);
+            } else {
+                fProc32(device, chunk, n, 255);
+            }
+            device += n;
+            x += n;
+            width -= n;
         }
     }
 }
@@ -434,23 +445,11 @@ void SkARGB32_Shader_Blitter::blitRect(int x, int y, int width, int height) {
             } while (--height > 0);
         }
     } else {
-        SkXfermode* xfer = fXfermode;
-        if (xfer) {
-            do {
-                shaderContext->shadeSpan(x, y, span, width);
-                xfer->xfer32(device, span, width, NULL);
-                y += 1;
-                device = (uint32_t*)((char*)device + deviceRB);
-            } while (--height > 0);
-        } else {
-            SkBlitRow::Proc32 proc = fProc32;
-            do {
-                shaderContext->shadeSpan(x, y, span, width);
-                proc(device, span, width, 255);
-                y += 1;
-                device = (uint32_t*)((char*)device + deviceRB);
-            } while (--height > 0);
-        }
+        // Fused shade+blend, chunked to keep the intermediate span in L1.
+        do {
+            this->blitH(x, y, width);
+            y += 1;
+        } while (--height > 0);
     }
 }
 
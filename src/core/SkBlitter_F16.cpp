@@ -0,0 +1,190 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCoreBlitters.h"
+#include "SkColorPriv.h"
+#include "SkHalf.h"
+#include "SkShader.h"
+#include "SkTemplates.h"
+
+/*
+ *  Blitters for kRGBA_F16 devices.  Pixels are four premultiplied halfs in
+ *  R,G,B,A memory order.  Blending happens in single precision: rows are
+ *  expanded with SkHalfToFloat_row, composited srcover, and packed back with
+ *  SkFloatToHalf_row, so the device never drops below 16 bits of storage.
+ *
+ *  Shaders still shade into 8888 spans (that's all SkShader::Context speaks),
+ *  so these blitters buy F16 storage and float-precision compositing, not
+ *  wide-gamut sources.  Only srcover (and src, via opaque sources) is
+ *  supported; SkBlitter::Choose() routes other transfer modes away from us.
+ */
+
+static void pmcolor_to_float4(float dst[4], SkPMColor c) {
+    static const float gInv255 = 1.0f / 255;
+    dst[0] = SkGetPackedR32(c) * gInv255;
+    dst[1] = SkGetPackedG32(c) * gInv255;
+    dst[2] = SkGetPackedB32(c) * gInv255;
+    dst[3] = SkGetPackedA32(c) * gInv255;
+}
+
+// dst = src*scale + dst*(1 - srcA*scale), one pixel of floats.
+static void srcover_1(float dst[4], const float src[4], float scale) {
+    const float dstScale = 1.0f - src[3] * scale;
+    for (int i = 0; i < 4; i++) {
+        dst[i] = src[i] * scale + dst[i] * dstScale;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkRGBA_F16_Blitter::SkRGBA_F16_Blitter(const SkBitmap& device, const SkPaint& paint)
+    : INHERITED(device) {
+    SkASSERT(NULL == paint.getShader());
+    SkASSERT(NULL == paint.getXfermode());
+
+    pmcolor_to_float4(fSrc, SkPreMultiplyColor(paint.getColor()));
+    fSrcIsOpaque = (0xFF == paint.getAlpha());
+
+    SkHalf packed[4];
+    SkFloatToHalf_row(packed, fSrc, 4);
+    memcpy(&fSrcPixel, packed, sizeof(fSrcPixel));
+}
+
+const SkBitmap* SkRGBA_F16_Blitter::justAnOpaqueColor(uint32_t* value) {
+    // Callers expect a 32-bit device, so never take this fast path.
+    return NULL;
+}
+
+void SkRGBA_F16_Blitter::blitH(int x, int y, int width) {
+    SkASSERT(x >= 0 && y >= 0 && x + width <= fDevice.width());
+
+    uint64_t* device = (uint64_t*)fDevice.getAddr(x, y);
+
+    if (fSrcIsOpaque) {
+        for (int i = 0; i < width; i++) {
+            device[i] = fSrcPixel;
+        }
+        return;
+    }
+
+    SkAutoSTMalloc<256, float> storage(width * 4);
+    float* floats = storage.get();
+    SkHalfToFloat_row(floats, (const SkHalf*)device, width * 4);
+    for (int i = 0; i < width; i++) {
+        srcover_1(floats + (i << 2), fSrc, 1.0f);
+    }
+    SkFloatToHalf_row((SkHalf*)device, floats, width * 4);
+}
+
+void SkRGBA_F16_Blitter::blitRect(int x, int y, int width, int height) {
+    SkASSERT(x >= 0 && y >= 0 &&
+             x + width <= fDevice.width() && y + height <= fDevice.height());
+
+    while (--height >= 0) {
+        this->blitH(x, y++, width);
+    }
+}
+
+void SkRGBA_F16_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
+                                   const int16_t runs[]) {
+    uint64_t* device = (uint64_t*)fDevice.getAddr(x, y);
+    SkAutoSTMalloc<256, float> storage(fDevice.width() * 4);
+    float* floats = storage.get();
+
+    for (;;) {
+        int count = runs[0];
+        SkASSERT(count >= 0);
+        if (count <= 0) {
+            return;
+        }
+        unsigned aa = antialias[0];
+        if (aa) {
+            if (0xFF == aa && fSrcIsOpaque) {
+                for (int i = 0; i < count; i++) {
+                    device[i] = fSrcPixel;
+                }
+            } else {
+                const float scale = aa * (1.0f / 255);
+                SkHalfToFloat_row(floats, (const SkHalf*)device, count * 4);
+                for (int i = 0; i < count; i++) {
+                    srcover_1(floats + (i << 2), fSrc, scale);
+                }
+                SkFloatToHalf_row((SkHalf*)device, floats, count * 4);
+            }
+        }
+        runs += count;
+        antialias += count;
+        device += count;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkRGBA_F16_Shader_Blitter::SkRGBA_F16_Shader_Blitter(const SkBitmap& device,
+        const SkPaint& paint, SkShader::Context* shaderContext)
+    : INHERITED(device, paint, shaderContext) {
+    SkASSERT(NULL == paint.getXfermode());
+
+    fBuffer = (SkPMColor*)sk_malloc_throw(device.width() * sizeof(SkPMColor));
+    fFloats = (float*)sk_malloc_throw(device.width() * 4 * sizeof(float));
+}
+
+SkRGBA_F16_Shader_Blitter::~SkRGBA_F16_Shader_Blitter() {
+    sk_free(fFloats);
+    sk_free(fBuffer);
+}
+
+void SkRGBA_F16_Shader_Blitter::blitH(int x, int y, int width) {
+    SkASSERT(x >= 0 && y >= 0 && x + width <= fDevice.width());
+
+    uint64_t* device = (uint64_t*)fDevice.getAddr(x, y);
+    fShaderContext->shadeSpan(x, y, fBuffer, width);
+
+    if (fShaderFlags & SkShader::kOpaqueAlpha_Flag) {
+        // srcover with opaque sources is just src; skip the device read.
+        for (int i = 0; i < width; i++) {
+            pmcolor_to_float4(fFloats + (i << 2), fBuffer[i]);
+        }
+    } else {
+        SkHalfToFloat_row(fFloats, (const SkHalf*)device, width * 4);
+        for (int i = 0; i < width; i++) {
+            float src[4];
+            pmcolor_to_float4(src, fBuffer[i]);
+            srcover_1(fFloats + (i << 2), src, 1.0f);
+        }
+    }
+    SkFloatToHalf_row((SkHalf*)device, fFloats, width * 4);
+}
+
+void SkRGBA_F16_Shader_Blitter::blitAntiH(int x, int y, const SkAlpha antialias[],
+                                          const int16_t runs[]) {
+    uint64_t* device = (uint64_t*)fDevice.getAddr(x, y);
+
+    for (;;) {
+        int count = runs[0];
+        SkASSERT(count >= 0);
+        if (count <= 0) {
+            return;
+        }
+        unsigned aa = antialias[0];
+        if (aa) {
+            fShaderContext->shadeSpan(x, y, fBuffer, count);
+            const float scale = aa * (1.0f / 255);
+            SkHalfToFloat_row(fFloats, (const SkHalf*)device, count * 4);
+            for (int i = 0; i < count; i++) {
+                float src[4];
+                pmcolor_to_float4(src, fBuffer[i]);
+                srcover_1(fFloats + (i << 2), src, scale);
+            }
+            SkFloatToHalf_row((SkHalf*)device, fFloats, count * 4);
+        }
+        runs += count;
+        antialias += count;
+        x += count;
+        device += count;
+    }
+}
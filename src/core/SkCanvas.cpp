@@ -11,6 +11,7 @@
 #include "SkColorFilter.h"
 #include "SkDeviceImageFilterProxy.h"
 #include "SkDraw.h"
+#include "SkDeviceProperties.h"
 #include "SkDrawable.h"
 #include "SkDrawFilter.h"
 #include "SkDrawLooper.h"
@@ -116,11 +117,19 @@ struct DeviceCM {
     SkMatrix            fMatrixStorage;
     const bool          fDeviceIsBitmapDevice;
 
+    // The (clip stack genID, total matrix) that fClip/fMatrix and the
+    // device's matrix-clip were last computed for. When a restore brings
+    // back a clip stack we've already seen, updateMC() can skip the
+    // recomputation entirely.
+    int32_t             fCMGenID;
+    SkMatrix            fCMTotalMatrix;
+
     DeviceCM(SkBaseDevice* device, const SkPaint* paint, SkCanvas* canvas,
              bool conservativeRasterClip, bool deviceIsBitmapDevice)
         : fNext(NULL)
         , fClip(conservativeRasterClip)
         , fDeviceIsBitmapDevice(deviceIsBitmapDevice)
+        , fCMGenID(SkClipStack::kInvalidGenID)
     {
         if (NULL != device) {
             device->ref();
@@ -143,6 +152,7 @@ struct DeviceCM {
         SkASSERT(!fNext);
         SkASSERT(fDevice);
         fClip.setRect(bounds);
+        fCMGenID = SkClipStack::kInvalidGenID;
     }
 
     void updateMC(const SkMatrix& totalMatrix, const SkRasterClip& totalClip,
@@ -152,8 +162,23 @@ struct DeviceCM {
         int width = fDevice->width();
         int height = fDevice->height();
 
+        // When other layers are in the picture, our clip also excludes the
+        // bounds of the layers above us, and that arrangement isn't captured
+        // by the clip stack genID -- so only memoize the single-layer case.
+        const int32_t genID = updateClip ? SkClipStack::kInvalidGenID
+                                         : clipStack.getTopmostGenID();
+        if (genID != SkClipStack::kInvalidGenID && genID == fCMGenID &&
+            totalMatrix == fCMTotalMatrix) {
+            // A restore brought back a state we've already computed:
+            // fMatrix/fClip and the device's matrix-clip are still current.
+            return;
+        }
+
         if ((x | y) == 0) {
-            fMatrix = &totalMatrix;
+            // always copy into fMatrixStorage (even though totalMatrix would
+            // do) so the cached state can't dangle into a popped MCRec
+            fMatrixStorage = totalMatrix;
+            fMatrix = &fMatrixStorage;
             fClip = totalClip;
         } else {
             fMatrixStorage = totalMatrix;
@@ -175,6 +200,9 @@ struct DeviceCM {
 
         fDevice->setMatrixClip(*fMatrix, fClip.forceGetBW(), clipStack);
 
+        fCMGenID = genID;
+        fCMTotalMatrix = totalMatrix;
+
 #ifdef SK_DEBUG
         if (!fClip.isEmpty()) {
             SkIRect deviceR;
@@ -484,18 +512,83 @@ bool AutoDrawLooper::doNext(SkDrawFilter::Type drawType) {
 
 #define LOOPER_BEGIN_DRAWDEVICE(paint, type)                        \
     this->predrawNotify();                                          \
+    if (fCollectDrawStats) {                                        \
+        this->bumpDrawStats((DrawStats::DrawType)type, NULL);       \
+    }                                                               \
+    if (fTrackDamage) {                                             \
+        this->accumulateDamage(NULL);                               \
+    }                                                               \
     AutoDrawLooper  looper(this, fProps, paint, true);              \
     while (looper.next(type)) {                                     \
         SkDrawIter          iter(this);
 
 #define LOOPER_BEGIN(paint, type, bounds)                           \
     this->predrawNotify();                                          \
+    if (fCollectDrawStats) {                                        \
+        this->bumpDrawStats((DrawStats::DrawType)type, bounds);     \
+    }                                                               \
+    if (fTrackDamage) {                                             \
+        this->accumulateDamage(bounds);                             \
+    }                                                               \
     AutoDrawLooper  looper(this, fProps, paint, false, bounds);     \
     while (looper.next(type)) {                                     \
         SkDrawIter          iter(this);
 
 #define LOOPER_END    }
 
+// The cast in the macros above depends on DrawStats::DrawType mirroring SkDrawFilter::Type.
+SK_COMPILE_ASSERT((int)SkCanvas::DrawStats::kDrawTypeCount == (int)SkDrawFilter::kTypeCount,
+                  drawstats_types_out_of_sync);
+SK_COMPILE_ASSERT((int)SkCanvas::DrawStats::kText_DrawType == (int)SkDrawFilter::kText_Type,
+                  drawstats_types_out_of_sync);
+
+void SkCanvas::bumpDrawStats(DrawStats::DrawType type, const SkRect* localBounds) {
+    fDrawStats.fDrawCalls[type] += 1;
+
+    SkIRect ibounds;
+    if (!this->getClipDeviceBounds(&ibounds)) {
+        return;
+    }
+    SkRect device = SkRect::Make(ibounds);
+    if (localBounds) {
+        SkRect mapped;
+        this->getTotalMatrix().mapRect(&mapped, *localBounds);
+        if (!device.intersect(mapped)) {
+            return;
+        }
+    }
+    fDrawStats.fPixelsTouched += (uint64_t)SkScalarCeilToInt(device.width()) *
+                                 (uint64_t)SkScalarCeilToInt(device.height());
+}
+
+void SkCanvas::accumulateDamage(const SkRect* localBounds) {
+    SkIRect ibounds;
+    if (!this->getClipDeviceBounds(&ibounds)) {
+        return;
+    }
+    if (localBounds) {
+        SkRect mapped;
+        this->getTotalMatrix().mapRect(&mapped, *localBounds);
+        SkIRect idraw;
+        mapped.roundOut(&idraw);
+        if (!ibounds.intersect(idraw)) {
+            return;
+        }
+    }
+    fDamage.op(ibounds, SkRegion::kUnion_Op);
+}
+
+void SkCanvas::bumpSaveStats(bool isLayer) {
+    if (isLayer) {
+        fDrawStats.fSaveLayers += 1;
+    } else {
+        fDrawStats.fSaves += 1;
+    }
+    if ((uint32_t)fSaveCount > fDrawStats.fMaxSaveDepth) {
+        fDrawStats.fMaxSaveDepth = fSaveCount;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 void SkCanvas::resetForNextPicture(const SkIRect& bounds) {
@@ -519,6 +612,10 @@ SkBaseDevice* SkCanvas::init(SkBaseDevice* device, InitFlags flags) {
     fDeviceCMDirty = true;
     fSaveCount = 1;
     fMetaData = NULL;
+    fDrawStats.reset();
+    fCollectDrawStats = false;
+    fDamage.setEmpty();
+    fTrackDamage = false;
 
     fClipStack.reset(SkNEW(SkClipStack));
 
@@ -616,7 +713,9 @@ SkCanvas::SkCanvas(const SkBitmap& bitmap, const SkSurfaceProps& props)
 {
     inc_canvas();
 
-    SkAutoTUnref<SkBaseDevice> device(SkNEW_ARGS(SkBitmapDevice, (bitmap)));
+    SkDeviceProperties leaky(props.pixelGeometry());
+    leaky.setAllowThreadedRaster(props.isAllowThreadedRaster());
+    SkAutoTUnref<SkBaseDevice> device(SkNEW_ARGS(SkBitmapDevice, (bitmap, leaky)));
     this->init(device, kDefault_InitFlags);
 }
 
@@ -865,6 +964,9 @@ int SkCanvas::getSaveCount() const {
 int SkCanvas::save() {
     fSaveCount += 1;
     fMCRec->fDeferredSaveCount += 1;
+    if (fCollectDrawStats) {
+        this->bumpSaveStats(false);
+    }
     return this->getSaveCount() - 1;  // return our prev value
 }
 
@@ -971,6 +1073,9 @@ int SkCanvas::saveLayer(const SkRect* bounds, const SkPaint* paint) {
     }
     SaveLayerStrategy strategy = this->willSaveLayer(bounds, paint, kARGB_ClipLayer_SaveFlag);
     fSaveCount += 1;
+    if (fCollectDrawStats) {
+        this->bumpSaveStats(true);
+    }
     this->internalSaveLayer(bounds, paint, kARGB_ClipLayer_SaveFlag, strategy);
     return this->getSaveCount() - 1;
 }
@@ -981,6 +1086,9 @@ int SkCanvas::saveLayer(const SkRect* bounds, const SkPaint* paint, SaveFlags fl
     }
     SaveLayerStrategy strategy = this->willSaveLayer(bounds, paint, flags);
     fSaveCount += 1;
+    if (fCollectDrawStats) {
+        this->bumpSaveStats(true);
+    }
     this->internalSaveLayer(bounds, paint, flags, strategy);
     return this->getSaveCount() - 1;
 }
@@ -1229,7 +1337,7 @@ void SkCanvas::internalDrawDevice(SkBaseDevice* srcDev, int x, int y,
             SkIRect clipBounds = SkIRect::MakeWH(srcDev->width(), srcDev->height());
             SkAutoTUnref<SkImageFilter::Cache> cache(dstDev->getImageFilterCache());
             SkImageFilter::Context ctx(matrix, clipBounds, cache.get());
-            if (filter->filterImage(&proxy, src, ctx, &dst, &offset)) {
+            if (filter->filterImageBanded(&proxy, src, ctx, &dst, &offset)) {
                 SkPaint tmpUnfiltered(*paint);
                 tmpUnfiltered.setImageFilter(NULL);
                 dstDev->drawSprite(iter, dst, pos.x() + offset.x(), pos.y() + offset.y(),
@@ -1279,7 +1387,7 @@ void SkCanvas::onDrawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint*
             const SkIRect clipBounds = bitmap.bounds();
             SkAutoTUnref<SkImageFilter::Cache> cache(iter.fDevice->getImageFilterCache());
             SkImageFilter::Context ctx(matrix, clipBounds, cache.get());
-            if (filter->filterImage(&proxy, bitmap, ctx, &dst, &offset)) {
+            if (filter->filterImageBanded(&proxy, bitmap, ctx, &dst, &offset)) {
                 SkPaint tmpUnfiltered(*paint);
                 tmpUnfiltered.setImageFilter(NULL);
                 iter.fDevice->drawSprite(iter, dst, pos.x() + offset.x(), pos.y() + offset.y(),
@@ -1292,6 +1400,58 @@ void SkCanvas::onDrawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint*
     LOOPER_END
 }
 
+void SkCanvas::onDrawSpriteBatch(const SkBitmap& bitmap, const SkIRect src[],
+                                 const SkIPoint dst[], int count, const SkPaint* paint) {
+    if (bitmap.drawsNothing() || count <= 0) {
+        return;
+    }
+    SkDEBUGCODE(bitmap.validate();)
+
+    SkBaseDevice* device = this->getDevice();
+    if (NULL == device || kUnknown_SkColorType == device->imageInfo().colorType() ||
+            (paint && paint->getImageFilter())) {
+        // Recording and utility canvases that predate this entry point (and
+        // the image filter path, which filters sprite by sprite) still get
+        // correct results from individual drawSprite calls.
+        const SkIRect bounds = SkIRect::MakeWH(bitmap.width(), bitmap.height());
+        for (int i = 0; i < count; i++) {
+            SkIRect subset = src[i];
+            if (!subset.intersect(bounds)) {
+                continue;
+            }
+            SkBitmap subsetBM;
+            if (bitmap.extractSubset(&subsetBM, subset)) {
+                this->drawSprite(subsetBM, dst[i].fX + subset.fLeft - src[i].fLeft,
+                                 dst[i].fY + subset.fTop - src[i].fTop, paint);
+            }
+        }
+        return;
+    }
+
+    SkPaint tmp;
+    if (NULL == paint) {
+        paint = &tmp;
+    }
+
+    LOOPER_BEGIN_DRAWDEVICE(*paint, SkDrawFilter::kBitmap_Type)
+
+    while (iter.next()) {
+        paint = &looper.paint();
+        if (0 == iter.getX() && 0 == iter.getY()) {
+            iter.fDevice->drawSprites(iter, bitmap, src, dst, count, *paint);
+        } else {
+            // Shift each placement into this device's space.
+            SkAutoSTMalloc<64, SkIPoint> adjusted(count);
+            for (int i = 0; i < count; i++) {
+                adjusted[i] = SkIPoint::Make(dst[i].fX - iter.getX(), dst[i].fY - iter.getY());
+            }
+            iter.fDevice->drawSprites(iter, bitmap, src, adjusted.get(), count, *paint);
+        }
+    }
+
+    LOOPER_END
+}
+
 /////////////////////////////////////////////////////////////////////////////
 void SkCanvas::translate(SkScalar dx, SkScalar dy) {
     SkMatrix m;
@@ -1708,6 +1868,13 @@ void SkCanvas::drawRect(const SkRect& r, const SkPaint& paint) {
     this->onDrawRect(r, paint);
 }
 
+void SkCanvas::drawRects(const SkRect rects[], int count, const SkPaint& paint) {
+    if (count <= 0) {
+        return;
+    }
+    this->onDrawRects(rects, count, paint);
+}
+
 void SkCanvas::drawOval(const SkRect& r, const SkPaint& paint) {
     this->onDrawOval(r, paint);
 }
@@ -1773,6 +1940,14 @@ void SkCanvas::drawSprite(const SkBitmap& bitmap, int left, int top, const SkPai
     this->onDrawSprite(bitmap, left, top, paint);
 }
 
+void SkCanvas::drawSpriteBatch(const SkBitmap& bitmap, const SkIRect src[], const SkIPoint dst[],
+                               int count, const SkPaint* paint) {
+    if (bitmap.empty() || count <= 0) {
+        return;
+    }
+    this->onDrawSpriteBatch(bitmap, src, dst, count, paint);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //  These are the virtual drawing methods
 //////////////////////////////////////////////////////////////////////////////
@@ -1853,6 +2028,36 @@ void SkCanvas::onDrawRect(const SkRect& r, const SkPaint& paint) {
     LOOPER_END
 }
 
+void SkCanvas::onDrawRects(const SkRect rects[], int count, const SkPaint& paint) {
+    SkASSERT(count > 0);
+
+    SkRect storage;
+    const SkRect* bounds = NULL;
+    if (paint.canComputeFastBounds()) {
+        // As in onDrawRect, sort before computing bounds so inverted rects
+        // (which draw -- they're sorted downstream) aren't wrongly rejected.
+        SkRect total = rects[0];
+        total.sort();
+        for (int i = 1; i < count; ++i) {
+            SkRect r = rects[i];
+            r.sort();
+            total.join(r);
+        }
+        bounds = &paint.computeFastBounds(total, &storage);
+        if (this->quickReject(*bounds)) {
+            return;
+        }
+    }
+
+    LOOPER_BEGIN(paint, SkDrawFilter::kRect_Type, bounds)
+
+    while (iter.next()) {
+        iter.fDevice->drawRects(iter, rects, count, looper.paint());
+    }
+
+    LOOPER_END
+}
+
 void SkCanvas::onDrawOval(const SkRect& oval, const SkPaint& paint) {
     SkRect storage;
     const SkRect* bounds = NULL;
@@ -2072,9 +2277,10 @@ void SkCanvas::internalDrawBitmapNine(const SkBitmap& bitmap,
     if (bitmap.drawsNothing()) {
         return;
     }
+
+    SkRect storage;
+    const SkRect* bounds = &dst;
     if (NULL == paint || paint->canComputeFastBounds()) {
-        SkRect storage;
-        const SkRect* bounds = &dst;
         if (paint) {
             bounds = &paint->computeFastBounds(dst, &storage);
         }
@@ -2083,57 +2289,27 @@ void SkCanvas::internalDrawBitmapNine(const SkBitmap& bitmap,
         }
     }
 
-    const int32_t w = bitmap.width();
-    const int32_t h = bitmap.height();
-
     SkIRect c = center;
     // pin center to the bounds of the bitmap
     c.fLeft = SkMax32(0, center.fLeft);
     c.fTop = SkMax32(0, center.fTop);
-    c.fRight = SkPin32(center.fRight, c.fLeft, w);
-    c.fBottom = SkPin32(center.fBottom, c.fTop, h);
-
-    const SkScalar srcX[4] = {
-        0, SkIntToScalar(c.fLeft), SkIntToScalar(c.fRight), SkIntToScalar(w)
-    };
-    const SkScalar srcY[4] = {
-        0, SkIntToScalar(c.fTop), SkIntToScalar(c.fBottom), SkIntToScalar(h)
-    };
-    SkScalar dstX[4] = {
-        dst.fLeft, dst.fLeft + SkIntToScalar(c.fLeft),
-        dst.fRight - SkIntToScalar(w - c.fRight), dst.fRight
-    };
-    SkScalar dstY[4] = {
-        dst.fTop, dst.fTop + SkIntToScalar(c.fTop),
-        dst.fBottom - SkIntToScalar(h - c.fBottom), dst.fBottom
-    };
-
-    if (dstX[1] > dstX[2]) {
-        dstX[1] = dstX[0] + (dstX[3] - dstX[0]) * c.fLeft / (w - c.width());
-        dstX[2] = dstX[1];
-    }
-
-    if (dstY[1] > dstY[2]) {
-        dstY[1] = dstY[0] + (dstY[3] - dstY[0]) * c.fTop / (h - c.height());
-        dstY[2] = dstY[1];
-    }
-
-    for (int y = 0; y < 3; y++) {
-        SkRect s, d;
-
-        s.fTop = srcY[y];
-        s.fBottom = srcY[y+1];
-        d.fTop = dstY[y];
-        d.fBottom = dstY[y+1];
-        for (int x = 0; x < 3; x++) {
-            s.fLeft = srcX[x];
-            s.fRight = srcX[x+1];
-            d.fLeft = dstX[x];
-            d.fRight = dstX[x+1];
-            this->internalDrawBitmapRect(bitmap, &s, d, paint,
-                                         kNone_DrawBitmapRectFlag);
-        }
+    c.fRight = SkPin32(center.fRight, c.fLeft, bitmap.width());
+    c.fBottom = SkPin32(center.fBottom, c.fTop, bitmap.height());
+
+    SkLazyPaint lazy;
+    if (NULL == paint) {
+        paint = lazy.init();
     }
+
+    // One looper pass for the whole nine-patch; the device decides whether
+    // to blit it in one go or decompose into per-patch draws.
+    LOOPER_BEGIN(*paint, SkDrawFilter::kBitmap_Type, bounds)
+
+    while (iter.next()) {
+        iter.fDevice->drawBitmapNine(iter, bitmap, c, dst, looper.paint());
+    }
+
+    LOOPER_END
 }
 
 void SkCanvas::onDrawBitmapNine(const SkBitmap& bitmap, const SkIRect& center, const SkRect& dst,
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkChecksum.h"
+#include "SkLazyFnPtr.h"
+
+namespace {
+
+uint32_t hash32_portable(const void* data, size_t bytes, uint32_t seed) {
+    return SkChecksum::Murmur3(data, bytes, seed);
+}
+
+SkChecksumHashProc choose_hash32() {
+    SkChecksumHashProc proc = SkChecksumHashGetPlatformProc();
+    return proc ? proc : hash32_portable;
+}
+
+}  // namespace
+
+uint32_t SkChecksum::Hash32(const void* data, size_t bytes, uint32_t seed) {
+    SK_DECLARE_STATIC_LAZY_FN_PTR(SkChecksumHashProc, proc, choose_hash32);
+    return proc.get()(data, bytes, seed);
+}
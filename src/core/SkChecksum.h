@@ -115,6 +115,20 @@ public:
         return Mix(hash);
     }
 
+    /**
+     *  Hash a blob of bytes with the fastest hash this machine supports:
+     *  the hardware CRC32-C instruction (SSE 4.2) when present, Murmur3
+     *  otherwise.  Comparable quality to Murmur3 for hash tables and cache
+     *  keys, but the two are not interchangeable and the result is not
+     *  stable across machines -- never serialize or persist it.
+     *
+     *  @param data Memory address of the data block to be processed.
+     *  @param size Size of the data block in bytes.
+     *  @param seed Initial hash seed. (optional)
+     *  @return hash result
+     */
+    static uint32_t Hash32(const void* data, size_t bytes, uint32_t seed=0);
+
     /**
      *  Compute a 32-bit checksum for a given data block
      *
@@ -195,4 +209,10 @@ inline uint32_t SkGoodHash(const SkString& k) {
     return SkChecksum::Murmur3(k.c_str(), k.size());
 }
 
+// Allows hardware-accelerated implementations of SkChecksum::Hash32 to be
+// chosen at runtime, in the same manner as the procs in SkUtils.h.  Returns
+// NULL when the CPU (or the port) has no accelerated hash.
+typedef uint32_t (*SkChecksumHashProc)(const void* data, size_t bytes, uint32_t seed);
+SkChecksumHashProc SkChecksumHashGetPlatformProc();
+
 #endif
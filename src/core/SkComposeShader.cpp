@@ -7,6 +7,7 @@
  */
 
 
+#include "Sk4px.h"
 #include "SkComposeShader.h"
 #include "SkColorFilter.h"
 #include "SkColorPriv.h"
@@ -143,9 +144,11 @@ void SkComposeShader::ComposeShaderContext::shadeSpan(int x, int y, SkPMColor re
 
     SkPMColor   tmp[TMP_COLOR_COUNT];
 
+    // (x*a + x) >> 8 == x * SkAlpha255To256(a) >> 8, so scaling by the paint
+    // alpha is approxMulDiv255 with the alpha byte -- exactly SkAlphaMulQ.
+    const Sk4px paintAlpha = Sk4px::DupAlpha(this->getPaintAlpha());
+
     if (NULL == mode) {   // implied SRC_OVER
-        // TODO: when we have a good test-case, should use SkBlitRow::Proc32
-        // for these loops
         do {
             int n = count;
             if (n > TMP_COLOR_COUNT) {
@@ -155,15 +158,20 @@ void SkComposeShader::ComposeShaderContext::shadeSpan(int x, int y, SkPMColor re
             shaderContextA->shadeSpan(x, y, result, n);
             shaderContextB->shadeSpan(x, y, tmp, n);
 
+            // Blend B over A (and fold in the paint alpha) four pixels at a
+            // time while the spans are still warm, rather than a scalar
+            // pixel-by-pixel third pass.
             if (256 == scale) {
-                for (int i = 0; i < n; i++) {
-                    result[i] = SkPMSrcOver(tmp[i], result[i]);
-                }
+                Sk4px::MapDstSrc(n, result, tmp,
+                                 [](const Sk4px& dst4, const Sk4px& src4) {
+                    return src4 + dst4.approxMulDiv255(src4.alphas().inv());
+                });
             } else {
-                for (int i = 0; i < n; i++) {
-                    result[i] = SkAlphaMulQ(SkPMSrcOver(tmp[i], result[i]),
-                                            scale);
-                }
+                Sk4px::MapDstSrc(n, result, tmp,
+                                 [&](const Sk4px& dst4, const Sk4px& src4) {
+                    return (src4 + dst4.approxMulDiv255(src4.alphas().inv()))
+                            .approxMulDiv255(paintAlpha);
+                });
             }
 
             result += n;
@@ -182,9 +190,9 @@ void SkComposeShader::ComposeShaderContext::shadeSpan(int x, int y, SkPMColor re
             mode->xfer32(result, tmp, n, NULL);
 
             if (256 != scale) {
-                for (int i = 0; i < n; i++) {
-                    result[i] = SkAlphaMulQ(result[i], scale);
-                }
+                Sk4px::MapSrc(n, result, result, [&](const Sk4px& p) {
+                    return p.approxMulDiv255(paintAlpha);
+                });
             }
 
             result += n;
@@ -11,6 +11,7 @@
 #include "SkColorPriv.h"
 #include "SkDither.h"
 #include "SkMathPriv.h"
+#include "SkPMFloat.h"
 #include "SkUnPreMultiply.h"
 
 enum AlphaVerb {
@@ -49,6 +50,109 @@ void convert32_row(uint32_t* dst, const uint32_t* src, int count) {
     }
 }
 
+/*
+ *  Row procs for the premul and unpremul verbs.
+ *
+ *  The per-pixel table lookups in SkPreMultiplyARGB and SkUnPreMultiply
+ *  dominate bulk readbacks, so these procs pass the common fully-opaque and
+ *  fully-transparent pixels through without any math and push everything else
+ *  through Sk4f. The unpremul proc builds 255/a from approxInvert() plus one
+ *  Newton-Raphson step; the worst-case error of the scaled components is well
+ *  under kRoundSlop, so any pixel that lands within kRoundSlop of a rounding
+ *  boundary falls back to the exact per-pixel routine. That keeps the results
+ *  bit-identical to converting one pixel at a time.
+ */
+
+static const float kRoundSlop = 1.0f / 32;
+
+static bool needs_exact_proc(const float fs[4]) {
+    for (int i = 0; i < 4; ++i) {
+        if (SK_A32_SHIFT / 8 == i) {
+            continue;   // alpha passes through exactly
+        }
+        // Components >= 256 only come from invalid premul input (component
+        // bigger than alpha); hand those to the exact proc so the garbage we
+        // produce is at least the same garbage the per-pixel path produces.
+        if (fs[i] >= 256.0f) {
+            return true;
+        }
+        float frac = fs[i] - (float)(int)fs[i];
+        if (frac < kRoundSlop || frac > 1 - kRoundSlop) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t pack_from_floats(const float fs[4]) {
+    // fs[] holds 0.5-biased component values in SkPMColor byte order, so
+    // truncation rounds each lane to the nearest integer.
+    return ((uint32_t)fs[0] <<  0) |
+           ((uint32_t)fs[1] <<  8) |
+           ((uint32_t)fs[2] << 16) |
+           ((uint32_t)fs[3] << 24);
+}
+
+template <bool doSwapRB>
+static void premul_row(uint32_t* dst, const uint32_t* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        uint32_t c = src[i];
+        if (doSwapRB) {
+            c = SkSwizzle_RB(c);
+        }
+        unsigned a = SkGetPackedA32(c);
+        if (255 == a || 0 == a) {
+            dst[i] = 255 == a ? c : 0;
+            continue;
+        }
+        float scale = a * (1.0f / 255);
+        Sk4f fs = SkPMFloat::FromARGB(a, SkGetPackedR32(c), SkGetPackedG32(c),
+                                      SkGetPackedB32(c))
+                * SkPMFloat::FromARGB(1, scale, scale, scale)
+                + Sk4f(0.5f);
+        float comps[4];
+        fs.store(comps);
+        if (needs_exact_proc(comps)) {
+            dst[i] = SkPreMultiplyARGB(a, SkGetPackedR32(c), SkGetPackedG32(c),
+                                       SkGetPackedB32(c));
+        } else {
+            dst[i] = pack_from_floats(comps);
+        }
+    }
+}
+
+template <bool doSwapRB>
+static void unpremul_row(uint32_t* dst, const uint32_t* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        uint32_t c = src[i];
+        if (doSwapRB) {
+            c = SkSwizzle_RB(c);
+        }
+        unsigned a = SkGetPackedA32(c);
+        if (255 == a || 0 == a) {
+            dst[i] = 255 == a ? c : 0;
+            continue;
+        }
+        Sk4f va((float)a);
+        Sk4f estimate = va.approxInvert();
+        estimate = estimate * (Sk4f(2) - va * estimate);  // one Newton-Raphson step
+        float scale = 255 * estimate.kth<0>();
+        // Not SkPMFloat(c): readbacks may hand us slightly invalid premul
+        // pixels, and we want those to take the same path as everything else.
+        Sk4f fs = SkPMFloat::FromARGB(a, SkGetPackedR32(c), SkGetPackedG32(c),
+                                      SkGetPackedB32(c))
+                * SkPMFloat::FromARGB(1, scale, scale, scale)
+                + Sk4f(0.5f);
+        float comps[4];
+        fs.store(comps);
+        if (needs_exact_proc(comps)) {
+            dst[i] = SkUnPreMultiply::UnPreMultiplyPreservingByteOrder(c);
+        } else {
+            dst[i] = pack_from_floats(comps);
+        }
+    }
+}
+
 static bool is_32bit_colortype(SkColorType ct) {
     return kRGBA_8888_SkColorType == ct || kBGRA_8888_SkColorType == ct;
 }
@@ -100,16 +204,16 @@ bool SkSrcPixelInfo::convertPixelsTo(SkDstPixelInfo* dst, int width, int height)
             break;
         case kPremul_AlphaVerb:
             if (doSwapRB) {
-                proc = convert32_row<true, kPremul_AlphaVerb>;
+                proc = premul_row<true>;
             } else {
-                proc = convert32_row<false, kPremul_AlphaVerb>;
+                proc = premul_row<false>;
             }
             break;
         case kUnpremul_AlphaVerb:
             if (doSwapRB) {
-                proc = convert32_row<true, kUnpremul_AlphaVerb>;
+                proc = unpremul_row<true>;
             } else {
-                proc = convert32_row<false, kUnpremul_AlphaVerb>;
+                proc = unpremul_row<false>;
             }
             break;
     }
@@ -358,26 +358,30 @@ const SkConvolutionFilter1D::ConvolutionFixed* SkConvolutionFilter1D::GetSingleF
     return &fFilterValues[filter.fDataLocation];
 }
 
-void BGRAConvolve2D(const unsigned char* sourceData,
-                    int sourceByteRowStride,
-                    bool sourceHasAlpha,
-                    const SkConvolutionFilter1D& filterX,
-                    const SkConvolutionFilter1D& filterY,
-                    int outputByteRowStride,
-                    unsigned char* output,
-                    const SkConvolutionProcs& convolveProcs,
-                    bool useSimdIfPossible) {
+void BGRAConvolve2DBand(const unsigned char* sourceData,
+                        int sourceByteRowStride,
+                        bool sourceHasAlpha,
+                        const SkConvolutionFilter1D& filterX,
+                        const SkConvolutionFilter1D& filterY,
+                        int outputByteRowStride,
+                        unsigned char* output,
+                        const SkConvolutionProcs& convolveProcs,
+                        bool useSimdIfPossible,
+                        int outYStart, int outYEnd) {
+    SkASSERT(0 <= outYStart && outYStart < outYEnd &&
+             outYEnd <= filterY.numValues());
 
     int maxYFilterSize = filterY.maxFilter();
 
     // The next row in the input that we will generate a horizontally
     // convolved row for. If the filter doesn't start at the beginning of the
-    // image (this is the case when we are only resizing a subset), then we
-    // don't want to generate any output rows before that. Compute the starting
-    // row for convolution as the first pixel for the first vertical filter.
+    // image (this is the case when we are only resizing a subset, or when we
+    // are producing a band other than the topmost one), then we don't want to
+    // generate any output rows before that. Compute the starting row for
+    // convolution as the first pixel for the first vertical filter.
     int filterOffset, filterLength;
     const SkConvolutionFilter1D::ConvolutionFixed* filterValues =
-        filterY.FilterForValue(0, &filterOffset, &filterLength);
+        filterY.FilterForValue(outYStart, &filterOffset, &filterLength);
     int nextXRow = filterOffset;
 
     // We loop over each row in the input doing a horizontal convolution. This
@@ -421,7 +425,7 @@ void BGRAConvolve2D(const unsigned char* sourceData,
     filterY.FilterForValue(numOutputRows - 1, &lastFilterOffset,
                            &lastFilterLength);
 
-    for (int outY = 0; outY < numOutputRows; outY++) {
+    for (int outY = outYStart; outY < outYEnd; outY++) {
         filterValues = filterY.FilterForValue(outY,
                                               &filterOffset, &filterLength);
 
@@ -487,3 +491,18 @@ void BGRAConvolve2D(const unsigned char* sourceData,
         }
     }
 }
+
+void BGRAConvolve2D(const unsigned char* sourceData,
+                    int sourceByteRowStride,
+                    bool sourceHasAlpha,
+                    const SkConvolutionFilter1D& filterX,
+                    const SkConvolutionFilter1D& filterY,
+                    int outputByteRowStride,
+                    unsigned char* output,
+                    const SkConvolutionProcs& convolveProcs,
+                    bool useSimdIfPossible) {
+    BGRAConvolve2DBand(sourceData, sourceByteRowStride, sourceHasAlpha,
+                       filterX, filterY, outputByteRowStride, output,
+                       convolveProcs, useSimdIfPossible,
+                       0, filterY.numValues());
+}
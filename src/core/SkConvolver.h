@@ -202,4 +202,22 @@ SK_API void BGRAConvolve2D(const unsigned char* sourceData,
     const SkConvolutionProcs&,
     bool useSimdIfPossible);
 
+// Like BGRAConvolve2D, but only produces the output rows in
+// [outYStart, outYEnd); the rest of the output buffer is left untouched.
+//
+// Each call horizontally convolves every source row its vertical filter
+// windows cover, so calls for adjacent bands redo the rows the bands share.
+// In exchange the calls are entirely independent: disjoint bands may be
+// convolved concurrently into the same output buffer.
+SK_API void BGRAConvolve2DBand(const unsigned char* sourceData,
+    int sourceByteRowStride,
+    bool sourceHasAlpha,
+    const SkConvolutionFilter1D& xfilter,
+    const SkConvolutionFilter1D& yfilter,
+    int outputByteRowStride,
+    unsigned char* output,
+    const SkConvolutionProcs&,
+    bool useSimdIfPossible,
+    int outYStart, int outYEnd);
+
 #endif  // SK_CONVOLVER_H
@@ -193,6 +193,45 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+class SkRGBA_F16_Blitter : public SkRasterBlitter {
+public:
+    SkRGBA_F16_Blitter(const SkBitmap& device, const SkPaint& paint);
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override;
+    void blitRect(int x, int y, int width, int height) override;
+    const SkBitmap* justAnOpaqueColor(uint32_t*) override;
+
+private:
+    float    fSrc[4];    // premultiplied source color, [0,1], R,G,B,A order
+    uint64_t fSrcPixel;  // fSrc packed as four halfs
+    bool     fSrcIsOpaque;
+
+    // illegal
+    SkRGBA_F16_Blitter& operator=(const SkRGBA_F16_Blitter&);
+
+    typedef SkRasterBlitter INHERITED;
+};
+
+class SkRGBA_F16_Shader_Blitter : public SkShaderBlitter {
+public:
+    SkRGBA_F16_Shader_Blitter(const SkBitmap& device, const SkPaint& paint,
+                              SkShader::Context* shaderContext);
+    virtual ~SkRGBA_F16_Shader_Blitter();
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override;
+
+private:
+    SkPMColor*  fBuffer;  // device.width() colors from the shader
+    float*      fFloats;  // device.width() * 4 floats of scratch
+
+    // illegal
+    SkRGBA_F16_Shader_Blitter& operator=(const SkRGBA_F16_Shader_Blitter&);
+
+    typedef SkShaderBlitter INHERITED;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 /*  These return the correct subclass of blitter for their device config.
 
     Currently, they make the following assumptions about the state of the
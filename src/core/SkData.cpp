@@ -111,36 +111,86 @@ static void sk_mmap_releaseproc(const void* addr, size_t length, void*) {
     sk_fmunmap(addr, length);
 }
 
-SkData* SkData::NewFromFILE(SkFILE* f) {
+static void apply_access_pattern(const void* addr, size_t length, SkData::AccessPattern pattern) {
+    switch (pattern) {
+        case SkData::kSequential_AccessPattern:
+            sk_fmadvise(addr, length, kSequential_SkFILE_MemoryAdvice);
+            break;
+        case SkData::kRandom_AccessPattern:
+            sk_fmadvise(addr, length, kRandom_SkFILE_MemoryAdvice);
+            break;
+        case SkData::kNormal_AccessPattern:
+            break;
+    }
+}
+
+SkData* SkData::NewFromFILE(SkFILE* f, AccessPattern pattern) {
     size_t size;
     void* addr = sk_fmmap(f, &size);
     if (NULL == addr) {
         return NULL;
     }
 
+    apply_access_pattern(addr, size, pattern);
     return SkData::NewWithProc(addr, size, sk_mmap_releaseproc, NULL);
 }
 
-SkData* SkData::NewFromFileName(const char path[]) {
+SkData* SkData::NewFromFileName(const char path[], AccessPattern pattern) {
     SkFILE* f = path ? sk_fopen(path, kRead_SkFILE_Flag) : NULL;
     if (NULL == f) {
         return NULL;
     }
-    SkData* data = NewFromFILE(f);
+    SkData* data = NewFromFILE(f, pattern);
     sk_fclose(f);
     return data;
 }
 
-SkData* SkData::NewFromFD(int fd) {
+SkData* SkData::NewFromFD(int fd, AccessPattern pattern) {
     size_t size;
     void* addr = sk_fdmmap(fd, &size);
     if (NULL == addr) {
         return NULL;
     }
 
+    apply_access_pattern(addr, size, pattern);
     return SkData::NewWithProc(addr, size, sk_mmap_releaseproc, NULL);
 }
 
+void SkData::prefetch(size_t offset, size_t length) const {
+    // Only mmap-backed datarefs know how to talk to the kernel about paging.
+    if (sk_mmap_releaseproc != fReleaseProc) {
+        return;
+    }
+
+    size_t available = fSize;
+    if (offset >= available || 0 == length) {
+        return;
+    }
+    available -= offset;
+    if (length > available) {
+        length = available;
+    }
+
+    sk_fmadvise(this->bytes() + offset, length, kWillNeed_SkFILE_MemoryAdvice);
+}
+
+void SkData::purge(size_t offset, size_t length) const {
+    if (sk_mmap_releaseproc != fReleaseProc) {
+        return;
+    }
+
+    size_t available = fSize;
+    if (offset >= available || 0 == length) {
+        return;
+    }
+    available -= offset;
+    if (length > available) {
+        length = available;
+    }
+
+    sk_fmadvise(this->bytes() + offset, length, kDontNeed_SkFILE_MemoryAdvice);
+}
+
 // assumes context is a SkData
 static void sk_dataref_releaseproc(const void*, size_t, void* context) {
     SkData* src = reinterpret_cast<SkData*>(context);
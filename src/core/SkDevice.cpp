@@ -107,6 +107,13 @@ void SkBaseDevice::drawDRRect(const SkDraw& draw, const SkRRect& outer,
     this->drawPath(draw, path, paint, preMatrix, pathIsMutable);
 }
 
+void SkBaseDevice::drawRects(const SkDraw& draw, const SkRect rects[], int count,
+                             const SkPaint& paint) {
+    for (int i = 0; i < count; ++i) {
+        this->drawRect(draw, rects[i], paint);
+    }
+}
+
 void SkBaseDevice::drawPatch(const SkDraw& draw, const SkPoint cubics[12], const SkColor colors[4],
                              const SkPoint texCoords[4], SkXfermode* xmode, const SkPaint& paint) {
     SkPatchUtils::VertexData data;
@@ -166,6 +173,76 @@ void SkBaseDevice::drawTextBlob(const SkDraw& draw, const SkTextBlob* blob, SkSc
     }
 }
 
+void SkBaseDevice::drawBitmapNine(const SkDraw& draw, const SkBitmap& bitmap,
+                                  const SkIRect& center, const SkRect& dst,
+                                  const SkPaint& paint) {
+    // Default impl : decompose into nine drawBitmapRect calls
+    const int32_t w = bitmap.width();
+    const int32_t h = bitmap.height();
+    SkASSERT(SkIRect::MakeWH(w, h).contains(center));
+
+    const SkScalar srcX[4] = {
+        0, SkIntToScalar(center.fLeft), SkIntToScalar(center.fRight), SkIntToScalar(w)
+    };
+    const SkScalar srcY[4] = {
+        0, SkIntToScalar(center.fTop), SkIntToScalar(center.fBottom), SkIntToScalar(h)
+    };
+    SkScalar dstX[4] = {
+        dst.fLeft, dst.fLeft + SkIntToScalar(center.fLeft),
+        dst.fRight - SkIntToScalar(w - center.fRight), dst.fRight
+    };
+    SkScalar dstY[4] = {
+        dst.fTop, dst.fTop + SkIntToScalar(center.fTop),
+        dst.fBottom - SkIntToScalar(h - center.fBottom), dst.fBottom
+    };
+
+    if (dstX[1] > dstX[2]) {
+        dstX[1] = dstX[0] + (dstX[3] - dstX[0]) * center.fLeft / (w - center.width());
+        dstX[2] = dstX[1];
+    }
+    if (dstY[1] > dstY[2]) {
+        dstY[1] = dstY[0] + (dstY[3] - dstY[0]) * center.fTop / (h - center.height());
+        dstY[2] = dstY[1];
+    }
+
+    for (int y = 0; y < 3; y++) {
+        SkRect s, d;
+
+        s.fTop = srcY[y];
+        s.fBottom = srcY[y+1];
+        d.fTop = dstY[y];
+        d.fBottom = dstY[y+1];
+        for (int x = 0; x < 3; x++) {
+            s.fLeft = srcX[x];
+            s.fRight = srcX[x+1];
+            d.fLeft = dstX[x];
+            d.fRight = dstX[x+1];
+            this->drawBitmapRect(draw, bitmap, &s, d, paint,
+                                 SkCanvas::kNone_DrawBitmapRectFlag);
+        }
+    }
+}
+
+void SkBaseDevice::drawSprites(const SkDraw& draw, const SkBitmap& bitmap,
+                               const SkIRect src[], const SkIPoint dst[],
+                               int count, const SkPaint& paint) {
+    // Default impl : decompose into one drawSprite call per placement
+    const SkIRect bounds = SkIRect::MakeWH(bitmap.width(), bitmap.height());
+    for (int i = 0; i < count; i++) {
+        SkIRect subset = src[i];
+        if (!subset.intersect(bounds)) {
+            continue;
+        }
+        SkBitmap subsetBM;
+        if (bitmap.extractSubset(&subsetBM, subset)) {
+            // If the subset was clipped to the bitmap, shift the dst to match.
+            this->drawSprite(draw, subsetBM,
+                             dst[i].fX + subset.fLeft - src[i].fLeft,
+                             dst[i].fY + subset.fTop - src[i].fTop, paint);
+        }
+    }
+}
+
 void SkBaseDevice::drawImage(const SkDraw& draw, const SkImage* image, SkScalar x, SkScalar y,
                              const SkPaint& paint) {
     // Default impl : turns everything into raster bitmap
@@ -27,15 +27,21 @@ SkDeviceLooper::SkDeviceLooper(const SkBitmap& base,
 
     if (rc.isEmpty() || !fClippedBounds.intersect(bounds, rc.getBounds())) {
         fState = kDone_State;
+        fTileCount = 0;
     } else if (this->fitsInDelta(fClippedBounds)) {
         fState = kSimple_State;
+        fTileCount = 1;
     } else {
         // back up by 1 DX, so that next() will put us in a correct starting
         // position.
         fCurrOffset.set(fClippedBounds.left() - fDelta,
                         fClippedBounds.top());
         fState = kComplex_State;
+        const int cols = (fClippedBounds.width() + fDelta - 1) / fDelta;
+        const int rows = (fClippedBounds.height() + fDelta - 1) / fDelta;
+        fTileCount = cols * rows;
     }
+    fInitialState = fState;
 }
 
 SkDeviceLooper::~SkDeviceLooper() {
@@ -98,6 +104,32 @@ static bool next_tile(const SkIRect& boundary, int delta, SkIPoint* offset) {
     return false;
 }
 
+bool SkDeviceLooper::resetToTile(int index) {
+    SkASSERT(index >= 0 && index < fTileCount);
+
+    // un-finish us if a previous iteration ran to completion
+    fState = fInitialState;
+
+    switch (fState) {
+        case kDone_State:
+            return false;
+
+        case kSimple_State:
+            fCurrBitmap = &fBaseBitmap;
+            fCurrRC = &fBaseRC;
+            fCurrOffset.set(0, 0);
+            return true;
+
+        case kComplex_State: {
+            const int cols = (fClippedBounds.width() + fDelta - 1) / fDelta;
+            fCurrOffset.set(fClippedBounds.left() + (index % cols) * fDelta,
+                            fClippedBounds.top() + (index / cols) * fDelta);
+            return this->computeCurrBitmapAndClip();
+        }
+    }
+    return false;
+}
+
 bool SkDeviceLooper::next() {
     switch (fState) {
         case kDone_State:
@@ -60,6 +60,27 @@ public:
      */
     bool next();
 
+    /**
+     *  Returns how many tiles this looper will visit: 0 if there is nothing to
+     *  draw, 1 if the bounds fit in the safe zone, and the full grid count
+     *  otherwise. Valid before and after iteration.
+     */
+    int countTiles() const { return fTileCount; }
+
+    /**
+     *  Position the looper on the given tile (0 <= index < countTiles()),
+     *  independent of any prior next() or resetToTile() calls. Returns true if
+     *  the tile's clip is non-empty, after which mapRect() and mapMatrix() are
+     *  valid; returns false if the tile can be skipped entirely.
+     *
+     *  Tiles are independent of each other, so a draw can be distributed over
+     *  workers (e.g. an SkTaskGroup): give each worker its own looper over the
+     *  same base/clip/bounds and hand out tile indices among them. A single
+     *  looper must not be shared between threads, as it owns the subset bitmap
+     *  and clip storage its getters return.
+     */
+    bool resetToTile(int index);
+
 private:
     const SkBitmap&     fBaseBitmap;
     const SkRasterClip& fBaseRC;
@@ -80,6 +101,8 @@ private:
     SkIPoint            fCurrOffset;
     int                 fDelta;
     State               fState;
+    State               fInitialState;  // remembered for resetToTile()
+    int                 fTileCount;
 
     enum Delta {
         kBW_Delta = 1 << 14,        // 16K, gives room to spare for fixedpoint
@@ -18,23 +18,31 @@ struct SkDeviceProperties {
     SkDeviceProperties(InitType, float gamma = SK_GAMMA_EXPONENT)
         : fGamma(gamma)
         , fPixelGeometry(SkSurfacePropsDefaultPixelGeometry())
+        , fAllowThreadedRaster(false)
     {}
 
     SkDeviceProperties(SkPixelGeometry geo, float gamma = SK_GAMMA_EXPONENT)
         : fGamma(gamma)
         , fPixelGeometry(geo)
+        , fAllowThreadedRaster(false)
     {}
 
     SkPixelGeometry pixelGeometry() const { return fPixelGeometry; }
     float gamma() const { return fGamma; }
+    bool allowThreadedRaster() const { return fAllowThreadedRaster; }
 
     void setPixelGeometry(SkPixelGeometry geo) {
         fPixelGeometry = geo;
     }
 
+    void setAllowThreadedRaster(bool allow) {
+        fAllowThreadedRaster = allow;
+    }
+
 private:
     const float   fGamma;
     SkPixelGeometry fPixelGeometry;
+    bool          fAllowThreadedRaster;
 };
 
 #endif
@@ -6,6 +6,7 @@
  */
 
 #include "SkDistanceFieldGen.h"
+#include "SkNx.h"
 #include "SkPoint.h"
 
 struct DFData {
@@ -193,47 +194,34 @@ static void init_distances(DFData* data, unsigned char* edges, int width, int he
 
 // first stage forward pass
 // (forward in Y, forward in X)
+// The four neighbor candidates (upper left, up, upper right, left) are computed
+// together through Sk4f; the compare-and-replace scan stays scalar and in the
+// original order so the result matches the sequential version exactly.
 static void F1(DFData* curr, int width) {
-    // upper left
-    DFData* check = curr - width-1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*(distVec.fX + distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // up
-    check = curr - width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // upper right
-    check = curr - width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX - distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // left
-    check = curr - 1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+    const DFData* up = curr - width-1;  // upper left, up, upper right
+    const DFData* left = curr - 1;
+
+    Sk4f neighborDistSq(up[0].fDistSq, up[1].fDistSq, up[2].fDistSq, left->fDistSq);
+    Sk4f vecX(up[0].fDistVector.fX, up[1].fDistVector.fX, up[2].fDistVector.fX,
+              left->fDistVector.fX);
+    Sk4f vecY(up[0].fDistVector.fY, up[1].fDistVector.fY, up[2].fDistVector.fY,
+              left->fDistVector.fY);
+    // each candidate's distSq expands to neighbor distSq + a*vX + b*vY + c
+    Sk4f candidate = neighborDistSq + Sk4f(-2.0f, 0.0f, 2.0f, -2.0f)*vecX
+                                    + Sk4f(-2.0f, -2.0f, -2.0f, 0.0f)*vecY
+                                    + Sk4f(2.0f, 1.0f, 2.0f, 1.0f);
+
+    float distSq[4];
+    candidate.store(distSq);
+    static const float gAdjX[4] = { -1.0f, 0.0f, 1.0f, -1.0f };
+    static const float gAdjY[4] = { -1.0f, -1.0f, -1.0f, 0.0f };
+    const DFData* check[4] = { up, up+1, up+2, left };
+    for (int k = 0; k < 4; ++k) {
+        if (distSq[k] < curr->fDistSq) {
+            curr->fDistSq = distSq[k];
+            curr->fDistVector.fX = check[k]->fDistVector.fX + gAdjX[k];
+            curr->fDistVector.fY = check[k]->fDistVector.fY + gAdjY[k];
+        }
     }
 }
 
@@ -268,47 +256,31 @@ static void B1(DFData* curr, int width) {
 
 // second stage backward pass
 // (backward in Y, backwards in X)
+// Vectorized the same way as F1, over (right, bottom left, bottom, bottom right).
 static void B2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom left
-    check = curr + width-1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*(distVec.fX - distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom
-    check = curr + width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
-
-    // bottom right
-    check = curr + width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX + distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+    const DFData* right = curr + 1;
+    const DFData* down = curr + width-1;  // bottom left, bottom, bottom right
+
+    Sk4f neighborDistSq(right->fDistSq, down[0].fDistSq, down[1].fDistSq, down[2].fDistSq);
+    Sk4f vecX(right->fDistVector.fX, down[0].fDistVector.fX, down[1].fDistVector.fX,
+              down[2].fDistVector.fX);
+    Sk4f vecY(right->fDistVector.fY, down[0].fDistVector.fY, down[1].fDistVector.fY,
+              down[2].fDistVector.fY);
+    Sk4f candidate = neighborDistSq + Sk4f(2.0f, -2.0f, 0.0f, 2.0f)*vecX
+                                    + Sk4f(0.0f, 2.0f, 2.0f, 2.0f)*vecY
+                                    + Sk4f(1.0f, 2.0f, 1.0f, 2.0f);
+
+    float distSq[4];
+    candidate.store(distSq);
+    static const float gAdjX[4] = { 1.0f, -1.0f, 0.0f, 1.0f };
+    static const float gAdjY[4] = { 0.0f, 1.0f, 1.0f, 1.0f };
+    const DFData* check[4] = { right, down, down+1, down+2 };
+    for (int k = 0; k < 4; ++k) {
+        if (distSq[k] < curr->fDistSq) {
+            curr->fDistSq = distSq[k];
+            curr->fDistVector.fX = check[k]->fDistVector.fX + gAdjX[k];
+            curr->fDistVector.fY = check[k]->fDistVector.fY + gAdjY[k];
+        }
     }
 }
 
@@ -428,8 +400,8 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     currEdge = edgePtr + dataWidth+1;
     unsigned char *dfPtr = distanceField;
     for (int j = 1; j < dataHeight-1; ++j) {
-        for (int i = 1; i < dataWidth-1; ++i) {
 #if DUMP_EDGE
+        for (int i = 1; i < dataWidth-1; ++i) {
             float alpha = currData->fAlpha;
             float edge = 0.0f;
             if (*currEdge) {
@@ -439,7 +411,34 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
             float result = alpha + (1.0f-alpha)*edge;
             unsigned char val = sk_float_round2int(255*result);
             *dfPtr++ = val;
+            ++currData;
+            ++currEdge;
+        }
 #else
+        const Sk4f magnitude((float)SK_DistanceFieldMagnitude);
+        int i = 1;
+        // Handle four texels at a time so the square roots go through Sk4f. Clamping the
+        // packed value to [0,255] is equivalent to the two range checks in
+        // pack_distance_field_val.
+        for (; i < dataWidth-1-3; i += 4) {
+            float distSq[4];
+            float signMul[4];
+            for (int k = 0; k < 4; ++k) {
+                distSq[k] = currData[k].fDistSq;
+                signMul[k] = currData[k].fAlpha > 0.5f ? -1.0f : 1.0f;
+            }
+            Sk4f dist = Sk4f::Load(distSq).sqrt() * Sk4f::Load(signMul);
+            Sk4f packed = (magnitude - dist) * Sk4f(128.0f) / magnitude;
+            packed = Sk4f::Max(Sk4f(0.0f), Sk4f::Min(Sk4f(255.0f), packed));
+            float out[4];
+            packed.store(out);
+            for (int k = 0; k < 4; ++k) {
+                dfPtr[k] = (unsigned char)out[k];
+            }
+            currData += 4;
+            dfPtr += 4;
+        }
+        for (; i < dataWidth-1; ++i) {
             float dist;
             if (currData->fAlpha > 0.5f) {
                 dist = -SkScalarSqrt(currData->fDistSq);
@@ -447,10 +446,10 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
                 dist = SkScalarSqrt(currData->fDistSq);
             }
             *dfPtr++ = pack_distance_field_val(dist, (float)SK_DistanceFieldMagnitude);
-#endif
             ++currData;
-            ++currEdge;
         }
+        currEdge += dataWidth-2;
+#endif
         currData += 2;
         currEdge += 2;
     }
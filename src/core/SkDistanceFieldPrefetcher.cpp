@@ -0,0 +1,137 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDistanceFieldGen.h"
+#include "SkDistanceFieldPrefetcher.h"
+#include "SkLazyPtr.h"
+#include "SkRefCnt.h"
+#include "SkTDArray.h"
+#include "SkTaskGroup.h"
+#include "SkThread.h"
+
+namespace {
+
+struct FieldRequest : public SkRefCnt {
+    uint64_t     fKey;
+    int          fWidth;
+    int          fHeight;
+    bool         fDone;
+    SkAutoMalloc fImage;          // tightly packed A8 copy of the source mask
+    SkAutoMalloc fDistanceField;  // valid once fDone is set (under the mutex)
+};
+
+}  // namespace
+
+SK_DECLARE_STATIC_MUTEX(gFieldRequestMutex);
+
+// All live requests, so keys can be looked up.  Pending requests additionally
+// sit in gPending until a worker claims them.  Both arrays own a ref on each
+// entry.
+static SkTDArray<FieldRequest*> gLiveFields;
+static SkTDArray<FieldRequest*> gPendingFields;
+
+static SkTaskGroup* create_task_group() { return SkNEW(SkTaskGroup); }
+SK_DECLARE_STATIC_LAZY_PTR(SkTaskGroup, gFieldTaskGroup, create_task_group);
+
+static int find_by_key(const SkTDArray<FieldRequest*>& array, uint64_t key) {
+    for (int i = 0; i < array.count(); i++) {
+        if (array[i]->fKey == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Each Prefetch() posts one of these; it claims the oldest request still
+// pending, which is not necessarily the one that posted it.
+static void run_one_generate(int*) {
+    SkAutoTUnref<FieldRequest> request;
+    {
+        SkAutoMutexAcquire lock(gFieldRequestMutex);
+        if (0 == gPendingFields.count()) {
+            return;  // Everything pending was taken or purged.
+        }
+        request.reset(gPendingFields[0]);  // Adopt the pending list's ref.
+        gPendingFields.remove(0);
+    }
+
+    // Until fDone is set the buffers are the worker's alone; Take() only
+    // looks at fDone, which is published under the mutex below.
+    size_t fieldSize = SkComputeDistanceFieldSize(request->fWidth, request->fHeight);
+    SkGenerateDistanceFieldFromA8Image((unsigned char*)request->fDistanceField.reset(fieldSize),
+                                       (const unsigned char*)request->fImage.get(),
+                                       request->fWidth, request->fHeight,
+                                       request->fWidth);
+
+    SkAutoMutexAcquire lock(gFieldRequestMutex);
+    // If Take() or PurgeAll() already forgot the request this just drops the
+    // result with the worker's ref.
+    request->fDone = true;
+}
+
+void SkDistanceFieldPrefetcher::Prefetch(uint64_t key, const unsigned char* image,
+                                         int width, int height, size_t rowBytes) {
+    SkASSERT(image);
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    FieldRequest* request = SkNEW(FieldRequest);
+    request->fKey = key;
+    request->fWidth = width;
+    request->fHeight = height;
+    request->fDone = false;
+    // Copy the mask tightly packed; the caller's pixels are typically glyph
+    // cache memory that cannot be touched off the owning thread.
+    uint8_t* copy = (uint8_t*)request->fImage.reset(width * height);
+    for (int y = 0; y < height; ++y) {
+        memcpy(copy + y * width, image + y * rowBytes, width);
+    }
+
+    {
+        SkAutoMutexAcquire lock(gFieldRequestMutex);
+        if (find_by_key(gLiveFields, key) >= 0) {
+            request->unref();  // Already queued or done; keep the first one.
+            return;
+        }
+        *gLiveFields.append() = request;         // Holds the initial ref.
+        *gPendingFields.append() = SkRef(request);
+    }
+    gFieldTaskGroup.get()->add(run_one_generate, (int*)NULL);
+}
+
+bool SkDistanceFieldPrefetcher::Take(uint64_t key, unsigned char* distanceField) {
+    SkASSERT(distanceField);
+    SkAutoMutexAcquire lock(gFieldRequestMutex);
+    int live = find_by_key(gLiveFields, key);
+    if (live < 0) {
+        return false;
+    }
+    SkAutoTUnref<FieldRequest> request(gLiveFields[live]);  // Adopt the live list's ref.
+    gLiveFields.remove(live);
+    int pending = find_by_key(gPendingFields, key);
+    if (pending >= 0) {
+        gPendingFields[pending]->unref();
+        gPendingFields.remove(pending);
+    }
+    if (!request->fDone) {
+        // Still pending or mid-generation on a worker; the caller generates
+        // the field itself rather than waiting.
+        return false;
+    }
+    memcpy(distanceField, request->fDistanceField.get(),
+           SkComputeDistanceFieldSize(request->fWidth, request->fHeight));
+    return true;
+}
+
+void SkDistanceFieldPrefetcher::PurgeAll() {
+    SkAutoMutexAcquire lock(gFieldRequestMutex);
+    gPendingFields.unrefAll();
+    gPendingFields.reset();
+    gLiveFields.unrefAll();
+    gLiveFields.reset();
+}
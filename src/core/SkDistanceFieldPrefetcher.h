@@ -0,0 +1,53 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDistanceFieldPrefetcher_DEFINED
+#define SkDistanceFieldPrefetcher_DEFINED
+
+#include "SkTypes.h"
+
+/**
+ *  A background generation service for glyph distance fields.
+ *
+ *  SkGenerateDistanceFieldFromA8Image runs a Euclidean distance transform per
+ *  texel, so producing a distance field on first use stalls the draw that
+ *  needs it.  Clients that know which glyphs are coming (e.g. from layout
+ *  lookahead) hand the A8 mask to Prefetch(); the transform runs on an
+ *  SkTaskGroup worker and the draw path picks the finished field up with
+ *  Take() instead of generating it inline.
+ *
+ *  Keys are chosen by the caller and must be unique per glyph image; a
+ *  (strike hash, packed glyph id) pair works well.  The mask is copied during
+ *  Prefetch(), so the caller's image (typically glyph cache memory) does not
+ *  need to outlive the call.
+ *
+ *  Workers run on the SkTaskGroup thread pool, so generation happens
+ *  synchronously inside Prefetch() unless an SkTaskGroup::Enabler exists.
+ */
+class SkDistanceFieldPrefetcher : SkNoncopyable {
+public:
+    /**
+     *  Queue background generation of the distance field for this A8 mask.
+     *  Does nothing if a request with this key is already queued or done.
+     */
+    static void Prefetch(uint64_t key, const unsigned char* image,
+                         int width, int height, size_t rowBytes);
+
+    /**
+     *  If the field for this key has been generated, copy it into
+     *  distanceField (sized with SkComputeDistanceFieldSize), forget the
+     *  request and return true.  Otherwise forget the request -- finished or
+     *  not, it will not be returned again -- and return false, in which case
+     *  the caller should generate the field itself.
+     */
+    static bool Take(uint64_t key, unsigned char* distanceField);
+
+    /** Drop all requests whose results have not been taken. */
+    static void PurgeAll();
+};
+
+#endif  // SkDistanceFieldPrefetcher_DEFINED
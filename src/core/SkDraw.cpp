@@ -7,6 +7,7 @@
 #define __STDC_LIMIT_MACROS
 
 #include "SkDraw.h"
+#include "SkBlitRow.h"
 #include "SkBlitter.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
@@ -16,16 +17,20 @@
 #include "SkMaskFilter.h"
 #include "SkPaint.h"
 #include "SkPathEffect.h"
+#include "SkPixelRef.h"
 #include "SkRasterClip.h"
 #include "SkRasterizer.h"
 #include "SkRRect.h"
 #include "SkScan.h"
 #include "SkShader.h"
 #include "SkSmallAllocator.h"
+#include "SkSpriteBlitter.h"
 #include "SkString.h"
 #include "SkStroke.h"
+#include "SkTemplates.h"
 #include "SkTextMapStateProc.h"
 #include "SkTLazy.h"
+#include "SkTSort.h"
 #include "SkUtils.h"
 #include "SkVertState.h"
 
@@ -928,6 +933,67 @@ void SkDraw::drawRect(const SkRect& prePaintRect, const SkPaint& paint,
     }
 }
 
+namespace {
+struct RectTopLess {
+    bool operator()(const SkRect& a, const SkRect& b) const {
+        return a.fTop < b.fTop || (a.fTop == b.fTop && a.fLeft < b.fLeft);
+    }
+};
+}
+
+void SkDraw::drawRects(const SkRect rects[], int count, const SkPaint& paint) const {
+    SkDEBUGCODE(this->validate();)
+
+    if (count <= 0 || fRC->isEmpty()) {
+        return;
+    }
+
+    SkPoint strokeSize;
+    if (kFill_RectType != ComputeRectType(paint, *fMatrix, &strokeSize)) {
+        // Strokes, hairlines and effect-carrying paints don't share enough
+        // setup to be worth batching.
+        for (int i = 0; i < count; ++i) {
+            this->drawRect(rects[i], paint);
+        }
+        return;
+    }
+
+    // Map everything into device space up front, culling as we go.
+    SkAutoSTMalloc<32, SkRect> devStorage(count);
+    SkRect* devRects = devStorage.get();
+    int devCount = 0;
+    for (int i = 0; i < count; ++i) {
+        SkRect r;
+        fMatrix->mapPoints(rect_points(r), rect_points(rects[i]), 2);
+        r.sort();
+        if (!fRC->quickReject(r.roundOut())) {
+            devRects[devCount++] = r;
+        }
+    }
+    if (0 == devCount) {
+        return;
+    }
+
+    // Emit in scanline order so the blitter walks the target top-down.
+    if (devCount > 1) {
+        SkTQSort(devRects, devRects + devCount - 1, RectTopLess());
+    }
+
+    SkAutoBlitterChoose blitterStorage(*fBitmap, *fMatrix, paint);
+    SkBlitter*          blitter = blitterStorage.get();
+    const SkRasterClip& clip = *fRC;
+
+    if (paint.isAntiAlias()) {
+        for (int i = 0; i < devCount; ++i) {
+            SkScan::AntiFillRect(devRects[i], clip, blitter);
+        }
+    } else {
+        for (int i = 0; i < devCount; ++i) {
+            SkScan::FillRect(devRects[i], clip, blitter);
+        }
+    }
+}
+
 void SkDraw::drawDevMask(const SkMask& srcM, const SkPaint& paint) const {
     if (srcM.fBounds.isEmpty()) {
         return;
@@ -993,6 +1059,20 @@ bool SkDrawTreatAAStrokeAsHairline(SkScalar strokeWidth, const SkMatrix& matrix,
     return false;
 }
 
+// A uniform stroke's outline only stays rrect-shaped if every corner is a
+// true circular arc: offsetting a circle gives a circle, but a square corner's
+// outline depends on the stroke join, and an elliptical corner's offset curve
+// is not an ellipse.
+static bool all_corners_stroke_friendly(const SkRRect& rrect) {
+    for (int i = 0; i < 4; ++i) {
+        const SkVector& r = rrect.radii((SkRRect::Corner)i);
+        if (r.fX <= 0 || r.fX != r.fY) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void SkDraw::drawRRect(const SkRRect& rrect, const SkPaint& paint) const {
     SkDEBUGCODE(this->validate());
 
@@ -1009,22 +1089,39 @@ void SkDraw::drawRRect(const SkRRect& rrect, const SkPaint& paint) const {
             goto DRAW_PATH;
         }
 
-        if (paint.getPathEffect() || paint.getStyle() != SkPaint::kFill_Style) {
+        if (paint.getPathEffect() || paint.getRasterizer()) {
             goto DRAW_PATH;
         }
 
-        if (paint.getRasterizer()) {
+        // Mask-filtered strokes can stay on the rrect path (the stroke's ring
+        // is still rrect-shaped); everything else non-fill takes the path.
+        if (paint.getStyle() != SkPaint::kFill_Style &&
+            !(SkPaint::kStroke_Style == paint.getStyle() && paint.getMaskFilter())) {
             goto DRAW_PATH;
         }
     }
 
     if (paint.getMaskFilter()) {
+        SkScalar devStrokeWidth = 0;
+        if (SkPaint::kStroke_Style == paint.getStyle()) {
+            // Outsetting and insetting by half the stroke width only tracks
+            // the stroke's outline when the width maps uniformly and every
+            // corner is a circular arc.
+            if (!fMatrix->isSimilarity() || !all_corners_stroke_friendly(rrect)) {
+                goto DRAW_PATH;
+            }
+            devStrokeWidth = fMatrix->mapRadius(paint.getStrokeWidth());
+            if (devStrokeWidth <= 0) {
+                goto DRAW_PATH;
+            }
+        }
+
         // Transform the rrect into device space.
         SkRRect devRRect;
         if (rrect.transform(*fMatrix, &devRRect)) {
             SkAutoBlitterChoose blitter(*fBitmap, *fMatrix, paint);
             if (paint.getMaskFilter()->filterRRect(devRRect, *fMatrix, *fRC, blitter.get(),
-                                                   SkPaint::kFill_Style)) {
+                                                   paint.getStyle(), devStrokeWidth)) {
                 return; // filterRRect() called the blitter, so we're done
             }
         }
@@ -1301,6 +1398,23 @@ void SkDraw::drawBitmap(const SkBitmap& bitmap, const SkMatrix& prematrix,
         return;
     }
 
+    if (bitmap.pixelRef()) {
+        // Tell lazy pixelrefs which part of the source this draw can actually sample, so
+        // they need not decode the rest. Outset by one texel for bilinear filtering.
+        SkMatrix inverse;
+        if (matrix.invert(&inverse)) {
+            SkRect src;
+            inverse.mapRect(&src, SkRect::Make(fRC->getBounds()));
+            SkIRect isrc;
+            src.roundOut(&isrc);
+            isrc.outset(1, 1);
+            if (isrc.intersect(SkIRect::MakeWH(bitmap.width(), bitmap.height()))) {
+                isrc.offset(bitmap.pixelRefOrigin().x(), bitmap.pixelRefOrigin().y());
+                bitmap.pixelRef()->ensureRegionResident(isrc);
+            }
+        }
+    }
+
     if (bitmap.colorType() != kAlpha_8_SkColorType && just_translate(matrix, bitmap)) {
         //
         // It is safe to call lock pixels now, since we know the matrix is
@@ -1364,6 +1478,17 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y,
         return; // nothing to draw
     }
 
+    if (bitmap.pixelRef()) {
+        // Sprites sample 1:1, so the needed source region is just the clip bounds shifted
+        // into bitmap space.
+        SkIRect isrc = fRC->getBounds();
+        isrc.offset(-x, -y);
+        if (isrc.intersect(SkIRect::MakeWH(bitmap.width(), bitmap.height()))) {
+            isrc.offset(bitmap.pixelRefOrigin().x(), bitmap.pixelRefOrigin().y());
+            bitmap.pixelRef()->ensureRegionResident(isrc);
+        }
+    }
+
     SkPaint paint(origPaint);
     paint.setStyle(SkPaint::kFill_Style);
 
@@ -1398,6 +1523,230 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y,
     draw.drawRect(r, shaderPaint);
 }
 
+namespace {
+// Orders sprite placements by destination top row.
+struct SpriteRowOrder {
+    const SkIPoint* fDst;
+    bool operator()(int a, int b) const { return fDst[a].fY < fDst[b].fY; }
+};
+}  // namespace
+
+void SkDraw::drawSprites(const SkBitmap& bitmap, const SkIRect src[], const SkIPoint dst[],
+                         int count, const SkPaint& origPaint) const {
+    SkDEBUGCODE(this->validate();)
+
+    if (fRC->isEmpty() || count <= 0 ||
+            bitmap.width() == 0 || bitmap.height() == 0 ||
+            bitmap.colorType() == kUnknown_SkColorType) {
+        return;
+    }
+
+    SkPaint paint(origPaint);
+    paint.setStyle(SkPaint::kFill_Style);
+
+    // One blitter for the whole batch: the choice depends only on the source,
+    // destination and paint, so it can be repositioned per placement.
+    SkTBlitterAllocator allocator;
+    SkBlitter* blitter = NULL;
+    if (NULL == paint.getColorFilter()) {
+        blitter = SkBlitter::ChooseSprite(*fBitmap, paint, bitmap, 0, 0, &allocator);
+    }
+
+    SkAutoSTMalloc<64, int> orderStorage(count);
+    int* order = orderStorage.get();
+    for (int i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    SpriteRowOrder cmp = { dst };
+    SkTQSort(order, order + count - 1, cmp);
+
+    const SkIRect bitmapBounds = SkIRect::MakeWH(bitmap.width(), bitmap.height());
+    for (int i = 0; i < count; i++) {
+        const SkIRect& srcRect = src[order[i]];
+        const SkIPoint& dstPoint = dst[order[i]];
+        SkIRect subset = srcRect;
+        if (!subset.intersect(bitmapBounds)) {
+            continue;
+        }
+        SkIRect bounds = SkIRect::MakeXYWH(dstPoint.fX + subset.fLeft - srcRect.fLeft,
+                                           dstPoint.fY + subset.fTop - srcRect.fTop,
+                                           subset.width(), subset.height());
+        if (fRC->quickReject(bounds)) {
+            continue;
+        }
+        if (blitter && (fRC->isBW() || fRC->quickContains(bounds))) {
+            // Reposition the blitter: its origin is where the full bitmap's
+            // top-left lands for this subset, and the fill rect selects the
+            // subset out of it.
+            static_cast<SkSpriteBlitter*>(blitter)->setup(*fBitmap,
+                                                          bounds.fLeft - subset.fLeft,
+                                                          bounds.fTop - subset.fTop,
+                                                          paint);
+            SkScan::FillIRect(bounds, *fRC, blitter);
+        } else {
+            // Color filter or partially covered AA clip: sprite at a time.
+            SkBitmap tmp;
+            if (bitmap.extractSubset(&tmp, subset)) {
+                this->drawSprite(tmp, bounds.fLeft, bounds.fTop, paint);
+            }
+        }
+    }
+}
+
+bool SkDraw::drawBitmapNine(const SkBitmap& bitmap, const SkIRect& center,
+                            const SkRect& dst, const SkPaint& paint) const {
+    SkDEBUGCODE(this->validate();)
+
+    if (fRC->isEmpty()) {
+        return true;    // nothing to draw
+    }
+
+    // Only the plain srcover blit is expressible as SkBlitRow calls; anything
+    // fancier goes back through the general bitmap machinery.
+    if (paint.getStyle() != SkPaint::kFill_Style || paint.getShader() ||
+            paint.getColorFilter() || paint.getMaskFilter() || paint.getXfermode() ||
+            paint.getImageFilter() || paint.getRasterizer()) {
+        return false;
+    }
+    if (kN32_SkColorType != bitmap.colorType() || kN32_SkColorType != fBitmap->colorType()) {
+        return false;
+    }
+    if (fRC->isAA() || (fMatrix->getType() & ~SkMatrix::kTranslate_Mask)) {
+        return false;
+    }
+
+    // Every patch must land on whole device pixels, or the edges need AA.
+    SkRect devDst = dst;
+    devDst.offset(fMatrix->getTranslateX(), fMatrix->getTranslateY());
+    SkIRect dstI;
+    devDst.round(&dstI);
+    SkRect check;
+    check.set(dstI);
+    if (check != devDst) {
+        return false;
+    }
+
+    const int w = bitmap.width();
+    const int h = bitmap.height();
+    SkASSERT(SkIRect::MakeWH(w, h).contains(center));
+
+    const int srcX[4] = { 0, center.fLeft, center.fRight, w };
+    const int srcY[4] = { 0, center.fTop, center.fBottom, h };
+    int dstX[4] = {
+        dstI.fLeft, dstI.fLeft + center.fLeft, dstI.fRight - (w - center.fRight), dstI.fRight
+    };
+    int dstY[4] = {
+        dstI.fTop, dstI.fTop + center.fTop, dstI.fBottom - (h - center.fBottom), dstI.fBottom
+    };
+
+    if (dstX[1] > dstX[2]) {
+        dstX[1] = dstX[0] + (dstX[3] - dstX[0]) * center.fLeft / (w - center.width());
+        dstX[2] = dstX[1];
+    }
+    if (dstY[1] > dstY[2]) {
+        dstY[1] = dstY[0] + (dstY[3] - dstY[0]) * center.fTop / (h - center.height());
+        dstY[2] = dstY[1];
+    }
+
+    // Nearest sampling only; if the caller wants filtered stretching, fall
+    // back (the corners are 1:1 either way).
+    const bool scaled = dstX[1] - dstX[0] != srcX[1] - srcX[0] ||
+                        dstX[2] - dstX[1] != srcX[2] - srcX[1] ||
+                        dstX[3] - dstX[2] != srcX[3] - srcX[2] ||
+                        dstY[1] - dstY[0] != srcY[1] - srcY[0] ||
+                        dstY[2] - dstY[1] != srcY[2] - srcY[1] ||
+                        dstY[3] - dstY[2] != srcY[3] - srcY[2];
+    if (scaled && kNone_SkFilterQuality != paint.getFilterQuality()) {
+        return false;
+    }
+
+    SkAutoLockPixels alp(bitmap);
+    if (!bitmap.readyToDraw()) {
+        return true;    // nothing to draw
+    }
+
+    const unsigned paintAlpha = paint.getAlpha();
+    if (0 == paintAlpha) {
+        return true;    // nothing to draw
+    }
+
+    // This is the once-per-draw setup the per-patch fallback repeats 9 times.
+    unsigned flags = 0;
+    if (paintAlpha < 0xFF) {
+        flags |= SkBlitRow::kGlobalAlpha_Flag32;
+    }
+    if (!bitmap.isOpaque()) {
+        flags |= SkBlitRow::kSrcPixelAlpha_Flag32;
+    }
+    SkBlitRow::Proc32 proc = SkBlitRow::Factory32(flags);
+
+    int maxDstW = 0;
+    for (int i = 0; i < 3; i++) {
+        maxDstW = SkMax32(maxDstW, dstX[i+1] - dstX[i]);
+    }
+    SkAutoTMalloc<SkPMColor> rowStorage(maxDstW);
+    SkAutoTMalloc<int>       lutStorage(maxDstW);
+    SkPMColor* rowBuf = rowStorage.get();
+    int*       xLUT   = lutStorage.get();
+
+    const SkRegion& clipRgn = fRC->bwRgn();
+
+    for (int cy = 0; cy < 3; cy++) {
+        const int sTop = srcY[cy];
+        const int sH = srcY[cy+1] - sTop;
+        const int dTop = dstY[cy];
+        const int dH = dstY[cy+1] - dTop;
+        if (sH <= 0 || dH <= 0) {
+            continue;
+        }
+        for (int cx = 0; cx < 3; cx++) {
+            const int sLeft = srcX[cx];
+            const int sW = srcX[cx+1] - sLeft;
+            const int dLeft = dstX[cx];
+            const int dW = dstX[cx+1] - dLeft;
+            if (sW <= 0 || dW <= 0) {
+                continue;
+            }
+
+            const bool scaleX = sW != dW;
+            if (scaleX) {
+                for (int i = 0; i < dW; i++) {
+                    xLUT[i] = sLeft + i * sW / dW;
+                }
+            }
+
+            // Stretched patches repeat source rows, so remember the last one
+            // we scaled and replay it down the patch.
+            int cachedSy = -1;
+
+            SkRegion::Cliperator iter(clipRgn,
+                                      SkIRect::MakeXYWH(dLeft, dTop, dW, dH));
+            for (; !iter.done(); iter.next()) {
+                const SkIRect& r = iter.rect();
+                for (int y = r.fTop; y < r.fBottom; y++) {
+                    const int sy = sTop + (sH == dH ? y - dTop : (y - dTop) * sH / dH);
+                    uint32_t* dstRow = fBitmap->getAddr32(r.fLeft, y);
+                    const SkPMColor* srcRow;
+                    if (!scaleX) {
+                        srcRow = bitmap.getAddr32(sLeft + (r.fLeft - dLeft), sy);
+                    } else {
+                        if (sy != cachedSy) {
+                            const SkPMColor* s = bitmap.getAddr32(0, sy);
+                            for (int i = 0; i < dW; i++) {
+                                rowBuf[i] = s[xLUT[i]];
+                            }
+                            cachedSy = sy;
+                        }
+                        srcRow = rowBuf + (r.fLeft - dLeft);
+                    }
+                    proc(dstRow, srcRow, r.width(), paintAlpha);
+                }
+            }
+        }
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SkScalerContext.h"
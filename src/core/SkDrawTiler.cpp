@@ -0,0 +1,117 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDrawTiler.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkRasterClip.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
+
+// Each band covers this many device rows. Small enough to hand every core
+// work on a 1080p surface, large enough that edge setup doesn't dominate.
+static const int kBandHeight = 128;
+
+// Below this many bands the per-band setup outweighs the parallelism.
+static const int kMinBands = 2;
+
+bool SkDrawTiler::Usable(const SkDraw& draw, const SkPaint& paint) {
+    if (NULL == draw.fRC || draw.fRC->isEmpty()) {
+        return false;
+    }
+    // Mask filters and rasterizers generate coverage that crosses band
+    // boundaries, so banding them would produce seams.
+    if (paint.getMaskFilter() || paint.getRasterizer() || paint.getImageFilter()) {
+        return false;
+    }
+    const SkIRect& bounds = draw.fRC->getBounds();
+    return bounds.height() >= kMinBands * kBandHeight;
+}
+
+namespace {
+
+struct DrawBand {
+    SkDraw          fDraw;      // copy of the original, with fRC repointed
+    SkRasterClip    fBandRC;    // original clip intersected with the band
+
+    const SkPath*   fPath;
+    const SkMatrix* fPrePathMatrix;
+    bool            fPathIsMutable;
+
+    const SkBitmap* fBitmap;
+    const SkMatrix* fBitmapMatrix;
+    const SkRect*   fDstOrNull;
+
+    const SkPaint*  fPaint;
+};
+
+}  // namespace
+
+static void draw_path_band(DrawBand* band) {
+    // pathIsMutable would let SkDraw transform the path in place, which is
+    // not safe once the same path is visible to several bands.
+    band->fDraw.drawPath(*band->fPath, *band->fPaint, band->fPrePathMatrix, false);
+}
+
+static void draw_bitmap_band(DrawBand* band) {
+    band->fDraw.drawBitmap(*band->fBitmap, *band->fBitmapMatrix, band->fDstOrNull,
+                           *band->fPaint);
+}
+
+static int setup_bands(const SkDraw& draw, SkAutoSTMalloc<8, DrawBand>* storage) {
+    const SkIRect& bounds = draw.fRC->getBounds();
+    const int bandCount = (bounds.height() + kBandHeight - 1) / kBandHeight;
+
+    DrawBand* bands = storage->reset(bandCount);
+    for (int i = 0; i < bandCount; ++i) {
+        DrawBand* band = SkNEW_PLACEMENT(&bands[i], DrawBand);
+        SkIRect bandRect = SkIRect::MakeLTRB(bounds.left(), bounds.top() + i * kBandHeight,
+                                             bounds.right(),
+                                             SkMin32(bounds.top() + (i + 1) * kBandHeight,
+                                                     bounds.bottom()));
+        band->fBandRC = *draw.fRC;
+        band->fBandRC.op(bandRect, SkRegion::kIntersect_Op);
+        band->fDraw = draw;
+        band->fDraw.fRC = &band->fBandRC;
+        band->fDraw.fClip = &band->fBandRC.forceGetBW();
+    }
+    return bandCount;
+}
+
+static void destroy_bands(DrawBand* bands, int count) {
+    for (int i = 0; i < count; ++i) {
+        bands[i].~DrawBand();
+    }
+}
+
+void SkDrawTiler::DrawPath(const SkDraw& draw, const SkPath& path, const SkPaint& paint,
+                           const SkMatrix* prePathMatrix, bool pathIsMutable) {
+    SkAutoSTMalloc<8, DrawBand> storage;
+    const int bandCount = setup_bands(draw, &storage);
+    for (int i = 0; i < bandCount; ++i) {
+        storage.get()[i].fPath = &path;
+        storage.get()[i].fPrePathMatrix = prePathMatrix;
+        storage.get()[i].fPathIsMutable = pathIsMutable;
+        storage.get()[i].fPaint = &paint;
+    }
+    SkTaskGroup().batch(draw_path_band, storage.get(), bandCount);
+    destroy_bands(storage.get(), bandCount);
+}
+
+void SkDrawTiler::DrawBitmap(const SkDraw& draw, const SkBitmap& bitmap, const SkMatrix& matrix,
+                             const SkRect* dstOrNull, const SkPaint& paint) {
+    SkAutoSTMalloc<8, DrawBand> storage;
+    const int bandCount = setup_bands(draw, &storage);
+    for (int i = 0; i < bandCount; ++i) {
+        storage.get()[i].fBitmap = &bitmap;
+        storage.get()[i].fBitmapMatrix = &matrix;
+        storage.get()[i].fDstOrNull = dstOrNull;
+        storage.get()[i].fPaint = &paint;
+    }
+    SkTaskGroup().batch(draw_bitmap_band, storage.get(), bandCount);
+    destroy_bands(storage.get(), bandCount);
+}
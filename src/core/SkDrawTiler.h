@@ -0,0 +1,40 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDrawTiler_DEFINED
+#define SkDrawTiler_DEFINED
+
+#include "SkDraw.h"
+
+/**
+ *  Splits a single SkDraw into horizontal bands and runs each band on an
+ *  SkTaskGroup worker, with the band's SkRasterClip intersected into the
+ *  draw's clip. Blitters are clip-bounded, so each band writes a disjoint
+ *  set of rows and the bands can run concurrently.
+ *
+ *  This is only used when the owning surface opted in via
+ *  SkSurfaceProps::kAllowThreadedRaster_Flag, and falls back to running
+ *  the bands serially when SkTaskGroup has not been enabled.
+ */
+class SkDrawTiler {
+public:
+    /**
+     *  Returns true if the draw is a sensible candidate for banding:
+     *  the clip must span enough rows to amortize the per-band setup, and
+     *  the paint must not carry effects (mask filters, rasterizers) whose
+     *  output crosses band boundaries.
+     */
+    static bool Usable(const SkDraw&, const SkPaint&);
+
+    static void DrawPath(const SkDraw&, const SkPath&, const SkPaint&,
+                         const SkMatrix* prePathMatrix, bool pathIsMutable);
+
+    static void DrawBitmap(const SkDraw&, const SkBitmap&, const SkMatrix&,
+                           const SkRect* dstOrNull, const SkPaint&);
+};
+
+#endif
@@ -21,7 +21,23 @@ static int32_t next_generation_id() {
     return genID;
 }
 
-SkDrawable::SkDrawable() : fGenerationID(0) {}
+SkDrawable::SkDrawable()
+    : fGenerationID(0)
+    , fCachedPicture(NULL)
+    , fCachedGenerationID(0)
+    , fCachingEnabled(false) {}
+
+SkDrawable::~SkDrawable() {
+    SkSafeUnref(fCachedPicture);
+}
+
+void SkDrawable::setSnapshotCachingEnabled(bool enabled) {
+    if (fCachingEnabled != enabled) {
+        fCachingEnabled = enabled;
+        SkSafeUnref(fCachedPicture);
+        fCachedPicture = NULL;
+    }
+}
 
 static void draw_bbox(SkCanvas* canvas, const SkRect& r) {
     SkPaint paint;
@@ -34,6 +50,21 @@ static void draw_bbox(SkCanvas* canvas, const SkRect& r) {
 
 void SkDrawable::draw(SkCanvas* canvas) {
     SkAutoCanvasRestore acr(canvas, true);
+
+    if (fCachingEnabled) {
+        const uint32_t genID = this->getGenerationID();
+        if (NULL == fCachedPicture || fCachedGenerationID != genID) {
+            SkSafeUnref(fCachedPicture);
+            fCachedPicture = this->newPictureSnapshot();
+            fCachedGenerationID = genID;
+        }
+        if (fCachedPicture) {
+            canvas->drawPicture(fCachedPicture);
+            return;
+        }
+        // Snapshotting failed somehow; fall through and draw directly.
+    }
+
     this->onDraw(canvas);
 
     if (false) {
@@ -69,7 +100,12 @@ SkPicture* SkDrawable::onNewPictureSnapshot() {
 
     const SkRect bounds = this->getBounds();
     SkCanvas* canvas = recorder.beginRecording(bounds, NULL, 0);
-    this->draw(canvas);
+    {
+        // Call onDraw() directly rather than draw(): when snapshot caching is enabled,
+        // draw() would circle back here trying to build the snapshot we're recording.
+        SkAutoCanvasRestore acr(canvas, true);
+        this->onDraw(canvas);
+    }
     if (false) {
         draw_bbox(canvas, bounds);
     }
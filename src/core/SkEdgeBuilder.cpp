@@ -18,12 +18,12 @@ template <typename T> static T* typedAllocThrow(SkChunkAlloc& alloc) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SkEdgeBuilder::SkEdgeBuilder() : fAlloc(16*1024) {
+SkEdgeBuilder::SkEdgeBuilder() : fArena(16*1024) {
     fEdgeList = NULL;
 }
 
 void SkEdgeBuilder::addLine(const SkPoint pts[]) {
-    SkEdge* edge = typedAllocThrow<SkEdge>(fAlloc);
+    SkEdge* edge = typedAllocThrow<SkEdge>(*fArena);
     if (edge->setLine(pts[0], pts[1], fShiftUp)) {
         fList.push(edge);
     } else {
@@ -32,7 +32,7 @@ void SkEdgeBuilder::addLine(const SkPoint pts[]) {
 }
 
 void SkEdgeBuilder::addQuad(const SkPoint pts[]) {
-    SkQuadraticEdge* edge = typedAllocThrow<SkQuadraticEdge>(fAlloc);
+    SkQuadraticEdge* edge = typedAllocThrow<SkQuadraticEdge>(*fArena);
     if (edge->setQuadratic(pts, fShiftUp)) {
         fList.push(edge);
     } else {
@@ -41,7 +41,7 @@ void SkEdgeBuilder::addQuad(const SkPoint pts[]) {
 }
 
 void SkEdgeBuilder::addCubic(const SkPoint pts[]) {
-    SkCubicEdge* edge = typedAllocThrow<SkCubicEdge>(fAlloc);
+    SkCubicEdge* edge = typedAllocThrow<SkCubicEdge>(*fArena);
     if (edge->setCubic(pts, fShiftUp)) {
         fList.push(edge);
     } else {
@@ -96,7 +96,7 @@ int SkEdgeBuilder::buildPoly(const SkPath& path, const SkIRect* iclip, int shift
     size_t maxEdgePtrSize = maxEdgeCount * sizeof(SkEdge*);
 
     // lets store the edges and their pointers in the same block
-    char* storage = (char*)fAlloc.allocThrow(maxEdgeSize + maxEdgePtrSize);
+    char* storage = (char*)fArena->allocThrow(maxEdgeSize + maxEdgePtrSize);
     SkEdge* edge = reinterpret_cast<SkEdge*>(storage);
     SkEdge** edgePtr = reinterpret_cast<SkEdge**>(storage + maxEdgeSize);
     // Record the beginning of our pointers, so we can return them to the caller
@@ -163,7 +163,7 @@ static void handle_quad(SkEdgeBuilder* builder, const SkPoint pts[3]) {
 
 int SkEdgeBuilder::build(const SkPath& path, const SkIRect* iclip, int shiftUp,
                          bool canCullToTheRight) {
-    fAlloc.reset();
+    fArena->rewind();
     fList.reset();
     fShiftUp = shiftUp;
 
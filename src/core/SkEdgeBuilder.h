@@ -8,9 +8,9 @@
 #ifndef SkEdgeBuilder_DEFINED
 #define SkEdgeBuilder_DEFINED
 
-#include "SkChunkAlloc.h"
 #include "SkRect.h"
 #include "SkTDArray.h"
+#include "SkThreadArena.h"
 
 struct SkEdge;
 class SkEdgeClipper;
@@ -27,7 +27,7 @@ public:
     SkEdge** edgeList() { return fEdgeList; }
 
 private:
-    SkChunkAlloc        fAlloc;
+    SkAutoThreadArena   fArena;
     SkTDArray<SkEdge*>  fList;
 
     /*
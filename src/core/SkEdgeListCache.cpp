@@ -0,0 +1,164 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkEdgeListCache.h"
+#include "SkChecksum.h"
+#include "SkResourceCache.h"
+
+// Below this many verbs, rebuilding the edges costs about as much as
+// digesting the path, so don't bother.
+static const int kMinVerbsToCache = 8;
+
+// Each cached record is padded to the largest edge type so the pointer
+// array can be rebuilt by fixed-stride arithmetic.
+static const size_t kEdgeRecordBytes = sizeof(SkCubicEdge);
+
+static size_t edge_actual_bytes(const SkEdge* edge) {
+    if (edge->fCurveCount > 0) {
+        return sizeof(SkQuadraticEdge);
+    } else if (edge->fCurveCount < 0) {
+        return sizeof(SkCubicEdge);
+    }
+    return sizeof(SkEdge);
+}
+
+bool SkEdgeListCache::ComputeDigest(const SkPath& path, const SkIRect* clipRect, int shiftUp,
+                                    bool clipToTheRight, uint64_t* digest) {
+    const int verbCount = path.countVerbs();
+    if (verbCount < kMinVerbsToCache) {
+        return false;
+    }
+    const int ptCount = path.countPoints();
+
+    SkAutoSTMalloc<64, SkPoint> points(ptCount);
+    SkAutoSTMalloc<256, uint8_t> verbs(verbCount);
+    path.getPoints(points.get(), ptCount);
+    path.getVerbs(verbs.get(), verbCount);
+
+    // Conic weights are stored beside the point array in SkPathRef and are
+    // not part of getPoints(); two paths differing only in a weight would
+    // otherwise digest identically. There is no public bulk accessor, so
+    // collect them by walking the verbs when the path has any conics.
+    SkAutoSTMalloc<16, SkScalar> weights(verbCount);
+    int weightCount = 0;
+    if (path.getSegmentMasks() & SkPath::kConic_SegmentMask) {
+        SkPath::RawIter iter(path);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while (SkPath::kDone_Verb != (verb = iter.next(pts))) {
+            if (SkPath::kConic_Verb == verb) {
+                weights[weightCount++] = iter.conicWeight();
+            }
+        }
+    }
+
+    struct {
+        SkIRect fClip;
+        int32_t fShiftUp;
+        int32_t fClipToTheRight;
+        int32_t fFillType;
+    } params = {
+        clipRect ? *clipRect : SkIRect::MakeEmpty(),
+        shiftUp,
+        clipToTheRight,
+        path.getFillType(),
+    };
+    // Hash everything twice with unrelated seeds so the two words collide
+    // independently. Chaining the second word off the first would make it a
+    // function of (first word, params): any 32-bit collision between paths
+    // would collide in both words, leaving only ~32 bits of protection on a
+    // cache that returns edges without verifying the path on a hit.
+    static const uint32_t kLoSeed = 0x9e3779b9;  // arbitrary, != the default seed of 0
+    uint32_t hi = SkChecksum::Murmur3(points.get(), ptCount * sizeof(SkPoint));
+    hi = SkChecksum::Murmur3(verbs.get(), verbCount * sizeof(uint8_t), hi);
+    hi = SkChecksum::Murmur3(weights.get(), weightCount * sizeof(SkScalar), hi);
+    hi = SkChecksum::Murmur3(&params, sizeof(params), hi);
+
+    uint32_t lo = SkChecksum::Murmur3(points.get(), ptCount * sizeof(SkPoint), kLoSeed);
+    lo = SkChecksum::Murmur3(verbs.get(), verbCount * sizeof(uint8_t), lo);
+    lo = SkChecksum::Murmur3(weights.get(), weightCount * sizeof(SkScalar), lo);
+    lo = SkChecksum::Murmur3(&params, sizeof(params), lo);
+
+    *digest = (uint64_t)hi << 32 | lo;
+    return true;
+}
+
+namespace {
+
+static unsigned gEdgeListKeyNamespaceLabel;
+
+struct EdgeListKey : public SkResourceCache::Key {
+    EdgeListKey(uint64_t digest) : fDigest(digest) {
+        this->init(&gEdgeListKeyNamespaceLabel, 0, sizeof(fDigest));
+    }
+    uint64_t fDigest;
+};
+
+struct EdgeListRec : public SkResourceCache::Rec {
+    EdgeListRec(uint64_t digest, SkEdge** list, int count)
+        : fKey(digest)
+        , fCount(count)
+        , fRecords(sk_malloc_throw(count * kEdgeRecordBytes)) {
+        char* slot = (char*)fRecords;
+        for (int i = 0; i < count; ++i) {
+            memcpy(slot, list[i], edge_actual_bytes(list[i]));
+            slot += kEdgeRecordBytes;
+        }
+    }
+    ~EdgeListRec() override {
+        sk_free(fRecords);
+    }
+
+    EdgeListKey fKey;
+    int         fCount;
+    void*       fRecords;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fCount * kEdgeRecordBytes;
+    }
+
+    struct FindContext {
+        SkAutoMalloc*       fEdgeStorage;
+        SkTDArray<SkEdge*>* fList;
+        int                 fCount;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const EdgeListRec& rec = static_cast<const EdgeListRec&>(baseRec);
+        FindContext* ctx = (FindContext*)contextData;
+
+        const size_t bytes = rec.fCount * kEdgeRecordBytes;
+        char* copy = (char*)ctx->fEdgeStorage->reset(bytes);
+        memcpy(copy, rec.fRecords, bytes);
+
+        ctx->fList->setCount(rec.fCount);
+        for (int i = 0; i < rec.fCount; ++i) {
+            (*ctx->fList)[i] = (SkEdge*)(copy + i * kEdgeRecordBytes);
+        }
+        ctx->fCount = rec.fCount;
+        return true;
+    }
+};
+
+}  // namespace
+
+int SkEdgeListCache::Find(uint64_t digest, SkAutoMalloc* edgeStorage,
+                          SkTDArray<SkEdge*>* list) {
+    EdgeListRec::FindContext ctx = { edgeStorage, list, -1 };
+    if (!SkResourceCache::Find(EdgeListKey(digest), EdgeListRec::Visitor, &ctx)) {
+        return -1;
+    }
+    return ctx.fCount;
+}
+
+void SkEdgeListCache::Add(uint64_t digest, SkEdge** list, int count) {
+    if (count <= 0) {
+        return;
+    }
+    SkResourceCache::Add(SkNEW_ARGS(EdgeListRec, (digest, list, count)));
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkEdgeListCache_DEFINED
+#define SkEdgeListCache_DEFINED
+
+#include "SkEdge.h"
+#include "SkPath.h"
+#include "SkTDArray.h"
+#include "SkTemplates.h"
+
+/**
+ *  Caches built (but unwalked) edge lists in SkResourceCache, so repeated
+ *  rasterization of the same device-space geometry can skip SkEdgeBuilder's
+ *  path iteration, curve chopping, and per-edge setup.
+ *
+ *  Because the SkPath handed to SkScan::FillPath is the freshly transformed
+ *  device-space copy (its genID is not stable across draws), entries are
+ *  keyed by a digest of the device-space geometry plus the clip/shift
+ *  parameters that influence edge building -- the post-transform equivalent
+ *  of "source path genID + device matrix".
+ *
+ *  Edges are mutated while they're walked, so a hit copies the cached
+ *  records into caller-owned storage.
+ */
+class SkEdgeListCache {
+public:
+    /**
+     *  Digest the geometry and edge-building parameters. Returns false if
+     *  this path isn't worth caching (too few verbs to amortize the digest).
+     */
+    static bool ComputeDigest(const SkPath&, const SkIRect* clipRect, int shiftUp,
+                              bool clipToTheRight, uint64_t* digest);
+
+    /**
+     *  On a hit, fills edgeStorage with a mutable copy of the cached edge
+     *  records, points list at them, and returns the edge count. Returns -1
+     *  on a miss.
+     */
+    static int Find(uint64_t digest, SkAutoMalloc* edgeStorage, SkTDArray<SkEdge*>* list);
+
+    /** Record the built edge list under the digest. */
+    static void Add(uint64_t digest, SkEdge** list, int count);
+};
+
+#endif
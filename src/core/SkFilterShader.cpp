@@ -73,7 +73,10 @@ SkFilterShader::FilterShaderContext::FilterShaderContext(const SkFilterShader& f
                                                          SkShader::Context* shaderContext,
                                                          const ContextRec& rec)
     : INHERITED(filterShader, rec)
-    , fShaderContext(shaderContext) {}
+    , fShaderContext(shaderContext)
+    , fFilterProcCtx(NULL) {
+    fFilterProc = filterShader.fFilter->asSpanProc(&fFilterProcCtx);
+}
 
 SkFilterShader::FilterShaderContext::~FilterShaderContext() {
     fShaderContext->~Context();
@@ -83,7 +86,11 @@ void SkFilterShader::FilterShaderContext::shadeSpan(int x, int y, SkPMColor resu
     const SkFilterShader& filterShader = static_cast<const SkFilterShader&>(fShader);
 
     fShaderContext->shadeSpan(x, y, result, count);
-    filterShader.fFilter->filterSpan(result, count, result);
+    if (fFilterProc) {
+        fFilterProc(fFilterProcCtx, result, count, result);
+    } else {
+        filterShader.fFilter->filterSpan(result, count, result);
+    }
 }
 
 #ifndef SK_IGNORE_TO_STRING
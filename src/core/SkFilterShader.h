@@ -8,10 +8,9 @@
 #ifndef SkFilterShader_DEFINED
 #define SkFilterShader_DEFINED
 
+#include "SkColorFilter.h"
 #include "SkShader.h"
 
-class SkColorFilter;
-
 class SkFilterShader : public SkShader {
 public:
     SkFilterShader(SkShader* shader, SkColorFilter* filter);
@@ -35,7 +34,11 @@ public:
         }
 
     private:
-        SkShader::Context* fShaderContext;
+        SkShader::Context*     fShaderContext;
+        // Fused filter proc (and its context) resolved once at context creation, so the
+        // per-span loop does not pay a virtual filterSpan() call. NULL if unavailable.
+        SkColorFilter::SpanProc fFilterProc;
+        const void*            fFilterProcCtx;
 
         typedef SkShader::Context INHERITED;
     };
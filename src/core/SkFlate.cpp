@@ -10,6 +10,8 @@
 #include "SkData.h"
 #include "SkFlate.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 
 namespace {
 
@@ -30,7 +32,7 @@ template <typename T> void* skia_alloc_func(void*, T items, T size) {
 
 static void skia_free_func(void*, void* address) { sk_free(address); }
 
-bool doFlate(bool compress, SkStream* src, SkWStream* dst) {
+bool doFlate(bool compress, SkStream* src, SkWStream* dst, int compressionLevel) {
     uint8_t inputBuffer[kBufferSize];
     uint8_t outputBuffer[kBufferSize];
     z_stream flateData;
@@ -43,7 +45,7 @@ bool doFlate(bool compress, SkStream* src, SkWStream* dst) {
     flateData.avail_out = kBufferSize;
     int rc;
     if (compress)
-        rc = deflateInit(&flateData, Z_DEFAULT_COMPRESSION);
+        rc = deflateInit(&flateData, compressionLevel);
     else
         rc = inflateInit(&flateData);
     if (rc != Z_OK)
@@ -108,29 +110,140 @@ bool doFlate(bool compress, SkStream* src, SkWStream* dst) {
     return false;
 }
 
+// Memory backed inputs larger than this are split into chunks of this size,
+// which are compressed in parallel as independent raw deflate streams and
+// then concatenated.  Each chunk restarts the deflate dictionary, so smaller
+// chunks would cost more compression ratio.
+const size_t kParallelChunkSize = 1 << 17;  // 128K
+
+struct DeflateChunkTask {
+    const uint8_t*         fInput;
+    size_t                 fInputSize;
+    int                    fCompressionLevel;
+    bool                   fLast;
+    bool                   fSuccess;
+    SkDynamicMemoryWStream fOutput;
+};
+
+void deflate_chunk(DeflateChunkTask* task) {
+    z_stream flateData;
+    flateData.zalloc = &skia_alloc_func;
+    flateData.zfree = &skia_free_func;
+    flateData.opaque = NULL;
+    // A negative windowBits selects a raw deflate stream with no zlib
+    // wrapper, so the chunks can be concatenated into a single stream.
+    if (deflateInit2(&flateData, task->fCompressionLevel, Z_DEFLATED, -MAX_WBITS,
+                     8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return;
+    }
+    flateData.next_in = (Bytef*)task->fInput;
+    flateData.avail_in = SkToUInt(task->fInputSize);
+    // The last chunk terminates the stream.  The other chunks end with a full
+    // flush, which stops at a byte boundary without setting the final block
+    // bit, so the next chunk's output can follow directly.
+    const int flush = task->fLast ? Z_FINISH : Z_FULL_FLUSH;
+    uint8_t outputBuffer[kBufferSize];
+    int rc;
+    do {
+        flateData.next_out = outputBuffer;
+        flateData.avail_out = kBufferSize;
+        rc = deflate(&flateData, flush);
+        if (rc != Z_OK && rc != Z_STREAM_END) {
+            deflateEnd(&flateData);
+            return;
+        }
+        task->fOutput.write(outputBuffer, kBufferSize - flateData.avail_out);
+    } while (task->fLast ? rc != Z_STREAM_END
+                         : flateData.avail_in != 0 || 0 == flateData.avail_out);
+    deflateEnd(&flateData);
+    task->fSuccess = true;
 }
 
+bool deflate_parallel(const uint8_t* input, size_t inputLength, SkWStream* dst,
+                      int compressionLevel) {
+    SkASSERT(input != NULL && inputLength > kParallelChunkSize);
+    const size_t numChunks =
+            (inputLength + kParallelChunkSize - 1) / kParallelChunkSize;
+    SkAutoTDeleteArray<DeflateChunkTask> tasks(
+            SkNEW_ARRAY(DeflateChunkTask, numChunks));
+    uLong adler = adler32(0, NULL, 0);
+    for (size_t i = 0; i < numChunks; i++) {
+        DeflateChunkTask* task = &tasks.get()[i];
+        task->fInput = input + i * kParallelChunkSize;
+        task->fInputSize =
+                SkTMin(kParallelChunkSize, inputLength - i * kParallelChunkSize);
+        task->fCompressionLevel = compressionLevel;
+        task->fLast = numChunks - 1 == i;
+        task->fSuccess = false;
+        adler = adler32(adler, task->fInput, SkToUInt(task->fInputSize));
+    }
+
+    SkTaskGroup tg;
+    tg.batch(deflate_chunk, tasks.get(), SkToInt(numChunks));
+    tg.wait();
+
+    // Write the zlib stream header (RFC 1950): deflate with a 32K window,
+    // the advisory compression level bits, and the check bits.
+    int level = Z_DEFAULT_COMPRESSION == compressionLevel ? 6 : compressionLevel;
+    uint32_t header = 0x78 << 8;
+    if (level >= 2) {
+        header |= (6 == level ? 2 : (level < 6 ? 1 : 3)) << 6;
+    }
+    header += 31 - (header % 31);
+    if (!dst->write8(header >> 8) || !dst->write8(header & 0xFF)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < numChunks; i++) {
+        DeflateChunkTask* task = &tasks.get()[i];
+        if (!task->fSuccess) {
+            return false;
+        }
+        SkAutoTDelete<SkStream> chunk(task->fOutput.detachAsStream());
+        if (!dst->writeStream(chunk, chunk->getLength())) {
+            return false;
+        }
+    }
+
+    // The zlib stream trailer is the adler32 of the uncompressed data,
+    // big endian.
+    uint8_t trailer[4] = { (uint8_t)(adler >> 24), (uint8_t)(adler >> 16),
+                           (uint8_t)(adler >> 8),  (uint8_t)(adler >> 0) };
+    return dst->write(trailer, sizeof(trailer));
+}
+
+}
+
+SK_COMPILE_ASSERT(SkFlate::kDefaultCompression_Level == Z_DEFAULT_COMPRESSION,
+                  compression_level_mismatch);
+
 // static
-bool SkFlate::Deflate(SkStream* src, SkWStream* dst) {
-    return doFlate(true, src, dst);
+bool SkFlate::Deflate(SkStream* src, SkWStream* dst, int compressionLevel) {
+    const uint8_t* input = (const uint8_t*)src->getMemoryBase();
+    if (input != NULL && src->getLength() > kParallelChunkSize) {
+        return deflate_parallel(input, src->getLength(), dst, compressionLevel);
+    }
+    return doFlate(true, src, dst, compressionLevel);
 }
 
-bool SkFlate::Deflate(const void* ptr, size_t len, SkWStream* dst) {
+bool SkFlate::Deflate(const void* ptr, size_t len, SkWStream* dst, int compressionLevel) {
+    if (len > kParallelChunkSize) {
+        return deflate_parallel((const uint8_t*)ptr, len, dst, compressionLevel);
+    }
     SkMemoryStream stream(ptr, len);
-    return doFlate(true, &stream, dst);
+    return doFlate(true, &stream, dst, compressionLevel);
 }
 
-bool SkFlate::Deflate(const SkData* data, SkWStream* dst) {
+bool SkFlate::Deflate(const SkData* data, SkWStream* dst, int compressionLevel) {
     if (data) {
-        SkMemoryStream stream(data->data(), data->size());
-        return doFlate(true, &stream, dst);
+        return SkFlate::Deflate(data->data(), data->size(), dst, compressionLevel);
     }
     return false;
 }
 
 // static
 bool SkFlate::Inflate(SkStream* src, SkWStream* dst) {
-    return doFlate(false, src, dst);
+    return doFlate(false, src, dst, Z_DEFAULT_COMPRESSION);
 }
 
 
@@ -170,7 +283,7 @@ struct SkDeflateWStream::Impl {
     z_stream fZStream;
 };
 
-SkDeflateWStream::SkDeflateWStream(SkWStream* out)
+SkDeflateWStream::SkDeflateWStream(SkWStream* out, int compressionLevel)
     : fImpl(SkNEW(SkDeflateWStream::Impl)) {
     fImpl->fOut = out;
     fImpl->fInBufferIndex = 0;
@@ -180,7 +293,7 @@ SkDeflateWStream::SkDeflateWStream(SkWStream* out)
     fImpl->fZStream.zalloc = &skia_alloc_func;
     fImpl->fZStream.zfree = &skia_free_func;
     fImpl->fZStream.opaque = NULL;
-    SkDEBUGCODE(int r =) deflateInit(&fImpl->fZStream, Z_DEFAULT_COMPRESSION);
+    SkDEBUGCODE(int r =) deflateInit(&fImpl->fZStream, compressionLevel);
     SkASSERT(Z_OK == r);
 }
 
@@ -20,23 +20,44 @@ class SkData;
 */
 class SkFlate {
 public:
+    /**
+     *  Compression levels, matching zlib's: 0 stores the data uncompressed,
+     *  1 is the fastest compression, 9 the smallest output, and -1 selects
+     *  zlib's default tradeoff.
+     */
+    enum {
+        kNoCompression_Level      = 0,
+        kFastestCompression_Level = 1,
+        kBestCompression_Level    = 9,
+        kDefaultCompression_Level = -1,
+    };
+
     /**
      *  Use the flate compression algorithm to compress the data in src,
      *  putting the result into dst.  Returns false if an error occurs.
+     *
+     *  When the source data is memory backed and large enough, it is split
+     *  into chunks that are compressed in parallel on SkTaskGroup threads
+     *  and concatenated into a single stream.  Each chunk restarts the
+     *  deflate dictionary, so the output is marginally larger than a serial
+     *  compression at the same level.
      */
-    static bool Deflate(SkStream* src, SkWStream* dst);
+    static bool Deflate(SkStream* src, SkWStream* dst,
+                        int compressionLevel = kDefaultCompression_Level);
 
     /**
      *  Use the flate compression algorithm to compress the data in src,
      *  putting the result into dst.  Returns false if an error occurs.
      */
-    static bool Deflate(const void* src, size_t len, SkWStream* dst);
+    static bool Deflate(const void* src, size_t len, SkWStream* dst,
+                        int compressionLevel = kDefaultCompression_Level);
 
     /**
      *  Use the flate compression algorithm to compress the data,
      *  putting the result into dst.  Returns false if an error occurs.
      */
-    static bool Deflate(const SkData*, SkWStream* dst);
+    static bool Deflate(const SkData*, SkWStream* dst,
+                        int compressionLevel = kDefaultCompression_Level);
 
     /** Use the flate compression algorithm to decompress the data in src,
         putting the result into dst.  Returns false if an error occurs.
@@ -46,15 +67,15 @@ public:
 
 /**
   * Wrap a stream in this class to compress the information written to
-  * this stream using the Deflate algorithm.  Uses Zlib's
-  * Z_DEFAULT_COMPRESSION level.
+  * this stream using the Deflate algorithm.
   *
   * See http://en.wikipedia.org/wiki/DEFLATE
   */
 class SkDeflateWStream : public SkWStream {
 public:
     /** Does not take ownership of the stream. */
-    SkDeflateWStream(SkWStream*);
+    SkDeflateWStream(SkWStream*,
+                     int compressionLevel = SkFlate::kDefaultCompression_Level);
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream();
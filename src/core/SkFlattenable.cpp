@@ -59,13 +59,68 @@ struct Entry {
 static int gCount;
 static Entry gEntries[MAX_ENTRY_COUNT];
 
+// Indices into gEntries, kept sorted so the lookups below can binary search
+// instead of running a strcmp over every registered entry. Each entry's
+// position in gEntries is its registration-assigned ID and never changes;
+// only these index tables are reordered.
+static int gNameCount;
+static int gFactoryCount;
+static uint16_t gSortedByName[MAX_ENTRY_COUNT];
+static uint16_t gSortedByFactory[MAX_ENTRY_COUNT];
+
+// Returns the position in gSortedByName where an entry named name is (or
+// would be inserted). Sets *found if the name is already present.
+static int search_by_name(const char name[], bool* found) {
+    int lo = 0;
+    int hi = gNameCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        int cmp = strcmp(gEntries[gSortedByName[mid]].fName, name);
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else if (cmp > 0) {
+            hi = mid - 1;
+        } else {
+            *found = true;
+            return mid;
+        }
+    }
+    *found = false;
+    return lo;
+}
+
+// The factory-pointer analog of search_by_name.
+static int search_by_factory(SkFlattenable::Factory factory, bool* found) {
+    int lo = 0;
+    int hi = gFactoryCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        SkFlattenable::Factory f = gEntries[gSortedByFactory[mid]].fFactory;
+        if (f < factory) {
+            lo = mid + 1;
+        } else if (factory < f) {
+            hi = mid - 1;
+        } else {
+            *found = true;
+            return mid;
+        }
+    }
+    *found = false;
+    return lo;
+}
+
+static void sorted_insert(uint16_t table[], int count, int pos, uint16_t value) {
+    memmove(table + pos + 1, table + pos, (count - pos) * sizeof(uint16_t));
+    table[pos] = value;
+}
+
 void SkFlattenable::Register(const char name[], Factory factory, SkFlattenable::Type type) {
     SkASSERT(name);
     SkASSERT(factory);
 
     static bool gOnce = false;
     if (!gOnce) {
-        gCount = 0;
+        gCount = gNameCount = gFactoryCount = 0;
         gOnce = true;
     }
 
@@ -74,6 +129,23 @@ void SkFlattenable::Register(const char name[], Factory factory, SkFlattenable::
     gEntries[gCount].fName = name;
     gEntries[gCount].fFactory = factory;
     gEntries[gCount].fType = type;
+
+    // On a duplicate registration the newest entry wins, matching the old
+    // backwards linear scan.
+    bool found;
+    int namePos = search_by_name(name, &found);
+    if (found) {
+        gSortedByName[namePos] = SkToU16(gCount);
+    } else {
+        sorted_insert(gSortedByName, gNameCount++, namePos, SkToU16(gCount));
+    }
+    int factoryPos = search_by_factory(factory, &found);
+    if (found) {
+        gSortedByFactory[factoryPos] = SkToU16(gCount);
+    } else {
+        sorted_insert(gSortedByFactory, gFactoryCount++, factoryPos, SkToU16(gCount));
+    }
+
     gCount += 1;
 }
 
@@ -92,13 +164,9 @@ SkFlattenable::Factory SkFlattenable::NameToFactory(const char name[]) {
 #ifdef SK_DEBUG
     report_no_entries(__FUNCTION__);
 #endif
-    const Entry* entries = gEntries;
-    for (int i = gCount - 1; i >= 0; --i) {
-        if (strcmp(entries[i].fName, name) == 0) {
-            return entries[i].fFactory;
-        }
-    }
-    return NULL;
+    bool found;
+    int pos = search_by_name(name, &found);
+    return found ? gEntries[gSortedByName[pos]].fFactory : NULL;
 }
 
 bool SkFlattenable::NameToType(const char name[], SkFlattenable::Type* type) {
@@ -107,14 +175,12 @@ bool SkFlattenable::NameToType(const char name[], SkFlattenable::Type* type) {
 #ifdef SK_DEBUG
     report_no_entries(__FUNCTION__);
 #endif
-    const Entry* entries = gEntries;
-    for (int i = gCount - 1; i >= 0; --i) {
-        if (strcmp(entries[i].fName, name) == 0) {
-            *type = entries[i].fType;
-            return true;
-        }
+    bool found;
+    int pos = search_by_name(name, &found);
+    if (found) {
+        *type = gEntries[gSortedByName[pos]].fType;
     }
-    return false;
+    return found;
 }
 
 const char* SkFlattenable::FactoryToName(Factory fact) {
@@ -122,11 +188,7 @@ const char* SkFlattenable::FactoryToName(Factory fact) {
 #ifdef SK_DEBUG
     report_no_entries(__FUNCTION__);
 #endif
-    const Entry* entries = gEntries;
-    for (int i = gCount - 1; i >= 0; --i) {
-        if (entries[i].fFactory == fact) {
-            return entries[i].fName;
-        }
-    }
-    return NULL;
+    bool found;
+    int pos = search_by_factory(fact, &found);
+    return found ? gEntries[gSortedByFactory[pos]].fName : NULL;
 }
@@ -8,10 +8,140 @@
 #include "SkFontMgr.h"
 #include "SkLazyPtr.h"
 #include "SkStream.h"
+#include "SkString.h"
+#include "SkTDArray.h"
+#include "SkThread.h"
+#include "SkTypeface.h"
 #include "SkTypes.h"
 
 class SkFontStyle;
-class SkTypeface;
+
+/**
+ *  A small LRU cache of fallback matches, keyed by the character's 256-slot
+ *  unicode block, the requested style, family name, and locale chain. Each
+ *  entry remembers the typefaces the fallback scan returned for that block;
+ *  a later query probes those candidates' cmaps through charsToGlyphs, so
+ *  repeated fallback queries over a run of text skip the port's full chain
+ *  scan entirely. A candidate that does not cover the specific character
+ *  falls through to the scan, whose result is then added to the entry.
+ */
+class SkFontFallbackCache {
+public:
+    SkFontFallbackCache() {}
+
+    ~SkFontFallbackCache() {
+        for (int i = 0; i < fEntries.count(); ++i) {
+            this->deleteEntry(fEntries[i]);
+        }
+    }
+
+    SkTypeface* findAndRef(const char familyName[], const SkFontStyle& style,
+                           const char* bcp47[], int bcp47Count, SkUnichar character) {
+        SkString locale;
+        build_locale_key(bcp47, bcp47Count, &locale);
+        SkAutoMutexAcquire ama(fMutex);
+
+        Entry* entry = this->findEntry(familyName, style, locale, character);
+        if (NULL == entry) {
+            return NULL;
+        }
+        for (int i = 0; i < entry->fCandidates.count(); ++i) {
+            SkTypeface* candidate = entry->fCandidates[i];
+            uint16_t glyph;
+            if (candidate->charsToGlyphs(&character, SkTypeface::kUTF32_Encoding, &glyph, 1)
+                    && glyph) {
+                return SkRef(candidate);
+            }
+        }
+        return NULL;
+    }
+
+    void add(const char familyName[], const SkFontStyle& style,
+             const char* bcp47[], int bcp47Count, SkUnichar character, SkTypeface* face) {
+        SkString locale;
+        build_locale_key(bcp47, bcp47Count, &locale);
+        SkAutoMutexAcquire ama(fMutex);
+
+        Entry* entry = this->findEntry(familyName, style, locale, character);
+        if (NULL == entry) {
+            entry = SkNEW(Entry);
+            entry->fBlock = character >> 8;
+            entry->fStyle = style;
+            entry->fFamilyName.set(familyName);
+            entry->fLocale = locale;
+            *fEntries.insert(0) = entry;
+            if (fEntries.count() > kMaxEntries) {
+                this->deleteEntry(fEntries[fEntries.count() - 1]);
+                fEntries.remove(fEntries.count() - 1);
+            }
+        }
+        for (int i = 0; i < entry->fCandidates.count(); ++i) {
+            if (entry->fCandidates[i] == face) {
+                return;
+            }
+        }
+        *entry->fCandidates.insert(0) = SkRef(face);
+        if (entry->fCandidates.count() > kMaxCandidates) {
+            entry->fCandidates[entry->fCandidates.count() - 1]->unref();
+            entry->fCandidates.remove(entry->fCandidates.count() - 1);
+        }
+    }
+
+private:
+    struct Entry {
+        uint32_t    fBlock;         // character >> 8
+        SkFontStyle fStyle;
+        SkString    fFamilyName;
+        SkString    fLocale;
+        // Most recently matched first; each holds a ref.
+        SkTDArray<SkTypeface*> fCandidates;
+    };
+
+    enum {
+        kMaxEntries = 128,
+        kMaxCandidates = 4,
+    };
+
+    static void build_locale_key(const char* bcp47[], int bcp47Count, SkString* locale) {
+        for (int i = 0; i < bcp47Count; ++i) {
+            if (i > 0) {
+                locale->append(",");
+            }
+            locale->append(bcp47[i]);
+        }
+    }
+
+    // Requires fMutex. Returns the matching entry moved to the front of the
+    // LRU order, or NULL.
+    Entry* findEntry(const char familyName[], const SkFontStyle& style,
+                     const SkString& locale, SkUnichar character) {
+        const uint32_t block = character >> 8;
+        for (int i = 0; i < fEntries.count(); ++i) {
+            Entry* entry = fEntries[i];
+            if (entry->fBlock == block && entry->fStyle == style
+                    && entry->fFamilyName.equals(familyName ? familyName : "")
+                    && entry->fLocale == locale) {
+                if (i > 0) {
+                    fEntries.remove(i);
+                    *fEntries.insert(0) = entry;
+                }
+                return entry;
+            }
+        }
+        return NULL;
+    }
+
+    void deleteEntry(Entry* entry) {
+        for (int i = 0; i < entry->fCandidates.count(); ++i) {
+            entry->fCandidates[i]->unref();
+        }
+        SkDELETE(entry);
+    }
+
+    // Most recently used first.
+    SkTDArray<Entry*> fEntries;
+    SkMutex fMutex;
+};
 
 class SkEmptyFontStyleSet : public SkFontStyleSet {
 public:
@@ -87,6 +217,12 @@ static SkFontStyleSet* emptyOnNull(SkFontStyleSet* fsset) {
     return fsset;
 }
 
+SkFontMgr::SkFontMgr() : fFallbackCache(SkNEW(SkFontFallbackCache)) {}
+
+SkFontMgr::~SkFontMgr() {
+    SkDELETE(fFallbackCache);
+}
+
 int SkFontMgr::countFamilies() const {
     return this->onCountFamilies();
 }
@@ -111,7 +247,15 @@ SkTypeface* SkFontMgr::matchFamilyStyle(const char familyName[],
 SkTypeface* SkFontMgr::matchFamilyStyleCharacter(const char familyName[], const SkFontStyle& style,
                                                  const char* bcp47[], int bcp47Count,
                                                  SkUnichar character) const {
-    return this->onMatchFamilyStyleCharacter(familyName, style, bcp47, bcp47Count, character);
+    SkTypeface* face = fFallbackCache->findAndRef(familyName, style, bcp47, bcp47Count, character);
+    if (face) {
+        return face;
+    }
+    face = this->onMatchFamilyStyleCharacter(familyName, style, bcp47, bcp47Count, character);
+    if (face) {
+        fFallbackCache->add(familyName, style, bcp47, bcp47Count, character, face);
+    }
+    return face;
 }
 
 SkTypeface* SkFontMgr::matchFaceStyle(const SkTypeface* face,
@@ -178,6 +178,36 @@ SkPoint SkEvalQuadAt(const SkPoint src[3], SkScalar t) {
     return to_point((A * t2 + B+B) * t2 + P0);
 }
 
+void SkEvalQuadAts(const SkPoint src[3], const SkScalar ts[], int count, SkPoint pts[]) {
+    SkASSERT(src);
+
+    const Sk2s p0 = from_point(src[0]);
+    const Sk2s p1 = from_point(src[1]);
+    const Sk2s p2 = from_point(src[2]);
+    const Sk2s b = p1 - p0;
+    const Sk2s a = p2 - p1 - b;
+
+    // split the xy coefficients into planar four-lane vectors, so each
+    // iteration evaluates the Horner form at four t values
+    const Sk4s ax(a.kth<0>()),      ay(a.kth<1>());
+    const Sk4s bx(2 * b.kth<0>()),  by(2 * b.kth<1>());
+    const Sk4s cx(p0.kth<0>()),     cy(p0.kth<1>());
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const Sk4s t = Sk4s::Load(&ts[i]);
+        SkScalar xs[4], ys[4];
+        ((ax * t + bx) * t + cx).store(xs);
+        ((ay * t + by) * t + cy).store(ys);
+        for (int j = 0; j < 4; ++j) {
+            pts[i + j].set(xs[j], ys[j]);
+        }
+    }
+    for (; i < count; ++i) {
+        pts[i] = SkEvalQuadAt(src, ts[i]);
+    }
+}
+
 SkVector SkEvalQuadTangentAt(const SkPoint src[3], SkScalar t) {
     SkASSERT(src);
     SkASSERT(t >= 0 && t <= SK_Scalar1);
@@ -407,6 +437,38 @@ void SkEvalCubicAt(const SkPoint src[4], SkScalar t, SkPoint* loc,
     }
 }
 
+void SkEvalCubicAts(const SkPoint src[4], const SkScalar ts[], int count, SkPoint pts[]) {
+    SkASSERT(src);
+
+    const Sk2s p0 = from_point(src[0]);
+    const Sk2s p1 = from_point(src[1]);
+    const Sk2s p2 = from_point(src[2]);
+    const Sk2s p3 = from_point(src[3]);
+    const Sk2s three(3);
+    const Sk2s a = p3 + three * (p1 - p2) - p0;
+    const Sk2s b = three * (p2 - p1 - p1 + p0);
+    const Sk2s c = three * (p1 - p0);
+
+    const Sk4s ax(a.kth<0>()),  ay(a.kth<1>());
+    const Sk4s bx(b.kth<0>()),  by(b.kth<1>());
+    const Sk4s cx(c.kth<0>()),  cy(c.kth<1>());
+    const Sk4s dx(p0.kth<0>()), dy(p0.kth<1>());
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const Sk4s t = Sk4s::Load(&ts[i]);
+        SkScalar xs[4], ys[4];
+        (((ax * t + bx) * t + cx) * t + dx).store(xs);
+        (((ay * t + by) * t + cy) * t + dy).store(ys);
+        for (int j = 0; j < 4; ++j) {
+            pts[i + j].set(xs[j], ys[j]);
+        }
+    }
+    for (; i < count; ++i) {
+        SkEvalCubicAt(src, ts[i], &pts[i], NULL, NULL);
+    }
+}
+
 /** Cubic'(t) = At^2 + Bt + C, where
     A = 3(-a + 3(b - c) + d)
     B = 6(a - 2b + c)
@@ -1237,6 +1299,40 @@ void SkConic::evalAt(SkScalar t, SkPoint* pt, SkVector* tangent) const {
     }
 }
 
+void SkConic::evalAts(const SkScalar ts[], int count, SkPoint pts[]) const {
+    const Sk2s p0 = from_point(fPts[0]);
+    const Sk2s p1 = from_point(fPts[1]);
+    const Sk2s p2 = from_point(fPts[2]);
+    const Sk2s ww(fW + fW);
+
+    // numerator:   (P0 - 2wP1 + P2) t^2 + 2(wP1 - P0) t + P0
+    // denominator: (2 - 2w) t^2 + (2w - 2) t + 1
+    const Sk2s na = p0 - ww * p1 + p2;
+    const Sk2s nb = ww * p1 - p0 - p0;
+
+    const Sk4s nax(na.kth<0>()),  nay(na.kth<1>());
+    const Sk4s nbx(nb.kth<0>()),  nby(nb.kth<1>());
+    const Sk4s ncx(p0.kth<0>()),  ncy(p0.kth<1>());
+    const Sk4s da(2 - fW - fW);
+    const Sk4s db(fW + fW - 2);
+    const Sk4s dc(1);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const Sk4s t = Sk4s::Load(&ts[i]);
+        const Sk4s d = (da * t + db) * t + dc;
+        SkScalar xs[4], ys[4];
+        (((nax * t + nbx) * t + ncx) / d).store(xs);
+        (((nay * t + nby) * t + ncy) / d).store(ys);
+        for (int j = 0; j < 4; ++j) {
+            pts[i + j].set(xs[j], ys[j]);
+        }
+    }
+    for (; i < count; ++i) {
+        pts[i] = this->evalAt(ts[i]);
+    }
+}
+
 void SkConic::chopAt(SkScalar t, SkConic dst[2]) const {
     SkP3D tmp[3], tmp2[3];
 
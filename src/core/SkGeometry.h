@@ -41,6 +41,11 @@ SkPoint SkEvalQuadTangentAt(const SkPoint src[3], SkScalar t);
 */
 void SkEvalQuadAt(const SkPoint src[3], SkScalar t, SkPoint* pt, SkVector* tangent = NULL);
 
+/** Evaluate the quad at all of the given t values, four lanes at a time.
+    Flattening loops should prefer this over point-at-a-time SkEvalQuadAt.
+*/
+void SkEvalQuadAts(const SkPoint src[3], const SkScalar ts[], int count, SkPoint pts[]);
+
 /**
  *  output is : eval(t) == coeff[0] * t^2 + coeff[1] * t + coeff[2]
  */
@@ -110,6 +115,11 @@ SK_API void SkConvertQuadToCubic(const SkPoint src[3], SkPoint dst[4]);
 void SkEvalCubicAt(const SkPoint src[4], SkScalar t, SkPoint* locOrNull,
                    SkVector* tangentOrNull, SkVector* curvatureOrNull);
 
+/** Evaluate the cubic's position at all of the given t values, four lanes
+    at a time.
+*/
+void SkEvalCubicAts(const SkPoint src[4], const SkScalar ts[], int count, SkPoint pts[]);
+
 /** Given a src cubic bezier, chop it at the specified t value,
     where 0 < t < 1, and return the two new cubics in dst:
     dst[0..3] and dst[3..6]
@@ -244,6 +254,11 @@ struct SkConic {
     void chop(SkConic dst[2]) const;
 
     SkPoint evalAt(SkScalar t) const;
+
+    /** Evaluate the conic's position at all of the given t values, four
+        lanes at a time.
+    */
+    void evalAts(const SkScalar ts[], int count, SkPoint pts[]) const;
     SkVector evalTangentAt(SkScalar t) const;
 
     void computeAsQuadError(SkVector* err) const;
@@ -47,6 +47,12 @@ class SkGlyph {
     int8_t      fRsbDelta, fLsbDelta;  // used by auto-kerning
     int8_t      fForceBW;
 
+    // If non-NULL, the image is held RLE-packed (see SkPackBits) and fImage
+    // stays NULL; SkGlyphCache::findImage() unpacks it on demand. Managed
+    // entirely by SkGlyphCache.
+    void*       fPackedImage;
+    uint32_t    fPackedImageSize;
+
     void initWithGlyphID(uint32_t glyph_id) {
         this->initCommon(MakeID(glyph_id));
     }
@@ -124,6 +130,8 @@ class SkGlyph {
         fPath           = NULL;
         fMaskFormat     = MASK_FORMAT_UNKNOWN;
         fForceBW        = 0;
+        fPackedImage    = NULL;
+        fPackedImageSize = 0;
     }
 
     static unsigned ID2Code(uint32_t id) {
@@ -5,22 +5,57 @@
  * found in the LICENSE file.
  */
 
+#include "SkAtomics.h"
 #include "SkGlyphCache.h"
 #include "SkGlyphCache_Globals.h"
 #include "SkGraphics.h"
 #include "SkLazyPtr.h"
+#include "SkPackBits.h"
 #include "SkPaint.h"
 #include "SkPath.h"
+#include "SkRTConf.h"
+#include "SkReader32.h"
+#include "SkStream.h"
+#include "SkTSort.h"
 #include "SkTemplates.h"
 #include "SkTLS.h"
 #include "SkTypeface.h"
+#include "SkWriter32.h"
 
 //#define SPEW_PURGE_STATUS
 
+SK_CONF_DECLARE(int, c_fontCacheMB, "cache.fontCacheMB", 0,
+                "Font cache byte budget in megabytes; 0 keeps the compiled-in default");
+SK_CONF_DECLARE(int, c_fontCacheCount, "cache.fontCacheCount", 0,
+                "Font cache strike count limit; 0 keeps the compiled-in default");
+
 namespace {
 
+void apply_font_cache_mb(const int& mb, void* context) {
+    if (mb > 0) {
+        ((SkGlyphCache_Globals*)context)->setCacheSizeLimit((size_t)mb << 20);
+    }
+}
+
+void apply_font_cache_count(const int& count, void* context) {
+    if (count > 0) {
+        ((SkGlyphCache_Globals*)context)->setCacheCountLimit(count);
+    }
+}
+
 SkGlyphCache_Globals* create_globals() {
-    return SkNEW_ARGS(SkGlyphCache_Globals, (SkGlyphCache_Globals::kYes_UseMutex));
+    SkGlyphCache_Globals* globals =
+            SkNEW_ARGS(SkGlyphCache_Globals, (SkGlyphCache_Globals::kYes_UseMutex));
+    if (c_fontCacheMB > 0) {
+        globals->setCacheSizeLimit((size_t)c_fontCacheMB << 20);
+    }
+    if (c_fontCacheCount > 0) {
+        globals->setCacheCountLimit(c_fontCacheCount);
+    }
+    // Later SK_CONF_SET() calls keep applying to the shared globals.
+    SK_CONF_SET_CHANGE_PROC(c_fontCacheMB, apply_font_cache_mb, globals);
+    SK_CONF_SET_CHANGE_PROC(c_fontCacheCount, apply_font_cache_count, globals);
+    return globals;
 }
 
 }  // namespace
@@ -38,6 +73,100 @@ static SkGlyphCache_Globals& getGlobals() {
     return tls ? *tls : getSharedGlobals();
 }
 
+// Strike-level hit/miss counts for VisitCache(), reported through
+// SkGraphics::GetCacheStats(). Atomics, because the pinned fast path in
+// VisitCache() runs without any lock held.
+static int32_t gStrikeCacheHits;
+static int32_t gStrikeCacheMisses;
+
+uint32_t SkGlyphCache::GetStrikeCacheHitCount() {
+    return (uint32_t)sk_atomic_load(&gStrikeCacheHits);
+}
+
+uint32_t SkGlyphCache::GetStrikeCacheMissCount() {
+    return (uint32_t)sk_atomic_load(&gStrikeCacheMisses);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Per-thread strike pins.
+//
+// VisitCache() costs two acquisitions of the global strike mutex per use (one
+// to find and detach the strike, one to reattach it), and multithreaded
+// text-heavy work contends hard on that lock.  Instead of returning a strike
+// to the global list the moment a thread is done with it, we pin a few
+// recently used strikes in thread-local slots; the next VisitCache() for the
+// same descriptor on that thread takes the strike straight from its pin
+// without any locking at all.
+//
+// As far as the globals are concerned a pinned strike is just a detached
+// strike (not in the list, not counted against the budget), which the design
+// already tolerates -- see DetachCache()'s comment about duplicate strikes.
+// Pins flow back to the global list when a slot is recycled for a different
+// descriptor and when the thread exits.  Threads using a TLS cache (see
+// SkGraphics::SetTLSFontCacheLimit) never contend, so they don't use pins.
+
+namespace {
+
+struct StrikePins {
+    enum { kSlotCount = 2 };
+    SkGlyphCache* fSlot[kSlotCount];  // most recently pinned first
+
+    // If a pinned strike matches desc, hand it to the caller (who now owns it).
+    SkGlyphCache* takeMatch(const SkDescriptor& desc) {
+        for (int i = 0; i < kSlotCount; ++i) {
+            if (fSlot[i] && fSlot[i]->getDescriptor().equals(desc)) {
+                SkGlyphCache* cache = fSlot[i];
+                fSlot[i] = NULL;
+                return cache;
+            }
+        }
+        return NULL;
+    }
+
+    // Pin cache, taking ownership.  Returns the strike evicted to make room,
+    // or NULL if a slot was free.
+    SkGlyphCache* pin(SkGlyphCache* cache) {
+        int open = kSlotCount - 1;
+        SkGlyphCache* evicted = fSlot[open];
+        for (int i = 0; i < kSlotCount; ++i) {
+            if (NULL == fSlot[i]) {
+                open = i;
+                evicted = NULL;
+                break;
+            }
+        }
+        for (int i = open; i > 0; --i) {
+            fSlot[i] = fSlot[i - 1];
+        }
+        fSlot[0] = cache;
+        return evicted;
+    }
+
+    static StrikePins* Get() { return (StrikePins*)SkTLS::Get(Create, Delete); }
+
+private:
+    static void* Create() {
+        StrikePins* pins = SkNEW(StrikePins);
+        sk_bzero(pins->fSlot, sizeof(pins->fSlot));
+        return pins;
+    }
+
+    static void Delete(void* ptr) {
+        StrikePins* pins = (StrikePins*)ptr;
+        // The thread is going away; hand surviving pins back so their cached
+        // glyphs aren't lost.
+        for (int i = 0; i < kSlotCount; ++i) {
+            if (pins->fSlot[i]) {
+                getSharedGlobals().attachCacheToHead(pins->fSlot[i]);
+            }
+        }
+        SkDELETE(pins);
+    }
+};
+
+}  // namespace
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef SK_GLYPHCACHE_TRACK_HASH_STATS
@@ -57,7 +186,7 @@ static SkGlyphCache_Globals& getGlobals() {
 #define kMinAllocAmount     ((sizeof(SkGlyph) + kMinGlyphImageSize) * kMinGlyphCount)
 
 SkGlyphCache::SkGlyphCache(SkTypeface* typeface, const SkDescriptor* desc, SkScalerContext* ctx)
-        : fScalerContext(ctx), fGlyphAlloc(kMinAllocAmount) {
+        : fScalerContext(ctx), fGlyphAlloc(kMinAllocAmount), fImageScratchSize(0) {
     SkASSERT(typeface);
     SkASSERT(desc);
     SkASSERT(ctx);
@@ -191,10 +320,69 @@ const SkGlyph& SkGlyphCache::getUnicharAdvance(SkUnichar charCode) {
 
 const SkGlyph& SkGlyphCache::getGlyphIDAdvance(uint16_t glyphID) {
     VALIDATE();
+    if (fScalerContext->getRec().fFlags & SkScalerContext::kAdvancesOnlyMetrics_Flag) {
+        return *this->lookupAdvanceOnly(glyphID);
+    }
     uint32_t id = SkGlyph::MakeID(glyphID);
     return *this->lookupByCombinedID(id, kJustAdvance_MetricsType);
 }
 
+void SkGlyphCache::getGlyphIDAdvances(const uint16_t glyphIDs[], int count, bool vertical,
+                                      SkScalar advances[]) {
+    VALIDATE();
+    if (fScalerContext->getRec().fFlags & SkScalerContext::kAdvancesOnlyMetrics_Flag) {
+        for (int i = 0; i < count; ++i) {
+            const SkGlyph* glyph = this->lookupAdvanceOnly(glyphIDs[i]);
+            advances[i] = SkFixedToScalar(vertical ? glyph->fAdvanceY : glyph->fAdvanceX);
+        }
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        const SkGlyph* glyph = this->lookupByCombinedID(SkGlyph::MakeID(glyphIDs[i]),
+                                                        kJustAdvance_MetricsType);
+        advances[i] = SkFixedToScalar(vertical ? glyph->fAdvanceY : glyph->fAdvanceX);
+    }
+}
+
+const SkGlyph* SkGlyphCache::lookupAdvanceOnly(uint16_t glyphID) {
+    unsigned glyphCount = fScalerContext->getGlyphCount();
+    if (glyphID >= glyphCount) {
+        // out-of-range ids take the usual path, which zero-fills a record
+        return this->lookupByCombinedID(SkGlyph::MakeID(glyphID), kJustAdvance_MetricsType);
+    }
+
+    if (NULL == fAdvanceCache.get()) {
+        int blockCount = (glyphCount + kAdvanceBlockSize - 1) / kAdvanceBlockSize;
+        fAdvanceCache.reset(2 * glyphCount);
+        fAdvanceValid.reset(blockCount);
+        sk_bzero(fAdvanceValid.get(), blockCount);
+        fMemoryUsed += 2 * glyphCount * sizeof(SkFixed) + blockCount;
+    }
+
+    int block = glyphID / kAdvanceBlockSize;
+    if (!fAdvanceValid[block]) {
+        uint16_t first = block * kAdvanceBlockSize;
+        int n = SkMin32(kAdvanceBlockSize, glyphCount - first);
+        SkFixed advancesX[kAdvanceBlockSize];
+        SkFixed advancesY[kAdvanceBlockSize];
+        fScalerContext->getAdvanceBatch(first, n, advancesX, advancesY);
+        for (int i = 0; i < n; ++i) {
+            fAdvanceCache[2 * (first + i)] = advancesX[i];
+            fAdvanceCache[2 * (first + i) + 1] = advancesY[i];
+        }
+        fAdvanceValid[block] = true;
+    }
+
+    fAdvanceScratch.initWithGlyphID(glyphID);
+    fAdvanceScratch.fMaskFormat = MASK_FORMAT_JUST_ADVANCE;
+    fAdvanceScratch.fWidth = fAdvanceScratch.fHeight = 0;
+    fAdvanceScratch.fTop = fAdvanceScratch.fLeft = 0;
+    fAdvanceScratch.fRsbDelta = fAdvanceScratch.fLsbDelta = 0;
+    fAdvanceScratch.fAdvanceX = fAdvanceCache[2 * glyphID];
+    fAdvanceScratch.fAdvanceY = fAdvanceCache[2 * glyphID + 1];
+    return &fAdvanceScratch;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 const SkGlyph& SkGlyphCache::getUnicharMetrics(SkUnichar charCode) {
@@ -261,7 +449,7 @@ SkGlyph* SkGlyphCache::lookupByCombinedID(uint32_t id, MetricsType type) {
     return glyph;
 }
 
-uint16_t SkGlyphCache::lookupMetrics(uint32_t id, MetricsType mtype) {
+uint16_t SkGlyphCache::findOrInsertGlyph(uint32_t id, bool* wasInserted) {
     SkASSERT(id != SkGlyph::kImpossibleID);
     // Count is always greater than 0 because of the sentinel.
     // The fGlyphArray cache is in descending order, so that the sentinel with a value of ~0 is
@@ -281,10 +469,7 @@ uint16_t SkGlyphCache::lookupMetrics(uint32_t id, MetricsType mtype) {
     uint16_t glyph_index = hi;
     SkGlyph* glyph = &gptr[glyph_index];
     if (glyph->fID == id) {
-        if (kFull_MetricsType == mtype && glyph->isJustAdvance()) {
-            fScalerContext->getMetrics(glyph);
-        }
-        SkASSERT(glyph->fID != SkGlyph::kImpossibleID);
+        *wasInserted = false;
         return glyph_index;
     }
 
@@ -300,11 +485,18 @@ uint16_t SkGlyphCache::lookupMetrics(uint32_t id, MetricsType mtype) {
 
     glyph = fGlyphArray.insert(glyph_index);
     glyph->initGlyphFromCombinedID(id);
+    *wasInserted = true;
+    return glyph_index;
+}
+
+uint16_t SkGlyphCache::lookupMetrics(uint32_t id, MetricsType mtype) {
+    bool wasInserted;
+    uint16_t glyph_index = this->findOrInsertGlyph(id, &wasInserted);
+    SkGlyph* glyph = &fGlyphArray[glyph_index];
 
-    if (kJustAdvance_MetricsType == mtype) {
+    if (wasInserted && kJustAdvance_MetricsType == mtype) {
         fScalerContext->getAdvance(glyph);
-    } else {
-        SkASSERT(kFull_MetricsType == mtype);
+    } else if (wasInserted || (kFull_MetricsType == mtype && glyph->isJustAdvance())) {
         fScalerContext->getMetrics(glyph);
     }
 
@@ -312,19 +504,172 @@ uint16_t SkGlyphCache::lookupMetrics(uint32_t id, MetricsType mtype) {
     return glyph_index;
 }
 
+void SkGlyphCache::populateGlyphIDRun(const uint16_t glyphIDs[], int count,
+                                      const SkGlyph* results[]) {
+    VALIDATE();
+
+    SkAutoSTMalloc<64, uint16_t> indexStorage(count);
+    uint16_t* indices = indexStorage.get();
+
+    // First find or insert every glyph in the run, deferring generation so
+    // the scaler context can be visited once for the whole run. Note that an
+    // insertion shifts the indices of the glyphs after it, including any we
+    // have already recorded.
+    for (int i = 0; i < count; ++i) {
+        uint32_t id = SkGlyph::MakeID(glyphIDs[i]);
+        bool wasInserted;
+        uint16_t glyph_index = this->findOrInsertGlyph(id, &wasInserted);
+        if (wasInserted) {
+            for (int j = 0; j < i; ++j) {
+                if (indices[j] >= glyph_index) {
+                    indices[j] += 1;
+                }
+            }
+        }
+        indices[i] = glyph_index;
+        fGlyphHash[ID2HashIndex(id)] = glyph_index;
+    }
+
+    // Generate metrics for every glyph that needs them, in one batch. A glyph
+    // repeated within the run is batched only on its first appearance.
+    SkAutoSTMalloc<64, SkGlyph*> pendingStorage(count);
+    SkGlyph** pending = pendingStorage.get();
+    int pendingCount = 0;
+    for (int i = 0; i < count; ++i) {
+        SkGlyph* glyph = &fGlyphArray[indices[i]];
+        if (glyph->isJustAdvance()) {
+            bool alreadyPending = false;
+            for (int j = 0; j < pendingCount; ++j) {
+                if (pending[j] == glyph) {
+                    alreadyPending = true;
+                    break;
+                }
+            }
+            if (!alreadyPending) {
+                pending[pendingCount++] = glyph;
+            }
+        }
+    }
+    if (pendingCount > 0) {
+        fScalerContext->getMetricsBatch(pending, pendingCount);
+    }
+
+    // Generate the images, again in one batch. They are generated into one
+    // contiguous temporary block so that each can be stored packed afterwards
+    // (see tryPackImage); getImageBatch writes through fImage, so each
+    // glyph's fImage temporarily points into the block.
+    pendingCount = 0;
+    size_t totalImageSize = 0;
+    for (int i = 0; i < count; ++i) {
+        SkGlyph* glyph = &fGlyphArray[indices[i]];
+        if (results) {
+            results[i] = glyph;
+        }
+        if (glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth
+                && NULL == glyph->fImage && NULL == glyph->fPackedImage) {
+            bool alreadyPending = false;
+            for (int j = 0; j < pendingCount; ++j) {
+                if (pending[j] == glyph) {
+                    alreadyPending = true;
+                    break;
+                }
+            }
+            if (!alreadyPending) {
+                pending[pendingCount++] = glyph;
+                totalImageSize += glyph->computeImageSize();
+            }
+        }
+    }
+    if (pendingCount > 0) {
+        SkAutoMalloc imageStorage(totalImageSize);
+        uint8_t* block = (uint8_t*)imageStorage.get();
+        for (int i = 0; i < pendingCount; ++i) {
+            pending[i]->fImage = block;
+            block += pending[i]->computeImageSize();
+        }
+        fScalerContext->getImageBatch(const_cast<const SkGlyph**>(pending), pendingCount);
+        for (int i = 0; i < pendingCount; ++i) {
+            SkGlyph* glyph = pending[i];
+            const void* raw = glyph->fImage;
+            glyph->fImage = NULL;
+            // recompute in case the scaler changed the maskformat
+            size_t size = glyph->computeImageSize();
+            if (this->tryPackImage(glyph, raw, size)) {
+                continue;
+            }
+            glyph->fImage = fGlyphAlloc.alloc(size, SkChunkAlloc::kReturnNil_AllocFailType);
+            if (glyph->fImage) {
+                memcpy(glyph->fImage, raw, size);
+                fMemoryUsed += size;
+            }
+        }
+    }
+}
+
+void* SkGlyphCache::imageScratch(size_t size) {
+    if (size > fImageScratchSize) {
+        fMemoryUsed += size - fImageScratchSize;
+        fImageScratchSize = size;
+        fImageScratch.reset(size);
+    }
+    return fImageScratch.get();
+}
+
+bool SkGlyphCache::tryPackImage(SkGlyph* glyph, const void* raw, size_t rawSize) {
+    // Only A8 images are packed: they dominate the cache (text is mostly AA),
+    // and their rows are long runs of 0x00/0xFF that pack well. BW is already
+    // a bit per pixel, and unpacking LCD16/ARGB as bytes rarely wins.
+    if (SkMask::kA8_Format != glyph->fMaskFormat || 0 == rawSize) {
+        return false;
+    }
+
+    SkAutoMalloc packStorage(SkPackBits::ComputeMaxSize8(SkToInt(rawSize)));
+    size_t packedSize = SkPackBits::Pack8((const uint8_t*)raw, SkToInt(rawSize),
+                                          (uint8_t*)packStorage.get());
+    if (packedSize >= rawSize) {
+        return false;
+    }
+
+    void* packed = fGlyphAlloc.alloc(packedSize, SkChunkAlloc::kReturnNil_AllocFailType);
+    if (NULL == packed) {
+        return false;
+    }
+    memcpy(packed, packStorage.get(), packedSize);
+    glyph->fPackedImage = packed;
+    glyph->fPackedImageSize = SkToU32(packedSize);
+    fMemoryUsed += packedSize;
+    return true;
+}
+
 const void* SkGlyphCache::findImage(const SkGlyph& glyph) {
     if (glyph.fWidth > 0 && glyph.fWidth < kMaxGlyphWidth) {
+        SkGlyph* writable = const_cast<SkGlyph*>(&glyph);
+        if (glyph.fPackedImage) {
+            // Unpack at blit time; only the packed copy stays resident, so the
+            // same cache budget holds roughly twice the glyphs.
+            void* scratch = this->imageScratch(glyph.computeImageSize());
+            SkPackBits::Unpack8((const uint8_t*)glyph.fPackedImage,
+                                glyph.fPackedImageSize, (uint8_t*)scratch);
+            return scratch;
+        }
         if (NULL == glyph.fImage) {
-            size_t  size = glyph.computeImageSize();
-            const_cast<SkGlyph&>(glyph).fImage = fGlyphAlloc.alloc(size,
+            // Generate into the scratch first, so the image can be stored
+            // packed when that wins.
+            void* scratch = this->imageScratch(glyph.computeImageSize());
+            writable->fImage = scratch;
+            fScalerContext->getImage(glyph);
+            writable->fImage = NULL;
+            // the scaler may have changed the maskformat during getImage
+            // (e.g. from AA or LCD to BW), so recompute the size it wrote
+            size_t size = glyph.computeImageSize();
+            if (this->tryPackImage(writable, scratch, size)) {
+                return scratch;
+            }
+            writable->fImage = fGlyphAlloc.alloc(size,
                                         SkChunkAlloc::kReturnNil_AllocFailType);
             // check that alloc() actually succeeded
             if (glyph.fImage) {
-                fScalerContext->getImage(glyph);
-                // TODO: the scaler may have changed the maskformat during
-                // getImage (e.g. from AA or LCD to BW) which means we may have
-                // overallocated the buffer. Check if the new computedImageSize
-                // is smaller, and if so, strink the alloc size in fImageAlloc.
+                memcpy(writable->fImage, scratch, size);
                 fMemoryUsed += size;
             }
         }
@@ -466,6 +811,22 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
     }
     SkASSERT(desc);
 
+    // Fast path: a strike this thread has pinned needs no locking at all.
+    StrikePins* pins = SkGlyphCache_Globals::FindTLS() ? NULL : StrikePins::Get();
+    if (pins) {
+        SkGlyphCache* pinned = pins->takeMatch(*desc);
+        if (pinned) {
+            sk_atomic_inc(&gStrikeCacheHits);
+            AutoValidate av(pinned);
+            if (!proc(pinned, context)) {
+                // Still ours; the slot we just emptied is free to re-pin it.
+                SkAssertResult(NULL == pins->pin(pinned));
+                pinned = NULL;
+            }
+            return pinned;
+        }
+    }
+
     SkGlyphCache_Globals& globals = getGlobals();
     SkAutoMutexAcquire    ac(globals.fMutex);
     SkGlyphCache*         cache;
@@ -475,10 +836,12 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
 
     for (cache = globals.internalGetHead(); cache != NULL; cache = cache->fNext) {
         if (cache->fDesc->equals(*desc)) {
+            sk_atomic_inc(&gStrikeCacheHits);
             globals.internalDetachCache(cache);
             goto FOUND_IT;
         }
     }
+    sk_atomic_inc(&gStrikeCacheMisses);
 
     /* Release the mutex now, before we create a new entry (which might have
         side-effects like trying to access the cache/mutex (yikes!)
@@ -520,6 +883,15 @@ void SkGlyphCache::AttachCache(SkGlyphCache* cache) {
     SkASSERT(cache);
     SkASSERT(cache->fNext == NULL);
 
+    if (NULL == SkGlyphCache_Globals::FindTLS()) {
+        // Keep the strike pinned to this thread; only an evicted pin goes back
+        // to the global list (and takes the global lock).
+        cache = StrikePins::Get()->pin(cache);
+        if (NULL == cache) {
+            return;
+        }
+    }
+
     getGlobals().attachCacheToHead(cache);
 }
 
@@ -552,6 +924,290 @@ void SkGlyphCache::Dump() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static const uint32_t kStrikeSnapshotMagic = SkSetFourByteTag('s', 'g', 'c', '1');
+
+// Checksum over the head of the typeface's font data, so a persisted snapshot
+// is rejected when the installed font changes across process starts.
+static uint32_t compute_typeface_checksum(SkTypeface* face) {
+    int ttcIndex;
+    SkAutoTDelete<SkStreamAsset> stream(face->openStream(&ttcIndex));
+    if (NULL == stream.get()) {
+        return 0;
+    }
+    uint32_t buffer[256];
+    size_t bytes = stream->read(buffer, sizeof(buffer));
+    return SkChecksum::Murmur3(buffer, bytes);
+}
+
+SkData* SkGlyphCache::SnapshotStrike(SkTypeface* typeface, const SkDescriptor* desc) {
+    SkASSERT(desc);
+    if (!typeface) {
+        typeface = SkTypeface::GetDefaultTypeface();
+    }
+
+    SkDynamicMemoryWStream faceStream;
+    typeface->serialize(&faceStream);
+    SkAutoTUnref<SkData> faceData(faceStream.copyToData());
+
+    SkWriter32 writer;
+    writer.write32(kStrikeSnapshotMagic);
+    writer.write32(compute_typeface_checksum(typeface));
+    writer.write32(SkToU32(faceData->size()));
+    writer.writePad(faceData->data(), faceData->size());
+    writer.write32(desc->getLength());
+    writer.writePad(desc, desc->getLength());
+
+    SkGlyphCache* cache = SkGlyphCache::DetachCache(typeface, desc);
+
+    // Everything but the sentinel at index 0.
+    writer.write32(cache->fGlyphArray.count() - 1);
+    for (int i = 0; i < cache->fGlyphArray.count(); ++i) {
+        const SkGlyph& glyph = cache->fGlyphArray[i];
+        if (SkGlyph::kImpossibleID == glyph.fID) {
+            continue;
+        }
+        // Serialize the raw image bytes, but only if the image has already
+        // been generated; findImage() unpacks an RLE-stored image for us.
+        const void* image = NULL;
+        size_t imageSize = 0;
+        if (glyph.fImage || glyph.fPackedImage) {
+            image = cache->findImage(glyph);
+            if (image) {
+                imageSize = glyph.computeImageSize();
+            }
+        }
+        writer.write32(glyph.fID);
+        writer.write32(glyph.fAdvanceX);
+        writer.write32(glyph.fAdvanceY);
+        writer.write32((glyph.fWidth << 16) | glyph.fHeight);
+        writer.write32(((uint16_t)glyph.fTop << 16) | (uint16_t)glyph.fLeft);
+        writer.write32((glyph.fMaskFormat << 24) | ((uint8_t)glyph.fRsbDelta << 16) |
+                       ((uint8_t)glyph.fLsbDelta << 8) | (uint8_t)glyph.fForceBW);
+        writer.write32(SkToU32(imageSize));
+        if (imageSize) {
+            writer.writePad(image, imageSize);
+        }
+    }
+
+    SkGlyphCache::AttachCache(cache);
+    return writer.snapshotAsData();
+}
+
+bool SkGlyphCache::LoadStrikeSnapshot(const void* data, size_t length) {
+    SkReader32 reader(data, length);
+    if (!reader.isAvailable(3 * sizeof(uint32_t)) || kStrikeSnapshotMagic != reader.readU32()) {
+        return false;
+    }
+    const uint32_t fontChecksum = reader.readU32();
+    const uint32_t faceSize = reader.readU32();
+    if (!reader.isAvailable(SkAlign4(faceSize))) {
+        return false;
+    }
+    SkMemoryStream faceStream(reader.skip(faceSize), faceSize, false);
+    SkAutoTUnref<SkTypeface> face(SkTypeface::Deserialize(&faceStream));
+    if (NULL == face.get() || compute_typeface_checksum(face) != fontChecksum) {
+        return false;
+    }
+
+    if (!reader.isAvailable(sizeof(uint32_t))) {
+        return false;
+    }
+    const uint32_t descLength = reader.readU32();
+    if (descLength < sizeof(SkDescriptor) || SkAlign4(descLength) != descLength ||
+            !reader.isAvailable(descLength)) {
+        return false;
+    }
+    SkAutoDescriptor ad(descLength);
+    SkDescriptor* desc = ad.getDesc();
+    memcpy(desc, reader.skip(descLength), descLength);
+    if (desc->getLength() != descLength) {
+        return false;
+    }
+    // The rec's fontID was only meaningful in the process that wrote the
+    // snapshot; rebind it to the typeface we just resolved.
+    SkScalerContextRec* rec =
+            (SkScalerContextRec*)desc->findEntry(kRec_SkDescriptorTag, NULL);
+    if (NULL == rec) {
+        return false;
+    }
+    rec->fFontID = face->uniqueID();
+    desc->computeChecksum();
+
+    if (!reader.isAvailable(sizeof(uint32_t))) {
+        return false;
+    }
+    const uint32_t glyphCount = reader.readU32();
+
+    SkGlyphCache* cache = SkGlyphCache::DetachCache(face, desc);
+    bool ok = true;
+    for (uint32_t i = 0; i < glyphCount; ++i) {
+        if (!reader.isAvailable(7 * sizeof(uint32_t))) {
+            ok = false;
+            break;
+        }
+        const uint32_t id = reader.readU32();
+        const SkFixed advanceX = reader.readS32();
+        const SkFixed advanceY = reader.readS32();
+        const uint32_t dims = reader.readU32();
+        const uint32_t pos = reader.readU32();
+        const uint32_t bits = reader.readU32();
+        const uint32_t imageSize = reader.readU32();
+        if (!reader.isAvailable(SkAlign4(imageSize))) {
+            ok = false;
+            break;
+        }
+        const void* image = imageSize ? reader.skip(imageSize) : NULL;
+        if (SkGlyph::kImpossibleID == id) {
+            ok = false;
+            break;
+        }
+
+        bool wasInserted;
+        uint16_t glyph_index = cache->findOrInsertGlyph(id, &wasInserted);
+        SkGlyph* glyph = &cache->fGlyphArray[glyph_index];
+        if (!wasInserted) {
+            // Already generated in this process; trust the live data.
+            continue;
+        }
+        glyph->fAdvanceX = advanceX;
+        glyph->fAdvanceY = advanceY;
+        glyph->fWidth = dims >> 16;
+        glyph->fHeight = dims & 0xFFFF;
+        glyph->fTop = (int16_t)(pos >> 16);
+        glyph->fLeft = (int16_t)(pos & 0xFFFF);
+        glyph->fMaskFormat = bits >> 24;
+        glyph->fRsbDelta = (int8_t)(bits >> 16);
+        glyph->fLsbDelta = (int8_t)(bits >> 8);
+        glyph->fForceBW = (int8_t)bits;
+        if (image && glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth &&
+                imageSize == glyph->computeImageSize()) {
+            if (!cache->tryPackImage(glyph, image, imageSize)) {
+                glyph->fImage = cache->fGlyphAlloc.alloc(imageSize,
+                                        SkChunkAlloc::kReturnNil_AllocFailType);
+                if (glyph->fImage) {
+                    memcpy(glyph->fImage, image, imageSize);
+                    cache->fMemoryUsed += imageSize;
+                }
+            }
+        }
+    }
+    SkGlyphCache::AttachCache(cache);
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkGlyphCache::StrikeSnapshot::StrikeSnapshot(const SkDescriptor& desc)
+    : fDesc(desc.copy())
+    , fImageAlloc(kMinAllocAmount) {}
+
+SkGlyphCache::StrikeSnapshot::~StrikeSnapshot() {
+    SkDescriptor::Free(fDesc);
+}
+
+const SkGlyph* SkGlyphCache::StrikeSnapshot::findGlyph(uint16_t glyphID, SkFixed x,
+                                                       SkFixed y) const {
+    const uint32_t id = SkGlyph::MakeID(glyphID, x, y);
+
+    // fGlyphs is in descending fID order, matching the strike's fGlyphArray
+    // (minus its sentinel), so reuse findOrInsertGlyph's search.
+    const SkGlyph* gptr = fGlyphs.begin();
+    int lo = 0;
+    int hi = fGlyphs.count() - 1;
+    while (lo < hi) {
+        int mid = (hi + lo) >> 1;
+        if (gptr[mid].fID > id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (hi >= 0 && gptr[hi].fID == id) {
+        return &gptr[hi];
+    }
+
+    SkAutoMutexAcquire ama(fMissMutex);
+    *fMisses.append() = id;
+    return NULL;
+}
+
+int SkGlyphCache::StrikeSnapshot::missCount() const {
+    SkAutoMutexAcquire ama(fMissMutex);
+    return fMisses.count();
+}
+
+SkGlyphCache::StrikeSnapshot* SkGlyphCache::TakeStrikeSnapshot(SkTypeface* typeface,
+                                                               const SkDescriptor* desc) {
+    SkGlyphCache* cache = SkGlyphCache::DetachCache(typeface, desc);
+
+    StrikeSnapshot* snapshot = SkNEW_ARGS(StrikeSnapshot, (*cache->fDesc));
+    snapshot->fFontMetrics = cache->fFontMetrics;
+    snapshot->fMaskFormat = cache->getMaskFormat();
+    snapshot->fIsSubpixel = cache->isSubpixel();
+
+    snapshot->fGlyphs.setReserve(cache->fGlyphArray.count());
+    for (int i = 0; i < cache->fGlyphArray.count(); ++i) {
+        const SkGlyph& glyph = cache->fGlyphArray[i];
+        if (SkGlyph::kImpossibleID == glyph.fID || glyph.isJustAdvance()) {
+            continue;
+        }
+        const void* image = NULL;
+        if (glyph.fWidth > 0 && glyph.fWidth < kMaxGlyphWidth) {
+            if (NULL == glyph.fImage && NULL == glyph.fPackedImage) {
+                // Never generated; keep it out of the snapshot so it reads as
+                // a miss rather than as a glyph with no image.
+                continue;
+            }
+            image = cache->findImage(glyph);
+            if (NULL == image) {
+                continue;
+            }
+        }
+        SkGlyph* copy = snapshot->fGlyphs.append();
+        *copy = glyph;
+        copy->fPath = NULL;
+        copy->fPackedImage = NULL;
+        copy->fPackedImageSize = 0;
+        copy->fImage = NULL;
+        if (image) {
+            size_t size = glyph.computeImageSize();
+            copy->fImage = snapshot->fImageAlloc.alloc(size,
+                                   SkChunkAlloc::kThrow_AllocFailType);
+            memcpy(copy->fImage, image, size);
+        }
+    }
+
+    SkGlyphCache::AttachCache(cache);
+    return snapshot;
+}
+
+int SkGlyphCache::FillStrikeSnapshotMisses(SkTypeface* typeface, StrikeSnapshot* snapshot) {
+    SkTDArray<uint32_t> misses;
+    {
+        SkAutoMutexAcquire ama(snapshot->fMissMutex);
+        misses.swap(snapshot->fMisses);
+    }
+    if (misses.isEmpty()) {
+        return 0;
+    }
+    SkTQSort(misses.begin(), misses.end() - 1);
+
+    SkGlyphCache* cache = SkGlyphCache::DetachCache(typeface, &snapshot->getDescriptor());
+    int filled = 0;
+    for (int i = 0; i < misses.count(); ++i) {
+        if (i > 0 && misses[i] == misses[i - 1]) {
+            continue;
+        }
+        SkGlyph* glyph = cache->lookupByCombinedID(misses[i], kFull_MetricsType);
+        cache->findImage(*glyph);
+        filled += 1;
+    }
+    SkGlyphCache::AttachCache(cache);
+    return filled;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void SkGlyphCache_Globals::attachCacheToHead(SkGlyphCache* cache) {
     SkAutoMutexAcquire    ac(fMutex);
 
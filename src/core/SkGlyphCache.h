@@ -16,8 +16,10 @@
 #include "SkScalerContext.h"
 #include "SkTemplates.h"
 #include "SkTDArray.h"
+#include "SkThread.h"
 
 struct SkDeviceProperties;
+class SkData;
 class SkPaint;
 
 class SkGlyphCache_Globals;
@@ -42,10 +44,21 @@ public:
     /** Returns a glyph with valid fAdvance and fDevKern fields.
         The remaining fields may be valid, but that is not guaranteed. If you
         require those, call getUnicharMetrics or getGlyphIDMetrics instead.
+
+        On a strike created with SkScalerContext::kAdvancesOnlyMetrics_Flag,
+        getGlyphIDAdvance serves the advance from a compact per-strike table
+        and the returned glyph is only valid until the next advance query.
     */
     const SkGlyph& getUnicharAdvance(SkUnichar);
     const SkGlyph& getGlyphIDAdvance(uint16_t);
 
+    /** Fill advances[] with each glyph's advance, as one contiguous array
+        suitable for vectorized accumulation. Only just-advance entries are
+        generated, so no image metrics are computed for uncached glyphs.
+    */
+    void getGlyphIDAdvances(const uint16_t glyphIDs[], int count, bool vertical,
+                            SkScalar advances[]);
+
     /** Returns a glyph with all fields valid except fImage and fPath, which
         may be null. If they are null, call findImage or findPath for those.
         If they are not null, then they are valid.
@@ -64,6 +77,16 @@ public:
     const SkGlyph& getUnicharMetrics(SkUnichar, SkFixed x, SkFixed y);
     const SkGlyph& getGlyphIDMetrics(uint16_t, SkFixed x, SkFixed y);
 
+    /** Populate the strike with full metrics and images for an entire run of
+        glyphIDs in one pass. This visits the scaler context with whole-run
+        batches, so ports that pay per-call overhead (e.g. FreeType's global
+        mutex and size activation) pay it once per run rather than once per
+        glyph. Any glyph already cached is not regenerated. If results is not
+        null it receives a pointer per ID, equivalent to calling
+        getGlyphIDMetrics followed by findImage on each.
+    */
+    void populateGlyphIDRun(const uint16_t glyphIDs[], int count, const SkGlyph* results[]);
+
     /** Return the glyphID for the specified Unichar. If the char has already
         been seen, use the existing cache entry. If not, ask the scalercontext
         to compute it for us.
@@ -80,7 +103,10 @@ public:
     unsigned getGlyphCount();
 
     /** Return the image associated with the glyph. If it has not been generated
-        this will trigger that.
+        this will trigger that. A8 images are usually held RLE-packed in the
+        strike (raising the effective capacity of the font cache budget), in
+        which case the returned pointer addresses a scratch buffer that stays
+        valid only until the next findImage() call on this strike.
     */
     const void* findImage(const SkGlyph&);
     /** Return the Path associated with the glyph. If it has not been generated
@@ -152,6 +178,94 @@ public:
 
     static void Dump();
 
+    /** Serialize the glyph metrics and images of the strike matching desc
+        into a blob the caller can persist across process starts. The blob
+        embeds the typeface (SkTypeface::serialize) along with a checksum of
+        its font data, so LoadStrikeSnapshot() can reject it if the installed
+        font has changed. Glyph paths are not snapshotted. The caller owns a
+        ref on the returned data.
+    */
+    static SkData* SnapshotStrike(SkTypeface*, const SkDescriptor* desc);
+
+    /** Pre-populate the glyph cache from a blob previously produced by
+        SnapshotStrike(), typically at process startup before the first draw,
+        so first-frame text does not pay for rasterizing the UI glyph set.
+        Returns false without adding glyphs if the blob is malformed, the
+        typeface cannot be resolved, or its font data checksum no longer
+        matches.
+    */
+    static bool LoadStrikeSnapshot(const void* data, size_t length);
+
+    /** How many VisitCache() calls found an existing strike (pinned or in the
+        global list), and how many had to create one, since process start.
+    */
+    static uint32_t GetStrikeCacheHitCount();
+    static uint32_t GetStrikeCacheMissCount();
+
+    /** An immutable view of a strike for concurrent raster threads. Unlike
+        the serialized blobs made by SnapshotStrike(), a StrikeSnapshot is an
+        in-memory copy meant to live for about one frame.
+
+        It holds every fully generated glyph (metrics and image; paths and
+        advance-only entries are not copied) as the strike stood when the
+        snapshot was taken. Once constructed it is never written, so any
+        number of raster threads may query it without touching the global
+        strike lock; publication to those threads just needs the usual
+        happens-before a queue or mutex hand-off provides. Queries the
+        snapshot cannot serve record the combined glyph ID in a miss list;
+        FillStrikeSnapshotMisses() replays that list against the real strike
+        (typically on a shared fill worker, or between frames) so the next
+        frame's snapshot contains the glyphs.
+    */
+    class StrikeSnapshot : public SkRefCnt {
+    public:
+        virtual ~StrikeSnapshot();
+
+        const SkDescriptor& getDescriptor() const { return *fDesc; }
+        const SkPaint::FontMetrics& getFontMetrics() const { return fFontMetrics; }
+        SkMask::Format getMaskFormat() const { return fMaskFormat; }
+        bool isSubpixel() const { return fIsSubpixel; }
+
+        /** Return the glyph for the given ID and subpixel position, with
+            fImage valid for non-empty glyphs and fPath always NULL, or NULL
+            if the strike had not generated it when the snapshot was taken.
+            NULL returns are recorded in the miss list.
+        */
+        const SkGlyph* findGlyph(uint16_t glyphID, SkFixed x = 0, SkFixed y = 0) const;
+
+        /** The number of miss records so far (duplicates are possible; they
+            are coalesced when the misses are filled).
+        */
+        int missCount() const;
+
+    private:
+        StrikeSnapshot(const SkDescriptor&);
+
+        SkDescriptor*           fDesc;
+        SkPaint::FontMetrics    fFontMetrics;
+        SkMask::Format          fMaskFormat;
+        bool                    fIsSubpixel;
+        SkTDArray<SkGlyph>      fGlyphs;        // descending fID, like fGlyphArray
+        SkChunkAlloc            fImageAlloc;
+
+        mutable SkMutex             fMissMutex;
+        mutable SkTDArray<uint32_t> fMisses;
+
+        friend class SkGlyphCache;
+    };
+
+    /** Build a snapshot of the strike matching desc, creating the strike if
+        necessary but never generating glyphs. The caller owns a ref.
+    */
+    static StrikeSnapshot* TakeStrikeSnapshot(SkTypeface*, const SkDescriptor*);
+
+    /** Generate full metrics and an image in the real strike for every glyph
+        in the snapshot's miss list, then clear the list. Returns the number
+        of distinct glyphs generated. The snapshot itself is unchanged; take
+        a new snapshot to pick the glyphs up.
+    */
+    static int FillStrikeSnapshotMisses(SkTypeface*, StrikeSnapshot*);
+
 #ifdef SK_DEBUG
     void validate() const;
 #else
@@ -197,6 +311,25 @@ private:
     // Return the index of id in the fGlyphArray. If it does
     // not exist, create a new one using MetricsType.
     uint16_t lookupMetrics(uint32_t id, MetricsType type);
+
+    // Return the index of id in fGlyphArray, inserting an initialized but
+    // not-yet-generated glyph if it is not already present. *wasInserted tells
+    // the caller whether generation is still needed.
+    uint16_t findOrInsertGlyph(uint32_t id, bool* wasInserted);
+
+    // If the raw A8 image packs down to fewer bytes, store the packed copy on
+    // the glyph (leaving fImage NULL) and return true. Otherwise the caller
+    // stores the raw bytes as before.
+    bool tryPackImage(SkGlyph*, const void* raw, size_t rawSize);
+
+    // Return a scratch block of at least size bytes, shared by image
+    // generation and unpacking; the block lives until the next request.
+    void* imageScratch(size_t size);
+
+    // Serve an advance query from fAdvanceCache, filling the glyph's block of
+    // the table with one getAdvanceBatch call if needed. Only used on
+    // advances-only strikes; the returned glyph is fAdvanceScratch.
+    const SkGlyph* lookupAdvanceOnly(uint16_t glyphID);
     static bool DetachProc(const SkGlyphCache*, void*) { return true; }
 
     SkGlyphCache*        fNext, *fPrev;
@@ -219,6 +352,21 @@ private:
     SkTDArray<SkGlyph>   fGlyphArray;
     SkChunkAlloc         fGlyphAlloc;
 
+    // Backs imageScratch(); grows to the largest image seen on this strike.
+    SkAutoMalloc         fImageScratch;
+    size_t               fImageScratchSize;
+
+    enum {
+        kAdvanceBlockSize = 64  // glyphs fetched per getAdvanceBatch call
+    };
+
+    // Compact advance table for advances-only strikes
+    // (SkScalerContext::kAdvancesOnlyMetrics_Flag): two SkFixed (x, y) per
+    // glyph ID, filled one block at a time. Allocated on first advance query.
+    SkAutoTMalloc<SkFixed> fAdvanceCache;
+    SkAutoTMalloc<uint8_t> fAdvanceValid;   // one flag per block
+    SkGlyph                fAdvanceScratch; // returned by lookupAdvanceOnly
+
     struct CharGlyphRec {
         uint32_t    fID;    // unichar + subpixel
         uint16_t    fGlyphIndex;
@@ -9,15 +9,20 @@
 
 #include "SkGraphics.h"
 
+#include "SkBlitRow.h"
 #include "SkBlitter.h"
 #include "SkCanvas.h"
+#include "SkDecodeScheduler.h"
+#include "SkDiscardableMemoryPool.h"
 #include "SkGeometry.h"
+#include "SkGlyphCache.h"
 #include "SkMath.h"
 #include "SkMatrix.h"
 #include "SkPath.h"
 #include "SkPathEffect.h"
 #include "SkPixelRef.h"
 #include "SkRefCnt.h"
+#include "SkResourceCache.h"
 #include "SkRTConf.h"
 #include "SkScalerContext.h"
 #include "SkShader.h"
@@ -59,6 +64,8 @@ void SkGraphics::Init() {
     }
 #endif
 
+    SkBlitRow::InitProcTables();
+
 #ifdef BUILD_EMBOSS_TABLE
     SkEmbossMask_BuildTable();
 #endif
@@ -133,6 +140,189 @@ void SkGraphics::Term() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Each process-global cache already exposes its own budget knobs; this table
+// gathers them behind one interface so GetCacheStats() and PurgeToFit() can
+// treat the caches uniformly.
+struct CacheInterface {
+    const char* fName;
+    size_t   (*fGetUsed)();
+    size_t   (*fGetLimit)();
+    size_t   (*fSetLimit)(size_t);
+    uint32_t (*fGetHits)();
+    uint32_t (*fGetMisses)();
+};
+
+size_t pool_get_used() { return SkGetGlobalDiscardableMemoryPool()->getRAMUsed(); }
+size_t pool_get_limit() { return SkGetGlobalDiscardableMemoryPool()->getRAMBudget(); }
+
+size_t pool_set_limit(size_t bytes) {
+    SkDiscardableMemoryPool* pool = SkGetGlobalDiscardableMemoryPool();
+    size_t prev = pool->getRAMBudget();
+    pool->setRAMBudget(bytes);
+    return prev;
+}
+
+uint32_t pool_get_hits() {
+#if SK_LAZY_CACHE_STATS
+    return (uint32_t)SkGetGlobalDiscardableMemoryPool()->getCacheHits();
+#else
+    return 0;
+#endif
+}
+
+uint32_t pool_get_misses() {
+#if SK_LAZY_CACHE_STATS
+    return (uint32_t)SkGetGlobalDiscardableMemoryPool()->getCacheMisses();
+#else
+    return 0;
+#endif
+}
+
+const CacheInterface gCacheTable[] = {
+    { "resource",
+      SkGraphics::GetResourceCacheTotalBytesUsed,
+      SkGraphics::GetResourceCacheTotalByteLimit,
+      SkGraphics::SetResourceCacheTotalByteLimit,
+      SkResourceCache::GetHitCount,
+      SkResourceCache::GetMissCount },
+    { "font",
+      SkGraphics::GetFontCacheUsed,
+      SkGraphics::GetFontCacheLimit,
+      SkGraphics::SetFontCacheLimit,
+      SkGlyphCache::GetStrikeCacheHitCount,
+      SkGlyphCache::GetStrikeCacheMissCount },
+    { "discardable",
+      pool_get_used,
+      pool_get_limit,
+      pool_set_limit,
+      pool_get_hits,
+      pool_get_misses },
+};
+
+const int kCacheCount = SK_ARRAY_COUNT(gCacheTable);
+
+}  // namespace
+
+int SkGraphics::GetCacheStats(CacheStats stats[], int maxCount) {
+    for (int i = 0; i < maxCount && i < kCacheCount; ++i) {
+        stats[i].fName = gCacheTable[i].fName;
+        stats[i].fBytesUsed = gCacheTable[i].fGetUsed();
+        stats[i].fByteLimit = gCacheTable[i].fGetLimit();
+        stats[i].fHits = gCacheTable[i].fGetHits();
+        stats[i].fMisses = gCacheTable[i].fGetMisses();
+    }
+    return kCacheCount;
+}
+
+void SkGraphics::PurgeToFit(size_t totalBytes) {
+    // Weight each cache by its smoothed hit rate; the +1/+2 keeps caches with
+    // no traffic yet from being starved to zero.
+    float weight[kCacheCount];
+    float weightSum = 0;
+    int hottest = 0;
+    for (int i = 0; i < kCacheCount; ++i) {
+        const uint32_t hits = gCacheTable[i].fGetHits();
+        const uint32_t misses = gCacheTable[i].fGetMisses();
+        weight[i] = (hits + 1) / (float)((uint64_t)hits + misses + 2);
+        weightSum += weight[i];
+        if (weight[i] > weight[hottest]) {
+            hottest = i;
+        }
+    }
+
+    // Split totalBytes in proportion to the weights. The hottest cache gets
+    // whatever the others leave behind, so rounding slack (and anything freed
+    // by shrinking a cold cache) lands where it pays off most.
+    size_t newLimit[kCacheCount];
+    size_t granted = 0;
+    for (int i = 0; i < kCacheCount; ++i) {
+        if (i != hottest) {
+            newLimit[i] = (size_t)(totalBytes * (weight[i] / weightSum));
+            granted += newLimit[i];
+        }
+    }
+    newLimit[hottest] = totalBytes > granted ? totalBytes - granted : 0;
+
+    // Shrink before growing, so memory is actually released before any cache
+    // is told it may use more.
+    for (int i = 0; i < kCacheCount; ++i) {
+        if (newLimit[i] < gCacheTable[i].fGetLimit()) {
+            gCacheTable[i].fSetLimit(newLimit[i]);
+        }
+    }
+    for (int i = 0; i < kCacheCount; ++i) {
+        if (newLimit[i] >= gCacheTable[i].fGetLimit()) {
+            gCacheTable[i].fSetLimit(newLimit[i]);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct IdleWorkRec {
+    SkGraphics::IdleWorkProc fProc;
+    void*                    fContext;
+};
+}  // namespace
+
+SK_DECLARE_STATIC_MUTEX(gIdleWorkMutex);
+static SkTDArray<IdleWorkRec> gIdleWorkRecs;
+
+void SkGraphics::RegisterIdleWorkProc(IdleWorkProc proc, void* context) {
+    SkASSERT(proc);
+    SkAutoMutexAcquire lock(gIdleWorkMutex);
+    IdleWorkRec rec = { proc, context };
+    *gIdleWorkRecs.append() = rec;
+}
+
+void SkGraphics::UnregisterIdleWorkProc(IdleWorkProc proc, void* context) {
+    SkAutoMutexAcquire lock(gIdleWorkMutex);
+    for (int i = 0; i < gIdleWorkRecs.count(); ++i) {
+        if (gIdleWorkRecs[i].fProc == proc && gIdleWorkRecs[i].fContext == context) {
+            gIdleWorkRecs.remove(i);
+            return;
+        }
+    }
+}
+
+void SkGraphics::PerformIdleWork(double deadlineNanos) {
+    // Cheap built-in housekeeping first: it's bounded, and doing it now keeps
+    // it off the next frame's critical path.
+    if (SkResourceCache::PerformIdleWork(deadlineNanos)) {
+        return;  // Ran out of time mid-purge.
+    }
+    SkGetGlobalDiscardableMemoryPool()->reclaimAsNeeded();
+
+    // Deferred idle-priority predecodes.  These are the coarsest items we run:
+    // each call decodes one whole image, so the last one may overrun.
+    while (SkTime::GetNSecs() < deadlineNanos && SkDecodeScheduler::PerformIdleWork()) {
+    }
+
+    // Externally registered work, round-robin so no proc starves the others.
+    SkTDArray<IdleWorkRec> recs;
+    {
+        SkAutoMutexAcquire lock(gIdleWorkMutex);
+        recs = gIdleWorkRecs;
+    }
+    bool moreWork = true;
+    while (moreWork && SkTime::GetNSecs() < deadlineNanos) {
+        moreWork = false;
+        for (int i = 0; i < recs.count(); ++i) {
+            if (recs[i].fProc(recs[i].fContext, deadlineNanos)) {
+                moreWork = true;
+            }
+            if (SkTime::GetNSecs() >= deadlineNanos) {
+                return;
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static const char kFontCacheLimitStr[] = "font-cache-limit";
 static const size_t kFontCacheLimitLen = sizeof(kFontCacheLimitStr) - 1;
 
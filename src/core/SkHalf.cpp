@@ -7,6 +7,7 @@
 
 #include "SkHalf.h"
 #include "SkFloatBits.h"
+#include "SkLazyFnPtr.h"
 
 uint16_t halfMantissa(SkHalf h) {
     return h & 0x03ff;
@@ -95,3 +96,39 @@ float SkHalfToFloat(SkHalf h) {
     o.fUInt |= (halfSign(h) << 31);
     return o.fFloat;
 }
+
+namespace {
+
+void half_to_float_row_portable(float dst[], const SkHalf src[], int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = SkHalfToFloat(src[i]);
+    }
+}
+
+void float_to_half_row_portable(SkHalf dst[], const float src[], int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = SkFloatToHalf(src[i]);
+    }
+}
+
+SkHalfToFloatRowProc choose_half_to_float_row() {
+    SkHalfToFloatRowProc proc = SkHalfToFloatRowGetPlatformProc();
+    return proc ? proc : half_to_float_row_portable;
+}
+
+SkFloatToHalfRowProc choose_float_to_half_row() {
+    SkFloatToHalfRowProc proc = SkFloatToHalfRowGetPlatformProc();
+    return proc ? proc : float_to_half_row_portable;
+}
+
+}  // namespace
+
+void SkHalfToFloat_row(float dst[], const SkHalf src[], int count) {
+    SK_DECLARE_STATIC_LAZY_FN_PTR(SkHalfToFloatRowProc, proc, choose_half_to_float_row);
+    proc.get()(dst, src, count);
+}
+
+void SkFloatToHalf_row(SkHalf dst[], const float src[], int count) {
+    SK_DECLARE_STATIC_LAZY_FN_PTR(SkFloatToHalfRowProc, proc, choose_float_to_half_row);
+    proc.get()(dst, src, count);
+}
@@ -23,4 +23,17 @@ typedef uint16_t SkHalf;
 float SkHalfToFloat(SkHalf h);
 SkHalf SkFloatToHalf(float f);
 
+// Convert a row of values between half and single precision.  dst and src
+// may not overlap.  Uses hardware conversion (F16C) when the CPU has it.
+void SkHalfToFloat_row(float dst[], const SkHalf src[], int count);
+void SkFloatToHalf_row(SkHalf dst[], const float src[], int count);
+
+// Allows hardware-accelerated row converters to be chosen at runtime, in the
+// same manner as the procs in SkUtils.h.  Returns NULL when the CPU (or the
+// port) has no accelerated converter.
+typedef void (*SkHalfToFloatRowProc)(float dst[], const SkHalf src[], int count);
+typedef void (*SkFloatToHalfRowProc)(SkHalf dst[], const float src[], int count);
+SkHalfToFloatRowProc SkHalfToFloatRowGetPlatformProc();
+SkFloatToHalfRowProc SkFloatToHalfRowGetPlatformProc();
+
 #endif
@@ -12,9 +12,11 @@
 #include "SkDevice.h"
 #include "SkLazyPtr.h"
 #include "SkMatrixImageFilter.h"
+#include "SkPixelRef.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkRect.h"
+#include "SkResourceCache.h"
 #include "SkTDynamicHash.h"
 #include "SkTInternalLList.h"
 #include "SkValidationUtils.h"
@@ -24,12 +26,6 @@
 #include "SkGr.h"
 #endif
 
-#ifdef SK_BUILD_FOR_IOS
-  enum { kDefaultCacheSize = 2 * 1024 * 1024 };
-#else 
-  enum { kDefaultCacheSize = 128 * 1024 * 1024 };
-#endif 
-
 static int32_t next_image_filter_unique_id() {
     static int32_t gImageFilterUniqueID;
 
@@ -61,6 +57,26 @@ struct SkImageFilter::Cache::Key {
     }
 };
 
+// Cached filter results carry a resource cache sharedID derived from the source
+// bitmap's generation ID, so all results computed from that source can be purged
+// together when its pixels change (see the GenIDChangeListener in filterImage()).
+static uint64_t make_filter_shared_id(uint32_t srcGenID) {
+    uint64_t sharedID = SkSetFourByteTag('i', 'm', 'g', 'f');
+    return (sharedID << 32) | srcGenID;
+}
+
+namespace {
+class PurgeFilterResultsListener : public SkPixelRef::GenIDChangeListener {
+public:
+    explicit PurgeFilterResultsListener(uint32_t srcGenID) : fSrcGenID(srcGenID) {}
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_filter_shared_id(fSrcGenID));
+    }
+private:
+    uint32_t fSrcGenID;
+};
+}  // namespace
+
 SkImageFilter::Common::~Common() {
     for (int i = 0; i < fInputs.count(); ++i) {
         SkSafeUnref(fInputs[i]);
@@ -189,12 +205,108 @@ bool SkImageFilter::filterImage(Proxy* proxy, const SkBitmap& src,
         this->onFilterImage(proxy, src, context, result, offset)) {
         if (context.cache()) {
             context.cache()->set(key, *result, *offset);
+            if (srcGenID && src.pixelRef()) {
+                // Purge this result (and any siblings keyed off the same source)
+                // if the source pixels change out from under the cache.
+                src.pixelRef()->addGenIDChangeListener(
+                        SkNEW_ARGS(PurgeFilterResultsListener, (srcGenID)));
+            }
         }
         return true;
     }
     return false;
 }
 
+// Banded evaluation parameters: target footprint for one band of N32
+// intermediate (roughly half a typical L2 slice), and a floor so that filter
+// lookback does not dominate recomputation on very wide layers.
+enum {
+    kBandTargetBytes = 256 * 1024,
+    kMinBandHeight   = 32,
+};
+
+bool SkImageFilter::filterImageBanded(Proxy* proxy, const SkBitmap& src,
+                                      const Context& context,
+                                      SkBitmap* result, SkIPoint* offset) const {
+    SkASSERT(result);
+    SkASSERT(offset);
+    if (NULL == proxy || src.getTexture()) {
+        return this->filterImage(proxy, src, context, result, offset);
+    }
+
+    // The source bitmap's top-left corner is the filter-space origin, so its
+    // bounds map forward to the region the DAG can produce.
+    SkIRect dstBounds;
+    if (!this->filterBounds(src.bounds(), context.ctm(), &dstBounds)) {
+        return this->filterImage(proxy, src, context, result, offset);
+    }
+    if (!dstBounds.intersect(context.clipBounds())) {
+        return false;
+    }
+
+    const int bandHeight = SkMax32(kMinBandHeight,
+                                   kBandTargetBytes / SkMax32(1, dstBounds.width() << 2));
+    if (dstBounds.height() <= bandHeight * 2) {
+        // Not enough rows for banding to reduce the peak footprint.
+        return this->filterImage(proxy, src, context, result, offset);
+    }
+
+    uint32_t srcGenID = fUsesSrcInput ? src.getGenerationID() : 0;
+    Cache::Key key(fUniqueID, context.ctm(), context.clipBounds(), srcGenID);
+    if (context.cache()) {
+        if (context.cache()->get(key, result, offset)) {
+            return true;
+        }
+    }
+
+    SkAutoTUnref<SkBaseDevice> device(proxy->createDevice(dstBounds.width(),
+                                                          dstBounds.height()));
+    if (!device) {
+        return this->filterImage(proxy, src, context, result, offset);
+    }
+    SkCanvas canvas(device);
+    canvas.clear(0x0);
+
+    bool producedAnyBand = false;
+    for (int top = dstBounds.top(); top < dstBounds.bottom(); top += bandHeight) {
+        SkIRect band = SkIRect::MakeLTRB(dstBounds.left(), top, dstBounds.right(),
+                                         SkMin32(top + bandHeight, dstBounds.bottom()));
+        // Band intermediates are not worth caching; the stitched result is
+        // cached below under the caller's key.
+        Context bandContext(context.ctm(), band, NULL);
+        SkBitmap bandResult;
+        SkIPoint bandOffset = SkIPoint::Make(0, 0);
+        if (!this->filterImage(proxy, src, bandContext, &bandResult, &bandOffset)) {
+            continue;   // e.g. the band was fully cropped away
+        }
+        producedAnyBand = true;
+        band.offset(-dstBounds.left(), -dstBounds.top());
+        SkRect clipRect;
+        clipRect.set(band);
+        canvas.save();
+        canvas.clipRect(clipRect);
+        canvas.drawBitmap(bandResult,
+                          SkIntToScalar(bandOffset.x() - dstBounds.left()),
+                          SkIntToScalar(bandOffset.y() - dstBounds.top()));
+        canvas.restore();
+    }
+    if (!producedAnyBand) {
+        return false;
+    }
+
+    *result = device->accessBitmap(false);
+    offset->fX = dstBounds.left();
+    offset->fY = dstBounds.top();
+    if (context.cache()) {
+        context.cache()->set(key, *result, *offset);
+        if (srcGenID && src.pixelRef()) {
+            src.pixelRef()->addGenIDChangeListener(
+                    SkNEW_ARGS(PurgeFilterResultsListener, (srcGenID)));
+        }
+    }
+    return true;
+}
+
 bool SkImageFilter::filterBounds(const SkIRect& src, const SkMatrix& ctm,
                                  SkIRect* dst) const {
     SkASSERT(dst);
@@ -489,8 +601,63 @@ private:
     mutable SkMutex                    fMutex;
 };
 
+// The process-wide cache returned by Cache::Get() is backed by SkResourceCache, so
+// filter results persist across frames, share the resource cache's byte budget and
+// purging, and can be invalidated as a group when their source pixels change: every
+// entry carries a sharedID derived from the source bitmap's generation ID, and a
+// GenIDChangeListener on the source posts a purge of that sharedID.
+
+static unsigned gImageFilterKeyNamespaceLabel;
+
+struct ImageFilterKey : public SkResourceCache::Key {
+    explicit ImageFilterKey(const SkImageFilter::Cache::Key& key) : fKey(key) {
+        // Cache::Key is compile-asserted to be tightly packed, so it can double as
+        // the flat payload SkResourceCache hashes and compares.
+        this->init(&gImageFilterKeyNamespaceLabel, make_filter_shared_id(key.fSrcGenID),
+                   sizeof(fKey));
+    }
+    SkImageFilter::Cache::Key fKey;
+};
+
+struct ImageFilterRec : public SkResourceCache::Rec {
+    ImageFilterRec(const SkImageFilter::Cache::Key& key, const SkBitmap& bitmap,
+                   const SkIPoint& offset)
+        : fKey(key), fBitmap(bitmap), fOffset(offset) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fBitmap.getSize(); }
+
+    struct FindContext {
+        SkBitmap* fResult;
+        SkIPoint* fOffset;
+    };
+    static bool Finder(const SkResourceCache::Rec& baseRec, void* context) {
+        const ImageFilterRec& rec = static_cast<const ImageFilterRec&>(baseRec);
+        FindContext* ctx = (FindContext*)context;
+        *ctx->fResult = rec.fBitmap;
+        *ctx->fOffset = rec.fOffset;
+        return true;
+    }
+
+private:
+    ImageFilterKey fKey;
+    SkBitmap       fBitmap;
+    SkIPoint       fOffset;
+};
+
+class ResourceCacheImpl : public SkImageFilter::Cache {
+public:
+    bool get(const Key& key, SkBitmap* result, SkIPoint* offset) const override {
+        ImageFilterRec::FindContext ctx = { result, offset };
+        return SkResourceCache::Find(ImageFilterKey(key), ImageFilterRec::Finder, &ctx);
+    }
+    void set(const Key& key, const SkBitmap& result, const SkIPoint& offset) override {
+        SkResourceCache::Add(SkNEW_ARGS(ImageFilterRec, (key, result, offset)));
+    }
+};
+
 SkImageFilter::Cache* CreateCache() {
-    return SkImageFilter::Cache::Create(kDefaultCacheSize);
+    return SkNEW(ResourceCacheImpl);
 }
 
 } // namespace
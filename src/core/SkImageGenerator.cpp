@@ -6,6 +6,7 @@
  */
 
 #include "SkImageGenerator.h"
+#include "SkRect.h"
 
 SkImageGenerator::Result SkImageGenerator::getPixels(const SkImageInfo& info, void* pixels,
                                                      size_t rowBytes, const Options* options,
@@ -37,6 +38,18 @@ SkImageGenerator::Result SkImageGenerator::getPixels(const SkImageInfo& info, vo
     if (NULL == options) {
         options = &optsStorage;
     }
+
+    if (options->fSubset) {
+        // The caller must size the destination to the subset and the subset
+        // must be contained by the full image.
+        if (info.width() != options->fSubset->width() ||
+                info.height() != options->fSubset->height()) {
+            return kInvalidParameters;
+        }
+        if (!SkIRect::MakeWH(fInfo.width(), fInfo.height()).contains(*options->fSubset)) {
+            return kInvalidParameters;
+        }
+    }
     const Result result = this->onGetPixels(info, pixels, rowBytes, *options, ctable, ctableCount);
 
     if ((kIncompleteInput == result || kSuccess == result) && ctableCount) {
@@ -106,6 +119,17 @@ bool SkImageGenerator::onGetYUV8Planes(SkISize sizes[3], void* planes[3], size_t
     return this->onGetYUV8Planes(sizes, planes, rowBytes);
 }
 
+GrTexture* SkImageGenerator::generateTexture(GrContext* ctx) {
+    if (NULL == ctx) {
+        return NULL;
+    }
+    return this->onGenerateTexture(ctx);
+}
+
+GrTexture* SkImageGenerator::onGenerateTexture(GrContext*) {
+    return NULL;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 SkData* SkImageGenerator::onRefEncodedData() {
@@ -13,8 +13,140 @@
 struct MaskValue {
     SkMask          fMask;
     SkCachedData*   fData;
+    bool            fCompressed;    // fData holds RLE rows rather than the dense plane
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ *  Big blur masks are mostly transparent, so a dense A8 plane wastes nearly all of the
+ *  cache's byte budget on zeros. Sufficiently sparse masks are stored run-length encoded
+ *  instead, and decoded into a fresh dense plane on lookup -- still far cheaper than
+ *  re-blurring, and small enough that the budget holds many large soft shadows.
+ *
+ *  Each row is a sequence of (skip, literal) uint16 pairs (little-endian, byte-packed to
+ *  avoid alignment requirements), each pair followed by 'literal' coverage bytes. The
+ *  skips and literals of one row always sum to the mask width, so no terminator is needed.
+ */
+
+static const uint32_t kMaxRLEDimension = 0xFFFF;
+
+// A literal run soaks up interior zero gaps shorter than this, since splitting a run
+// costs a 4 byte pair.
+static const int kMinSkipRun = 8;
+
+static void write_u16(uint8_t* p, unsigned value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static unsigned read_u16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+// Measures when dst is NULL, encodes otherwise. Returns the encoded byte size.
+static size_t encode_rle_rows(const SkMask& mask, uint8_t* dst) {
+    const int width = mask.fBounds.width();
+    const int height = mask.fBounds.height();
+    size_t size = 0;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = mask.fImage + y * mask.fRowBytes;
+        int x = 0;
+        while (x < width) {
+            int start = x;
+            while (x < width && 0 == row[x]) {
+                x += 1;
+            }
+            const int skip = x - start;
+            start = x;
+            while (x < width) {
+                if (0 != row[x]) {
+                    x += 1;
+                    continue;
+                }
+                int z = x;
+                while (z < width && 0 == row[z]) {
+                    z += 1;
+                }
+                if (z - x >= kMinSkipRun || z == width) {
+                    break;
+                }
+                x = z;  // short interior gap: cheaper kept as literal zeros
+            }
+            const int literal = x - start;
+            if (dst) {
+                write_u16(dst + size, skip);
+                write_u16(dst + size + 2, literal);
+                memcpy(dst + size + 4, row + start, literal);
+            }
+            size += 4 + literal;
+        }
+    }
+    return size;
+}
+
+static void decode_rle_rows(const uint8_t* src, const SkMask& mask, uint8_t* image) {
+    const int width = mask.fBounds.width();
+    const int height = mask.fBounds.height();
+    sk_bzero(image, mask.computeTotalImageSize());
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = image + y * mask.fRowBytes;
+        int x = 0;
+        while (x < width) {
+            const int skip = read_u16(src);
+            const int literal = read_u16(src + 2);
+            src += 4;
+            x += skip;
+            memcpy(row + x, src, literal);
+            src += literal;
+            x += literal;
+        }
+    }
+}
+
+// Returns RLE data worth caching in place of the dense plane, or NULL to cache densely.
+static SkCachedData* try_compress_mask(const SkMask& mask, SkResourceCache* localCache) {
+    if (SkMask::kA8_Format != mask.fFormat || NULL == mask.fImage ||
+        (uint32_t)mask.fBounds.width() > kMaxRLEDimension ||
+        (uint32_t)mask.fBounds.height() > kMaxRLEDimension) {
+        return NULL;
+    }
+    const size_t denseSize = mask.computeTotalImageSize();
+    if (0 == denseSize) {
+        return NULL;
+    }
+    const size_t rleSize = encode_rle_rows(mask, NULL);
+    // Only worth the decode-on-lookup copy when the mask is mostly transparent.
+    if (rleSize > (denseSize >> 1)) {
+        return NULL;
+    }
+    SkCachedData* data = CHECK_LOCAL(localCache, newCachedData, NewCachedData, rleSize);
+    if (data) {
+        (void)encode_rle_rows(mask, (uint8_t*)data->writable_data());
+    }
+    return data;
+}
+
+// Common tail for FindAndRef: hands back either the dense cached plane directly, or a
+// fresh dense plane decoded from the cached RLE rows.
+static SkCachedData* resolve_mask_data(MaskValue* value, SkMask* mask,
+                                       SkResourceCache* localCache) {
+    *mask = value->fMask;
+    if (!value->fCompressed) {
+        mask->fImage = (uint8_t*)value->fData->data();
+        return value->fData;
+    }
+    SkCachedData* dense = CHECK_LOCAL(localCache, newCachedData, NewCachedData,
+                                      mask->computeTotalImageSize());
+    if (dense) {
+        decode_rle_rows((const uint8_t*)value->fData->data(), *mask,
+                        (uint8_t*)dense->writable_data());
+        mask->fImage = (uint8_t*)dense->data();
+    }
+    value->fData->unref();
+    return dense;
+}
+
 namespace {
 static unsigned gRRectBlurKeyNamespaceLabel;
 
@@ -37,11 +169,12 @@ public:
 };
 
 struct RRectBlurRec : public SkResourceCache::Rec {
-    RRectBlurRec(RRectBlurKey key, const SkMask& mask, SkCachedData* data)
+    RRectBlurRec(RRectBlurKey key, const SkMask& mask, SkCachedData* data, bool compressed)
         : fKey(key)
     {
         fValue.fMask = mask;
         fValue.fData = data;
+        fValue.fCompressed = compressed;
         fValue.fData->attachToCacheAndRef();
     }
     ~RRectBlurRec() {
@@ -78,16 +211,105 @@ SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style, SkBlurQ
         return NULL;
     }
 
-    *mask = result.fMask;
-    mask->fImage = (uint8_t*)(result.fData->data());
-    return result.fData;
+    return resolve_mask_data(&result, mask, localCache);
 }
 
 void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
                       const SkRRect& rrect, const SkMask& mask, SkCachedData* data,
                       SkResourceCache* localCache) {
     RRectBlurKey key(sigma, rrect, style, quality);
-    return CHECK_LOCAL(localCache, add, Add, SkNEW_ARGS(RRectBlurRec, (key, mask, data)));
+    SkAutoTUnref<SkCachedData> rle(try_compress_mask(mask, localCache));
+    SkCachedData* store = rle ? rle.get() : data;
+    return CHECK_LOCAL(localCache, add, Add,
+                       SkNEW_ARGS(RRectBlurRec, (key, mask, store, SkToBool(rle.get()))));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gRRectsBlurKeyNamespaceLabel;
+
+struct RRectsBlurKey : public SkResourceCache::Key {
+public:
+    RRectsBlurKey(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
+                  const SkRRect rrects[], int count)
+        : fSigma(sigma)
+        , fStyle(style)
+        , fQuality(quality)
+    {
+        SkASSERT(1 == count || 2 == count);
+        fRRects[0] = rrects[0];
+        if (2 == count) {
+            fRRects[1] = rrects[1];
+        } else {
+            fRRects[1].setEmpty();
+        }
+
+        this->init(&gRRectsBlurKeyNamespaceLabel, 0,
+                   sizeof(fSigma) + sizeof(fStyle) + sizeof(fQuality) + sizeof(fRRects));
+    }
+
+    SkScalar    fSigma;
+    int32_t     fStyle;
+    int32_t     fQuality;
+    SkRRect     fRRects[2];
+};
+
+struct RRectsBlurRec : public SkResourceCache::Rec {
+    RRectsBlurRec(RRectsBlurKey key, const SkMask& mask, SkCachedData* data, bool compressed)
+        : fKey(key)
+    {
+        fValue.fMask = mask;
+        fValue.fData = data;
+        fValue.fCompressed = compressed;
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~RRectsBlurRec() {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    RRectsBlurKey  fKey;
+    MaskValue      fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const RRectsBlurRec& rec = static_cast<const RRectsBlurRec&>(baseRec);
+        MaskValue* result = static_cast<MaskValue*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (NULL == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = rec.fValue;
+        return true;
+    }
+};
+} // namespace
+
+SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
+                                      const SkRRect rrects[], int count, SkMask* mask,
+                                      SkResourceCache* localCache) {
+    MaskValue result;
+    RRectsBlurKey key(sigma, style, quality, rrects, count);
+    if (!CHECK_LOCAL(localCache, find, Find, key, RRectsBlurRec::Visitor, &result)) {
+        return NULL;
+    }
+
+    return resolve_mask_data(&result, mask, localCache);
+}
+
+void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
+                      const SkRRect rrects[], int count, const SkMask& mask, SkCachedData* data,
+                      SkResourceCache* localCache) {
+    RRectsBlurKey key(sigma, style, quality, rrects, count);
+    SkAutoTUnref<SkCachedData> rle(try_compress_mask(mask, localCache));
+    SkCachedData* store = rle ? rle.get() : data;
+    return CHECK_LOCAL(localCache, add, Add,
+                       SkNEW_ARGS(RRectsBlurRec, (key, mask, store, SkToBool(rle.get()))));
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -128,11 +350,12 @@ public:
 };
 
 struct RectsBlurRec : public SkResourceCache::Rec {
-    RectsBlurRec(RectsBlurKey key, const SkMask& mask, SkCachedData* data)
+    RectsBlurRec(RectsBlurKey key, const SkMask& mask, SkCachedData* data, bool compressed)
         : fKey(key)
     {
         fValue.fMask = mask;
         fValue.fData = data;
+        fValue.fCompressed = compressed;
         fValue.fData->attachToCacheAndRef();
     }
     ~RectsBlurRec() {
@@ -170,14 +393,15 @@ SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style, SkBlurQ
         return NULL;
     }
 
-    *mask = result.fMask;
-    mask->fImage = (uint8_t*)(result.fData->data());
-    return result.fData;
+    return resolve_mask_data(&result, mask, localCache);
 }
 
 void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
                       const SkRect rects[], int count, const SkMask& mask, SkCachedData* data,
                       SkResourceCache* localCache) {
     RectsBlurKey key(sigma, style, quality, rects, count);
-    return CHECK_LOCAL(localCache, add, Add, SkNEW_ARGS(RectsBlurRec, (key, mask, data)));
+    SkAutoTUnref<SkCachedData> rle(try_compress_mask(mask, localCache));
+    SkCachedData* store = rle ? rle.get() : data;
+    return CHECK_LOCAL(localCache, add, Add,
+                       SkNEW_ARGS(RectsBlurRec, (key, mask, store, SkToBool(rle.get()))));
 }
@@ -29,6 +29,9 @@ public:
     static SkCachedData* FindAndRef(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
                                     const SkRect rects[], int count, SkMask* mask,
                                     SkResourceCache* localCache = NULL);
+    static SkCachedData* FindAndRef(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
+                                    const SkRRect rrects[], int count, SkMask* mask,
+                                    SkResourceCache* localCache = NULL);
 
     /**
      * Add a mask and its pixel-data to the cache.
@@ -39,6 +42,9 @@ public:
     static void Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
                     const SkRect rects[], int count, const SkMask& mask, SkCachedData* data,
                     SkResourceCache* localCache = NULL);
+    static void Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
+                    const SkRRect rrects[], int count, const SkMask& mask, SkCachedData* data,
+                    SkResourceCache* localCache = NULL);
 };
 
 #endif
@@ -216,12 +216,33 @@ static int countNestedRects(const SkPath& path, SkRect rects[2]) {
 
 bool SkMaskFilter::filterRRect(const SkRRect& devRRect, const SkMatrix& matrix,
                                const SkRasterClip& clip, SkBlitter* blitter,
-                               SkPaint::Style style) const {
+                               SkPaint::Style style, SkScalar devStrokeWidth) const {
     // Attempt to speed up drawing by creating a nine patch. If a nine patch
     // cannot be used, return false to allow our caller to recover and perform
     // the drawing another way.
     NinePatch patch;
     patch.fMask.fImage = NULL;
+
+    if (SkPaint::kStroke_Style == style && devStrokeWidth > 0) {
+        // A uniform stroke covers the ring between the round rect outset and
+        // inset by half the stroke width.  If the inset leaves nothing, the
+        // stroke covers the whole outset shape and we fill that instead.
+        const SkScalar hw = SkScalarHalf(devStrokeWidth);
+        SkRRect rrects[2];
+        devRRect.outset(hw, hw, &rrects[0]);
+        devRRect.inset(hw, hw, &rrects[1]);
+        const int count = rrects[1].isEmpty() ? 1 : 2;
+
+        if (kTrue_FilterReturn != this->filterRRectsToNine(rrects, count, matrix,
+                                                           clip.getBounds(),
+                                                           &patch)) {
+            SkASSERT(NULL == patch.fMask.fImage);
+            return false;
+        }
+        draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, 1 == count, clip, blitter);
+        return true;
+    }
+
     if (kTrue_FilterReturn != this->filterRRectToNine(devRRect, matrix,
                                                       clip.getBounds(),
                                                       &patch)) {
@@ -297,6 +318,12 @@ SkMaskFilter::filterRRectToNine(const SkRRect&, const SkMatrix&,
     return kUnimplemented_FilterReturn;
 }
 
+SkMaskFilter::FilterReturn
+SkMaskFilter::filterRRectsToNine(const SkRRect[], int count, const SkMatrix&,
+                                 const SkIRect& clipBounds, NinePatch*) const {
+    return kUnimplemented_FilterReturn;
+}
+
 SkMaskFilter::FilterReturn
 SkMaskFilter::filterRectsToNine(const SkRect[], int count, const SkMatrix&,
                                 const SkIRect& clipBounds, NinePatch*) const {
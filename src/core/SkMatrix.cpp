@@ -12,6 +12,12 @@
 
 #include <stddef.h>
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
 static void normalize_perspective(SkScalar mat[9]) {
     // If it was interesting to never store the last element, we could divide all 8 other
     // elements here by the 9th, making it 1.0...
@@ -981,10 +987,42 @@ void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[]
             src += 1;
             dst += 1;
         }
+        count >>= 1;
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        // The ABCD -> BADC swizzle the skew terms need is a single in-register
+        // shuffle; building it with lane inserts (the portable loop below) is
+        // what kept this kernel from running at memory speed.
+        const __m128 trans4 = _mm_setr_ps(tx, ty, tx, ty);
+        const __m128 scale4 = _mm_setr_ps(sx, sy, sx, sy);
+        const __m128 skew4  = _mm_setr_ps(kx, ky, kx, ky);
+        for (int i = 0; i < count; ++i) {
+            __m128 xy = _mm_loadu_ps(&src->fX);
+            __m128 yx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 3, 0, 1));
+            _mm_storeu_ps(&dst->fX, _mm_add_ps(_mm_add_ps(_mm_mul_ps(xy, scale4),
+                                                          _mm_mul_ps(yx, skew4)), trans4));
+            src += 2;
+            dst += 2;
+        }
+#elif defined(SK_ARM_HAS_NEON)
+        // vrev64q swaps within each lane pair, exactly the ABCD -> BADC
+        // swizzle the skew terms need.
+        const SkScalar transA[4] = { tx, ty, tx, ty };
+        const SkScalar scaleA[4] = { sx, sy, sx, sy };
+        const SkScalar skewA[4]  = { kx, ky, kx, ky };
+        const float32x4_t trans4 = vld1q_f32(transA);
+        const float32x4_t scale4 = vld1q_f32(scaleA);
+        const float32x4_t skew4  = vld1q_f32(skewA);
+        for (int i = 0; i < count; ++i) {
+            float32x4_t xy = vld1q_f32(&src->fX);
+            float32x4_t yx = vrev64q_f32(xy);
+            vst1q_f32(&dst->fX, vmlaq_f32(vmlaq_f32(trans4, xy, scale4), yx, skew4));
+            src += 2;
+            dst += 2;
+        }
+#else
         Sk4s trans4(tx, ty, tx, ty);
         Sk4s scale4(sx, sy, sx, sy);
         Sk4s  skew4(kx, ky, kx, ky);    // applied to swizzle of src4
-        count >>= 1;
         for (int i = 0; i < count; ++i) {
             Sk4s src4 = Sk4s::Load(&src->fX);
             Sk4s swz4(src[0].fY, src[0].fX, src[1].fY, src[1].fX);  // need ABCD -> BADC
@@ -992,6 +1030,7 @@ void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[]
             src += 2;
             dst += 2;
         }
+#endif
     }
 }
 
@@ -1061,9 +1100,28 @@ void SkMatrix::mapVectors(SkPoint dst[], const SkPoint src[], int count) const {
     }
 }
 
+void SkMatrix::mapRectScaleTranslate(SkRect* dst, const SkRect& src) const {
+    SkASSERT(dst);
+    SkASSERT(this->isScaleTranslate());
+
+    SkScalar sx = fMat[kMScaleX];
+    SkScalar sy = fMat[kMScaleY];
+    SkScalar tx = fMat[kMTransX];
+    SkScalar ty = fMat[kMTransY];
+    Sk4s scale(sx, sy, sx, sy);
+    Sk4s trans(tx, ty, tx, ty);
+    (Sk4s::Load(&src.fLeft) * scale + trans).store(&dst->fLeft);
+    // a negative scale swaps the sides
+    dst->sort();
+}
+
 bool SkMatrix::mapRect(SkRect* dst, const SkRect& src) const {
     SkASSERT(dst);
 
+    if (this->isScaleTranslate()) {
+        this->mapRectScaleTranslate(dst, src);
+        return true;
+    }
     if (this->rectStaysRect()) {
         this->mapPoints((SkPoint*)dst, (const SkPoint*)&src, 2);
         dst->sort();
@@ -1220,7 +1278,8 @@ bool SkMatrix::fixedStepInX(SkScalar y, SkFixed* stepX, SkFixed* stepY) const {
 #include "SkPerspIter.h"
 
 SkPerspIter::SkPerspIter(const SkMatrix& m, SkScalar x0, SkScalar y0, int count)
-        : fMatrix(m), fSX(x0), fSY(y0), fCount(count) {
+        : fMatrix(m), fSX(x0), fSY(y0), fCount(count)
+        , fBoundaryIndex(0), fBoundaryCount(0) {
     SkPoint pt;
 
     SkMatrix::Persp_xy(m, x0, y0, &pt);
@@ -1228,30 +1287,77 @@ SkPerspIter::SkPerspIter(const SkMatrix& m, SkScalar x0, SkScalar y0, int count)
     fY = SkScalarToFixed(pt.fY);
 }
 
-int SkPerspIter::next() {
-    int n = fCount;
+void SkPerspIter::loadBoundaries() {
+    SkScalar sx[kBatch];
+    SkScalar nextSX = fSX;
+    int remaining = fCount;
+    int used = 0;
+
+    for (; used < kBatch && remaining > 0; ++used) {
+        int n = SkMin32(remaining, (int)kCount);
+        nextSX += SkIntToScalar(n);
+        sx[used] = nextSX;
+        fBoundaryN[used] = n;
+        remaining -= n;
+    }
+    for (int i = used; i < kBatch; ++i) {
+        // Duplicate the last boundary so the unused lanes stay benign.
+        sx[i] = nextSX;
+        fBoundaryN[i] = 0;
+    }
+    fSX = nextSX;
+    fBoundaryIndex = 0;
+    fBoundaryCount = used;
+
+    // Transform all of the boundary points at once; the lane arithmetic
+    // matches Persp_xy() term for term, so the results are identical.
+    Sk4s x4 = Sk4s::Load(sx);
+    Sk4s y4(fSY);
+    Sk4s vx = x4 * Sk4s(fMatrix[SkMatrix::kMScaleX])
+            + y4 * Sk4s(fMatrix[SkMatrix::kMSkewX])
+            + Sk4s(fMatrix[SkMatrix::kMTransX]);
+    Sk4s vy = x4 * Sk4s(fMatrix[SkMatrix::kMSkewY])
+            + y4 * Sk4s(fMatrix[SkMatrix::kMScaleY])
+            + Sk4s(fMatrix[SkMatrix::kMTransY]);
+    Sk4s vz = x4 * Sk4s(fMatrix[SkMatrix::kMPersp0])
+            + y4 * Sk4s(fMatrix[SkMatrix::kMPersp1])
+            + Sk4s(fMatrix[SkMatrix::kMPersp2]);
+
+    if ((vz == Sk4s(0)).anyTrue()) {
+        // A boundary on the horizon: Persp_xy() pins z == 0 to the origin
+        // rather than infinity, so take the scalar transform for the batch.
+        for (int i = 0; i < used; ++i) {
+            SkPoint pt;
+            SkMatrix::Persp_xy(fMatrix, sx[i], fSY, &pt);
+            fBoundaryX[i] = pt.fX;
+            fBoundaryY[i] = pt.fY;
+        }
+    } else {
+        Sk4s iz = vz.invert();
+        (vx * iz).store(fBoundaryX);
+        (vy * iz).store(fBoundaryY);
+    }
+}
 
-    if (0 == n) {
+int SkPerspIter::next() {
+    if (0 == fCount) {
         return 0;
     }
-    SkPoint pt;
+    if (fBoundaryIndex == fBoundaryCount) {
+        this->loadBoundaries();
+    }
     SkFixed x = fX;
     SkFixed y = fY;
     SkFixed dx, dy;
 
-    if (n >= kCount) {
-        n = kCount;
-        fSX += SkIntToScalar(kCount);
-        SkMatrix::Persp_xy(fMatrix, fSX, fSY, &pt);
-        fX = SkScalarToFixed(pt.fX);
-        fY = SkScalarToFixed(pt.fY);
+    const int n = fBoundaryN[fBoundaryIndex];
+    fX = SkScalarToFixed(fBoundaryX[fBoundaryIndex]);
+    fY = SkScalarToFixed(fBoundaryY[fBoundaryIndex]);
+    fBoundaryIndex += 1;
+    if (kCount == n) {
         dx = (fX - x) >> kShift;
         dy = (fY - y) >> kShift;
     } else {
-        fSX += SkIntToScalar(n);
-        SkMatrix::Persp_xy(fMatrix, fSX, fSY, &pt);
-        fX = SkScalarToFixed(pt.fX);
-        fY = SkScalarToFixed(pt.fY);
         dx = (fX - x) / n;
         dy = (fY - y) / n;
     }
@@ -8,6 +8,7 @@
 #ifndef SkMessageBus_DEFINED
 #define SkMessageBus_DEFINED
 
+#include "SkAtomics.h"
 #include "SkLazyPtr.h"
 #include "SkTArray.h"
 #include "SkTDArray.h"
@@ -29,8 +30,16 @@ public:
         void poll(SkTArray<Message>* out);
 
     private:
-        SkTArray<Message>  fMessages;
-        SkMutex            fMessagesMutex;
+        struct Node {
+            explicit Node(const Message& m) : fMessage(m), fNext(NULL) {}
+            Message fMessage;
+            Node*   fNext;
+        };
+
+        // Top of an intrusive stack of unread messages, newest first.  Posting threads push
+        // with a compare-and-swap; only poll() (single consumer) ever detaches nodes, by
+        // swapping the whole stack out at once.  So receive() never takes a lock.
+        Node* fTop;
 
         friend class SkMessageBus;
         void receive(const Message& m);  // SkMessageBus is a friend only to call this.
@@ -59,7 +68,7 @@ private:
 //   ----------------------- Implementation of SkMessageBus::Inbox -----------------------
 
 template<typename Message>
-SkMessageBus<Message>::Inbox::Inbox() {
+SkMessageBus<Message>::Inbox::Inbox() : fTop(NULL) {
     // Register ourselves with the corresponding message bus.
     SkMessageBus<Message>* bus = SkMessageBus<Message>::Get();
     SkAutoMutexAcquire lock(bus->fInboxesMutex);
@@ -78,20 +87,44 @@ SkMessageBus<Message>::Inbox::~Inbox() {
             break;
         }
     }
+    // No one can post to us anymore, so any leftover messages are ours to throw out.
+    Node* node = sk_atomic_exchange(&fTop, static_cast<Node*>(NULL), sk_memory_order_acquire);
+    while (node) {
+        Node* next = node->fNext;
+        SkDELETE(node);
+        node = next;
+    }
 }
 
 template<typename Message>
 void SkMessageBus<Message>::Inbox::receive(const Message& m) {
-    SkAutoMutexAcquire lock(fMessagesMutex);
-    fMessages.push_back(m);
+    Node* node = SkNEW_ARGS(Node, (m));
+    node->fNext = sk_atomic_load(&fTop, sk_memory_order_relaxed);
+    // Push onto the stack.  On failure the compare-exchange refreshes node->fNext for us.
+    while (!sk_atomic_compare_exchange(&fTop, &node->fNext, node,
+                                       sk_memory_order_release, sk_memory_order_relaxed)) {}
 }
 
 template<typename Message>
 void SkMessageBus<Message>::Inbox::poll(SkTArray<Message>* messages) {
     SkASSERT(messages);
     messages->reset();
-    SkAutoMutexAcquire lock(fMessagesMutex);
-    fMessages.swap(messages);
+    // Grab the whole stack at once.  Acquire pairs with the release in receive().
+    Node* node = sk_atomic_exchange(&fTop, static_cast<Node*>(NULL), sk_memory_order_acquire);
+    // The stack is newest-first; reverse it so messages come out in the order they were posted.
+    Node* reversed = NULL;
+    while (node) {
+        Node* next = node->fNext;
+        node->fNext = reversed;
+        reversed = node;
+        node = next;
+    }
+    while (reversed) {
+        messages->push_back(reversed->fMessage);
+        Node* next = reversed->fNext;
+        SkDELETE(reversed);
+        reversed = next;
+    }
 }
 
 //   ----------------------- Implementation of SkMessageBus -----------------------
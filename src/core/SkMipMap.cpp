@@ -8,6 +8,14 @@
 #include "SkMipMap.h"
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
+
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
 
 static void downsample32_nocheck(void* dst, int, int, const void* srcPtr, const SkBitmap& srcBM) {
     const uint32_t* p = static_cast<const uint32_t*>(srcPtr);
@@ -59,6 +67,63 @@ static void downsample32_check(void* dst, int x, int y, const void* srcPtr, cons
     *((uint32_t*)dst) = ((rb >> 2) & 0xFF00FF) | ((ag << 6) & 0xFF00FF00);
 }
 
+// Downsamples a run of |count| 2x2 blocks whose top-left pixel is at |srcPtr|,
+// writing |count| pixels. The caller guarantees both source rows cover
+// 2 * count pixels, i.e. the odd right column has been peeled off, so no
+// per-pixel edge checks are needed. Produces the same truncating
+// (sum >> 2) averages as downsample32_nocheck.
+static void downsample32_row(void* dst, const void* srcPtr, const SkBitmap& srcBM, int count) {
+    const uint32_t* row0 = static_cast<const uint32_t*>(srcPtr);
+    uint32_t* out = static_cast<uint32_t*>(dst);
+
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const uint32_t* row1 = row0 + (srcBM.rowBytes() >> 2);
+    const __m128i zero = _mm_setzero_si128();
+    while (count >= 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1));
+        // 16-bit per-channel sums of the two rows; lo holds columns 0,1 of
+        // this pair of blocks, hi holds columns 2,3.
+        __m128i vlo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero),
+                                    _mm_unpacklo_epi8(b, zero));
+        __m128i vhi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero),
+                                    _mm_unpackhi_epi8(b, zero));
+        // Add the left and right column of each block, divide, and repack.
+        __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(vlo, vhi),
+                                    _mm_unpackhi_epi64(vlo, vhi));
+        sum = _mm_srli_epi16(sum, 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out),
+                         _mm_packus_epi16(sum, sum));
+        row0 += 4;
+        row1 += 4;
+        out += 2;
+        count -= 2;
+    }
+#elif defined(SK_ARM_HAS_NEON)
+    const uint32_t* row1 = row0 + (srcBM.rowBytes() >> 2);
+    while (count >= 2) {
+        uint8x16_t a = vld1q_u8(reinterpret_cast<const uint8_t*>(row0));
+        uint8x16_t b = vld1q_u8(reinterpret_cast<const uint8_t*>(row1));
+        uint16x8_t v0 = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+        uint16x8_t v1 = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+        uint16x4_t d0 = vadd_u16(vget_low_u16(v0), vget_high_u16(v0));
+        uint16x4_t d1 = vadd_u16(vget_low_u16(v1), vget_high_u16(v1));
+        vst1_u8(reinterpret_cast<uint8_t*>(out),
+                vshrn_n_u16(vcombine_u16(d0, d1), 2));
+        row0 += 4;
+        row1 += 4;
+        out += 2;
+        count -= 2;
+    }
+#endif
+    while (count > 0) {
+        downsample32_nocheck(out, 0, 0, row0, srcBM);
+        row0 += 2;
+        out += 1;
+        count -= 1;
+    }
+}
+
 static inline uint32_t expand16(U16CPU c) {
     return (c & ~SK_G16_MASK_IN_PLACE) | ((c & SK_G16_MASK_IN_PLACE) << 16);
 }
@@ -180,9 +245,66 @@ size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
 }
 
 typedef void SkDownSampleProc(void*, int x, int y, const void* srcPtr, const SkBitmap& srcBM);
+typedef void SkDownSampleRowProc(void* dst, const void* srcPtr, const SkBitmap& srcBM, int count);
+
+namespace {
+
+// A run of destination rows of one mip level. Bands write disjoint rows of
+// the same level and only read the (locked) source level, so tall levels can
+// be downsampled on several threads at once.
+struct MipLevelBand {
+    const SkBitmap* fSrc;
+    const SkBitmap* fDst;
+    SkDownSampleProc* fProcNoCheck;
+    SkDownSampleProc* fProcCheck;
+    SkDownSampleRowProc* fRowProc;  // may be NULL
+    int fYStart;
+    int fYEnd;                      // never includes the odd bottom row
+};
+
+}  // namespace
+
+static void downsample_band(MipLevelBand* band) {
+    const SkBitmap& srcBM = *band->fSrc;
+    const SkBitmap& dstBM = *band->fDst;
+    const int width = dstBM.width();
+    const int widthEven = width & ~1;
+    const size_t pixelSize = srcBM.info().bytesPerPixel();
+
+    const char* srcBasePtr = (const char*)srcBM.getPixels()
+                           + srcBM.rowBytes() * 2 * band->fYStart;
+    char* dstBasePtr = (char*)dstBM.getPixels()
+                     + dstBM.rowBytes() * band->fYStart;
+
+    for (int y = band->fYStart; y < band->fYEnd; y++) {
+        const void* srcPtr = srcBasePtr;
+        void* dstPtr = dstBasePtr;
+        if (band->fRowProc && widthEven > 0) {
+            band->fRowProc(dstPtr, srcPtr, srcBM, widthEven);
+            srcPtr = (const char*)srcPtr + pixelSize * 2 * widthEven;
+            dstPtr = (char*)dstPtr + pixelSize * widthEven;
+        } else {
+            for (int x = 0; x < widthEven; x++) {
+                band->fProcNoCheck(dstPtr, x, y, srcPtr, srcBM);
+                srcPtr = (const char*)srcPtr + pixelSize * 2;
+                dstPtr = (char*)dstPtr + pixelSize;
+            }
+        }
+        if (width & 1) {
+            band->fProcCheck(dstPtr, widthEven, y, srcPtr, srcBM);
+        }
+        srcBasePtr += srcBM.rowBytes() * 2;
+        dstBasePtr += dstBM.rowBytes();
+    }
+}
+
+// Below this many rows per band the task handoff costs more than it saves;
+// levels shrink fast enough that only the first level or two go parallel.
+static const int kMinRowsPerBand = 32;
 
 SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
     SkDownSampleProc* proc_nocheck, *proc_check;
+    SkDownSampleRowProc* proc_row = NULL;
 
     const SkColorType ct = src.colorType();
     const SkAlphaType at = src.alphaType();
@@ -191,6 +313,7 @@ SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
         case kBGRA_8888_SkColorType:
             proc_check = downsample32_check;
             proc_nocheck = downsample32_nocheck;
+            proc_row = downsample32_row;
             break;
         case kRGB_565_SkColorType:
             proc_check = downsample16;
@@ -277,30 +400,38 @@ SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
         dstBM.installPixels(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
 
         srcBM.lockPixels();
-        const int widthEven = width & ~1;
         const int heightEven = height & ~1;
         const size_t pixelSize = srcBM.info().bytesPerPixel();
 
-        const void* srcBasePtr = srcBM.getPixels();
-        void* dstBasePtr = dstBM.getPixels();
-        for (int y = 0; y < heightEven; y++) {
-            const void* srcPtr = srcBasePtr;
-            void* dstPtr = dstBasePtr;
-            for (int x = 0; x < widthEven; x++) {
-                proc_nocheck(dstPtr, x, y, srcPtr, srcBM);
-                srcPtr = (char*)srcPtr + pixelSize * 2;
-                dstPtr = (char*)dstPtr + pixelSize;
-            }
-            if (width & 1) {
-                proc_check(dstPtr, widthEven, y, srcPtr, srcBM);
+        MipLevelBand band;
+        band.fSrc = &srcBM;
+        band.fDst = &dstBM;
+        band.fProcNoCheck = proc_nocheck;
+        band.fProcCheck = proc_check;
+        band.fRowProc = proc_row;
+
+        const int bandCount = heightEven / kMinRowsPerBand;
+        if (bandCount < 2) {
+            band.fYStart = 0;
+            band.fYEnd = heightEven;
+            downsample_band(&band);
+        } else {
+            SkAutoSTMalloc<8, MipLevelBand> bands(bandCount);
+            for (int b = 0; b < bandCount; b++) {
+                bands.get()[b] = band;
+                bands.get()[b].fYStart = b * kMinRowsPerBand;
+                bands.get()[b].fYEnd = (b + 1 == bandCount)
+                                     ? heightEven
+                                     : (b + 1) * kMinRowsPerBand;
             }
-
-            srcBasePtr = (char*)srcBasePtr + srcBM.rowBytes() * 2;
-            dstBasePtr = (char*)dstBasePtr + dstBM.rowBytes();
+            SkTaskGroup().batch(downsample_band, bands.get(), bandCount);
         }
+
         if (height & 1) {
-            const void* srcPtr = srcBasePtr;
-            void* dstPtr = dstBasePtr;
+            const void* srcPtr = (const char*)srcBM.getPixels()
+                               + srcBM.rowBytes() * 2 * heightEven;
+            void* dstPtr = (char*)dstBM.getPixels()
+                         + dstBM.rowBytes() * heightEven;
             for (int x = 0; x < width; x++) {
                 proc_check(dstPtr, x, heightEven, srcPtr, srcBM);
                 srcPtr = (char*)srcPtr + pixelSize * 2;
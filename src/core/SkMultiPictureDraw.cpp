@@ -12,6 +12,7 @@
 #include "SkCanvasPriv.h"
 #include "SkMultiPictureDraw.h"
 #include "SkPicture.h"
+#include "SkTSort.h"
 #include "SkTaskGroup.h"
 
 #if SK_SUPPORT_GPU
@@ -23,12 +24,19 @@
 
 void SkMultiPictureDraw::DrawData::draw() {
     fCanvas->drawPicture(fPicture, &fMatrix, fPaint);
+    if (fDoneProc) {
+        fDoneProc(fDoneCtx, fIndex);
+    }
 }
 
 void SkMultiPictureDraw::DrawData::init(SkCanvas* canvas, const SkPicture* picture,
-                                        const SkMatrix* matrix, const SkPaint* paint) {
+                                        const SkMatrix* matrix, const SkPaint* paint,
+                                        int index) {
     fPicture = SkRef(picture);
     fCanvas = SkRef(canvas);
+    fIndex = index;
+    fDoneProc = NULL;
+    fDoneCtx = NULL;
     if (matrix) {
         fMatrix = *matrix;
     } else {
@@ -52,16 +60,25 @@ void SkMultiPictureDraw::DrawData::Reset(SkTDArray<DrawData>& data) {
 
 //////////////////////////////////////////////////////////////////////////////////////
 
-SkMultiPictureDraw::SkMultiPictureDraw(int reserve) {
+SkMultiPictureDraw::SkMultiPictureDraw(int reserve)
+    : fDoneProc(NULL)
+    , fDoneCtx(NULL)
+    , fNextIndex(0) {
     if (reserve > 0) {
         fGPUDrawData.setReserve(reserve);
         fThreadSafeDrawData.setReserve(reserve);
     }
 }
 
+void SkMultiPictureDraw::setCompletionCallback(CompletionProc proc, void* context) {
+    fDoneProc = proc;
+    fDoneCtx = context;
+}
+
 void SkMultiPictureDraw::reset() {
     DrawData::Reset(fGPUDrawData);
     DrawData::Reset(fThreadSafeDrawData);
+    fNextIndex = 0;
 }
 
 void SkMultiPictureDraw::add(SkCanvas* canvas,
@@ -74,7 +91,58 @@ void SkMultiPictureDraw::add(SkCanvas* canvas,
     }
 
     SkTDArray<DrawData>& array = canvas->getGrContext() ? fGPUDrawData : fThreadSafeDrawData;
-    array.append()->init(canvas, picture, matrix, paint);
+    array.append()->init(canvas, picture, matrix, paint, fNextIndex++);
+}
+
+void SkMultiPictureDraw::addTiled(SkCanvas* canvas,
+                                  const SkPicture* picture,
+                                  const SkMatrix* matrix,
+                                  const SkPaint* paint,
+                                  int tileSize) {
+    if (NULL == canvas || NULL == picture) {
+        SkDEBUGFAIL("parameters to SkMultiPictureDraw::addTiled should be non-NULL");
+        return;
+    }
+
+    SkImageInfo info;
+    size_t rowBytes;
+    SkIPoint origin;
+    void* pixels = canvas->getGrContext()
+            ? NULL
+            : canvas->accessTopLayerPixels(&info, &rowBytes, &origin);
+
+    SkIRect clip;
+    if (NULL == pixels || tileSize <= 0 || !canvas->getClipDeviceBounds(&clip)
+            || (paint && paint->getImageFilter())) {
+        this->add(canvas, picture, matrix, paint);
+        return;
+    }
+
+    // Each tile gets its own canvas over the shared pixels, clipped to its slice of the
+    // device.  The clips are disjoint and raster blits never stray outside the clip, so
+    // the tiles can be replayed in parallel.  Playback through each tile canvas queries
+    // the picture's BBH against that tile's clip, so every task only touches the ops
+    // that actually intersect its tile.
+    SkMatrix layerMatrix = canvas->getTotalMatrix();
+    layerMatrix.postTranslate(SkIntToScalar(-origin.x()), SkIntToScalar(-origin.y()));
+
+    for (int y = clip.top(); y < clip.bottom(); y += tileSize) {
+        for (int x = clip.left(); x < clip.right(); x += tileSize) {
+            SkIRect tile = SkIRect::MakeXYWH(x, y, tileSize, tileSize);
+            SkAssertResult(tile.intersect(clip));
+            tile.offset(-origin.x(), -origin.y());  // Device coords -> top layer coords.
+
+            SkAutoTUnref<SkCanvas> tileCanvas(SkCanvas::NewRasterDirect(info, pixels, rowBytes));
+            if (NULL == tileCanvas) {
+                this->add(canvas, picture, matrix, paint);
+                return;
+            }
+            tileCanvas->clipRect(SkRect::Make(tile));
+            tileCanvas->setMatrix(layerMatrix);
+
+            fThreadSafeDrawData.append()->init(tileCanvas, picture, matrix, paint, fNextIndex++);
+        }
+    }
 }
 
 class AutoMPDReset : SkNoncopyable {
@@ -95,6 +163,22 @@ void SkMultiPictureDraw::draw(bool flush) {
         dd->fCanvas->drawPicture(dd->fPicture, &dd->fMatrix, dd->fPaint);
     }
 #else
+    // Hand the biggest pictures to the task group first: its queue is shared, so idle
+    // threads just pull the next entry, and this greedy order keeps one long picture
+    // from being started last and left running alone at the end.
+    struct CostlierThan {
+        bool operator()(const DrawData& a, const DrawData& b) const {
+            return a.fPicture->approximateOpCount() > b.fPicture->approximateOpCount();
+        }
+    };
+    if (fThreadSafeDrawData.count() > 1) {
+        SkTQSort(fThreadSafeDrawData.begin(), fThreadSafeDrawData.end() - 1, CostlierThan());
+    }
+    for (int i = 0; i < fThreadSafeDrawData.count(); ++i) {
+        fThreadSafeDrawData[i].fDoneProc = fDoneProc;
+        fThreadSafeDrawData[i].fDoneCtx = fDoneCtx;
+    }
+
     // we place the taskgroup after the MPDReset, to ensure that we don't delete the DrawData
     // objects until after we're finished the tasks (which have pointers to the data).
     SkTaskGroup group;
@@ -195,6 +279,9 @@ void SkMultiPictureDraw::draw(bool flush) {
         if (flush) {
             canvas->flush();
         }
+        if (fDoneProc) {
+            fDoneProc(fDoneCtx, data.fIndex);
+        }
     }
 
 #if !defined(SK_IGNORE_GPU_LAYER_HOISTING) && SK_SUPPORT_GPU
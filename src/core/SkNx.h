@@ -62,6 +62,9 @@ public:
     static SkNi Min(const SkNi& a, const SkNi& b) {
         return SkNi(SkNi<N/2, T>::Min(a.fLo, b.fLo), SkNi<N/2, T>::Min(a.fHi, b.fHi));
     }
+    static SkNi Max(const SkNi& a, const SkNi& b) {
+        return SkNi(SkNi<N/2, T>::Max(a.fLo, b.fLo), SkNi<N/2, T>::Max(a.fHi, b.fHi));
+    }
     SkNi operator < (const SkNi& o) const { return SkNi(fLo < o.fLo, fHi < o.fHi); }
 
     template <int k> T kth() const {
@@ -177,6 +180,7 @@ public:
     SkNi operator >> (int bits) const { return SkNi(fVal >> bits); }
 
     static SkNi Min(const SkNi& a, const SkNi& b) { return SkNi(SkTMin(a.fVal, b.fVal)); }
+    static SkNi Max(const SkNi& a, const SkNi& b) { return SkNi(SkTMax(a.fVal, b.fVal)); }
     SkNi operator <(const SkNi& o) const { return SkNi(fVal < o.fVal); }
 
     template <int k> T kth() const {
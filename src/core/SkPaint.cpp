@@ -18,6 +18,7 @@
 #include "SkImageFilter.h"
 #include "SkMaskFilter.h"
 #include "SkMaskGamma.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkPaintDefaults.h"
@@ -27,10 +28,13 @@
 #include "SkScalerContext.h"
 #include "SkShader.h"
 #include "SkStringUtils.h"
+#include "SkStrokedPathCache.h"
 #include "SkStroke.h"
 #include "SkTextFormatParams.h"
 #include "SkTextToPathIter.h"
+#include "SkThread.h"
 #include "SkTLazy.h"
+#include "SkTLS.h"
 #include "SkTypeface.h"
 #include "SkXfermode.h"
 
@@ -66,6 +70,8 @@ SkPaint::SkPaint() {
     fBitfields.fStyle        = kFill_Style;
     fBitfields.fTextEncoding = kUTF8_TextEncoding;
     fBitfields.fHinting      = SkPaintDefaults_Hinting;
+
+    fGenerationID = 0;
 }
 
 SkPaint::SkPaint(const SkPaint& src) {
@@ -90,6 +96,7 @@ SkPaint::SkPaint(const SkPaint& src) {
     COPY(fWidth);
     COPY(fMiterLimit);
     COPY(fBitfields);
+    COPY(fGenerationID);
 
 #undef COPY
 #undef REF_COPY
@@ -134,6 +141,7 @@ SkPaint& SkPaint::operator=(const SkPaint& src) {
     COPY(fWidth);
     COPY(fMiterLimit);
     COPY(fBitfields);
+    COPY(fGenerationID);
 
     return *this;
 
@@ -169,16 +177,36 @@ void SkPaint::reset() {
     *this = init;
 }
 
+static uint32_t next_paint_generation_id() {
+    static int32_t gNextID = 0;
+    uint32_t id;
+    // Loop in case our global wraps around, as we never want to return 0.
+    do {
+        id = (uint32_t)sk_atomic_inc(&gNextID) + 1;
+    } while (0 == id);
+    return id;
+}
+
+uint32_t SkPaint::getGenerationID() const {
+    if (0 == fGenerationID) {
+        fGenerationID = next_paint_generation_id();
+    }
+    return fGenerationID;
+}
+
 void SkPaint::setFilterQuality(SkFilterQuality quality) {
     fBitfields.fFilterQuality = quality;
+    fGenerationID = 0;
 }
 
 void SkPaint::setHinting(Hinting hintingLevel) {
     fBitfields.fHinting = hintingLevel;
+    fGenerationID = 0;
 }
 
 void SkPaint::setFlags(uint32_t flags) {
     fBitfields.fFlags = flags;
+    fGenerationID = 0;
 }
 
 void SkPaint::setAntiAlias(bool doAA) {
@@ -236,6 +264,7 @@ void SkPaint::setDistanceFieldTextTEMP(bool doDistanceFieldText) {
 void SkPaint::setStyle(Style style) {
     if ((unsigned)style < kStyleCount) {
         fBitfields.fStyle = style;
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setStyle(%d) out of range\n", style);
@@ -245,6 +274,7 @@ void SkPaint::setStyle(Style style) {
 
 void SkPaint::setColor(SkColor color) {
     fColor = color;
+    fGenerationID = 0;
 }
 
 void SkPaint::setAlpha(U8CPU a) {
@@ -259,6 +289,7 @@ void SkPaint::setARGB(U8CPU a, U8CPU r, U8CPU g, U8CPU b) {
 void SkPaint::setStrokeWidth(SkScalar width) {
     if (width >= 0) {
         fWidth = width;
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setStrokeWidth() called with negative value\n");
@@ -269,6 +300,7 @@ void SkPaint::setStrokeWidth(SkScalar width) {
 void SkPaint::setStrokeMiter(SkScalar limit) {
     if (limit >= 0) {
         fMiterLimit = limit;
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setStrokeMiter() called with negative value\n");
@@ -279,6 +311,7 @@ void SkPaint::setStrokeMiter(SkScalar limit) {
 void SkPaint::setStrokeCap(Cap ct) {
     if ((unsigned)ct < kCapCount) {
         fBitfields.fCapType = SkToU8(ct);
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setStrokeCap(%d) out of range\n", ct);
@@ -289,6 +322,7 @@ void SkPaint::setStrokeCap(Cap ct) {
 void SkPaint::setStrokeJoin(Join jt) {
     if ((unsigned)jt < kJoinCount) {
         fBitfields.fJoinType = SkToU8(jt);
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setStrokeJoin(%d) out of range\n", jt);
@@ -301,6 +335,7 @@ void SkPaint::setStrokeJoin(Join jt) {
 void SkPaint::setTextAlign(Align align) {
     if ((unsigned)align < kAlignCount) {
         fBitfields.fTextAlign = SkToU8(align);
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setTextAlign(%d) out of range\n", align);
@@ -311,6 +346,7 @@ void SkPaint::setTextAlign(Align align) {
 void SkPaint::setTextSize(SkScalar ts) {
     if (ts >= 0) {
         fTextSize = ts;
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setTextSize() called with negative value\n");
@@ -320,15 +356,18 @@ void SkPaint::setTextSize(SkScalar ts) {
 
 void SkPaint::setTextScaleX(SkScalar scaleX) {
     fTextScaleX = scaleX;
+    fGenerationID = 0;
 }
 
 void SkPaint::setTextSkewX(SkScalar skewX) {
     fTextSkewX = skewX;
+    fGenerationID = 0;
 }
 
 void SkPaint::setTextEncoding(TextEncoding encoding) {
     if ((unsigned)encoding <= kGlyphID_TextEncoding) {
         fBitfields.fTextEncoding = encoding;
+        fGenerationID = 0;
     } else {
 #ifdef SK_REPORT_API_RANGE_CHECK
         SkDebugf("SkPaint::setTextEncoding(%d) out of range\n", encoding);
@@ -340,26 +379,31 @@ void SkPaint::setTextEncoding(TextEncoding encoding) {
 
 SkTypeface* SkPaint::setTypeface(SkTypeface* font) {
     SkRefCnt_SafeAssign(fTypeface, font);
+    fGenerationID = 0;
     return font;
 }
 
 SkRasterizer* SkPaint::setRasterizer(SkRasterizer* r) {
     SkRefCnt_SafeAssign(fRasterizer, r);
+    fGenerationID = 0;
     return r;
 }
 
 SkDrawLooper* SkPaint::setLooper(SkDrawLooper* looper) {
     SkRefCnt_SafeAssign(fLooper, looper);
+    fGenerationID = 0;
     return looper;
 }
 
 SkImageFilter* SkPaint::setImageFilter(SkImageFilter* imageFilter) {
     SkRefCnt_SafeAssign(fImageFilter, imageFilter);
+    fGenerationID = 0;
     return imageFilter;
 }
 
 SkAnnotation* SkPaint::setAnnotation(SkAnnotation* annotation) {
     SkRefCnt_SafeAssign(fAnnotation, annotation);
+    fGenerationID = 0;
     return annotation;
 }
 
@@ -826,6 +870,81 @@ static SkFixed advance(const SkGlyph& glyph, int xyIndex) {
     return (&glyph.fAdvanceX)[xyIndex];
 }
 
+// Resolve the run to glyph IDs up front, so advances can then be fetched as
+// one contiguous array. Returns the glyph count; *glyphs points either into
+// the original text (glyph encoding) or into storage.
+static int resolve_text_to_glyphs(const SkPaint& paint, SkGlyphCache* cache,
+                                  const char* text, size_t byteLength,
+                                  SkAutoSTMalloc<64, uint16_t>* storage,
+                                  const uint16_t** glyphs) {
+    if (SkPaint::kGlyphID_TextEncoding == paint.getTextEncoding()) {
+        *glyphs = (const uint16_t*)text;
+        return SkToInt(byteLength >> 1);
+    }
+
+    const int count = paint.countText(text, byteLength);
+    storage->reset(count);
+    uint16_t* gptr = storage->get();
+
+    const char* stop = text + byteLength;
+    switch (paint.getTextEncoding()) {
+        case SkPaint::kUTF8_TextEncoding:
+            while (text < stop) {
+                *gptr++ = cache->unicharToGlyph(SkUTF8_NextUnichar(&text));
+            }
+            break;
+        case SkPaint::kUTF16_TextEncoding: {
+            const uint16_t* text16 = (const uint16_t*)text;
+            const uint16_t* stop16 = (const uint16_t*)stop;
+            while (text16 < stop16) {
+                *gptr++ = cache->unicharToGlyph(SkUTF16_NextUnichar(&text16));
+            }
+            break;
+        }
+        case SkPaint::kUTF32_TextEncoding: {
+            const int32_t* text32 = (const int32_t*)text;
+            const int32_t* stop32 = (const int32_t*)stop;
+            while (text32 < stop32) {
+                *gptr++ = cache->unicharToGlyph(*text32++);
+            }
+            break;
+        }
+        default:
+            SkDEBUGFAIL("unknown text encoding");
+    }
+    *glyphs = storage->get();
+    return count;
+}
+
+// Batch width-only measurement: one glyph-ID resolve, one contiguous advance
+// fetch (just-advance metrics only), and a four-lane sum.
+static SkScalar measure_text_batch(const SkPaint& paint, SkGlyphCache* cache,
+                                   const char* text, size_t byteLength, int* count) {
+    SkAutoSTMalloc<64, uint16_t> glyphStorage(0);
+    const uint16_t* glyphs;
+    const int n = resolve_text_to_glyphs(paint, cache, text, byteLength, &glyphStorage, &glyphs);
+
+    *count = n;
+    if (0 == n) {
+        return 0;
+    }
+
+    SkAutoSTMalloc<64, SkScalar> advanceStorage(n);
+    SkScalar* advances = advanceStorage.get();
+    cache->getGlyphIDAdvances(glyphs, n, paint.isVerticalText(), advances);
+
+    Sk4s sum4(0);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        sum4 = sum4 + Sk4s::Load(advances + i);
+    }
+    SkScalar width = sum4.kth<0>() + sum4.kth<1>() + sum4.kth<2>() + sum4.kth<3>();
+    for (; i < n; ++i) {
+        width += advances[i];
+    }
+    return width;
+}
+
 SkScalar SkPaint::measure_text(SkGlyphCache* cache,
                                const char* text, size_t byteLength,
                                int* count, SkRect* bounds) const {
@@ -838,6 +957,10 @@ SkScalar SkPaint::measure_text(SkGlyphCache* cache,
         return 0;
     }
 
+    if (NULL == bounds && !this->isDevKernText()) {
+        return measure_text_batch(*this, cache, text, byteLength, count);
+    }
+
     SkMeasureCacheProc glyphCacheProc = this->getMeasureCacheProc(NULL != bounds);
 
     int xyIndex;
@@ -1081,6 +1204,28 @@ int SkPaint::getTextWidths(const void* textData, size_t byteLength,
 
     SkAutoGlyphCache    autoCache(paint, NULL, NULL);
     SkGlyphCache*       cache = autoCache.getCache();
+
+    if (widths && NULL == bounds && !this->isDevKernText()) {
+        // Batch path: one glyph-ID resolve, then the advances land directly
+        // in widths[] as one contiguous fetch, scaled four lanes at a time.
+        SkAutoSTMalloc<64, uint16_t> glyphStorage(0);
+        const uint16_t* glyphs;
+        const int n = resolve_text_to_glyphs(paint, cache, (const char*)textData, byteLength,
+                                             &glyphStorage, &glyphs);
+        cache->getGlyphIDAdvances(glyphs, n, paint.isVerticalText(), widths);
+        if (scale) {
+            const Sk4s scale4(scale);
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                (Sk4s::Load(widths + i) * scale4).store(widths + i);
+            }
+            for (; i < n; ++i) {
+                widths[i] = SkScalarMul(widths[i], scale);
+            }
+        }
+        return n;
+    }
+
     SkMeasureCacheProc  glyphCacheProc;
     glyphCacheProc = paint.getMeasureCacheProc(NULL != bounds);
 
@@ -1728,6 +1873,81 @@ void SkPaint::getScalerContextDescriptor(SkAutoDescriptor* ad,
 #endif
 }
 
+namespace {
+
+/*  Per-thread memo of the most recent descriptor built by descriptorProc(). The key is the
+ *  paint's generation ID plus the other inputs that feed the descriptor. A single entry is
+ *  enough to cover the common case of many consecutive text calls with the same paint, and
+ *  keeping it per-thread means no locking.
+ */
+struct DescriptorMemo {
+    uint32_t        fGenID;         // 0 means empty
+    bool            fHasMatrix;
+    SkMatrix        fMatrix;
+    bool            fHasProps;
+    float           fGamma;
+    SkPixelGeometry fPixelGeometry;
+    bool            fAllowThreadedRaster;
+    bool            fIgnoreGamma;
+    SkDescriptor*   fDesc;
+
+    bool matches(uint32_t genID, const SkDeviceProperties* props, const SkMatrix* matrix,
+                 bool ignoreGamma) const {
+        if (genID != fGenID || ignoreGamma != fIgnoreGamma) {
+            return false;
+        }
+        if (fHasMatrix != (NULL != matrix) || (matrix && *matrix != fMatrix)) {
+            return false;
+        }
+        if (fHasProps != (NULL != props)) {
+            return false;
+        }
+        if (props && (props->gamma() != fGamma ||
+                      props->pixelGeometry() != fPixelGeometry ||
+                      props->allowThreadedRaster() != fAllowThreadedRaster)) {
+            return false;
+        }
+        return true;
+    }
+
+    void set(uint32_t genID, const SkDeviceProperties* props, const SkMatrix* matrix,
+             bool ignoreGamma, const SkDescriptor* desc) {
+        fGenID = genID;
+        fHasMatrix = NULL != matrix;
+        if (matrix) {
+            fMatrix = *matrix;
+        }
+        fHasProps = NULL != props;
+        if (props) {
+            fGamma = props->gamma();
+            fPixelGeometry = props->pixelGeometry();
+            fAllowThreadedRaster = props->allowThreadedRaster();
+        }
+        fIgnoreGamma = ignoreGamma;
+        SkDescriptor::Free(fDesc);
+        fDesc = desc->copy();
+    }
+
+    static void* CreateTLS() {
+        DescriptorMemo* memo = SkNEW(DescriptorMemo);
+        memo->fGenID = 0;
+        memo->fDesc = NULL;
+        return memo;
+    }
+
+    static void DeleteTLS(void* ptr) {
+        DescriptorMemo* memo = static_cast<DescriptorMemo*>(ptr);
+        SkDescriptor::Free(memo->fDesc);
+        SkDELETE(memo);
+    }
+
+    static DescriptorMemo* Get() {
+        return (DescriptorMemo*)SkTLS::Get(CreateTLS, DeleteTLS);
+    }
+};
+
+}  // namespace
+
 /*
  *  ignoreGamma tells us that the caller just wants metrics that are unaffected
  *  by gamma correction, so we set the rec to ignore preblend: i.e. gamma = 1,
@@ -1737,6 +1957,13 @@ void SkPaint::descriptorProc(const SkDeviceProperties* deviceProperties,
                              const SkMatrix* deviceMatrix,
                              void (*proc)(SkTypeface*, const SkDescriptor*, void*),
                              void* context, bool ignoreGamma) const {
+    DescriptorMemo* memo = DescriptorMemo::Get();
+    const uint32_t genID = this->getGenerationID();
+    if (memo->matches(genID, deviceProperties, deviceMatrix, ignoreGamma)) {
+        proc(fTypeface, memo->fDesc, context);
+        return;
+    }
+
     SkScalerContext::Rec    rec;
 
     SkPathEffect*   pe = this->getPathEffect();
@@ -1758,6 +1985,8 @@ void SkPaint::descriptorProc(const SkDeviceProperties* deviceProperties,
     test_desc(rec, pe, &peBuffer, mf, &mfBuffer, ra, &raBuffer, desc, descSize);
 #endif
 
+    memo->set(genID, deviceProperties, deviceMatrix, ignoreGamma, desc);
+
     proc(fTypeface, desc, context);
 }
 
@@ -2016,32 +2245,38 @@ void SkPaint::unflatten(SkReadBuffer& buffer) {
 
 SkShader* SkPaint::setShader(SkShader* shader) {
     SkRefCnt_SafeAssign(fShader, shader);
+    fGenerationID = 0;
     return shader;
 }
 
 SkColorFilter* SkPaint::setColorFilter(SkColorFilter* filter) {
     SkRefCnt_SafeAssign(fColorFilter, filter);
+    fGenerationID = 0;
     return filter;
 }
 
 SkXfermode* SkPaint::setXfermode(SkXfermode* mode) {
     SkRefCnt_SafeAssign(fXfermode, mode);
+    fGenerationID = 0;
     return mode;
 }
 
 SkXfermode* SkPaint::setXfermodeMode(SkXfermode::Mode mode) {
     SkSafeUnref(fXfermode);
     fXfermode = SkXfermode::Create(mode);
+    fGenerationID = 0;
     return fXfermode;
 }
 
 SkPathEffect* SkPaint::setPathEffect(SkPathEffect* effect) {
     SkRefCnt_SafeAssign(fPathEffect, effect);
+    fGenerationID = 0;
     return effect;
 }
 
 SkMaskFilter* SkPaint::setMaskFilter(SkMaskFilter* filter) {
     SkRefCnt_SafeAssign(fMaskFilter, filter);
+    fGenerationID = 0;
     return filter;
 }
 
@@ -2058,6 +2293,21 @@ bool SkPaint::getFillPath(const SkPath& src, SkPath* dst, const SkRect* cullRect
         srcPtr = &tmpPath;
     }
 
+    // Plain strokes of stable geometry hit the stroked-path cache. Path
+    // effect output is excluded: it can depend on per-draw state (cull rect,
+    // dash phase) that the cache key doesn't see.
+    if (srcPtr == &src && SkStrokedPathCache::UsableFor(src, rec)) {
+        if (SkStrokedPathCache::Find(src, rec, dst)) {
+            return true;
+        }
+        if (rec.applyToPath(dst, src)) {
+            SkStrokedPathCache::Add(src, rec, *dst);
+            return true;
+        }
+        // needToApply() promised applyToPath would succeed; fall through
+        // defensively.
+    }
+
     if (!rec.applyToPath(dst, *srcPtr)) {
         if (srcPtr == &tmpPath) {
             // If path's were copy-on-write, this trick would not be needed.
@@ -189,6 +189,15 @@ void SkPath::swap(SkPath& that) {
     }
 }
 
+void SkPath::GetBounds(const SkPath paths[], int count, SkRect bounds[]) {
+    // Paths that share an SkPathRef hit the cached answer after the first
+    // computes it; dirty ones take the vector min/max accumulation in
+    // SkRect::setBoundsCheck.
+    for (int i = 0; i < count; ++i) {
+        bounds[i] = paths[i].getBounds();
+    }
+}
+
 static inline bool check_edge_against_rect(const SkPoint& p0,
                                            const SkPoint& p1,
                                            const SkRect& rect,
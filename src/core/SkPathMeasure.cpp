@@ -10,7 +10,9 @@
 #include "SkPathMeasure.h"
 #include "SkGeometry.h"
 #include "SkPath.h"
+#include "SkResourceCache.h"
 #include "SkTSearch.h"
+#include "SkTemplates.h"
 
 // these must be 0,1,2,3 since they are in our 2-bit field
 enum {
@@ -153,6 +155,129 @@ SkScalar SkPathMeasure::compute_cubic_segs(const SkPoint pts[4],
     return distance;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+/*  Dashing (SkDashPath) builds a fresh SkPathMeasure -- and hence a fresh
+ *  distance table -- every time the same path is drawn. The table only
+ *  depends on the path's contents, so we keep a copy of each contour's
+ *  table in SkResourceCache, keyed by (genID, forceClosed, contour index).
+ *  Iteration over a given path is deterministic, so a cached contour's
+ *  segments, points and bookkeeping can be replayed verbatim into a later
+ *  measure of the same path.
+ */
+
+namespace {
+
+static unsigned gPathMeasureKeyNamespaceLabel;
+
+struct MeasureKey : public SkResourceCache::Key {
+    MeasureKey(uint32_t genID, bool forceClosed, int contourIndex) {
+        fGenID = genID;
+        fForceClosed = forceClosed;
+        fContourIndex = contourIndex;
+        this->init(&gPathMeasureKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fContourIndex));
+    }
+
+    uint32_t fGenID;
+    int32_t  fForceClosed;
+    int32_t  fContourIndex;
+};
+
+struct MeasureRec : public SkResourceCache::Rec {
+    MeasureRec(const MeasureKey& key, const void* segs, size_t segBytes, int segCount,
+               const SkPoint pts[], int ptsBefore, int ptCount,
+               SkScalar length, bool isClosed, int firstPtIndexAfter)
+        : fKey(key)
+        , fSegs(segBytes)
+        , fPts(ptCount * sizeof(SkPoint))
+        , fSegBytes(segBytes)
+        , fSegCount(segCount)
+        , fPtsBefore(ptsBefore)
+        , fPtCount(ptCount)
+        , fLength(length)
+        , fIsClosed(isClosed)
+        , fFirstPtIndexAfter(firstPtIndexAfter)
+    {
+        if (segBytes) {
+            memcpy(fSegs.get(), segs, segBytes);
+        }
+        if (ptCount) {
+            memcpy(fPts.get(), pts, ptCount * sizeof(SkPoint));
+        }
+    }
+
+    MeasureKey   fKey;
+    SkAutoMalloc fSegs;             // Segment[fSegCount], stored untyped
+    SkAutoMalloc fPts;              // the points this contour appended
+    size_t       fSegBytes;
+    int          fSegCount;
+    int          fPtsBefore;        // the measure's point count going in
+    int          fPtCount;
+    SkScalar     fLength;
+    bool         fIsClosed;
+    int          fFirstPtIndexAfter;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fSegBytes + fPtCount * sizeof(SkPoint);
+    }
+};
+
+}  // namespace
+
+class SkPathMeasureCache {
+public:
+    static bool UsableFor(const SkPathMeasure& measure) {
+        const SkPath* path = measure.fPath;
+        return path && !path->isVolatile() && path->countVerbs() >= kMinVerbsToCache;
+    }
+
+    /** On a hit, installs the cached contour into the measure and returns true. */
+    static bool Find(SkPathMeasure* measure) {
+        MeasureKey key(measure->fPath->getGenerationID(), measure->fForceClosed,
+                       measure->fContourIndex);
+        return SkResourceCache::Find(key, Visitor, measure);
+    }
+
+    /** Records the contour buildSegments() just measured. ptsBefore is the
+        measure's point count from before the build.
+    */
+    static void Add(SkPathMeasure* measure, int ptsBefore) {
+        MeasureKey key(measure->fPath->getGenerationID(), measure->fForceClosed,
+                       measure->fContourIndex);
+        const SkTDArray<SkPathMeasure::Segment>& segs = measure->fSegments;
+        SkResourceCache::Add(SkNEW_ARGS(MeasureRec,
+                (key, segs.begin(), segs.count() * sizeof(SkPathMeasure::Segment),
+                 segs.count(), measure->fPts.begin() + ptsBefore, ptsBefore,
+                 measure->fPts.count() - ptsBefore,
+                 measure->fLength, measure->fIsClosed, measure->fFirstPtIndex)));
+    }
+
+private:
+    // Below this many verbs, measuring costs about as much as the cache traffic.
+    static const int kMinVerbsToCache = 8;
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const MeasureRec& rec = static_cast<const MeasureRec&>(baseRec);
+        SkPathMeasure* measure = (SkPathMeasure*)contextData;
+        if (measure->fPts.count() != rec.fPtsBefore) {
+            // Can't happen for a matching (genID, contour index) pair, but a
+            // mismatched prefix would corrupt the stored point indices.
+            return false;
+        }
+        measure->fSegments.setCount(rec.fSegCount);
+        if (rec.fSegBytes) {
+            memcpy(measure->fSegments.begin(), rec.fSegs.get(), rec.fSegBytes);
+        }
+        measure->fPts.append(rec.fPtCount, (const SkPoint*)rec.fPts.get());
+        measure->fLength = rec.fLength;
+        measure->fIsClosed = rec.fIsClosed;
+        measure->fFirstPtIndex = rec.fFirstPtIndexAfter;
+        return true;
+    }
+};
+
 void SkPathMeasure::buildSegments() {
     SkPoint         pts[4];
     int             ptIndex = fFirstPtIndex;
@@ -168,6 +293,34 @@ void SkPathMeasure::buildSegments() {
      *
      *  We do this check below, and in compute_quad_segs and compute_cubic_segs
      */
+    fCursor = 0;
+
+    const bool cacheable = SkPathMeasureCache::UsableFor(*this);
+    if (cacheable && SkPathMeasureCache::Find(this)) {
+        // The cached contour is installed; we still have to march fIter past
+        // its verbs so nextContour() picks up where a real build would have.
+        bool done = false;
+        do {
+            switch (fIter.next(pts)) {
+                case SkPath::kMove_Verb:
+                    if (!firstMoveTo) {
+                        done = true;
+                        break;
+                    }
+                    firstMoveTo = false;
+                    break;
+                case SkPath::kDone_Verb:
+                    done = true;
+                    break;
+                default:
+                    break;
+            }
+        } while (!done);
+        fContourIndex += 1;
+        return;
+    }
+    const int ptsBefore = fPts.count();
+
     fSegments.reset();
     bool done = false;
     do {
@@ -244,6 +397,11 @@ void SkPathMeasure::buildSegments() {
     fIsClosed = isClosed;
     fFirstPtIndex = ptIndex;
 
+    if (cacheable) {
+        SkPathMeasureCache::Add(this, ptsBefore);
+    }
+    fContourIndex += 1;
+
 #ifdef SK_DEBUG
     {
         const Segment* seg = fSegments.begin();
@@ -401,6 +559,8 @@ SkPathMeasure::SkPathMeasure() {
     fLength = -1;   // signal we need to compute it
     fForceClosed = false;
     fFirstPtIndex = -1;
+    fContourIndex = 0;
+    fCursor = 0;
 }
 
 SkPathMeasure::SkPathMeasure(const SkPath& path, bool forceClosed) {
@@ -408,6 +568,8 @@ SkPathMeasure::SkPathMeasure(const SkPath& path, bool forceClosed) {
     fLength = -1;   // signal we need to compute it
     fForceClosed = forceClosed;
     fFirstPtIndex = -1;
+    fContourIndex = 0;
+    fCursor = 0;
 
     fIter.setPath(path, forceClosed);
 }
@@ -421,6 +583,8 @@ void SkPathMeasure::setPath(const SkPath* path, bool forceClosed) {
     fLength = -1;   // signal we need to compute it
     fForceClosed = forceClosed;
     fFirstPtIndex = -1;
+    fContourIndex = 0;
+    fCursor = 0;
 
     if (path) {
         fIter.setPath(*path, forceClosed);
@@ -478,9 +642,30 @@ const SkPathMeasure::Segment* SkPathMeasure::distanceToSegment(
     const Segment*  seg = fSegments.begin();
     int             count = fSegments.count();
 
-    int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
-    // don't care if we hit an exact match or not, so we xor index if it is negative
-    index ^= (index >> 31);
+    /*  Dashing asks for monotonically increasing distances, so the target is
+        usually at or just past the segment we returned last time. Try a short
+        forward walk from that cursor before falling back to a binary search
+        over the whole table.
+    */
+    int index = -1;
+    if ((unsigned)fCursor < (unsigned)count
+            && (0 == fCursor || seg[fCursor - 1].fDistance < distance)) {
+        const int kMaxCursorWalk = 8;
+        int limit = SkMin32(count, fCursor + kMaxCursorWalk);
+        int i = fCursor;
+        while (i < limit && seg[i].fDistance < distance) {
+            i += 1;
+        }
+        if (i < limit) {
+            index = i;
+        }
+    }
+    if (index < 0) {
+        index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
+        // don't care if we hit an exact match or not, so we xor index if it is negative
+        index ^= (index >> 31);
+    }
+    fCursor = index;
     seg = &seg[index];
 
     // now interpolate t-values with the prev segment (if possible)
@@ -10,6 +10,12 @@
 #include "SkPath.h"
 #include "SkPathRef.h"
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 SkPathRef::Editor::Editor(SkAutoTUnref<SkPathRef>* pathRef,
                           int incReserveVerbs,
@@ -23,6 +29,7 @@ SkPathRef::Editor::Editor(SkAutoTUnref<SkPathRef>* pathRef,
         pathRef->reset(copy);
     }
     fPathRef = *pathRef;
+    fPathRef->callGenIDChangeListeners();
     fPathRef->fGenerationID = 0;
     SkDEBUGCODE(sk_atomic_inc(&fPathRef->fEditorsAttached);)
 }
@@ -42,6 +49,70 @@ SkPathRef* SkPathRef::CreateEmpty() {
     return SkRef(empty.get());
 }
 
+// Below this many points the deinterleave setup outweighs the vector math.
+static const int kMinPointsForPlanarXform = 16;
+
+/**
+ *  Affine-transform a run of points using planar (separate x/y) vector
+ *  registers, so big paths get full-width SIMD instead of the strided
+ *  per-point math in SkMatrix::mapPoints. The interleaved xy storage is
+ *  deinterleaved at load time (free on NEON via vld2, one shuffle on SSE),
+ *  which gets us SoA's contiguous lanes without a second storage format.
+ *  Returns false if the matrix or target can't use this path.
+ */
+static bool planar_transform_points(SkPoint dst[], const SkPoint src[], int count,
+                                    const SkMatrix& matrix) {
+    if (matrix.hasPerspective()) {
+        return false;
+    }
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const __m128 sx = _mm_set1_ps(matrix.getScaleX());
+    const __m128 kx = _mm_set1_ps(matrix.getSkewX());
+    const __m128 tx = _mm_set1_ps(matrix.getTranslateX());
+    const __m128 ky = _mm_set1_ps(matrix.getSkewY());
+    const __m128 sy = _mm_set1_ps(matrix.getScaleY());
+    const __m128 ty = _mm_set1_ps(matrix.getTranslateY());
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 ab = _mm_loadu_ps(&src[i].fX);      // x0 y0 x1 y1
+        __m128 cd = _mm_loadu_ps(&src[i + 2].fX);  // x2 y2 x3 y3
+        __m128 x = _mm_shuffle_ps(ab, cd, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 y = _mm_shuffle_ps(ab, cd, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 nx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, sx), _mm_mul_ps(y, kx)), tx);
+        __m128 ny = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, ky), _mm_mul_ps(y, sy)), ty);
+        _mm_storeu_ps(&dst[i].fX, _mm_unpacklo_ps(nx, ny));
+        _mm_storeu_ps(&dst[i + 2].fX, _mm_unpackhi_ps(nx, ny));
+    }
+    if (i < count) {
+        matrix.mapPoints(dst + i, src + i, count - i);
+    }
+    return true;
+#elif defined(SK_ARM_HAS_NEON)
+    const float sx = matrix.getScaleX();
+    const float kx = matrix.getSkewX();
+    const float32x4_t tx = vdupq_n_f32(matrix.getTranslateX());
+    const float ky = matrix.getSkewY();
+    const float sy = matrix.getScaleY();
+    const float32x4_t ty = vdupq_n_f32(matrix.getTranslateY());
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x2_t p = vld2q_f32(&src[i].fX);   // val[0] = xs, val[1] = ys
+        float32x4x2_t o;
+        o.val[0] = vmlaq_n_f32(vmlaq_n_f32(tx, p.val[0], sx), p.val[1], kx);
+        o.val[1] = vmlaq_n_f32(vmlaq_n_f32(ty, p.val[0], ky), p.val[1], sy);
+        vst2q_f32(&dst[i].fX, o);
+    }
+    if (i < count) {
+        matrix.mapPoints(dst + i, src + i, count - i);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 void SkPathRef::CreateTransformedCopy(SkAutoTUnref<SkPathRef>* dst,
                                       const SkPathRef& src,
                                       const SkMatrix& matrix) {
@@ -72,7 +143,10 @@ void SkPathRef::CreateTransformedCopy(SkAutoTUnref<SkPathRef>* dst,
     // Need to check this here in case (&src == dst)
     bool canXformBounds = !src.fBoundsIsDirty && matrix.rectStaysRect() && src.countPoints() > 1;
 
-    matrix.mapPoints((*dst)->fPoints, src.points(), src.fPointCnt);
+    if (src.fPointCnt < kMinPointsForPlanarXform ||
+        !planar_transform_points((*dst)->fPoints, src.points(), src.fPointCnt, matrix)) {
+        matrix.mapPoints((*dst)->fPoints, src.points(), src.fPointCnt);
+    }
 
     /*
         *  Here we optimize the bounds computation, by noting if the bounds are
@@ -154,6 +228,7 @@ SkPathRef* SkPathRef::CreateFromBuffer(SkRBuffer* buffer) {
 void SkPathRef::Rewind(SkAutoTUnref<SkPathRef>* pathRef) {
     if ((*pathRef)->unique()) {
         SkDEBUGCODE((*pathRef)->validate();)
+        (*pathRef)->callGenIDChangeListeners();
         (*pathRef)->fBoundsIsDirty = true;  // this also invalidates fIsFinite
         (*pathRef)->fVerbCnt = 0;
         (*pathRef)->fPointCnt = 0;
@@ -436,6 +511,25 @@ uint32_t SkPathRef::genID() const {
     return fGenerationID;
 }
 
+void SkPathRef::addGenIDChangeListener(GenIDChangeListener* listener) {
+    if (NULL == listener || this == empty.get()) {
+        // The empty path ref is shared and never dies, so there's no point in tracking this.
+        SkDELETE(listener);
+        return;
+    }
+    *fGenIDChangeListeners.append() = listener;
+}
+
+// we need to be called *before* the genID gets changed or zerod
+void SkPathRef::callGenIDChangeListeners() {
+    for (int i = 0; i < fGenIDChangeListeners.count(); i++) {
+        fGenIDChangeListeners[i]->onChange();
+    }
+
+    // Listeners get at most one shot, so whether these triggered or not, blow them away.
+    fGenIDChangeListeners.deleteAll();
+}
+
 #ifdef SK_DEBUG
 void SkPathRef::validate() const {
     this->INHERITED::validate();
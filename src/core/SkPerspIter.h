@@ -36,13 +36,25 @@ public:
 private:
     enum {
         kShift  = 4,
-        kCount  = (1 << kShift)
+        kCount  = (1 << kShift),
+        kBatch  = 4     // chunk boundary points transformed per batch
     };
     const SkMatrix& fMatrix;
     SkFixed         fStorage[kCount * 2];
     SkFixed         fX, fY;
     SkScalar        fSX, fSY;
     int             fCount;
+
+    // Upcoming chunk boundary points. They are computed kBatch at a time so
+    // the perspective transform (and in particular its divide) runs four
+    // lanes wide instead of once per chunk.
+    SkScalar        fBoundaryX[kBatch];
+    SkScalar        fBoundaryY[kBatch];
+    int             fBoundaryN[kBatch];
+    int             fBoundaryIndex;
+    int             fBoundaryCount;
+
+    void loadBoundaries();
 };
 
 #endif
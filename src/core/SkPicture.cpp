@@ -20,6 +20,7 @@
 #include "SkPaintPriv.h"
 #include "SkPathEffect.h"
 #include "SkPicture.h"
+#include "SkRasterLayerCache.h"
 #include "SkRegion.h"
 #include "SkShader.h"
 #include "SkStream.h"
@@ -53,7 +54,7 @@ namespace {
 
 // Some commands have a paint, some have an optional paint.  Either way, get back a pointer.
 static const SkPaint* AsPtr(const SkPaint& p) { return &p; }
-static const SkPaint* AsPtr(const SkRecords::Optional<SkPaint>& p) { return p; }
+static const SkPaint* AsPtr(const SkRecords::Interned<SkPaint>& p) { return p; }
 
 /** SkRecords visitor to determine whether an instance may require an
     "external" bitmap to rasterize. May return false positives.
@@ -238,6 +239,7 @@ SkPicture::~SkPicture() {
         SkPicture::DeletionMessage msg;
         msg.fUniqueID = id;
         SkMessageBus<SkPicture::DeletionMessage>::Post(msg);
+        SkNotifyPictureLayersAreStale(id);
     }
 }
 
@@ -274,6 +276,29 @@ void SkPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  useBBH ? fBBH.get() : NULL, callback);
 }
 
+void SkPicture::playback(SkCanvas* canvas, const SkRegion& damage,
+                         AbortCallback* callback) const {
+    SkASSERT(canvas);
+
+    SkRecordDrawDamage(*fRecord, canvas, this->drawablePicts(), NULL, this->drawableCount(),
+                       fBBH.get(), damage, callback);
+}
+
+void SkPicture::EXPERIMENTAL_playbackWithProfile(SkCanvas* canvas,
+                                                 SkRecordDrawProfile* profile) const {
+    SkASSERT(canvas);
+    SkASSERT(profile);
+
+    // Use the BBH (or not) exactly as playback() would, so the profile reflects
+    // what an ordinary playback costs.
+    SkRect clipBounds = { 0, 0, 0, 0 };
+    (void)canvas->getClipBounds(&clipBounds);
+    const bool useBBH = !clipBounds.contains(this->cullRect());
+
+    SkRecordProfiledDraw(*fRecord, canvas, this->drawablePicts(), NULL, this->drawableCount(),
+                         useBBH ? fBBH.get() : NULL, profile);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SkStream.h"
@@ -368,6 +393,22 @@ SkPicture* SkPicture::CreateFromStream(SkStream* stream, InstallPixelRefProc pro
     return Forwardport(info, data);
 }
 
+SkPicture* SkPicture::CreateFromData(SkData* data, InstallPixelRefProc proc) {
+    if (NULL == data) {
+        return NULL;
+    }
+    SkMemoryStream stream(data);
+    SkPictInfo info;
+    if (!InternalOnly_StreamIsSKP(&stream, &info) || !stream.readBool()) {
+        return NULL;
+    }
+    // Passing data down lets the parser alias its storage instead of copying
+    // the op and buffer blocks back out of the stream.
+    SkAutoTDelete<SkPictureData> pictData(
+            SkPictureData::CreateFromStream(&stream, info, proc, data));
+    return Forwardport(info, pictData);
+}
+
 SkPicture* SkPicture::CreateFromBuffer(SkReadBuffer& buffer) {
     SkPictInfo info;
     if (!InternalOnly_BufferIsSKP(&buffer, &info) || !buffer.readBool()) {
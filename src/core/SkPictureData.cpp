@@ -301,7 +301,8 @@ static uint32_t pictInfoFlagsToReadBufferFlags(uint32_t pictInfoFlags) {
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
-                                   SkPicture::InstallPixelRefProc proc) {
+                                   SkPicture::InstallPixelRefProc proc,
+                                   const SkData* sharedData) {
     /*
      *  By the time we encounter BUFFER_SIZE_TAG, we need to have already seen
      *  its dependents: FACTORY_TAG and TYPEFACE_TAG. These two are not required
@@ -316,7 +317,16 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(NULL == fOpData);
-            fOpData = SkData::NewFromStream(stream, size);
+            if (sharedData) {
+                // Trusted fast path: alias the op block in place rather than
+                // copying it out of the stream.
+                fOpData = SkData::NewSubset(sharedData, stream->getPosition(), size);
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+            } else {
+                fOpData = SkData::NewFromStream(stream, size);
+            }
             if (!fOpData) {
                 return false;
             }
@@ -373,13 +383,26 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            SkData* block;
+            if (sharedData) {
+                // Trusted fast path: the flattened tables stay in sharedData
+                // and are read in place.
+                block = SkData::NewSubset(sharedData, stream->getPosition(), size);
+                if (stream->skip(size) != size) {
+                    block->unref();
+                    return false;
+                }
+            } else {
+                block = SkData::NewUninitialized(size);
+                if (stream->read(block->writable_data(), size) != size) {
+                    block->unref();
+                    return false;
+                }
             }
+            SkAutoDataUnref data(block);
 
             /* Should we use SkValidatingReadBuffer instead? */
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(data->data(), size);
             buffer.setFlags(pictInfoFlagsToReadBufferFlags(fInfo.fFlags));
             buffer.setVersion(fInfo.fVersion);
 
@@ -504,10 +527,11 @@ bool SkPictureData::parseBufferTag(SkReadBuffer& buffer,
 
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
-                                               SkPicture::InstallPixelRefProc proc) {
+                                               SkPicture::InstallPixelRefProc proc,
+                                               const SkData* sharedData) {
     SkAutoTDelete<SkPictureData> data(SkNEW_ARGS(SkPictureData, (info)));
 
-    if (!data->parseStream(stream, proc)) {
+    if (!data->parseStream(stream, proc, sharedData)) {
         return NULL;
     }
     return data.detach();
@@ -525,7 +549,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 }
 
 bool SkPictureData::parseStream(SkStream* stream,
-                                SkPicture::InstallPixelRefProc proc) {
+                                SkPicture::InstallPixelRefProc proc,
+                                const SkData* sharedData) {
     for (;;) {
         uint32_t tag = stream->readU32();
         if (SK_PICT_EOF_TAG == tag) {
@@ -533,7 +558,7 @@ bool SkPictureData::parseStream(SkStream* stream,
         }
 
         uint32_t size = stream->readU32();
-        if (!this->parseStreamTag(stream, tag, size, proc)) {
+        if (!this->parseStreamTag(stream, tag, size, proc, sharedData)) {
             return false; // we're invalid
         }
     }
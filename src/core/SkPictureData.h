@@ -58,10 +58,13 @@ struct SkPictInfo {
 class SkPictureData {
 public:
     SkPictureData(const SkPictureRecord& record, const SkPictInfo&, bool deepCopyOps);
-    // Does not affect ownership of SkStream.
+    // Does not affect ownership of SkStream. If sharedData is non-NULL, the
+    // stream must be walking exactly that data (from byte 0), and the op and
+    // buffer blocks will alias it instead of being copied out of the stream.
     static SkPictureData* CreateFromStream(SkStream*,
                                            const SkPictInfo&,
-                                           SkPicture::InstallPixelRefProc);
+                                           SkPicture::InstallPixelRefProc,
+                                           const SkData* sharedData = NULL);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
 
     virtual ~SkPictureData();
@@ -81,7 +84,7 @@ protected:
     explicit SkPictureData(const SkPictInfo& info);
 
     // Does not affect ownership of SkStream.
-    bool parseStream(SkStream*, SkPicture::InstallPixelRefProc);
+    bool parseStream(SkStream*, SkPicture::InstallPixelRefProc, const SkData* sharedData);
     bool parseBuffer(SkReadBuffer& buffer);
 
 public:
@@ -138,7 +141,8 @@ private:
 
     // these help us with reading/writing
     // Does not affect ownership of SkStream.
-    bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size, SkPicture::InstallPixelRefProc);
+    bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size, SkPicture::InstallPixelRefProc,
+                        const SkData* sharedData);
     bool parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
     void flattenToBuffer(SkWriteBuffer&) const;
 
@@ -29,17 +29,56 @@ SkCanvas* SkPictureRecorder::beginRecording(const SkRect& cullRect,
     fCullRect = cullRect;
     fFlags = recordFlags;
 
+    // In recycle mode we hang on to the SkRecord and BBH after endRecording*().  If the
+    // picture (or drawable) made from them has since been deleted, we're their only owner
+    // again and can simply rewind them instead of paying to build them up from scratch.
+    const bool recycle = SkToBool(recordFlags & kRecycleResources_RecordFlag);
+
     if (bbhFactory) {
-        fBBH.reset((*bbhFactory)(cullRect));
+        if (recycle && fBBH && fBBH->unique()) {
+            fBBH->reset();
+        } else {
+            fBBH.reset((*bbhFactory)(cullRect));
+        }
         SkASSERT(fBBH.get());
+    } else {
+        fBBH.reset(NULL);
     }
 
-    fRecord.reset(SkNEW(SkRecord));
+    if (recycle && fRecord && fRecord->unique()) {
+        fRecord->rewind();
+    } else {
+        // Seed the new record with the old one's size.  Recording loops are usually
+        // steady frame over frame, so its first blocks can be sized right up front.
+        const size_t bytesHint = fRecord ? fRecord->bytesUsed() : 0;
+        fRecord.reset(SkNEW_ARGS(SkRecord, (bytesHint)));
+    }
     fRecorder->reset(fRecord.get(), cullRect);
     fActivelyRecording = true;
     return this->getRecordingCanvas();
 }
 
+SkCanvas* SkPictureRecorder::beginRecordingUpdate(const SkPicture* previous,
+                                                  const SkRect& invalidRect,
+                                                  SkBBHFactory* bbhFactory /* = NULL */,
+                                                  uint32_t recordFlags /* = 0 */) {
+    SkASSERT(previous);
+    SkCanvas* canvas = this->beginRecording(previous->cullRect(), bbhFactory, recordFlags);
+
+    // Replay the old frame everywhere except the invalidated region. Large pictures are
+    // carried over as a single by-reference op, so this costs O(1) record time; at playback
+    // their bounding hierarchy still culls as if the ops had been recorded inline.
+    canvas->save();
+    canvas->clipRect(invalidRect, SkRegion::kDifference_Op);
+    canvas->drawPicture(previous);
+    canvas->restore();
+
+    // Constrain everything the caller records to the damaged area, so the merged frame
+    // stays consistent even if a draw strays outside the invalidation rect.
+    canvas->clipRect(invalidRect);
+    return canvas;
+}
+
 SkCanvas* SkPictureRecorder::getRecordingCanvas() {
     return fActivelyRecording ? fRecorder.get() : nullptr;
 }
@@ -48,6 +87,7 @@ SkPicture* SkPictureRecorder::endRecordingAsPicture() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
     // TODO: delay as much of this work until just before first playback?
+    SkRecordNoopHiddenDraws(fCullRect, fRecord);
     SkRecordOptimize(fRecord);
 
     SkAutoTUnref<SkLayerInfo> saveLayerData;
@@ -77,10 +117,21 @@ SkPicture* SkPictureRecorder::endRecordingAsPicture() {
     for (int i = 0; pictList && i < pictList->count(); i++) {
         subPictureBytes += SkPictureUtils::ApproximateBytesUsed(pictList->begin()[i]);
     }
+    // In recycle mode, share refs with the picture rather than handing ours over, so that
+    // the next beginRecording() can reuse the SkRecord and BBH once the picture is deleted.
+    SkRecord* record;
+    SkBBoxHierarchy* bbh;
+    if (fFlags & kRecycleResources_RecordFlag) {
+        record = SkRef(fRecord.get());
+        bbh = SkSafeRef(fBBH.get());
+    } else {
+        record = fRecord.detach();
+        bbh = fBBH.detach();
+    }
     return SkNEW_ARGS(SkPicture, (fCullRect,
-                                  fRecord.detach(),
+                                  record,
                                   pictList,
-                                  fBBH.detach(),
+                                  bbh,
                                   saveLayerData.detach(),
                                   subPictureBytes));
 }
@@ -172,6 +223,7 @@ SkDrawable* SkPictureRecorder::endRecordingAsDrawable() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
     // TODO: delay as much of this work until just before first playback?
+    SkRecordNoopHiddenDraws(fCullRect, fRecord);
     SkRecordOptimize(fRecord);
 
     if (fBBH.get()) {
@@ -183,9 +235,13 @@ SkDrawable* SkPictureRecorder::endRecordingAsDrawable() {
                                          fCullRect,
                                          SkToBool(fFlags & kComputeSaveLayerInfo_RecordFlag)));
 
-    // release our refs now, so only the drawable will be the owner.
-    fRecord.reset(NULL);
-    fBBH.reset(NULL);
+    // Release our refs now, so only the drawable will be the owner -- unless we're
+    // recycling, in which case we keep them so beginRecording() can reuse the memory
+    // once the drawable is deleted.
+    if (!(fFlags & kRecycleResources_RecordFlag)) {
+        fRecord.reset(NULL);
+        fBBH.reset(NULL);
+    }
 
     return drawable;
 }
@@ -10,10 +10,13 @@
 #include "SkBitmap.h"
 #include "SkBitmapProcShader.h"
 #include "SkCanvas.h"
+#include "SkLazyPtr.h"
 #include "SkMatrixUtils.h"
 #include "SkPicture.h"
 #include "SkReadBuffer.h"
 #include "SkResourceCache.h"
+#include "SkTaskGroup.h"
+#include "SkThread.h"
 
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
@@ -99,8 +102,135 @@ static bool cache_try_alloc_pixels(SkBitmap* bitmap) {
         : bitmap->tryAllocPixels();
 }
 
+// Bucket the tile to a power-of-two pixel size. The bitmap shader's inverse
+// scale hides the difference, and pinch-zoom frames whose scales differ only
+// slightly land on the same cached tile instead of re-rasterizing the picture
+// every frame.
+static SkISize bucket_tile_size(const SkISize& size, int maxTextureSize) {
+    int w = SkNextPow2(size.width());
+    int h = SkNextPow2(size.height());
+
+    // Power-of-two rounding can push us back over the limits, so re-clamp.
+    static const int64_t kMaxTileArea = 2048 * 2048;
+    while ((int64_t)w * h > kMaxTileArea) {
+        if (w >= h) {
+            w >>= 1;
+        } else {
+            h >>= 1;
+        }
+    }
+    if (maxTextureSize) {
+        while (w > maxTextureSize) {
+            w >>= 1;
+        }
+        while (h > maxTextureSize) {
+            h >>= 1;
+        }
+    }
+    return SkISize::Make(SkTMax(w, 1), SkTMax(h, 1));
+}
+
+static SkSize tile_scale(const SkISize& tileSize, const SkRect& tile) {
+    return SkSize::Make(SkIntToScalar(tileSize.width()) / tile.width(),
+                        SkIntToScalar(tileSize.height()) / tile.height());
+}
+
+// Rasterize the picture into a tile of the given pixel size, wrap it in a
+// bitmap shader and add it to SkResourceCache. Returns the shader (or NULL on
+// allocation failure). Safe to call from a background task: the picture is
+// const and the cache is thread-safe.
+static SkShader* create_tile_shader(const SkPicture* picture, const SkRect& tile,
+                                    SkShader::TileMode tmx, SkShader::TileMode tmy,
+                                    const SkISize& tileSize, const SkMatrix& localMatrix) {
+    const SkSize tileScale = tile_scale(tileSize, tile);
+
+    SkBitmap bm;
+    bm.setInfo(SkImageInfo::MakeN32Premul(tileSize));
+    if (!cache_try_alloc_pixels(&bm)) {
+        return NULL;
+    }
+    bm.eraseColor(SK_ColorTRANSPARENT);
+
+    // Always disable LCD text, since we can't assume our image will be opaque.
+    SkCanvas canvas(bm, SkSurfaceProps(0, kUnknown_SkPixelGeometry));
+
+    canvas.scale(tileScale.width(), tileScale.height());
+    canvas.translate(-tile.x(), -tile.y());
+    canvas.drawPicture(picture);
+
+    SkMatrix shaderMatrix = localMatrix;
+    shaderMatrix.preScale(1 / tileScale.width(), 1 / tileScale.height());
+    SkShader* tileShader = SkShader::CreateBitmapShader(bm, tmx, tmy, &shaderMatrix);
+
+    BitmapShaderKey key(picture->uniqueID(), tile, tmx, tmy, tileScale, localMatrix);
+    SkResourceCache::Add(SkNEW_ARGS(BitmapShaderRec, (key, tileShader, bm.getSize())));
+    return tileShader;
+}
+
+// Everything a background re-rasterization needs, copied out of the shader so
+// the task doesn't reference it after it may have been deleted.
+struct TileTask {
+    TileTask(const SkPicture* picture, const SkRect& tile,
+             SkShader::TileMode tmx, SkShader::TileMode tmy,
+             const SkISize& tileSize, const SkMatrix& localMatrix, uint32_t keyHash)
+        : fPicture(SkRef(picture))
+        , fTile(tile)
+        , fTmx(tmx)
+        , fTmy(tmy)
+        , fTileSize(tileSize)
+        , fLocalMatrix(localMatrix)
+        , fKeyHash(keyHash) {}
+
+    SkAutoTUnref<const SkPicture> fPicture;
+    SkRect             fTile;
+    SkShader::TileMode fTmx, fTmy;
+    SkISize            fTileSize;
+    SkMatrix           fLocalMatrix;
+    uint32_t           fKeyHash;
+};
+
 } // namespace
 
+SK_DECLARE_STATIC_MUTEX(gPendingTileMutex);
+
+typedef SkTDArray<uint32_t> PendingTileHashes;
+SK_DECLARE_STATIC_LAZY_PTR(PendingTileHashes, gPendingTileHashes);
+
+// Long-lived so add() is fire-and-forget; a function-local SkTaskGroup would
+// wait for its tasks on destruction.
+SK_DECLARE_STATIC_LAZY_PTR(SkTaskGroup, gTileTaskGroup);
+
+static void rasterize_tile_task(TileTask* task) {
+    SkAutoTDelete<TileTask> owned(task);
+    SkAutoTUnref<SkShader> shader(create_tile_shader(task->fPicture, task->fTile,
+                                                     task->fTmx, task->fTmy,
+                                                     task->fTileSize, task->fLocalMatrix));
+    SkAutoMutexAcquire ama(gPendingTileMutex);
+    int index = gPendingTileHashes.get()->find(task->fKeyHash);
+    if (index >= 0) {
+        gPendingTileHashes.get()->remove(index);
+    }
+}
+
+// Kick off a background rebuild of the given tile, unless one is already in
+// flight. With no SkTaskGroup threads this runs synchronously, and the caller
+// just draws one frame with the stale tile.
+static void spawn_tile_rebuild(const SkPicture* picture, const SkRect& tile,
+                               SkShader::TileMode tmx, SkShader::TileMode tmy,
+                               const SkISize& tileSize, const SkMatrix& localMatrix,
+                               uint32_t keyHash) {
+    {
+        SkAutoMutexAcquire ama(gPendingTileMutex);
+        if (gPendingTileHashes.get()->find(keyHash) >= 0) {
+            return;
+        }
+        *gPendingTileHashes.get()->append() = keyHash;
+    }
+    gTileTaskGroup.get()->add(rasterize_tile_task,
+                              SkNEW_ARGS(TileTask, (picture, tile, tmx, tmy, tileSize,
+                                                    localMatrix, keyHash)));
+}
+
 SkPictureShader::SkPictureShader(const SkPicture* picture, TileMode tmx, TileMode tmy,
                                  const SkMatrix* localMatrix, const SkRect* tile)
     : INHERITED(localMatrix)
@@ -187,10 +317,10 @@ SkShader* SkPictureShader::refBitmapShader(const SkMatrix& matrix, const SkMatri
     if (tileSize.isEmpty()) {
         return NULL;
     }
+    tileSize = bucket_tile_size(tileSize, maxTextureSize);
 
-    // The actual scale, compensating for rounding & clamping.
-    SkSize tileScale = SkSize::Make(SkIntToScalar(tileSize.width()) / fTile.width(),
-                                    SkIntToScalar(tileSize.height()) / fTile.height());
+    // The actual scale, compensating for rounding, clamping & bucketing.
+    SkSize tileScale = tile_scale(tileSize, fTile);
 
     SkAutoTUnref<SkShader> tileShader;
     BitmapShaderKey key(fPicture->uniqueID(),
@@ -201,25 +331,36 @@ SkShader* SkPictureShader::refBitmapShader(const SkMatrix& matrix, const SkMatri
                         this->getLocalMatrix());
 
     if (!SkResourceCache::Find(key, BitmapShaderRec::Visitor, &tileShader)) {
-        SkBitmap bm;
-        bm.setInfo(SkImageInfo::MakeN32Premul(tileSize));
-        if (!cache_try_alloc_pixels(&bm)) {
-            return NULL;
+        // A zoom in progress usually has a neighboring bucket already built.
+        // Draw with that one for now and rebuild the exact bucket on a
+        // background task, rather than stalling this draw on a full
+        // re-rasterization of the picture.
+        static const int kNumNeighbors = 2;
+        const SkISize neighbors[kNumNeighbors] = {
+            SkISize::Make(SkTMax(tileSize.width() >> 1, 1), SkTMax(tileSize.height() >> 1, 1)),
+            bucket_tile_size(SkISize::Make(tileSize.width() << 1, tileSize.height() << 1),
+                             maxTextureSize),
+        };
+        for (int i = 0; i < kNumNeighbors; ++i) {
+            if (neighbors[i] == tileSize) {
+                continue;
+            }
+            BitmapShaderKey neighborKey(fPicture->uniqueID(),
+                                        fTile,
+                                        fTmx,
+                                        fTmy,
+                                        tile_scale(neighbors[i], fTile),
+                                        this->getLocalMatrix());
+            if (SkResourceCache::Find(neighborKey, BitmapShaderRec::Visitor, &tileShader)) {
+                spawn_tile_rebuild(fPicture, fTile, fTmx, fTmy, tileSize,
+                                   this->getLocalMatrix(), key.hash());
+                return tileShader.detach();
+            }
         }
-        bm.eraseColor(SK_ColorTRANSPARENT);
-
-        // Always disable LCD text, since we can't assume our image will be opaque.
-        SkCanvas canvas(bm, SkSurfaceProps(0, kUnknown_SkPixelGeometry));
-
-        canvas.scale(tileScale.width(), tileScale.height());
-        canvas.translate(-fTile.x(), -fTile.y());
-        canvas.drawPicture(fPicture);
-
-        SkMatrix shaderMatrix = this->getLocalMatrix();
-        shaderMatrix.preScale(1 / tileScale.width(), 1 / tileScale.height());
-        tileShader.reset(CreateBitmapShader(bm, fTmx, fTmy, &shaderMatrix));
 
-        SkResourceCache::Add(SkNEW_ARGS(BitmapShaderRec, (key, tileShader.get(), bm.getSize())));
+        // Nothing usable in the cache: rasterize the tile now.
+        tileShader.reset(create_tile_shader(fPicture, fTile, fTmx, fTmy, tileSize,
+                                            this->getLocalMatrix()));
     }
 
     return tileShader.detach();
@@ -177,6 +177,17 @@ bool SkPixelRef::lockPixels() {
     return this->lockPixels(&rec);
 }
 
+void SkPixelRef::ensureRegionResident(const SkIRect& region) {
+    SkIRect clamped = region;
+    if (!clamped.intersect(SkIRect::MakeWH(fInfo.width(), fInfo.height()))) {
+        return;
+    }
+    if (!fPreLocked) {
+        SkAutoMutexAcquire ac(*fMutex);
+        this->onEnsureRegionResident(clamped);
+    }
+}
+
 void SkPixelRef::unlockPixels() {
     SkASSERT(!fPreLocked || SKPIXELREF_PRELOCKED_LOCKCOUNT == fLockCount);
 
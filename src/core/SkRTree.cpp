@@ -17,6 +17,11 @@ SkRect SkRTree::getRootBound() const {
     }
 }
 
+void SkRTree::reset() {
+    fCount = 0;
+    fNodes.rewind();  // Keeps the node arena around for the next insert().
+}
+
 void SkRTree::insert(const SkRect boundsArray[], int N) {
     SkASSERT(0 == fCount);
 
@@ -179,6 +184,30 @@ void SkRTree::search(Node* node, const SkRect& query, SkTDArray<unsigned>* resul
     }
 }
 
+void SkRTree::search(const SkRect& query, SearchProc proc, void* context) const {
+    if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
+        (void)this->search(fRoot.fSubtree, query, proc, context);
+    }
+}
+
+bool SkRTree::search(Node* node, const SkRect& query, SearchProc proc, void* context) const {
+    // The leaves hold ops in insertion order, and bulkLoad() packs them into
+    // nodes left to right, so this depth-first walk hands out hits in draw
+    // order, just like the array-based search above.
+    for (int i = 0; i < node->fNumChildren; ++i) {
+        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
+            if (0 == node->fLevel) {
+                if (!proc(node->fChildren[i].fOpIndex, context)) {
+                    return false;
+                }
+            } else if (!this->search(node->fChildren[i].fSubtree, query, proc, context)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 size_t SkRTree::bytesUsed() const {
     size_t byteCount = sizeof(SkRTree);
 
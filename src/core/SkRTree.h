@@ -42,7 +42,9 @@ public:
     virtual ~SkRTree() {}
 
     void insert(const SkRect[], int N) override;
+    void reset() override;
     void search(const SkRect& query, SkTDArray<unsigned>* results) const override;
+    void search(const SkRect& query, SearchProc proc, void* context) const override;
     size_t bytesUsed() const override;
 
     // Methods and constants below here are only public for tests.
@@ -77,6 +79,8 @@ private:
     };
 
     void search(Node* root, const SkRect& query, SkTDArray<unsigned>* results) const;
+    // Returns false if proc ended the search early.
+    bool search(Node* root, const SkRect& query, SearchProc proc, void* context) const;
 
     // Consumes the input array.
     Branch bulkLoad(SkTDArray<Branch>* branches, int level = 0);
@@ -351,3 +351,61 @@ SkStreamAsset* SkRWBuffer::newStreamSnapshot() const {
     SkAutoTUnref<SkROBuffer> buffer(this->newRBufferSnapshot());
     return SkNEW_ARGS(SkROBufferStreamAsset, (buffer));
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A rewindable view of an SkRWBuffer that may still be growing.  It reads
+// through a snapshot like the stream above, but when a read wants more than
+// the snapshot holds and the writer has appended since, it snaps the buffer
+// again and picks up where it left off, rather than treating the old
+// snapshot's end as EOF.
+class SkRWBufferPollingStream : public SkStreamRewindable {
+public:
+    SkRWBufferPollingStream(const SkRWBuffer* buffer) : fRWBuffer(buffer) {
+        this->refresh();
+    }
+
+    size_t read(void* dst, size_t request) override {
+        size_t bytesRead = fStream->read(dst, request);
+        if (bytesRead < request && fRWBuffer->size() > fStream->getLength()) {
+            // The writer has appended since our snapshot was taken.
+            this->refresh();
+            if (dst) {
+                dst = (char*)dst + bytesRead;
+            }
+            bytesRead += fStream->read(dst, request - bytesRead);
+        }
+        return bytesRead;
+    }
+
+    // True only when everything appended so far has been consumed; a later
+    // read may still return more.
+    bool isAtEnd() const override {
+        return fStream->isAtEnd() && fRWBuffer->size() == fStream->getPosition();
+    }
+
+    bool rewind() override { return fStream->rewind(); }
+
+    bool hasPosition() const override { return true; }
+
+    size_t getPosition() const override { return fStream->getPosition(); }
+
+    SkStreamRewindable* duplicate() const override {
+        return SkNEW_ARGS(SkRWBufferPollingStream, (fRWBuffer));
+    }
+
+private:
+    void refresh() {
+        const size_t position = fStream.get() ? fStream->getPosition() : 0;
+        SkAutoTUnref<SkROBuffer> snapshot(fRWBuffer->newRBufferSnapshot());
+        fStream.reset(SkNEW_ARGS(SkROBufferStreamAsset, (snapshot)));
+        fStream->seek(position);
+    }
+
+    const SkRWBuffer*           fRWBuffer;  // not owned; must outlive this
+    SkAutoTDelete<SkStreamAsset> fStream;   // over the latest snapshot
+};
+
+SkStreamRewindable* SkRWBuffer::newPollingStream() const {
+    return SkNEW_ARGS(SkRWBufferPollingStream, (this));
+}
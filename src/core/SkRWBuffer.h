@@ -14,6 +14,7 @@ struct SkBufferBlock;
 struct SkBufferHead;
 class SkRWBuffer;
 class SkStreamAsset;
+class SkStreamRewindable;
 
 /**
  *  Contains a read-only, thread-sharable block of memory. To access the memory, the caller must
@@ -81,7 +82,16 @@ public:
 
     SkROBuffer* newRBufferSnapshot() const;
     SkStreamAsset* newStreamSnapshot() const;
-    
+
+    /**
+     *  Return a rewindable stream that reads this buffer while it is still being appended to.
+     *  When the reader runs out of bytes it takes a fresh snapshot, so it sees data appended
+     *  after the stream was created rather than hitting a hard EOF.  isAtEnd() is true once
+     *  everything appended so far has been consumed; a later read may still return more.
+     *  This buffer must outlive the stream (and any duplicates of it).
+     */
+    SkStreamRewindable* newPollingStream() const;
+
 #ifdef SK_DEBUG
     void validate() const;
 #else
@@ -156,7 +156,7 @@ bool SkRasterClip::setPath(const SkPath& path, const SkRegion& clip, bool doAA)
         if (this->isBW()) {
             this->convertToAA();
         }
-        (void)fAA.setPath(path, &clip, doAA);
+        (void)fAA.setPathLazy(path, &clip, doAA);
     }
     return this->updateCacheAndReturnNonEmpty();
 }
@@ -379,7 +379,8 @@ void SkRasterClip::validate() const {
     fAA.validate();
 
     SkASSERT(this->computeIsEmpty() == fIsEmpty);
-    SkASSERT(this->computeIsRect() == fIsRect);
+    // One-directional; see isRect() in the header.
+    SkASSERT(!fIsRect || this->computeIsRect());
 }
 #endif
 
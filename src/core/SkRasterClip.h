@@ -31,7 +31,9 @@ public:
     }
 
     bool isRect() const {
-        SkASSERT(this->computeIsRect() == fIsRect);
+        // One-directional: a lazy AA clip reports false from SkAAClip::isRect() until it
+        // materializes, so the truth can flip to true after we cached false.
+        SkASSERT(!fIsRect || this->computeIsRect());
         return fIsRect;
     }
 
@@ -79,7 +81,9 @@ private:
     SkAAClip    fAA;
     bool        fForceConservativeRects;
     bool        fIsBW;
-    // these 2 are caches based on querying the right obj based on fIsBW
+    // these 2 are caches based on querying the right obj based on fIsBW.
+    // fIsRect is conservative: false may mean "not known yet", since a lazy
+    // AA clip answers isRect() with false until it materializes.
     bool        fIsEmpty;
     bool        fIsRect;
 
@@ -0,0 +1,275 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkLayerInfo.h"
+#include "SkRasterLayerCache.h"
+#include "SkRecordDraw.h"
+#include "SkRecords.h"
+#include "SkResourceCache.h"
+
+static uint64_t picture_layers_shared_id(uint32_t pictureID) {
+    uint64_t sharedID = SkSetFourByteTag('p', 'l', 'y', 'r');
+    return (sharedID << 32) | pictureID;
+}
+
+void SkNotifyPictureLayersAreStale(uint32_t pictureID) {
+    SkResourceCache::PostPurgeSharedID(picture_layers_shared_id(pictureID));
+}
+
+namespace {
+static unsigned gLayerKeyNamespaceLabel;
+
+struct LayerKey : public SkResourceCache::Key {
+public:
+    LayerKey(uint32_t pictureID, unsigned start, const SkMatrix& initialMat)
+        : fPictureID(pictureID)
+        , fStart(start)
+    {
+        initialMat.get9(fMat);  // Raw scalars; SkMatrix itself carries a lazy type mask.
+        this->init(&gLayerKeyNamespaceLabel, picture_layers_shared_id(pictureID),
+                   sizeof(fPictureID) + sizeof(fStart) + sizeof(fMat));
+    }
+
+    uint32_t fPictureID;
+    uint32_t fStart;
+    SkScalar fMat[9];
+};
+
+struct LayerRec : public SkResourceCache::Rec {
+    LayerRec(const LayerKey& key, const SkBitmap& bm)
+        : fKey(key)
+        , fBitmap(bm)
+    {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(fKey) + fBitmap.getSize(); }
+
+    static bool Finder(const SkResourceCache::Rec& baseRec, void* contextBitmap) {
+        const LayerRec& rec = static_cast<const LayerRec&>(baseRec);
+        SkBitmap* result = (SkBitmap*)contextBitmap;
+
+        *result = rec.fBitmap;
+        result->lockPixels();
+        return SkToBool(result->getPixels());
+    }
+
+private:
+    LayerKey fKey;
+    SkBitmap fBitmap;
+};
+}  // namespace
+
+// Like GrLayerHoister, we only take on layers that live in the top-level picture,
+// don't nest, and don't need image filtering; everything else plays back normally.
+static bool is_hoistable(const SkLayerInfo::BlockInfo& info) {
+    return NULL == info.fPicture
+        && !info.fHasNestedLayers
+        && !info.fIsNested
+        && !(info.fPaint && info.fPaint->getImageFilter());
+}
+
+// Compute the layer's src rect in device space; returns false if it is empty.
+static bool compute_source_rect(const SkLayerInfo::BlockInfo& info, const SkMatrix& initialMat,
+                                const SkIRect& dstIR, SkIRect* srcIR) {
+    if (!info.fSrcBounds.isEmpty()) {
+        SkMatrix totMat = initialMat;
+        totMat.preConcat(info.fPreMat);
+        totMat.preConcat(info.fLocalMat);
+
+        SkRect r;
+        totMat.mapRect(&r, info.fSrcBounds);
+        r.roundOut(srcIR);
+
+        if (!srcIR->intersect(dstIR)) {
+            return false;
+        }
+    } else {
+        *srcIR = dstIR;
+    }
+    return !srcIR->isEmpty();
+}
+
+// Plays back a picture, substituting cached bitmaps for hoistable saveLayer blocks.
+class ReplaceLayerDraw : public SkRecords::Draw {
+public:
+    ReplaceLayerDraw(SkCanvas* canvas,
+                     const SkPicture* picture,
+                     const SkLayerInfo* layerInfo,
+                     const SkMatrix& initialMat,
+                     SkPicture::AbortCallback* callback)
+        : INHERITED(canvas, picture->drawablePicts(), NULL, picture->drawableCount())
+        , fCanvas(canvas)
+        , fPicture(picture)
+        , fLayerInfo(layerInfo)
+        , fInitialMat(initialMat)
+        , fCallback(callback)
+        , fIndex(0)
+        , fNumReplaced(0) {
+    }
+
+    int draw() {
+        const SkBBoxHierarchy* bbh = fPicture->fBBH.get();
+        const SkRecord* record = fPicture->fRecord.get();
+        if (NULL == record) {
+            return 0;
+        }
+
+        if (bbh) {
+            SkRect query = { 0, 0, 0, 0 };
+            (void)fCanvas->getClipBounds(&query);
+
+            bbh->search(query, &fOps);
+
+            for (fIndex = 0; fIndex < fOps.count(); ++fIndex) {
+                if (fCallback && fCallback->abort()) {
+                    return fNumReplaced;
+                }
+                record->visit<void>(fOps[fIndex], *this);
+            }
+        } else {
+            for (fIndex = 0; fIndex < (int) record->count(); ++fIndex) {
+                if (fCallback && fCallback->abort()) {
+                    return fNumReplaced;
+                }
+                record->visit<void>(fIndex, *this);
+            }
+        }
+
+        return fNumReplaced;
+    }
+
+    // Same as Draw for all ops except SaveLayer.
+    template <typename T> void operator()(const T& r) {
+        this->INHERITED::operator()(r);
+    }
+
+    void operator()(const SkRecords::SaveLayer& sl) {
+        const unsigned start = fOps.count() ? fOps[fIndex] : SkToU32(fIndex);
+
+        const SkLayerInfo::BlockInfo* info = this->findBlock(start);
+
+        SkBitmap layer;
+        SkIRect srcIR;
+        if (info && this->lookupOrRender(*info, &layer, &srcIR)) {
+            fNumReplaced++;
+
+            fCanvas->drawSprite(layer, srcIR.fLeft, srcIR.fTop, info->fPaint);
+
+            // Skip forward past the layer's interior ops and its restore.
+            if (fOps.count()) {
+                while (fOps[fIndex] < info->fRestoreOpID) {
+                    ++fIndex;
+                }
+                SkASSERT(fOps[fIndex] == info->fRestoreOpID);
+            } else {
+                fIndex = SkToInt(info->fRestoreOpID);
+            }
+            return;
+        }
+
+        // No cacheable layer here; play the saveLayer as recorded.
+        this->INHERITED::operator()(sl);
+    }
+
+private:
+    const SkLayerInfo::BlockInfo* findBlock(unsigned start) const {
+        // Pictures rarely carry more than a handful of layer blocks; a scan is fine.
+        for (int i = 0; i < fLayerInfo->numBlocks(); ++i) {
+            const SkLayerInfo::BlockInfo& info = fLayerInfo->block(i);
+            if (info.fSaveLayerOpID == start && is_hoistable(info)) {
+                return &info;
+            }
+        }
+        return NULL;
+    }
+
+    bool lookupOrRender(const SkLayerInfo::BlockInfo& info, SkBitmap* layer, SkIRect* srcIR) {
+        SkRect layerRect;
+        fInitialMat.mapRect(&layerRect, info.fBounds);
+
+        const SkIRect dstIR = layerRect.roundOut();
+        if (!compute_source_rect(info, fInitialMat, dstIR, srcIR)) {
+            return false;
+        }
+
+        // Don't let one giant layer evict everything else in the cache.
+        const size_t layerBytes = (size_t)srcIR->width() * srcIR->height() * 4;
+        if (layerBytes > SkResourceCache::GetTotalByteLimit() / 4) {
+            return false;
+        }
+
+        LayerKey key(fPicture->uniqueID(), SkToU32(info.fSaveLayerOpID), fInitialMat);
+        if (SkResourceCache::Find(key, LayerRec::Finder, layer)) {
+            return true;
+        }
+
+        if (!this->renderLayer(info, *srcIR, layer)) {
+            return false;
+        }
+        SkResourceCache::Add(SkNEW_ARGS(LayerRec, (key, *layer)));
+        return true;
+    }
+
+    // Render the layer's interior ops into a fresh bitmap, just as GrLayerHoister::DrawLayers
+    // does into a texture.
+    bool renderLayer(const SkLayerInfo::BlockInfo& info, const SkIRect& srcIR, SkBitmap* layer) {
+        if (!layer->tryAllocN32Pixels(srcIR.width(), srcIR.height())) {
+            return false;
+        }
+        layer->eraseColor(SK_ColorTRANSPARENT);
+
+        SkCanvas canvas(*layer);
+
+        // '-srcIR.topLeft()' maps the layer's top/left to the origin.
+        SkMatrix initialCTM;
+        initialCTM.setTranslate(SkIntToScalar(-srcIR.fLeft), SkIntToScalar(-srcIR.fTop));
+        initialCTM.preConcat(fInitialMat);
+        initialCTM.preConcat(info.fPreMat);
+
+        canvas.setMatrix(initialCTM);
+        canvas.concat(info.fLocalMat);
+
+        SkRecordPartialDraw(*fPicture->fRecord.get(), &canvas,
+                            fPicture->drawablePicts(), fPicture->drawableCount(),
+                            SkToU32(info.fSaveLayerOpID) + 1, SkToU32(info.fRestoreOpID),
+                            initialCTM);
+
+        layer->setImmutable();
+        return true;
+    }
+
+    SkCanvas*                 fCanvas;
+    const SkPicture*          fPicture;
+    const SkLayerInfo*        fLayerInfo;
+    const SkMatrix            fInitialMat;
+    SkPicture::AbortCallback* fCallback;
+
+    SkTDArray<unsigned>       fOps;
+    int                       fIndex;
+    int                       fNumReplaced;
+
+    typedef Draw INHERITED;
+};
+
+int SkRasterLayerCacheDraw(const SkPicture* picture,
+                           SkCanvas* canvas,
+                           SkPicture::AbortCallback* callback) {
+    const SkPicture::AccelData* data =
+            picture->EXPERIMENTAL_getAccelData(SkLayerInfo::ComputeKey());
+    const SkLayerInfo* layerInfo = static_cast<const SkLayerInfo*>(data);
+
+    if (!layerInfo || 0 == layerInfo->numBlocks()) {
+        picture->playback(canvas, callback);
+        return 0;
+    }
+
+    SkAutoCanvasRestore saveRestore(canvas, true /*save now, restore at exit*/);
+
+    ReplaceLayerDraw draw(canvas, picture, layerInfo, canvas->getTotalMatrix(), callback);
+    return draw.draw();
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRasterLayerCache_DEFINED
+#define SkRasterLayerCache_DEFINED
+
+#include "SkPicture.h"
+
+class SkCanvas;
+
+/**
+ *  Draw 'picture' into 'canvas', substituting cached pre-rendered bitmaps for the
+ *  saveLayer/restore blocks described by the picture's SkLayerInfo (computed when the
+ *  picture was recorded with kComputeSaveLayerInfo_RecordFlag).  This is the raster
+ *  analog of GrRecordReplaceDraw: a layer is rendered the first time it's needed and
+ *  cached in SkResourceCache, so replaying the same picture again skips the layer's
+ *  interior ops and just blits the cached result.
+ *
+ *  Pictures recorded without saveLayer info just play back normally.
+ *
+ *  Returns the number of saveLayer blocks that were replaced.
+ */
+int SkRasterLayerCacheDraw(const SkPicture*, SkCanvas*, SkPicture::AbortCallback* = NULL);
+
+/**
+ *  Purge any cached layers rendered from the picture with this uniqueID.
+ *  Called by ~SkPicture.
+ */
+void SkNotifyPictureLayersAreStale(uint32_t pictureID);
+
+#endif  // SkRasterLayerCache_DEFINED
@@ -12,6 +12,55 @@ SkRecord::~SkRecord() {
     for (unsigned i = 0; i < this->count(); i++) {
         this->mutate<void>(i, destroyer);
     }
+    this->destroyInternedPaints();
+}
+
+void SkRecord::rewind() {
+    SkASSERT(this->unique());
+    Destroyer destroyer;
+    for (unsigned i = 0; i < this->count(); i++) {
+        this->mutate<void>(i, destroyer);
+    }
+    this->destroyInternedPaints();
+    fCount = 0;            // fRecords keeps its capacity.
+    fCommandAlloc.rewind();
+    fAlloc.rewind();
+}
+
+SkPaint* SkRecord::internPaint(const SkPaint& src) {
+    const uint32_t hash = src.getHash();
+
+    // Find the start of the run of entries with this hash, if any.
+    int lo = 0, hi = fInternedPaints.count();
+    while (lo < hi) {
+        const int mid = (lo + hi) >> 1;
+        if (fInternedPaints[mid].fHash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    // getHash() can collide where operator== differs, so check the whole run.
+    int i = lo;
+    for (; i < fInternedPaints.count() && fInternedPaints[i].fHash == hash; i++) {
+        if (*fInternedPaints[i].fPaint == src) {
+            return fInternedPaints[i].fPaint;
+        }
+    }
+
+    SkPaint* copy = SkNEW_PLACEMENT_ARGS(this->alloc<SkPaint>(), SkPaint, (src));
+    PaintEntry* entry = fInternedPaints.insert(i);
+    entry->fHash = hash;
+    entry->fPaint = copy;
+    return copy;
+}
+
+void SkRecord::destroyInternedPaints() {
+    for (int i = 0; i < fInternedPaints.count(); i++) {
+        fInternedPaints[i].fPaint->~SkPaint();
+    }
+    fInternedPaints.rewind();
 }
 
 void SkRecord::grow() {
@@ -22,7 +71,9 @@ void SkRecord::grow() {
 }
 
 size_t SkRecord::bytesUsed() const {
-    size_t bytes = fAlloc.approxBytesAllocated() + sizeof(SkRecord);
+    size_t bytes = fCommandAlloc.approxBytesAllocated()
+                 + fAlloc.approxBytesAllocated()
+                 + sizeof(SkRecord);
     // If fReserved <= kInlineRecords, we've already accounted for fRecords with sizeof(SkRecord).
     // When we go over that limit, they're allocated on the heap (and the inline space is wasted).
     if (fReserved > kInlineRecords) {
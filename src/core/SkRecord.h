@@ -9,6 +9,7 @@
 #define SkRecord_DEFINED
 
 #include "SkRecords.h"
+#include "SkTDArray.h"
 #include "SkTLogic.h"
 #include "SkTemplates.h"
 #include "SkVarAlloc.h"
@@ -32,11 +33,21 @@ class SkRecord : public SkNVRefCnt<SkRecord> {
         kInlineAllocLgBytes = 8, // 1<<8 == 256 bytes inline, then SkVarAlloc starting at 512 bytes.
     };
 public:
-    SkRecord()
+    // bytesHint, if not zero, is how big a previous similar use ended up (see bytesUsed());
+    // we seed the allocators with it so a steady per-frame recording loop doesn't pay to
+    // ramp its block sizes back up from scratch in every new record.
+    explicit SkRecord(size_t bytesHint = 0)
         : fCount(0)
         , fReserved(kInlineRecords)
-        , fAlloc(kInlineAllocLgBytes+1,  // First malloc'd block is 2x as large as fInlineAlloc.
-                 fInlineAlloc, sizeof(fInlineAlloc)) {}
+        , fCommandAlloc(kInlineAllocLgBytes+1,  // First malloc'd block is 2x as large as
+                        fInlineAlloc, sizeof(fInlineAlloc))  // fInlineAlloc.
+        , fAlloc(kInlineAllocLgBytes+1) {
+        if (bytesHint) {
+            // Half each is approximate, but the doubling ramp forgives a bad split quickly.
+            fCommandAlloc.hint(bytesHint / 2);
+            fAlloc.hint(bytesHint / 2);
+        }
+    }
     ~SkRecord();
 
     // Returns the number of canvas commands in this SkRecord.
@@ -71,6 +82,11 @@ public:
         return (T*)fAlloc.alloc(sizeof(T) * count, SK_MALLOC_THROW);
     }
 
+    // Return a paint equal to src that this SkRecord owns, handing out one shared copy
+    // for all equal paints.  Records store the returned pointer (see SkRecords::Interned);
+    // it lives until the SkRecord is destroyed or rewound, like memory from alloc().
+    SkPaint* internPaint(const SkPaint& src);
+
     // Add a new command of type T to the end of this SkRecord.
     // You are expected to placement new an object of type T onto this pointer.
     template <typename T>
@@ -107,6 +123,11 @@ public:
         return fRecords[i].set(this->allocCommand<T>());
     }
 
+    // Destroy all commands and return to the empty state, keeping the memory we've already
+    // allocated around for reuse.  Only safe to call when this SkRecord is not shared (e.g.
+    // before it's been handed to an SkPicture).
+    void rewind();
+
     // Does not return the bytes in any pointers embedded in the Records; callers
     // need to iterate with a visitor to measure those they care for.
     size_t bytesUsed() const;
@@ -115,17 +136,23 @@ private:
     // An SkRecord is structured as an array of pointers into a big chunk of memory where
     // records representing each canvas draw call are stored:
     //
-    // fRecords:  [*][*][*]...
-    //             |  |  |
-    //             |  |  |
-    //             |  |  +---------------------------------------+
-    //             |  +-----------------+                        |
-    //             |                    |                        |
-    //             v                    v                        v
-    //   fAlloc:  [SkRecords::DrawRect][SkRecords::DrawPosTextH][SkRecords::DrawRect]...
+    //        fRecords:  [*][*][*]...
+    //                    |  |  |
+    //                    |  |  |
+    //                    |  |  +---------------------------------------+
+    //                    |  +-----------------+                        |
+    //                    |                    |                        |
+    //                    v                    v                        v
+    // fCommandAlloc:  [SkRecords::DrawRect][SkRecords::DrawPosTextH][SkRecords::DrawRect]...
     //
     // We store the types of each of the pointers alongside the pointer.
     // The cost to append a T to this structure is 8 + sizeof(T) bytes.
+    //
+    // Commands get their own allocator, separate from the one backing alloc<T>(), so that
+    // their payloads pack back-to-back in playback order: fRecords can't go away (the BBH
+    // hands SkRecordDraw op indices, so we need random access), but walking the commands
+    // 0,1,2,... now reads fCommandAlloc essentially linearly.  Arrays the commands point to
+    // (points, glyphs, etc.) land in fAlloc and don't break up the command stream.
 
     // A mutator that can be used with replace to destroy canvas commands.
     struct Destroyer {
@@ -140,11 +167,22 @@ private:
     }
 
     template <typename T>
-    SK_WHEN(!SkTIsEmpty<T>, T*) allocCommand() { return this->alloc<T>(); }
+    SK_WHEN(!SkTIsEmpty<T>, T*) allocCommand() {
+        return (T*)fCommandAlloc.alloc(sizeof(T), SK_MALLOC_THROW);
+    }
 
     void grow();
 
-    // A typed pointer to some bytes in fAlloc.  visit() and mutate() allow polymorphic dispatch.
+    // One entry per unique interned paint, kept sorted by hash so internPaint() can
+    // binary search.  The paints themselves are allocated out of fAlloc; we destroy
+    // them here since the records referencing them don't.
+    struct PaintEntry {
+        uint32_t fHash;
+        SkPaint* fPaint;
+    };
+    void destroyInternedPaints();
+
+    // A typed pointer to some bytes in fCommandAlloc.  visit()/mutate() allow polymorphic dispatch.
     struct Record {
         // On 32-bit machines we store type in 4 bytes, followed by a pointer.  Simple.
         // On 64-bit machines we store a pointer with the type slotted into two top (unused) bytes.
@@ -152,7 +190,7 @@ private:
         uint64_t fTypeAndPtr;
         static const int kTypeShift = sizeof(void*) == 4 ? 32 : 48;
 
-        // Point this record to its data in fAlloc.  Returns ptr for convenience.
+        // Point this record to its data in fCommandAlloc.  Returns ptr for convenience.
         template <typename T>
         T* set(T* ptr) {
             fTypeAndPtr = ((uint64_t)T::kType) << kTypeShift | (uintptr_t)ptr;
@@ -189,9 +227,13 @@ private:
     unsigned fCount, fReserved;
     SkAutoSTMalloc<kInlineRecords, Record> fRecords;
 
-    // fAlloc needs to be a data structure which can append variable length data in contiguous
-    // chunks, returning a stable handle to that data for later retrieval.
+    // Both allocators need to be data structures which can append variable length data in
+    // contiguous chunks, returning a stable handle to that data for later retrieval.
+    // fCommandAlloc holds only command payloads, in append order; fAlloc holds everything
+    // allocated through alloc<T>().
+    SkVarAlloc fCommandAlloc;
     SkVarAlloc fAlloc;
+    SkTDArray<PaintEntry> fInternedPaints;
     char fInlineAlloc[1 << kInlineAllocLgBytes];
 };
 
@@ -8,6 +8,38 @@
 #include "SkLayerInfo.h"
 #include "SkRecordDraw.h"
 #include "SkPatchUtils.h"
+#include "SkTDArray.h"
+#include "SkTSort.h"
+#include "SkTime.h"
+
+namespace {
+
+struct DrawOpContext {
+    const SkRecord*           fRecord;
+    SkRecords::Draw*          fDraw;
+    SkPicture::AbortCallback* fCallback;
+};
+
+// SkBBoxHierarchy::SearchProc that records each hit for later merging.
+bool gather_op(unsigned opIndex, void* context) {
+    ((SkTDArray<unsigned>*)context)->push(opIndex);
+    return true;
+}
+
+// SkBBoxHierarchy::SearchProc that draws each op the BBH hands us.
+bool draw_op(unsigned opIndex, void* context) {
+    DrawOpContext* ctx = (DrawOpContext*)context;
+    if (ctx->fCallback && ctx->fCallback->abort()) {
+        return false;
+    }
+    // This visit call uses the SkRecords::Draw::operator() to call
+    // methods on the |canvas|, wrapped by methods defined with the
+    // DRAW() macro.
+    ctx->fRecord->visit<void>(opIndex, *ctx->fDraw);
+    return true;
+}
+
+}  // namespace
 
 void SkRecordDraw(const SkRecord& record,
                   SkCanvas* canvas,
@@ -29,19 +61,11 @@ void SkRecordDraw(const SkRecord& record,
             query.setEmpty();
         }
 
-        SkTDArray<unsigned> ops;
-        bbh->search(query, &ops);
-
+        // Stream the hits (in draw order) straight into the draw visitor
+        // rather than building a temporary ops array every frame.
         SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
-        for (int i = 0; i < ops.count(); i++) {
-            if (callback && callback->abort()) {
-                return;
-            }
-            // This visit call uses the SkRecords::Draw::operator() to call
-            // methods on the |canvas|, wrapped by methods defined with the
-            // DRAW() macro.
-            record.visit<void>(ops[i], draw);
-        }
+        DrawOpContext ctx = { &record, &draw, callback };
+        bbh->search(query, draw_op, &ctx);
     } else {
         // Draw all ops.
         SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
@@ -57,6 +81,154 @@ void SkRecordDraw(const SkRecord& record,
     }
 }
 
+void SkRecordDrawDamage(const SkRecord& record,
+                        SkCanvas* canvas,
+                        SkPicture const* const drawablePicts[],
+                        SkDrawable* const drawables[],
+                        int drawableCount,
+                        const SkBBoxHierarchy* bbh,
+                        const SkRegion& damage,
+                        SkPicture::AbortCallback* callback) {
+    if (damage.isEmpty()) {
+        return;
+    }
+
+    SkAutoCanvasRestore saveRestore(canvas, true /*save now, restore at exit*/);
+    canvas->clipRegion(damage);
+
+    SkMatrix inverse;
+    if (NULL == bbh || damage.isRect() || !canvas->getTotalMatrix().invert(&inverse)) {
+        // A single rectangle (or no BBH to cull with) is handled exactly like
+        // an ordinary clipped draw.
+        SkRecordDraw(record, canvas, drawablePicts, drawables, drawableCount, bbh, callback);
+        return;
+    }
+
+    // Query the BBH once per damage rectangle and merge the hits, so ops that
+    // fall between disjoint dirty areas are culled rather than redrawn.  The
+    // region is in device space; the BBH was filled in identity space, so each
+    // query rect is mapped back through the inverse CTM, with the same one
+    // pixel outset getClipBounds() applies for antialiasing slop.
+    SkTDArray<unsigned> ops;
+    for (SkRegion::Iterator iter(damage); !iter.done(); iter.next()) {
+        SkRect query = SkRect::Make(iter.rect());
+        query.outset(SK_Scalar1, SK_Scalar1);
+        inverse.mapRect(&query);
+        bbh->search(query, gather_op, &ops);
+    }
+    if (0 == ops.count()) {
+        return;
+    }
+    SkTQSort(ops.begin(), ops.end() - 1);
+
+    SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
+    for (int i = 0; i < ops.count(); i++) {
+        if (i > 0 && ops[i] == ops[i - 1]) {
+            continue;  // the same op can be hit by several damage rectangles
+        }
+        if (callback && callback->abort()) {
+            return;
+        }
+        record.visit<void>(ops[i], draw);
+    }
+}
+
+namespace {
+
+// Wraps SkRecords::Draw, timing each op and charging it to an SkRecordDrawProfile.
+class ProfileDraw : SkNoncopyable {
+public:
+    ProfileDraw(SkCanvas* canvas, SkPicture const* const drawablePicts[],
+                SkDrawable* const drawables[], int drawableCount,
+                SkRecordDrawProfile* profile)
+        : fDraw(canvas, drawablePicts, drawables, drawableCount)
+        , fProfile(profile)
+        , fIndex(0) {}
+
+    // Must be kept in sync with the record index passed to visit().
+    void setIndex(unsigned index) { fIndex = index; }
+
+    template <typename T> void operator()(const T& r) {
+        const double start = SkTime::GetNSecs();
+        fDraw(r);
+        this->tally(T::kType, SkTime::GetNSecs() - start);
+    }
+
+private:
+    void tally(SkRecords::Type type, double nsecs) {
+        SkRecordDrawProfile::TypeStat* stat = &fProfile->fTypes[type];
+        stat->fCalls += 1;
+        stat->fNSecs += nsecs;
+        fProfile->fTotalNSecs += nsecs;
+
+        // Keep fHotOps sorted, most expensive first.  kMaxHotOps is small
+        // enough that insertion into the sorted array is cheap.
+        int n = fProfile->fHotOpCount;
+        if (SkRecordDrawProfile::kMaxHotOps == n) {
+            if (nsecs <= fProfile->fHotOps[n - 1].fNSecs) {
+                return;
+            }
+            n -= 1;
+        } else {
+            fProfile->fHotOpCount = n + 1;
+        }
+        while (n > 0 && nsecs > fProfile->fHotOps[n - 1].fNSecs) {
+            fProfile->fHotOps[n] = fProfile->fHotOps[n - 1];
+            n -= 1;
+        }
+        fProfile->fHotOps[n].fIndex = fIndex;
+        fProfile->fHotOps[n].fNSecs = nsecs;
+    }
+
+    SkRecords::Draw      fDraw;
+    SkRecordDrawProfile* fProfile;
+    unsigned             fIndex;
+};
+
+struct ProfileOpContext {
+    const SkRecord* fRecord;
+    ProfileDraw*    fDraw;
+};
+
+bool profile_op(unsigned opIndex, void* context) {
+    ProfileOpContext* ctx = (ProfileOpContext*)context;
+    ctx->fDraw->setIndex(opIndex);
+    ctx->fRecord->visit<void>(opIndex, *ctx->fDraw);
+    return true;
+}
+
+}  // namespace
+
+const char* SkRecordDrawProfile::NameOfType(int type) {
+#define CASE(T) case SkRecords::T##_Type: return #T;
+    switch (type) { SK_RECORD_TYPES(CASE) }
+#undef CASE
+    SkDEBUGFAIL("Unknown SkRecords::Type");
+    return "Unknown";
+}
+
+void SkRecordProfiledDraw(const SkRecord& record, SkCanvas* canvas,
+                          SkPicture const* const drawablePicts[],
+                          SkDrawable* const drawables[], int drawableCount,
+                          const SkBBoxHierarchy* bbh, SkRecordDrawProfile* profile) {
+    SkAutoCanvasRestore saveRestore(canvas, true /*save now, restore at exit*/);
+
+    ProfileDraw draw(canvas, drawablePicts, drawables, drawableCount, profile);
+    if (bbh) {
+        SkRect query;
+        if (!canvas->getClipBounds(&query)) {
+            query.setEmpty();
+        }
+        ProfileOpContext ctx = { &record, &draw };
+        bbh->search(query, profile_op, &ctx);
+    } else {
+        for (unsigned i = 0; i < record.count(); i++) {
+            draw.setIndex(i);
+            record.visit<void>(i, draw);
+        }
+    }
+}
+
 void SkRecordPartialDraw(const SkRecord& record, SkCanvas* canvas,
                          SkPicture const* const drawablePicts[], int drawableCount,
                          unsigned start, unsigned stop,
@@ -112,6 +284,8 @@ DRAW(DrawPosTextH, drawPosTextH(r.text, r.byteLength, r.xpos, r.y, r.paint));
 DRAW(DrawRRect, drawRRect(r.rrect, r.paint));
 DRAW(DrawRect, drawRect(r.rect, r.paint));
 DRAW(DrawSprite, drawSprite(r.bitmap.shallowCopy(), r.left, r.top, r.paint));
+DRAW(DrawSpriteBatch,
+     drawSpriteBatch(r.bitmap.shallowCopy(), r.src, r.dst, r.count, r.paint));
 DRAW(DrawText, drawText(r.text, r.byteLength, r.x, r.y, r.paint));
 DRAW(DrawTextBlob, drawTextBlob(r.blob, r.x, r.y, r.paint));
 DRAW(DrawTextOnPath, drawTextOnPath(r.text, r.byteLength, r.path, &r.matrix, r.paint));
@@ -119,6 +293,19 @@ DRAW(DrawVertices, drawVertices(r.vmode, r.vertexCount, r.vertices, r.texs, r.co
                                 r.xmode.get(), r.indices, r.indexCount, r.paint));
 #undef DRAW
 
+template <> void Draw::draw(const DrawRectBatch& r) {
+    for (unsigned i = 0; i < r.count; i++) {
+        fCanvas->drawRect(r.rects[i], r.paint);
+    }
+}
+
+template <> void Draw::draw(const DrawBitmapBatch& r) {
+    const SkBitmap bitmap = r.bitmap.shallowCopy();
+    for (unsigned i = 0; i < r.count; i++) {
+        fCanvas->drawBitmap(bitmap, r.positions[i].x(), r.positions[i].y(), r.paint);
+    }
+}
+
 template <> void Draw::draw(const DrawDrawable& r) {
     SkASSERT(r.index >= 0);
     SkASSERT(r.index < fDrawableCount);
@@ -402,7 +589,26 @@ private:
         return rect;
     }
 
+    Bounds bounds(const DrawSpriteBatch& op) const {  // Like DrawSprite: no matrix, just clip.
+        SkRect rect = Bounds::MakeEmpty();
+        for (int i = 0; i < op.count; i++) {
+            rect.join(Bounds::MakeXYWH(op.dst[i].fX, op.dst[i].fY,
+                                       op.src[i].width(), op.src[i].height()));
+        }
+        if (!rect.intersect(fCurrentClipBounds)) {
+            return Bounds::MakeEmpty();
+        }
+        return rect;
+    }
+
     Bounds bounds(const DrawRect& op) const { return this->adjustAndMap(op.rect, &op.paint); }
+    Bounds bounds(const DrawRectBatch& op) const {
+        SkRect dst = op.rects[0];
+        for (unsigned i = 1; i < op.count; i++) {
+            dst.join(op.rects[i]);
+        }
+        return this->adjustAndMap(dst, &op.paint);
+    }
     Bounds bounds(const DrawOval& op) const { return this->adjustAndMap(op.oval, &op.paint); }
     Bounds bounds(const DrawRRect& op) const {
         return this->adjustAndMap(op.rrect.rect(), &op.paint);
@@ -433,6 +639,15 @@ private:
                 SkRect::MakeXYWH(op.left, op.top, op.bitmap.width(), op.bitmap.height()),
                 op.paint);
     }
+    Bounds bounds(const DrawBitmapBatch& op) const {
+        const SkScalar w = SkIntToScalar(op.bitmap.width()),
+                       h = SkIntToScalar(op.bitmap.height());
+        SkRect dst = SkRect::MakeXYWH(op.positions[0].x(), op.positions[0].y(), w, h);
+        for (unsigned i = 1; i < op.count; i++) {
+            dst.join(SkRect::MakeXYWH(op.positions[i].x(), op.positions[i].y(), w, h));
+        }
+        return this->adjustAndMap(dst, op.paint);
+    }
 
     Bounds bounds(const DrawPath& op) const {
         return op.path.isInverseFillType() ? fCurrentClipBounds
@@ -28,6 +28,49 @@ void SkRecordDraw(const SkRecord&, SkCanvas*, SkPicture const* const drawablePic
                   SkDrawable* const drawables[], int drawableCount,
                   const SkBBoxHierarchy*, SkPicture::AbortCallback*);
 
+// Draw an SkRecord restricted to a damage region (in the canvas' device space).
+// The canvas is clipped to the region, and when a BBH is provided the ops are
+// culled against each rectangle of the region rather than just its bounds, so
+// ops that fall between disjoint dirty areas are skipped instead of redrawn.
+void SkRecordDrawDamage(const SkRecord&, SkCanvas*, SkPicture const* const drawablePicts[],
+                        SkDrawable* const drawables[], int drawableCount,
+                        const SkBBoxHierarchy*, const SkRegion& damage,
+                        SkPicture::AbortCallback*);
+
+// Timing data filled in by SkRecordProfiledDraw(), attributing playback cost to
+// record types and to the most expensive individual records.
+struct SkRecordDrawProfile {
+    static const int kMaxHotOps = 10;
+
+    struct TypeStat {
+        int    fCalls;  // how many records of this type were played back
+        double fNSecs;  // total wall time spent playing them
+    };
+    struct HotOp {
+        unsigned fIndex;  // index of the record within its SkRecord
+        double   fNSecs;
+    };
+
+    SkRecordDrawProfile() { this->reset(); }
+    void reset() { sk_bzero(this, sizeof(*this)); }
+
+    // Printable name for an SkRecords::Type, e.g. "DrawRect".
+    static const char* NameOfType(int type);
+
+    TypeStat fTypes[SkRecords::kTypeCount];  // indexed by SkRecords::Type
+    HotOp    fHotOps[kMaxHotOps];            // most expensive first; fHotOpCount are valid
+    int      fHotOpCount;
+    double   fTotalNSecs;
+};
+
+// Draw an SkRecord as SkRecordDraw does, timing each op and accumulating the results
+// into profile.  The profile is not reset first, so several draws may be pooled.
+// Reading the clock around every record makes this slower than SkRecordDraw.
+void SkRecordProfiledDraw(const SkRecord&, SkCanvas*,
+                          SkPicture const* const drawablePicts[],
+                          SkDrawable* const drawables[], int drawableCount,
+                          const SkBBoxHierarchy*, SkRecordDrawProfile* profile);
+
 // Draw a portion of an SkRecord into an SkCanvas.
 // When drawing a portion of an SkRecord the CTM on the passed in canvas must be
 // the composition of the replay matrix with the record-time CTM (for the portion
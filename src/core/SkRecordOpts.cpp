@@ -7,9 +7,13 @@
 
 #include "SkRecordOpts.h"
 
+#include "SkBBoxHierarchy.h"
+#include "SkRecordDraw.h"
 #include "SkRecordPattern.h"
 #include "SkRecords.h"
+#include "SkShader.h"
 #include "SkTDArray.h"
+#include "SkTemplates.h"
 
 using namespace SkRecords;
 
@@ -22,6 +26,7 @@ void SkRecordOptimize(SkRecord* record) {
 
     SkRecordNoopSaveLayerDrawRestores(record);
     SkRecordMergeSvgOpacityAndFilterLayers(record);
+    SkRecordBatchDraws(record);
 }
 
 // Most of the optimizations in this file are pattern-based.  These are all defined as structs with:
@@ -143,6 +148,43 @@ void SkRecordNoopSaveRestores(SkRecord* record) {
     while (apply(&onlyDraws, record) || apply(&noDraws, record));
 }
 
+// Mutator that folds a layer's color into the draw's paint.  Paints held through the
+// record's intern table may be shared with other records, so those are folded into a
+// copy and the record is pointed at a freshly interned paint instead.
+struct FoldLayerColor {
+    SK_CREATE_MEMBER_DETECTOR(paint);
+
+    SkRecord*      fRecord;
+    const SkPaint* fLayerPaint;
+
+    template <typename T>
+    SK_WHEN(HasMember_paint<T>, bool) operator()(T* draw) {
+        return this->fold(&draw->paint);
+    }
+
+    template <typename T>
+    SK_WHEN(!HasMember_paint<T>, bool) operator()(T*) { return false; }
+
+    bool fold(SkPaint* paint) {
+        return fold_opacity_layer_color_to_paint(*fLayerPaint, false /*isSaveLayer*/, paint);
+    }
+
+    bool fold(Interned<SkPaint>* slot) {
+        const SkPaint* shared = *slot;
+        if (NULL == shared) {
+            // We can just give the draw the SaveLayer's paint.
+            // TODO(mtklein): figure out how to do this clearly
+            return false;
+        }
+        SkPaint folded(*shared);
+        if (!fold_opacity_layer_color_to_paint(*fLayerPaint, false /*isSaveLayer*/, &folded)) {
+            return false;
+        }
+        *slot = fRecord->internPaint(folded);
+        return true;
+    }
+};
+
 // For some SaveLayer-[drawing command]-Restore patterns, merge the SaveLayer's alpha into the
 // draw, and no-op the SaveLayer and Restore.
 struct SaveLayerDrawRestoreNooper {
@@ -156,14 +198,8 @@ struct SaveLayerDrawRestoreNooper {
             return KillSaveLayerAndRestore(record, begin);
         }
 
-        SkPaint* drawPaint = pattern->second<SkPaint>();
-        if (drawPaint == NULL) {
-            // We can just give the draw the SaveLayer's paint.
-            // TODO(mtklein): figure out how to do this clearly
-            return false;
-        }
-
-        if (!fold_opacity_layer_color_to_paint(*layerPaint, false /*isSaveLayer*/, drawPaint)) {
+        FoldLayerColor fold = { record, layerPaint };
+        if (!record->mutate<bool>(begin + 1, fold)) {
             return false;
         }
 
@@ -204,17 +240,20 @@ struct SvgOpacityAndFilterLayerMergePass {
 
         // This layer typically contains a filter, but this should work for layers with for other
         // purposes too.
-        SkPaint* filterLayerPaint = pattern->fourth<SaveLayer>()->paint;
+        const SkPaint* filterLayerPaint = pattern->fourth<SaveLayer>()->paint;
         if (filterLayerPaint == NULL) {
             // We can just give the inner SaveLayer the paint of the outer SaveLayer.
             // TODO(mtklein): figure out how to do this clearly
             return false;
         }
 
-        if (!fold_opacity_layer_color_to_paint(*opacityPaint, true /*isSaveLayer*/,
-                                               filterLayerPaint)) {
+        // The interned paint may be shared with other records, so fold into a copy
+        // and point the inner SaveLayer at a freshly interned paint.
+        SkPaint folded(*filterLayerPaint);
+        if (!fold_opacity_layer_color_to_paint(*opacityPaint, true /*isSaveLayer*/, &folded)) {
             return false;
         }
+        pattern->fourth<SaveLayer>()->paint = record->internPaint(folded);
 
         return KillSaveLayerAndRestore(record, begin);
     }
@@ -230,3 +269,294 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
     SvgOpacityAndFilterLayerMergePass pass;
     apply(&pass, record);
 }
+
+// Visitor that returns the command as a const T* when it's exactly a T, or NULL otherwise.
+template <typename T>
+struct MatchesType {
+    const T* operator()(const T& op) { return &op; }
+    template <typename U> const T* operator()(const U&) { return NULL; }
+};
+
+static bool same_paint(const Interned<SkPaint>& a, const Interned<SkPaint>& b) {
+    const SkPaint* aPaint = a;
+    const SkPaint* bPaint = b;
+    if (aPaint == bPaint) {
+        return true;  // Interning makes this the common case for equal paints.
+    }
+    if (NULL == aPaint || NULL == bPaint) {
+        return false;
+    }
+    return *aPaint == *bPaint;
+}
+
+static bool same_bitmap(const ImmutableBitmap& a, const ImmutableBitmap& b) {
+    // The pixels are immutable, so sharing the pixel ref (at the same origin
+    // and with the same info) means the two draws read the same texels.
+    const SkBitmap aBitmap = a.shallowCopy();
+    const SkBitmap bBitmap = b.shallowCopy();
+    return aBitmap.pixelRef()       == bBitmap.pixelRef()
+        && aBitmap.pixelRefOrigin() == bBitmap.pixelRefOrigin()
+        && aBitmap.info()           == bBitmap.info();
+}
+
+// Only runs long enough to pay for the batch record and its side array are worth rewriting;
+// shorter runs aren't hurting anyone.
+static const unsigned kMinRunToBatch = 4;
+
+// Returns one past the last command in the DrawRect run starting at begin, and batches the
+// run if it's long enough.  Playback order and per-rect semantics are unchanged; we just
+// collapse n records (and their n BBH entries and visit dispatches) down to one.
+static unsigned batch_rect_run(SkRecord* record, unsigned begin, const DrawRect* first) {
+    MatchesType<DrawRect> match;
+    unsigned end = begin + 1;
+    while (end < record->count()) {
+        const DrawRect* next = record->visit<const DrawRect*>(end, match);
+        if (NULL == next || !(next->paint == first->paint)) {
+            break;
+        }
+        end++;
+    }
+
+    const unsigned n = end - begin;
+    if (n >= kMinRunToBatch) {
+        SkRect* rects = record->alloc<SkRect>(n);
+        for (unsigned i = 0; i < n; i++) {
+            rects[i] = record->visit<const DrawRect*>(begin + i, match)->rect;
+        }
+        const SkPaint paint = first->paint;   // replace() destroys first.
+        SkNEW_PLACEMENT_ARGS(record->replace<DrawRectBatch>(begin),
+                             DrawRectBatch, (paint, rects, n));
+        for (unsigned i = begin + 1; i < end; i++) {
+            record->replace<NoOp>(i);
+        }
+    }
+    return end;
+}
+
+// As above, for DrawBitmap runs sharing one bitmap and paint.
+static unsigned batch_bitmap_run(SkRecord* record, unsigned begin, const DrawBitmap* first) {
+    MatchesType<DrawBitmap> match;
+    unsigned end = begin + 1;
+    while (end < record->count()) {
+        const DrawBitmap* next = record->visit<const DrawBitmap*>(end, match);
+        if (NULL == next
+                || !same_paint(next->paint, first->paint)
+                || !same_bitmap(next->bitmap, first->bitmap)) {
+            break;
+        }
+        end++;
+    }
+
+    const unsigned n = end - begin;
+    if (n >= kMinRunToBatch) {
+        SkPoint* positions = record->alloc<SkPoint>(n);
+        for (unsigned i = 0; i < n; i++) {
+            const DrawBitmap* op = record->visit<const DrawBitmap*>(begin + i, match);
+            positions[i].set(op->left, op->top);
+        }
+        // Copy the bitmap out before replace() destroys first.  The interned paint is
+        // owned by the record itself, so its pointer stays valid across replace().
+        const SkBitmap bitmap = first->bitmap.shallowCopy();
+        SkPaint* paint = first->paint;
+        SkNEW_PLACEMENT_ARGS(record->replace<DrawBitmapBatch>(begin),
+                             DrawBitmapBatch, (paint, bitmap, positions, n));
+        for (unsigned i = begin + 1; i < end; i++) {
+            record->replace<NoOp>(i);
+        }
+    }
+    return end;
+}
+
+namespace {
+
+// An SkBBoxHierarchy that just steals the per-op bounds SkRecordFillBounds() feeds it,
+// so the overdraw pass below can reuse the same conservative bounds the BBH would get.
+class BoundsCapture : public SkBBoxHierarchy {
+public:
+    void insert(const SkRect bounds[], int N) override { fBounds.append(N, bounds); }
+    void search(const SkRect&, SkTDArray<unsigned>*) const override {}
+    size_t bytesUsed() const override { return 0; }
+    SkRect getRootBound() const override { return SkRect::MakeEmpty(); }
+
+    const SkRect& get(int i) const { return fBounds[i]; }
+    int count() const { return fBounds.count(); }
+
+private:
+    SkTDArray<SkRect> fBounds;
+};
+
+// True if a fill with this paint is guaranteed to leave every pixel it covers fully opaque.
+static bool paint_covers_opaquely(const SkPaint& paint) {
+    if (SkPaint::kFill_Style != paint.getStyle() || 0xFF != paint.getAlpha()) {
+        return false;
+    }
+    if (paint.getPathEffect() || paint.getMaskFilter() || paint.getColorFilter() ||
+        paint.getImageFilter() || paint.getLooper() || paint.getRasterizer()) {
+        return false;
+    }
+    if (paint.getShader() && !paint.getShader()->isOpaque()) {
+        return false;
+    }
+    SkXfermode* xfermode = paint.getXfermode();
+    if (xfermode) {
+        SkXfermode::Mode mode;
+        if (!xfermode->asMode(&mode) ||
+            (SkXfermode::kSrc_Mode != mode && SkXfermode::kSrcOver_Mode != mode)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Forward scan that computes the device-space rect (usually empty) each op is known to
+// cover with fully opaque pixels.  Coverage is only credited to fill draws with opaque
+// paints under an axis-preserving matrix, a plain intersected non-AA rectangular clip,
+// and outside any saveLayer; anywhere the analysis gets fuzzy, it credits nothing.
+class OpaqueCoverage : SkNoncopyable {
+public:
+    OpaqueCoverage(const SkRect& cullRect, SkIRect* opaque)
+        : fOpaque(opaque)
+        , fCurrentOp(0)
+        , fCTM(&SkMatrix::I())
+        , fLayerDepth(0)
+        , fClipTight(true) {
+        cullRect.roundOut(&fClipDev);
+    }
+
+    void setCurrentOp(unsigned currentOp) { fCurrentOp = currentOp; }
+
+    template <typename T> void operator()(const T& op) {
+        fOpaque[fCurrentOp] = this->coverage(op);
+        this->updateCTM(op);
+        this->updateState(op);
+    }
+
+private:
+    struct SavedState {
+        bool clipTight;
+        bool isLayer;
+    };
+
+    // As in SkRecordDraw's bounds analysis, only Restore and SetMatrix change the CTM.
+    template <typename T> void updateCTM(const T&) {}
+    void updateCTM(const Restore& op)   { fCTM = &op.matrix; }
+    void updateCTM(const SetMatrix& op) { fCTM = &op.matrix; }
+
+    void push(bool isLayer) {
+        SavedState s = { fClipTight, isLayer };
+        fStack.push(s);
+    }
+
+    template <typename T> void updateState(const T&) {}
+    void updateState(const Save&)      { this->push(false); }
+    void updateState(const SaveLayer&) { this->push(true); fLayerDepth++; }
+    void updateState(const Restore& op) {
+        if (!fStack.isEmpty()) {
+            SavedState s;
+            fStack.pop(&s);
+            fClipTight = s.clipTight;
+            if (s.isLayer) {
+                fLayerDepth--;
+            }
+        }
+        fClipDev = op.devBounds;
+    }
+    void updateState(const ClipRect& op) {
+        if (SkRegion::kReplace_Op == op.opAA.op) {
+            fClipTight = !op.opAA.aa;
+        } else if (SkRegion::kIntersect_Op == op.opAA.op) {
+            fClipTight = fClipTight && !op.opAA.aa;
+        } else {
+            fClipTight = false;
+        }
+        fClipDev = op.devBounds;
+    }
+    void updateState(const ClipRRect& op)  { fClipTight = false; fClipDev = op.devBounds; }
+    void updateState(const ClipPath& op)   { fClipTight = false; fClipDev = op.devBounds; }
+    void updateState(const ClipRegion& op) { fClipTight = false; fClipDev = op.devBounds; }
+
+    bool stateAllowsCoverage() const { return fClipTight && 0 == fLayerDepth; }
+
+    template <typename T> SkIRect coverage(const T&) const { return SkIRect::MakeEmpty(); }
+
+    SkIRect coverage(const DrawRect& op) const {
+        if (!this->stateAllowsCoverage() || !fCTM->rectStaysRect() ||
+            !paint_covers_opaquely(op.paint)) {
+            return SkIRect::MakeEmpty();
+        }
+        SkRect dev;
+        fCTM->mapRect(&dev, op.rect);
+        SkIRect idev;
+        dev.roundIn(&idev);  // only pixels entirely inside are certainly opaque
+        return idev.intersect(fClipDev) ? idev : SkIRect::MakeEmpty();
+    }
+
+    SkIRect coverage(const DrawPaint& op) const {
+        return this->stateAllowsCoverage() && paint_covers_opaquely(op.paint)
+                   ? fClipDev : SkIRect::MakeEmpty();
+    }
+
+    SkIRect* fOpaque;
+    unsigned fCurrentOp;
+    const SkMatrix* fCTM;
+    SkIRect fClipDev;           // device bounds of the current clip
+    int fLayerDepth;            // how many saveLayers we're inside
+    bool fClipTight;            // true when fClipDev is exactly the set of unclipped pixels
+    SkTDArray<SavedState> fStack;
+};
+
+}  // namespace
+
+void SkRecordNoopHiddenDraws(const SkRect& cullRect, SkRecord* record) {
+    const int count = record->count();
+    if (0 == count) {
+        return;
+    }
+
+    // Conservative device bounds for every op, from the same machinery that fills the BBH.
+    BoundsCapture bounds;
+    SkRecordFillBounds(cullRect, *record, &bounds);
+    SkASSERT(bounds.count() == count);
+
+    SkAutoTMalloc<SkIRect> opaque(count);
+    OpaqueCoverage coverage(cullRect, opaque.get());
+    for (int i = 0; i < count; i++) {
+        coverage.setCurrentOp(i);
+        record->visit<void>(i, coverage);
+    }
+
+    // Walk back-to-front accumulating opaque coverage; a draw whose bounds are already
+    // completely covered by draws that come after it can never affect the final pixels.
+    SkRegion covered;
+    for (int i = count - 1; i >= 0; i--) {
+        IsDraw isDraw;
+        if (record->mutate<bool>(i, isDraw)) {
+            SkIRect devBounds;
+            bounds.get(i).roundOut(&devBounds);
+            if (!devBounds.isEmpty() && covered.contains(devBounds)) {
+                record->replace<NoOp>(i);
+                continue;
+            }
+        }
+        if (!opaque[i].isEmpty()) {
+            covered.op(opaque[i], SkRegion::kUnion_Op);
+        }
+    }
+}
+
+void SkRecordBatchDraws(SkRecord* record) {
+    MatchesType<DrawRect> isDrawRect;
+    MatchesType<DrawBitmap> isDrawBitmap;
+
+    for (unsigned i = 0; i < record->count(); /* i advanced below */) {
+        if (const DrawRect* op = record->visit<const DrawRect*>(i, isDrawRect)) {
+            i = batch_rect_run(record, i, op);
+            continue;
+        }
+        if (const DrawBitmap* op = record->visit<const DrawBitmap*>(i, isDrawBitmap)) {
+            i = batch_bitmap_run(record, i, op);
+            continue;
+        }
+        i++;
+    }
+}
@@ -24,4 +24,13 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Coalesce runs of DrawRect commands sharing one paint, and runs of DrawBitmap commands
+// sharing one bitmap and paint, into single DrawRectBatch / DrawBitmapBatch commands.
+void SkRecordBatchDraws(SkRecord*);
+
+// Turns draws that are completely covered by later opaque draws into no-ops -- front-to-back
+// overdraw elimination for the raster backend.  Needs the picture's cull rect to seed the
+// clip and bounds analysis, so it runs separately from SkRecordOptimize().
+void SkRecordNoopHiddenDraws(const SkRect& cullRect, SkRecord*);
+
 #endif//SkRecordOpts_DEFINED
@@ -60,8 +60,11 @@ public:
     }
 
 private:
-    // Abstracts away whether the paint is always part of the command or optional.
+    // Abstracts away whether the paint is inline, optional, or interned.
+    // N.B. interned paints may be shared with other records; don't mutate
+    // them through this pointer.  (See SkRecord::internPaint().)
     template <typename T> static T* AsPtr(SkRecords::Optional<T>& x) { return x; }
+    template <typename T> static T* AsPtr(SkRecords::Interned<T>& x) { return x; }
     template <typename T> static T* AsPtr(T& x) { return &x; }
 
     type* fPaint;
@@ -106,6 +106,17 @@ T* SkRecorder::copy(const T src[], size_t count) {
     return dst;
 }
 
+// Specialization for SkPaint: identical paints are shared through the record's
+// intern table rather than copied per record.  Text- and sprite-heavy content
+// tends to repeat a handful of paints across thousands of records.
+template <>
+SkPaint* SkRecorder::copy(const SkPaint* src) {
+    if (NULL == src) {
+        return NULL;
+    }
+    return fRecord->internPaint(*src);
+}
+
 // Specialization for copying strings, using memcpy.
 // This measured around 2x faster for copying code points,
 // but I found no corresponding speedup for other arrays.
@@ -141,6 +152,13 @@ void SkRecorder::onDrawRect(const SkRect& rect, const SkPaint& paint) {
     APPEND(DrawRect, delay_copy(paint), rect);
 }
 
+void SkRecorder::onDrawRects(const SkRect rects[], int count, const SkPaint& paint) {
+    // Record per-rect; the batching win is a raster-time optimization.
+    for (int i = 0; i < count; ++i) {
+        APPEND(DrawRect, delay_copy(paint), rects[i]);
+    }
+}
+
 void SkRecorder::onDrawOval(const SkRect& oval, const SkPaint& paint) {
     APPEND(DrawOval, delay_copy(paint), oval);
 }
@@ -209,6 +227,16 @@ void SkRecorder::onDrawSprite(const SkBitmap& bitmap, int left, int top, const S
     APPEND(DrawSprite, this->copy(paint), delay_copy(bitmap), left, top);
 }
 
+void SkRecorder::onDrawSpriteBatch(const SkBitmap& bitmap, const SkIRect src[],
+                                   const SkIPoint dst[], int count, const SkPaint* paint) {
+    APPEND(DrawSpriteBatch,
+           this->copy(paint),
+           delay_copy(bitmap),
+           this->copy(src, count),
+           this->copy(dst, count),
+           count);
+}
+
 void SkRecorder::onDrawText(const void* text, size_t byteLength,
                             SkScalar x, SkScalar y, const SkPaint& paint) {
     APPEND(DrawText,
@@ -251,7 +279,24 @@ void SkRecorder::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
     APPEND(DrawTextBlob, delay_copy(paint), blob, x, y);
 }
 
+// Nested pictures at or below this op count are spliced into the parent record instead of
+// being referenced, so playback is one flat op walk rather than a recursive
+// SkPicture::playback with its own culling and save/restore per level.
+static const int kMaxPictureOpsToInline = 32;
+
 void SkRecorder::onDrawPicture(const SkPicture* pic, const SkMatrix* matrix, const SkPaint* paint) {
+    if (NULL == paint && pic->approximateOpCount() <= kMaxPictureOpsToInline) {
+        // Replay the picture into this recorder, with the matrix pre-concatenated.
+        // A paint would require saveLayer semantics, so those pictures are still
+        // recorded by reference.  Deeper nestings inline recursively as their
+        // DrawPicture ops come back through here.
+        SkAutoCanvasRestore acr(this, true);
+        if (matrix) {
+            this->concat(*matrix);
+        }
+        pic->playback(this);
+        return;
+    }
     fApproxBytesUsedBySubPictures += SkPictureUtils::ApproximateBytesUsed(pic);
     APPEND(DrawPicture, this->copy(paint), pic, matrix ? *matrix : SkMatrix::I());
 }
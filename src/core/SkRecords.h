@@ -39,6 +39,7 @@ namespace SkRecords {
     M(AddComment)                                                   \
     M(EndCommentGroup)                                              \
     M(DrawBitmap)                                                   \
+    M(DrawBitmapBatch)                                              \
     M(DrawBitmapNine)                                               \
     M(DrawBitmapRectToRect)                                         \
     M(DrawBitmapRectToRectBleed)                                    \
@@ -58,7 +59,9 @@ namespace SkRecords {
     M(DrawTextOnPath)                                               \
     M(DrawRRect)                                                    \
     M(DrawRect)                                                     \
+    M(DrawRectBatch)                                                \
     M(DrawSprite)                                                   \
+    M(DrawSpriteBatch)                                              \
     M(DrawTextBlob)                                                 \
     M(DrawVertices)
 
@@ -67,6 +70,11 @@ namespace SkRecords {
 enum Type { SK_RECORD_TYPES(ENUM) };
 #undef ENUM
 
+// The number of distinct record types, for code that keeps per-type tables.
+#define COUNT(T) +1
+static const int kTypeCount = SK_RECORD_TYPES(COUNT);
+#undef COUNT
+
 // Macros to make it easier to define a record for a draw call with 0 args, 1 args, 2 args, etc.
 // These should be clearer when you look at their use below.
 #define RECORD0(T)                      \
@@ -163,6 +171,19 @@ private:
     T* fPtr;
 };
 
+// Points at a paint owned by the SkRecord's intern table (see SkRecord::internPaint()).
+// Several records may share one paint, so unlike Optional we never destroy it here.
+template <typename T>
+class Interned {
+public:
+    Interned(T* ptr) : fPtr(ptr) {}
+    // Default copy and assign.
+
+    ACT_AS_PTR(fPtr);
+private:
+    T* fPtr;
+};
+
 // PODArray doesn't own the pointer's memory, and we assume the data is POD.
 template <typename T>
 class PODArray {
@@ -222,7 +243,7 @@ RECORD0(NoOp);
 
 RECORD2(Restore, SkIRect, devBounds, TypedMatrix, matrix);
 RECORD0(Save);
-RECORD3(SaveLayer, Optional<SkRect>, bounds, Optional<SkPaint>, paint, SkCanvas::SaveFlags, flags);
+RECORD3(SaveLayer, Optional<SkRect>, bounds, Interned<SkPaint>, paint, SkCanvas::SaveFlags, flags);
 
 RECORD1(SetMatrix, TypedMatrix, matrix);
 
@@ -243,36 +264,42 @@ RECORD2(AddComment, PODArray<char>, key, PODArray<char>, value);
 RECORD0(EndCommentGroup);
 
 // While not strictly required, if you have an SkPaint, it's fastest to put it first.
-RECORD4(DrawBitmap, Optional<SkPaint>, paint,
+RECORD4(DrawBitmap, Interned<SkPaint>, paint,
                     ImmutableBitmap, bitmap,
                     SkScalar, left,
                     SkScalar, top);
-RECORD4(DrawBitmapNine, Optional<SkPaint>, paint,
+// Built by SkRecordBatchDraws() from runs of DrawBitmap sharing one bitmap and paint;
+// never recorded directly.  positions holds count (left,top) pairs, drawn in order.
+RECORD4(DrawBitmapBatch, Interned<SkPaint>, paint,
+                         ImmutableBitmap, bitmap,
+                         PODArray<SkPoint>, positions,
+                         unsigned, count);
+RECORD4(DrawBitmapNine, Interned<SkPaint>, paint,
                         ImmutableBitmap, bitmap,
                         SkIRect, center,
                         SkRect, dst);
-RECORD4(DrawBitmapRectToRect, Optional<SkPaint>, paint,
+RECORD4(DrawBitmapRectToRect, Interned<SkPaint>, paint,
                               ImmutableBitmap, bitmap,
                               Optional<SkRect>, src,
                               SkRect, dst);
-RECORD4(DrawBitmapRectToRectBleed, Optional<SkPaint>, paint,
+RECORD4(DrawBitmapRectToRectBleed, Interned<SkPaint>, paint,
                                    ImmutableBitmap, bitmap,
                                    Optional<SkRect>, src,
                                    SkRect, dst);
 RECORD3(DrawDRRect, SkPaint, paint, SkRRect, outer, SkRRect, inner);
 RECORD2(DrawDrawable, SkRect, worstCaseBounds, int32_t, index);
-RECORD4(DrawImage, Optional<SkPaint>, paint,
+RECORD4(DrawImage, Interned<SkPaint>, paint,
                    RefBox<const SkImage>, image,
                    SkScalar, left,
                    SkScalar, top);
-RECORD4(DrawImageRect, Optional<SkPaint>, paint,
+RECORD4(DrawImageRect, Interned<SkPaint>, paint,
                        RefBox<const SkImage>, image,
                        Optional<SkRect>, src,
                        SkRect, dst);
 RECORD2(DrawOval, SkPaint, paint, SkRect, oval);
 RECORD1(DrawPaint, SkPaint, paint);
 RECORD2(DrawPath, SkPaint, paint, PreCachedPath, path);
-RECORD3(DrawPicture, Optional<SkPaint>, paint,
+RECORD3(DrawPicture, Interned<SkPaint>, paint,
                      RefBox<const SkPicture>, picture,
                      TypedMatrix, matrix);
 RECORD4(DrawPoints, SkPaint, paint, SkCanvas::PointMode, mode, unsigned, count, SkPoint*, pts);
@@ -287,7 +314,18 @@ RECORD5(DrawPosTextH, SkPaint, paint,
                       PODArray<SkScalar>, xpos);
 RECORD2(DrawRRect, SkPaint, paint, SkRRect, rrect);
 RECORD2(DrawRect, SkPaint, paint, SkRect, rect);
-RECORD4(DrawSprite, Optional<SkPaint>, paint, ImmutableBitmap, bitmap, int, left, int, top);
+// Built by SkRecordBatchDraws() from runs of DrawRect sharing one paint; never recorded
+// directly.  rects holds count rectangles, drawn in order.
+RECORD3(DrawRectBatch, SkPaint, paint,
+                       PODArray<SkRect>, rects,
+                       unsigned, count);
+RECORD4(DrawSprite, Interned<SkPaint>, paint, ImmutableBitmap, bitmap, int, left, int, top);
+// src and dst each hold count entries, one per sprite.
+RECORD5(DrawSpriteBatch, Interned<SkPaint>, paint,
+                         ImmutableBitmap, bitmap,
+                         PODArray<SkIRect>, src,
+                         PODArray<SkIPoint>, dst,
+                         int, count);
 RECORD5(DrawText, SkPaint, paint,
                   PODArray<char>, text,
                   size_t, byteLength,
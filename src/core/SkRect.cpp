@@ -74,13 +74,31 @@ bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
         accum = max = min;
         accum = accum * Sk4s(0);
 
-        count >>= 1;
-        for (int i = 0; i < count; ++i) {
+        count >>= 1;    // now measured in point-pairs
+        // Two accumulators per side keep the Min/Max dependency chains short
+        // enough that long point arrays (big freshly-built paths) run at load
+        // bandwidth rather than min-latency.
+        if (count >= 2) {
+            Sk4s min1 = min, max1 = max;
+            do {
+                Sk4s xy0 = Sk4s::Load(&pts[0].fX);
+                Sk4s xy1 = Sk4s::Load(&pts[2].fX);
+                accum = accum * xy0 * xy1;
+                min  = Sk4s::Min(min,  xy0);
+                max  = Sk4s::Max(max,  xy0);
+                min1 = Sk4s::Min(min1, xy1);
+                max1 = Sk4s::Max(max1, xy1);
+                pts += 4;
+                count -= 2;
+            } while (count >= 2);
+            min = Sk4s::Min(min, min1);
+            max = Sk4s::Max(max, max1);
+        }
+        if (count) {
             Sk4s xy = Sk4s::Load(&pts->fX);
             accum = accum * xy;
             min = Sk4s::Min(min, xy);
             max = Sk4s::Max(max, xy);
-            pts += 2;
         }
 
         /**
@@ -586,15 +586,8 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 ///////////////////////////////////////////////////////////////////////////////
 
 bool SkRegion::setRects(const SkIRect rects[], int count) {
-    if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
-        }
-    }
-    return !this->isEmpty();
+    // the bulk op builds union(rects) in a single sweep
+    return this->op(rects, count, kReplace_Op);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1092,6 +1085,153 @@ bool SkRegion::op(const SkRegion& rgna, const SkRegion& rgnb, Op op) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "SkTDArray.h"
+#include "SkTSort.h"
+
+namespace {
+
+struct IRectTopLess {
+    bool operator()(const SkIRect& a, const SkIRect& b) const {
+        return a.fTop < b.fTop;
+    }
+};
+
+struct RunTypeLess {
+    bool operator()(SkRegion::RunType a, SkRegion::RunType b) const {
+        return a < b;
+    }
+};
+
+// An interval within one y-band; layout matches the L,R pairs in a run array.
+struct Span {
+    SkRegion::RunType fLeft;
+    SkRegion::RunType fRight;
+};
+
+struct SpanLeftLess {
+    bool operator()(const Span& a, const Span& b) const {
+        return a.fLeft < b.fLeft;
+    }
+};
+
+}  // namespace
+
+bool SkRegion::op(const SkIRect rects[], int count, Op op) {
+    SkDEBUGCODE(this->validate();)
+
+    // Weed out empties; an empty array degenerates to an op with empty.
+    SkTDArray<SkIRect> sorted;
+    sorted.setReserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (!rects[i].isEmpty()) {
+            *sorted.append() = rects[i];
+        }
+    }
+    if (sorted.count() <= 1) {
+        const SkIRect& r = sorted.count() > 0 ? sorted[0] : SkIRect::EmptyIRect();
+        return this->op(r, op);
+    }
+
+    // Build union(rects) in one sweep instead of count successive region ops.
+    SkTQSort(sorted.begin(), sorted.end() - 1, IRectTopLess());
+
+    // Every distinct top/bottom is a y where the interval list can change.
+    SkTDArray<RunType> ys;
+    ys.setReserve(2 * sorted.count());
+    for (int i = 0; i < sorted.count(); ++i) {
+        *ys.append() = sorted[i].fTop;
+        *ys.append() = sorted[i].fBottom;
+    }
+    SkTQSort(ys.begin(), ys.end() - 1, RunTypeLess());
+    int uniqueYs = 1;
+    for (int i = 1; i < ys.count(); ++i) {
+        if (ys[i] != ys[uniqueYs - 1]) {
+            ys[uniqueYs++] = ys[i];
+        }
+    }
+    ys.setCount(uniqueYs);
+
+    SkTDArray<RunType> runs;
+    *runs.append() = ys[0];     // top
+
+    SkTDArray<int>  active;     // indices into sorted[]
+    SkTDArray<Span> spans;      // scratch interval list for the current band
+    int next = 0;
+    int prevBottomIndex = -1;   // offsets into runs[], for band coalescing
+    int prevSpansIndex = -1;
+    int prevSpanCount = -1;
+
+    for (int e = 0; e < ys.count() - 1; ++e) {
+        const RunType y0 = ys[e];
+        const RunType y1 = ys[e + 1];
+
+        // admit rects starting at (or above) this band, retire finished ones
+        while (next < sorted.count() && sorted[next].fTop <= y0) {
+            if (sorted[next].fBottom > y0) {
+                *active.append() = next;
+            }
+            next += 1;
+        }
+        for (int i = active.count() - 1; i >= 0; --i) {
+            if (sorted[active[i]].fBottom <= y0) {
+                active.removeShuffle(i);
+            }
+        }
+
+        spans.setCount(active.count());
+        for (int i = 0; i < active.count(); ++i) {
+            spans[i].fLeft = sorted[active[i]].fLeft;
+            spans[i].fRight = sorted[active[i]].fRight;
+        }
+        if (spans.count() > 1) {
+            SkTQSort(spans.begin(), spans.end() - 1, SpanLeftLess());
+        }
+
+        // merge overlapping/abutting intervals in place
+        int merged = 0;
+        for (int i = 1; i < spans.count(); ++i) {
+            if (spans[i].fLeft <= spans[merged].fRight) {
+                spans[merged].fRight = SkMax32(spans[merged].fRight, spans[i].fRight);
+            } else {
+                spans[++merged] = spans[i];
+            }
+        }
+        const int spanCount = spans.count() > 0 ? merged + 1 : 0;
+
+        // identical neighboring bands coalesce into one taller band
+        if (spanCount == prevSpanCount &&
+            (0 == spanCount ||
+             0 == memcmp(&runs[prevSpansIndex], spans.begin(),
+                         spanCount * sizeof(Span)))) {
+            runs[prevBottomIndex] = y1;
+            continue;
+        }
+
+        prevBottomIndex = runs.count();
+        *runs.append() = y1;
+        *runs.append() = spanCount;
+        prevSpansIndex = runs.count();
+        for (int i = 0; i < spanCount; ++i) {
+            *runs.append() = spans[i].fLeft;
+            *runs.append() = spans[i].fRight;
+        }
+        *runs.append() = kRunTypeSentinel;
+        prevSpanCount = spanCount;
+    }
+    *runs.append() = kRunTypeSentinel;
+
+    SkRegion unioned;
+    unioned.setRuns(runs.begin(), runs.count());
+
+    if (kReplace_Op == op) {
+        this->swap(unioned);
+        return !this->isEmpty();
+    }
+    return this->op(unioned, op);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 #include "SkBuffer.h"
 
 size_t SkRegion::writeToMemory(void* storage) const {
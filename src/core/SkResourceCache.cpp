@@ -9,7 +9,9 @@
 #include "SkMessageBus.h"
 #include "SkMipMap.h"
 #include "SkPixelRef.h"
+#include "SkRTConf.h"
 #include "SkResourceCache.h"
+#include "SkTime.h"
 
 #include <stddef.h>
 
@@ -26,6 +28,24 @@ DECLARE_SKMESSAGEBUS_MESSAGE(SkResourceCache::PurgeSharedIDMessage)
     #define SK_DEFAULT_IMAGE_CACHE_LIMIT     (2 * 1024 * 1024)
 #endif
 
+SK_CONF_DECLARE(int, c_resourceCacheMB, "cache.resourceCacheTotalMB", 0,
+                "Total SkResourceCache byte budget in megabytes; 0 keeps the compiled-in default");
+
+static void apply_resource_cache_mb(const int& mb, void*) {
+    if (mb > 0) {
+        SkResourceCache::SetTotalByteLimit((size_t)mb << 20);
+    }
+}
+
+namespace {
+// Wires the knob up at static-init time so SK_CONF_SET() takes effect immediately.
+struct ResourceCacheKnob {
+    ResourceCacheKnob() {
+        SK_CONF_SET_CHANGE_PROC(c_resourceCacheMB, apply_resource_cache_mb, NULL);
+    }
+} gResourceCacheKnob;
+}  // namespace
+
 void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t length) {
     SkASSERT(SkAlign4(length) == length);
 
@@ -43,9 +63,9 @@ void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t lengt
     fSharedID_lo = (uint32_t)sharedID;
     fSharedID_hi = (uint32_t)(sharedID >> 32);
     fNamespace = nameSpace;
-    // skip unhashed fields when computing the murmur
-    fHash = SkChecksum::Murmur3(this->as32() + kUnhashedLocal32s,
-                                (fCount32 - kUnhashedLocal32s) << 2);
+    // skip unhashed fields when computing the hash
+    fHash = SkChecksum::Hash32(this->as32() + kUnhashedLocal32s,
+                               (fCount32 - kUnhashedLocal32s) << 2);
 }
 
 #include "SkTDynamicHash.h"
@@ -62,6 +82,8 @@ void SkResourceCache::init() {
     fHash = new Hash;
     fTotalBytesUsed = 0;
     fCount = 0;
+    fHitCount = 0;
+    fMissCount = 0;
     fSingleAllocationByteLimit = 0;
     fAllocator = NULL;
 
@@ -213,12 +235,13 @@ bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
     if (rec) {
         if (visitor(*rec, context)) {
             this->moveToHead(rec);  // for our LRU
+            fHitCount += 1;
             return true;
         } else {
             this->remove(rec);  // stale
-            return false;
         }
     }
+    fMissCount += 1;
     return false;
 }
 
@@ -517,96 +540,213 @@ void SkResourceCache::checkMessages() {
 
 #include "SkThread.h"
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = NULL;
-static void cleanup_gResourceCache() {
+// The global cache is sharded by key hash into independent SkResourceCache
+// instances, each guarded by its own mutex and given an equal slice of the byte
+// budget.  Threads working with different keys mostly land on different shards,
+// so they don't serialize on one global lock.  Keyless operations (limits,
+// purge-all, dump) visit every shard.
+static const int kShardCount = 8;
+
+SK_DECLARE_STATIC_MUTEX(gShardMutex0);
+SK_DECLARE_STATIC_MUTEX(gShardMutex1);
+SK_DECLARE_STATIC_MUTEX(gShardMutex2);
+SK_DECLARE_STATIC_MUTEX(gShardMutex3);
+SK_DECLARE_STATIC_MUTEX(gShardMutex4);
+SK_DECLARE_STATIC_MUTEX(gShardMutex5);
+SK_DECLARE_STATIC_MUTEX(gShardMutex6);
+SK_DECLARE_STATIC_MUTEX(gShardMutex7);
+static SkBaseMutex* const gShardMutex[kShardCount] = {
+    &gShardMutex0, &gShardMutex1, &gShardMutex2, &gShardMutex3,
+    &gShardMutex4, &gShardMutex5, &gShardMutex6, &gShardMutex7,
+};
+SK_COMPILE_ASSERT(8 == kShardCount, shard_mutex_list_out_of_sync);
+
+static SkResourceCache* gShards[kShardCount];
+
+// How the shards allocate their contents: through this factory when set (by the compile-time
+// default or SetDiscardableFactory()), with malloc when NULL.
+static SkResourceCache::DiscardableFactory gShardDiscardableFactory =
+#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
+    SkDiscardableMemory::Create;
+#else
+    NULL;
+#endif
+
+static void cleanup_gShards() {
     // We'll clean this up in our own tests, but disable for clients.
     // Chrome seems to have funky multi-process things going on in unit tests that
     // makes this unsafe to delete when the main process atexit()s.
     // SkLazyPtr does the same sort of thing.
 #if SK_DEVELOPER
-    SkDELETE(gResourceCache);
+    for (int i = 0; i < kShardCount; ++i) {
+        SkDELETE(gShards[i]);
+        gShards[i] = NULL;
+    }
 #endif
 }
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (NULL == gResourceCache) {
-#ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = SkNEW_ARGS(SkResourceCache, (SkDiscardableMemory::Create));
-#else
-        gResourceCache = SkNEW_ARGS(SkResourceCache, (SK_DEFAULT_IMAGE_CACHE_LIMIT));
-#endif
-        atexit(cleanup_gResourceCache);
+/** Must hold gShardMutex[i] when calling. */
+static SkResourceCache* get_shard(int i) {
+    // gShardMutex[i] is always held when this is called, so we don't need to be fancy in here.
+    gShardMutex[i]->assertHeld();
+    if (NULL == gShards[i]) {
+        if (gShardDiscardableFactory) {
+            gShards[i] = SkNEW_ARGS(SkResourceCache, (gShardDiscardableFactory));
+        } else {
+            size_t limit = SK_DEFAULT_IMAGE_CACHE_LIMIT;
+            if (c_resourceCacheMB > 0) {
+                limit = (size_t)c_resourceCacheMB << 20;
+            }
+            gShards[i] = SkNEW_ARGS(SkResourceCache, (limit / kShardCount));
+        }
+        // This may register more than once if several shards spin up, but
+        // extra runs of the cleanup only find NULLs.
+        atexit(cleanup_gShards);
     }
-    return gResourceCache;
+    return gShards[i];
+}
+
+// The low bits of the hash index the buckets of the shard's internal hash
+// table, so pick the shard with high bits to keep the two independent.
+static int shard_for_key(const SkResourceCache::Key& key) {
+    return (key.hash() >> 29) & (kShardCount - 1);
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalBytesUsed();
+    size_t total = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        total += get_shard(i)->getTotalBytesUsed();
+    }
+    return total;
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalByteLimit();
+    size_t total = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        total += get_shard(i)->getTotalByteLimit();
+    }
+    return total;
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setTotalByteLimit(newLimit);
+    size_t prevTotal = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        prevTotal += get_shard(i)->setTotalByteLimit(newLimit / kShardCount);
+    }
+    return prevTotal;
+}
+
+uint32_t SkResourceCache::GetHitCount() {
+    uint32_t total = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        total += get_shard(i)->getHitCount();
+    }
+    return total;
+}
+
+uint32_t SkResourceCache::GetMissCount() {
+    uint32_t total = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        total += get_shard(i)->getMissCount();
+    }
+    return total;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->discardableFactory();
+    SkAutoMutexAcquire am(gShardMutex[0]);
+    return get_shard(0)->discardableFactory();
+}
+
+void SkResourceCache::SetDiscardableFactory(DiscardableFactory factory) {
+    // Tear down any shards built with the old factory; they'll be rebuilt
+    // lazily with the new one.  The caller promises no other thread is using
+    // the global cache yet, but take the locks anyway -- they're cheap here.
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        SkDELETE(gShards[i]);
+        gShards[i] = NULL;
+    }
+    gShardDiscardableFactory = factory;
 }
 
 SkBitmap::Allocator* SkResourceCache::GetAllocator() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->allocator();
+    SkAutoMutexAcquire am(gShardMutex[0]);
+    return get_shard(0)->allocator();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->newCachedData(bytes);
+    SkAutoMutexAcquire am(gShardMutex[0]);
+    return get_shard(0)->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->dump();
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        get_shard(i)->dump();
+    }
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setSingleAllocationByteLimit(size);
+    size_t prev = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        const size_t prevForShard = get_shard(i)->setSingleAllocationByteLimit(size);
+        if (0 == i) {
+            prev = prevForShard;  // All shards carry the same value.
+        }
+    }
+    return prev;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getSingleAllocationByteLimit();
+    SkAutoMutexAcquire am(gShardMutex[0]);
+    return get_shard(0)->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    // Computed against the shard's slice of the budget, since that's what a
+    // single allocation has to fit within.  All shards agree on this.
+    SkAutoMutexAcquire am(gShardMutex[0]);
+    return get_shard(0)->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShardMutex[i]);
+        get_shard(i)->purgeAll();
+    }
+}
+
+bool SkResourceCache::PerformIdleWork(double deadlineNanos) {
+    for (int i = 0; i < kShardCount; ++i) {
+        {
+            SkAutoMutexAcquire am(gShardMutex[i]);
+            SkResourceCache* shard = get_shard(i);
+            shard->checkMessages();
+            shard->purgeAsNeeded();
+        }
+        if (SkTime::GetNSecs() >= deadlineNanos) {
+            return i + 1 < kShardCount;
+        }
+    }
+    return false;
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->find(key, visitor, context);
+    const int i = shard_for_key(key);
+    SkAutoMutexAcquire am(gShardMutex[i]);
+    return get_shard(i)->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->add(rec);
+    const int i = shard_for_key(rec->getKey());
+    SkAutoMutexAcquire am(gShardMutex[i]);
+    get_shard(i)->add(rec);
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
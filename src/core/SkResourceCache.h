@@ -23,8 +23,11 @@ class SkMipMap;
  *  thread-safe, so if a given instance is to be shared across threads, the
  *  caller must manage the access itself (e.g. via a mutex).
  *
- *  As a convenience, a global instance is also defined, which can be safely
- *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  As a convenience, a global cache is also defined, which can be safely
+ *  accessed across threads via the static methods (e.g. Find, Add, etc.).
+ *  It is sharded by key hash into several instances with independent locks
+ *  and equal slices of the byte budget, so concurrent lookups of different
+ *  keys rarely contend.
  */
 class SkResourceCache {
 public:
@@ -137,17 +140,38 @@ public:
     static size_t GetTotalByteLimit();
     static size_t SetTotalByteLimit(size_t newLimit);
 
+    static uint32_t GetHitCount();
+    static uint32_t GetMissCount();
+
     static size_t SetSingleAllocationByteLimit(size_t);
     static size_t GetSingleAllocationByteLimit();
     static size_t GetEffectiveSingleAllocationByteLimit();
 
     static void PurgeAll();
 
+    /**
+     *  Idle-time housekeeping: process pending invalidation messages and purge
+     *  over-budget entries, shard by shard, stopping once deadlineNanos
+     *  (SkTime::GetNSecs() timebase) passes.  Returns true if it ran out of
+     *  time with shards still unvisited.
+     */
+    static bool PerformIdleWork(double deadlineNanos);
+
     /**
      *  Returns the DiscardableFactory used by the global cache, or NULL.
      */
     static DiscardableFactory GetDiscardableFactory();
 
+    /**
+     *  Make the global cache allocate its contents through the specified factory. Any existing
+     *  contents are purged. Embedders can use this to back the cache with discardable memory
+     *  shared between processes (e.g. ashmem), so a bitmap decoded or scaled in one process can
+     *  be found by the others; pass NULL to return to process-local malloc'd memory.
+     *
+     *  This must be called before other threads start using the global cache.
+     */
+    static void SetDiscardableFactory(DiscardableFactory factory);
+
     /**
      * Use this allocator for bitmaps, so they can use ashmem when available.
      * Returns NULL if the ResourceCache has not been initialized with a DiscardableFactory.
@@ -198,6 +222,9 @@ public:
     size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
     size_t getTotalByteLimit() const { return fTotalByteLimit; }
 
+    uint32_t getHitCount() const { return fHitCount; }
+    uint32_t getMissCount() const { return fMissCount; }
+
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
      *  0 is no maximum at all; this is the default.
@@ -248,6 +275,9 @@ private:
     size_t  fSingleAllocationByteLimit;
     int     fCount;
 
+    uint32_t fHitCount;
+    uint32_t fMissCount;
+
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
     void checkMessages();
@@ -126,7 +126,23 @@ void SkScalerContext::getAdvance(SkGlyph* glyph) {
 
 void SkScalerContext::getMetrics(SkGlyph* glyph) {
     generateMetrics(glyph);
+    this->fixupMetrics(glyph);
+}
+
+void SkScalerContext::getMetricsBatch(SkGlyph* glyphs[], int count) {
+    this->generateMetricsBatch(glyphs, count);
+    for (int i = 0; i < count; ++i) {
+        this->fixupMetrics(glyphs[i]);
+    }
+}
+
+void SkScalerContext::generateMetricsBatch(SkGlyph* glyphs[], int count) {
+    for (int i = 0; i < count; ++i) {
+        this->generateMetrics(glyphs[i]);
+    }
+}
 
+void SkScalerContext::fixupMetrics(SkGlyph* glyph) {
     // for now we have separate cache entries for devkerning on and off
     // in the future we might share caches, but make our measure/draw
     // code make the distinction. Thus we zap the values if the caller
@@ -585,6 +601,40 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     }
 }
 
+void SkScalerContext::getImageBatch(const SkGlyph* glyphs[], int count) {
+    if (fGenerateImageFromPath || fMaskFilter) {
+        // These paths rework the mask per glyph, so batch generation in the
+        // port cannot help. Fall back to the one-at-a-time path.
+        for (int i = 0; i < count; ++i) {
+            this->getImage(*glyphs[i]);
+        }
+        return;
+    }
+    this->generateImageBatch(glyphs, count);
+}
+
+void SkScalerContext::generateImageBatch(const SkGlyph* glyphs[], int count) {
+    for (int i = 0; i < count; ++i) {
+        this->generateImage(*glyphs[i]);
+    }
+}
+
+void SkScalerContext::getAdvanceBatch(uint16_t firstGlyphID, int count,
+                                      SkFixed advancesX[], SkFixed advancesY[]) {
+    this->generateAdvanceBatch(firstGlyphID, count, advancesX, advancesY);
+}
+
+void SkScalerContext::generateAdvanceBatch(uint16_t firstGlyphID, int count,
+                                           SkFixed advancesX[], SkFixed advancesY[]) {
+    for (int i = 0; i < count; ++i) {
+        SkGlyph glyph;
+        glyph.initWithGlyphID(firstGlyphID + i);
+        this->getAdvance(&glyph);
+        advancesX[i] = glyph.fAdvanceX;
+        advancesY[i] = glyph.fAdvanceY;
+    }
+}
+
 void SkScalerContext::getPath(const SkGlyph& glyph, SkPath* path) {
     this->internalGetPath(glyph, NULL, path, NULL);
 }
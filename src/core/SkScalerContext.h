@@ -178,6 +178,11 @@ public:
         // Generate A8 from LCD source (for GDI and CoreGraphics).
         // only meaningful if fMaskFormat is kA8
         kGenA8FromLCD_Flag        = 0x0800, // could be 0x200 (bit meaning dependent on fMaskFormat)
+
+        // The strike is only used to measure text (e.g. by a layout engine),
+        // so SkGlyphCache serves advance queries from a compact per-strike
+        // table filled with getAdvanceBatch instead of full SkGlyph records.
+        kAdvancesOnlyMetrics_Flag = 0x1000,
     };
 
     // computed values
@@ -223,6 +228,24 @@ public:
     void        getAdvance(SkGlyph*);
     void        getMetrics(SkGlyph*);
     void        getImage(const SkGlyph&);
+
+    /** Batch variants of getMetrics/getImage for a run of glyphs. These let
+        ports amortize per-call overhead (e.g. a global library mutex, or
+        re-activating the face size) over the whole run instead of paying it
+        once per glyph. getImageBatch requires that metrics have already been
+        generated and each glyph's fImage points to pre-allocated storage, as
+        with generateImage.
+    */
+    void        getMetricsBatch(SkGlyph* glyphs[], int count);
+    void        getImageBatch(const SkGlyph* glyphs[], int count);
+
+    /** Fill advancesX/Y[] for the consecutive glyph ID range starting at
+        firstGlyphID. Only advances are computed -- no bounds, so ports can
+        skip outline processing entirely (e.g. FT_Get_Advances).
+    */
+    void        getAdvanceBatch(uint16_t firstGlyphID, int count,
+                                SkFixed advancesX[], SkFixed advancesY[]);
+
     void        getPath(const SkGlyph&, SkPath*);
     void        getFontMetrics(SkPaint::FontMetrics*);
 
@@ -271,6 +294,24 @@ protected:
      */
     virtual void generateImage(const SkGlyph& glyph) = 0;
 
+    /** As generateMetrics, for a run of glyphs in one call. The default
+     *  implementation loops over generateMetrics; ports with expensive
+     *  per-call setup should override.
+     */
+    virtual void generateMetricsBatch(SkGlyph* glyphs[], int count);
+
+    /** As generateImage, for a run of glyphs whose metrics have already been
+     *  generated and whose fImage buffers are allocated.
+     */
+    virtual void generateImageBatch(const SkGlyph* glyphs[], int count);
+
+    /** As generateAdvance, for a consecutive glyph ID range in one call. The
+     *  default implementation loops over generateAdvance; ports with a bulk
+     *  advance API should override.
+     */
+    virtual void generateAdvanceBatch(uint16_t firstGlyphID, int count,
+                                      SkFixed advancesX[], SkFixed advancesY[]);
+
     /** Sets the passed path to the glyph outline.
      *  If this cannot be done the path is set to empty;
      *  this is indistinguishable from a glyph with an empty path.
@@ -315,6 +356,10 @@ private:
     void internalGetPath(const SkGlyph& glyph, SkPath* fillPath,
                          SkPath* devPath, SkMatrix* fillToDevMatrix);
 
+    // applies the path/rasterizer/mask-filter adjustments to bounds produced
+    // by generateMetrics. Shared by getMetrics and getMetricsBatch.
+    void fixupMetrics(SkGlyph* glyph);
+
     // returns the right context from our link-list for this char. If no match
     // is found it returns NULL. If a match is found then the glyphID param is
     // set to the glyphID that maps to the provided char.
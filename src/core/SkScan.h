@@ -22,6 +22,13 @@ class SkPath;
 */
 typedef SkIRect SkXRect;
 
+/**
+ *  When true, SkScan::AntiFillPath routes eligible (non-inverse, winding)
+ *  paths through the analytic scan converter in SkScan_AnalyticAA.cpp
+ *  instead of the 4x supersampled one in SkScan_AntiPath.cpp.
+ */
+extern bool gSkUseAnalyticAA;
+
 class SkScan {
 public:
     /*
@@ -45,6 +52,7 @@ public:
     static void AntiFillXRect(const SkXRect&, const SkRasterClip&, SkBlitter*);
     static void FillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
+    static void AnalyticFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
                           const SkRasterClip&, SkBlitter*);
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -69,6 +77,7 @@ private:
     static void FillPath(const SkPath&, const SkRegion& clip, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRegion& clip, SkBlitter*,
                              bool forceRLE = false);
+    static void AnalyticFillPath(const SkPath&, const SkRegion& clip, SkBlitter*);
     static void FillTriangle(const SkPoint pts[], const SkRegion*, SkBlitter*);
 
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -0,0 +1,318 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkScan.h"
+#include "SkScanPriv.h"
+#include "SkBlitter.h"
+#include "SkGeometry.h"
+#include "SkPath.h"
+#include "SkRasterClip.h"
+#include "SkRegion.h"
+#include "SkTemplates.h"
+#include "SkTSort.h"
+
+bool gSkUseAnalyticAA = false;
+
+/*
+ *  An exact-coverage scan converter: instead of supersampling 4 vertical
+ *  subsamples per pixel row (SkScan_AntiPath.cpp), each edge's trapezoidal
+ *  area inside every pixel it crosses is accumulated directly, one device
+ *  row at a time. Curves are flattened to line segments up front; within a
+ *  single pixel row the segment's coverage is exact.
+ *
+ *  Coverage is tracked with two per-row float buffers:
+ *    - fArea[x]:  the partial area contributed inside pixel x by edge
+ *                 pieces that cross that pixel, relative to full cover.
+ *    - fCover[x]: signed vertical extent that "spills" to every pixel at
+ *                 or right of x; integrated with a running sum at blit time.
+ *
+ *  Only non-inverse, winding-fill paths take this route; everything else
+ *  falls back to SkScan::AntiFillPath.
+ */
+
+namespace {
+
+struct AnalyticEdge {
+    float   fX0, fY0;   // top point (fY0 <= fY1)
+    float   fX1, fY1;
+    float   fDxDy;
+    int8_t  fWinding;   // +1 if the original segment pointed down
+
+    bool setLine(SkPoint p0, SkPoint p1) {
+        int winding = 1;
+        if (p0.fY > p1.fY) {
+            SkTSwap(p0, p1);
+            winding = -1;
+        }
+        if (p0.fY == p1.fY) {   // horizontal segments contribute no coverage
+            return false;
+        }
+        fX0 = p0.fX; fY0 = p0.fY;
+        fX1 = p1.fX; fY1 = p1.fY;
+        fDxDy = (fX1 - fX0) / (fY1 - fY0);
+        fWinding = SkToS8(winding);
+        return true;
+    }
+
+    float xAtY(float y) const { return fX0 + (y - fY0) * fDxDy; }
+
+    bool operator<(const AnalyticEdge& other) const { return fY0 < other.fY0; }
+};
+
+class EdgeList {
+public:
+    EdgeList() {}
+
+    void addLine(const SkPoint& p0, const SkPoint& p1) {
+        AnalyticEdge edge;
+        if (edge.setLine(p0, p1)) {
+            *fEdges.append() = edge;
+        }
+    }
+
+    // Flatten the path into line segments. The segment count per curve is
+    // chosen from the curve's device-space extent, so error stays well under
+    // the quarter-pixel the supersampler already tolerated.
+    void build(const SkPath& path) {
+        SkPath::Iter iter(path, true);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
+            switch (verb) {
+                case SkPath::kLine_Verb:
+                    this->addLine(pts[0], pts[1]);
+                    break;
+                case SkPath::kQuad_Verb:
+                    this->addCurve(pts, 2);
+                    break;
+                case SkPath::kConic_Verb: {
+                    SkAutoConicToQuads quadder;
+                    const SkPoint* quads = quadder.computeQuads(pts, iter.conicWeight(),
+                                                                SK_Scalar1 / 4);
+                    for (int i = 0; i < quadder.countQuads(); ++i) {
+                        this->addCurve(&quads[i * 2], 2);
+                    }
+                } break;
+                case SkPath::kCubic_Verb:
+                    this->addCurve(pts, 3);
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (fEdges.count() > 1) {
+            SkTQSort<AnalyticEdge>(fEdges.begin(), fEdges.end() - 1);
+        }
+    }
+
+    int count() const { return fEdges.count(); }
+    const AnalyticEdge& operator[](int i) const { return fEdges[i]; }
+
+private:
+    void addCurve(const SkPoint pts[], int order) {
+        SkRect bounds;
+        bounds.set(pts, order + 1);
+        const float dim = SkMaxScalar(bounds.width(), bounds.height());
+        int segs = SkScalarCeilToInt(SkScalarSqrt(dim));
+        segs = SkTPin(segs, 1, 64);
+        SkScalar ts[64];
+        SkPoint flat[64];
+        for (int i = 1; i <= segs; ++i) {
+            ts[i - 1] = (float)i / segs;
+        }
+        if (2 == order) {
+            SkEvalQuadAts(pts, ts, segs, flat);
+        } else {
+            SkEvalCubicAts(pts, ts, segs, flat);
+        }
+        SkPoint prev = pts[0];
+        for (int i = 0; i < segs; ++i) {
+            this->addLine(prev, flat[i]);
+            prev = flat[i];
+        }
+    }
+
+    SkTDArray<AnalyticEdge> fEdges;
+};
+
+class CoverageAccumulator {
+public:
+    CoverageAccumulator(const SkIRect& bounds)
+        : fBounds(bounds)
+        , fArea(bounds.width() + 2)
+        , fCover(bounds.width() + 2)
+        , fAlpha(bounds.width())
+        , fRuns(bounds.width() + 1) {
+        this->resetRow();
+    }
+
+    void resetRow() {
+        sk_bzero(fArea.get(), (fBounds.width() + 2) * sizeof(float));
+        sk_bzero(fCover.get(), (fBounds.width() + 2) * sizeof(float));
+    }
+
+    // Accumulate one edge, clipped to the pixel row [rowTop, rowTop+1).
+    void accumulate(const AnalyticEdge& edge, float rowTop) {
+        const float rowBot = rowTop + 1;
+        const float yTop = SkTMax(edge.fY0, rowTop);
+        const float yBot = SkTMin(edge.fY1, rowBot);
+        if (yBot <= yTop) {
+            return;
+        }
+        float x0 = edge.xAtY(yTop);
+        float x1 = edge.xAtY(yBot);
+        float h0 = yTop, h1 = yBot;
+        if (x0 > x1) {  // walk left-to-right; the winding sign is unchanged
+            SkTSwap(x0, x1);
+            SkTSwap(h0, h1);
+        }
+        const float sign = (float)edge.fWinding;
+        const float L = (float)fBounds.left();
+        const float R = (float)fBounds.right();
+        x0 = SkTPin(x0, L, R);
+        x1 = SkTPin(x1, L, R);
+
+        int ix = (int)sk_float_floor(x0);
+        const int ixLast = (int)sk_float_floor(x1 == R ? x1 - 1 : x1);
+        if (ix >= ixLast) {
+            // Entire piece lives in one pixel column: exact trapezoid.
+            const float dy = yBot - yTop;
+            const float xmid = 0.5f * (x0 + x1);
+            this->addPartial(ix, sign * dy * ((ix + 1) - xmid));
+            this->addSpill(ix + 1, sign * dy);
+            return;
+        }
+        // Crosses column boundaries: split at each integer x. The vertical
+        // extent covered in each column is proportional to the x-extent
+        // because the piece is a straight segment.
+        const float dyTotal = yBot - yTop;
+        const float invDx = 1.0f / (x1 - x0);
+        float prevX = x0;
+        for (; ix <= ixLast; ++ix) {
+            const float nextX = SkTMin((float)(ix + 1), x1);
+            const float dy = dyTotal * (nextX - prevX) * invDx;
+            const float xmid = 0.5f * (prevX + nextX);
+            this->addPartial(ix, sign * dy * ((ix + 1) - xmid));
+            this->addSpill(ix + 1, sign * dy);
+            prevX = nextX;
+        }
+    }
+
+    // Integrate the row and blit it. Nonzero winding: alpha = |sum| clamped.
+    void blitRow(int y, SkBlitter* blitter) {
+        const int width = fBounds.width();
+        float running = 0;
+        for (int i = 0; i < width; ++i) {
+            running += fCover[i];
+            float coverage = sk_float_abs(fArea[i] + running);
+            int alpha = (int)(coverage * 255 + 0.5f);
+            fAlpha[i] = SkToU8(SkMin32(alpha, 255));
+        }
+        // Coalesce equal alphas into runs for blitAntiH.
+        int i = 0;
+        while (i < width) {
+            int j = i + 1;
+            while (j < width && fAlpha[j] == fAlpha[i]) {
+                ++j;
+            }
+            fRuns[i] = SkToS16(j - i);
+            i = j;
+        }
+        fRuns[width] = 0;
+        blitter->blitAntiH(fBounds.left(), y, fAlpha.get(), fRuns.get());
+    }
+
+private:
+    void addPartial(int x, float v) { fArea[x - fBounds.left()] += v; }
+    void addSpill(int x, float v)   { fCover[x - fBounds.left()] += v; }
+
+    const SkIRect           fBounds;
+    SkAutoTMalloc<float>    fArea;
+    SkAutoTMalloc<float>    fCover;
+    SkAutoTMalloc<SkAlpha>  fAlpha;
+    SkAutoTMalloc<int16_t>  fRuns;
+};
+
+}  // namespace
+
+static bool analytic_can_handle(const SkPath& path) {
+    return !path.isInverseFillType() &&
+           SkPath::kWinding_FillType == path.getFillType();
+}
+
+void SkScan::AnalyticFillPath(const SkPath& path, const SkRegion& origClip,
+                              SkBlitter* blitter) {
+    if (origClip.isEmpty()) {
+        return;
+    }
+    if (!analytic_can_handle(path)) {
+        AntiFillPath(path, origClip, blitter);
+        return;
+    }
+
+    SkIRect ir;
+    path.getBounds().roundOut(&ir);
+    SkIRect bounds;
+    if (!bounds.intersect(ir, origClip.getBounds())) {
+        return;
+    }
+
+    SkScanClipper clipper(blitter, &origClip, ir);
+    if (NULL == clipper.getBlitter()) {
+        return;
+    }
+    blitter = clipper.getBlitter();
+    if (clipper.getClipRect() && !bounds.intersect(*clipper.getClipRect())) {
+        return;
+    }
+
+    EdgeList edges;
+    edges.build(path);
+    if (0 == edges.count()) {
+        return;
+    }
+
+    CoverageAccumulator acc(bounds);
+    int nextEdge = 0;
+    SkTDArray<int> active;
+
+    for (int y = bounds.top(); y < bounds.bottom(); ++y) {
+        const float rowTop = (float)y;
+        const float rowBot = rowTop + 1;
+        while (nextEdge < edges.count() && edges[nextEdge].fY0 < rowBot) {
+            *active.append() = nextEdge++;
+        }
+        for (int i = 0; i < active.count();) {
+            if (edges[active[i]].fY1 <= rowTop) {
+                active.removeShuffle(i);
+            } else {
+                acc.accumulate(edges[active[i]], rowTop);
+                ++i;
+            }
+        }
+        acc.blitRow(y, blitter);
+        acc.resetRow();
+    }
+}
+
+void SkScan::AnalyticFillPath(const SkPath& path, const SkRasterClip& clip,
+                              SkBlitter* blitter) {
+    if (clip.isEmpty()) {
+        return;
+    }
+
+    if (clip.isBW()) {
+        AnalyticFillPath(path, clip.bwRgn(), blitter);
+    } else {
+        SkRegion        tmp;
+        SkAAClipBlitter aaBlitter;
+
+        tmp.setRect(clip.getBounds());
+        aaBlitter.init(blitter, &clip.aaRgn());
+        SkScan::AnalyticFillPath(path, tmp, &aaBlitter);
+    }
+}
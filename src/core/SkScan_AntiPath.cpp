@@ -11,7 +11,10 @@
 #include "SkPath.h"
 #include "SkMatrix.h"
 #include "SkBlitter.h"
+#include "SkRTConf.h"
 #include "SkRegion.h"
+#include "SkTLS.h"
+#include "SkTemplates.h"
 #include "SkAntiRun.h"
 
 #define SHIFT   2
@@ -34,6 +37,12 @@
 //#define FORCE_SUPERMASK
 //#define FORCE_RLE
 
+// Runtime counterpart of FORCE_RLE, for A/B tuning the supersampler choice without a
+// rebuild.  (FORCE_SUPERMASK has no runtime twin: the mask blitter's storage is a
+// compile-time-sized stack array.)
+SK_CONF_DECLARE(bool, c_forceRLEAA, "rendering.aa.forceRLE", false,
+                "Always use the RLE supersampler for antialiased paths, never the mask one");
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /// Base class for a single-pass supersampled blitter.
@@ -52,7 +61,13 @@ public:
         SkDEBUGFAIL("How did I get here?");
     }
 
+    /// Supersampled pixels covered so far; AntiFillPath profiles this per path.
+    uint64_t coverage() const { return fCoverage; }
+
 protected:
+    /// Running count of covered supersampled pixels, for the draw profile.
+    uint64_t    fCoverage;
+
     SkBlitter*  fRealBlitter;
     /// Current y coordinate, in destination coordinates.
     int         fCurrIY;
@@ -96,6 +111,7 @@ BaseSuperBlitter::BaseSuperBlitter(SkBlitter* realBlit, const SkIRect& ir, const
     fTop = sectBounds.top();
     fCurrIY = fTop - 1;
     fCurrY = (fTop << SHIFT) - 1;
+    fCoverage = 0;
 
     SkDEBUGCODE(fCurrX = -1;)
 }
@@ -209,6 +225,7 @@ void SuperBlitter::blitH(int x, int y, int width) {
         width += x;
         x = 0;
     }
+    fCoverage += width;
 
 #ifdef SK_DEBUG
     SkASSERT(y != fCurrY || x >= fCurrX);
@@ -316,6 +333,7 @@ void SuperBlitter::blitRect(int x, int y, int width, int height) {
     if (count > 0) {
         y += count << SHIFT;
         height -= count << SHIFT;
+        fCoverage += (uint64_t)width * (count << SHIFT);
 
         // save original X for our tail blitH() loop at the bottom
         int origX = x;
@@ -406,6 +424,9 @@ public:
 #ifdef FORCE_RLE
         return false;
 #endif
+        if (c_forceRLEAA) {
+            return false;
+        }
         int width = bounds.width();
         int64_t rb = SkAlign4(width);
         // use 64bits to detect overflow
@@ -552,6 +573,7 @@ void MaskSuperBlitter::blitH(int x, int y, int width) {
         width += x;
         x = 0;
     }
+    fCoverage += width;
 
     uint8_t* row = fMask.fImage + iy * fMask.fRowBytes + (x >> SHIFT);
 
@@ -584,6 +606,49 @@ void MaskSuperBlitter::blitH(int x, int y, int width) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ *  Per-thread profile of prior antialiased draws, keyed by path generation ID. The static
+ *  gates below (bounds, inverse fill, width limits) already use everything knowable before
+ *  drawing; what they can't see is how much of its bounds a path actually covers. The mask
+ *  supersampler clears and resolves its whole rect, so a sparse path (thin outline, long
+ *  diagonal) pays for far more pixels than it touches, while the RLE supersampler only
+ *  visits covered runs. We record the measured density on each draw and use it to steer
+ *  repeat draws of the same path.
+ */
+struct ScanProfileCache {
+    enum { kEntryCount = 64 };
+    struct Entry {
+        uint32_t fGenID;    // 0 means empty
+        uint8_t  fDensity;  // covered fraction of the drawn bounds, 0..255
+    };
+    Entry fEntries[kEntryCount];
+
+    ScanProfileCache() { sk_bzero(fEntries, sizeof(fEntries)); }
+
+    const Entry* find(uint32_t genID) const {
+        const Entry* entry = &fEntries[genID & (kEntryCount - 1)];
+        return (entry->fGenID == genID) ? entry : NULL;
+    }
+
+    void set(uint32_t genID, uint8_t density) {
+        Entry* entry = &fEntries[genID & (kEntryCount - 1)];
+        entry->fGenID = genID;
+        entry->fDensity = density;
+    }
+
+    static void* CreateTLS() { return SkNEW(ScanProfileCache); }
+    static void DeleteTLS(void* ptr) { SkDELETE((ScanProfileCache*)ptr); }
+    static ScanProfileCache* Get() {
+        return (ScanProfileCache*)SkTLS::Get(CreateTLS, DeleteTLS);
+    }
+};
+
+// Below this density (32/255, about an eighth covered) a path that fits the mask
+// supersampler is still cheaper through the RLE one.
+static const uint8_t kSparseDensity = 32;
+
+///////////////////////////////////////////////////////////////////////////////
+
 static bool fitsInsideLimit(const SkRect& r, SkScalar max) {
     const SkScalar min = -max;
     return  r.fLeft > min && r.fTop > min &&
@@ -629,6 +694,12 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         return;
     }
 
+    if (gSkUseAnalyticAA && !forceRLE && !path.isInverseFillType() &&
+            SkPath::kWinding_FillType == path.getFillType()) {
+        SkScan::AnalyticFillPath(path, origClip, blitter);
+        return;
+    }
+
     const bool isInverse = path.isInverseFillType();
     SkIRect ir;
 
@@ -710,15 +781,43 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
 
     SkASSERT(SkIntToScalar(ir.fTop) <= path.getBounds().fTop);
 
+    // Inverse fills and forceRLE pin the engine, so only profile the free choices.
+    ScanProfileCache* profiles = NULL;
+    uint32_t genID = 0;
+    if (!isInverse && !forceRLE) {
+        profiles = ScanProfileCache::Get();
+        genID = path.getGenerationID();
+    }
+
     // MaskSuperBlitter can't handle drawing outside of ir, so we can't use it
     // if we're an inverse filltype
-    if (!isInverse && MaskSuperBlitter::CanHandleRect(ir) && !forceRLE) {
+    bool useMask = !isInverse && MaskSuperBlitter::CanHandleRect(ir) && !forceRLE;
+    if (useMask && profiles) {
+        const ScanProfileCache::Entry* entry = profiles->find(genID);
+        if (entry && entry->fDensity < kSparseDensity) {
+            useMask = false;
+        }
+    }
+
+    uint64_t coverage;
+    if (useMask) {
         MaskSuperBlitter    superBlit(blitter, ir, *clipRgn, isInverse);
         SkASSERT(SkIntToScalar(ir.fTop) <= path.getBounds().fTop);
         sk_fill_path(path, superClipRect, &superBlit, ir.fTop, ir.fBottom, SHIFT, *clipRgn);
+        coverage = superBlit.coverage();
     } else {
         SuperBlitter    superBlit(blitter, ir, *clipRgn, isInverse);
         sk_fill_path(path, superClipRect, &superBlit, ir.fTop, ir.fBottom, SHIFT, *clipRgn);
+        coverage = superBlit.coverage();
+    }
+
+    if (profiles) {
+        const uint64_t superArea = ((uint64_t)ir.width() << SHIFT) *
+                                   ((uint64_t)ir.height() << SHIFT);
+        if (superArea) {
+            profiles->set(genID,
+                          (uint8_t)SkTMin<uint64_t>(coverage * 255 / superArea, 255));
+        }
     }
 
     if (isInverse) {
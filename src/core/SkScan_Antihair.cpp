@@ -550,6 +550,19 @@ void SkScan::AntiHairLineRgn(const SkPoint array[], int arrayCount, const SkRegi
         clipBounds.outset(SK_Scalar1, SK_Scalar1);
     }
 
+    // Same idea as in HairLineRgn: when a rect clip contains the whole
+    // polyline there is nothing for the per-segment quickReject /
+    // quickContains tests below to do, so bound the array once and drop the
+    // clip. The outset covers the extra pixel the blitters can touch on
+    // either side of an antialiased hairline.
+    if (clip && arrayCount > 2) {
+        SkRect bounds;
+        if (bounds.setBoundsCheck(array, arrayCount) &&   // stay clipped on non-finite
+                clip->quickContains(bounds.roundOut().makeOutset(2, 2))) {
+            clip = NULL;
+        }
+    }
+
     for (int i = 0; i < arrayCount - 1; ++i) {
         SkPoint pts[2];
 
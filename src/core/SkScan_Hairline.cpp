@@ -51,6 +51,21 @@ void SkScan::HairLineRgn(const SkPoint array[], int arrayCount, const SkRegion*
         clipBounds.set(clip->getBounds());
     }
 
+    // If the clip is a rect that contains the whole polyline, every
+    // per-segment clip test below is dead work, which adds up fast for
+    // polylines with tens of thousands of tiny segments. Bound the whole
+    // array once (outset by a pixel, since a hairline can hit the pixel to
+    // the right or below its coordinate) and drop the clip up front.
+    if (clip && arrayCount > 2) {
+        SkRect bounds;
+        if (bounds.setBoundsCheck(array, arrayCount)) {   // stay clipped on non-finite
+            bounds.outset(SK_Scalar1, SK_Scalar1);
+            if (clip->quickContains(bounds.roundOut())) {
+                clip = NULL;
+            }
+        }
+    }
+
     for (int i = 0; i < arrayCount - 1; ++i) {
         SkBlitter* blitter = origBlitter;
 
@@ -9,6 +9,7 @@
 #include "SkBlitter.h"
 #include "SkEdge.h"
 #include "SkEdgeBuilder.h"
+#include "SkEdgeListCache.h"
 #include "SkGeometry.h"
 #include "SkPath.h"
 #include "SkQuadClipper.h"
@@ -403,10 +404,26 @@ void sk_fill_path(const SkPath& path, const SkIRect* clipRect, SkBlitter* blitte
     // If we're convex, then we need both edges, even the right edge is past the clip
     const bool canCullToTheRight = !path.isConvex();
 
-    int count = builder.build(path, clipRect, shiftEdgesUp, canCullToTheRight);
-    SkASSERT(count >= 0);
-
-    SkEdge**    list = builder.edgeList();
+    // Repeated draws of the same device-space geometry can reuse the built
+    // edge list; edges get mutated while walked, so a hit hands us a copy.
+    SkAutoMalloc        cachedEdgeStorage;
+    SkTDArray<SkEdge*>  cachedList;
+    uint64_t            digest = 0;
+    const bool tryCache = SkEdgeListCache::ComputeDigest(path, clipRect, shiftEdgesUp,
+                                                         canCullToTheRight, &digest);
+
+    SkEdge** list;
+    int count = tryCache ? SkEdgeListCache::Find(digest, &cachedEdgeStorage, &cachedList) : -1;
+    if (count >= 0) {
+        list = cachedList.begin();
+    } else {
+        count = builder.build(path, clipRect, shiftEdgesUp, canCullToTheRight);
+        SkASSERT(count >= 0);
+        list = builder.edgeList();
+        if (tryCache) {
+            SkEdgeListCache::Add(digest, list, count);
+        }
+    }
 
     if (0 == count) {
         if (path.isInverseFillType()) {
@@ -381,6 +381,14 @@ bool SkMemoryStream::peek(void* buffer, size_t size) const {
     return true;
 }
 
+const void* SkMemoryStream::peekBytes(size_t size) const {
+    if (size > fData->size() - fOffset) {
+        // The stream is not large enough to satisfy this request.
+        return NULL;
+    }
+    return fData->bytes() + fOffset;
+}
+
 bool SkMemoryStream::isAtEnd() const {
     return fOffset == fData->size();
 }
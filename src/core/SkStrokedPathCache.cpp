@@ -0,0 +1,76 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkStrokedPathCache.h"
+#include "SkResourceCache.h"
+
+// Below this many verbs, restroking is comparable to the cache traffic.
+static const int kMinVerbsToCache = 4;
+
+// Strokes are tolerance-based, so nearby res scales share an entry.
+static SkScalar quantize_res_scale(SkScalar resScale) {
+    return SkScalarRoundToScalar(resScale * 2) / 2;
+}
+
+namespace {
+
+static unsigned gStrokedPathKeyNamespaceLabel;
+
+struct StrokedPathKey : public SkResourceCache::Key {
+    StrokedPathKey(const SkPath& src, const SkStrokeRec& rec) {
+        fGenID = src.getGenerationID();
+        fWidth = rec.getWidth();
+        fMiter = rec.getMiter();
+        fResScale = quantize_res_scale(rec.getResScale());
+        fPacked = (rec.getCap() << 8) | (rec.getJoin() << 4) | rec.getStyle();
+        this->init(&gStrokedPathKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fWidth) + sizeof(fMiter) +
+                   sizeof(fResScale) + sizeof(fPacked));
+    }
+
+    uint32_t fGenID;
+    SkScalar fWidth;
+    SkScalar fMiter;
+    SkScalar fResScale;
+    uint32_t fPacked;
+};
+
+struct StrokedPathRec : public SkResourceCache::Rec {
+    StrokedPathRec(const StrokedPathKey& key, const SkPath& stroked)
+        : fKey(key), fStroked(stroked) {}
+
+    StrokedPathKey fKey;
+    SkPath         fStroked;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fStroked.countPoints() * sizeof(SkPoint)
+                             + fStroked.countVerbs();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const StrokedPathRec& rec = static_cast<const StrokedPathRec&>(baseRec);
+        *(SkPath*)contextData = rec.fStroked;
+        return true;
+    }
+};
+
+}  // namespace
+
+bool SkStrokedPathCache::UsableFor(const SkPath& src, const SkStrokeRec& rec) {
+    return rec.needToApply() && !src.isVolatile() && src.countVerbs() >= kMinVerbsToCache;
+}
+
+bool SkStrokedPathCache::Find(const SkPath& src, const SkStrokeRec& rec, SkPath* result) {
+    SkASSERT(UsableFor(src, rec));
+    return SkResourceCache::Find(StrokedPathKey(src, rec), StrokedPathRec::Visitor, result);
+}
+
+void SkStrokedPathCache::Add(const SkPath& src, const SkStrokeRec& rec, const SkPath& result) {
+    SkASSERT(UsableFor(src, rec));
+    SkResourceCache::Add(SkNEW_ARGS(StrokedPathRec, (StrokedPathKey(src, rec), result)));
+}
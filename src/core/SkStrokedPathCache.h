@@ -0,0 +1,36 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrokedPathCache_DEFINED
+#define SkStrokedPathCache_DEFINED
+
+#include "SkPath.h"
+#include "SkStrokeRec.h"
+
+/**
+ *  Caches the fill path produced by stroking, in SkResourceCache, so paints
+ *  that re-stroke unchanged geometry every frame (routes, charts) get a hash
+ *  lookup instead of rebuilding the outline in SkStroke.
+ *
+ *  Entries are keyed by the source path's generation ID, the stroke
+ *  parameters, and a quantized resolution scale. Only plain strokes are
+ *  cached: path effects see per-draw state (cull rects, dash phase) that the
+ *  key can't capture.
+ */
+class SkStrokedPathCache {
+public:
+    /** True if this src/rec combination is worth looking up at all. */
+    static bool UsableFor(const SkPath& src, const SkStrokeRec&);
+
+    /** On a hit, copies the cached stroked path into result. */
+    static bool Find(const SkPath& src, const SkStrokeRec&, SkPath* result);
+
+    /** Record the stroked fill path for this src/rec combination. */
+    static void Add(const SkPath& src, const SkStrokeRec&, const SkPath& result);
+};
+
+#endif
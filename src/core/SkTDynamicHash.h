@@ -16,18 +16,27 @@
 //   static const Key& GetKey(const T&) { ... }
 //   static uint32_t Hash(const Key&) { ... }
 // We'll look on T for these by default, or you can pass a custom Traits type.
+//
+// Internally this is a Robin Hood hash: linear probing where an insert may
+// displace a resident entry that sits closer to its preferred slot than the
+// incoming entry does, and a remove shifts the following run of entries back
+// one slot. That keeps probe sequences short and contiguous with no deleted
+// markers to skip, even under the sustained insert/remove churn the resource
+// caches produce. We cache each entry's hash beside its slot so a probe can
+// reject a mismatch without touching the entry itself.
 template <typename T,
           typename Key,
           typename Traits = T,
           int kGrowPercent = 75>  // Larger -> more memory efficient, but slower.
 class SkTDynamicHash {
 public:
-    SkTDynamicHash() : fCount(0), fDeleted(0), fCapacity(0), fArray(NULL) {
+    SkTDynamicHash() : fCount(0), fCapacity(0), fArray(NULL), fHashes(NULL) {
         SkASSERT(this->validate());
     }
 
     ~SkTDynamicHash() {
         sk_free(fArray);
+        sk_free(fHashes);
     }
 
     class Iter {
@@ -47,7 +56,7 @@ public:
         void operator++() {
             do {
                 fCurrentIndex++;
-            } while (!this->done() && (this->current() == Empty() || this->current() == Deleted()));
+            } while (!this->done() && this->current() == Empty());
         }
 
     private:
@@ -74,7 +83,7 @@ public:
         void operator++() {
             do {
                 fCurrentIndex++;
-            } while (!this->done() && (this->current() == Empty() || this->current() == Deleted()));
+            } while (!this->done() && this->current() == Empty());
         }
 
     private:
@@ -88,17 +97,23 @@ public:
 
     // Return the entry with this key if we have it, otherwise NULL.
     T* find(const Key& key) const {
-        int index = this->firstIndex(key);
-        for (int round = 0; round < fCapacity; round++) {
+        const uint32_t hash = Hash(key);
+        int index = hash & this->hashMask();
+        for (int dist = 0; dist < fCapacity; dist++) {
             SkASSERT(index >= 0 && index < fCapacity);
             T* candidate = fArray[index];
             if (Empty() == candidate) {
                 return NULL;
             }
-            if (Deleted() != candidate && GetKey(*candidate) == key) {
+            if (hash == fHashes[index] && GetKey(*candidate) == key) {
                 return candidate;
             }
-            index = this->nextIndex(index, round);
+            // Anything hashing to our slot would have displaced this entry
+            // rather than probe past it, so the key can't be further along.
+            if (this->distance(index) < dist) {
+                return NULL;
+            }
+            index = this->nextIndex(index);
         }
         SkASSERT(fCapacity == 0);
         return NULL;
@@ -124,15 +139,15 @@ public:
             sk_bzero(fArray, sizeof(T*)* fCapacity);
         }
         fCount = 0;
-        fDeleted = 0;
     }
 
-    void reset() { 
-        fCount = 0; 
-        fDeleted = 0; 
-        fCapacity = 0; 
-        sk_free(fArray); 
-        fArray = NULL; 
+    void reset() {
+        fCount = 0;
+        fCapacity = 0;
+        sk_free(fArray);
+        fArray = NULL;
+        sk_free(fHashes);
+        fHashes = NULL;
     }
 
 protected:
@@ -142,23 +157,23 @@ protected:
 
     // How many collisions do we go through before finding where this entry should be inserted?
     int countCollisions(const Key& key) const {
-        int index = this->firstIndex(key);
-        for (int round = 0; round < fCapacity; round++) {
+        const uint32_t hash = Hash(key);
+        int index = hash & this->hashMask();
+        for (int dist = 0; dist < fCapacity; dist++) {
             SkASSERT(index >= 0 && index < fCapacity);
             const T* candidate = fArray[index];
-            if (Empty() == candidate || Deleted() == candidate || GetKey(*candidate) == key) {
-                return round;
+            if (Empty() == candidate || (hash == fHashes[index] && GetKey(*candidate) == key)) {
+                return dist;
             }
-            index = this->nextIndex(index, round);
+            index = this->nextIndex(index);
         }
         SkASSERT(fCapacity == 0);
         return 0;
     }
 
 private:
-    // We have two special values to indicate an empty or deleted entry.
-    static T* Empty()   { return reinterpret_cast<T*>(0); }  // i.e. NULL
-    static T* Deleted() { return reinterpret_cast<T*>(1); }  // Also an invalid pointer.
+    // We have a special value to indicate an empty slot.
+    static T* Empty() { return reinterpret_cast<T*>(0); }  // i.e. NULL
 
     bool validate() const {
         #define SKTDYNAMICHASH_CHECK(x) SkASSERT(x); if (!(x)) return false
@@ -170,29 +185,27 @@ private:
 
         // O(N) checks, skipped when very large.
         if (fCount < kLarge * kLarge) {
-            // Are fCount and fDeleted correct, and are all elements findable?
-            int count = 0, deleted = 0;
+            // Is fCount correct, is each cached hash fresh, and is every element findable?
+            int count = 0;
             for (int i = 0; i < fCapacity; i++) {
-                if (Deleted() == fArray[i]) {
-                    deleted++;
-                } else if (Empty() != fArray[i]) {
+                if (Empty() != fArray[i]) {
                     count++;
+                    SKTDYNAMICHASH_CHECK(Hash(GetKey(*fArray[i])) == fHashes[i]);
                     SKTDYNAMICHASH_CHECK(this->find(GetKey(*fArray[i])));
                 }
             }
             SKTDYNAMICHASH_CHECK(count == fCount);
-            SKTDYNAMICHASH_CHECK(deleted == fDeleted);
         }
 
         // O(N^2) checks, skipped when large.
         if (fCount < kLarge) {
             // Are all entries unique?
             for (int i = 0; i < fCapacity; i++) {
-                if (Empty() == fArray[i] || Deleted() == fArray[i]) {
+                if (Empty() == fArray[i]) {
                     continue;
                 }
                 for (int j = i+1; j < fCapacity; j++) {
-                    if (Empty() == fArray[j] || Deleted() == fArray[j]) {
+                    if (Empty() == fArray[j]) {
                         continue;
                     }
                     SKTDYNAMICHASH_CHECK(fArray[i] != fArray[j]);
@@ -205,43 +218,61 @@ private:
     }
 
     void innerAdd(T* newEntry) {
-        const Key& key = GetKey(*newEntry);
-        int index = this->firstIndex(key);
+        T* entry = newEntry;
+        uint32_t hash = Hash(GetKey(*entry));
+        int index = hash & this->hashMask();
+        int dist = 0;
         for (int round = 0; round < fCapacity; round++) {
             SkASSERT(index >= 0 && index < fCapacity);
-            const T* candidate = fArray[index];
-            if (Empty() == candidate || Deleted() == candidate) {
-                if (Deleted() == candidate) {
-                    fDeleted--;
-                }
+            if (Empty() == fArray[index]) {
+                fArray[index] = entry;
+                fHashes[index] = hash;
                 fCount++;
-                fArray[index] = newEntry;
                 return;
             }
-            index = this->nextIndex(index, round);
+            // Robin Hood: if the resident entry is closer to its preferred
+            // slot than we are to ours, it can better afford to keep probing.
+            // Take its slot and carry it forward instead.
+            const int residentDist = this->distance(index);
+            if (residentDist < dist) {
+                SkTSwap(entry, fArray[index]);
+                SkTSwap(hash, fHashes[index]);
+                dist = residentDist;
+            }
+            index = this->nextIndex(index);
+            dist++;
         }
         SkASSERT(fCapacity == 0);
     }
 
     void innerRemove(const Key& key) {
-        const int firstIndex = this->firstIndex(key);
-        int index = firstIndex;
-        for (int round = 0; round < fCapacity; round++) {
+        const uint32_t hash = Hash(key);
+        int index = hash & this->hashMask();
+        for (int dist = 0; dist < fCapacity; dist++) {
             SkASSERT(index >= 0 && index < fCapacity);
-            const T* candidate = fArray[index];
-            if (Deleted() != candidate && GetKey(*candidate) == key) {
-                fDeleted++;
+            if (hash == fHashes[index] && GetKey(*fArray[index]) == key) {
+                // Shift the rest of the probe run back one slot, so no
+                // deleted marker is needed to keep later entries findable.
+                for (;;) {
+                    const int next = this->nextIndex(index);
+                    if (Empty() == fArray[next] || 0 == this->distance(next)) {
+                        break;
+                    }
+                    fArray[index] = fArray[next];
+                    fHashes[index] = fHashes[next];
+                    index = next;
+                }
+                fArray[index] = Empty();
                 fCount--;
-                fArray[index] = Deleted();
                 return;
             }
-            index = this->nextIndex(index, round);
+            index = this->nextIndex(index);
         }
         SkASSERT(fCapacity == 0);
     }
 
     void maybeGrow() {
-        if (100 * (fCount + fDeleted + 1) > fCapacity * kGrowPercent) {
+        if (100 * (fCount + 1) > fCapacity * kGrowPercent) {
             this->resize(fCapacity > 0 ? fCapacity * 2 : 4);
         }
     }
@@ -251,13 +282,15 @@ private:
         int oldCapacity = fCapacity;
         SkAutoTMalloc<T*> oldArray(fArray);
 
-        fCount = fDeleted = 0;
+        fCount = 0;
         fCapacity = newCapacity;
         fArray = (T**)sk_calloc_throw(sizeof(T*) * fCapacity);
+        sk_free(fHashes);
+        fHashes = (uint32_t*)sk_malloc_throw(sizeof(uint32_t) * fCapacity);
 
         for (int i = 0; i < oldCapacity; i++) {
             T* entry = oldArray[i];
-            if (Empty() != entry && Deleted() != entry) {
+            if (Empty() != entry) {
                 this->innerAdd(entry);
             }
         }
@@ -267,23 +300,24 @@ private:
     // fCapacity is always a power of 2, so this masks the correct low bits to index into our hash.
     uint32_t hashMask() const { return fCapacity - 1; }
 
-    int firstIndex(const Key& key) const {
-        return Hash(key) & this->hashMask();
+    // Given index at round N, what is the index to check at N+1?
+    int nextIndex(int index) const {
+        return (index + 1) & this->hashMask();
     }
 
-    // Given index at round N, what is the index to check at N+1?  round should start at 0.
-    int nextIndex(int index, int round) const {
-        // This will search a power-of-two array fully without repeating an index.
-        return (index + round + 1) & this->hashMask();
+    // How far has the entry at index probed past its preferred slot?
+    int distance(int index) const {
+        SkASSERT(Empty() != fArray[index]);
+        return (index - (fHashes[index] & this->hashMask())) & this->hashMask();
     }
 
     static const Key& GetKey(const T& t) { return Traits::GetKey(t); }
     static uint32_t Hash(const Key& key) { return Traits::Hash(key); }
 
-    int fCount;     // Number of non Empty(), non Deleted() entries in fArray.
-    int fDeleted;   // Number of Deleted() entries in fArray.
+    int fCount;     // Number of non Empty() entries in fArray.
     int fCapacity;  // Number of entries in fArray.  Always a power of 2.
     T** fArray;
+    uint32_t* fHashes;  // Cached Hash(GetKey(*fArray[i])) for each occupied slot.
 };
 
 #endif
@@ -1,7 +1,9 @@
 #include "SkTaskGroup.h"
 
 #include "SkCondVar.h"
+#include "SkRTConf.h"
 #include "SkRunnable.h"
+#include "SkSpinlock.h"
 #include "SkTDArray.h"
 #include "SkThread.h"
 #include "SkThreadUtils.h"
@@ -23,26 +25,28 @@ namespace {
 
 class ThreadPool : SkNoncopyable {
 public:
-    static void Add(SkRunnable* task, int32_t* pending) {
+    static void Add(SkRunnable* task, SkTaskGroup::Priority priority, int32_t* pending) {
         if (!gGlobal) {  // If we have no threads, run synchronously.
             return task->run();
         }
-        gGlobal->add(&CallRunnable, task, pending);
+        gGlobal->add(&CallRunnable, task, priority, pending);
     }
 
-    static void Add(void (*fn)(void*), void* arg, int32_t* pending) {
+    static void Add(void (*fn)(void*), void* arg, SkTaskGroup::Priority priority,
+                    int32_t* pending) {
         if (!gGlobal) {
             return fn(arg);
         }
-        gGlobal->add(fn, arg, pending);
+        gGlobal->add(fn, arg, priority, pending);
     }
 
-    static void Batch(void (*fn)(void*), void* args, int N, size_t stride, int32_t* pending) {
+    static void Batch(void (*fn)(void*), void* args, int N, size_t stride,
+                      SkTaskGroup::Priority priority, int32_t* pending) {
         if (!gGlobal) {
             for (int i = 0; i < N; i++) { fn((char*)args + i*stride); }
             return;
         }
-        gGlobal->batch(fn, args, N, stride, pending);
+        gGlobal->batch(fn, args, N, stride, priority, pending);
     }
 
     static void Wait(int32_t* pending) {
@@ -53,14 +57,10 @@ public:
         while (sk_acquire_load(pending) > 0) {  // Pairs with sk_atomic_dec here or in Loop.
             // Lend a hand until our SkTaskGroup of interest is done.
             Work work;
-            {
-                AutoLock lock(&gGlobal->fReady);
-                if (gGlobal->fWork.isEmpty()) {
-                    // Someone has picked up all the work (including ours).  How nice of them!
-                    // (They may still be working on it, so we can't assert *pending == 0 here.)
-                    continue;
-                }
-                gGlobal->fWork.pop(&work);
+            if (!gGlobal->findWork(0, &work)) {
+                // Someone has picked up all the work (including ours).  How nice of them!
+                // (They may still be working on it, so we can't assert *pending == 0 here.)
+                continue;
             }
             // This Work isn't necessarily part of our SkTaskGroup of interest, but that's fine.
             // We threads gotta stick together.  We're always making forward progress.
@@ -70,13 +70,6 @@ public:
     }
 
 private:
-    struct AutoLock {
-        AutoLock(SkCondVar* c) : fC(c) { fC->lock(); }
-        ~AutoLock() { fC->unlock(); }
-    private:
-        SkCondVar* fC;
-    };
-
     static void CallRunnable(void* arg) { static_cast<SkRunnable*>(arg)->run(); }
 
     struct Work {
@@ -85,10 +78,22 @@ private:
         int32_t* pending;   // then sk_atomic_dec(pending) afterwards.
     };
 
-    explicit ThreadPool(int threads) : fDraining(false) {
+    // One per worker thread. add() scatters tasks across these round-robin, so submitters and
+    // workers usually contend for different (brief, spinlocked) locks rather than one global
+    // mutex.  Workers drain their own deque first and steal from the others when it runs dry.
+    struct Deque {
+        SkSpinlock      fLock;
+        SkTDArray<Work> fHigh;    // Run before anything in fNormal, regardless of age.
+        SkTDArray<Work> fNormal;
+    };
+
+    explicit ThreadPool(int threads)
+        : fDraining(false), fWorkCount(0), fSleepers(0), fNextDeque(0), fNextWorkerId(0) {
         if (threads == -1) {
             threads = num_cores();
         }
+        fDequeCount = threads;
+        fDeques = SkNEW_ARRAY(Deque, fDequeCount);
         for (int i = 0; i < threads; i++) {
             fThreads.push(SkNEW_ARGS(SkThread, (&ThreadPool::Loop, this)));
             fThreads.top()->start();
@@ -96,65 +101,132 @@ private:
     }
 
     ~ThreadPool() {
-        SkASSERT(fWork.isEmpty());  // All SkTaskGroups should be destroyed by now.
+        SkASSERT(0 == fWorkCount);  // All SkTaskGroups should be destroyed by now.
         {
-            AutoLock lock(&fReady);
+            fReady.lock();
             fDraining = true;
             fReady.broadcast();
+            fReady.unlock();
         }
         for (int i = 0; i < fThreads.count(); i++) {
             fThreads[i]->join();
         }
-        SkASSERT(fWork.isEmpty());  // Can't hurt to double check.
+        SkASSERT(0 == fWorkCount);  // Can't hurt to double check.
         fThreads.deleteAll();
+        SkDELETE_ARRAY(fDeques);
     }
 
-    void add(void (*fn)(void*), void* arg, int32_t* pending) {
+    void add(void (*fn)(void*), void* arg, SkTaskGroup::Priority priority, int32_t* pending) {
         Work work = { fn, arg, pending };
         sk_atomic_inc(pending);  // No barrier needed.
-        {
-            AutoLock lock(&fReady);
-            fWork.push(work);
-            fReady.signal();
-        }
+        Deque& deque = fDeques[(uint32_t)sk_atomic_inc(&fNextDeque) % fDequeCount];
+        deque.fLock.acquire();
+        (SkTaskGroup::kHigh_Priority == priority ? deque.fHigh : deque.fNormal).push(work);
+        deque.fLock.release();
+        sk_atomic_inc(&fWorkCount);
+        this->wake(1);
     }
 
-    void batch(void (*fn)(void*), void* arg, int N, size_t stride, int32_t* pending) {
+    void batch(void (*fn)(void*), void* arg, int N, size_t stride,
+               SkTaskGroup::Priority priority, int32_t* pending) {
         sk_atomic_add(pending, N);  // No barrier needed.
-        {
-            AutoLock lock(&fReady);
-            Work* batch = fWork.append(N);
-            for (int i = 0; i < N; i++) {
+        // Scatter the batch across the deques in contiguous chunks, one lock grab per deque.
+        const int perDeque = (N + fDequeCount - 1) / fDequeCount;
+        const uint32_t start = (uint32_t)sk_atomic_inc(&fNextDeque);
+        int i = 0;
+        for (int d = 0; d < fDequeCount && i < N; d++) {
+            Deque& deque = fDeques[(start + d) % fDequeCount];
+            const int n = SkTMin(perDeque, N - i);
+            deque.fLock.acquire();
+            Work* batch =
+                    (SkTaskGroup::kHigh_Priority == priority ? deque.fHigh : deque.fNormal)
+                            .append(n);
+            for (int j = 0; j < n; j++, i++) {
                 Work work = { fn, (char*)arg + i*stride, pending };
-                batch[i] = work;
+                batch[j] = work;
             }
-            fReady.broadcast();
+            deque.fLock.release();
+        }
+        sk_atomic_add(&fWorkCount, N);
+        this->wake(N);
+    }
+
+    // Take one piece of work out of deque, high priority first.  Returns false if it's empty.
+    static bool Take(Deque* deque, Work* work) {
+        SkTDArray<Work>* queue = NULL;
+        deque->fLock.acquire();
+        if (!deque->fHigh.isEmpty()) {
+            queue = &deque->fHigh;
+        } else if (!deque->fNormal.isEmpty()) {
+            queue = &deque->fNormal;
+        }
+        if (queue) {
+            queue->pop(work);
+        }
+        deque->fLock.release();
+        return SkToBool(queue);
+    }
+
+    // Look for work, starting with our own deque and then stealing from the others.
+    bool findWork(int self, Work* work) {
+        for (int i = 0; i < fDequeCount; i++) {
+            if (Take(&fDeques[(self + i) % fDequeCount], work)) {
+                sk_atomic_dec(&fWorkCount);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Poke sleeping workers, if there are any.  n is how many new tasks just arrived.
+    void wake(int n) {
+        if (sk_acquire_load(&fSleepers) > 0) {
+            fReady.lock();
+            if (n > 1) {
+                fReady.broadcast();
+            } else {
+                fReady.signal();
+            }
+            fReady.unlock();
         }
     }
 
     static void Loop(void* arg) {
         ThreadPool* pool = (ThreadPool*)arg;
+        const int self = sk_atomic_inc(&pool->fNextWorkerId);
         Work work;
         while (true) {
-            {
-                AutoLock lock(&pool->fReady);
-                while (pool->fWork.isEmpty()) {
-                    if (pool->fDraining) {
-                        return;
-                    }
-                    pool->fReady.wait();
-                }
-                pool->fWork.pop(&work);
+            if (pool->findWork(self, &work)) {
+                work.fn(work.arg);
+                sk_atomic_dec(work.pending);  // Release pairs with sk_acquire_load() in Wait().
+                continue;
+            }
+            // All the deques looked empty.  Sleep unless work arrived while we were scanning:
+            // we advertise ourselves as asleep first, then re-check the work count, so wake()
+            // can't miss us.  (It reads fWorkCount's inc before it reads fSleepers.)
+            pool->fReady.lock();
+            sk_atomic_inc(&pool->fSleepers);
+            if (0 == sk_acquire_load(&pool->fWorkCount) && !pool->fDraining) {
+                pool->fReady.wait();
+            }
+            sk_atomic_dec(&pool->fSleepers);
+            const bool done = pool->fDraining && 0 == sk_acquire_load(&pool->fWorkCount);
+            pool->fReady.unlock();
+            if (done) {
+                return;
             }
-            work.fn(work.arg);
-            sk_atomic_dec(work.pending);  // Release pairs with sk_acquire_load() in Wait().
         }
     }
 
-    SkTDArray<Work>      fWork;
+    Deque*               fDeques;     // Allocated fDequeCount long, freed in the destructor.
+    int                  fDequeCount;
     SkTDArray<SkThread*> fThreads;
-    SkCondVar            fReady;
+    SkCondVar            fReady;       // Only used for sleeping and waking workers.
     bool                 fDraining;
+    /*atomic*/ int32_t   fWorkCount;   // Total tasks sitting in the deques.
+    /*atomic*/ int32_t   fSleepers;    // Workers blocked in fReady.wait().
+    /*atomic*/ int32_t   fNextDeque;   // Round-robin cursor for add() and batch().
+    /*atomic*/ int32_t   fNextWorkerId;
 
     static ThreadPool* gGlobal;
     friend struct SkTaskGroup::Enabler;
@@ -163,8 +235,15 @@ ThreadPool* ThreadPool::gGlobal = NULL;
 
 }  // namespace
 
+SK_CONF_DECLARE(int, c_taskGroupThreads, "threads.taskGroupCount", -1,
+                "SkTaskGroup worker thread count; -1 keeps the caller's choice, 0 disables the "
+                "pool entirely");
+
 SkTaskGroup::Enabler::Enabler(int threads) {
     SkASSERT(ThreadPool::gGlobal == NULL);
+    if (c_taskGroupThreads >= 0) {
+        threads = c_taskGroupThreads;
+    }
     if (threads != 0 && SkCondVar::Supported()) {
         ThreadPool::gGlobal = SkNEW_ARGS(ThreadPool, (threads));
     }
@@ -176,10 +255,14 @@ SkTaskGroup::Enabler::~Enabler() {
 
 SkTaskGroup::SkTaskGroup() : fPending(0) {}
 
-void SkTaskGroup::wait()                            { ThreadPool::Wait(&fPending); }
-void SkTaskGroup::add(SkRunnable* task)             { ThreadPool::Add(task, &fPending); }
-void SkTaskGroup::add(void (*fn)(void*), void* arg) { ThreadPool::Add(fn, arg, &fPending); }
-void SkTaskGroup::batch (void (*fn)(void*), void* args, int N, size_t stride) {
-    ThreadPool::Batch(fn, args, N, stride, &fPending);
+void SkTaskGroup::wait() { ThreadPool::Wait(&fPending); }
+void SkTaskGroup::add(SkRunnable* task, Priority priority) {
+    ThreadPool::Add(task, priority, &fPending);
+}
+void SkTaskGroup::add(void (*fn)(void*), void* arg, Priority priority) {
+    ThreadPool::Add(fn, arg, priority, &fPending);
+}
+void SkTaskGroup::batch(void (*fn)(void*), void* args, int N, size_t stride, Priority priority) {
+    ThreadPool::Batch(fn, args, N, stride, priority, &fPending);
 }
 
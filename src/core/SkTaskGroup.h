@@ -20,20 +20,32 @@ public:
         ~Enabler();
     };
 
+    // High-priority tasks are run before any normal-priority task, no matter when they were
+    // added.  Use kHigh_Priority for latency-critical work (e.g. tiles needed this frame) that
+    // shares the pool with background work like decodes.
+    enum Priority {
+        kHigh_Priority,
+        kNormal_Priority,
+    };
+
     SkTaskGroup();
     ~SkTaskGroup() { this->wait(); }
 
     // Add a task to this SkTaskGroup.  It will likely run on another thread.
     // Neither add() method takes owership of any of its parameters.
-    void add(SkRunnable*);
+    void add(SkRunnable*, Priority = kNormal_Priority);
 
     template <typename T>
-    void add(void (*fn)(T*), T* arg) { this->add((void_fn)fn, (void*)arg); }
+    void add(void (*fn)(T*), T* arg, Priority priority = kNormal_Priority) {
+        this->add((void_fn)fn, (void*)arg, priority);
+    }
 
     // Add a batch of N tasks, all calling fn with different arguments.
     // Equivalent to a loop over add(fn, arg), but with perhaps less synchronization overhead.
     template <typename T>
-    void batch(void (*fn)(T*), T* args, int N) { this->batch((void_fn)fn, args, N, sizeof(T)); }
+    void batch(void (*fn)(T*), T* args, int N, Priority priority = kNormal_Priority) {
+        this->batch((void_fn)fn, args, N, sizeof(T), priority);
+    }
 
     // Block until all Tasks previously add()ed to this SkTaskGroup have run.
     // You may safely reuse this SkTaskGroup after wait() returns.
@@ -42,8 +54,8 @@ public:
 private:
     typedef void(*void_fn)(void*);
 
-    void add  (void_fn, void* arg);
-    void batch(void_fn, void* args, int N, size_t stride);
+    void add  (void_fn, void* arg, Priority);
+    void batch(void_fn, void* args, int N, size_t stride, Priority);
 
     /*atomic*/ int32_t fPending;
 };
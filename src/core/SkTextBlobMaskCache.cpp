@@ -0,0 +1,132 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTextBlobMaskCache.h"
+#include "SkTextBlob.h"
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+// Masks larger than this are likely too expensive to keep around, and large
+// blobs amortize their rasterization cost over many glyphs anyway.
+static const SkScalar kMaxCachedDimension = 256;
+
+struct BlobMaskValue {
+    SkMask          fMask;
+    SkCachedData*   fData;
+};
+
+namespace {
+static unsigned gBlobMaskKeyNamespaceLabel;
+
+struct BlobMaskKey : public SkResourceCache::Key {
+public:
+    BlobMaskKey(uint32_t blobID, const SkMatrix& matrix, const SkPaint& paint)
+        : fBlobID(blobID)
+        , fPaintFlags(paint.getFlags())
+        , fHinting(paint.getHinting())
+    {
+        fMatrix[0] = matrix.getScaleX();
+        fMatrix[1] = matrix.getSkewX();
+        fMatrix[2] = matrix.getSkewY();
+        fMatrix[3] = matrix.getScaleY();
+        // Only the fractional translation affects the rendered mask; keying on
+        // it (rather than the full translation) lets one entry serve every
+        // integer offset of the same blob.
+        fMatrix[4] = matrix.getTranslateX() - SkScalarFloorToScalar(matrix.getTranslateX());
+        fMatrix[5] = matrix.getTranslateY() - SkScalarFloorToScalar(matrix.getTranslateY());
+
+        this->init(&gBlobMaskKeyNamespaceLabel, 0,
+                   sizeof(fBlobID) + sizeof(fPaintFlags) + sizeof(fHinting) + sizeof(fMatrix));
+    }
+
+    uint32_t    fBlobID;
+    uint32_t    fPaintFlags;
+    uint32_t    fHinting;
+    SkScalar    fMatrix[6];
+};
+
+struct BlobMaskRec : public SkResourceCache::Rec {
+    BlobMaskRec(BlobMaskKey key, const SkMask& mask, SkCachedData* data)
+        : fKey(key)
+    {
+        fValue.fMask = mask;
+        fValue.fData = data;
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~BlobMaskRec() {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    BlobMaskKey   fKey;
+    BlobMaskValue fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const BlobMaskRec& rec = static_cast<const BlobMaskRec&>(baseRec);
+        BlobMaskValue* result = static_cast<BlobMaskValue*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (NULL == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = rec.fValue;
+        return true;
+    }
+};
+} // namespace
+
+bool SkTextBlobMaskCache::IsCacheable(const SkTextBlob* blob, const SkMatrix& matrix,
+                                      const SkPaint& paint) {
+    if (matrix.hasPerspective()) {
+        return false;
+    }
+    if (SkPaint::kFill_Style != paint.getStyle()) {
+        return false;
+    }
+    // Geometry and mask effects change the rendered coverage in ways the key
+    // does not describe.
+    if (paint.getPathEffect() || paint.getMaskFilter() || paint.getRasterizer()) {
+        return false;
+    }
+    // LCD coverage cannot round-trip through an A8 mask.
+    if (paint.isLCDRenderText()) {
+        return false;
+    }
+
+    SkRect devBounds;
+    matrix.mapRect(&devBounds, blob->bounds());
+    if (!devBounds.isFinite() || devBounds.isEmpty()) {
+        return false;
+    }
+    return devBounds.width() <= kMaxCachedDimension && devBounds.height() <= kMaxCachedDimension;
+}
+
+SkCachedData* SkTextBlobMaskCache::FindAndRef(uint32_t blobID, const SkMatrix& matrix,
+                                              const SkPaint& paint, SkMask* mask,
+                                              SkResourceCache* localCache) {
+    BlobMaskValue result;
+    BlobMaskKey key(blobID, matrix, paint);
+    if (!CHECK_LOCAL(localCache, find, Find, key, BlobMaskRec::Visitor, &result)) {
+        return NULL;
+    }
+
+    *mask = result.fMask;
+    mask->fImage = (uint8_t*)(result.fData->data());
+    return result.fData;
+}
+
+void SkTextBlobMaskCache::Add(uint32_t blobID, const SkMatrix& matrix, const SkPaint& paint,
+                              const SkMask& mask, SkCachedData* data,
+                              SkResourceCache* localCache) {
+    BlobMaskKey key(blobID, matrix, paint);
+    return CHECK_LOCAL(localCache, add, Add, SkNEW_ARGS(BlobMaskRec, (key, mask, data)));
+}
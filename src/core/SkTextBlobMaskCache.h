@@ -0,0 +1,55 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTextBlobMaskCache_DEFINED
+#define SkTextBlobMaskCache_DEFINED
+
+#include "SkCachedData.h"
+#include "SkMask.h"
+#include "SkMatrix.h"
+#include "SkPaint.h"
+#include "SkResourceCache.h"
+
+class SkTextBlob;
+
+/**
+ *  Caches the composited A8 mask for an entire text blob, so the raster path
+ *  can blit a repeated blob directly instead of re-rasterizing every glyph on
+ *  every draw. Entries are keyed on the blob's uniqueID, the 2x2 part of the
+ *  matrix plus the fractional translation, and the mask-affecting paint state;
+ *  one entry therefore serves every integer translation of the same blob.
+ *
+ *  The mask's bounds are stored relative to the fractional translation; the
+ *  caller re-applies the integer translation before blitting.
+ */
+class SkTextBlobMaskCache {
+public:
+    /**
+     *  True if the blob/matrix/paint combination is one the cache can
+     *  represent: no perspective, a fill paint without geometry or mask
+     *  effects, non-LCD text, and device bounds under the cache's size
+     *  threshold.
+     */
+    static bool IsCacheable(const SkTextBlob* blob, const SkMatrix& matrix, const SkPaint& paint);
+
+    /**
+     *  On success, return a ref to the SkCachedData that holds the pixels, and
+     *  have mask already point to that memory.
+     *
+     *  On failure, return NULL.
+     */
+    static SkCachedData* FindAndRef(uint32_t blobID, const SkMatrix& matrix, const SkPaint& paint,
+                                    SkMask* mask, SkResourceCache* localCache = NULL);
+
+    /**
+     *  Add a mask and its pixel-data to the cache.
+     */
+    static void Add(uint32_t blobID, const SkMatrix& matrix, const SkPaint& paint,
+                    const SkMask& mask, SkCachedData* data, SkResourceCache* localCache = NULL);
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkThreadArena.h"
+#include "SkTLS.h"
+
+// Sized for the pathops/edge-builder common case; the arena grows (and the
+// grown block survives rewind) if a caller needs more.
+static const size_t kThreadArenaMinSize = 16 * 1024;
+
+namespace {
+
+struct ThreadArena {
+    ThreadArena() : fAlloc(kThreadArenaMinSize), fInUse(false) {}
+
+    SkChunkAlloc fAlloc;
+    bool         fInUse;
+};
+
+}  // namespace
+
+static void* create_thread_arena() {
+    return SkNEW(ThreadArena);
+}
+
+static void delete_thread_arena(void* ptr) {
+    SkDELETE((ThreadArena*)ptr);
+}
+
+SkAutoThreadArena::SkAutoThreadArena(size_t minSize) {
+    ThreadArena* arena = (ThreadArena*)SkTLS::Get(create_thread_arena, delete_thread_arena);
+    if (arena && !arena->fInUse) {
+        arena->fInUse = true;
+        fAlloc = &arena->fAlloc;
+        fBorrowed = true;
+    } else {
+        fAlloc = SkNEW_ARGS(SkChunkAlloc, (minSize));
+        fBorrowed = false;
+    }
+}
+
+SkAutoThreadArena::~SkAutoThreadArena() {
+    if (fBorrowed) {
+        fAlloc->rewind();
+        ThreadArena* arena = (ThreadArena*)SkTLS::Find(create_thread_arena);
+        SkASSERT(arena && &arena->fAlloc == fAlloc);
+        arena->fInUse = false;
+    } else {
+        SkDELETE(fAlloc);
+    }
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkThreadArena_DEFINED
+#define SkThreadArena_DEFINED
+
+#include "SkChunkAlloc.h"
+
+/**
+ *  Borrows the calling thread's scratch SkChunkAlloc for the scope of the
+ *  object. Transient geometry work (pathops, edge building) used to build a
+ *  fresh allocator per call and free it at the end; borrowing a per-thread
+ *  arena and rewind()ing it on release keeps the block warm, so steady-state
+ *  work does no malloc at all.
+ *
+ *  If the thread's arena is already borrowed (nested use), a private
+ *  allocator is created instead, so borrowers never have to care.
+ */
+class SkAutoThreadArena : SkNoncopyable {
+public:
+    /** minSize is only used if a private allocator has to be created. */
+    SkAutoThreadArena(size_t minSize);
+    ~SkAutoThreadArena();
+
+    SkChunkAlloc* get() const { return fAlloc; }
+    SkChunkAlloc& operator*() const { return *fAlloc; }
+    SkChunkAlloc* operator->() const { return fAlloc; }
+
+private:
+    SkChunkAlloc* fAlloc;
+    bool          fBorrowed;
+};
+
+#endif
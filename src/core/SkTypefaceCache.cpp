@@ -8,11 +8,37 @@
 
 
 
+#include "SkAtomics.h"
+#include "SkSpinlock.h"
 #include "SkTypefaceCache.h"
 #include "SkThread.h"
 
 #define TYPEFACE_CACHE_LIMIT    1024
 
+/**
+ *  An immutable copy of the cache contents, published for lock-free lookup.
+ *  The snapshot owns a ref on each face, so a face found in a snapshot is
+ *  alive even if the cache purges it concurrently.
+ */
+struct SkTypefaceCache::Snapshot {
+    explicit Snapshot(const SkTDArray<Rec>& recs) : fRecs(recs) {
+        for (int i = 0; i < fRecs.count(); ++i) {
+            fRecs[i].fFace->ref();
+        }
+    }
+    ~Snapshot() {
+        for (int i = 0; i < fRecs.count(); ++i) {
+            fRecs[i].fFace->unref();
+        }
+    }
+
+    SkTDArray<Rec> fRecs;
+};
+
+SkTypefaceCache::Snapshot* SkTypefaceCache::gSnapshot = NULL;
+int32_t SkTypefaceCache::gSnapshotEpoch = 0;
+int32_t SkTypefaceCache::gSnapshotReaders[2] = { 0, 0 };
+
 SkTypefaceCache::SkTypefaceCache() {}
 
 SkTypefaceCache::~SkTypefaceCache() {
@@ -69,6 +95,32 @@ void SkTypefaceCache::purgeAll() {
     this->purge(fArray.count());
 }
 
+void SkTypefaceCache::publishSnapshot() {
+    Snapshot* oldSnapshot = gSnapshot;
+    const int32_t oldEpoch = gSnapshotEpoch;
+
+    // Publish the new snapshot, then open the new epoch. A reader that pinned
+    // the old epoch may observe either snapshot; both are protected, because
+    // neither can be reclaimed before this publish (and so the old epoch)
+    // completes, and the write lock keeps other writers out until then.
+    sk_release_store(&gSnapshot, SkNEW_ARGS(Snapshot, (fArray)));
+
+    // The epoch must be published with a full (seq_cst) barrier between it and
+    // the reader-count loads below. With only release/acquire, this store could
+    // still sit in the store buffer while we read a count of 0, at the same
+    // time as a reader pins the old epoch and re-reads the epoch as still
+    // current -- letting both sides proceed and us reclaim a snapshot in use.
+    // The seq_cst RMW mirrors the reader's seq_cst pin increment.
+    SkDEBUGCODE(int32_t prevEpoch =) sk_atomic_inc(&gSnapshotEpoch);
+    SkASSERT(prevEpoch == oldEpoch);
+
+    // Wait for readers still pinning the old epoch to drain, then reclaim.
+    // Readers only scan a small array, so this spin is short.
+    while (sk_atomic_load(&gSnapshotReaders[oldEpoch & 1], sk_memory_order_seq_cst) != 0) {
+    }
+    SkDELETE(oldSnapshot);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 SkTypefaceCache& SkTypefaceCache::Get() {
@@ -81,22 +133,53 @@ SkFontID SkTypefaceCache::NewFontID() {
     return sk_atomic_inc(&gFontID) + 1;
 }
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
+// Writers are rare and hold the lock only to update fArray and swap in a new snapshot, so a
+// spinlock keeps the occasional writer/writer overlap off the futex path entirely.
+SK_DECLARE_STATIC_SPINLOCK(gWriteLock);
 
 void SkTypefaceCache::Add(SkTypeface* face, const SkFontStyle& requestedStyle) {
-    SkAutoMutexAcquire ama(gMutex);
+    SkAutoSpinlock lock(gWriteLock);
     Get().add(face, requestedStyle);
+    Get().publishSnapshot();
 }
 
 SkTypeface* SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
-    SkAutoMutexAcquire ama(gMutex);
-    SkTypeface* typeface = Get().findByProcAndRef(proc, ctx);
-    return typeface;
+    for (;;) {
+        // Pin the current epoch, then make sure no publish slipped in between
+        // reading the epoch and pinning it. Once the pin is validated, any
+        // snapshot we load stays alive until we unpin: a writer reclaims a
+        // snapshot only after the epoch it served has drained, and the write
+        // lock keeps a second writer out while the first is waiting on us.
+        const int32_t epoch = sk_acquire_load(&gSnapshotEpoch);
+        sk_atomic_inc(&gSnapshotReaders[epoch & 1]);
+        // seq_cst to pair with the writer's seq_cst epoch publication; see
+        // publishSnapshot() for why release/acquire is not enough here.
+        if (sk_atomic_load(&gSnapshotEpoch, sk_memory_order_seq_cst) != epoch) {
+            // Raced with a publish; drop the stale pin and retry.
+            sk_atomic_dec(&gSnapshotReaders[epoch & 1]);
+            continue;
+        }
+
+        SkTypeface* typeface = NULL;
+        const Snapshot* snapshot = sk_acquire_load(&gSnapshot);
+        if (snapshot) {
+            for (int i = 0; i < snapshot->fRecs.count(); ++i) {
+                const Rec& rec = snapshot->fRecs[i];
+                if (proc(rec.fFace, rec.fRequestedStyle, ctx)) {
+                    typeface = SkRef(rec.fFace);
+                    break;
+                }
+            }
+        }
+        sk_atomic_dec(&gSnapshotReaders[epoch & 1]);
+        return typeface;
+    }
 }
 
 void SkTypefaceCache::PurgeAll() {
-    SkAutoMutexAcquire ama(gMutex);
+    SkAutoSpinlock lock(gWriteLock);
     Get().purgeAll();
+    Get().publishSnapshot();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -111,7 +194,7 @@ static bool DumpProc(SkTypeface* face, const SkFontStyle& s, void* ctx) {
 
 void SkTypefaceCache::Dump() {
 #ifdef SK_DEBUG
-    SkAutoMutexAcquire ama(gMutex);
+    SkAutoSpinlock lock(gWriteLock);
     (void)Get().findByProcAndRef(DumpProc, NULL);
 #endif
 }
@@ -63,6 +63,10 @@ public:
     static SkFontID NewFontID();
 
     // These are static wrappers around a global instance of a cache.
+    //
+    // FindByProcAndRef does not take the cache mutex: it scans an immutable
+    // snapshot of the cache published by Add/PurgeAll, protected by an epoch
+    // ticket, so concurrent lookups never serialize against each other.
 
     static void Add(SkTypeface*, const SkFontStyle& requested);
     static SkTypeface* FindByProcAndRef(FindProc proc, void* ctx);
@@ -83,6 +87,18 @@ private:
         SkFontStyle fRequestedStyle;
     };
     SkTDArray<Rec> fArray;
+
+    // Lock-free lookup support for the global cache. Writers (the static
+    // Add/PurgeAll wrappers, holding the cache mutex) copy the contents into
+    // an immutable Snapshot and publish it; readers pin the current epoch
+    // while they scan, and a writer reclaims the old snapshot only once the
+    // old epoch's readers have drained. Only the global instance publishes.
+    struct Snapshot;
+    void publishSnapshot();
+
+    static Snapshot* gSnapshot;
+    static int32_t   gSnapshotEpoch;
+    static int32_t   gSnapshotReaders[2];
 };
 
 #endif
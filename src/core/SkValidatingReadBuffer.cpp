@@ -33,6 +33,10 @@ bool SkValidatingReadBuffer::isValid() const {
     return !fError;
 }
 
+// Structural prevalidation: the base pointer and total size are checked for 4-byte alignment
+// once, up front. Every advance after that goes through SkReader32, which only ever moves the
+// cursor by 4-aligned amounts, so cursor alignment is an invariant of the whole stream and the
+// per-field reads below need only a single availability check each (asserted in debug).
 void SkValidatingReadBuffer::setMemory(const void* data, size_t size) {
     this->validate(IsPtrAlign4(data) && (SkAlign4(size) == size));
     if (!fError) {
@@ -43,7 +47,8 @@ void SkValidatingReadBuffer::setMemory(const void* data, size_t size) {
 const void* SkValidatingReadBuffer::skip(size_t size) {
     size_t inc = SkAlign4(size);
     const void* addr = fReader.peek();
-    this->validate(IsPtrAlign4(addr) && fReader.isAvailable(inc));
+    SkASSERT(IsPtrAlign4(addr));
+    this->validate(fReader.isAvailable(inc));
     if (!fError) {
         fReader.skip(size);
     }
@@ -72,13 +77,15 @@ SkFixed SkValidatingReadBuffer::readFixed() {
 
 int32_t SkValidatingReadBuffer::readInt() {
     const size_t inc = sizeof(int32_t);
-    this->validate(IsPtrAlign4(fReader.peek()) && fReader.isAvailable(inc));
+    SkASSERT(IsPtrAlign4(fReader.peek()));
+    this->validate(fReader.isAvailable(inc));
     return fError ? 0 : fReader.readInt();
 }
 
 SkScalar SkValidatingReadBuffer::readScalar() {
     const size_t inc = sizeof(SkScalar);
-    this->validate(IsPtrAlign4(fReader.peek()) && fReader.isAvailable(inc));
+    SkASSERT(IsPtrAlign4(fReader.peek()));
+    this->validate(fReader.isAvailable(inc));
     return fError ? 0 : fReader.readScalar();
 }
 
@@ -120,8 +127,13 @@ void* SkValidatingReadBuffer::readEncodedString(size_t* length, SkPaint::TextEnc
 }
 
 void SkValidatingReadBuffer::readPoint(SkPoint* point) {
-    point->fX = this->readScalar();
-    point->fY = this->readScalar();
+    // One bounds check covers both scalars.
+    const void* ptr = this->skip(sizeof(SkPoint));
+    if (!fError) {
+        memcpy(point, ptr, sizeof(SkPoint));
+    } else {
+        point->set(0, 0);
+    }
 }
 
 void SkValidatingReadBuffer::readMatrix(SkMatrix* matrix) {
@@ -174,13 +186,16 @@ void SkValidatingReadBuffer::readPath(SkPath* path) {
 bool SkValidatingReadBuffer::readArray(void* value, size_t size, size_t elementSize) {
     const uint32_t count = this->getArrayCount();
     this->validate(size == count);
-    (void)this->skip(sizeof(uint32_t)); // Skip array count
     const uint64_t byteLength64 = sk_64_mul(count, elementSize);
     const size_t byteLength = count * elementSize;
-    this->validate(byteLength == byteLength64);
-    const void* ptr = this->skip(SkAlign4(byteLength));
+    // One combined check covers multiplication overflow plus the bounds of the count word
+    // and the payload together, instead of validating each skip separately.
+    const uint64_t needed64 = sizeof(uint32_t) + SkAlign4(byteLength64);
+    this->validate(byteLength == byteLength64 && needed64 <= SK_MaxU32 &&
+                   fReader.isAvailable(static_cast<size_t>(needed64)));
     if (!fError) {
-        memcpy(value, ptr, byteLength);
+        (void)fReader.skip(sizeof(uint32_t)); // Skip array count
+        memcpy(value, fReader.skip(SkAlign4(byteLength)), byteLength);
         return true;
     }
     return false;
@@ -208,7 +223,8 @@ bool SkValidatingReadBuffer::readScalarArray(SkScalar* values, size_t size) {
 
 uint32_t SkValidatingReadBuffer::getArrayCount() {
     const size_t inc = sizeof(uint32_t);
-    fError = fError || !IsPtrAlign4(fReader.peek()) || !fReader.isAvailable(inc);
+    SkASSERT(fError || IsPtrAlign4(fReader.peek()));
+    fError = fError || !fReader.isAvailable(inc);
     return fError ? 0 : *(uint32_t*)fReader.peek();
 }
 
@@ -16,12 +16,14 @@
 
 struct SkVarAlloc::Block {
     Block* prev;
+    size_t size;
     char* data() { return (char*)(this + 1); }
 
     static Block* Alloc(Block* prev, size_t size, unsigned flags) {
         SkASSERT(size >= sizeof(Block));
         Block* b = (Block*)sk_malloc_flags(size, flags);
         b->prev = prev;
+        b->size = size;
         return b;
     }
 };
@@ -49,6 +51,40 @@ SkVarAlloc::~SkVarAlloc() {
     }
 }
 
+void SkVarAlloc::rewind() {
+    if (fBlock) {
+        // Keep the most recent block.  Thanks to doubling it's at least as large as all the
+        // earlier blocks combined, so anything that fit before fits in it alone.
+        Block* doomed = fBlock->prev;
+        while (doomed) {
+            Block* prev = doomed->prev;
+            sk_free(doomed);
+            doomed = prev;
+        }
+        fBlock->prev = NULL;
+        fByte = fBlock->data();
+        fRemaining = SkToU32(fBlock->size - sizeof(Block));
+        fBytesAllocated = fBlock->size;
+        // fLgSize stays put, so if we do overflow this block we keep growing from where we left off.
+    } else {
+        // We never allocated.  We can't rewind into constructor-provided storage (we don't
+        // remember where it began), so just start over empty.
+        fByte = NULL;
+        fRemaining = 0;
+        fBytesAllocated = 0;
+    }
+}
+
+void SkVarAlloc::hint(size_t bytesHint) {
+    unsigned lg = fLgSize;
+    while (((size_t)1 << lg) < bytesHint + sizeof(Block)) {
+        lg++;
+    }
+    if (lg > fLgSize) {
+        fLgSize = lg;
+    }
+}
+
 void SkVarAlloc::makeSpace(size_t bytes, unsigned flags) {
     SkASSERT(SkIsAlignPtr(bytes));
 
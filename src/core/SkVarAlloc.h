@@ -34,6 +34,17 @@ public:
         return ptr;
     }
 
+    // Invalidates all previously alloc()ed bytes, but keeps the largest block we've
+    // allocated around for reuse.  A warmed-up SkVarAlloc that's rewound between uses
+    // of similar size settles into doing no heap allocation at all.
+    void rewind();
+
+    // Suggest that the next block we malloc be big enough to hold about bytesHint.
+    // This just seeds the doubling ramp -- a cold SkVarAlloc that knows how big its
+    // last use was can go straight to a block that size instead of ramping up to it
+    // one malloc at a time.  No-op if we've already ramped past bytesHint.
+    void hint(size_t bytesHint);
+
     // Returns our best estimate of the number of bytes we've allocated.
     // (We may not track this precisely to save space.)
     size_t approxBytesAllocated() const { return fBytesAllocated; }
@@ -12,6 +12,7 @@
 #include "SkPDFStream.h"
 #include "SkPDFTypes.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 
 static void emit_pdf_header(SkWStream* stream) {
     stream->writeText("%PDF-1.4\n%");
@@ -61,12 +62,45 @@ static void perform_font_subsetting(
     }
 }
 
-static SkPDFObject* create_pdf_page_content(const SkPDFDevice* pageDevice) {
-    SkAutoTDelete<SkStreamAsset> content(pageDevice->content());
-    return SkNEW_ARGS(SkPDFStream, (content.get()));
+// Generating a page's content stream and deflating it only touches that
+// page's SkPDFDevice, so the work for different pages can run concurrently
+// on SkTaskGroup workers.  Object numbering and emission stay serial.
+struct PageContentTask {
+    const SkPDFDevice* fDevice;
+    SkPDFStream* fContent;  // owned; created by generate_page_content()
+};
+
+static void generate_page_content(PageContentTask* task) {
+    SkAutoTDelete<SkStreamAsset> content(task->fDevice->content());
+    task->fContent = SkNEW_ARGS(SkPDFStream, (content.get()));
+    task->fContent->deflateData();
 }
 
-static SkPDFDict* create_pdf_page(const SkPDFDevice* pageDevice) {
+namespace {
+// Stands in for an object that has already been written to the output in
+// streaming mode; page dictionaries emit indirect references to it, but its
+// body must never be needed again.
+class PDFStreamedStub : public SkPDFObject {
+public:
+    void emitObject(SkWStream*,
+                    const SkPDFObjNumMap&,
+                    const SkPDFSubstituteMap&) override {
+        SkDEBUGFAIL("streamed object emitted twice");
+    }
+};
+}  // namespace
+
+// State accumulated by the streaming mode: one stub per page content stream
+// already written to the output, plus where each landed.
+struct StreamedPages {
+    StreamedPages() : fBaseOffset(0) {}
+    SkTDArray<SkPDFObject*> fContents;  // owned by SkDocument_PDF
+    SkTDArray<int32_t> fOffsets;        // offsets relative to fBaseOffset
+    size_t fBaseOffset;                 // stream position of the PDF header
+};
+
+static SkPDFDict* create_pdf_page(const SkPDFDevice* pageDevice,
+                                  SkPDFObject* content) {
     SkAutoTUnref<SkPDFDict> page(SkNEW_ARGS(SkPDFDict, ("Page")));
     page->insertObject("Resources", pageDevice->createResourceDict());
     page->insertObject("MediaBox", pageDevice->copyMediaBox());
@@ -74,7 +108,7 @@ static SkPDFDict* create_pdf_page(const SkPDFDevice* pageDevice) {
         SkASSERT(annots->size() > 0);
         page->insertObject("Annots", SkRef(annots));
     }
-    page->insertObjRef("Contents", create_pdf_page_content(pageDevice));
+    page->insertObjRef("Contents", content);  // Transfers ownership.
     return page.detach();
 }
 
@@ -156,19 +190,38 @@ static void generate_page_tree(const SkTDArray<SkPDFDict*>& pages,
 }
 
 static bool emit_pdf_document(const SkTDArray<const SkPDFDevice*>& pageDevices,
-                              SkWStream* stream) {
+                              SkWStream* stream,
+                              const StreamedPages* streamedPages) {
     if (pageDevices.isEmpty()) {
         return false;
     }
 
+    // Generate and compress every page's content stream in parallel.  Each
+    // task only reads its own device, so no synchronization is needed beyond
+    // the final wait() (SkTaskGroup::~SkTaskGroup).  In streaming mode the
+    // content streams have already been written out, page by page.
+    SkTDArray<PageContentTask> contentTasks;
+    if (!streamedPages) {
+        contentTasks.setCount(pageDevices.count());
+        SkTaskGroup tg;
+        for (int i = 0; i < pageDevices.count(); i++) {
+            SkASSERT(pageDevices[i]);
+            SkASSERT(i == 0 ||
+                     pageDevices[i - 1]->getCanon() == pageDevices[i]->getCanon());
+            contentTasks[i].fDevice = pageDevices[i];
+            contentTasks[i].fContent = NULL;
+            tg.add(generate_page_content, &contentTasks[i]);
+        }
+    }
+
     SkTDArray<SkPDFDict*> pages;
     SkAutoTUnref<SkPDFDict> dests(SkNEW(SkPDFDict));
 
     for (int i = 0; i < pageDevices.count(); i++) {
-        SkASSERT(pageDevices[i]);
-        SkASSERT(i == 0 ||
-                 pageDevices[i - 1]->getCanon() == pageDevices[i]->getCanon());
-        SkAutoTUnref<SkPDFDict> page(create_pdf_page(pageDevices[i]));
+        SkPDFObject* content = streamedPages
+                ? SkRef(streamedPages->fContents[i])
+                : (SkPDFObject*)contentTasks[i].fContent;
+        SkAutoTUnref<SkPDFDict> page(create_pdf_page(pageDevices[i], content));
         pageDevices[i]->appendDestinations(dests, page.get());
         pages.push(page.detach());
     }
@@ -198,13 +251,28 @@ static bool emit_pdf_document(const SkTDArray<const SkPDFDevice*>& pageDevices,
     perform_font_subsetting(pageDevices, &substitutes);
 
     SkPDFObjNumMap objNumMap;
+    int streamedObjectCount = 0;
+    SkTDArray<int32_t> offsets;
+    if (streamedPages) {
+        // The content streams were already written, in order, as objects
+        // 1..N; register them first so the close-time numbering agrees.
+        for (int i = 0; i < streamedPages->fContents.count(); ++i) {
+            SkAssertResult(objNumMap.addObject(streamedPages->fContents[i]));
+        }
+        streamedObjectCount = streamedPages->fContents.count();
+        offsets = streamedPages->fOffsets;
+    }
     if (objNumMap.addObject(docCatalog.get())) {
         docCatalog->addResources(&objNumMap, substitutes);
     }
-    size_t baseOffset = SkToOffT(stream->bytesWritten());
-    emit_pdf_header(stream);
-    SkTDArray<int32_t> offsets;
-    for (int i = 0; i < objNumMap.objects().count(); ++i) {
+    size_t baseOffset;
+    if (streamedPages) {
+        baseOffset = streamedPages->fBaseOffset;  // header already emitted
+    } else {
+        baseOffset = SkToOffT(stream->bytesWritten());
+        emit_pdf_header(stream);
+    }
+    for (int i = streamedObjectCount; i < objNumMap.objects().count(); ++i) {
         SkPDFObject* object = objNumMap.objects()[i];
         offsets.push(SkToS32(stream->bytesWritten() - baseOffset));
         SkASSERT(object == substitutes.getSubstitute(object));
@@ -286,9 +354,12 @@ class SkDocument_PDF : public SkDocument {
 public:
     SkDocument_PDF(SkWStream* stream,
                    void (*doneProc)(SkWStream*, bool),
-                   SkScalar rasterDpi)
+                   SkScalar rasterDpi,
+                   bool streamPages)
         : SkDocument(stream, doneProc)
-        , fRasterDpi(rasterDpi) {}
+        , fActiveDevice(NULL)
+        , fRasterDpi(rasterDpi)
+        , fStreamPages(streamPages) {}
 
     virtual ~SkDocument_PDF() {
         // subclasses must call close() in their destructors
@@ -305,6 +376,7 @@ protected:
         SkAutoTUnref<SkPDFDevice> device(
                 SkPDFDevice::Create(pageSize, fRasterDpi, &fCanon));
         fCanvas.reset(SkNEW_ARGS(SkCanvas, (device.get())));
+        fActiveDevice = device.get();
         fPageDevices.push(device.detach());
         fCanvas->clipRect(trimBox);
         fCanvas->translate(trimBox.x(), trimBox.y());
@@ -315,33 +387,76 @@ protected:
         SkASSERT(fCanvas.get());
         fCanvas->flush();
         fCanvas.reset(NULL);
+        if (fStreamPages) {
+            this->streamPageContent();
+        }
+        fActiveDevice = NULL;
     }
 
     bool onClose(SkWStream* stream) override {
         SkASSERT(!fCanvas.get());
 
-        bool success = emit_pdf_document(fPageDevices, stream);
-        fPageDevices.unrefAll();
-        fCanon.reset();
+        bool success = emit_pdf_document(fPageDevices, stream,
+                                         fStreamPages ? &fStreamed : NULL);
+        this->reset();
         return success;
     }
 
     void onAbort() override {
+        this->reset();
+    }
+
+private:
+    // Write the page's content stream to the output now and keep only a
+    // numbered stub for the page dictionary to reference, so the content's
+    // memory can be reclaimed.  Shared resources stay in the canon until
+    // close().
+    void streamPageContent() {
+        SkWStream* stream = this->getStream();
+        if (0 == fStreamed.fContents.count()) {
+            fStreamed.fBaseOffset = SkToOffT(stream->bytesWritten());
+            emit_pdf_header(stream);
+        }
+        SkAutoTDelete<SkStreamAsset> pageContent(fActiveDevice->content());
+        SkAutoTUnref<SkPDFStream> content(
+                SkNEW_ARGS(SkPDFStream, (pageContent.get())));
+        content->deflateData();
+        fActiveDevice->dropContent();
+
+        fStreamed.fOffsets.push(
+                SkToS32(stream->bytesWritten() - fStreamed.fBaseOffset));
+        stream->writeDecAsText(fStreamed.fContents.count() + 1);
+        stream->writeText(" 0 obj\n");  // Generation number is always 0.
+        SkPDFObjNumMap emptyNumMap;
+        SkPDFSubstituteMap emptySubstitutes;
+        content->emitObject(stream, emptyNumMap, emptySubstitutes);
+        stream->writeText("\nendobj\n");
+
+        fStreamed.fContents.push(SkNEW(PDFStreamedStub));
+    }
+
+    void reset() {
         fPageDevices.unrefAll();
+        fStreamed.fContents.unrefAll();
+        fStreamed.fContents.rewind();
+        fStreamed.fOffsets.rewind();
         fCanon.reset();
     }
 
-private:
     SkPDFCanon fCanon;
     SkTDArray<const SkPDFDevice*> fPageDevices;
     SkAutoTUnref<SkCanvas> fCanvas;
+    SkPDFDevice* fActiveDevice;  // borrowed; owned by fPageDevices
     SkScalar fRasterDpi;
+    const bool fStreamPages;
+    StreamedPages fStreamed;
 };
 }  // namespace
 ///////////////////////////////////////////////////////////////////////////////
 
 SkDocument* SkDocument::CreatePDF(SkWStream* stream, SkScalar dpi) {
-    return stream ? SkNEW_ARGS(SkDocument_PDF, (stream, NULL, dpi)) : NULL;
+    return stream ? SkNEW_ARGS(SkDocument_PDF, (stream, NULL, dpi, false))
+                  : NULL;
 }
 
 SkDocument* SkDocument::CreatePDF(const char path[], SkScalar dpi) {
@@ -351,5 +466,10 @@ SkDocument* SkDocument::CreatePDF(const char path[], SkScalar dpi) {
         return NULL;
     }
     auto delete_wstream = [](SkWStream* stream, bool) { SkDELETE(stream); };
-    return SkNEW_ARGS(SkDocument_PDF, (stream, delete_wstream, dpi));
+    return SkNEW_ARGS(SkDocument_PDF, (stream, delete_wstream, dpi, false));
+}
+
+SkDocument* SkDocument::CreateStreamingPDF(SkWStream* stream, SkScalar dpi) {
+    return stream ? SkNEW_ARGS(SkDocument_PDF, (stream, NULL, dpi, true))
+                  : NULL;
 }
@@ -12,6 +12,8 @@
 #include "SkWriteBuffer.h"
 #include "SkGpuBlurUtils.h"
 #include "SkBlurImage_opts.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
 #endif
@@ -76,11 +78,12 @@ enum BlurDirection {
 
 template<BlurDirection srcDirection, BlurDirection dstDirection>
 static void boxBlur(const SkPMColor* src, int srcStride, SkPMColor* dst, int kernelSize,
-                    int leftOffset, int rightOffset, int width, int height)
+                    int leftOffset, int rightOffset, int width, int height,
+                    int transposedStride)
 {
     int rightBorder = SkMin32(rightOffset + 1, width);
     int srcStrideX = srcDirection == kX ? 1 : srcStride;
-    int dstStrideX = dstDirection == kX ? 1 : height;
+    int dstStrideX = dstDirection == kX ? 1 : transposedStride;
     int srcStrideY = srcDirection == kX ? srcStride : 1;
     int dstStrideY = dstDirection == kX ? width : 1;
     uint32_t scale = (1 << 24) / kernelSize;
@@ -128,6 +131,71 @@ static void boxBlur(const SkPMColor* src, int srcStride, SkPMColor* dst, int ker
     }
 }
 
+namespace {
+
+struct BoxBlurChunk {
+    SkBoxBlurProc    fProc;
+    const SkPMColor* fSrc;
+    int              fSrcStride;
+    SkPMColor*       fDst;
+    int              fKernelSize;
+    int              fLeftOffset;
+    int              fRightOffset;
+    int              fWidth;
+    int              fRows;
+    int              fTransposedStride;
+};
+
+} // namespace
+
+static void run_box_blur_chunk(BoxBlurChunk* chunk) {
+    chunk->fProc(chunk->fSrc, chunk->fSrcStride, chunk->fDst, chunk->fKernelSize,
+                 chunk->fLeftOffset, chunk->fRightOffset, chunk->fWidth, chunk->fRows,
+                 chunk->fTransposedStride);
+}
+
+/**
+ * Carves one box blur pass into contiguous row chunks and hands them to an
+ * SkTaskGroup.  Every row of a pass is independent of the others, so the
+ * chunks can run in parallel; without an SkTaskGroup::Enabler this degrades
+ * to running them in sequence on the calling thread.  srcRowStride and
+ * dstRowStride step a whole blur row in each buffer; transposedStride is the
+ * full-pass column stride that transposing procs use, which must not shrink
+ * with the chunk's row count.
+ */
+static void run_box_blur_pass(SkBoxBlurProc proc, const SkPMColor* src, int srcStride,
+                              int srcRowStride, SkPMColor* dst, int dstRowStride,
+                              int kernelSize, int leftOffset, int rightOffset,
+                              int width, int height, int transposedStride) {
+    // Below this many rows per chunk the task overhead outweighs the win.
+    const int kMinRowsPerChunk = 64;
+    const int kMaxChunks = 16;
+    int chunkCount = SkMin32(height / kMinRowsPerChunk, kMaxChunks);
+    if (chunkCount <= 1) {
+        proc(src, srcStride, dst, kernelSize, leftOffset, rightOffset, width, height,
+             transposedStride);
+        return;
+    }
+
+    SkAutoSTMalloc<kMaxChunks, BoxBlurChunk> chunks(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        int rowStart = height * i / chunkCount;
+        int rowStop = height * (i + 1) / chunkCount;
+        BoxBlurChunk* chunk = &chunks[i];
+        chunk->fProc = proc;
+        chunk->fSrc = src + rowStart * srcRowStride;
+        chunk->fSrcStride = srcStride;
+        chunk->fDst = dst + rowStart * dstRowStride;
+        chunk->fKernelSize = kernelSize;
+        chunk->fLeftOffset = leftOffset;
+        chunk->fRightOffset = rightOffset;
+        chunk->fWidth = width;
+        chunk->fRows = rowStop - rowStart;
+        chunk->fTransposedStride = transposedStride;
+    }
+    SkTaskGroup().batch(run_box_blur_chunk, chunks.get(), chunkCount);
+}
+
 static void getBox3Params(SkScalar s, int *kernelSize, int* kernelSize3, int *lowOffset,
                           int *highOffset)
 {
@@ -210,21 +278,36 @@ bool SkBlurImageFilter::onFilterImage(Proxy* proxy,
         boxBlurYX = boxBlur<kY, kX>;
     }
 
+    // The row stride arguments below step a whole blur row: the source stride
+    // for reads along X, 1 for reads along Y (the rows are adjacent columns),
+    // the pass width for writes along X, and 1 for transposed writes.
     if (kernelSizeX > 0 && kernelSizeY > 0) {
-        boxBlurX(s,  sw, t, kernelSizeX,  lowOffsetX,  highOffsetX, w, h);
-        boxBlurX(t,  w,  d, kernelSizeX,  highOffsetX, lowOffsetX,  w, h);
-        boxBlurXY(d, w,  t, kernelSizeX3, highOffsetX, highOffsetX, w, h);
-        boxBlurX(t,  h,  d, kernelSizeY,  lowOffsetY,  highOffsetY, h, w);
-        boxBlurX(d,  h,  t, kernelSizeY,  highOffsetY, lowOffsetY,  h, w);
-        boxBlurXY(t, h,  d, kernelSizeY3, highOffsetY, highOffsetY, h, w);
+        run_box_blur_pass(boxBlurX,  s, sw, sw, t, w, kernelSizeX,  lowOffsetX,  highOffsetX,
+                          w, h, h);
+        run_box_blur_pass(boxBlurX,  t, w,  w,  d, w, kernelSizeX,  highOffsetX, lowOffsetX,
+                          w, h, h);
+        run_box_blur_pass(boxBlurXY, d, w,  w,  t, 1, kernelSizeX3, highOffsetX, highOffsetX,
+                          w, h, h);
+        run_box_blur_pass(boxBlurX,  t, h,  h,  d, h, kernelSizeY,  lowOffsetY,  highOffsetY,
+                          h, w, w);
+        run_box_blur_pass(boxBlurX,  d, h,  h,  t, h, kernelSizeY,  highOffsetY, lowOffsetY,
+                          h, w, w);
+        run_box_blur_pass(boxBlurXY, t, h,  h,  d, 1, kernelSizeY3, highOffsetY, highOffsetY,
+                          h, w, w);
     } else if (kernelSizeX > 0) {
-        boxBlurX(s,  sw, d, kernelSizeX,  lowOffsetX,  highOffsetX, w, h);
-        boxBlurX(d,  w,  t, kernelSizeX,  highOffsetX, lowOffsetX,  w, h);
-        boxBlurX(t,  w,  d, kernelSizeX3, highOffsetX, highOffsetX, w, h);
+        run_box_blur_pass(boxBlurX,  s, sw, sw, d, w, kernelSizeX,  lowOffsetX,  highOffsetX,
+                          w, h, h);
+        run_box_blur_pass(boxBlurX,  d, w,  w,  t, w, kernelSizeX,  highOffsetX, lowOffsetX,
+                          w, h, h);
+        run_box_blur_pass(boxBlurX,  t, w,  w,  d, w, kernelSizeX3, highOffsetX, highOffsetX,
+                          w, h, h);
     } else if (kernelSizeY > 0) {
-        boxBlurYX(s, sw, d, kernelSizeY,  lowOffsetY,  highOffsetY, h, w);
-        boxBlurX(d,  h,  t, kernelSizeY,  highOffsetY, lowOffsetY,  h, w);
-        boxBlurXY(t, h,  d, kernelSizeY3, highOffsetY, highOffsetY, h, w);
+        run_box_blur_pass(boxBlurYX, s, sw, 1,  d, h, kernelSizeY,  lowOffsetY,  highOffsetY,
+                          h, w, w);
+        run_box_blur_pass(boxBlurX,  d, h,  h,  t, h, kernelSizeY,  highOffsetY, lowOffsetY,
+                          h, w, w);
+        run_box_blur_pass(boxBlurXY, t, h,  h,  d, 1, kernelSizeY3, highOffsetY, highOffsetY,
+                          h, w, w);
     }
     return true;
 }
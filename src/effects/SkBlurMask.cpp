@@ -9,6 +9,7 @@
 
 #include "SkBlurMask.h"
 #include "SkMath.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkEndian.h"
 
@@ -32,12 +33,39 @@ SkScalar SkBlurMask::ConvertSigmaToRadius(SkScalar sigma) {
 
 #define UNROLL_SEPARABLE_LOOPS
 
+namespace {
+
+// One contiguous run of box blur rows, handed to an SkTaskGroup so the rows of
+// a pass can run in parallel.  fLeftRadius doubles as the single radius of the
+// interpolating blur, which ignores fRightRadius; fOuterWeight is only used by
+// the interpolating blur.
+struct BoxBlurChunk {
+    const uint8_t* fSrc;
+    int            fSrcYStride;
+    uint8_t*       fDst;
+    int            fLeftRadius;
+    int            fRightRadius;
+    uint8_t        fOuterWeight;
+    int            fWidth;
+    int            fYStart;
+    int            fYStop;
+    int            fDstXStride;
+    int            fDstYStride;
+};
+
+// Below this many rows per chunk the task overhead outweighs the win.
+static const int kMinBlurRowsPerChunk = 128;
+static const int kMaxBlurChunks = 16;
+
+} // namespace
+
 /**
- * This function performs a box blur in X, of the given radius.  If the
- * "transpose" parameter is true, it will transpose the pixels on write,
- * such that X and Y are swapped. Reads are always performed from contiguous
- * memory in X, for speed. The destination buffer (dst) must be at least
- * (width + leftRadius + rightRadius) * height bytes in size.
+ * This function performs a box blur in X, of the given radius, over the rows
+ * [yStart, yStop).  The destination strides are chosen by the boxBlur()
+ * driver below: with a transposing stride pair it will transpose the pixels
+ * on write, such that X and Y are swapped. Reads are always performed from
+ * contiguous memory in X, for speed. The destination buffer (dst) must be at
+ * least (width + leftRadius + rightRadius) * height bytes in size.
  *
  * This is what the inner loop looks like before unrolling, and with the two
  * cases broken out separately (width < diameter, width >= diameter):
@@ -76,19 +104,16 @@ SkScalar SkBlurMask::ConvertSigmaToRadius(SkScalar sigma) {
  *          }
  *      }
  */
-static int boxBlur(const uint8_t* src, int src_y_stride, uint8_t* dst,
-                   int leftRadius, int rightRadius, int width, int height,
-                   bool transpose)
+static void boxBlurRows(const uint8_t* src, int src_y_stride, uint8_t* dst,
+                        int leftRadius, int rightRadius, int width,
+                        int yStart, int yStop, int dst_x_stride, int dst_y_stride)
 {
     int diameter = leftRadius + rightRadius;
     int kernelSize = diameter + 1;
     int border = SkMin32(width, diameter);
     uint32_t scale = (1 << 24) / kernelSize;
-    int new_width = width + SkMax32(leftRadius, rightRadius) * 2;
-    int dst_x_stride = transpose ? height : 1;
-    int dst_y_stride = transpose ? 1 : new_width;
     uint32_t half = 1 << 23;
-    for (int y = 0; y < height; ++y) {
+    for (int y = yStart; y < yStop; ++y) {
         uint32_t sum = 0;
         uint8_t* dptr = dst + y * dst_y_stride;
         const uint8_t* right = src + y * src_y_stride;
@@ -222,6 +247,43 @@ static int boxBlur(const uint8_t* src, int src_y_stride, uint8_t* dst,
         }
         SkASSERT(sum == 0);
     }
+}
+
+static void run_box_blur_chunk(BoxBlurChunk* chunk) {
+    boxBlurRows(chunk->fSrc, chunk->fSrcYStride, chunk->fDst,
+                chunk->fLeftRadius, chunk->fRightRadius, chunk->fWidth,
+                chunk->fYStart, chunk->fYStop, chunk->fDstXStride, chunk->fDstYStride);
+}
+
+static int boxBlur(const uint8_t* src, int src_y_stride, uint8_t* dst,
+                   int leftRadius, int rightRadius, int width, int height,
+                   bool transpose)
+{
+    int new_width = width + SkMax32(leftRadius, rightRadius) * 2;
+    int dst_x_stride = transpose ? height : 1;
+    int dst_y_stride = transpose ? 1 : new_width;
+    int chunkCount = SkMin32(height / kMinBlurRowsPerChunk, kMaxBlurChunks);
+    if (chunkCount <= 1) {
+        boxBlurRows(src, src_y_stride, dst, leftRadius, rightRadius, width,
+                    0, height, dst_x_stride, dst_y_stride);
+        return new_width;
+    }
+
+    SkAutoSTMalloc<kMaxBlurChunks, BoxBlurChunk> chunks(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        BoxBlurChunk* chunk = &chunks[i];
+        chunk->fSrc = src;
+        chunk->fSrcYStride = src_y_stride;
+        chunk->fDst = dst;
+        chunk->fLeftRadius = leftRadius;
+        chunk->fRightRadius = rightRadius;
+        chunk->fWidth = width;
+        chunk->fYStart = height * i / chunkCount;
+        chunk->fYStop = height * (i + 1) / chunkCount;
+        chunk->fDstXStride = dst_x_stride;
+        chunk->fDstYStride = dst_y_stride;
+    }
+    SkTaskGroup().batch(run_box_blur_chunk, chunks.get(), chunkCount);
     return new_width;
 }
 
@@ -278,9 +340,9 @@ static int boxBlur(const uint8_t* src, int src_y_stride, uint8_t* dst,
  *  return new_width;
  */
 
-static int boxBlurInterp(const uint8_t* src, int src_y_stride, uint8_t* dst,
-                         int radius, int width, int height,
-                         bool transpose, uint8_t outer_weight)
+static void boxBlurInterpRows(const uint8_t* src, int src_y_stride, uint8_t* dst,
+                              int radius, int width, uint8_t outer_weight,
+                              int yStart, int yStop, int dst_x_stride, int dst_y_stride)
 {
     int diameter = radius * 2;
     int kernelSize = diameter + 1;
@@ -291,10 +353,7 @@ static int boxBlurInterp(const uint8_t* src, int src_y_stride, uint8_t* dst,
     uint32_t outer_scale = (outer_weight << 16) / kernelSize;
     uint32_t inner_scale = (inner_weight << 16) / (kernelSize - 2);
     uint32_t half = 1 << 23;
-    int new_width = width + diameter;
-    int dst_x_stride = transpose ? height : 1;
-    int dst_y_stride = transpose ? 1 : new_width;
-    for (int y = 0; y < height; ++y) {
+    for (int y = yStart; y < yStop; ++y) {
         uint32_t outer_sum = 0, inner_sum = 0;
         uint8_t* dptr = dst + y * dst_y_stride;
         const uint8_t* right = src + y * src_y_stride;
@@ -403,6 +462,44 @@ static int boxBlurInterp(const uint8_t* src, int src_y_stride, uint8_t* dst,
 #undef RIGHT_BORDER_ITER
         SkASSERT(outer_sum == 0 && inner_sum == 0);
     }
+}
+
+static void run_box_blur_interp_chunk(BoxBlurChunk* chunk) {
+    boxBlurInterpRows(chunk->fSrc, chunk->fSrcYStride, chunk->fDst,
+                      chunk->fLeftRadius, chunk->fWidth, chunk->fOuterWeight,
+                      chunk->fYStart, chunk->fYStop, chunk->fDstXStride, chunk->fDstYStride);
+}
+
+static int boxBlurInterp(const uint8_t* src, int src_y_stride, uint8_t* dst,
+                         int radius, int width, int height,
+                         bool transpose, uint8_t outer_weight)
+{
+    int new_width = width + radius * 2;
+    int dst_x_stride = transpose ? height : 1;
+    int dst_y_stride = transpose ? 1 : new_width;
+    int chunkCount = SkMin32(height / kMinBlurRowsPerChunk, kMaxBlurChunks);
+    if (chunkCount <= 1) {
+        boxBlurInterpRows(src, src_y_stride, dst, radius, width, outer_weight,
+                          0, height, dst_x_stride, dst_y_stride);
+        return new_width;
+    }
+
+    SkAutoSTMalloc<kMaxBlurChunks, BoxBlurChunk> chunks(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        BoxBlurChunk* chunk = &chunks[i];
+        chunk->fSrc = src;
+        chunk->fSrcYStride = src_y_stride;
+        chunk->fDst = dst;
+        chunk->fLeftRadius = radius;
+        chunk->fRightRadius = radius;
+        chunk->fOuterWeight = outer_weight;
+        chunk->fWidth = width;
+        chunk->fYStart = height * i / chunkCount;
+        chunk->fYStop = height * (i + 1) / chunkCount;
+        chunk->fDstXStride = dst_x_stride;
+        chunk->fDstYStride = dst_y_stride;
+    }
+    SkTaskGroup().batch(run_box_blur_interp_chunk, chunks.get(), chunkCount);
     return new_width;
 }
 
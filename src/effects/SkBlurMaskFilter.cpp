@@ -84,6 +84,10 @@ protected:
                                            const SkIRect& clipBounds,
                                            NinePatch*) const override;
 
+    virtual FilterReturn filterRRectsToNine(const SkRRect[], int count, const SkMatrix&,
+                                            const SkIRect& clipBounds,
+                                            NinePatch*) const override;
+
     bool filterRectMask(SkMask* dstM, const SkRect& r, const SkMatrix& matrix,
                         SkIPoint* margin, SkMask::CreateMode createMode) const;
     bool filterRRectMask(SkMask* dstM, const SkRRect& r, const SkMatrix& matrix,
@@ -206,8 +210,8 @@ static bool prepare_to_draw_into_mask(const SkRect& bounds, SkMask* mask) {
     return true;
 }
 
-static bool draw_rrect_into_mask(const SkRRect rrect, SkMask* mask) {
-    if (!prepare_to_draw_into_mask(rrect.rect(), mask)) {
+static bool draw_rrects_into_mask(const SkRRect rrects[], int count, SkMask* mask) {
+    if (!prepare_to_draw_into_mask(rrects[0].rect(), mask)) {
         return false;
     }
 
@@ -222,7 +226,17 @@ static bool draw_rrect_into_mask(const SkRRect rrect, SkMask* mask) {
 
     SkPaint paint;
     paint.setAntiAlias(true);
-    canvas.drawRRect(rrect, paint);
+
+    if (1 == count) {
+        canvas.drawRRect(rrects[0], paint);
+    } else {
+        // The ring between the two round rects, e.g. the shape of a stroke.
+        SkPath path;
+        path.addRRect(rrects[0]);
+        path.addRRect(rrects[1]);
+        path.setFillType(SkPath::kEvenOdd_FillType);
+        canvas.drawPath(path, paint);
+    }
     return true;
 }
 
@@ -276,16 +290,18 @@ static SkCachedData* copy_mask_to_cacheddata(SkMask* mask) {
     return data;
 }
 
-static SkCachedData* find_cached_rrect(SkMask* mask, SkScalar sigma, SkBlurStyle style,
-                                       SkBlurQuality quality, const SkRRect& rrect) {
-    return SkMaskCache::FindAndRef(sigma, style, quality, rrect, mask);
+static SkCachedData* find_cached_rrects(SkMask* mask, SkScalar sigma, SkBlurStyle style,
+                                        SkBlurQuality quality, const SkRRect rrects[],
+                                        int count) {
+    return SkMaskCache::FindAndRef(sigma, style, quality, rrects, count, mask);
 }
 
-static SkCachedData* add_cached_rrect(SkMask* mask, SkScalar sigma, SkBlurStyle style,
-                                      SkBlurQuality quality, const SkRRect& rrect) {
+static SkCachedData* add_cached_rrects(SkMask* mask, SkScalar sigma, SkBlurStyle style,
+                                       SkBlurQuality quality, const SkRRect rrects[],
+                                       int count) {
     SkCachedData* cache = copy_mask_to_cacheddata(mask);
     if (cache) {
-        SkMaskCache::Add(sigma, style, quality, rrect, *mask, cache);
+        SkMaskCache::Add(sigma, style, quality, rrects, count, *mask, cache);
     }
     return cache;
 }
@@ -314,7 +330,17 @@ SkMaskFilter::FilterReturn
 SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& matrix,
                                         const SkIRect& clipBounds,
                                         NinePatch* patch) const {
+    return this->filterRRectsToNine(&rrect, 1, matrix, clipBounds, patch);
+}
+
+SkMaskFilter::FilterReturn
+SkBlurMaskFilterImpl::filterRRectsToNine(const SkRRect rrectsIn[], int count,
+                                         const SkMatrix& matrix,
+                                         const SkIRect& clipBounds,
+                                         NinePatch* patch) const {
     SkASSERT(patch != NULL);
+    SkASSERT(1 == count || 2 == count);
+    const SkRRect& rrect = rrectsIn[0];
     switch (rrect.getType()) {
         case SkRRect::kEmpty_Type:
             // Nothing to draw.
@@ -379,8 +405,36 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
     const SkVector& LR = rrect.radii(SkRRect::kLowerRight_Corner);
     const SkVector& LL = rrect.radii(SkRRect::kLowerLeft_Corner);
 
-    const SkScalar leftUnstretched = SkTMax(UL.fX, LL.fX) + SkIntToScalar(2 * margin.fX);
-    const SkScalar rightUnstretched = SkTMax(UR.fX, LR.fX) + SkIntToScalar(2 * margin.fX);
+    SkScalar leftUnstretched = SkTMax(UL.fX, LL.fX) + SkIntToScalar(2 * margin.fX);
+    SkScalar rightUnstretched = SkTMax(UR.fX, LR.fX) + SkIntToScalar(2 * margin.fX);
+    SkScalar topUnstretched = SkTMax(UL.fY, UR.fY) + SkIntToScalar(2 * margin.fY);
+    SkScalar bottomUnstretched = SkTMax(LL.fY, LR.fY) + SkIntToScalar(2 * margin.fY);
+
+    // For a ring, the inner round rect's corners must also land inside the
+    // unstretched caps, so that only straight sections of both contours cross
+    // the stretch strip.
+    SkScalar insetL = 0, insetT = 0, insetR = 0, insetB = 0;
+    if (2 == count) {
+        const SkRRect& inner = rrectsIn[1];
+        insetL = inner.rect().left() - rrect.rect().left();
+        insetT = inner.rect().top() - rrect.rect().top();
+        insetR = rrect.rect().right() - inner.rect().right();
+        insetB = rrect.rect().bottom() - inner.rect().bottom();
+
+        const SkVector& iUL = inner.radii(SkRRect::kUpperLeft_Corner);
+        const SkVector& iUR = inner.radii(SkRRect::kUpperRight_Corner);
+        const SkVector& iLR = inner.radii(SkRRect::kLowerRight_Corner);
+        const SkVector& iLL = inner.radii(SkRRect::kLowerLeft_Corner);
+
+        leftUnstretched = SkTMax(leftUnstretched,
+                                 insetL + SkTMax(iUL.fX, iLL.fX) + SkIntToScalar(2 * margin.fX));
+        rightUnstretched = SkTMax(rightUnstretched,
+                                  insetR + SkTMax(iUR.fX, iLR.fX) + SkIntToScalar(2 * margin.fX));
+        topUnstretched = SkTMax(topUnstretched,
+                                insetT + SkTMax(iUL.fY, iUR.fY) + SkIntToScalar(2 * margin.fY));
+        bottomUnstretched = SkTMax(bottomUnstretched,
+                                   insetB + SkTMax(iLL.fY, iLR.fY) + SkIntToScalar(2 * margin.fY));
+    }
 
     // Extra space in the middle to ensure an unchanging piece for stretching. Use 3 to cover
     // any fractional space on either side plus 1 for the part to stretch.
@@ -392,9 +446,6 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
         return kUnimplemented_FilterReturn;
     }
 
-    const SkScalar topUnstretched = SkTMax(UL.fY, UR.fY) + SkIntToScalar(2 * margin.fY);
-    const SkScalar bottomUnstretched = SkTMax(LL.fY, LR.fY) + SkIntToScalar(2 * margin.fY);
-
     const SkScalar totalSmallHeight = topUnstretched + bottomUnstretched + stretchSize;
     if (totalSmallHeight >= rrect.rect().height()) {
         // There is no valid piece to stretch.
@@ -403,27 +454,47 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
 
     SkRect smallR = SkRect::MakeWH(totalSmallWidth, totalSmallHeight);
 
-    SkRRect smallRR;
+    SkRRect smallRRects[2];
     SkVector radii[4];
     radii[SkRRect::kUpperLeft_Corner] = UL;
     radii[SkRRect::kUpperRight_Corner] = UR;
     radii[SkRRect::kLowerRight_Corner] = LR;
     radii[SkRRect::kLowerLeft_Corner] = LL;
-    smallRR.setRectRadii(smallR, radii);
+    smallRRects[0].setRectRadii(smallR, radii);
+
+    if (2 == count) {
+        // Shrink the inner round rect with the same layout: same insets from
+        // the outer, same radii.  Since the small rects are keyed only by
+        // radii, sigma and style, every same-radius stroke shares one entry
+        // regardless of the stroked rect's size.
+        SkRect smallInnerR = smallR;
+        smallInnerR.fLeft += insetL;
+        smallInnerR.fTop += insetT;
+        smallInnerR.fRight -= insetR;
+        smallInnerR.fBottom -= insetB;
+
+        const SkRRect& inner = rrectsIn[1];
+        SkVector innerRadii[4];
+        innerRadii[SkRRect::kUpperLeft_Corner] = inner.radii(SkRRect::kUpperLeft_Corner);
+        innerRadii[SkRRect::kUpperRight_Corner] = inner.radii(SkRRect::kUpperRight_Corner);
+        innerRadii[SkRRect::kLowerRight_Corner] = inner.radii(SkRRect::kLowerRight_Corner);
+        innerRadii[SkRRect::kLowerLeft_Corner] = inner.radii(SkRRect::kLowerLeft_Corner);
+        smallRRects[1].setRectRadii(smallInnerR, innerRadii);
+    }
 
     const SkScalar sigma = this->computeXformedSigma(matrix);
-    SkCachedData* cache = find_cached_rrect(&patch->fMask, sigma, fBlurStyle,
-                                            this->getQuality(), smallRR);
+    SkCachedData* cache = find_cached_rrects(&patch->fMask, sigma, fBlurStyle,
+                                             this->getQuality(), smallRRects, count);
     if (!cache) {
         bool analyticBlurWorked = false;
-        if (c_analyticBlurRRect) {
+        if (1 == count && c_analyticBlurRRect) {
             analyticBlurWorked =
-                this->filterRRectMask(&patch->fMask, smallRR, matrix, &margin,
+                this->filterRRectMask(&patch->fMask, smallRRects[0], matrix, &margin,
                                       SkMask::kComputeBoundsAndRenderImage_CreateMode);
         }
 
         if (!analyticBlurWorked) {
-            if (!draw_rrect_into_mask(smallRR, &srcM)) {
+            if (!draw_rrects_into_mask(smallRRects, count, &srcM)) {
                 return kFalse_FilterReturn;
             }
 
@@ -433,7 +504,8 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
                 return kFalse_FilterReturn;
             }
         }
-        cache = add_cached_rrect(&patch->fMask, sigma, fBlurStyle, this->getQuality(), smallRR);
+        cache = add_cached_rrects(&patch->fMask, sigma, fBlurStyle, this->getQuality(),
+                                  smallRRects, count);
     }
 
     patch->fMask.fBounds.offsetTo(0, 0);
@@ -7,8 +7,10 @@
 
 #include "SkColorCubeFilter.h"
 #include "SkColorPriv.h"
+#include "SkNx.h"
 #include "SkOnce.h"
 #include "SkReadBuffer.h"
+#include "SkResourceCache.h"
 #include "SkUnPreMultiply.h"
 #include "SkWriteBuffer.h"
 #if SK_SUPPORT_GPU
@@ -34,6 +36,55 @@ int32_t SkNextColorCubeUniqueID() {
     return genID;
 }
 
+static unsigned gCubeLutNamespaceLabel;
+
+struct CubeLutKey : public SkResourceCache::Key {
+    CubeLutKey(int32_t uniqueID) : fUniqueID(uniqueID) {
+        this->init(&gCubeLutNamespaceLabel, MakeSharedID(uniqueID), sizeof(fUniqueID));
+    }
+
+    static uint64_t MakeSharedID(int32_t uniqueID) {
+        uint64_t sharedID = SkSetFourByteTag('c', 'u', 'b', 'e');
+        return (sharedID << 32) | (uint32_t)uniqueID;
+    }
+
+    int32_t fUniqueID;
+};
+
+/**
+ *  The cube colors expanded to one float quad (r, g, b, 0) per lattice point, ready for
+ *  Sk4f loads in the filter loop. Kept in SkResourceCache so repeated spans share the
+ *  expansion and the memory stays under the cache budget.
+ */
+struct CubeLutRec : public SkResourceCache::Rec {
+    CubeLutRec(int32_t uniqueID, const SkColor* cube, int dim)
+        : fKey(uniqueID)
+        , fData(SkData::NewUninitialized(dim * dim * dim * 4 * sizeof(float))) {
+        float* dst = (float*)fData->writable_data();
+        const int count = dim * dim * dim;
+        for (int i = 0; i < count; ++i) {
+            const SkColor c = cube[i];
+            dst[0] = SkIntToScalar(SkColorGetR(c));
+            dst[1] = SkIntToScalar(SkColorGetG(c));
+            dst[2] = SkIntToScalar(SkColorGetB(c));
+            dst[3] = 0;
+            dst += 4;
+        }
+    }
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fData->size(); }
+
+    static bool Finder(const SkResourceCache::Rec& baseRec, void* ctxData) {
+        const CubeLutRec& rec = static_cast<const CubeLutRec&>(baseRec);
+        *(SkData**)ctxData = SkRef(rec.fData.get());
+        return true;
+    }
+
+    CubeLutKey           fKey;
+    SkAutoTUnref<SkData> fData;
+};
+
 } // end namespace
 
 static const int MIN_CUBE_SIZE = 4;
@@ -59,6 +110,10 @@ SkColorCubeFilter::SkColorCubeFilter(SkData* cubeData, int cubeDimension)
   , fCache(cubeDimension) {
 }
 
+SkColorCubeFilter::~SkColorCubeFilter() {
+    SkResourceCache::PostPurgeSharedID(CubeLutKey::MakeSharedID(fUniqueID));
+}
+
 uint32_t SkColorCubeFilter::getFlags() const {
     return this->INHERITED::getFlags() | kAlphaUnchanged_Flag;
 }
@@ -129,34 +184,80 @@ void SkColorCubeFilter::filterSpan(const SkPMColor src[], int count, SkPMColor d
     fCache.getProcessingLuts(&colorToIndex, &colorToFactors, &colorToScalar);
 
     const int dim = fCache.cubeDimension();
-    SkColor* colorCube = (SkColor*)fCubeData->data();
+
+    // Fetch (or build and share) the float-expanded cube.
+    SkData* cubeFloats = NULL;
+    CubeLutKey key(fUniqueID);
+    if (!SkResourceCache::Find(key, CubeLutRec::Finder, &cubeFloats)) {
+        CubeLutRec* rec = SkNEW_ARGS(CubeLutRec,
+                                     (fUniqueID, (const SkColor*)fCubeData->data(), dim));
+        cubeFloats = SkRef(rec->fData.get());
+        SkResourceCache::Add(rec);
+    }
+    SkAutoTUnref<SkData> autoUnref(cubeFloats);
+    const float* cube = (const float*)cubeFloats->data();
+
+    static const SkScalar inv8bit = SkScalarInvert(SkIntToScalar(255));
     for (int i = 0; i < count; ++i) {
         SkColor inputColor = SkUnPreMultiply::PMColorToColor(src[i]);
         uint8_t r = SkColorGetR(inputColor);
         uint8_t g = SkColorGetG(inputColor);
         uint8_t b = SkColorGetB(inputColor);
         uint8_t a = SkColorGetA(inputColor);
-        SkScalar rOut(0), gOut(0), bOut(0);
-        for (int x = 0; x < 2; ++x) {
-            for (int y = 0; y < 2; ++y) {
-                for (int z = 0; z < 2; ++z) {
-                    SkColor lutColor = colorCube[colorToIndex[x][r] +
-                                                (colorToIndex[y][g] +
-                                                 colorToIndex[z][b] * dim) * dim];
-                    SkScalar factor = colorToFactors[x][r] *
-                                      colorToFactors[y][g] *
-                                      colorToFactors[z][b];
-                    rOut += colorToScalar[SkColorGetR(lutColor)] * factor;
-                    gOut += colorToScalar[SkColorGetG(lutColor)] * factor;
-                    bOut += colorToScalar[SkColorGetB(lutColor)] * factor;
-                }
+
+        // Flat-array float-quad steps to the next lattice point on each axis
+        // (zero at the clamped top edge, where both indices coincide).
+        const int base = (colorToIndex[0][r] +
+                         (colorToIndex[0][g] + colorToIndex[0][b] * dim) * dim) * 4;
+        const int stepR = (colorToIndex[1][r] - colorToIndex[0][r]) * 4;
+        const int stepG = (colorToIndex[1][g] - colorToIndex[0][g]) * dim * 4;
+        const int stepB = (colorToIndex[1][b] - colorToIndex[0][b]) * dim * dim * 4;
+        const SkScalar fr = colorToFactors[1][r];
+        const SkScalar fg = colorToFactors[1][g];
+        const SkScalar fb = colorToFactors[1][b];
+
+        // Tetrahedral interpolation: order the fractional offsets to pick the tetrahedron
+        // of the cell that contains the point, and blend its four corners instead of all
+        // eight corners of the cell. Exact at the lattice points, like trilinear.
+        int t1, t2;
+        SkScalar w1, w2, w3;
+        if (fr >= fg) {
+            if (fg >= fb) {         // fr >= fg >= fb
+                t1 = stepR; t2 = stepR + stepG;
+                w1 = fr - fg; w2 = fg - fb; w3 = fb;
+            } else if (fr >= fb) {  // fr >= fb > fg
+                t1 = stepR; t2 = stepR + stepB;
+                w1 = fr - fb; w2 = fb - fg; w3 = fg;
+            } else {                // fb > fr >= fg
+                t1 = stepB; t2 = stepB + stepR;
+                w1 = fb - fr; w2 = fr - fg; w3 = fg;
+            }
+        } else {
+            if (fr >= fb) {         // fg > fr >= fb
+                t1 = stepG; t2 = stepG + stepR;
+                w1 = fg - fr; w2 = fr - fb; w3 = fb;
+            } else if (fg >= fb) {  // fg >= fb > fr
+                t1 = stepG; t2 = stepG + stepB;
+                w1 = fg - fb; w2 = fb - fr; w3 = fr;
+            } else {                // fb > fg > fr
+                t1 = stepB; t2 = stepB + stepG;
+                w1 = fb - fg; w2 = fg - fr; w3 = fr;
             }
         }
-        const SkScalar aOut = SkIntToScalar(a);
+        const SkScalar w0 = SK_Scalar1 - w1 - w2 - w3;
+
+        Sk4f acc = Sk4f(w0) * Sk4f::Load(cube + base) +
+                   Sk4f(w1) * Sk4f::Load(cube + base + t1) +
+                   Sk4f(w2) * Sk4f::Load(cube + base + t2) +
+                   Sk4f(w3) * Sk4f::Load(cube + base + stepR + stepG + stepB);
+        acc = acc * Sk4f(SkIntToScalar(a) * inv8bit);
+
+        float rgb[4];
+        acc.store(rgb);
         dst[i] = SkPackARGB32(a,
-            SkScalarRoundToInt(rOut * aOut),
-            SkScalarRoundToInt(gOut * aOut),
-            SkScalarRoundToInt(bOut * aOut));
+                              SkScalarRoundToInt(rgb[0]),
+                              SkScalarRoundToInt(rgb[1]),
+                              SkScalarRoundToInt(rgb[2]));
     }
 }
 
@@ -137,11 +137,52 @@ static void Add16(const SkColorMatrixFilter::State& state,
     result[3] = a;
 }
 
+/**
+ *  Need inv255 = 1 / 255 as a constant, so when we premul a SkPMFloat, we can do this
+ *
+ *      new_red = old_red * alpha * inv255
+ *
+ *  instead of (much slower)
+ *
+ *      new_red = old_red * alpha / 255
+ *
+ *  However, 1.0f/255 comes to (in hex) 0x3B808081, which is slightly bigger than the "actual"
+ *  value of 0x3B808080(repeat 80)... This slightly too-big value can cause us to compute
+ *  new_red > alpha, which is a problem (for valid premul). To fix this, we use a
+ *  hand-computed value of 0x3B808080, 1 ULP smaller. This keeps our colors valid.
+ */
+static const float gInv255 = 0.0039215683f; //  (1.0f / 255) - ULP == SkBits2Float(0x3B808080)
+
+static Sk4f premul(const Sk4f& x) {
+    float scale = SkPMFloat(x).a() * gInv255;
+    Sk4f pm = x * Sk4f(scale, scale, scale, 1);
+
+#ifdef SK_DEBUG
+    SkPMFloat pmf(pm);
+    SkASSERT(pmf.isValid());
+#endif
+
+    return pm;
+}
+
+static Sk4f unpremul(const SkPMFloat& pm) {
+    float scale = 255 / pm.a(); // candidate for fast/approx invert?
+    return pm * Sk4f(scale, scale, scale, 1);
+}
+
+static Sk4f clamp_0_255(const Sk4f& value) {
+    return Sk4f::Max(Sk4f::Min(value, Sk4f(255)), Sk4f(0));
+}
+
 // src is [20] but some compilers won't accept __restrict__ on anything
 // but an raw pointer or reference
 void SkColorMatrixFilter::initState(const SkScalar* SK_RESTRICT src) {
     transpose_to_pmorder(fTranspose, src);
 
+    // Cache the matrix applied to transparent black, so filterSpan() doesn't have to
+    // rebuild it for every span.
+    fTranslatePMColor = SkPMFloat(premul(clamp_0_255(Sk4f::Load(fTranspose + 16)))).roundClamp();
+
     int32_t* array = fState.fArray;
     SkFixed max = 0;
     for (int i = 0; i < 20; i++) {
@@ -239,43 +280,6 @@ uint32_t SkColorMatrixFilter::getFlags() const {
     return this->INHERITED::getFlags() | fFlags;
 }
 
-/**
- *  Need inv255 = 1 / 255 as a constant, so when we premul a SkPMFloat, we can do this
- *
- *      new_red = old_red * alpha * inv255
- *
- *  instead of (much slower)
- *
- *      new_red = old_red * alpha / 255
- *
- *  However, 1.0f/255 comes to (in hex) 0x3B808081, which is slightly bigger than the "actual"
- *  value of 0x3B808080(repeat 80)... This slightly too-big value can cause us to compute
- *  new_red > alpha, which is a problem (for valid premul). To fix this, we use a
- *  hand-computed value of 0x3B808080, 1 ULP smaller. This keeps our colors valid.
- */
-static const float gInv255 = 0.0039215683f; //  (1.0f / 255) - ULP == SkBits2Float(0x3B808080)
-
-static Sk4f premul(const Sk4f& x) {
-    float scale = SkPMFloat(x).a() * gInv255;
-    Sk4f pm = x * Sk4f(scale, scale, scale, 1);
-
-#ifdef SK_DEBUG
-    SkPMFloat pmf(pm);
-    SkASSERT(pmf.isValid());
-#endif
-
-    return pm;
-}
-
-static Sk4f unpremul(const SkPMFloat& pm) {
-    float scale = 255 / pm.a(); // candidate for fast/approx invert?
-    return pm * Sk4f(scale, scale, scale, 1);
-}
-
-static Sk4f clamp_0_255(const Sk4f& value) {
-    return Sk4f::Max(Sk4f::Min(value, Sk4f(255)), Sk4f(0));
-}
-
 void SkColorMatrixFilter::filterSpan(const SkPMColor src[], int count, SkPMColor dst[]) const {
     Proc proc = fProc;
     if (NULL == proc) {
@@ -298,8 +302,7 @@ void SkColorMatrixFilter::filterSpan(const SkPMColor src[], int count, SkPMColor
         const Sk4f c3 = Sk4f::Load(fTranspose + 12);
         const Sk4f c4 = Sk4f::Load(fTranspose + 16);  // translates
 
-        // todo: we could cache this in the constructor...
-        SkPMColor matrix_translate_pmcolor = SkPMFloat(premul(clamp_0_255(c4))).roundClamp();
+        const SkPMColor matrix_translate_pmcolor = fTranslatePMColor;
 
         for (int i = 0; i < count; i++) {
             const SkPMColor src_c = src[i];
@@ -362,6 +365,19 @@ void SkColorMatrixFilter::filterSpan(const SkPMColor src[], int count, SkPMColor
     }
 }
 
+static void color_matrix_span_proc(const void* ctx, const SkPMColor src[], int count,
+                                   SkPMColor dst[]) {
+    static_cast<const SkColorMatrixFilter*>(ctx)->SkColorMatrixFilter::filterSpan(src, count, dst);
+}
+
+SkColorFilter::SpanProc SkColorMatrixFilter::asSpanProc(const void** ctx) const {
+    if (NULL == fProc) {
+        return NULL;    // identity; filterSpan() is already just a copy
+    }
+    *ctx = this;
+    return color_matrix_span_proc;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkColorMatrixFilter::flatten(SkWriteBuffer& buffer) const {
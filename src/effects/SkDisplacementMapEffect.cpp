@@ -6,6 +6,7 @@
  */
 
 #include "SkDisplacementMapEffect.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkUnPreMultiply.h"
@@ -64,11 +65,33 @@ void computeDisplacement(const SkVector& scale, SkBitmap* dst,
     const SkVector scaleAdj = SkVector::Make(SK_ScalarHalf - SkScalarMul(scale.fX, SK_ScalarHalf),
                                              SK_ScalarHalf - SkScalarMul(scale.fY, SK_ScalarHalf));
     const SkUnPreMultiply::Scale* table = SkUnPreMultiply::GetScaleTable();
+    const Sk4f scaleX(scaleForColor.fX), adjX(scaleAdj.fX);
+    const Sk4f scaleY(scaleForColor.fY), adjY(scaleAdj.fY);
     SkPMColor* dstPtr = dst->getAddr32(0, 0);
     for (int y = bounds.top(); y < bounds.bottom(); ++y) {
         const SkPMColor* displPtr = displ->getAddr32(bounds.left() + offset.fX,
                                                      y + offset.fY);
-        for (int x = bounds.left(); x < bounds.right(); ++x, ++displPtr) {
+        int x = bounds.left();
+        // Compute the displacement math four pixels at a time. The channel extraction and the
+        // bounds-checked source fetch stay scalar, since both are table/pixel gathers.
+        for (; x + 4 <= bounds.right(); x += 4, displPtr += 4) {
+            float dispX[4], dispY[4];
+            for (int i = 0; i < 4; i++) {
+                dispX[i] = SkIntToScalar(getValue<typeX>(displPtr[i], table));
+                dispY[i] = SkIntToScalar(getValue<typeY>(displPtr[i], table));
+            }
+            // Truncate the displacement values
+            int srcX[4], srcY[4];
+            ((Sk4f::Load(dispX) * scaleX + adjX).castTrunc() + Sk4i(x, x + 1, x + 2, x + 3))
+                .store(srcX);
+            ((Sk4f::Load(dispY) * scaleY + adjY).castTrunc() + Sk4i(y)).store(srcY);
+            for (int i = 0; i < 4; i++) {
+                *dstPtr++ = ((srcX[i] < 0) || (srcX[i] >= srcW) ||
+                             (srcY[i] < 0) || (srcY[i] >= srcH)) ?
+                          0 : *(src->getAddr32(srcX[i], srcY[i]));
+            }
+        }
+        for (; x < bounds.right(); ++x, ++displPtr) {
             const SkScalar displX = SkScalarMul(scaleForColor.fX,
                 SkIntToScalar(getValue<typeX>(*displPtr, table))) + scaleAdj.fX;
             const SkScalar displY = SkScalarMul(scaleForColor.fY,
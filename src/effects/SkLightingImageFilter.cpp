@@ -8,6 +8,7 @@
 #include "SkLightingImageFilter.h"
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkReadBuffer.h"
@@ -72,6 +73,26 @@ public:
                             SkClampMax(SkScalarRoundToInt(color.fY), 255),
                             SkClampMax(SkScalarRoundToInt(color.fZ), 255));
     }
+    // Lights four pixels at once for a light with uniform direction and color;
+    // the normals come in with one lane per pixel.  Mirrors light() above.
+    void light4(const Sk4f& normalX, const Sk4f& normalY, const Sk4f& normalZ,
+                const SkPoint3& surfaceTolight, const SkPoint3& lightColor,
+                SkPMColor dst[4]) const {
+        Sk4f colorScale = (normalX * Sk4f(surfaceTolight.fX) +
+                           normalY * Sk4f(surfaceTolight.fY) +
+                           normalZ * Sk4f(surfaceTolight.fZ)) * Sk4f(fKD);
+        colorScale = Sk4f::Max(Sk4f(0), Sk4f::Min(colorScale, Sk4f(SK_Scalar1)));
+        float r[4], g[4], b[4];
+        (colorScale * Sk4f(lightColor.fX) + Sk4f(0.5f)).store(r);
+        (colorScale * Sk4f(lightColor.fY) + Sk4f(0.5f)).store(g);
+        (colorScale * Sk4f(lightColor.fZ) + Sk4f(0.5f)).store(b);
+        for (int i = 0; i < 4; ++i) {
+            dst[i] = SkPackARGB32(255,
+                                  SkClampMax((int) r[i], 255),
+                                  SkClampMax((int) g[i], 255),
+                                  SkClampMax((int) b[i], 255));
+        }
+    }
 private:
     SkScalar fKD;
 };
@@ -94,6 +115,30 @@ public:
                             SkClampMax(SkScalarRoundToInt(color.fY), 255),
                             SkClampMax(SkScalarRoundToInt(color.fZ), 255));
     }
+    // Lights four pixels at once for a light with uniform direction and color.
+    // The dot products vectorize; SkScalarPow() has no vector form, so each
+    // pixel is finished in scalar.
+    void light4(const Sk4f& normalX, const Sk4f& normalY, const Sk4f& normalZ,
+                const SkPoint3& surfaceTolight, const SkPoint3& lightColor,
+                SkPMColor dst[4]) const {
+        SkPoint3 halfDir(surfaceTolight);
+        halfDir.fZ += SK_Scalar1;        // eye position is always (0, 0, 1)
+        halfDir.normalize();
+        Sk4f dot = normalX * Sk4f(halfDir.fX) +
+                   normalY * Sk4f(halfDir.fY) +
+                   normalZ * Sk4f(halfDir.fZ);
+        float dots[4];
+        dot.store(dots);
+        for (int i = 0; i < 4; ++i) {
+            SkScalar colorScale = SkScalarMul(fKS, SkScalarPow(dots[i], fShininess));
+            colorScale = SkScalarClampMax(colorScale, SK_Scalar1);
+            SkPoint3 color(lightColor * colorScale);
+            dst[i] = SkPackARGB32(SkClampMax(SkScalarRoundToInt(color.maxComponent()), 255),
+                                  SkClampMax(SkScalarRoundToInt(color.fX), 255),
+                                  SkClampMax(SkScalarRoundToInt(color.fY), 255),
+                                  SkClampMax(SkScalarRoundToInt(color.fZ), 255));
+        }
+    }
 private:
     SkScalar fKS;
     SkScalar fShininess;
@@ -166,100 +211,6 @@ inline SkPoint3 bottomRightNormal(int m[9], SkScalar surfaceScale) {
                          surfaceScale);
 }
 
-template <class LightingType, class LightType> void lightBitmap(
-        const LightingType& lightingType, const SkLight* light, const SkBitmap& src, SkBitmap* dst,
-        SkScalar surfaceScale, const SkIRect& bounds) {
-    SkASSERT(dst->width() == bounds.width() && dst->height() == bounds.height());
-    const LightType* l = static_cast<const LightType*>(light);
-    int left = bounds.left(), right = bounds.right();
-    int bottom = bounds.bottom();
-    int y = bounds.top();
-    SkPMColor* dptr = dst->getAddr32(0, 0);
-    {
-        int x = left;
-        const SkPMColor* row1 = src.getAddr32(x, y);
-        const SkPMColor* row2 = src.getAddr32(x, y + 1);
-        int m[9];
-        m[4] = SkGetPackedA32(*row1++);
-        m[5] = SkGetPackedA32(*row1++);
-        m[7] = SkGetPackedA32(*row2++);
-        m[8] = SkGetPackedA32(*row2++);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(topLeftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x)
-        {
-            shiftMatrixLeft(m);
-            m[5] = SkGetPackedA32(*row1++);
-            m[8] = SkGetPackedA32(*row2++);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(topNormal(m, surfaceScale), surfaceToLight,
-                                         l->lightColor(surfaceToLight));
-        }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(topRightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-    }
-
-    for (++y; y < bottom - 1; ++y) {
-        int x = left;
-        const SkPMColor* row0 = src.getAddr32(x, y - 1);
-        const SkPMColor* row1 = src.getAddr32(x, y);
-        const SkPMColor* row2 = src.getAddr32(x, y + 1);
-        int m[9];
-        m[1] = SkGetPackedA32(*row0++);
-        m[2] = SkGetPackedA32(*row0++);
-        m[4] = SkGetPackedA32(*row1++);
-        m[5] = SkGetPackedA32(*row1++);
-        m[7] = SkGetPackedA32(*row2++);
-        m[8] = SkGetPackedA32(*row2++);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
-            shiftMatrixLeft(m);
-            m[2] = SkGetPackedA32(*row0++);
-            m[5] = SkGetPackedA32(*row1++);
-            m[8] = SkGetPackedA32(*row2++);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
-                                         l->lightColor(surfaceToLight));
-        }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-    }
-
-    {
-        int x = left;
-        const SkPMColor* row0 = src.getAddr32(x, bottom - 2);
-        const SkPMColor* row1 = src.getAddr32(x, bottom - 1);
-        int m[9];
-        m[1] = SkGetPackedA32(*row0++);
-        m[2] = SkGetPackedA32(*row0++);
-        m[4] = SkGetPackedA32(*row1++);
-        m[5] = SkGetPackedA32(*row1++);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(bottomLeftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x)
-        {
-            shiftMatrixLeft(m);
-            m[2] = SkGetPackedA32(*row0++);
-            m[5] = SkGetPackedA32(*row1++);
-            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(bottomNormal(m, surfaceScale), surfaceToLight,
-                                         l->lightColor(surfaceToLight));
-        }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(bottomRightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-    }
-}
-
 SkPoint3 readPoint3(SkReadBuffer& buffer) {
     SkPoint3 point;
     point.fX = buffer.readScalar();
@@ -985,6 +936,184 @@ const SkScalar SkSpotLight::kSpecularExponentMax = 128.0f;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// lightBitmap() and its row helpers live down here, below the light
+// subclasses, so the distant-light fast path can overload on SkDistantLight.
+namespace {
+
+// Lights the interior pixels of one row with the scalar sliding-window path;
+// this is the generic case, for lights whose direction varies per pixel.
+// The row pointers start one pixel to the left of the first output pixel.
+template <class LightingType, class LightType>
+void lightRowInterior(const LightingType& lightingType, const LightType* l,
+                      const SkPMColor* row0, const SkPMColor* row1, const SkPMColor* row2,
+                      SkPMColor* dptr, int count, int x, int y, SkScalar surfaceScale) {
+    int m[9];
+    m[0] = SkGetPackedA32(*row0++);
+    m[1] = SkGetPackedA32(*row0++);
+    m[3] = SkGetPackedA32(*row1++);
+    m[4] = SkGetPackedA32(*row1++);
+    m[6] = SkGetPackedA32(*row2++);
+    m[7] = SkGetPackedA32(*row2++);
+    for (int i = 0; i < count; ++i, ++x) {
+        m[2] = SkGetPackedA32(*row0++);
+        m[5] = SkGetPackedA32(*row1++);
+        m[8] = SkGetPackedA32(*row2++);
+        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+        shiftMatrixLeft(m);
+    }
+}
+
+// Distant lights have a uniform direction and color, so the sobel taps and the
+// shading can be evaluated four pixels at a time with Sk4f.  The leftover
+// pixels fall back to the scalar path above.
+template <class LightingType>
+void lightRowInterior(const LightingType& lightingType, const SkDistantLight* l,
+                      const SkPMColor* row0, const SkPMColor* row1, const SkPMColor* row2,
+                      SkPMColor* dptr, int count, int x, int y, SkScalar surfaceScale) {
+    const SkPoint3 surfaceToLight = l->surfaceToLight(x, y, 0, surfaceScale);
+    const SkPoint3 lightColor = l->lightColor(surfaceToLight);
+    // pointToNormal() negates both sobel taps, so fold that in with the
+    // interior case's gOneQuarter weight.
+    const Sk4f quarterScale(-gOneQuarter * surfaceScale);
+    const Sk4f two(2.0f);
+    const Sk4f one(SK_Scalar1);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float a0[6], a1[6], a2[6];
+        for (int j = 0; j < 6; ++j) {
+            a0[j] = SkIntToScalar(SkGetPackedA32(row0[i + j]));
+            a1[j] = SkIntToScalar(SkGetPackedA32(row1[i + j]));
+            a2[j] = SkIntToScalar(SkGetPackedA32(row2[i + j]));
+        }
+        // interiorNormal()'s sobel taps for four adjacent pixels, one per lane.
+        Sk4f topLeft  = Sk4f::Load(a0), top = Sk4f::Load(a0 + 1), topRight = Sk4f::Load(a0 + 2);
+        Sk4f left     = Sk4f::Load(a1),                           right    = Sk4f::Load(a1 + 2);
+        Sk4f botLeft  = Sk4f::Load(a2), bot = Sk4f::Load(a2 + 1), botRight = Sk4f::Load(a2 + 2);
+        Sk4f nx = ((topRight - topLeft) + (right - left) * two + (botRight - botLeft))
+                  * quarterScale;
+        Sk4f ny = ((botLeft - topLeft) + (bot - top) * two + (botRight - topRight))
+                  * quarterScale;
+        Sk4f invLen = one / (nx * nx + ny * ny + one).sqrt();
+        lightingType.light4(nx * invLen, ny * invLen, invLen, surfaceToLight, lightColor,
+                            dptr + i);
+    }
+    for (; i < count; ++i) {
+        int m[9];
+        m[0] = SkGetPackedA32(row0[i]);
+        m[1] = SkGetPackedA32(row0[i + 1]);
+        m[2] = SkGetPackedA32(row0[i + 2]);
+        m[3] = SkGetPackedA32(row1[i]);
+        m[4] = SkGetPackedA32(row1[i + 1]);
+        m[5] = SkGetPackedA32(row1[i + 2]);
+        m[6] = SkGetPackedA32(row2[i]);
+        m[7] = SkGetPackedA32(row2[i + 1]);
+        m[8] = SkGetPackedA32(row2[i + 2]);
+        dptr[i] = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
+                                     lightColor);
+    }
+}
+
+template <class LightingType, class LightType> void lightBitmap(
+        const LightingType& lightingType, const SkLight* light, const SkBitmap& src, SkBitmap* dst,
+        SkScalar surfaceScale, const SkIRect& bounds) {
+    SkASSERT(dst->width() == bounds.width() && dst->height() == bounds.height());
+    const LightType* l = static_cast<const LightType*>(light);
+    int left = bounds.left(), right = bounds.right();
+    int bottom = bounds.bottom();
+    int y = bounds.top();
+    SkPMColor* dptr = dst->getAddr32(0, 0);
+    {
+        int x = left;
+        const SkPMColor* row1 = src.getAddr32(x, y);
+        const SkPMColor* row2 = src.getAddr32(x, y + 1);
+        int m[9];
+        m[4] = SkGetPackedA32(*row1++);
+        m[5] = SkGetPackedA32(*row1++);
+        m[7] = SkGetPackedA32(*row2++);
+        m[8] = SkGetPackedA32(*row2++);
+        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(topLeftNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+        for (++x; x < right - 1; ++x)
+        {
+            shiftMatrixLeft(m);
+            m[5] = SkGetPackedA32(*row1++);
+            m[8] = SkGetPackedA32(*row2++);
+            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+            *dptr++ = lightingType.light(topNormal(m, surfaceScale), surfaceToLight,
+                                         l->lightColor(surfaceToLight));
+        }
+        shiftMatrixLeft(m);
+        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(topRightNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+    }
+
+    for (++y; y < bottom - 1; ++y) {
+        int x = left;
+        const SkPMColor* row0 = src.getAddr32(x, y - 1);
+        const SkPMColor* row1 = src.getAddr32(x, y);
+        const SkPMColor* row2 = src.getAddr32(x, y + 1);
+        int m[9];
+        m[1] = SkGetPackedA32(row0[0]);
+        m[2] = SkGetPackedA32(row0[1]);
+        m[4] = SkGetPackedA32(row1[0]);
+        m[5] = SkGetPackedA32(row1[1]);
+        m[7] = SkGetPackedA32(row2[0]);
+        m[8] = SkGetPackedA32(row2[1]);
+        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+        int interior = right - left - 2;
+        lightRowInterior(lightingType, l, row0, row1, row2, dptr, interior,
+                         x + 1, y, surfaceScale);
+        dptr += interior;
+        x = right - 1;
+        m[0] = SkGetPackedA32(row0[x - left - 1]);
+        m[1] = SkGetPackedA32(row0[x - left]);
+        m[3] = SkGetPackedA32(row1[x - left - 1]);
+        m[4] = SkGetPackedA32(row1[x - left]);
+        m[6] = SkGetPackedA32(row2[x - left - 1]);
+        m[7] = SkGetPackedA32(row2[x - left]);
+        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+    }
+
+    {
+        int x = left;
+        const SkPMColor* row0 = src.getAddr32(x, bottom - 2);
+        const SkPMColor* row1 = src.getAddr32(x, bottom - 1);
+        int m[9];
+        m[1] = SkGetPackedA32(*row0++);
+        m[2] = SkGetPackedA32(*row0++);
+        m[4] = SkGetPackedA32(*row1++);
+        m[5] = SkGetPackedA32(*row1++);
+        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(bottomLeftNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+        for (++x; x < right - 1; ++x)
+        {
+            shiftMatrixLeft(m);
+            m[2] = SkGetPackedA32(*row0++);
+            m[5] = SkGetPackedA32(*row1++);
+            surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+            *dptr++ = lightingType.light(bottomNormal(m, surfaceScale), surfaceToLight,
+                                         l->lightColor(surfaceToLight));
+        }
+        shiftMatrixLeft(m);
+        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+        *dptr++ = lightingType.light(bottomRightNormal(m, surfaceScale), surfaceToLight,
+                                     l->lightColor(surfaceToLight));
+    }
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
 void SkLight::flattenLight(SkWriteBuffer& buffer) const {
     // Write type first, then baseclass, then subclass.
     buffer.writeInt(this->type());
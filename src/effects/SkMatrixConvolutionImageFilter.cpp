@@ -8,9 +8,11 @@
 #include "SkMatrixConvolutionImageFilter.h"
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkRect.h"
+#include "SkTemplates.h"
 #include "SkUnPreMultiply.h"
 
 #if SK_SUPPORT_GPU
@@ -44,6 +46,53 @@ SkMatrixConvolutionImageFilter::SkMatrixConvolutionImageFilter(
     SkASSERT(kernelSize.fWidth >= 1 && kernelSize.fHeight >= 1);
     SkASSERT(kernelOffset.fX >= 0 && kernelOffset.fX < kernelSize.fWidth);
     SkASSERT(kernelOffset.fY >= 0 && kernelOffset.fY < kernelSize.fHeight);
+    this->initSeparable();
+}
+
+void SkMatrixConvolutionImageFilter::initSeparable() {
+    fSeparable = false;
+    fRowKernel = NULL;
+    fColKernel = NULL;
+    int kw = fKernelSize.fWidth;
+    int kh = fKernelSize.fHeight;
+    if (kw < 2 || kh < 2) {
+        return;   // 1-D kernels gain nothing from splitting.
+    }
+    // Use the largest magnitude entry as the pivot, for numerical stability.
+    int pivot = 0;
+    for (int i = 1; i < kw * kh; ++i) {
+        if (SkScalarAbs(fKernel[i]) > SkScalarAbs(fKernel[pivot])) {
+            pivot = i;
+        }
+    }
+    if (0 == fKernel[pivot]) {
+        return;   // All-zero kernel.
+    }
+    int py = pivot / kw;
+    int px = pivot % kw;
+    SkAutoTMalloc<SkScalar> row(kw);
+    SkAutoTMalloc<SkScalar> col(kh);
+    SkScalar invPivot = SkScalarInvert(fKernel[py * kw + px]);
+    for (int cx = 0; cx < kw; ++cx) {
+        row[cx] = fKernel[py * kw + cx];
+    }
+    for (int cy = 0; cy < kh; ++cy) {
+        col[cy] = SkScalarMul(fKernel[cy * kw + px], invPivot);
+    }
+    // The kernel is rank-1 iff every entry matches the outer product.
+    const SkScalar tolerance = SkScalarAbs(fKernel[pivot]) / 65536;
+    for (int cy = 0; cy < kh; ++cy) {
+        for (int cx = 0; cx < kw; ++cx) {
+            if (SkScalarAbs(SkScalarMul(col[cy], row[cx]) - fKernel[cy * kw + cx]) > tolerance) {
+                return;
+            }
+        }
+    }
+    fRowKernel = SkNEW_ARRAY(SkScalar, kw);
+    fColKernel = SkNEW_ARRAY(SkScalar, kh);
+    memcpy(fRowKernel, row.get(), kw * sizeof(SkScalar));
+    memcpy(fColKernel, col.get(), kh * sizeof(SkScalar));
+    fSeparable = true;
 }
 
 SkMatrixConvolutionImageFilter* SkMatrixConvolutionImageFilter::Create(
@@ -115,6 +164,8 @@ void SkMatrixConvolutionImageFilter::flatten(SkWriteBuffer& buffer) const {
 
 SkMatrixConvolutionImageFilter::~SkMatrixConvolutionImageFilter() {
     delete[] fKernel;
+    delete[] fRowKernel;
+    delete[] fColKernel;
 }
 
 class UncheckedPixelFetcher {
@@ -171,7 +222,9 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
     for (int y = rect.fTop; y < rect.fBottom; ++y) {
         SkPMColor* dptr = result->getAddr32(rect.fLeft - bounds.fLeft, y - bounds.fTop);
         for (int x = rect.fLeft; x < rect.fRight; ++x) {
-            SkScalar sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+            // All four channels accumulate in one Sk4f lane each; the alpha
+            // lane is simply ignored when we're not convolving alpha.
+            Sk4f sum(0);
             for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
                 for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
                     SkPMColor s = PixelFetcher::fetch(src,
@@ -179,20 +232,20 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
                                                       y + cy - fKernelOffset.fY,
                                                       bounds);
                     SkScalar k = fKernel[cy * fKernelSize.fWidth + cx];
-                    if (convolveAlpha) {
-                        sumA += SkScalarMul(SkIntToScalar(SkGetPackedA32(s)), k);
-                    }
-                    sumR += SkScalarMul(SkIntToScalar(SkGetPackedR32(s)), k);
-                    sumG += SkScalarMul(SkIntToScalar(SkGetPackedG32(s)), k);
-                    sumB += SkScalarMul(SkIntToScalar(SkGetPackedB32(s)), k);
+                    sum = sum + Sk4f(SkIntToScalar(SkGetPackedA32(s)),
+                                     SkIntToScalar(SkGetPackedR32(s)),
+                                     SkIntToScalar(SkGetPackedG32(s)),
+                                     SkIntToScalar(SkGetPackedB32(s))) * Sk4f(k);
                 }
             }
+            float argb[4];
+            (sum * Sk4f(fGain) + Sk4f(fBias)).store(argb);
             int a = convolveAlpha
-                  ? SkClampMax(SkScalarFloorToInt(SkScalarMul(sumA, fGain) + fBias), 255)
+                  ? SkClampMax(SkScalarFloorToInt(argb[0]), 255)
                   : 255;
-            int r = SkClampMax(SkScalarFloorToInt(SkScalarMul(sumR, fGain) + fBias), a);
-            int g = SkClampMax(SkScalarFloorToInt(SkScalarMul(sumG, fGain) + fBias), a);
-            int b = SkClampMax(SkScalarFloorToInt(SkScalarMul(sumB, fGain) + fBias), a);
+            int r = SkClampMax(SkScalarFloorToInt(argb[1]), a);
+            int g = SkClampMax(SkScalarFloorToInt(argb[2]), a);
+            int b = SkClampMax(SkScalarFloorToInt(argb[3]), a);
             if (!convolveAlpha) {
                 a = SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
                 *dptr++ = SkPreMultiplyARGB(a, r, g, b);
@@ -215,10 +268,95 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
     }
 }
 
+// Horizontally convolves one source row into four float channels per pixel.
+static void convolve_row(const SkBitmap& src, int srcX, int srcY, int width,
+                         const SkScalar* rowKernel, int kernelWidth, float* dst) {
+    const SkPMColor* sptr = src.getAddr32(srcX, srcY);
+    for (int i = 0; i < width; ++i, ++sptr) {
+        Sk4f sum(0);
+        for (int cx = 0; cx < kernelWidth; ++cx) {
+            SkPMColor s = sptr[cx];
+            sum = sum + Sk4f(SkIntToScalar(SkGetPackedA32(s)),
+                             SkIntToScalar(SkGetPackedR32(s)),
+                             SkIntToScalar(SkGetPackedG32(s)),
+                             SkIntToScalar(SkGetPackedB32(s))) * Sk4f(rowKernel[cx]);
+        }
+        sum.store(dst + 4 * i);
+    }
+}
+
+/**
+ *  Interior fast path for rank-1 kernels: a horizontal pass into a ring
+ *  buffer of float rows, then a vertical combine, turning the O(W*H) inner
+ *  accumulate into O(W + H).  Every fetch lands inside bounds here, so no
+ *  tile-mode handling is needed; the intermediate rows stay in float, which
+ *  keeps the result within rounding distance of the direct convolution.
+ */
+template <bool convolveAlpha>
+void SkMatrixConvolutionImageFilter::filterInteriorPixelsSeparable(const SkBitmap& src,
+                                                                   SkBitmap* result,
+                                                                   const SkIRect& r,
+                                                                   const SkIRect& bounds) const {
+    SkIRect rect(r);
+    if (!rect.intersect(bounds)) {
+        return;
+    }
+    int width = rect.width();
+    int kw = fKernelSize.fWidth;
+    int kh = fKernelSize.fHeight;
+    int srcLeft = rect.fLeft - fKernelOffset.fX;
+    int ringBase = rect.fTop - fKernelOffset.fY;   // source row held in ring slot 0 at the start
+    size_t rowFloats = width * 4;
+    SkAutoTMalloc<float> ring(kh * rowFloats);
+    // Prime the ring with every source row but the last one the first output
+    // row needs; the y loop convolves one new row per output row.
+    for (int i = 0; i < kh - 1; ++i) {
+        convolve_row(src, srcLeft, ringBase + i, width, fRowKernel, kw, &ring[i * rowFloats]);
+    }
+    SkAutoSTMalloc<16, const float*> rows(kh);
+    for (int y = rect.fTop; y < rect.fBottom; ++y) {
+        int newRow = y - fKernelOffset.fY + kh - 1;
+        convolve_row(src, srcLeft, newRow, width, fRowKernel, kw,
+                     &ring[((newRow - ringBase) % kh) * rowFloats]);
+        for (int cy = 0; cy < kh; ++cy) {
+            rows[cy] = &ring[((y - fKernelOffset.fY + cy - ringBase) % kh) * rowFloats];
+        }
+        SkPMColor* dptr = result->getAddr32(rect.fLeft - bounds.fLeft, y - bounds.fTop);
+        for (int x = 0; x < width; ++x) {
+            Sk4f sum(0);
+            for (int cy = 0; cy < kh; ++cy) {
+                sum = sum + Sk4f::Load(rows[cy] + 4 * x) * Sk4f(fColKernel[cy]);
+            }
+            float argb[4];
+            (sum * Sk4f(fGain) + Sk4f(fBias)).store(argb);
+            int a = convolveAlpha
+                  ? SkClampMax(SkScalarFloorToInt(argb[0]), 255)
+                  : 255;
+            int red = SkClampMax(SkScalarFloorToInt(argb[1]), a);
+            int green = SkClampMax(SkScalarFloorToInt(argb[2]), a);
+            int blue = SkClampMax(SkScalarFloorToInt(argb[3]), a);
+            if (!convolveAlpha) {
+                a = SkGetPackedA32(*src.getAddr32(rect.fLeft + x, y));
+                *dptr++ = SkPreMultiplyARGB(a, red, green, blue);
+            } else {
+                *dptr++ = SkPackARGB32(a, red, green, blue);
+            }
+        }
+    }
+}
+
 void SkMatrixConvolutionImageFilter::filterInteriorPixels(const SkBitmap& src,
                                                           SkBitmap* result,
                                                           const SkIRect& rect,
                                                           const SkIRect& bounds) const {
+    if (fSeparable) {
+        if (fConvolveAlpha) {
+            this->filterInteriorPixelsSeparable<true>(src, result, rect, bounds);
+        } else {
+            this->filterInteriorPixelsSeparable<false>(src, result, rect, bounds);
+        }
+        return;
+    }
     filterPixels<UncheckedPixelFetcher>(src, result, rect, bounds);
 }
 
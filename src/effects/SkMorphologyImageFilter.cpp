@@ -6,12 +6,15 @@
  */
 
 #include "SkMorphologyImageFilter.h"
+#include "Sk4px.h"
 #include "SkBitmap.h"
 #include "SkColorPriv.h"
 #include "SkReadBuffer.h"
 #include "SkWriteBuffer.h"
 #include "SkRect.h"
 #include "SkMorphology_opts.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
 #include "GrInvariantOutput.h"
@@ -114,6 +117,158 @@ static void dilate(const SkPMColor* src, SkPMColor* dst,
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The procs above rescan the full window for every pixel, so they cost O(radius)
+// per pixel.  For larger radii we switch to the van Herk/Gil-Werman algorithm,
+// which costs a constant ~3 min/max per pixel regardless of radius: each block
+// of 2*radius+1 rows is scanned once forward (a running prefix) and once
+// backward (a stored suffix), and every output row is one extra min/max of a
+// prefix row with a suffix row.
+//
+// Each pass slides its window vertically and writes its result transposed, so
+// the rows it scans are contiguous and vectorize with Sk4px; running both
+// passes this way morphs both axes and restores the original orientation.
+
+enum MorphType {
+    kErode_MorphType,
+    kDilate_MorphType
+};
+
+template<MorphType type>
+static inline Sk4px morph_op(const Sk4px& a, const Sk4px& b) {
+    return kErode_MorphType == type ? Sk4px(Sk16b::Min(a, b))
+                                    : Sk4px(Sk16b::Max(a, b));
+}
+
+// dst[i] = op(a[i], b[i]) for count pixels.
+template<MorphType type>
+static void morph_row(const SkPMColor* a, const SkPMColor* b, SkPMColor* dst, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        morph_op<type>(Sk4px::Load4(a + i), Sk4px::Load4(b + i)).store4(dst + i);
+    }
+    for (; i < count; i++) {
+        morph_op<type>(Sk4px::Load1(a + i), Sk4px::Load1(b + i)).store1(dst + i);
+    }
+}
+
+// Morphs the columns [xStart, xStop) of a width x height image with a vertical
+// window of 2*radius+1 rows, writing each output pixel (x, y) to
+// dst[x * dstStride + y].  Rows outside the image behave as the op's neutral
+// value, which matches the window clamping the sliding procs above do.
+template<MorphType type>
+static void morph_strip(const SkPMColor* src, int srcStride,
+                        SkPMColor* dst, int dstStride,
+                        int radius, int height, int xStart, int xStop) {
+    const int count = xStop - xStart;
+    const int window = 2 * radius + 1;
+
+    // Suffix rows for the previous and current block: row j holds the op over
+    // block rows [j, window).  Row `window` stays neutral so that outputs whose
+    // window begins exactly on a block boundary come entirely from the prefix.
+    SkAutoTMalloc<SkPMColor> storage((2 * (window + 1) + 2) * count);
+    SkPMColor* prevSuffix = storage.get();
+    SkPMColor* curSuffix = prevSuffix + (window + 1) * count;
+    SkPMColor* prefix = curSuffix + (window + 1) * count;
+    SkPMColor* outRow = prefix + count;
+    memset(storage.get(), kErode_MorphType == type ? 0xFF : 0x00,
+           2 * (window + 1) * count * sizeof(SkPMColor));
+
+    src += xStart;
+    const int numBlocks = (height + 2 * radius + window - 1) / window;
+    for (int b = 0; b < numBlocks; b++) {
+        const int blockStart = b * window - radius;
+        // Backward scan: suffixes of the current block.
+        for (int j = window - 1; j >= 0; j--) {
+            const int row = blockStart + j;
+            if ((unsigned)row < (unsigned)height) {
+                morph_row<type>(src + row * srcStride, curSuffix + (j + 1) * count,
+                                curSuffix + j * count, count);
+            } else {
+                memcpy(curSuffix + j * count, curSuffix + (j + 1) * count,
+                       count * sizeof(SkPMColor));
+            }
+        }
+        // Forward scan: running prefix, combined with the previous block's
+        // suffix to finish the output row whose window ends here.
+        memset(prefix, kErode_MorphType == type ? 0xFF : 0x00, count * sizeof(SkPMColor));
+        for (int j = 0; j < window; j++) {
+            const int row = blockStart + j;
+            if ((unsigned)row < (unsigned)height) {
+                morph_row<type>(prefix, src + row * srcStride, prefix, count);
+            }
+            const int y = blockStart + j - radius;
+            if ((unsigned)y < (unsigned)height) {
+                morph_row<type>(prevSuffix + (j + 1) * count, prefix, outRow, count);
+                SkPMColor* d = dst + xStart * dstStride + y;
+                for (int i = 0; i < count; i++) {
+                    d[i * dstStride] = outRow[i];
+                }
+            }
+        }
+        SkTSwap(prevSuffix, curSuffix);
+    }
+}
+
+typedef void (*MorphStripProc)(const SkPMColor* src, int srcStride,
+                               SkPMColor* dst, int dstStride,
+                               int radius, int height, int xStart, int xStop);
+
+struct MorphPassChunk {
+    MorphStripProc  fProc;
+    const SkPMColor* fSrc;
+    int              fSrcStride;
+    SkPMColor*       fDst;
+    int              fDstStride;
+    int              fRadius;
+    int              fHeight;
+    int              fXStart;
+    int              fXStop;
+};
+
+static void run_morph_chunk(MorphPassChunk* chunk) {
+    chunk->fProc(chunk->fSrc, chunk->fSrcStride, chunk->fDst, chunk->fDstStride,
+                 chunk->fRadius, chunk->fHeight, chunk->fXStart, chunk->fXStop);
+}
+
+// One van Herk/Gil-Werman pass over a width x height image, writing transposed.
+// Columns are independent, so they're carved into strips run on SkTaskGroup.
+template<MorphType type>
+static void morph_pass(const SkPMColor* src, int srcStride,
+                       SkPMColor* dst, int dstStride,
+                       int radius, int width, int height) {
+    radius = SkMin32(radius, height - 1);
+
+    static const int kMinColsPerChunk = 64;
+    static const int kMaxChunks = 16;
+    const int chunkCount = SkMin32(width / kMinColsPerChunk, kMaxChunks);
+    if (chunkCount <= 1) {
+        morph_strip<type>(src, srcStride, dst, dstStride, radius, height, 0, width);
+        return;
+    }
+    MorphPassChunk chunks[kMaxChunks];
+    for (int i = 0; i < chunkCount; i++) {
+        MorphPassChunk* chunk = &chunks[i];
+        chunk->fProc = morph_strip<type>;
+        chunk->fSrc = src;
+        chunk->fSrcStride = srcStride;
+        chunk->fDst = dst;
+        chunk->fDstStride = dstStride;
+        chunk->fRadius = radius;
+        chunk->fHeight = height;
+        chunk->fXStart = width * i / chunkCount;
+        chunk->fXStop = width * (i + 1) / chunkCount;
+    }
+    SkTaskGroup().batch(run_morph_chunk, chunks, chunkCount);
+}
+
+// Below this, the sliding-window procs win: they touch each pixel once, while
+// the two transposing passes cost roughly six min/max ops plus a scattered
+// store per pixel no matter the radius.
+static const int kMinRadiusForVanHerk = 8;
+
+///////////////////////////////////////////////////////////////////////////////
+
 static void callProcX(SkMorphologyImageFilter::Proc procX, const SkBitmap& src, SkBitmap* dst, int radiusX, const SkIRect& bounds)
 {
     procX(src.getAddr32(bounds.left(), bounds.top()), dst->getAddr32(0, 0),
@@ -128,7 +283,8 @@ static void callProcY(SkMorphologyImageFilter::Proc procY, const SkBitmap& src,
           src.rowBytesAsPixels(), dst->rowBytesAsPixels());
 }
 
-bool SkMorphologyImageFilter::filterImageGeneric(SkMorphologyImageFilter::Proc procX,
+bool SkMorphologyImageFilter::filterImageGeneric(bool dilate,
+                                                 SkMorphologyImageFilter::Proc procX,
                                                  SkMorphologyImageFilter::Proc procY,
                                                  Proxy* proxy,
                                                  const SkBitmap& source,
@@ -184,7 +340,21 @@ bool SkMorphologyImageFilter::filterImageGeneric(SkMorphologyImageFilter::Proc p
         return false;
     }
 
-    if (width > 0 && height > 0) {
+    if (SkMax32(width, height) >= kMinRadiusForVanHerk) {
+        // Two transposing van Herk/Gil-Werman passes: the first morphs the y
+        // axis and leaves temp transposed, the second morphs the (original) x
+        // axis and transposes back.  A zero radius pass is just a transpose,
+        // so single-axis filters take the same route.  temp holds at least
+        // w*h pixels, which is all the transposed layout needs.
+        void (*pass)(const SkPMColor*, int, SkPMColor*, int, int, int, int) =
+                dilate ? morph_pass<kDilate_MorphType> : morph_pass<kErode_MorphType>;
+        const int w = srcBounds.width();
+        const int h = srcBounds.height();
+        pass(src.getAddr32(srcBounds.left(), srcBounds.top()), src.rowBytesAsPixels(),
+             temp.getAddr32(0, 0), h, height, w, h);
+        pass(temp.getAddr32(0, 0), h,
+             dst->getAddr32(0, 0), dst->rowBytesAsPixels(), width, h, w);
+    } else if (width > 0 && height > 0) {
         callProcX(procX, src, &temp, width, srcBounds);
         SkIRect tmpBounds = SkIRect::MakeWH(srcBounds.width(), srcBounds.height());
         callProcY(procY, temp, dst, height, tmpBounds);
@@ -209,7 +379,7 @@ bool SkErodeImageFilter::onFilterImage(Proxy* proxy,
     if (!erodeYProc) {
         erodeYProc = erode<kY>;
     }
-    return this->filterImageGeneric(erodeXProc, erodeYProc, proxy, source, ctx, dst, offset);
+    return this->filterImageGeneric(false, erodeXProc, erodeYProc, proxy, source, ctx, dst, offset);
 }
 
 bool SkDilateImageFilter::onFilterImage(Proxy* proxy,
@@ -223,7 +393,7 @@ bool SkDilateImageFilter::onFilterImage(Proxy* proxy,
     if (!dilateYProc) {
         dilateYProc = dilate<kY>;
     }
-    return this->filterImageGeneric(dilateXProc, dilateYProc, proxy, source, ctx, dst, offset);
+    return this->filterImageGeneric(true, dilateXProc, dilateYProc, proxy, source, ctx, dst, offset);
 }
 
 void SkMorphologyImageFilter::computeFastBounds(const SkRect& src, SkRect* dst) const {
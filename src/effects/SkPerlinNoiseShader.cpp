@@ -6,6 +6,7 @@
  */
 
 #include "SkDither.h"
+#include "SkNx.h"
 #include "SkPerlinNoiseShader.h"
 #include "SkColorFilter.h"
 #include "SkReadBuffer.h"
@@ -427,6 +428,127 @@ SkPMColor SkPerlinNoiseShader::PerlinNoiseShaderContext::shade(
     return SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
 }
 
+// Shades four consecutive pixels at once with Sk4f, fusing the four per-channel octave loops
+// of the scalar path into a single walk over the octaves. The lattice indices only depend on
+// the sample position (not the channel), so they are computed once per octave; only the
+// gradient fetches and the interpolation differ per channel.
+void SkPerlinNoiseShader::PerlinNoiseShaderContext::shade4(
+        const SkPoint& point, StitchData& stitchData, SkPMColor result[4]) const {
+    const SkPerlinNoiseShader& perlinNoiseShader = static_cast<const SkPerlinNoiseShader&>(fShader);
+    SkPoint newPoint;
+    fMatrix.mapPoints(&newPoint, &point, 1);
+    newPoint.fX = SkScalarRoundToScalar(newPoint.fX);
+    newPoint.fY = SkScalarRoundToScalar(newPoint.fY);
+
+    if (perlinNoiseShader.fStitchTiles) {
+        // Set up TurbulenceInitial stitch values.
+        stitchData = fPaintingData->fStitchDataInit;
+    }
+
+    // fMatrix is a pure translation, so the four mapped sample positions are consecutive in x.
+    Sk4f noiseVectorX = (Sk4f(newPoint.x()) + Sk4f(0, 1, 2, 3)) *
+                        Sk4f(fPaintingData->fBaseFrequency.fX);
+    SkScalar noiseVectorY = SkScalarMul(newPoint.y(), fPaintingData->fBaseFrequency.fY);
+
+    Sk4f turbulence[4] = { Sk4f(0), Sk4f(0), Sk4f(0), Sk4f(0) };
+    SkScalar ratio = SK_Scalar1;
+    for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
+        // The y lattice coordinates and fade factor are shared by all four pixels.
+        SkScalar positionY = noiseVectorY + kPerlinNoise;
+        int intY = SkScalarFloorToInt(positionY);
+        SkScalar fracY = positionY - SkIntToScalar(intY);
+        int nextY = intY + 1;
+        if (perlinNoiseShader.fStitchTiles) {
+            intY  = checkNoise(intY,  stitchData.fWrapY, stitchData.fHeight);
+            nextY = checkNoise(nextY, stitchData.fWrapY, stitchData.fHeight);
+        }
+        intY  &= kBlockMask;
+        nextY &= kBlockMask;
+
+        float positionX[4];
+        (noiseVectorX + Sk4f(SkIntToScalar(kPerlinNoise))).store(positionX);
+        float fracX[4];
+        int b00[4], b10[4], b01[4], b11[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            int intX = SkScalarFloorToInt(positionX[lane]);
+            fracX[lane] = positionX[lane] - SkIntToScalar(intX);
+            int nextX = intX + 1;
+            if (perlinNoiseShader.fStitchTiles) {
+                intX  = checkNoise(intX,  stitchData.fWrapX, stitchData.fWidth);
+                nextX = checkNoise(nextX, stitchData.fWrapX, stitchData.fWidth);
+            }
+            int i = fPaintingData->fLatticeSelector[intX  & kBlockMask];
+            int j = fPaintingData->fLatticeSelector[nextX & kBlockMask];
+            b00[lane] = (i + intY)  & kBlockMask;
+            b10[lane] = (j + intY)  & kBlockMask;
+            b01[lane] = (i + nextY) & kBlockMask;
+            b11[lane] = (j + nextY) & kBlockMask;
+        }
+
+        Sk4f fx = Sk4f::Load(fracX);
+        Sk4f fx1 = fx - Sk4f(SK_Scalar1);
+        Sk4f sx = fx * fx * (Sk4f(3) - Sk4f(2) * fx);  // smoothCurve()
+        Sk4f fy(fracY), fy1(fracY - SK_Scalar1);
+        Sk4f sy(smoothCurve(fracY));
+        Sk4f invRatio(SkScalarInvert(ratio));  // Exact: ratio is a power of two.
+
+        for (int channel = 0; channel < 4; ++channel) {
+            const SkPoint* gradient = fPaintingData->fGradient[channel];
+            float gx00[4], gy00[4], gx10[4], gy10[4], gx01[4], gy01[4], gx11[4], gy11[4];
+            for (int lane = 0; lane < 4; ++lane) {
+                gx00[lane] = gradient[b00[lane]].fX; gy00[lane] = gradient[b00[lane]].fY;
+                gx10[lane] = gradient[b10[lane]].fX; gy10[lane] = gradient[b10[lane]].fY;
+                gx01[lane] = gradient[b01[lane]].fX; gy01[lane] = gradient[b01[lane]].fY;
+                gx11[lane] = gradient[b11[lane]].fX; gy11[lane] = gradient[b11[lane]].fY;
+            }
+            Sk4f u = Sk4f::Load(gx00) * fx  + Sk4f::Load(gy00) * fy;  // Offset (0,0)
+            Sk4f v = Sk4f::Load(gx10) * fx1 + Sk4f::Load(gy10) * fy;  // Offset (-1,0)
+            Sk4f a = u + sx * (v - u);
+            v = Sk4f::Load(gx11) * fx1 + Sk4f::Load(gy11) * fy1;      // Offset (-1,-1)
+            u = Sk4f::Load(gx01) * fx  + Sk4f::Load(gy01) * fy1;      // Offset (0,-1)
+            Sk4f b = u + sx * (v - u);
+            Sk4f noise = a + sy * (b - a);
+            if (perlinNoiseShader.fType != kFractalNoise_Type) {
+                noise = Sk4f::Max(noise, Sk4f(0) - noise);  // abs()
+            }
+            turbulence[channel] = turbulence[channel] + noise * invRatio;
+        }
+
+        noiseVectorX = noiseVectorX + noiseVectorX;
+        noiseVectorY *= 2;
+        ratio *= 2;
+        if (perlinNoiseShader.fStitchTiles) {
+            // Update stitch values
+            stitchData.fWidth  *= 2;
+            stitchData.fWrapX   = stitchData.fWidth + kPerlinNoise;
+            stitchData.fHeight *= 2;
+            stitchData.fWrapY   = stitchData.fHeight + kPerlinNoise;
+        }
+    }
+
+    int rgba[4][4];
+    for (int channel = 3; channel >= 0; --channel) {
+        Sk4f t = turbulence[channel];
+        if (perlinNoiseShader.fType == kFractalNoise_Type) {
+            t = t * Sk4f(SK_ScalarHalf) + Sk4f(SK_ScalarHalf);
+        }
+        if (channel == 3) { // Scale alpha by paint value
+            t = t * Sk4f(SkIntToScalar(this->getPaintAlpha()) / 255);
+        }
+        // Clamp result
+        t = Sk4f::Max(Sk4f(0), Sk4f::Min(t, Sk4f(SK_Scalar1))) * Sk4f(255);
+        float vals[4];
+        t.store(vals);
+        for (int lane = 0; lane < 4; ++lane) {
+            rgba[channel][lane] = SkScalarFloorToInt(vals[lane]);
+        }
+    }
+    for (int lane = 0; lane < 4; ++lane) {
+        result[lane] = SkPreMultiplyARGB(rgba[3][lane], rgba[0][lane],
+                                         rgba[1][lane], rgba[2][lane]);
+    }
+}
+
 SkShader::Context* SkPerlinNoiseShader::onCreateContext(const ContextRec& rec,
                                                         void* storage) const {
     return SkNEW_PLACEMENT_ARGS(storage, PerlinNoiseShaderContext, (*this, rec));
@@ -459,7 +581,12 @@ void SkPerlinNoiseShader::PerlinNoiseShaderContext::shadeSpan(
         int x, int y, SkPMColor result[], int count) {
     SkPoint point = SkPoint::Make(SkIntToScalar(x), SkIntToScalar(y));
     StitchData stitchData;
-    for (int i = 0; i < count; ++i) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        shade4(point, stitchData, result + i);
+        point.fX += SkIntToScalar(4);
+    }
+    for (; i < count; ++i) {
         result[i] = shade(point, stitchData);
         point.fX += SK_Scalar1;
     }
@@ -40,6 +40,7 @@ public:
             memcpy(dst, tableB, 256);
             fFlags |= kB_Flag;
         }
+        this->initTables();
     }
 
     virtual ~SkTable_ColorFilter() {
@@ -54,6 +55,7 @@ public:
 #endif
 
     void filterSpan(const SkPMColor src[], int count, SkPMColor dst[]) const override;
+    SpanProc asSpanProc(const void** ctx) const override;
 
     SK_TO_STRING_OVERRIDE()
 
@@ -72,7 +74,10 @@ protected:
 private:
     mutable const SkBitmap* fBitmap; // lazily allocated
 
+    void initTables();
+
     uint8_t fStorage[256 * 4];
+    const uint8_t* fTables[4];  // a, r, g, b; resolved against fStorage/gIdentityTable once
     unsigned fFlags;
 
     friend class SkTableColorFilter;
@@ -115,24 +120,28 @@ static const uint8_t gIdentityTable[] = {
     0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
 };
 
-void SkTable_ColorFilter::filterSpan(const SkPMColor src[], int count, SkPMColor dst[]) const {
+void SkTable_ColorFilter::initTables() {
     const uint8_t* table = fStorage;
-    const uint8_t* tableA = gIdentityTable;
-    const uint8_t* tableR = gIdentityTable;
-    const uint8_t* tableG = gIdentityTable;
-    const uint8_t* tableB = gIdentityTable;
+    fTables[0] = fTables[1] = fTables[2] = fTables[3] = gIdentityTable;
     if (fFlags & kA_Flag) {
-        tableA = table; table += 256;
+        fTables[0] = table; table += 256;
     }
     if (fFlags & kR_Flag) {
-        tableR = table; table += 256;
+        fTables[1] = table; table += 256;
     }
     if (fFlags & kG_Flag) {
-        tableG = table; table += 256;
+        fTables[2] = table; table += 256;
     }
     if (fFlags & kB_Flag) {
-        tableB = table;
+        fTables[3] = table;
     }
+}
+
+void SkTable_ColorFilter::filterSpan(const SkPMColor src[], int count, SkPMColor dst[]) const {
+    const uint8_t* tableA = fTables[0];
+    const uint8_t* tableR = fTables[1];
+    const uint8_t* tableG = fTables[2];
+    const uint8_t* tableB = fTables[3];
 
     const SkUnPreMultiply::Scale* scaleTable = SkUnPreMultiply::GetScaleTable();
     for (int i = 0; i < count; ++i) {
@@ -158,6 +167,15 @@ void SkTable_ColorFilter::filterSpan(const SkPMColor src[], int count, SkPMColor
     }
 }
 
+static void table_span_proc(const void* ctx, const SkPMColor src[], int count, SkPMColor dst[]) {
+    static_cast<const SkTable_ColorFilter*>(ctx)->SkTable_ColorFilter::filterSpan(src, count, dst);
+}
+
+SkColorFilter::SpanProc SkTable_ColorFilter::asSpanProc(const void** ctx) const {
+    *ctx = this;
+    return table_span_proc;
+}
+
 #ifndef SK_IGNORE_TO_STRING
 void SkTable_ColorFilter::toString(SkString* str) const {
     const uint8_t* table = fStorage;
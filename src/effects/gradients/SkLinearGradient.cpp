@@ -6,6 +6,8 @@
  */
 
 #include "SkLinearGradient.h"
+#include "SkNx.h"
+#include "SkPMFloat.h"
 
 static inline int repeat_bits(int x, const int bits) {
     return x & ((1 << bits) - 1);
@@ -100,6 +102,55 @@ SkLinearGradient::LinearGradientContext::LinearGradientContext(
             fFlags |= SkShader::kConstInY16_Flag;
         }
     }
+
+    // Set up the color-stop intervals for the analytic evaluator, when
+    // shadeSpan will be able to use it (see the gate at the top of shadeSpan).
+    fRecCount = 0;
+    fApplyAlphaAfterInterp = false;
+    if (shader.fColorCount >= 2 && shader.fColorCount <= kMaxIntervalColorCount &&
+        SkShader::kClamp_TileMode == shader.fTileMode &&
+        kLinear_MatrixClass == fDstToIndexClass)
+    {
+        const int count = shader.fColorCount;
+        Rec* recs = fRecs.reset(count);
+        if (shader.fOrigPos) {
+            recs[0].fPos = 0;
+            recs[0].fPosScale = 0;  // should never be used
+            for (int i = 1; i < count; i++) {
+                // Force the positions to be monotonic so the interval search
+                // can rely on it. An out-of-order segment gets a zero scale,
+                // just as it gets a zero fScale in the base class' Rec table.
+                recs[i].fPos = SkScalarPin(shader.fOrigPos[i], recs[i - 1].fPos, SK_Scalar1);
+                float diff = recs[i].fPos - recs[i - 1].fPos;
+                recs[i].fPosScale = diff > 0 ? 1.0f / diff : 0;
+            }
+            recs[count - 1].fPos = 1;   // make sure we end exactly at 1
+        } else {
+            const float scale = float(count - 1);
+            const float invScale = 1.0f / scale;
+            for (int i = 0; i < count; i++) {
+                recs[i].fPos = i * invScale;
+                recs[i].fPosScale = scale;
+            }
+        }
+
+        // If everything is opaque (or the caller asked for premul interpolation)
+        // we can lerp premultiplied values directly; otherwise we lerp unpremul
+        // and premultiply as we write, to match what the cache builder does.
+        fApplyAlphaAfterInterp = !shader.isOpaque() &&
+            !(shader.getGradFlags() & SkGradientShader::kInterpolateColorsInPremul_Flag);
+
+        const float paintAlpha = this->getPaintAlpha() * (1.0f / 255);
+        for (int i = 0; i < count; i++) {
+            SkColor c = shader.fOrigColors[i];
+            float a = SkColorGetA(c) * paintAlpha;
+            float scale = fApplyAlphaAfterInterp ? 1.0f : a * (1.0f / 255);
+            SkPMFloat(a, SkColorGetR(c) * scale,
+                         SkColorGetG(c) * scale,
+                         SkColorGetB(c) * scale).store(recs[i].fColor);
+        }
+        fRecCount = count;
+    }
 }
 
 #define NO_CHECK_ITER               \
@@ -209,12 +260,246 @@ void shadeSpan_linear_repeat(TileProc proc, SkGradFixed dx, SkGradFixed fx,
 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The analytic (interval) evaluator: walk the color stops directly and lerp
+// with Sk4f, rather than gathering from the 256-entry cache per pixel.
+
+namespace {
+
+typedef SkLinearGradient::LinearGradientContext::Rec GradRec;
+
+// Find the interval containing tiledX, scanning forward from rec. The recs
+// are monotonic in fPos, starting at 0 and ending at 1, so this terminates.
+const GradRec* find_forward(const GradRec rec[], float tiledX) {
+    SkASSERT(tiledX >= 0 && tiledX <= 1);
+    rec += 1;
+    while (rec->fPos < tiledX) {
+        rec += 1;
+    }
+    return rec - 1;
+}
+
+const GradRec* find_backward(const GradRec rec[], float tiledX) {
+    SkASSERT(tiledX >= 0 && tiledX <= 1);
+    while (rec->fPos > tiledX) {
+        rec -= 1;
+    }
+    return rec;
+}
+
+// Truncate [0...255] component floats down to an SkPMColor. When apply_alpha
+// is set the components are unpremul, and get premultiplied on the way out.
+template <bool apply_alpha> SkPMColor trunc_from_255(const Sk4f& x) {
+    if (!apply_alpha) {
+        return SkPMFloat(x).trunc();
+    }
+    float c[4];
+    x.store(c);
+    return SkPreMultiplyARGB((U8CPU)c[SK_A32_SHIFT / 8], (U8CPU)c[SK_R32_SHIFT / 8],
+                             (U8CPU)c[SK_G32_SHIFT / 8], (U8CPU)c[SK_B32_SHIFT / 8]);
+}
+
+template <bool apply_alpha> void fill(SkPMColor dst[], int count,
+                                      const Sk4f& c4, const Sk4f& c4other) {
+    sk_memset32_dither(dst, trunc_from_255<apply_alpha>(c4),
+                       trunc_from_255<apply_alpha>(c4other), count);
+}
+
+// Write out n pixels of c, c+dc, c+2dc, ... with the dither bias pre-added.
+template <bool apply_alpha> void ramp(SkPMColor dstC[], int n, const Sk4f& c, const Sk4f& dc,
+                                      const Sk4f& dither0, const Sk4f& dither1) {
+    Sk4f dc2 = dc + dc;
+    Sk4f cd0 = c + dither0;
+    Sk4f cd1 = c + dc + dither1;
+    while (n >= 2) {
+        *dstC++ = trunc_from_255<apply_alpha>(cd0);
+        *dstC++ = trunc_from_255<apply_alpha>(cd1);
+        cd0 = cd0 + dc2;
+        cd1 = cd1 + dc2;
+        n -= 2;
+    }
+    if (n & 1) {
+        *dstC++ = trunc_from_255<apply_alpha>(cd0);
+    }
+}
+
+Sk4f lerp_color(float fx, const GradRec* r) {
+    SkASSERT(fx >= r[0].fPos);
+    const Sk4f c0 = Sk4f::Load(r[0].fColor);
+    const Sk4f diffc = Sk4f::Load(r[1].fColor) - c0;
+    return c0 + Sk4f((fx - r[0].fPos) * r[1].fPosScale) * diffc;
+}
+
+}   // namespace
+
+template <bool apply_alpha, bool dx_is_pos>
+void SkLinearGradient::LinearGradientContext::shade4_dx_clamp(SkPMColor dstC[], int count,
+                                                              float fx, float dx, float invDx,
+                                                              const float dither[2]) {
+    Sk4f dither0(dither[0]);
+    Sk4f dither1(dither[1]);
+    const Rec* recs = fRecs.get();
+
+    SkDEBUGCODE(SkPMColor* endDstC = dstC + count;)
+
+    if (dx_is_pos) {
+        if (fx < 0) {
+            // pixels that stay clamped to the first color
+            int n = SkTMin(SkScalarFloorToInt(-fx * invDx) + 1, count);
+            fill<apply_alpha>(dstC, n, Sk4f::Load(recs[0].fColor) + dither0,
+                                       Sk4f::Load(recs[0].fColor) + dither1);
+            count -= n;
+            dstC += n;
+            fx += n * dx;
+            SkASSERT(0 == count || fx >= 0);
+            if (n & 1) {
+                SkTSwap(dither0, dither1);
+            }
+        }
+    } else {
+        if (fx > 1) {
+            // pixels that stay clamped to the last color
+            int n = SkTMin(SkScalarFloorToInt((1 - fx) * invDx) + 1, count);
+            fill<apply_alpha>(dstC, n, Sk4f::Load(recs[fRecCount - 1].fColor) + dither0,
+                                       Sk4f::Load(recs[fRecCount - 1].fColor) + dither1);
+            count -= n;
+            dstC += n;
+            fx += n * dx;
+            SkASSERT(0 == count || fx <= 1);
+            if (n & 1) {
+                SkTSwap(dither0, dither1);
+            }
+        }
+    }
+    SkASSERT(count >= 0);
+
+    const Rec* r;
+    if (dx_is_pos) {
+        r = recs;                   // start the search at the beginning
+    } else {
+        r = recs + fRecCount - 2;   // ... or the end
+    }
+
+    while (count > 0) {
+        if (dx_is_pos) {
+            if (fx >= 1) {
+                fill<apply_alpha>(dstC, count, Sk4f::Load(recs[fRecCount - 1].fColor) + dither0,
+                                               Sk4f::Load(recs[fRecCount - 1].fColor) + dither1);
+                return;
+            }
+            r = find_forward(r, fx);
+        } else {
+            if (fx <= 0) {
+                fill<apply_alpha>(dstC, count, Sk4f::Load(recs[0].fColor) + dither0,
+                                               Sk4f::Load(recs[0].fColor) + dither1);
+                return;
+            }
+            r = find_backward(r, fx);
+        }
+        SkASSERT(r >= recs && r < recs + fRecCount - 1);
+
+        const float p0 = r[0].fPos;
+        const float p1 = r[1].fPos;
+        const Sk4f c0 = Sk4f::Load(r[0].fColor);
+        const Sk4f diffc = Sk4f::Load(r[1].fColor) - c0;
+        const float scale = r[1].fPosScale;
+
+        Sk4f c = c0 + Sk4f((fx - p0) * scale) * diffc;
+        const Sk4f dc = diffc * Sk4f(dx * scale);
+
+        int n;
+        if (dx_is_pos) {
+            n = SkTMin(SkScalarFloorToInt((p1 - fx) * invDx) + 1, count);
+        } else {
+            n = SkTMin(SkScalarFloorToInt((p0 - fx) * invDx) + 1, count);
+        }
+        SkASSERT(n > 0);
+
+        fx += n * dx;
+        // Float precision can leave fx just shy of the boundary; pin it so
+        // the interval search above keeps making progress.
+        if (dx_is_pos) {
+            fx = SkTMax(fx, p1);
+        } else {
+            fx = SkTMin(fx, p0);
+        }
+
+        ramp<apply_alpha>(dstC, n, c, dc, dither0, dither1);
+        dstC += n;
+        SkASSERT(dstC <= endDstC);
+
+        if (n & 1) {
+            SkTSwap(dither0, dither1);
+        }
+        count -= n;
+        SkASSERT(count >= 0);
+    }
+}
+
+void SkLinearGradient::LinearGradientContext::shade4_clamp(int x, int y, SkPMColor dstC[],
+                                                           int count, float fx, float dx) {
+    SkASSERT(count > 0);
+    SkASSERT(fRecCount > 0);
+
+    // The cache path dithers with a 2x2 cell; bias by the matching amounts
+    // here (and truncate when we pack) so the two paths stay in step.
+    static const float gDitherCell[] = {
+        1/8.0f,  5/8.0f,
+        7/8.0f,  3/8.0f,
+    };
+    const int rowIndex = (y & 1) << 1;
+    const float dither[2] = {
+        gDitherCell[rowIndex + (x & 1)],
+        gDitherCell[rowIndex + ((x + 1) & 1)],
+    };
+
+    if (SkScalarNearlyZero(dx * count)) {   // gradient is vertical
+        const float pinFx = SkScalarPin(fx, 0, SK_Scalar1);
+        Sk4f c = lerp_color(pinFx, find_forward(fRecs.get(), pinFx));
+        if (fApplyAlphaAfterInterp) {
+            fill<true>(dstC, count, c + Sk4f(dither[0]), c + Sk4f(dither[1]));
+        } else {
+            fill<false>(dstC, count, c + Sk4f(dither[0]), c + Sk4f(dither[1]));
+        }
+        return;
+    }
+
+    SkASSERT(0 != dx);
+    const float invDx = 1 / dx;
+    if (dx > 0) {
+        if (fApplyAlphaAfterInterp) {
+            this->shade4_dx_clamp<true, true>(dstC, count, fx, dx, invDx, dither);
+        } else {
+            this->shade4_dx_clamp<false, true>(dstC, count, fx, dx, invDx, dither);
+        }
+    } else {
+        if (fApplyAlphaAfterInterp) {
+            this->shade4_dx_clamp<true, false>(dstC, count, fx, dx, invDx, dither);
+        } else {
+            this->shade4_dx_clamp<false, false>(dstC, count, fx, dx, invDx, dither);
+        }
+    }
+}
+
 void SkLinearGradient::LinearGradientContext::shadeSpan(int x, int y, SkPMColor* SK_RESTRICT dstC,
                                                         int count) {
     SkASSERT(count > 0);
 
     const SkLinearGradient& linearGradient = static_cast<const SkLinearGradient&>(fShader);
 
+    if (fRecCount > 0) {
+        SkASSERT(kLinear_MatrixClass == fDstToIndexClass);
+        SkPoint pt;
+        fDstToIndexProc(fDstToIndex, SkIntToScalar(x) + SK_ScalarHalf,
+                        SkIntToScalar(y) + SK_ScalarHalf, &pt);
+        const float fx = pt.fX;
+        const float dx = fDstToIndex.getScaleX();
+        if (SkScalarIsFinite(fx) && SkScalarIsFinite(dx)) {
+            this->shade4_clamp(x, y, dstC, count, fx, dx);
+            return;
+        }
+    }
+
     SkPoint             srcPt;
     SkMatrix::MapXYProc dstProc = fDstToIndexProc;
     TileProc            proc = linearGradient.fTileProc;
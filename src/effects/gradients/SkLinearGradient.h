@@ -24,7 +24,29 @@ public:
         void shadeSpan(int x, int y, SkPMColor dstC[], int count) override;
         void shadeSpan16(int x, int y, uint16_t dstC[], int count) override;
 
+        // One color stop for the analytic (no-LUT) evaluator. fColor holds the
+        // components in SkPMColor order, each in [0...255].
+        struct Rec {
+            float   fColor[4];
+            float   fPos;       // 0...1
+            float   fPosScale;  // 1 / (fPos - prev.fPos), or 0 to skip the segment
+        };
+
     private:
+        enum {
+            // Beyond this many stops the interval walk starts to lose to the
+            // table lookup, and gradients that big are rare anyway.
+            kMaxIntervalColorCount = 8
+        };
+        SkAutoSTMalloc<kMaxIntervalColorCount, Rec> fRecs;
+        int     fRecCount;  // 0 when the analytic evaluator doesn't apply
+        bool    fApplyAlphaAfterInterp;
+
+        void shade4_clamp(int x, int y, SkPMColor dstC[], int count, float fx, float dx);
+        template <bool apply_alpha, bool dx_is_pos>
+        void shade4_dx_clamp(SkPMColor dstC[], int count, float fx, float dx, float invDx,
+                             const float dither[2]);
+
         typedef SkGradientShaderBase::GradientShaderBaseContext INHERITED;
     };
 
@@ -9,6 +9,7 @@
 #include "SkRadialGradient.h"
 #include "SkRadialGradient_Table.h"
 #include "SkNx.h"
+#include "SkPMFloat.h"
 
 #define kSQRT_TABLE_BITS    11
 #define kSQRT_TABLE_SIZE    (1 << kSQRT_TABLE_BITS)
@@ -163,10 +164,6 @@ SkShader::Context* SkRadialGradient::onCreateContext(const ContextRec& rec, void
     return SkNEW_PLACEMENT_ARGS(storage, RadialGradientContext, (*this, rec));
 }
 
-SkRadialGradient::RadialGradientContext::RadialGradientContext(
-        const SkRadialGradient& shader, const ContextRec& rec)
-    : INHERITED(shader, rec) {}
-
 void SkRadialGradient::RadialGradientContext::shadeSpan16(int x, int y, uint16_t* dstCParam,
                                                           int count) {
     SkASSERT(count > 0);
@@ -375,8 +372,142 @@ void shadeSpan_radial_repeat(SkScalar fx, SkScalar dx, SkScalar fy, SkScalar dy,
     shadeSpan_radial<repeat_tileproc_nonstatic>(fx, dx, fy, dy, dstC, cache, count, toggle);
 }
 
+typedef SkRadialGradient::RadialGradientContext::Rec RadialRec;
+
+// Truncate [0...255] component floats down to an SkPMColor, premultiplying on
+// the way out when the stops were interpolated unpremultiplied.
+template <bool apply_alpha> SkPMColor radial_trunc_from_255(const Sk4f& x) {
+    if (!apply_alpha) {
+        return SkPMFloat(x).trunc();
+    }
+    float c[4];
+    x.store(c);
+    return SkPreMultiplyARGB((U8CPU)c[SK_A32_SHIFT / 8], (U8CPU)c[SK_R32_SHIFT / 8],
+                             (U8CPU)c[SK_G32_SHIFT / 8], (U8CPU)c[SK_B32_SHIFT / 8]);
+}
+
+// Compile-time specialized evaluator for tiny clamp gradients: computes the
+// radius four pixels at a time with Sk4f and lerps the stop colors directly,
+// never touching fCache32.
+template <int stop_count, bool apply_alpha>
+void shadeSpan_radial_clamp_analytic(const RadialRec recs[], int x, int y,
+                                     SkScalar sfx, SkScalar sdx, SkScalar sfy, SkScalar sdy,
+                                     SkPMColor* SK_RESTRICT dstC, int count) {
+    // Same 2x2 dither cell as the analytic linear evaluator.
+    static const float gDitherCell[] = {
+        1/8.0f,  5/8.0f,
+        7/8.0f,  3/8.0f,
+    };
+    const int rowIndex = (y & 1) << 1;
+    const float dither[2] = {
+        gDitherCell[rowIndex + (x & 1)],
+        gDitherCell[rowIndex + ((x + 1) & 1)],
+    };
+
+    const Sk4f c0 = Sk4f::Load(recs[0].fColor);
+    const Sk4f d0 = Sk4f::Load(recs[1].fColor) - c0;
+
+    if (radial_completely_pinned(sfx, sdx, sfy, sdy)) {
+        const Sk4f last = Sk4f::Load(recs[stop_count - 1].fColor);
+        sk_memset32_dither(dstC,
+                           radial_trunc_from_255<apply_alpha>(last + Sk4f(dither[0])),
+                           radial_trunc_from_255<apply_alpha>(last + Sk4f(dither[1])),
+                           count);
+        return;
+    }
+
+    const Sk4f fx4(sfx, sfx + sdx, sfx + 2*sdx, sfx + 3*sdx);
+    const Sk4f fy4(sfy, sfy + sdy, sfy + 2*sdy, sfy + 3*sdy);
+    const Sk4f dx4(sdx * 4);
+    const Sk4f dy4(sdy * 4);
+
+    Sk4f tmpxy = fx4 * dx4 + fy4 * dy4;
+    Sk4f tmpdxdy = sum_squares(dx4, dy4);
+    Sk4f R = sum_squares(fx4, fy4);
+    Sk4f dR = tmpxy + tmpxy + tmpdxdy;
+    const Sk4f ddR = tmpdxdy + tmpdxdy;
+
+    int di = 0;     // alternates the dither bias per pixel
+    while (count > 0) {
+        Sk4f dist = Sk4f::Min(fast_sqrt(R), Sk4f(1));
+        R = R + dR;
+        dR = dR + ddR;
+
+        float t[4];
+        dist.store(t);
+
+        const int n = SkMin32(count, 4);
+        for (int i = 0; i < n; i++) {
+            Sk4f c;
+            if (2 == stop_count || t[i] <= recs[1].fPos) {
+                const float f = SkTPin((t[i] - recs[0].fPos) * recs[1].fPosScale, 0.0f, 1.0f);
+                c = c0 + Sk4f(f) * d0;
+            } else {
+                const Sk4f c1 = Sk4f::Load(recs[1].fColor);
+                const float f = SkTPin((t[i] - recs[1].fPos) * recs[2].fPosScale, 0.0f, 1.0f);
+                c = c1 + Sk4f(f) * (Sk4f::Load(recs[2].fColor) - c1);
+            }
+            *dstC++ = radial_trunc_from_255<apply_alpha>(c + Sk4f(dither[di]));
+            di ^= 1;
+        }
+        count -= n;
+    }
+}
+
 }  // namespace
 
+SkRadialGradient::RadialGradientContext::RadialGradientContext(
+        const SkRadialGradient& shader, const ContextRec& rec)
+    : INHERITED(shader, rec)
+    , fAnalyticProc(NULL) {
+    // Pick a compile-time specialized evaluator for tiny clamp gradients. The
+    // stop colors are staged like the linear gradient's analytic Recs: when
+    // everything is opaque (or premul interpolation was requested) we lerp
+    // premultiplied values directly, otherwise we lerp unpremul and
+    // premultiply on the way out.
+    if (shader.fColorCount >= 2 && shader.fColorCount <= kMaxAnalyticColorCount &&
+        SkShader::kClamp_TileMode == shader.fTileMode) {
+        const int count = shader.fColorCount;
+        if (shader.fOrigPos) {
+            fRecs[0].fPos = 0;
+            fRecs[0].fPosScale = 0;  // should never be used
+            for (int i = 1; i < count; i++) {
+                fRecs[i].fPos = SkScalarPin(shader.fOrigPos[i], fRecs[i - 1].fPos, SK_Scalar1);
+                float diff = fRecs[i].fPos - fRecs[i - 1].fPos;
+                fRecs[i].fPosScale = diff > 0 ? 1.0f / diff : 0;
+            }
+            fRecs[count - 1].fPos = 1;  // make sure we end exactly at 1
+        } else {
+            const float scale = float(count - 1);
+            const float invScale = 1.0f / scale;
+            for (int i = 0; i < count; i++) {
+                fRecs[i].fPos = i * invScale;
+                fRecs[i].fPosScale = scale;
+            }
+        }
+
+        const bool applyAlphaAfterInterp = !shader.isOpaque() &&
+            !(shader.getGradFlags() & SkGradientShader::kInterpolateColorsInPremul_Flag);
+        const float paintAlpha = this->getPaintAlpha() * (1.0f / 255);
+        for (int i = 0; i < count; i++) {
+            SkColor c = shader.fOrigColors[i];
+            float a = SkColorGetA(c) * paintAlpha;
+            float scale = applyAlphaAfterInterp ? 1.0f : a * (1.0f / 255);
+            SkPMFloat(a, SkColorGetR(c) * scale,
+                         SkColorGetG(c) * scale,
+                         SkColorGetB(c) * scale).store(fRecs[i].fColor);
+        }
+
+        if (2 == count) {
+            fAnalyticProc = applyAlphaAfterInterp ? shadeSpan_radial_clamp_analytic<2, true>
+                                                  : shadeSpan_radial_clamp_analytic<2, false>;
+        } else {
+            fAnalyticProc = applyAlphaAfterInterp ? shadeSpan_radial_clamp_analytic<3, true>
+                                                  : shadeSpan_radial_clamp_analytic<3, false>;
+        }
+    }
+}
+
 void SkRadialGradient::RadialGradientContext::shadeSpan(int x, int y,
                                                         SkPMColor* SK_RESTRICT dstC, int count) {
     SkASSERT(count > 0);
@@ -385,9 +516,6 @@ void SkRadialGradient::RadialGradientContext::shadeSpan(int x, int y,
 
     SkPoint             srcPt;
     SkMatrix::MapXYProc dstProc = fDstToIndexProc;
-    TileProc            proc = radialGradient.fTileProc;
-    const SkPMColor* SK_RESTRICT cache = fCache->getCache32();
-    int toggle = init_dither_toggle(x, y);
 
     if (fDstToIndexClass != kPerspective_MatrixClass) {
         dstProc(fDstToIndex, SkIntToScalar(x) + SK_ScalarHalf,
@@ -405,6 +533,14 @@ void SkRadialGradient::RadialGradientContext::shadeSpan(int x, int y,
             SkASSERT(fDstToIndexClass == kLinear_MatrixClass);
         }
 
+        if (fAnalyticProc) {
+            // Tiny clamp gradients lerp the stops directly and never build the cache.
+            fAnalyticProc(fRecs, x, y, srcPt.fX, sdx, srcPt.fY, sdy, dstC, count);
+            return;
+        }
+
+        const SkPMColor* SK_RESTRICT cache = fCache->getCache32();
+        int toggle = init_dither_toggle(x, y);
         RadialShadeProc shadeProc = shadeSpan_radial_repeat;
         if (SkShader::kClamp_TileMode == radialGradient.fTileMode) {
             shadeProc = shadeSpan_radial_clamp2;
@@ -415,6 +551,8 @@ void SkRadialGradient::RadialGradientContext::shadeSpan(int x, int y,
         }
         (*shadeProc)(srcPt.fX, sdx, srcPt.fY, sdy, dstC, cache, count, toggle);
     } else {    // perspective case
+        TileProc proc = radialGradient.fTileProc;
+        const SkPMColor* SK_RESTRICT cache = fCache->getCache32();
         SkScalar dstX = SkIntToScalar(x);
         SkScalar dstY = SkIntToScalar(y);
         do {
@@ -24,7 +24,27 @@ public:
         void shadeSpan(int x, int y, SkPMColor dstC[], int count) override;
         void shadeSpan16(int x, int y, uint16_t dstC[], int count) override;
 
+        // One color stop for the analytic (no-LUT) evaluator, mirroring
+        // SkLinearGradient::LinearGradientContext::Rec.
+        struct Rec {
+            float   fColor[4];  // components in SkPMColor order, each in [0...255]
+            float   fPos;       // 0...1
+            float   fPosScale;  // 1 / (fPos - prev.fPos), or 0 to skip the segment
+        };
+
+        typedef void (*AnalyticProc)(const Rec recs[], int x, int y,
+                                     SkScalar sfx, SkScalar sdx, SkScalar sfy, SkScalar sdy,
+                                     SkPMColor dstC[], int count);
+
     private:
+        enum {
+            // Only the smallest gradients get the specialized kernels; anything
+            // bigger keeps the cache so the per-pixel search stays trivial.
+            kMaxAnalyticColorCount = 3
+        };
+        Rec          fRecs[kMaxAnalyticColorCount];
+        AnalyticProc fAnalyticProc;  // NULL when the cache path applies
+
         typedef SkGradientShaderBase::GradientShaderBaseContext INHERITED;
     };
 
@@ -410,7 +410,10 @@ void GrAtlasTextContext::drawTextBlob(GrRenderTarget* rt, const GrClip& clip,
                                      drawFilter, clipRect, rt, clip, grPaint);
         } else {
             // If we can reuse the blob, then make sure we update the blob's viewmatrix, and x/y
-            // offsets
+            // offsets. The stored vertices stay where they were generated; we just accumulate the
+            // translation and apply it when the vertices are copied out at flush time.
+            cacheBlob->fTotalXOffset += transX;
+            cacheBlob->fTotalYOffset += transY;
             cacheBlob->fViewMatrix = viewMatrix;
             cacheBlob->fX = x;
             cacheBlob->fY = y;
@@ -477,6 +480,8 @@ void GrAtlasTextContext::regenerateTextBlob(BitmapTextBlob* cacheBlob,
     cacheBlob->fViewMatrix = viewMatrix;
     cacheBlob->fX = x;
     cacheBlob->fY = y;
+    cacheBlob->fTotalXOffset = 0;
+    cacheBlob->fTotalYOffset = 0;
 
     // Regenerate textblob
     SkPaint runPaint = skPaint;
@@ -1335,6 +1340,13 @@ bool GrAtlasTextContext::dfAppendGlyph(BitmapTextBlob* blob, int runIndex,
         return true;
     }
 
+    // Kick off background distance field generation while the rest of the
+    // blob is built; the flush that uploads this glyph picks the result up
+    // in getPackedGlyphDFImage().
+    if (GrBatchAtlas::kInvalidAtlasID == glyph->fID) {
+        scaler->prefetchGlyphDFImage(packed);
+    }
+
     PerSubRunInfo* subRun = &run.fSubRunInfo.back();
     SkASSERT(glyph->fMaskFormat == kA8_GrMaskFormat);
     subRun->fMaskFormat = kA8_GrMaskFormat;
@@ -1436,6 +1448,9 @@ public:
         int fRun;
         int fSubRun;
         GrColor fColor;
+        // The distance from the blob's stored vertex positions to where this draw lands. It is
+        // applied to the vertices as they are copied into the draw buffer, leaving the blob's
+        // storage untouched.
         SkScalar fTransX;
         SkScalar fTransY;
     };
@@ -1587,7 +1602,6 @@ public:
             } else {
                 regenerateColors = kA8_GrMaskFormat == fMaskFormat && run.fColor != args.fColor;
             }
-            bool regeneratePositions = args.fTransX != 0.f || args.fTransY != 0.f;
             int glyphCount = info.fGlyphEndIndex - info.fGlyphStartIndex;
 
             // We regenerate both texture coords and colors in the blob itself, and update the
@@ -1598,7 +1612,7 @@ public:
             // or coords as needed.  One final note, if we have to break a run for an atlas eviction
             // then we can't really trust the atlas has all of the correct data.  Atlas evictions
             // should be pretty rare, so we just always regenerate in those cases
-            if (regenerateTextureCoords || regenerateColors || regeneratePositions) {
+            if (regenerateTextureCoords || regenerateColors) {
                 // first regenerate texture coordinates / colors if need be
                 bool brokenRun = false;
 
@@ -1685,14 +1699,6 @@ public:
                         this->regenerateColors(vertex, vertexStride, args.fColor);
                     }
 
-                    if (regeneratePositions) {
-                        intptr_t vertex = reinterpret_cast<intptr_t>(blob->fVertices);
-                        vertex += info.fVertexStartIndex;
-                        vertex += vertexStride * glyphIdx * kVerticesPerGlyph;
-                        SkScalar transX = args.fTransX;
-                        SkScalar transY = args.fTransY;
-                        this->regeneratePositions(vertex, vertexStride, transX, transY);
-                    }
                     flushInfo.fGlyphsToFlush++;
                 }
 
@@ -1719,6 +1725,13 @@ public:
             size_t byteCount = info.fVertexEndIndex - info.fVertexStartIndex;
             memcpy(currVertex, blob->fVertices + info.fVertexStartIndex, byteCount);
 
+            // The blob's stored vertices are translation invariant; apply the accumulated offset
+            // to the copy headed for the draw buffer.
+            if (args.fTransX != 0.f || args.fTransY != 0.f) {
+                this->translatePositions(reinterpret_cast<intptr_t>(currVertex), byteCount,
+                                         vertexStride, args.fTransX, args.fTransY);
+            }
+
             currVertex += byteCount;
         }
         // Make sure to attach the last cache if applicable
@@ -1839,9 +1852,10 @@ private:
         }
     }
 
-    void regeneratePositions(intptr_t vertex, size_t vertexStride, SkScalar transX,
-                             SkScalar transY) {
-        for (int i = 0; i < kVerticesPerGlyph; i++) {
+    void translatePositions(intptr_t vertex, size_t byteCount, size_t vertexStride,
+                            SkScalar transX, SkScalar transY) {
+        int vertexCount = SkToInt(byteCount / vertexStride);
+        for (int i = 0; i < vertexCount; i++) {
             SkPoint* point = reinterpret_cast<SkPoint*>(vertex);
             point->fX += transX;
             point->fY += transY;
@@ -2121,7 +2135,7 @@ GrAtlasTextContext::createBatch(BitmapTextBlob* cacheBlob, const PerSubRunInfo&
 
 inline void GrAtlasTextContext::flushRun(GrDrawTarget* target, GrPipelineBuilder* pipelineBuilder,
                                          BitmapTextBlob* cacheBlob, int run, GrColor color,
-                                         SkScalar transX, SkScalar transY, const SkPaint& skPaint) {
+                                         const SkPaint& skPaint) {
     for (int subRun = 0; subRun < cacheBlob->fRuns[run].fSubRunInfo.count(); subRun++) {
         const PerSubRunInfo& info = cacheBlob->fRuns[run].fSubRunInfo[subRun];
         int glyphCount = info.fGlyphEndIndex - info.fGlyphStartIndex;
@@ -2130,7 +2144,9 @@ inline void GrAtlasTextContext::flushRun(GrDrawTarget* target, GrPipelineBuilder
         }
 
         SkAutoTUnref<BitmapTextBatch> batch(this->createBatch(cacheBlob, info, glyphCount, run,
-                                                              subRun, color, transX, transY,
+                                                              subRun, color,
+                                                              cacheBlob->fTotalXOffset,
+                                                              cacheBlob->fTotalYOffset,
                                                               skPaint));
         target->drawBatch(pipelineBuilder, batch);
     }
@@ -2176,8 +2192,7 @@ void GrAtlasTextContext::flush(GrDrawTarget* target,
                                SkScalar transX, SkScalar transY) {
     // We loop through the runs of the blob, flushing each.  If any run is too large, then we flush
     // it as paths
-    GrPipelineBuilder pipelineBuilder;
-    pipelineBuilder.setFromPaint(grPaint, rt, clip);
+    GrPipelineBuilder pipelineBuilder(grPaint, rt, clip);
 
     GrColor color = grPaint.getColor();
 
@@ -2188,7 +2203,7 @@ void GrAtlasTextContext::flush(GrDrawTarget* target,
             continue;
         }
         cacheBlob->fRuns[run].fVertexBounds.offset(transX, transY);
-        this->flushRun(target, &pipelineBuilder, cacheBlob, run, color, transX, transY, skPaint);
+        this->flushRun(target, &pipelineBuilder, cacheBlob, run, color, skPaint);
     }
 
     // Now flush big glyphs
@@ -2202,12 +2217,11 @@ void GrAtlasTextContext::flush(GrDrawTarget* target,
                                const GrPaint& grPaint,
                                const GrClip& clip,
                                const SkIRect& clipBounds) {
-    GrPipelineBuilder pipelineBuilder;
-    pipelineBuilder.setFromPaint(grPaint, rt, clip);
+    GrPipelineBuilder pipelineBuilder(grPaint, rt, clip);
 
     GrColor color = grPaint.getColor();
     for (int run = 0; run < cacheBlob->fRunCount; run++) {
-        this->flushRun(target, &pipelineBuilder, cacheBlob, run, color, 0, 0, skPaint);
+        this->flushRun(target, &pipelineBuilder, cacheBlob, run, color, skPaint);
     }
 
     // Now flush big glyphs
@@ -205,6 +205,12 @@ private:
         SkScalar fX;
         SkScalar fY;
 
+        // The cumulative translation applied to the blob since its vertices were generated. The
+        // stored vertices are never rewritten for a translation-only reuse; instead this offset
+        // is applied to the copy of the vertices made at flush time.
+        SkScalar fTotalXOffset;
+        SkScalar fTotalYOffset;
+
         // We can reuse distance field text, but only if the new viewmatrix would not result in
         // a mip change.  Because there can be multiple runs in a blob, we track the overall
         // maximum minimum scale, and minimum maximum scale, we can support before we need to regen
@@ -214,7 +220,9 @@ private:
         uint8_t fTextType;
 
         BitmapTextBlob()
-            : fMaxMinScale(-SK_ScalarMax)
+            : fTotalXOffset(0)
+            , fTotalYOffset(0)
+            , fMaxMinScale(-SK_ScalarMax)
             , fMinMaxScale(SK_ScalarMax)
             , fTextType(0) {}
 
@@ -279,7 +287,7 @@ private:
                                         GrColor, SkScalar transX, SkScalar transY,
                                         const SkPaint&);
     inline void flushRun(GrDrawTarget*, GrPipelineBuilder*, BitmapTextBlob*, int run, GrColor,
-                         SkScalar transX, SkScalar transY, const SkPaint&);
+                         const SkPaint&);
     inline void flushBigGlyphs(BitmapTextBlob* cacheBlob, GrRenderTarget* rt,
                                const SkPaint& skPaint,
                                SkScalar transX, SkScalar transY, const SkIRect& clipBounds);
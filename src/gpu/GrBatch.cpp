@@ -30,7 +30,9 @@ public:
     ~MemoryPoolAccessor() { gBatchSpinlock.release(); }
 
     GrMemoryPool* pool() const {
-        static GrMemoryPool gPool(16384, 16384);
+        // Batches are small and allocated/freed on the hot recording path, so let the pool keep
+        // released slots on freelists instead of churning blocks while we hold the spinlock.
+        static GrMemoryPool gPool(16384, 16384, /* smallAllocFreeLists = */ true);
         return &gPool;
     }
 };
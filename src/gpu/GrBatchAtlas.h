@@ -61,8 +61,8 @@ public:
 
     /*
      * A class which can be handed back to GrBatchAtlas for updating in bulk last use tokens.  The
-     * current max number of plots the GrBatchAtlas can handle is 32, if in the future this is
-     * insufficient then we can move to a 64 bit int
+     * current max number of plots the GrBatchAtlas can handle is 64, if in the future this is
+     * insufficient then we can move to a wider bitfield
      */
     class BulkUseTokenUpdater {
     public:
@@ -87,14 +87,14 @@ public:
 
         void set(int index) {
             SkASSERT(!this->find(index));
-            fPlotAlreadyUpdated = fPlotAlreadyUpdated | (1 << index);
+            fPlotAlreadyUpdated = fPlotAlreadyUpdated | ((uint64_t)1 << index);
             fPlotsToUpdate.push_back(index);
         }
 
         static const int kMinItems = 4;
-        static const int kMaxPlots = 32;
+        static const int kMaxPlots = 64;
         SkSTArray<kMinItems, int, true> fPlotsToUpdate;
-        uint32_t fPlotAlreadyUpdated;
+        uint64_t fPlotAlreadyUpdated;
 
         friend class GrBatchAtlas;
     };
@@ -11,6 +11,7 @@
 #include "GrRectanizer.h"
 #include "GrSurfacePriv.h"
 #include "SkString.h"
+#include "SkTDArray.h"
 
 #include "SkDistanceFieldGen.h"
 
@@ -110,6 +111,9 @@ GrPixelConfig GrBatchFontCache::getPixelConfig(GrMaskFormat format) const {
 void GrBatchFontCache::HandleEviction(GrBatchAtlas::AtlasID id, void* ptr) {
     GrBatchFontCache* fontCache = reinterpret_cast<GrBatchFontCache*>(ptr);
 
+    // Removing reshuffles the hash, so gather the victims first and remove them after iterating.
+    SkTDArray<GrBatchTextStrike*> toBeRemoved;
+
     SkTDynamicHash<GrBatchTextStrike, GrFontDescKey>::Iter iter(&fontCache->fCache);
     for (; !iter.done(); ++iter) {
         GrBatchTextStrike* strike = &*iter;
@@ -118,11 +122,16 @@ void GrBatchFontCache::HandleEviction(GrBatchAtlas::AtlasID id, void* ptr) {
         // clear out any empty strikes.  We will preserve the strike whose call to addToAtlas
         // triggered the eviction
         if (strike != fontCache->fPreserveStrike && 0 == strike->fAtlasedGlyphs) {
-            fontCache->fCache.remove(*(strike->fFontScalerKey));
-            strike->fIsAbandoned = true;
-            strike->unref();
+            *toBeRemoved.append() = strike;
         }
     }
+
+    for (int i = 0; i < toBeRemoved.count(); ++i) {
+        GrBatchTextStrike* strike = toBeRemoved[i];
+        fontCache->fCache.remove(*(strike->fFontScalerKey));
+        strike->fIsAbandoned = true;
+        strike->unref();
+    }
 }
 
 void GrBatchFontCache::dump() const {
@@ -277,10 +277,10 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
 
     SkASSERT(NULL == fBufferPtr);
 
-    // If the buffer is CPU-backed we map it because it is free to do so and saves a copy.
-    // Otherwise when buffer mapping is supported we map if the buffer size is greater than the
-    // threshold.
-    bool attemptMap = block.fBuffer->isCPUBacked();
+    // If the buffer is CPU-backed or persistently mapped we map it because it is free to do
+    // so and saves a copy. Otherwise when buffer mapping is supported we map if the buffer
+    // size is greater than the threshold.
+    bool attemptMap = block.fBuffer->isCPUBacked() || block.fBuffer->isPersistentlyMapped();
     if (!attemptMap && GrDrawTargetCaps::kNone_MapFlags != fGpu->caps()->mapBufferFlags()) {
         attemptMap = size > GR_GEOM_BUFFER_MAP_THRESHOLD;
     }
@@ -312,6 +312,10 @@ void GrBufferAllocPool::destroyBlock() {
         }
     }
     SkASSERT(!block.fBuffer->isMapped());
+    // Blocks are destroyed after the draws reading them have been flushed (reset() runs
+    // post-flush), so this is where persistently mapped buffers fence their last use. A
+    // recycled preallocated buffer waits on the fence when it is next mapped.
+    block.fBuffer->finishedWithData();
     block.fBuffer->unref();
     fBlocks.pop_back();
     fBufferPtr = NULL;
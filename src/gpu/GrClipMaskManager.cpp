@@ -25,6 +25,10 @@
 
 typedef SkClipStack::Element Element;
 
+GrContext* GrClipMaskManager::getContext() {
+    return fClipTarget->getContext();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace {
 // set up the draw state to enable the aa clipping mask. Besides setting up the
@@ -297,7 +301,7 @@ bool GrClipMaskManager::setupClipping(GrPipelineBuilder* pipelineBuilder,
 
     // If MSAA is enabled we can do everything in the stencil buffer.
     if (0 == rt->numSamples() && requiresAA) {
-        GrTexture* result = NULL;
+        SkAutoTUnref<GrTexture> result;
 
         // The top-left of the mask corresponds to the top-left corner of the bounds.
         SkVector clipToMaskOffset = {
@@ -308,17 +312,17 @@ bool GrClipMaskManager::setupClipping(GrPipelineBuilder* pipelineBuilder,
         if (this->useSWOnlyPath(pipelineBuilder, clipToMaskOffset, elements)) {
             // The clip geometry is complex enough that it will be more efficient to create it
             // entirely in software
-            result = this->createSoftwareClipMask(genID,
-                                                  initialState,
-                                                  elements,
-                                                  clipToMaskOffset,
-                                                  clipSpaceIBounds);
+            result.reset(this->createSoftwareClipMask(genID,
+                                                      initialState,
+                                                      elements,
+                                                      clipToMaskOffset,
+                                                      clipSpaceIBounds));
         } else {
-            result = this->createAlphaClipMask(genID,
-                                               initialState,
-                                               elements,
-                                               clipToMaskOffset,
-                                               clipSpaceIBounds);
+            result.reset(this->createAlphaClipMask(genID,
+                                                   initialState,
+                                                   elements,
+                                                   clipToMaskOffset,
+                                                   clipSpaceIBounds));
         }
 
         if (result) {
@@ -334,13 +338,6 @@ bool GrClipMaskManager::setupClipping(GrPipelineBuilder* pipelineBuilder,
         // if alpha clip mask creation fails fall through to the non-AA code paths
     }
 
-    // Either a hard (stencil buffer) clip was explicitly requested or an anti-aliased clip couldn't
-    // be created. In either case, free up the texture in the anti-aliased mask cache.
-    // TODO: this may require more investigation. Ganesh performs a lot of utility draws (e.g.,
-    // clears, InOrderDrawBuffer playbacks) that hit the stencil buffer path. These may be
-    // "incorrectly" clearing the AA cache.
-    fAACache.reset();
-
     // use the stencil clip if we can't represent the clip as a rectangle.
     SkIPoint clipSpaceToStencilSpaceOffset = -clip.origin();
     this->createStencilClipMask(rt,
@@ -501,27 +498,37 @@ GrTexture* GrClipMaskManager::createTempMask(int width, int height) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Return the texture currently in the cache if it exists. Otherwise, return NULL
+// Clip mask textures are cached in the GrResourceCache keyed on the clip stack's generation ID
+// and the clip space bounds of the mask. Clip stack generation IDs are never reused, so a stale
+// entry can never be returned for a changed clip; old masks simply age out of the cache under
+// its normal LRU budget. Since the cache can hold many masks at once, alternating between a
+// handful of stable clips (e.g. two tabs' clip shapes) keeps them all resident.
+static void get_clip_mask_key(int32_t clipGenID, const SkIRect& bounds, GrUniqueKey* key) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey::Builder builder(key, kDomain, 5);
+    builder[0] = clipGenID;
+    builder[1] = bounds.fLeft;
+    builder[2] = bounds.fTop;
+    builder[3] = bounds.fRight;
+    builder[4] = bounds.fBottom;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Return a ref on the mask texture cached for this clip if it exists. Otherwise, return NULL
 GrTexture* GrClipMaskManager::getCachedMaskTexture(int32_t elementsGenID,
                                                    const SkIRect& clipSpaceIBounds) {
-    bool cached = fAACache.canReuse(elementsGenID, clipSpaceIBounds);
-    if (!cached) {
-        return NULL;
-    }
-
-    return fAACache.getLastMask();
+    GrUniqueKey key;
+    get_clip_mask_key(elementsGenID, clipSpaceIBounds, &key);
+    return this->getContext()->textureProvider()->findAndRefTextureByUniqueKey(key);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Allocate a texture in the texture cache. This function returns the texture
-// allocated (or NULL on error).
+// Allocate a texture for the mask. This function returns a ref on the texture
+// allocated (or NULL on error). The caller is responsible for assigning the mask's
+// unique key (via assign_clip_mask_key) once the mask's contents are valid.
 GrTexture* GrClipMaskManager::allocMaskTexture(int32_t elementsGenID,
                                                const SkIRect& clipSpaceIBounds,
                                                bool willUpload) {
-    // Since we are setting up the cache we should free up the
-    // currently cached mask so it can be reused.
-    fAACache.reset();
-
     GrSurfaceDesc desc;
     desc.fFlags = willUpload ? kNone_GrSurfaceFlags : kRenderTarget_GrSurfaceFlag;
     desc.fWidth = clipSpaceIBounds.width();
@@ -532,8 +539,18 @@ GrTexture* GrClipMaskManager::allocMaskTexture(int32_t elementsGenID,
         desc.fConfig = kAlpha_8_GrPixelConfig;
     }
 
-    fAACache.acquireMask(elementsGenID, desc, clipSpaceIBounds);
-    return fAACache.getLastMask();
+    return this->getContext()->textureProvider()->createTexture(desc, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Give a completed mask its unique key so that later draws with the same clip find it in the
+// resource cache. This is deliberately done only after the mask's contents are fully rendered
+// or uploaded; a mask abandoned partway through construction must not be findable.
+static void assign_clip_mask_key(GrContext* context, int32_t elementsGenID,
+                                 const SkIRect& clipSpaceIBounds, GrTexture* texture) {
+    GrUniqueKey key;
+    get_clip_mask_key(elementsGenID, clipSpaceIBounds, &key);
+    context->textureProvider()->assignUniqueKeyToTexture(key, texture);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -546,16 +563,15 @@ GrTexture* GrClipMaskManager::createAlphaClipMask(int32_t elementsGenID,
     SkASSERT(kNone_ClipMaskType == fCurrClipMaskType);
 
     // First, check for cached texture
-    GrTexture* result = this->getCachedMaskTexture(elementsGenID, clipSpaceIBounds);
+    SkAutoTUnref<GrTexture> result(this->getCachedMaskTexture(elementsGenID, clipSpaceIBounds));
     if (result) {
         fCurrClipMaskType = kAlpha_ClipMaskType;
-        return result;
+        return result.detach();
     }
 
     // There's no texture in the cache. Let's try to allocate it then.
-    result = this->allocMaskTexture(elementsGenID, clipSpaceIBounds, false);
+    result.reset(this->allocMaskTexture(elementsGenID, clipSpaceIBounds, false));
     if (NULL == result) {
-        fAACache.reset();
         return NULL;
     }
 
@@ -564,12 +580,9 @@ GrTexture* GrClipMaskManager::createAlphaClipMask(int32_t elementsGenID,
     SkMatrix translate;
     translate.setTranslate(clipToMaskOffset);
 
-    // The texture may be larger than necessary, this rect represents the part of the texture
-    // we populate with a rasterization of the clip.
+    // This rect represents the part of the texture we populate with a rasterization of the clip.
     SkIRect maskSpaceIBounds = SkIRect::MakeWH(clipSpaceIBounds.width(), clipSpaceIBounds.height());
 
-    // The scratch texture that we are drawing into can be substantially larger than the mask. Only
-    // clear the part that we care about.
     fClipTarget->clear(&maskSpaceIBounds,
                        GrReducedClip::kAllIn_InitialState == initialState ? 0xffffffff : 0x00000000,
                        true,
@@ -613,7 +626,6 @@ GrTexture* GrClipMaskManager::createAlphaClipMask(int32_t elementsGenID,
                     temp.reset(this->createTempMask(maskSpaceIBounds.fRight,
                                                     maskSpaceIBounds.fBottom));
                     if (!temp) {
-                        fAACache.reset();
                         return NULL;
                     }
                 }
@@ -640,7 +652,6 @@ GrTexture* GrClipMaskManager::createAlphaClipMask(int32_t elementsGenID,
             }
 
             if (!this->drawElement(&pipelineBuilder, translate, dst, element, pr)) {
-                fAACache.reset();
                 return NULL;
             }
 
@@ -685,8 +696,10 @@ GrTexture* GrClipMaskManager::createAlphaClipMask(int32_t elementsGenID,
         }
     }
 
+    // The mask is complete; make it findable for subsequent draws with this clip.
+    assign_clip_mask_key(this->getContext(), elementsGenID, clipSpaceIBounds, result);
     fCurrClipMaskType = kAlpha_ClipMaskType;
-    return result;
+    return result.detach();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1046,8 +1059,8 @@ GrTexture* GrClipMaskManager::createSoftwareClipMask(int32_t elementsGenID,
         return result;
     }
 
-    // The mask texture may be larger than necessary. We round out the clip space bounds and pin
-    // the top left corner of the resulting rect to the top left of the texture.
+    // We round out the clip space bounds and pin the top left corner of the resulting rect to
+    // the top left of the texture.
     SkIRect maskSpaceIBounds = SkIRect::MakeWH(clipSpaceIBounds.width(), clipSpaceIBounds.height());
 
     GrSWMaskHelper helper(this->getContext());
@@ -1096,23 +1109,19 @@ GrTexture* GrClipMaskManager::createSoftwareClipMask(int32_t elementsGenID,
     // Allocate clip mask texture
     result = this->allocMaskTexture(elementsGenID, clipSpaceIBounds, true);
     if (NULL == result) {
-        fAACache.reset();
         return NULL;
     }
     helper.toTexture(result);
 
+    // The mask is complete; make it findable for subsequent draws with this clip.
+    assign_clip_mask_key(this->getContext(), elementsGenID, clipSpaceIBounds, result);
     fCurrClipMaskType = kAlpha_ClipMaskType;
     return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void GrClipMaskManager::purgeResources() {
-    fAACache.purgeResources();
-}
-
 void GrClipMaskManager::setClipTarget(GrClipTarget* clipTarget) {
     fClipTarget = clipTarget;
-    fAACache.setContext(clipTarget->getContext());
 }
 
 void GrClipMaskManager::adjustPathStencilParams(const GrStencilAttachment* stencilAttachment,
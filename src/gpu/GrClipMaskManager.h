@@ -7,14 +7,12 @@
 #ifndef GrClipMaskManager_DEFINED
 #define GrClipMaskManager_DEFINED
 
-#include "GrClipMaskCache.h"
 #include "GrContext.h"
 #include "GrPipelineBuilder.h"
 #include "GrReducedClip.h"
 #include "GrStencil.h"
 #include "GrTexture.h"
 #include "SkClipStack.h"
-#include "SkDeque.h"
 #include "SkPath.h"
 #include "SkRefCnt.h"
 #include "SkTLList.h"
@@ -54,12 +52,6 @@ public:
                        GrScissorState*,
                        const SkRect* devBounds);
 
-    /**
-     * Purge resources to free up memory. TODO: This class shouldn't hold any long lived refs
-     * which will allow Resourcecache to automatically purge anything this class has created.
-     */
-    void purgeResources();
-
     bool isClipInStencil() const {
         return kStencil_ClipMaskType == fCurrClipMaskType;
     }
@@ -68,9 +60,7 @@ public:
         return kAlpha_ClipMaskType == fCurrClipMaskType;
     }
 
-    GrContext* getContext() {
-        return fAACache.getContext();
-    }
+    GrContext* getContext();
 
     void setClipTarget(GrClipTarget*);
 
@@ -122,12 +112,13 @@ private:
                                       const SkVector& clipToMaskOffset,
                                       const SkIRect& clipSpaceIBounds);
 
-    // Returns the cached mask texture if it matches the elementsGenID and the clipSpaceIBounds.
-    // Returns NULL if not found.
+    // Returns a ref on the mask texture cached in the resource cache for this generation ID and
+    // bounds, or NULL if there is no such mask. The resource cache keeps recently used masks
+    // alive, so several distinct clips can stay resident at once.
     GrTexture* getCachedMaskTexture(int32_t elementsGenID, const SkIRect& clipSpaceIBounds);
 
-    // Handles allocation (if needed) of a clip alpha-mask texture for both the sw-upload
-    // or gpu-rendered cases.
+    // Allocates a clip alpha-mask texture for both the sw-upload or gpu-rendered cases and
+    // returns a ref on it. The caller assigns the mask's unique key once its contents are valid.
     GrTexture* allocMaskTexture(int32_t elementsGenID,
                                 const SkIRect& clipSpaceIBounds,
                                 bool willUpload);
@@ -189,7 +180,6 @@ private:
         kAlpha_ClipMaskType,
     } fCurrClipMaskType;
 
-    GrClipMaskCache fAACache;       // cache for the AA path
     GrClipTarget*   fClipTarget;
     StencilClipMode fClipMode;
 
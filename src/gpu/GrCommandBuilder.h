@@ -22,7 +22,7 @@ public:
     virtual ~GrCommandBuilder() {}
 
     void reset() { fCommands.reset(); }
-    void flush(GrInOrderDrawBuffer* iodb) { fCommands.flush(iodb); }
+    void flush(GrInOrderDrawBuffer* iodb) { fCommands.flush(iodb, this->sortsDrawsAtFlush()); }
 
     virtual Cmd* recordClearStencilClip(const SkIRect& rect,
                                         bool insideClip,
@@ -71,6 +71,10 @@ protected:
 
     GrCommandBuilder(GrGpu* gpu) : fCommands(gpu) {}
 
+    // Builders that return true get a flush-time pass that regroups non-overlapping draws by
+    // pipeline to collapse GPU state changes.
+    virtual bool sortsDrawsAtFlush() const { return false; }
+
     GrTargetCommands::CmdBuffer* cmdBuffer() { return fCommands.cmdBuffer(); }
     GrBatchTarget* batchTarget() { return fCommands.batchTarget(); }
 
@@ -41,6 +41,7 @@
 #include "SkConfig8888.h"
 #include "SkGr.h"
 #include "SkRRect.h"
+#include "SkSurface.h"
 #include "SkStrokeRec.h"
 #include "SkTLazy.h"
 #include "SkTLS.h"
@@ -204,6 +205,37 @@ void GrContext::freeGpuResources() {
     fResourceCache->purgeAllUnlocked();
 }
 
+void GrContext::performDeferredCleanup(SkMSec msNotUsed) {
+    fResourceCache->purgeResourcesNotUsedForMs(msNotUsed);
+}
+
+void GrContext::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources) {
+    fResourceCache->purgeUnlockedResources(bytesToPurge, preferScratchResources);
+}
+
+void GrContext::setGpuBatchTimingEnabled(bool enabled) {
+    fGpu->setBatchTimingEnabled(enabled);
+}
+
+bool GrContext::gpuBatchTimingEnabled() const {
+    return fGpu->batchTimingEnabled();
+}
+
+void GrContext::getGpuBatchTimings(SkTArray<GpuBatchTiming>* timings) const {
+    SkTArray<GrGpu::BatchTiming> batchTimings;
+    fGpu->getBatchTimings(&batchTimings);
+    for (int i = 0; i < batchTimings.count(); ++i) {
+        GpuBatchTiming& timing = timings->push_back();
+        timing.fName = batchTimings[i].fName;
+        timing.fGpuNanos = batchTimings[i].fGpuNanos;
+        timing.fCount = batchTimings[i].fCount;
+    }
+}
+
+void GrContext::resetGpuBatchTimings() {
+    fGpu->resetBatchTimings();
+}
+
 void GrContext::getResourceCacheUsage(int* resourceCount, size_t* resourceBytes) const {
     if (resourceCount) {
         *resourceCount = fResourceCache->getBudgetedResourceCount();
@@ -228,6 +260,32 @@ GrTextContext* GrContext::createTextContext(GrRenderTarget* renderTarget,
     return GrAtlasTextContext::Create(this, gpuDevice, leakyProperties, enableDistanceFieldFonts);
 }
 
+void GrContext::preloadFontGlyphs(SkTypeface* typeface) {
+    if (fGpu->caps()->shaderCaps()->pathRenderingSupport()) {
+        GrStencilAndCoverTextContext::PreloadGlyphs(this, typeface);
+    }
+}
+
+void GrContext::prewarmPicturePrograms(const SkPicture* picture, const SkImageInfo& info,
+                                       int sampleCount) {
+    RETURN_IF_ABANDONED
+    if (NULL == picture) {
+        return;
+    }
+    // Replaying through a scratch surface drives the normal pipeline, so exactly the programs
+    // (and glyph/atlas uploads) the real playback will request get built here. Deriving the
+    // program keys without drawing would mean duplicating every blitter/effect decision the
+    // draw path makes.
+    SkAutoTUnref<SkSurface> surface(SkSurface::NewRenderTarget(this, SkSurface::kYes_Budgeted,
+                                                               info, sampleCount, NULL));
+    if (!surface) {
+        return;
+    }
+    surface->getCanvas()->drawPicture(picture);
+    // Issue the draws so the programs are actually compiled; nothing consumes the pixels.
+    this->flush();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 bool GrContext::isConfigTexturable(GrPixelConfig config) const {
@@ -1373,10 +1431,29 @@ void GrContext::flush(int flagsBitfield) {
     } else {
         fDrawBuffer->flush();
     }
+    fGpu->didFlush();
     fResourceCache->notifyFlushOccurred();
     fFlushToReduceCacheSize = false;
 }
 
+GrFence GrContext::flushAndInsertFence(int flagsBitfield) {
+    this->flush(flagsBitfield);
+    return fGpu ? fGpu->insertFence() : 0;
+}
+
+bool GrContext::waitFence(GrFence fence, uint64_t timeoutNanos) {
+    if (!fence) {
+        return true;
+    }
+    return fGpu->waitFence(fence, timeoutNanos);
+}
+
+void GrContext::deleteFence(GrFence fence) {
+    if (fence) {
+        fGpu->deleteFence(fence);
+    }
+}
+
 bool sw_convert_to_premul(GrPixelConfig srcConfig, int width, int height, size_t inRowBytes,
                           const void* inPixels, size_t outRowBytes, void* outPixels) {
     SkSrcPixelInfo srcPI;
@@ -1411,7 +1488,8 @@ bool GrContext::writeSurfacePixels(GrSurface* surface,
                 this->flush();
             }
             return fGpu->writeTexturePixels(texture, left, top, width, height,
-                                            srcConfig, buffer, rowBytes);
+                                            srcConfig, buffer, rowBytes,
+                                            SkToBool(kStreamingSrc_PixelOpsFlag & pixelOpsFlags));
             // Don't need to check kFlushWrites_PixelOp here, we just did a direct write so the
             // upload is already flushed.
         }
@@ -1483,7 +1561,8 @@ bool GrContext::writeSurfacePixels(GrSurface* surface,
         this->flush();
     }
     if (!fGpu->writeTexturePixels(texture, 0, 0, width, height,
-                                  writeConfig, buffer, rowBytes)) {
+                                  writeConfig, buffer, rowBytes,
+                                  SkToBool(kStreamingSrc_PixelOpsFlag & pixelOpsFlags))) {
         return false;
     }
 
@@ -1526,6 +1605,33 @@ static SkColorType toggle_colortype32(SkColorType ct) {
     }
 }
 
+GrAsyncPixelRead GrContext::asyncReadRenderTargetPixels(GrRenderTarget* target,
+                                                        int left, int top, int width, int height,
+                                                        GrPixelConfig config, size_t rowBytes,
+                                                        AsyncReadPixelsProc proc, void* procCtx) {
+    if (!fDrawBuffer) {
+        return 0;
+    }
+    ASSERT_OWNED_RESOURCE(target);
+    SkASSERT(target);
+
+    this->flush();
+    return fGpu->insertAsyncReadPixels(target, left, top, width, height, config, rowBytes,
+                                       proc, procCtx);
+}
+
+bool GrContext::asyncReadPixelsIsReady(GrAsyncPixelRead read) {
+    return fGpu->asyncReadPixelsIsReady(read);
+}
+
+bool GrContext::finishAsyncReadPixels(GrAsyncPixelRead read, void* buffer, bool wait) {
+    return fGpu->finishAsyncReadPixels(read, buffer, wait);
+}
+
+int GrContext::processAsyncReadPixels(bool wait) {
+    return fGpu->processAsyncReadPixels(wait);
+}
+
 bool GrContext::readRenderTargetPixels(GrRenderTarget* target,
                                        int left, int top, int width, int height,
                                        GrPixelConfig dstConfig, void* buffer, size_t rowBytes,
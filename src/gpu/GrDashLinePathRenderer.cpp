@@ -17,17 +17,73 @@ GrDashLinePathRenderer::GrDashLinePathRenderer(GrContext* context)
 GrDashLinePathRenderer::~GrDashLinePathRenderer() {
 }
 
+// The most line segments we'll decompose a dashed polyline (or rect stroke) into before
+// handing the path off to a slower renderer. Each segment becomes its own dash batch.
+static const int kMaxDashedSegmentPts = 17;
+
+// If path is a single open or closed polyline, writes its points (with the closing point
+// repeated for closed contours) into pts and returns how many were written. Returns 0 for
+// anything else: multiple contours, curve segments, or more than maxPts points.
+static int get_polyline_pts(const SkPath& path, SkPoint pts[], int maxPts) {
+    SkPath::Iter iter(path, false);
+    SkPoint iterPts[4];
+    int count = 0;
+    for (;;) {
+        switch (iter.next(iterPts)) {
+            case SkPath::kMove_Verb:
+                if (count > 0) {
+                    return 0;
+                }
+                pts[count++] = iterPts[0];
+                break;
+            case SkPath::kLine_Verb:
+                if (count >= maxPts) {
+                    return 0;
+                }
+                pts[count++] = iterPts[1];
+                break;
+            case SkPath::kClose_Verb:
+                if (count > 1 && pts[count - 1] != pts[0]) {
+                    if (count >= maxPts) {
+                        return 0;
+                    }
+                    pts[count++] = pts[0];
+                }
+                break;
+            case SkPath::kDone_Verb:
+                return count >= 2 ? count : 0;
+            default:
+                return 0;   // quad, conic or cubic
+        }
+    }
+}
+
 bool GrDashLinePathRenderer::canDrawPath(const GrDrawTarget* target,
                                          const GrPipelineBuilder* pipelineBuilder,
                                          const SkMatrix& viewMatrix,
                                          const SkPath& path,
                                          const GrStrokeInfo& stroke,
                                          bool antiAlias) const {
+    if (!stroke.isDashed()) {
+        return false;
+    }
     SkPoint pts[2];
-    if (stroke.isDashed() && path.isLine(pts)) {
+    if (path.isLine(pts)) {
         return GrDashingEffect::CanDrawDashLine(pts, stroke, viewMatrix);
     }
-    return false;
+    // Polylines and rect strokes are drawn one segment at a time, so every segment must
+    // qualify on its own.
+    SkPoint poly[kMaxDashedSegmentPts];
+    int count = get_polyline_pts(path, poly, SK_ARRAY_COUNT(poly));
+    if (count < 2) {
+        return false;
+    }
+    for (int i = 0; i < count - 1; ++i) {
+        if (!GrDashingEffect::CanDrawDashLine(&poly[i], stroke, viewMatrix)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool GrDashLinePathRenderer::onDrawPath(GrDrawTarget* target,
@@ -38,7 +94,38 @@ bool GrDashLinePathRenderer::onDrawPath(GrDrawTarget* target,
                                         const GrStrokeInfo& stroke,
                                         bool useAA) {
     SkPoint pts[2];
-    SkAssertResult(path.isLine(pts));
-    return GrDashingEffect::DrawDashLine(target, pipelineBuilder, color,
-                                         viewMatrix, pts, useAA, stroke);
+    if (path.isLine(pts)) {
+        return GrDashingEffect::DrawDashLine(target, pipelineBuilder, color,
+                                             viewMatrix, pts, useAA, stroke);
+    }
+
+    SkPoint poly[kMaxDashedSegmentPts];
+    int count = get_polyline_pts(path, poly, SK_ARRAY_COUNT(poly));
+    SkASSERT(count >= 2);
+
+    // Draw each segment separately, advancing the dash phase by the length of every
+    // segment already drawn so the pattern flows continuously across the vertices.
+    // CanDrawDashLine only accepts two intervals, and a normalized phase (and hence a
+    // non-negative one coming out of the dash effect) stays in range under SkScalarMod.
+    SkASSERT(2 == stroke.getDashCount());
+    SkScalar intervals[2] = { stroke.getDashIntervals()[0], stroke.getDashIntervals()[1] };
+    const SkScalar intervalLength = intervals[0] + intervals[1];
+    SkPathEffect::DashInfo info;
+    info.fIntervals = intervals;
+    info.fCount = 2;
+    SkScalar phase = stroke.getDashPhase();
+    for (int i = 0; i < count - 1; ++i) {
+        if (poly[i] == poly[i + 1]) {
+            continue;
+        }
+        GrStrokeInfo segmentStroke(stroke, false);
+        info.fPhase = SkScalarMod(phase, intervalLength);
+        SkAssertResult(segmentStroke.setDashInfo(info));
+        if (!GrDashingEffect::DrawDashLine(target, pipelineBuilder, color, viewMatrix,
+                                           &poly[i], useAA, segmentStroke)) {
+            return false;
+        }
+        phase += SkPoint::Distance(poly[i], poly[i + 1]);
+    }
+    return true;
 }
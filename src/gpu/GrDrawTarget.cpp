@@ -491,12 +491,12 @@ bool GrDrawTarget::canCopySurface(const GrSurface* dst,
 
 void GrDrawTarget::setupPipeline(const PipelineInfo& pipelineInfo,
                                  GrPipeline* pipeline) {
-    SkNEW_PLACEMENT_ARGS(pipeline, GrPipeline, (*pipelineInfo.fPipelineBuilder,
-                                                pipelineInfo.fColorPOI,
-                                                pipelineInfo.fCoveragePOI,
-                                                *this->caps(),
-                                                *pipelineInfo.fScissor,
-                                                &pipelineInfo.fDstCopy));
+    GrPipeline::CreateAt(pipeline, *pipelineInfo.fPipelineBuilder,
+                         pipelineInfo.fColorPOI,
+                         pipelineInfo.fCoveragePOI,
+                         *this->caps(),
+                         *pipelineInfo.fScissor,
+                         &pipelineInfo.fDstCopy);
 }
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -624,6 +624,7 @@ void GrDrawTargetCaps::reset() {
     fCompressedTexSubImageSupport = false;
     fOversizedStencilSupport = false;
     fTextureBarrierSupport = false;
+    fInstancedArraysSupport = false;
 
     fUseDrawInsteadOfClear = false;
 
@@ -649,6 +650,7 @@ GrDrawTargetCaps& GrDrawTargetCaps::operator=(const GrDrawTargetCaps& other) {
     fCompressedTexSubImageSupport = other.fCompressedTexSubImageSupport;
     fOversizedStencilSupport = other.fOversizedStencilSupport;
     fTextureBarrierSupport = other.fTextureBarrierSupport;
+    fInstancedArraysSupport = other.fInstancedArraysSupport;
 
     fUseDrawInsteadOfClear = other.fUseDrawInsteadOfClear;
 
@@ -698,6 +700,7 @@ SkString GrDrawTargetCaps::dump() const {
     r.appendf("Compressed Update Support          : %s\n", gNY[fCompressedTexSubImageSupport]);
     r.appendf("Oversized Stencil Support          : %s\n", gNY[fOversizedStencilSupport]);
     r.appendf("Texture Barrier Support            : %s\n", gNY[fTextureBarrierSupport]);
+    r.appendf("Instanced Arrays Support           : %s\n", gNY[fInstancedArraysSupport]);
     r.appendf("Draw Instead of Clear [workaround] : %s\n", gNY[fUseDrawInsteadOfClear]);
 
     r.appendf("Max Texture Size                   : %d\n", fMaxTextureSize);
@@ -139,6 +139,9 @@ public:
     bool compressedTexSubImageSupport() const { return fCompressedTexSubImageSupport; }
     bool oversizedStencilSupport() const { return fOversizedStencilSupport; }
     bool textureBarrierSupport() const { return fTextureBarrierSupport; }
+    /** Can vertex attributes be advanced per instance rather than per vertex, with instanced
+        draw calls to match? */
+    bool instancedArraysSupport() const { return fInstancedArraysSupport; }
 
     bool useDrawInsteadOfClear() const { return fUseDrawInsteadOfClear; }
 
@@ -214,6 +217,7 @@ protected:
     bool fCompressedTexSubImageSupport  : 1;
     bool fOversizedStencilSupport       : 1;
     bool fTextureBarrierSupport         : 1;
+    bool fInstancedArraysSupport        : 1;
     // Driver workaround
     bool fUseDrawInsteadOfClear         : 1;
 
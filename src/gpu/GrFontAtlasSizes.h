@@ -38,7 +38,11 @@
 #define GR_FONT_ATLAS_TEXTURE_HEIGHT   2048
 
 #define GR_FONT_ATLAS_PLOT_WIDTH       256
-#define GR_FONT_ATLAS_A8_PLOT_WIDTH    512
+// 256x256 plots give the A8 atlas twice as many independently evictable plots in the same
+// texture. With a large (e.g. CJK) glyph working set this makes it far more likely the LRU
+// plot is no longer in flight, so we evict instead of forcing a mid-frame flush. Glyphs are
+// already capped at 256x256 (kGlyphMaxDim), so no glyph that fit before is excluded.
+#define GR_FONT_ATLAS_A8_PLOT_WIDTH    256
 #define GR_FONT_ATLAS_PLOT_HEIGHT      256
 
 #define GR_FONT_ATLAS_NUM_PLOTS_X     (GR_FONT_ATLAS_TEXTURE_WIDTH / GR_FONT_ATLAS_PLOT_WIDTH)
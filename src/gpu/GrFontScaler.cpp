@@ -11,6 +11,7 @@
 #include "GrFontScaler.h"
 #include "SkDescriptor.h"
 #include "SkDistanceFieldGen.h"
+#include "SkDistanceFieldPrefetcher.h"
 #include "SkGlyphCache.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -195,6 +196,25 @@ bool GrFontScaler::getPackedGlyphImage(GrGlyph::PackedID packed,
     return true;
 }
 
+void GrFontScaler::prefetchGlyphDFImage(GrGlyph::PackedID packed) {
+    const SkGlyph& glyph = fStrike->getGlyphIDMetrics(GrGlyph::UnpackID(packed),
+                                                      GrGlyph::UnpackFixedX(packed),
+                                                      GrGlyph::UnpackFixedY(packed));
+    // only A8 glyphs go through the prefetcher; BW glyphs are rare enough to
+    // generate inline
+    if (SkMask::kA8_Format != glyph.fMaskFormat || 0 == glyph.fWidth) {
+        return;
+    }
+    const void* image = fStrike->findImage(glyph);
+    if (NULL == image) {
+        return;
+    }
+    SkDistanceFieldPrefetcher::Prefetch(this->getDFKey(packed),
+                                        (const unsigned char*)image,
+                                        glyph.fWidth, glyph.fHeight,
+                                        glyph.rowBytes());
+}
+
 bool GrFontScaler::getPackedGlyphDFImage(GrGlyph::PackedID packed,
                                          int width, int height,
                                          void* dst) {
@@ -203,13 +223,17 @@ bool GrFontScaler::getPackedGlyphDFImage(GrGlyph::PackedID packed,
                                                       GrGlyph::UnpackFixedY(packed));
     SkASSERT(glyph.fWidth + 2*SK_DistanceFieldPad == width);
     SkASSERT(glyph.fHeight + 2*SK_DistanceFieldPad == height);
+    SkASSERT(dst);
+    SkMask::Format maskFormat = static_cast<SkMask::Format>(glyph.fMaskFormat);
+    if (SkMask::kA8_Format == maskFormat &&
+        SkDistanceFieldPrefetcher::Take(this->getDFKey(packed), (unsigned char*)dst)) {
+        return true;
+    }
     const void* image = fStrike->findImage(glyph);
     if (NULL == image) {
         return false;
     }
     // now generate the distance field
-    SkASSERT(dst);
-    SkMask::Format maskFormat = static_cast<SkMask::Format>(glyph.fMaskFormat);
     if (SkMask::kA8_Format == maskFormat) {
         // make the distance field from the image
         SkGenerateDistanceFieldFromA8Image((unsigned char*)dst,
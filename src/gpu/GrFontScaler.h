@@ -74,12 +74,20 @@ public:
     bool getPackedGlyphDFBounds(GrGlyph::PackedID, SkIRect* bounds);
     bool getPackedGlyphDFImage(GrGlyph::PackedID, int width, int height,
                                        void* image);
+    // Queue background distance field generation for an A8 glyph expected to
+    // draw soon (see SkDistanceFieldPrefetcher); getPackedGlyphDFImage picks
+    // the result up. Must be called on the thread that owns the strike.
+    void prefetchGlyphDFImage(GrGlyph::PackedID);
     bool getGlyphPath(uint16_t glyphID, SkPath*);
-    
+
 private:
+    uint64_t getDFKey(GrGlyph::PackedID packed) {
+        return ((uint64_t)this->getKey()->getHash() << 32) | packed;
+    }
+
     SkGlyphCache*  fStrike;
     GrFontDescKey* fKey;
-    
+
     typedef SkRefCnt INHERITED;
 };
 
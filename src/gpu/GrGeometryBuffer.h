@@ -98,6 +98,24 @@ public:
         return this->onUpdateData(src, srcSizeInBytes);
     }
 
+    /**
+     * Returns true if the backend keeps the buffer mapped for its entire lifetime
+     * (persistent-coherent mapping). Mapping such a buffer is free, so writers should prefer
+     * map() over updateData() regardless of how much data they have.
+     */
+    bool isPersistentlyMapped() const { return this->onIsPersistentlyMapped(); }
+
+    /**
+     * Notifies the buffer that every draw reading its current contents has been issued to the
+     * backend 3D API. Persistently mapped implementations insert a fence here and wait on it
+     * in the next map() so CPU writes can't race still-pending GPU reads. The buffer must not
+     * be mapped.
+     */
+    void finishedWithData() {
+        SkASSERT(!this->isMapped());
+        this->onFinishedWithData();
+    }
+
 protected:
     GrGeometryBuffer(GrGpu* gpu, size_t gpuMemorySize, bool dynamic, bool cpuBacked)
         : INHERITED(gpu, kCached_LifeCycle)
@@ -112,6 +130,8 @@ private:
     virtual void* onMap() = 0;
     virtual void onUnmap() = 0;
     virtual bool onUpdateData(const void* src, size_t srcSizeInBytes) = 0;
+    virtual bool onIsPersistentlyMapped() const { return false; }
+    virtual void onFinishedWithData() {}
 
     void*    fMapPtr;
     size_t   fGpuMemorySize;
@@ -88,6 +88,20 @@ protected:
         return fAttribs[fNumAttribs++];
     }
 
+    /**
+     * Like addVertexAttrib, but the attribute advances once per instance rather than once per
+     * vertex. Per-instance attributes contribute to the instance stride instead of the vertex
+     * stride and may only be used when the caps report instanced array support. As with
+     * addVertexAttrib, registration order must match the memory layout of the instance struct.
+     */
+    const Attribute& addInstanceAttrib(const Attribute& attribute) {
+        SkASSERT(fNumAttribs < kMaxVertexAttribs);
+        fInstanceStride += attribute.fOffset;
+        fAttribs[fNumAttribs] = attribute;
+        fAttribs[fNumAttribs].fPerInstance = true;
+        return fAttribs[fNumAttribs++];
+    }
+
     void setWillUseGeoShader() { fWillUseGeoShader = true; }
 
     // TODO hack see above
@@ -31,8 +31,12 @@ GrVertices& GrVertices::operator =(const GrVertices& di) {
     fIndicesPerInstance     = di.fIndicesPerInstance;
     fMaxInstancesPerDraw    = di.fMaxInstancesPerDraw;
 
+    fStartInstance          = di.fStartInstance;
+    fInstanceAttribCount    = di.fInstanceAttribCount;
+
     fVertexBuffer.reset(di.vertexBuffer());
     fIndexBuffer.reset(di.indexBuffer());
+    fInstanceAttribBuffer.reset(di.instanceAttribBuffer());
 
     return *this;
 }
@@ -233,10 +237,10 @@ bool GrGpu::readPixels(GrRenderTarget* target,
 bool GrGpu::writeTexturePixels(GrTexture* texture,
                                int left, int top, int width, int height,
                                GrPixelConfig config, const void* buffer,
-                               size_t rowBytes) {
+                               size_t rowBytes, bool streamingSrc) {
     this->handleDirtyContext();
     if (this->onWriteTexturePixels(texture, left, top, width, height,
-                                   config, buffer, rowBytes)) {
+                                   config, buffer, rowBytes, streamingSrc)) {
         fStats.incTextureUploads();
         return true;
     }
@@ -294,6 +298,10 @@ void GrGpu::removeGpuTraceMarker(const GrGpuTraceMarker* marker) {
 
 void GrGpu::draw(const DrawArgs& args, const GrVertices& vertices) {
     this->handleDirtyContext();
+    if (vertices.instanceCount() > vertices.maxInstancesPerDraw() &&
+        this->onMultiDraw(args, vertices)) {
+        return;
+    }
     GrVertices::Iterator iter;
     const GrNonInstancedVertices* verts = iter.init(vertices);
     do {
@@ -207,11 +207,15 @@ public:
      * @param buffer        memory to read pixels from
      * @param rowBytes      number of bytes between consecutive rows. Zero
      *                      means rows are tightly packed.
+     * @param streamingSrc  hints that buffer holds transient streamed data; the
+     *                      backend may stage the upload through a pixel buffer
+     *                      rather than copy the client memory synchronously.
      */
     bool writeTexturePixels(GrTexture* texture,
                             int left, int top, int width, int height,
                             GrPixelConfig config, const void* buffer,
-                            size_t rowBytes);
+                            size_t rowBytes,
+                            bool streamingSrc = false);
 
     /**
      * Clear the passed in render target. Ignores the draw state and clip. Clears the whole thing if
@@ -229,6 +233,12 @@ public:
      **/
     virtual void discard(GrRenderTarget* = NULL) = 0;
 
+    /**
+     * Called by the context after each flush. Gives the backend a chance to perform deferred
+     * housekeeping (e.g. batched object deletions) at a frame boundary.
+     */
+    virtual void didFlush() {}
+
     /**
      * This is can be called before allocating a texture to be a dst for copySurface. It will
      * populate the origin, config, and flags fields of the desc such that copySurface can
@@ -279,6 +289,48 @@ public:
     // Called before certain draws in order to guarantee coherent results from dst reads.
     virtual void xferBarrier(GrRenderTarget*, GrXferBarrierType) = 0;
 
+    // Inserts a fence into the GPU's command stream that signals once all preceding commands
+    // have been consumed. Returns 0 if the backend cannot create fences; callers should then
+    // treat the flushed work as already complete.
+    virtual GrFence insertFence() { return 0; }
+
+    // Returns true once the fence has signaled. A timeout of zero polls without blocking. The
+    // fence remains valid until deleteFence is called.
+    virtual bool waitFence(GrFence, uint64_t timeoutNanos) { return true; }
+
+    virtual void deleteFence(GrFence) {}
+
+    // Called on the context's thread when an asynchronous readback completes. pixels points at
+    // the rows top-to-bottom with the stride passed to insertAsyncReadPixels, and is only valid
+    // for the duration of the call.
+    typedef void (*AsyncReadPixelsProc)(void* ctx, const void* pixels, size_t rowBytes);
+
+    // Issues a readback of the target into driver-owned memory without waiting for the GPU,
+    // fenced behind the commands issued so far. Returns 0 if this backend cannot read the
+    // given rect and config asynchronously (or too many readbacks are already in flight);
+    // callers should then fall back to readPixels.
+    virtual GrAsyncPixelRead insertAsyncReadPixels(GrRenderTarget*, int left, int top,
+                                                   int width, int height, GrPixelConfig,
+                                                   size_t rowBytes, AsyncReadPixelsProc,
+                                                   void* procCtx) {
+        return 0;
+    }
+
+    // Returns true once the readback's fence has signaled, without blocking.
+    virtual bool asyncReadPixelsIsReady(GrAsyncPixelRead) { return false; }
+
+    // Completes a readback and retires its handle: delivers the pixels to the proc given at
+    // insert time, or copies them into buffer if no proc was given. If wait is false and the
+    // GPU has not finished, returns false and the handle stays live. Returns false and retires
+    // the handle if the pixels could not be retrieved (e.g. a lost context).
+    virtual bool finishAsyncReadPixels(GrAsyncPixelRead, void* buffer, bool wait) {
+        return false;
+    }
+
+    // Completes every in-flight readback that was given a proc and is ready (all of them, when
+    // wait is true), oldest first. Returns the number of readbacks still in flight.
+    virtual int processAsyncReadPixels(bool wait) { return 0; }
+
     struct DrawArgs {
         DrawArgs(const GrPrimitiveProcessor* primProc,
                  const GrPipeline* pipeline,
@@ -322,6 +374,33 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     // Debugging and Stats
 
+    /**
+     * A batch name together with the GPU time its submissions have accumulated while batch
+     * timing is enabled.
+     */
+    struct BatchTiming {
+        SkString fName;
+        uint64_t fGpuNanos;
+        int      fCount;
+    };
+
+    /**
+     * When enabled, each batch submission during command playback is bracketed in a GPU timer
+     * query (if the 3D API exposes one) and the elapsed time is aggregated under the batch's
+     * name. Timing is off by default; the queries themselves can cost GPU performance.
+     */
+    virtual void setBatchTimingEnabled(bool enabled) {}
+    virtual bool batchTimingEnabled() const { return false; }
+
+    /** Appends the aggregated batch timings to 'timings'. Submissions whose query results the
+        GPU hasn't produced yet are not included. */
+    virtual void getBatchTimings(SkTArray<BatchTiming>* timings) {}
+    virtual void resetBatchTimings() {}
+
+    // Called during command playback around each batch's draw submission.
+    virtual void beginBatchTiming(const char* name) {}
+    virtual void endBatchTiming() {}
+
     class Stats {
     public:
 #if GR_GPU_STATS
@@ -435,6 +514,12 @@ private:
 
     // overridden by backend-specific derived class to perform the draw call.
     virtual void onDraw(const DrawArgs&, const GrNonInstancedVertices&) = 0;
+
+    // Called before an instanced draw that exceeds the index buffer's instance capacity is
+    // chopped into multiple onDraw calls. A backend that can submit all the sub-draws with a
+    // single API call (e.g. multi-draw-indirect) performs the draw and returns true.
+    virtual bool onMultiDraw(const DrawArgs&, const GrVertices&) { return false; }
+
     virtual void onStencilPath(const GrPath*, const StencilPathState&) = 0;
 
     virtual void onDrawPath(const DrawArgs&, const GrPath*, const GrStencilSettings&) = 0;
@@ -458,7 +543,7 @@ private:
     virtual bool onWriteTexturePixels(GrTexture* texture,
                                       int left, int top, int width, int height,
                                       GrPixelConfig config, const void* buffer,
-                                      size_t rowBytes) = 0;
+                                      size_t rowBytes, bool streamingSrc) = 0;
 
     // overridden by backend-specific derived class to perform the resolve
     virtual void onResolveRenderTarget(GrRenderTarget* target) = 0;
@@ -64,6 +64,15 @@ private:
     uint32_t timestamp() const { return fResource->fTimestamp; }
     void setTimestamp(uint32_t ts) { fResource->fTimestamp = ts; }
 
+    SkMSec timeWhenResourceBecamePurgeable() const {
+        SkASSERT(fResource->isPurgeable());
+        return fResource->fTimeWhenBecamePurgeable;
+    }
+    void setTimeWhenResourceBecamePurgeable(SkMSec ms) {
+        SkASSERT(fResource->isPurgeable());
+        fResource->fTimeWhenBecamePurgeable = ms;
+    }
+
     int* accessCacheIndex() const { return &fResource->fCacheArrayIndex; }
 
     CacheAccess(GrGpuResource* resource) : fResource(resource) {}
@@ -9,7 +9,11 @@
 
 GrInOrderDrawBuffer::GrInOrderDrawBuffer(GrContext* context)
     : INHERITED(context)
-    , fCommands(GrCommandBuilder::Create(context->getGpu(), false))
+    // The reordering builder can't record NVPR path commands yet, so only use it when path
+    // rendering is off the table.
+    , fCommands(GrCommandBuilder::Create(
+          context->getGpu(),
+          !context->getGpu()->caps()->shaderCaps()->pathRenderingSupport()))
     , fPathIndexBuffer(kPathIdxBufferMinReserve * sizeof(char)/4)
     , fPathTransformBuffer(kPathXformBufferMinReserve * sizeof(float)/4)
     , fPipelineBuffer(kPipelineBufferMinReserve)
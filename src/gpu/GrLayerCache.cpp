@@ -77,8 +77,10 @@ private:
 #endif
 
 GrLayerCache::GrLayerCache(GrContext* context)
-    : fContext(context) {
+    : fContext(context)
+    , fCompactGeneration(0) {
     memset(fPlotLocks, 0, sizeof(fPlotLocks));
+    memset(fPlotLastUse, 0, sizeof(fPlotLastUse));
 }
 
 GrLayerCache::~GrLayerCache() {
@@ -469,6 +471,33 @@ void GrLayerCache::purgeAll() {
 }
 #endif
 
+void GrLayerCache::compact() {
+    if (!fAtlas) {
+        return;
+    }
+
+    ++fCompactGeneration;
+
+    // Walk from the least recently used plot and reclaim the first one that has gone cold.
+    // Purging a single plot per call spreads the reclamation (and subsequent re-rendering)
+    // cost over several frames rather than dumping the whole atlas at once.
+    GrAtlas::PlotIter iter;
+    GrPlot* plot;
+    for (plot = fAtlas->iterInit(&iter, GrAtlas::kLRUFirst_IterOrder);
+         plot;
+         plot = iter.prev()) {
+        if (fPlotLocks[plot->id()] > 0) {
+            continue;
+        }
+        if (fCompactGeneration - fPlotLastUse[plot->id()] < kPlotAgeThreshold) {
+            continue;
+        }
+
+        this->purgePlot(plot);
+        break;
+    }
+}
+
 void GrLayerCache::processDeletedPictures() {
     SkTArray<SkPicture::DeletionMessage> deletedPictures;
     fPictDeletionInbox.poll(&deletedPictures);
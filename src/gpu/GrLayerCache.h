@@ -328,6 +328,11 @@ public:
     // Cleanup after any SkPicture deletions
     void processDeletedPictures();
 
+    // Reclaim at most one cold, unlocked plot. Intended to be called once per frame (in
+    // lieu of a wholesale purge) so the atlas is defragmented incrementally while recently
+    // used layers stay resident for reuse.
+    void compact();
+
     SkDEBUGCODE(void validate() const;)
 
 #ifdef SK_DEVELOPER
@@ -374,6 +379,14 @@ private:
     // Plots with a 0 lock count are open for recycling/purging.
     int fPlotLocks[kNumPlotsX * kNumPlotsY];
 
+    // A plot must sit unused for this many compact() calls before it is reclaimed.
+    static const int kPlotAgeThreshold = 2;
+
+    // The generation (i.e., compact() call count) at which each plot was last locked.
+    // Together these age the plots so compact() only reclaims ones that have gone cold.
+    int64_t fCompactGeneration;
+    int64_t fPlotLastUse[kNumPlotsX * kNumPlotsY];
+
     // Inform the cache that layer's cached image is not currently required
     void unlock(GrCachedLayer* layer);
 
@@ -393,7 +406,10 @@ private:
     // was purged; false otherwise.
     bool purgePlot();
 
-    void incPlotLock(int plotIdx) { ++fPlotLocks[plotIdx]; }
+    void incPlotLock(int plotIdx) {
+        ++fPlotLocks[plotIdx];
+        fPlotLastUse[plotIdx] = fCompactGeneration;
+    }
     void decPlotLock(int plotIdx) {
         SkASSERT(fPlotLocks[plotIdx] > 0);
         --fPlotLocks[plotIdx];
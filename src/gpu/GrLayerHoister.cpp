@@ -379,12 +379,17 @@ void GrLayerHoister::UnlockLayers(GrContext* context,
 }
 
 void GrLayerHoister::PurgeCache(GrContext* context) {
-#if !GR_CACHE_HOISTED_LAYERS
     GrLayerCache* layerCache = context->getLayerCache();
 
+#if !GR_CACHE_HOISTED_LAYERS
     // This code completely clears out the atlas. It is required when
     // caching is disabled so the atlas doesn't fill up and force more
     // free floating layers
     layerCache->purgeAll();
+#else
+    // With caching enabled plots are left resident so their layers can be reused. Reclaim
+    // fragmented space one cold plot at a time rather than letting stale layers accumulate
+    // until freeAll.
+    layerCache->compact();
 #endif
 }
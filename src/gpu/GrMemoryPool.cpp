@@ -13,10 +13,14 @@
     #define VALIDATE
 #endif
 
-GrMemoryPool::GrMemoryPool(size_t preallocSize, size_t minAllocSize) {
+GrMemoryPool::GrMemoryPool(size_t preallocSize, size_t minAllocSize, bool smallAllocFreeLists) {
     SkDEBUGCODE(fAllocationCnt = 0);
+    SkDEBUGCODE(fFreeListCnt = 0);
     SkDEBUGCODE(fAllocBlockCnt = 0);
 
+    fSmallAllocFreeListsEnabled = smallAllocFreeLists;
+    memset(fFreeLists, 0, sizeof(fFreeLists));
+
     minAllocSize = SkTMax<size_t>(minAllocSize, 1 << 10);
     fMinAllocSize = GrSizeAlignUp(minAllocSize + kPerAllocPad, kAlignment),
     fPreallocSize = GrSizeAlignUp(preallocSize + kPerAllocPad, kAlignment);
@@ -31,6 +35,7 @@ GrMemoryPool::GrMemoryPool(size_t preallocSize, size_t minAllocSize) {
 };
 
 GrMemoryPool::~GrMemoryPool() {
+    this->drainSmallAllocFreeLists();
     VALIDATE;
     SkASSERT(0 == fAllocationCnt);
     SkASSERT(fHead == fTail);
@@ -42,6 +47,19 @@ void* GrMemoryPool::allocate(size_t size) {
     VALIDATE;
     size = GrSizeAlignUp(size, kAlignment);
     size += kPerAllocPad;
+    if (fSmallAllocFreeListsEnabled && size <= kSmallAllocLimit) {
+        void** head = &fFreeLists[size >> kAlignmentShift];
+        if (void* slot = *head) {
+            // The slot's AllocHeader still describes it from its previous life.
+            *head = *reinterpret_cast<void**>(slot);
+            SkASSERT(size == reinterpret_cast<AllocHeader*>(
+                                 reinterpret_cast<intptr_t>(slot) - kPerAllocPad)->fSize);
+            SkDEBUGCODE(++fAllocationCnt);
+            SkDEBUGCODE(--fFreeListCnt);
+            VALIDATE;
+            return slot;
+        }
+    }
     if (fTail->fFreeSize < size) {
         size_t blockSize = size;
         blockSize = SkTMax<size_t>(blockSize, fMinAllocSize);
@@ -57,9 +75,11 @@ void* GrMemoryPool::allocate(size_t size) {
     }
     SkASSERT(fTail->fFreeSize >= size);
     intptr_t ptr = fTail->fCurrPtr;
-    // We stash a pointer to the block header, just before the allocated space,
-    // so that we can decrement the live count on delete in constant time.
-    *reinterpret_cast<BlockHeader**>(ptr) = fTail;
+    // We stash the block header and padded size just before the allocated space, so that we can
+    // decrement the live count on delete (and pick a freelist) in constant time.
+    AllocHeader* allocHeader = reinterpret_cast<AllocHeader*>(ptr);
+    allocHeader->fBlock = fTail;
+    allocHeader->fSize = size;
     ptr += kPerAllocPad;
     fTail->fPrevPtr = fTail->fCurrPtr;
     fTail->fCurrPtr += size;
@@ -73,8 +93,27 @@ void* GrMemoryPool::allocate(size_t size) {
 
 void GrMemoryPool::release(void* p) {
     VALIDATE;
+    const AllocHeader* allocHeader = reinterpret_cast<const AllocHeader*>(
+            reinterpret_cast<intptr_t>(p) - kPerAllocPad);
+    if (fSmallAllocFreeListsEnabled && allocHeader->fSize <= kSmallAllocLimit) {
+        // Park the slot on its size's freelist rather than returning it to the block. The slot
+        // keeps its spot in the block's live count so the block can't be reclaimed from under it.
+        void** head = &fFreeLists[allocHeader->fSize >> kAlignmentShift];
+        *reinterpret_cast<void**>(p) = *head;
+        *head = p;
+        SkDEBUGCODE(--fAllocationCnt);
+        SkDEBUGCODE(++fFreeListCnt);
+        VALIDATE;
+        return;
+    }
+    this->returnToBlock(p);
+    SkDEBUGCODE(--fAllocationCnt);
+    VALIDATE;
+}
+
+void GrMemoryPool::returnToBlock(void* p) {
     intptr_t ptr = reinterpret_cast<intptr_t>(p) - kPerAllocPad;
-    BlockHeader* block = *reinterpret_cast<BlockHeader**>(ptr);
+    BlockHeader* block = reinterpret_cast<AllocHeader*>(ptr)->fBlock;
     if (1 == block->fLiveCount) {
         // the head block is special, it is reset rather than deleted
         if (fHead == block) {
@@ -104,7 +143,19 @@ void GrMemoryPool::release(void* p) {
             block->fCurrPtr = block->fPrevPtr;
         }
     }
-    SkDEBUGCODE(--fAllocationCnt);
+}
+
+void GrMemoryPool::drainSmallAllocFreeLists() {
+    for (int i = 0; i < kNumFreeLists; ++i) {
+        void* slot = fFreeLists[i];
+        fFreeLists[i] = NULL;
+        while (slot) {
+            void* next = *reinterpret_cast<void**>(slot);
+            this->returnToBlock(slot);
+            SkDEBUGCODE(--fFreeListCnt);
+            slot = next;
+        }
+    }
     VALIDATE;
 }
 
@@ -159,11 +210,12 @@ void GrMemoryPool::validate() {
             SkASSERT(ptrOffset ==  kHeaderSize);
             SkASSERT(userStart == block->fCurrPtr);
         } else {
-            SkASSERT(block == *reinterpret_cast<BlockHeader**>(userStart));
+            SkASSERT(block == reinterpret_cast<AllocHeader*>(userStart)->fBlock);
         }
         prev = block;
     } while ((block = block->fNext));
-    SkASSERT(allocCount == fAllocationCnt);
+    // Freelisted slots still count against their blocks' live counts.
+    SkASSERT(allocCount == fAllocationCnt + fFreeListCnt);
     SkASSERT(prev == fTail);
     SkASSERT(fAllocBlockCnt != 0 || fSize == fPreallocSize);
 #endif
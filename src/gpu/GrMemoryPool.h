@@ -22,9 +22,14 @@ public:
     /**
      * Prealloc size is the amount of space to make available at pool creation
      * time and keep around until pool destruction. The min alloc size is the
-     * smallest allowed size of additional allocations.
+     * smallest allowed size of additional allocations. When smallAllocFreeLists
+     * is true, released allocations up to kSmallAllocLimit bytes are kept on
+     * per-size freelists and handed back out by later allocates, making
+     * release/allocate of small objects a couple of pointer swaps and avoiding
+     * block churn; the pool then holds on to its high-water memory until it is
+     * destroyed.
      */
-    GrMemoryPool(size_t preallocSize, size_t minAllocSize);
+    GrMemoryPool(size_t preallocSize, size_t minAllocSize, bool smallAllocFreeLists = false);
 
     ~GrMemoryPool();
 
@@ -68,19 +73,41 @@ private:
         size_t       fSize;      ///< total allocated size of the block
     };
 
+    /// Stashed just before each allocation so release runs in constant time.
+    struct AllocHeader {
+        BlockHeader* fBlock;     ///< the block the allocation was parceled from.
+        size_t       fSize;      ///< padded size of the allocation, including this header.
+    };
+
     enum {
         // We assume this alignment is good enough for everybody.
-        kAlignment    = 8,
-        kHeaderSize   = GR_CT_ALIGN_UP(sizeof(BlockHeader), kAlignment),
-        kPerAllocPad  = GR_CT_ALIGN_UP(sizeof(BlockHeader*), kAlignment),
+        kAlignment       = 8,
+        kAlignmentShift  = 3,
+        kHeaderSize      = GR_CT_ALIGN_UP(sizeof(BlockHeader), kAlignment),
+        kPerAllocPad     = GR_CT_ALIGN_UP(sizeof(AllocHeader), kAlignment),
+        // Largest padded allocation eligible for the small-allocation freelists.
+        kSmallAllocLimit = 512,
+        kNumFreeLists    = (kSmallAllocLimit >> kAlignmentShift) + 1,
     };
+
+    /// The portion of release() that hands the allocation's space back to its block.
+    void returnToBlock(void* p);
+
+    /// Returns all freelisted slots to their blocks (called during destruction).
+    void drainSmallAllocFreeLists();
+
     size_t                            fSize;
     size_t                            fPreallocSize;
     size_t                            fMinAllocSize;
     BlockHeader*                      fHead;
     BlockHeader*                      fTail;
+    bool                              fSmallAllocFreeListsEnabled;
+    /// Heads of singly-linked lists of released small allocations, indexed by padded size.
+    /// Slots on a freelist still count against their block's fLiveCount so the block stays put.
+    void*                             fFreeLists[kNumFreeLists];
 #ifdef SK_DEBUG
     int                               fAllocationCnt;
+    int                               fFreeListCnt;
     int                               fAllocBlockCnt;
 #endif
 };
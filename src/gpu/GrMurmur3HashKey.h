@@ -15,8 +15,8 @@
 
 /**
  *  GrMurmur3HashKey is a hash key class that can take a data chunk of any predetermined
- *  length. It uses the Murmur3 hash function. It is intended to be used with
- *  SkTDynamicHash.
+ *  length. It uses SkChecksum::Hash32 (Murmur3, or hardware CRC32 when available).
+ *  It is intended to be used with SkTDynamicHash.
  */
 template<size_t KEY_SIZE_IN_BYTES>
 class GrMurmur3HashKey {
@@ -36,7 +36,7 @@ public:
         SK_COMPILE_ASSERT(KEY_SIZE_IN_BYTES % 4 == 0, key_size_mismatch);
         memcpy(fData, data, KEY_SIZE_IN_BYTES);
 
-        fHash = SkChecksum::Murmur3(fData, KEY_SIZE_IN_BYTES);
+        fHash = SkChecksum::Hash32(fData, KEY_SIZE_IN_BYTES);
 #ifdef SK_DEBUG
         fIsValid = true;
 #endif
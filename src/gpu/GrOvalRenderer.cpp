@@ -37,6 +37,15 @@ struct CircleVertex {
     SkScalar fInnerRadius;
 };
 
+// Per-instance data for the instanced-arrays circle path. The four corner vertices are shared by
+// every circle in the batch; the bounding geometry is reconstructed in the vertex shader as
+// fCenter + corner * fOuterRadius.
+struct CircleInstance {
+    SkPoint  fCenter;
+    SkScalar fOuterRadius;
+    SkScalar fInnerRadius;
+};
+
 struct EllipseVertex {
     SkPoint  fPos;
     SkPoint  fOffset;
@@ -67,16 +76,23 @@ inline bool circle_stays_circle(const SkMatrix& m) {
  *             p is the position in the normalized space.
  *             outerRad is the outerRadius in device space.
  *             innerRad is the innerRadius in normalized space (ignored if not stroking).
+ *
+ * When created for instanced arrays the position is instead computed in the vertex shader from a
+ * shared per-vertex corner in the normalized space and a per-instance vec4 of
+ * (center.xy, outerRad, innerRad).
  */
 
 class CircleEdgeEffect : public GrGeometryProcessor {
 public:
-    static GrGeometryProcessor* Create(GrColor color, bool stroke, const SkMatrix& localMatrix) {
-        return SkNEW_ARGS(CircleEdgeEffect, (color, stroke, localMatrix));
+    static GrGeometryProcessor* Create(GrColor color, bool stroke, const SkMatrix& localMatrix,
+                                       bool usesInstancedArrays = false) {
+        return SkNEW_ARGS(CircleEdgeEffect, (color, stroke, localMatrix, usesInstancedArrays));
     }
 
     const Attribute* inPosition() const { return fInPosition; }
     const Attribute* inCircleEdge() const { return fInCircleEdge; }
+    const Attribute* inCorner() const { return fInCorner; }
+    const Attribute* inCircleData() const { return fInCircleData; }
     GrColor color() const { return fColor; }
     const SkMatrix& localMatrix() const { return fLocalMatrix; }
     virtual ~CircleEdgeEffect() {}
@@ -102,18 +118,37 @@ public:
 
             GrGLVertToFrag v(kVec4f_GrSLType);
             args.fPB->addVarying("CircleEdge", &v);
-            vsBuilder->codeAppendf("%s = %s;", v.vsOut(), ce.inCircleEdge()->fName);
 
             // Setup pass through color
             this->setupColorPassThrough(pb, local.fInputColorType, args.fOutputColor, NULL,
                                         &fColorUniform);
 
-            // Setup position
-            this->setupPosition(pb, gpArgs, ce.inPosition()->fName);
+            if (ce.hasInstanceAttribs()) {
+                vsBuilder->codeAppendf("%s = vec4(%s, %s.z, %s.w);", v.vsOut(),
+                                       ce.inCorner()->fName, ce.inCircleData()->fName,
+                                       ce.inCircleData()->fName);
 
-            // emit transforms
-            this->emitTransforms(args.fPB, gpArgs->fPositionVar, ce.inPosition()->fName,
-                                 ce.localMatrix(), args.fTransformsIn, args.fTransformsOut);
+                // Reconstruct the bounding geometry from the shared corner and the instance data.
+                vsBuilder->codeAppendf("vec2 circlePos = %s.xy + %s * %s.z;",
+                                       ce.inCircleData()->fName, ce.inCorner()->fName,
+                                       ce.inCircleData()->fName);
+
+                // Setup position
+                this->setupPosition(pb, gpArgs, "circlePos");
+
+                // emit transforms
+                this->emitTransforms(args.fPB, gpArgs->fPositionVar, "circlePos",
+                                     ce.localMatrix(), args.fTransformsIn, args.fTransformsOut);
+            } else {
+                vsBuilder->codeAppendf("%s = %s;", v.vsOut(), ce.inCircleEdge()->fName);
+
+                // Setup position
+                this->setupPosition(pb, gpArgs, ce.inPosition()->fName);
+
+                // emit transforms
+                this->emitTransforms(args.fPB, gpArgs->fPositionVar, ce.inPosition()->fName,
+                                     ce.localMatrix(), args.fTransformsIn, args.fTransformsOut);
+            }
 
             GrGLFragmentBuilder* fsBuilder = args.fPB->getFragmentShaderBuilder();
             fsBuilder->codeAppendf("float d = length(%s.xy);", v.fsIn());
@@ -135,6 +170,7 @@ public:
             const CircleEdgeEffect& ce = gp.cast<CircleEdgeEffect>();
             uint16_t key = ce.isStroked() ? 0x1 : 0x0;
             key |= local.fUsesLocalCoords && ce.localMatrix().hasPerspective() ? 0x2 : 0x0;
+            key |= ce.hasInstanceAttribs() ? 0x4 : 0x0;
             b->add32(key << 16 | local.fInputColorType);
         }
 
@@ -181,14 +217,26 @@ public:
     }
 
 private:
-    CircleEdgeEffect(GrColor color, bool stroke, const SkMatrix& localMatrix)
+    CircleEdgeEffect(GrColor color, bool stroke, const SkMatrix& localMatrix,
+                     bool usesInstancedArrays)
         : fColor(color)
         , fLocalMatrix(localMatrix) {
         this->initClassID<CircleEdgeEffect>();
-        fInPosition = &this->addVertexAttrib(Attribute("inPosition", kVec2f_GrVertexAttribType,
-                                                       kHigh_GrSLPrecision));
-        fInCircleEdge = &this->addVertexAttrib(Attribute("inCircleEdge",
-                                                           kVec4f_GrVertexAttribType));
+        if (usesInstancedArrays) {
+            fInPosition = NULL;
+            fInCircleEdge = NULL;
+            fInCorner = &this->addVertexAttrib(Attribute("inCorner", kVec2f_GrVertexAttribType));
+            fInCircleData = &this->addInstanceAttrib(Attribute("inCircleData",
+                                                               kVec4f_GrVertexAttribType,
+                                                               kHigh_GrSLPrecision));
+        } else {
+            fInPosition = &this->addVertexAttrib(Attribute("inPosition", kVec2f_GrVertexAttribType,
+                                                           kHigh_GrSLPrecision));
+            fInCircleEdge = &this->addVertexAttrib(Attribute("inCircleEdge",
+                                                               kVec4f_GrVertexAttribType));
+            fInCorner = NULL;
+            fInCircleData = NULL;
+        }
         fStroke = stroke;
     }
 
@@ -202,6 +250,8 @@ private:
     SkMatrix fLocalMatrix;
     const Attribute* fInPosition;
     const Attribute* fInCircleEdge;
+    const Attribute* fInCorner;
+    const Attribute* fInCircleData;
     bool fStroke;
 
     GR_DECLARE_GEOMETRY_PROCESSOR_TEST;
@@ -691,10 +741,13 @@ public:
             return;
         }
 
+        bool useInstancedArrays = batchTarget->caps().instancedArraysSupport();
+
         // Setup geometry processor
         SkAutoTUnref<GrGeometryProcessor> gp(CircleEdgeEffect::Create(this->color(),
                                                                       this->stroke(),
-                                                                      invert));
+                                                                      invert,
+                                                                      useInstancedArrays));
 
         batchTarget->initDraw(gp, pipeline);
 
@@ -709,6 +762,52 @@ public:
         gp->initBatchTracker(batchTarget->currentBatchTracker(), init);
 
         int instanceCount = fGeoData.count();
+
+        if (useInstancedArrays) {
+            // Four corner vertices shared by every circle; per-circle data rides in an instanced
+            // stream so each additional circle costs one CircleInstance rather than four vertices.
+            SkASSERT(gp->getVertexStride() == sizeof(SkPoint));
+            SkASSERT(gp->getInstanceStride() == sizeof(CircleInstance));
+
+            const GrVertexBuffer* cornerBuffer;
+            int firstCorner;
+            SkPoint* corners = static_cast<SkPoint*>(batchTarget->makeVertSpace(
+                    sizeof(SkPoint), kVerticesPerQuad, &cornerBuffer, &firstCorner));
+            if (!corners) {
+                SkDebugf("Could not allocate vertices\n");
+                return;
+            }
+            // Triangle strip order.
+            corners[0].set(-1, -1);
+            corners[1].set(-1,  1);
+            corners[2].set( 1, -1);
+            corners[3].set( 1,  1);
+
+            const GrVertexBuffer* instanceBuffer;
+            int firstInstance;
+            CircleInstance* instances = static_cast<CircleInstance*>(batchTarget->makeVertSpace(
+                    sizeof(CircleInstance), instanceCount, &instanceBuffer, &firstInstance));
+            if (!instances) {
+                SkDebugf("Could not allocate vertices\n");
+                return;
+            }
+
+            for (int i = 0; i < instanceCount; i++) {
+                const Geometry& geom = fGeoData[i];
+                instances[i].fCenter.set(geom.fDevBounds.centerX(), geom.fDevBounds.centerY());
+                instances[i].fOuterRadius = geom.fOuterRadius;
+                // The inner radius in the instance data must be specified in normalized space.
+                instances[i].fInnerRadius = geom.fInnerRadius / geom.fOuterRadius;
+            }
+
+            GrVertices vertices;
+            vertices.initInstancedArrays(kTriangleStrip_GrPrimitiveType, cornerBuffer,
+                                         instanceBuffer, firstCorner, firstInstance,
+                                         kVerticesPerQuad, instanceCount);
+            batchTarget->draw(vertices);
+            return;
+        }
+
         size_t vertexStride = gp->getVertexStride();
         SkASSERT(vertexStride == sizeof(CircleVertex));
         QuadHelper helper;
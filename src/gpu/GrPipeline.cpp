@@ -14,6 +14,17 @@
 #include "GrProcOptInfo.h"
 #include "GrXferProcessor.h"
 
+GrPipeline* GrPipeline::CreateAt(void* memory,
+                                 const GrPipelineBuilder& pipelineBuilder,
+                                 const GrProcOptInfo& colorPOI,
+                                 const GrProcOptInfo& coveragePOI,
+                                 const GrDrawTargetCaps& caps,
+                                 const GrScissorState& scissorState,
+                                 const GrDeviceCoordTexture* dstCopy) {
+    return SkNEW_PLACEMENT_ARGS(memory, GrPipeline, (pipelineBuilder, colorPOI, coveragePOI,
+                                                     caps, scissorState, dstCopy));
+}
+
 GrPipeline::GrPipeline(const GrPipelineBuilder& pipelineBuilder,
                        const GrProcOptInfo& colorPOI,
                        const GrProcOptInfo& coveragePOI,
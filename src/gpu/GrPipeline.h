@@ -24,17 +24,25 @@ class GrPipelineBuilder;
 /**
  * Class that holds an optimized version of a GrPipelineBuilder. It is meant to be an immutable
  * class, and contains all data needed to set the state for a gpu draw.
+ *
+ * Pipelines are not reference counted. They are created in place in per-flush arena storage
+ * (the draw buffer's pipeline buffer) via CreateAt, hold only pending-execution references to
+ * their processors, and are destroyed in bulk when the draw buffer resets after a flush.
  */
 class GrPipeline {
 public:
     SK_DECLARE_INST_COUNT(GrPipeline)
 
-    GrPipeline(const GrPipelineBuilder&,
-               const GrProcOptInfo& colorPOI,
-               const GrProcOptInfo& coveragePOI,
-               const GrDrawTargetCaps&,
-               const GrScissorState&,
-               const GrDeviceCoordTexture* dstCopy);
+    /** Creates the pipeline in preallocated (arena) storage and returns it. The caller is
+        responsible for eventually running the destructor; the storage itself is reclaimed by
+        whoever owns the arena. */
+    static GrPipeline* CreateAt(void* memory,
+                                const GrPipelineBuilder&,
+                                const GrProcOptInfo& colorPOI,
+                                const GrProcOptInfo& coveragePOI,
+                                const GrDrawTargetCaps&,
+                                const GrScissorState&,
+                                const GrDeviceCoordTexture* dstCopy);
 
     /*
      * Returns true if these pipelines are equivalent.
@@ -99,6 +107,13 @@ public:
     const GrPipelineInfo& getInitBatchTracker() const { return fInitBT; }
 
 private:
+    GrPipeline(const GrPipelineBuilder&,
+               const GrProcOptInfo& colorPOI,
+               const GrProcOptInfo& coveragePOI,
+               const GrDrawTargetCaps&,
+               const GrScissorState&,
+               const GrDeviceCoordTexture* dstCopy);
+
     /**
      * Alter the program desc and inputs (attribs and processors) based on the blend optimization.
      */
@@ -140,8 +155,6 @@ private:
     int                                 fNumColorStages;
 
     GrProgramDesc fDesc;
-
-    typedef SkRefCnt INHERITED;
 };
 
 #endif
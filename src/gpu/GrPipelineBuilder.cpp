@@ -25,12 +25,20 @@ GrPipelineBuilder::GrPipelineBuilder()
     SkDEBUGCODE(fBlockEffectRemovalCnt = 0;)
 }
 
+GrPipelineBuilder::GrPipelineBuilder(const GrPaint& paint, GrRenderTarget* rt,
+                                     const GrClip& clip) {
+    SkDEBUGCODE(fBlockEffectRemovalCnt = 0;)
+    this->setFromPaint(paint, rt, clip);
+}
+
 GrPipelineBuilder& GrPipelineBuilder::operator=(const GrPipelineBuilder& that) {
     fRenderTarget.reset(SkSafeRef(that.fRenderTarget.get()));
     fFlags = that.fFlags;
     fStencilSettings = that.fStencilSettings;
     fDrawFace = that.fDrawFace;
-    fXPFactory.reset(SkRef(that.getXPFactory()));
+    if (fXPFactory.get() != that.getXPFactory()) {
+        fXPFactory.reset(SkRef(that.getXPFactory()));
+    }
     fColorStages = that.fColorStages;
     fCoverageStages = that.fCoverageStages;
     fClip = that.fClip;
@@ -37,6 +37,10 @@ public:
         *this = pipelineBuilder;
     }
 
+    /** Constructs the builder directly from a paint; equivalent to default construction followed
+        by setFromPaint(). */
+    GrPipelineBuilder(const GrPaint&, GrRenderTarget*, const GrClip&);
+
     virtual ~GrPipelineBuilder();
 
     /**
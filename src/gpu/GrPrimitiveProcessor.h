@@ -125,17 +125,22 @@ public:
         Attribute()
             : fName(NULL)
             , fType(kFloat_GrVertexAttribType)
-            , fOffset(0) {}
+            , fOffset(0)
+            , fPerInstance(false) {}
         Attribute(const char* name, GrVertexAttribType type,
                   GrSLPrecision precision = kDefault_GrSLPrecision)
             : fName(name)
             , fType(type)
             , fOffset(SkAlign4(GrVertexAttribTypeSize(type)))
-            , fPrecision(precision) {}
+            , fPrecision(precision)
+            , fPerInstance(false) {}
         const char* fName;
         GrVertexAttribType fType;
         size_t fOffset;
         GrSLPrecision fPrecision;
+        // Advanced once per instance rather than once per vertex. Only set on contexts with
+        // instanced array support. Does not affect the GLSL declaration of the attribute.
+        bool fPerInstance;
     };
 
     int numAttribs() const { return fNumAttribs; }
@@ -149,6 +154,11 @@ public:
     // structs.  In this case, it is best to assert the vertexstride == sizeof(VertexStruct).
     size_t getVertexStride() const { return fVertexStride; }
 
+    // The combined size of the per-instance attributes, or 0 if the GP has none. When nonzero the
+    // draw must supply a second vertex stream that is advanced once per instance.
+    size_t getInstanceStride() const { return fInstanceStride; }
+    bool hasInstanceAttribs() const { return fInstanceStride > 0; }
+
     /**
      * Gets a transformKey from an array of coord transforms
      */
@@ -175,11 +185,13 @@ protected:
     GrPrimitiveProcessor(bool isPathRendering)
         : fNumAttribs(0)
         , fVertexStride(0)
+        , fInstanceStride(0)
         , fIsPathRendering(isPathRendering) {}
 
     Attribute fAttribs[kMaxVertexAttribs];
     int fNumAttribs;
     size_t fVertexStride;
+    size_t fInstanceStride;
 
 private:
     virtual bool hasExplicitLocalCoords() const = 0;
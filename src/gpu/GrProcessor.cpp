@@ -90,7 +90,9 @@ public:
     ~MemoryPoolAccessor() { gProcessorSpinlock.release(); }
 
     GrMemoryPool* pool() const {
-        static GrMemoryPool gPool(4096, 4096);
+        // Processors are small and short-lived; keep released slots on the pool's freelists so
+        // allocation while holding the spinlock is a couple of pointer swaps.
+        static GrMemoryPool gPool(4096, 4096, /* smallAllocFreeLists = */ true);
         return &gPool;
     }
 };
@@ -50,6 +50,9 @@ public:
         return NULL;
     }
 
+protected:
+    bool sortsDrawsAtFlush() const override { return true; }
+
 private:
     typedef GrCommandBuilder INHERITED;
 
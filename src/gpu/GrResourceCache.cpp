@@ -14,6 +14,7 @@
 #include "SkGr.h"
 #include "SkMessageBus.h"
 #include "SkTSort.h"
+#include "SkTime.h"
 
 DECLARE_SKMESSAGEBUS_MESSAGE(GrUniqueKeyInvalidatedMessage);
 
@@ -366,6 +367,7 @@ void GrResourceCache::notifyCntReachedZero(GrGpuResource* resource, uint32_t fla
     SkASSERT(resource->isPurgeable());
     this->removeFromNonpurgeableArray(resource);
     fPurgeableQueue.insert(resource);
+    resource->cacheAccess().setTimeWhenResourceBecamePurgeable(SkTime::GetMSecs());
 
     if (!resource->resourcePriv().isBudgeted()) {
         // Check whether this resource could still be used as a scratch resource.
@@ -497,6 +499,55 @@ void GrResourceCache::purgeAllUnlocked() {
     this->validate();
 }
 
+void GrResourceCache::purgeResourcesNotUsedForMs(SkMSec msNotUsed) {
+    const SkMSec now = SkTime::GetMSecs();
+
+    // The queue is ordered by cache timestamp rather than wall clock time, but timestamps are
+    // assigned in the same order that resources become purgeable, so once the front of the queue
+    // is fresh enough everything behind it is too.
+    while (fPurgeableQueue.count()) {
+        GrGpuResource* resource = fPurgeableQueue.peek();
+        SkASSERT(resource->isPurgeable());
+        if (now - resource->cacheAccess().timeWhenResourceBecamePurgeable() < msNotUsed) {
+            break;
+        }
+        resource->cacheAccess().release();
+    }
+
+    this->validate();
+}
+
+void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources) {
+    size_t bytesPurged = 0;
+
+    if (preferScratchResources) {
+        // Gather the scratch resources to delete in one pass before releasing any; releasing
+        // reshuffles the heap out from under at(). This pass visits the queue in heap order
+        // rather than strict LRU order, which is fine for a memory pressure purge.
+        SkTDArray<GrGpuResource*> scratchResources;
+        for (int i = 0; i < fPurgeableQueue.count() && bytesPurged < bytesToPurge; ++i) {
+            GrGpuResource* resource = fPurgeableQueue.at(i);
+            SkASSERT(resource->isPurgeable());
+            if (resource->cacheAccess().isScratch()) {
+                *scratchResources.append() = resource;
+                bytesPurged += resource->gpuMemorySize();
+            }
+        }
+        for (int i = 0; i < scratchResources.count(); ++i) {
+            scratchResources[i]->cacheAccess().release();
+        }
+    }
+
+    while (bytesPurged < bytesToPurge && fPurgeableQueue.count()) {
+        GrGpuResource* resource = fPurgeableQueue.peek();
+        SkASSERT(resource->isPurgeable());
+        bytesPurged += resource->gpuMemorySize();
+        resource->cacheAccess().release();
+    }
+
+    this->validate();
+}
+
 void GrResourceCache::processInvalidUniqueKeys(
     const SkTArray<GrUniqueKeyInvalidatedMessage>& msgs) {
     for (int i = 0; i < msgs.count(); ++i) {
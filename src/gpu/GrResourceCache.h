@@ -160,6 +160,16 @@ public:
     /** Purges all resources that don't have external owners. */
     void purgeAllUnlocked();
 
+    /** Purges resources that haven't been used in the past 'msNotUsed' milliseconds, regardless
+        of whether the cache is over budget. Intended to be called from a client's idle loop so
+        the resulting 3D API deletions happen between frames. */
+    void purgeResourcesNotUsedForMs(SkMSec msNotUsed);
+
+    /** Purges unlocked resources, LRU first, until 'bytesToPurge' bytes have been freed or no
+        purgeable resources remain. If 'preferScratchResources' is true then scratch resources are
+        purged before resources with unique keys. Intended for memory pressure events. */
+    void purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources);
+
     /**
      * The callback function used by the cache when it is still over budget after a purge. The
      * passed in 'data' is the same 'data' handed to setOverbudgetCallback.
@@ -55,6 +55,10 @@ const GrIndexBuffer* GrResourceProvider::createInstancedIndexBuffer(const uint16
     return buffer;
 }
 
+GrVertexBuffer* GrResourceProvider::createVertexBuffer(size_t size, bool dynamic) {
+    return this->gpu()->createVertexBuffer(size, dynamic);
+}
+
 const GrIndexBuffer* GrResourceProvider::createQuadIndexBuffer() {
     static const int kMaxQuads = 1 << 12; // max possible: (1 << 14) - 1;
     GR_STATIC_ASSERT(4 * kMaxQuads <= 65535);
@@ -58,6 +58,12 @@ public:
      * Draw with kTriangles_GrPrimitiveType
      * @ return the quad index buffer
      */
+    /**
+     * Creates a vertex buffer. The caller owns a ref on the returned buffer. The buffer is not
+     * given a unique key; use assignUniqueKeyToResource to make it findable in the cache.
+     */
+    GrVertexBuffer* createVertexBuffer(size_t size, bool dynamic);
+
     const GrIndexBuffer* refQuadIndexBuffer() {
         if (GrIndexBuffer* buffer =
             this->findAndRefTByUniqueKey<GrIndexBuffer>(fQuadIndexBufferKey)) {
@@ -13,6 +13,8 @@
 
 #include "SkData.h"
 #include "SkDistanceFieldGen.h"
+#include "SkFloatBits.h"
+#include "SkMessageBus.h"
 #include "SkStrokeRec.h"
 
 // TODO: try to remove this #include
@@ -96,6 +98,42 @@ static bool choose_compressed_fmt(const GrDrawTargetCaps* caps,
     return false;
 }
 
+// When the path's generation ID changes, purge the mask cached under 'key'.
+class PathInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PathInvalidator(const GrUniqueKey& key) : fMsg(key) {}
+private:
+    GrUniqueKeyInvalidatedMessage fMsg;
+
+    void onChange() override {
+        SkMessageBus<GrUniqueKeyInvalidatedMessage>::Post(fMsg);
+    }
+};
+
+// Builds a key that pins down the rendered mask exactly: the path's contents, its fill and
+// stroke styling, anti-aliasing, the device transform with the mask bounds' origin folded in,
+// and the mask dimensions. Two draws share a key only when they would rasterize bit-identical
+// masks, which is the common case for a soft clip or path redrawn in place frame after frame.
+static void build_mask_key(GrUniqueKey* key, const SkPath& path, const SkStrokeRec& stroke,
+                           bool antiAlias, const SkMatrix& maskMatrix,
+                           const SkIRect& resultBounds) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey::Builder builder(key, kDomain, 15);
+    builder[0] = path.getGenerationID();
+    builder[1] = path.getFillType() |
+                 (stroke.getStyle() << 8) |
+                 (stroke.getJoin() << 12) |
+                 (stroke.getCap() << 16) |
+                 ((antiAlias ? 1 : 0) << 20);
+    builder[2] = SkFloat2Bits(stroke.getWidth());
+    builder[3] = SkFloat2Bits(stroke.getMiter());
+    for (int i = 0; i < 9; ++i) {
+        builder[4 + i] = SkFloat2Bits(maskMatrix.get(i));
+    }
+    builder[13] = resultBounds.width();
+    builder[14] = resultBounds.height();
+}
+
 }
 
 /**
@@ -229,7 +267,7 @@ bool GrSWMaskHelper::init(const SkIRect& resultBounds,
 /**
  * Get a texture (from the texture cache) of the correct size & format.
  */
-GrTexture* GrSWMaskHelper::createTexture() {
+GrTexture* GrSWMaskHelper::createTexture(bool cacheable) {
     GrSurfaceDesc desc;
     desc.fWidth = fBM.width();
     desc.fHeight = fBM.height();
@@ -248,6 +286,12 @@ GrTexture* GrSWMaskHelper::createTexture() {
         SkASSERT(fContext->getGpu()->caps()->isConfigTexturable(desc.fConfig));
     }
 
+    if (cacheable) {
+        // A unique key will be attached to this texture, so give it exact dimensions rather than
+        // pulling a potentially larger texture from the scratch pool.
+        return fContext->textureProvider()->createTexture(desc, true);
+    }
+
     return fContext->textureProvider()->refScratchTexture(
         desc, GrTextureProvider::kApprox_ScratchTexMatch);
 }
@@ -319,8 +363,10 @@ void GrSWMaskHelper::toSDF(unsigned char* sdf) {
 ////////////////////////////////////////////////////////////////////////////////
 /**
  * Software rasterizes path to A8 mask (possibly using the context's matrix)
- * and uploads the result to a scratch texture. Returns the resulting
- * texture on success; NULL on failure.
+ * and uploads the result to a texture. Returns the resulting texture on
+ * success; NULL on failure. Masks for non-volatile paths are cached in the
+ * resource cache so a path redrawn with the same transform and style skips
+ * rasterization and upload entirely.
  */
 GrTexture* GrSWMaskHelper::DrawPathMaskToTexture(GrContext* context,
                                                  const SkPath& path,
@@ -334,15 +380,35 @@ GrTexture* GrSWMaskHelper::DrawPathMaskToTexture(GrContext* context,
         return NULL;
     }
 
+    // Volatile paths are not expected to recur, so don't fill the cache with their masks.
+    GrUniqueKey key;
+    if (!path.isVolatile()) {
+        build_mask_key(&key, path, stroke, antiAlias, helper.fMatrix, resultBounds);
+        GrTexture* cached = context->textureProvider()->findAndRefTextureByUniqueKey(key);
+        if (cached) {
+            return cached;
+        }
+    }
+
     helper.draw(path, stroke, SkRegion::kReplace_Op, antiAlias, 0xFF);
 
-    GrTexture* texture(helper.createTexture());
+    GrTexture* texture(helper.createTexture(key.isValid()));
     if (!texture) {
         return NULL;
     }
 
     helper.toTexture(texture);
 
+    if (key.isValid()) {
+        // The key is assigned only now that the mask's contents are complete; a texture must not
+        // become findable while it is still blank.
+        context->textureProvider()->assignUniqueKeyToTexture(key, texture);
+        // Purge the cached mask when the path's contents change or the path goes away. The
+        // listener attaches to the shared SkPathRef, so a local copy of the path suffices.
+        SkPath listenerPath(path);
+        listenerPath.addGenIDChangeListener(SkNEW_ARGS(PathInvalidator, (key)));
+    }
+
     return texture;
 }
 
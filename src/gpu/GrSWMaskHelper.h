@@ -99,9 +99,11 @@ public:
                                          const SkIRect& rect);
 
 private:
-    // Helper function to get a scratch texture suitable for capturing the
-    // result (i.e., right size & format)
-    GrTexture* createTexture();
+    // Helper function to get a texture suitable for capturing the result
+    // (i.e., right size & format). Cacheable masks get an exact-size texture
+    // so a unique key can be attached to them; one-shot masks come from the
+    // scratch pool.
+    GrTexture* createTexture(bool cacheable);
 
     GrContext*      fContext;
     SkMatrix        fMatrix;
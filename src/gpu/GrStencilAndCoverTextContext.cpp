@@ -27,7 +27,11 @@ GrStencilAndCoverTextContext::GrStencilAndCoverTextContext(GrContext* context,
     : GrTextContext(context, gpuDevice, properties)
     , fStroke(SkStrokeRec::kFill_InitStyle)
     , fQueuedGlyphCount(0)
-    , fFallbackGlyphsIdx(kGlyphBufferSize) {
+    , fFallbackGlyphsIdx(kGlyphBufferSize)
+    , fCachedGlyphs(NULL)
+    , fCachedTypefaceID(0)
+    , fCachedDescChecksum(0)
+    , fCachedStrokeKey(0) {
 }
 
 GrStencilAndCoverTextContext*
@@ -42,6 +46,7 @@ GrStencilAndCoverTextContext::Create(GrContext* context, SkGpuDevice* gpuDevice,
 }
 
 GrStencilAndCoverTextContext::~GrStencilAndCoverTextContext() {
+    SkSafeUnref(fCachedGlyphs);
 }
 
 bool GrStencilAndCoverTextContext::canDraw(const GrRenderTarget* rt,
@@ -245,6 +250,39 @@ static GrPathRange* get_gr_glyphs(GrContext* ctx,
     return glyphs.detach();
 }
 
+void GrStencilAndCoverTextContext::PreloadGlyphs(GrContext* ctx, SkTypeface* typeface) {
+    // Build the canonically sized glyph path range used by kMaxPerformance_RenderMode and
+    // leave it behind in the resource cache under its unique key, where the first real draw
+    // with this typeface will find it.
+    SkStrokeRec fill(SkStrokeRec::kFill_InitStyle);
+    SkSafeUnref(get_gr_glyphs(ctx, typeface, NULL, fill));
+}
+
+GrPathRange* GrStencilAndCoverTextContext::getGlyphs(const SkTypeface* typeface,
+                                                     const SkDescriptor* desc,
+                                                     const SkStrokeRec& stroke) {
+    const uint32_t typefaceID = typeface ? typeface->uniqueID() : 0;
+    const uint32_t descChecksum = desc ? desc->getChecksum() : 0;
+    const uint64_t strokeKey = GrPath::ComputeStrokeKey(stroke);
+
+    if (fCachedGlyphs &&
+        fCachedTypefaceID == typefaceID &&
+        fCachedDescChecksum == descChecksum &&
+        fCachedStrokeKey == strokeKey &&
+        !fCachedGlyphs->wasDestroyed() &&
+        (NULL == desc || fCachedGlyphs->isEqualTo(*desc))) {
+        return SkRef(fCachedGlyphs);
+    }
+
+    GrPathRange* glyphs = get_gr_glyphs(fContext, typeface, desc, stroke);
+    SkSafeUnref(fCachedGlyphs);
+    fCachedGlyphs = SkRef(glyphs);
+    fCachedTypefaceID = typefaceID;
+    fCachedDescChecksum = descChecksum;
+    fCachedStrokeKey = strokeKey;
+    return glyphs;
+}
+
 void GrStencilAndCoverTextContext::init(GrRenderTarget* rt,
                                         const GrClip& clip,
                                         const GrPaint& paint,
@@ -293,8 +331,8 @@ void GrStencilAndCoverTextContext::init(GrRenderTarget* rt,
 
         fGlyphCache = fSkPaint.detachCache(&fDeviceProperties, &fContextInitialMatrix,
                                            true /*ignoreGamma*/);
-        fGlyphs = get_gr_glyphs(fContext, fGlyphCache->getScalerContext()->getTypeface(),
-                                &fGlyphCache->getDescriptor(), fStroke);
+        fGlyphs = this->getGlyphs(fGlyphCache->getScalerContext()->getTypeface(),
+                                  &fGlyphCache->getDescriptor(), fStroke);
     } else {
         // Don't bake strokes into the glyph outlines. We will stroke the glyphs
         // using the GPU instead. This is the fast path.
@@ -363,9 +401,9 @@ void GrStencilAndCoverTextContext::init(GrRenderTarget* rt,
 
         fGlyphCache = fSkPaint.detachCache(&fDeviceProperties, NULL, true /*ignoreGamma*/);
         fGlyphs = canUseRawPaths ?
-                      get_gr_glyphs(fContext, fSkPaint.getTypeface(), NULL, fStroke) :
-                      get_gr_glyphs(fContext, fGlyphCache->getScalerContext()->getTypeface(),
-                                    &fGlyphCache->getDescriptor(), fStroke);
+                      this->getGlyphs(fSkPaint.getTypeface(), NULL, fStroke) :
+                      this->getGlyphs(fGlyphCache->getScalerContext()->getTypeface(),
+                                      &fGlyphCache->getDescriptor(), fStroke);
     }
 
     fStateRestore.set(&fPipelineBuilder);
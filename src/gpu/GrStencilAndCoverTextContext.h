@@ -15,6 +15,8 @@
 class GrTextStrike;
 class GrPath;
 class GrPathRange;
+class SkDescriptor;
+class SkTypeface;
 
 /*
  * This class implements text rendering using stencil and cover path rendering
@@ -28,6 +30,13 @@ public:
 
     virtual ~GrStencilAndCoverTextContext();
 
+    /**
+     * Builds the glyph path range for the given typeface ahead of time, leaving it behind in
+     * the context's resource cache so the first text draw with that typeface does not stall
+     * on glyph path creation. Must be called on the context's thread.
+     */
+    static void PreloadGlyphs(GrContext*, SkTypeface*);
+
 private:
     static const int kGlyphBufferSize = 1024;
 
@@ -67,6 +76,12 @@ private:
     SkMatrix                                            fViewMatrix;
     SkMatrix                                            fLocalMatrix;
     bool                                                fUsingDeviceSpaceGlyphs;
+    // One-entry memo of the most recently used glyph path range, so back-to-back draws with
+    // the same typeface skip the resource cache lookup.
+    GrPathRange*                                        fCachedGlyphs;
+    uint32_t                                            fCachedTypefaceID;
+    uint32_t                                            fCachedDescChecksum;
+    uint64_t                                            fCachedStrokeKey;
 
     GrStencilAndCoverTextContext(GrContext*, SkGpuDevice*, const SkDeviceProperties&);
 
@@ -87,6 +102,7 @@ private:
               size_t textByteLength, RenderMode, const SkMatrix& viewMatrix,
               const SkIRect& regionClipBounds);
     bool mapToFallbackContext(SkMatrix* inverse);
+    GrPathRange* getGlyphs(const SkTypeface*, const SkDescriptor*, const SkStrokeRec&);
     void appendGlyph(const SkGlyph&, const SkPoint&);
     void flush();
     void finish();
@@ -14,18 +14,30 @@ void GrTargetCommands::reset() {
     fBatchTarget.reset();
 }
 
-void GrTargetCommands::flush(GrInOrderDrawBuffer* iodb) {
+void GrTargetCommands::flush(GrInOrderDrawBuffer* iodb, bool sortDraws) {
     if (fCmdBuffer.empty()) {
         return;
     }
 
     GrGpu* gpu = iodb->getGpu();
 
+    // Flatten the recorder so the sorting pass below can permute it. Geometry generation and
+    // execution must visit the draws in the same order because each batch's draws are consumed
+    // from the batch target in FIFO order.
+    SkTDArray<Cmd*> cmds;
+    CmdBuffer::Iter cmdIter(fCmdBuffer);
+    while (cmdIter.next()) {
+        *cmds.append() = cmdIter.get();
+    }
+
+    if (sortDraws) {
+        this->sortDrawsByState(&cmds);
+    }
+
     // Loop over all batches and generate geometry
-    CmdBuffer::Iter genIter(fCmdBuffer);
-    while (genIter.next()) {
-        if (Cmd::kDrawBatch_CmdType == genIter->type()) {
-            DrawBatch* db = reinterpret_cast<DrawBatch*>(genIter.get());
+    for (int i = 0; i < cmds.count(); ++i) {
+        if (Cmd::kDrawBatch_CmdType == cmds[i]->type()) {
+            DrawBatch* db = static_cast<DrawBatch*>(cmds[i]);
             fBatchTarget.resetNumberOfDraws();
             db->fBatch->generateGeometry(&fBatchTarget, db->fState->getPipeline());
             db->fBatch->setNumberOfDraws(fBatchTarget.numberOfDraws());
@@ -34,19 +46,17 @@ void GrTargetCommands::flush(GrInOrderDrawBuffer* iodb) {
 
     fBatchTarget.preFlush();
 
-    CmdBuffer::Iter iter(fCmdBuffer);
-
-    while (iter.next()) {
+    for (int i = 0; i < cmds.count(); ++i) {
         GrGpuTraceMarker newMarker("", -1);
         SkString traceString;
-        if (iter->isTraced()) {
-            traceString = iodb->getCmdString(iter->markerID());
+        if (cmds[i]->isTraced()) {
+            traceString = iodb->getCmdString(cmds[i]->markerID());
             newMarker.fMarker = traceString.c_str();
             gpu->addGpuTraceMarker(&newMarker);
         }
 
-        iter->execute(gpu);
-        if (iter->isTraced()) {
+        cmds[i]->execute(gpu);
+        if (cmds[i]->isTraced()) {
             gpu->removeGpuTraceMarker(&newMarker);
         }
     }
@@ -54,6 +64,49 @@ void GrTargetCommands::flush(GrInOrderDrawBuffer* iodb) {
     fBatchTarget.postFlush();
 }
 
+static bool intersect(const SkRect& a, const SkRect& b) {
+    SkASSERT(a.fLeft <= a.fRight && a.fTop <= a.fBottom &&
+             b.fLeft <= b.fRight && b.fTop <= b.fBottom);
+    return a.fLeft < b.fRight && b.fLeft < a.fRight &&
+           a.fTop < b.fBottom && b.fTop < a.fBottom;
+}
+
+void GrTargetCommands::sortDrawsByState(SkTDArray<Cmd*>* cmds) {
+    // Group draws that share a pipeline next to one another so playback switches GPU state as
+    // rarely as possible. Only runs of adjacent DrawBatch commands are permuted; every other
+    // command type is a barrier. Each draw slides backward toward the most recent draw with an
+    // equal pipeline, stopping if it would cross a draw whose bounds intersect its own, so
+    // overlapping geometry still renders in submission order.
+    int runStart = 0;
+    for (int i = 0; i <= cmds->count(); ++i) {
+        if (i < cmds->count() && Cmd::kDrawBatch_CmdType == (*cmds)[i]->type()) {
+            continue;
+        }
+        // [runStart, i) is a maximal run of draws.
+        for (int d = runStart + 1; d < i; ++d) {
+            DrawBatch* draw = static_cast<DrawBatch*>((*cmds)[d]);
+            int dest = d;
+            for (int j = d - 1; j >= runStart; --j) {
+                DrawBatch* other = static_cast<DrawBatch*>((*cmds)[j]);
+                if (other->fState->getPipeline()->isEqual(*draw->fState->getPipeline())) {
+                    dest = j + 1;
+                    break;
+                }
+                if (intersect(other->fBatch->bounds(), draw->fBatch->bounds())) {
+                    break;
+                }
+            }
+            if (dest < d) {
+                for (int j = d; j > dest; --j) {
+                    (*cmds)[j] = (*cmds)[j - 1];
+                }
+                (*cmds)[dest] = draw;
+            }
+        }
+        runStart = i + 1;
+    }
+}
+
 void GrTargetCommands::StencilPath::execute(GrGpu* gpu) {
     GrGpu::StencilPathState state;
     state.fRenderTarget = fRenderTarget.get();
@@ -90,8 +143,10 @@ void GrTargetCommands::DrawPaths::execute(GrGpu* gpu) {
                    fCount, fStencilSettings);
 }
 
-void GrTargetCommands::DrawBatch::execute(GrGpu*) {
+void GrTargetCommands::DrawBatch::execute(GrGpu* gpu) {
+    gpu->beginBatchTiming(fBatch->name());
     fBatchTarget->flushNext(fBatch->numberOfDraws());
+    gpu->endBatchTiming();
 }
 
 void GrTargetCommands::Clear::execute(GrGpu* gpu) {
@@ -17,6 +17,7 @@
 #include "GrRenderTarget.h"
 #include "GrTRecorder.h"
 #include "SkRect.h"
+#include "SkTDArray.h"
 #include "SkTypes.h"
 
 class GrInOrderDrawBuffer;
@@ -60,9 +61,13 @@ public:
     };
 
     void reset();
-    void flush(GrInOrderDrawBuffer*);
+    // When sortDraws is true, runs of adjacent draws are regrouped by pipeline before playback
+    // (see sortDrawsByState) to minimize GPU state changes.
+    void flush(GrInOrderDrawBuffer*, bool sortDraws = false);
 
 private:
+    void sortDrawsByState(SkTDArray<Cmd*>* cmds);
+
     friend class GrCommandBuilder;
     friend class GrInOrderDrawBuffer; // This goes away when State becomes just a pipeline
     friend class GrReorderCommandBuilder;
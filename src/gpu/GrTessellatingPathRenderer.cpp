@@ -12,9 +12,11 @@
 #include "GrBatchTest.h"
 #include "GrDefaultGeoProcFactory.h"
 #include "GrPathUtils.h"
+#include "GrResourceProvider.h"
 #include "GrVertices.h"
 #include "SkChunkAlloc.h"
 #include "SkGeometry.h"
+#include "SkMessageBus.h"
 
 #include <stdio.h>
 
@@ -1353,6 +1355,18 @@ bool GrTessellatingPathRenderer::canDrawPath(const GrDrawTarget* target,
     return stroke.isFillStyle() && !antiAlias && !path.isConvex();
 }
 
+// When the path's genID changes, invalidate the cached tessellation described by key.
+class PathInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PathInvalidator(const GrUniqueKey& key) : fMsg(key) {}
+private:
+    GrUniqueKeyInvalidatedMessage fMsg;
+
+    void onChange() override {
+        SkMessageBus<GrUniqueKeyInvalidatedMessage>::Post(fMsg);
+    }
+};
+
 class TessellatingPathBatch : public GrBatch {
 public:
 
@@ -1395,6 +1409,11 @@ public:
         }
         SkScalar screenSpaceTol = GrPathUtils::kDefaultTolerance;
         SkScalar tol = GrPathUtils::scaleToleranceToSrc(screenSpaceTol, fViewMatrix, pathBounds);
+        // Round the tolerance down to a power of two, so that paths drawn at slightly different
+        // view matrix scales land in the same cache bucket. Rounding down means a cached
+        // tessellation is never coarser than this draw requires.
+        int32_t tolBucket = SkScalarFloorToInt(SkScalarLog2(tol));
+        tol = SkScalarPow(2, SkIntToScalar(tolBucket));
         int contourCnt;
         int maxPts = GrPathUtils::worstCasePointCount(fPath, &contourCnt, tol);
         if (maxPts <= 0) {
@@ -1416,6 +1435,39 @@ public:
         batchTarget->initDraw(gp, pipeline);
         gp->initBatchTracker(batchTarget->currentBatchTracker(), fPipelineInfo);
 
+        size_t stride = gp->getVertexStride();
+        SkASSERT(stride == sizeof(SkPoint));
+        GrPrimitiveType primitiveType = WIREFRAME ? kLines_GrPrimitiveType
+                                                  : kTriangles_GrPrimitiveType;
+
+        // Cache the tessellated triangles in the resource cache, keyed by the path's genID, its
+        // fill type and the tolerance bucket. Inverse fills also depend on the clip bounds, so
+        // those are mixed into the key as well.
+        static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+        GrUniqueKey key;
+        int clipBoundsSize32 = fPath.isInverseFillType() ? sizeof(fClipBounds) / sizeof(uint32_t)
+                                                         : 0;
+        {
+            GrUniqueKey::Builder builder(&key, kDomain, 3 + clipBoundsSize32);
+            builder[0] = fPath.getGenerationID();
+            builder[1] = fillType;
+            builder[2] = (uint32_t) tolBucket;
+            if (clipBoundsSize32) {
+                memcpy(&builder[3], &fClipBounds, sizeof(fClipBounds));
+            }
+        }
+        GrResourceProvider* rp = batchTarget->resourceProvider();
+        SkAutoTUnref<GrVertexBuffer> vertexBuffer(rp->findAndRefTByUniqueKey<GrVertexBuffer>(key));
+        if (vertexBuffer) {
+            // The cached buffer holds exactly the emitted triangles, so its size gives the count.
+            int actualCount = SkToInt(vertexBuffer->gpuMemorySize() / stride);
+            LOG("reusing %d cached verts\n", actualCount);
+            GrVertices vertices;
+            vertices.init(primitiveType, vertexBuffer, 0, actualCount);
+            batchTarget->draw(vertices);
+            return;
+        }
+
         SkAutoTDeleteArray<Vertex*> contours(SkNEW_ARRAY(Vertex *, contourCnt));
 
         // For the initial size of the chunk allocator, estimate based on the point count:
@@ -1436,30 +1488,30 @@ public:
             return;
         }
 
-        size_t stride = gp->getVertexStride();
-        SkASSERT(stride == sizeof(SkPoint));
-        const GrVertexBuffer* vertexBuffer;
-        int firstVertex;
-        SkPoint* verts = static_cast<SkPoint*>(
-            batchTarget->makeVertSpace(stride, count, &vertexBuffer, &firstVertex));
-        if (!verts) {
-            SkDebugf("Could not allocate vertices\n");
-            return;
-        }
-
+        // Tessellate into temporary storage first; the cached buffer is sized to the actual
+        // triangle count, which is not known until the polys are emitted.
+        SkAutoTMalloc<SkPoint> verts(count);
         LOG("emitting %d verts\n", count);
-        SkPoint* end = polys_to_triangles(polys, fillType, verts);
-        int actualCount = static_cast<int>(end - verts);
+        SkPoint* end = polys_to_triangles(polys, fillType, verts.get());
+        int actualCount = static_cast<int>(end - verts.get());
         LOG("actual count: %d\n", actualCount);
         SkASSERT(actualCount <= count);
+        if (0 == actualCount) {
+            return;
+        }
+
+        vertexBuffer.reset(rp->createVertexBuffer(actualCount * stride, /* dynamic = */ false));
+        if (!vertexBuffer || !vertexBuffer->updateData(verts.get(), actualCount * stride)) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+        rp->assignUniqueKeyToResource(key, vertexBuffer);
+        // Purge the cached triangles when the path's contents change or the path goes away.
+        fPath.addGenIDChangeListener(SkNEW_ARGS(PathInvalidator, (key)));
 
-        GrPrimitiveType primitiveType = WIREFRAME ? kLines_GrPrimitiveType
-                                                  : kTriangles_GrPrimitiveType;
         GrVertices vertices;
-        vertices.init(primitiveType, vertexBuffer, firstVertex, actualCount);
+        vertices.init(primitiveType, vertexBuffer, 0, actualCount);
         batchTarget->draw(vertices);
-
-        batchTarget->putBackVertices((size_t)(count - actualCount), stride);
         return;
     }
 
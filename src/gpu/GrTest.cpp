@@ -53,8 +53,16 @@ void GrContext::printCacheStats() const {
 
 void GrContext::dumpGpuStats(SkString* out) const {
 #if GR_GPU_STATS
-    return fGpu->stats()->dump(out);
+    fGpu->stats()->dump(out);
 #endif
+    SkTArray<GrGpu::BatchTiming> timings;
+    fGpu->getBatchTimings(&timings);
+    for (int i = 0; i < timings.count(); ++i) {
+        out->appendf("Batch \"%s\": %.3f ms over %d submissions\n",
+                     timings[i].fName.c_str(),
+                     timings[i].fGpuNanos * 1e-6,
+                     timings[i].fCount);
+    }
 }
 
 void GrContext::printGpuStats() const {
@@ -225,7 +233,7 @@ private:
     bool onWriteTexturePixels(GrTexture* texture,
                               int left, int top, int width, int height,
                               GrPixelConfig config, const void* buffer,
-                              size_t rowBytes) override {
+                              size_t rowBytes, bool streamingSrc) override {
         return false;
     }
 
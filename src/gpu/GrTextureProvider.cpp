@@ -10,6 +10,7 @@
 #include "GrTexturePriv.h"
 #include "GrResourceCache.h"
 #include "GrGpu.h"
+#include "SkTDArray.h"
 
 enum ScratchTextureFlags {
     kExact_ScratchTextureFlag           = 0x1,
@@ -107,6 +108,30 @@ GrTexture* GrTextureProvider::internalRefScratchTexture(const GrSurfaceDesc& inD
     return NULL;
 }
 
+void GrTextureProvider::prewarmScratchTextures(const GrSurfaceDesc descs[], int count) {
+    if (this->isAbandoned()) {
+        return;
+    }
+
+    // Hold a ref on each texture until every request has been satisfied so that two identical
+    // descs yield two textures rather than the second request finding the first texture in
+    // the cache.
+    SkTDArray<GrTexture*> textures;
+    for (int i = 0; i < count; ++i) {
+        // Compressed textures are never recycled as scratch so there is nothing to warm up.
+        if (GrPixelConfigIsCompressed(descs[i].fConfig)) {
+            continue;
+        }
+        if (GrTexture* texture = this->internalRefScratchTexture(descs[i], 0)) {
+            *textures.append() = texture;
+        }
+    }
+
+    for (int i = 0; i < textures.count(); ++i) {
+        textures[i]->unref();
+    }
+}
+
 GrTexture* GrTextureProvider::wrapBackendTexture(const GrBackendTextureDesc& desc) {
     if (this->isAbandoned()) {
         return NULL;
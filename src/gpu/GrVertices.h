@@ -20,17 +20,31 @@ public:
     int indexCount() const { return fIndexCount; }
     bool isIndexed() const { return fIndexCount > 0; }
 
+    /** These describe the second, per-instance attribute stream of a hardware-instanced draw.
+        They are 0/NULL unless initInstancedArrays was used. */
+    int startInstance() const { return fStartInstance; }
+    int instanceAttribCount() const { return fInstanceAttribCount; }
+    bool isInstancedArrays() const { return fInstanceAttribCount > 0; }
+
     const GrVertexBuffer* vertexBuffer() const { return fVertexBuffer.get(); }
     const GrIndexBuffer* indexBuffer() const { return fIndexBuffer.get(); }
+    const GrVertexBuffer* instanceAttribBuffer() const { return fInstanceAttribBuffer.get(); }
 
 protected:
+    GrNonInstancedVertices()
+        : fStartInstance(0)
+        , fInstanceAttribCount(0) {}
+
     GrPrimitiveType         fPrimitiveType;
     int                     fStartVertex;
     int                     fStartIndex;
     int                     fVertexCount;
     int                     fIndexCount;
+    int                     fStartInstance;
+    int                     fInstanceAttribCount;
     GrPendingIOResource<const GrVertexBuffer, kRead_GrIOType> fVertexBuffer;
     GrPendingIOResource<const GrIndexBuffer, kRead_GrIOType>  fIndexBuffer;
+    GrPendingIOResource<const GrVertexBuffer, kRead_GrIOType> fInstanceAttribBuffer;
     friend class GrVertices;
 };
 
@@ -62,6 +76,44 @@ public:
         fVerticesPerInstance = 0;
         fIndicesPerInstance = 0;
         fMaxInstancesPerDraw = 0;
+        fStartInstance = 0;
+        fInstanceAttribCount = 0;
+        fInstanceAttribBuffer.reset(NULL);
+    }
+
+    /**
+     * Sets up a non-indexed hardware-instanced draw: each of 'instanceAttribCount' instances
+     * re-runs the 'vertexCount' vertices from 'vertexBuffer' while per-instance attributes are
+     * sourced from 'instanceAttribBuffer'. Only legal when the caps report instanced array
+     * support and the geometry processor declares per-instance attributes.
+     */
+    void initInstancedArrays(GrPrimitiveType primType,
+                             const GrVertexBuffer* vertexBuffer,
+                             const GrVertexBuffer* instanceAttribBuffer,
+                             int startVertex,
+                             int startInstance,
+                             int vertexCount,
+                             int instanceAttribCount) {
+        SkASSERT(vertexBuffer);
+        SkASSERT(instanceAttribBuffer);
+        SkASSERT(vertexCount);
+        SkASSERT(instanceAttribCount);
+        SkASSERT(startVertex >= 0);
+        SkASSERT(startInstance >= 0);
+        fPrimitiveType = primType;
+        fVertexBuffer.reset(vertexBuffer);
+        fIndexBuffer.reset(NULL);
+        fStartVertex = startVertex;
+        fStartIndex = 0;
+        fVertexCount = vertexCount;
+        fIndexCount = 0;
+        fInstanceCount = 0;
+        fVerticesPerInstance = 0;
+        fIndicesPerInstance = 0;
+        fMaxInstancesPerDraw = 0;
+        fStartInstance = startInstance;
+        fInstanceAttribCount = instanceAttribCount;
+        fInstanceAttribBuffer.reset(instanceAttribBuffer);
     }
 
     void initIndexed(GrPrimitiveType primType,
@@ -88,6 +140,9 @@ public:
         fVerticesPerInstance = 0;
         fIndicesPerInstance = 0;
         fMaxInstancesPerDraw = 0;
+        fStartInstance = 0;
+        fInstanceAttribCount = 0;
+        fInstanceAttribBuffer.reset(NULL);
     }
 
 
@@ -119,6 +174,9 @@ public:
         fVertexCount = instanceCount * fVerticesPerInstance;
         fIndexCount = instanceCount * fIndicesPerInstance;
         fMaxInstancesPerDraw = maxInstancesPerDraw;
+        fStartInstance = 0;
+        fInstanceAttribCount = 0;
+        fInstanceAttribBuffer.reset(NULL);
     }
 
 
@@ -126,6 +184,7 @@ public:
     int verticesPerInstance() const { return fVerticesPerInstance; }
     int indicesPerInstance() const { return fIndicesPerInstance; }
     int instanceCount() const { return fInstanceCount; }
+    int maxInstancesPerDraw() const { return fMaxInstancesPerDraw; }
 
     bool isInstanced() const { return fInstanceCount > 0; }
 
@@ -44,7 +44,6 @@
 
 #if SK_SUPPORT_GPU
 
-enum { kDefaultImageFilterCacheSize = 32 * 1024 * 1024 };
 
 #if 0
     extern bool (*gShouldDrawProc)();
@@ -2058,9 +2057,11 @@ bool SkGpuDevice::EXPERIMENTAL_drawPicture(SkCanvas* mainCanvas, const SkPicture
 }
 
 SkImageFilter::Cache* SkGpuDevice::getImageFilterCache() {
-    // We always return a transient cache, so it is freed after each
-    // filter traversal.
-    return SkImageFilter::Cache::Create(kDefaultImageFilterCacheSize);
+    // We return the process-wide cache, so unchanged filter results are
+    // reused across filter traversals (and frames).
+    SkImageFilter::Cache* cache = SkImageFilter::Cache::Get();
+    cache->ref();
+    return cache;
 }
 
 #endif
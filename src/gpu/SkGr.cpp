@@ -413,6 +413,18 @@ static GrTexture* create_unstretched_bitmap_texture(GrContext* ctx,
     GrSurfaceDesc desc;
     generate_bitmap_texture_desc(*bitmap, &desc);
 
+    // If the pixel ref can hand over its content as a texture directly (e.g.
+    // it wraps a hardware decoder's output buffer), take that zero-copy path.
+    GrTexture* wrapped = bitmap->pixelRef()->generateTexture(ctx);
+    if (wrapped) {
+        if (optionalKey.isValid()) {
+            BitmapInvalidator* listener = SkNEW_ARGS(BitmapInvalidator, (optionalKey));
+            bitmap->pixelRef()->addGenIDChangeListener(listener);
+            ctx->textureProvider()->assignUniqueKeyToTexture(optionalKey, wrapped);
+        }
+        return wrapped;
+    }
+
     if (kIndex_8_SkColorType == bitmap->colorType()) {
         if (ctx->isConfigTexturable(kIndex_8_GrPixelConfig)) {
             size_t imageSize = GrCompressedFormatDataSize(kIndex_8_GrPixelConfig,
@@ -93,6 +93,9 @@ const GrGLInterface* GrGLAssembleGLInterface(void* ctx, GrGLGetProc get) {
 
     GET_PROC(BlendFunc);
     GET_PROC(BufferData);
+    if (glVer >= GR_GL_VER(4,4) || extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
     GET_PROC(BufferSubData);
     GET_PROC(Clear);
     GET_PROC(ClearColor);
@@ -139,6 +142,10 @@ const GrGLInterface* GrGLAssembleGLInterface(void* ctx, GrGLGetProc get) {
         GET_PROC_SUFFIX(GetQueryObjectui64v, EXT);
     }
     GET_PROC(GetQueryiv);
+    if (glVer >= GR_GL_VER(4,1) || extensions.has("GL_ARB_get_program_binary")) {
+        GET_PROC(GetProgramBinary);
+        GET_PROC(ProgramBinary);
+    }
     GET_PROC(GetProgramInfoLog);
     GET_PROC(GetProgramiv);
     GET_PROC(GetShaderInfoLog);
@@ -227,6 +234,33 @@ const GrGLInterface* GrGLAssembleGLInterface(void* ctx, GrGLGetProc get) {
         GET_PROC(FlushMappedBufferRange);
     }
 
+    if (glVer >= GR_GL_VER(3,1) || extensions.has("GL_ARB_uniform_buffer_object")) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
+    if (glVer >= GR_GL_VER(3,3)) {
+        GET_PROC(DrawArraysInstanced);
+        GET_PROC(VertexAttribDivisor);
+    } else if (extensions.has("GL_ARB_draw_instanced") &&
+               extensions.has("GL_ARB_instanced_arrays")) {
+        GET_PROC_SUFFIX(DrawArraysInstanced, ARB);
+        GET_PROC_SUFFIX(VertexAttribDivisor, ARB);
+    }
+
+    // GL_ARB_multi_draw_indirect doesn't use the ARB suffix.
+    if (glVer >= GR_GL_VER(4,3) || extensions.has("GL_ARB_multi_draw_indirect")) {
+        GET_PROC(MultiDrawArraysIndirect);
+        GET_PROC(MultiDrawElementsIndirect);
+    }
+
+    if (glVer >= GR_GL_VER(3,2) || extensions.has("GL_ARB_sync")) {
+        GET_PROC(FenceSync);
+        GET_PROC(ClientWaitSync);
+        GET_PROC(DeleteSync);
+    }
+
     // First look for GL3.0 FBO or GL_ARB_framebuffer_object (same since
     // GL_ARB_framebuffer_object doesn't use ARB suffix.)
     if (glVer >= GR_GL_VER(3,0) || extensions.has("GL_ARB_framebuffer_object")) {
@@ -366,6 +400,9 @@ const GrGLInterface* GrGLAssembleGLESInterface(void* ctx, GrGLGetProc get) {
     GET_PROC(BlendEquation);
     GET_PROC(BlendFunc);
     GET_PROC(BufferData);
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
     GET_PROC(BufferSubData);
     GET_PROC(Clear);
     GET_PROC(ClearColor);
@@ -400,6 +437,25 @@ const GrGLInterface* GrGLAssembleGLESInterface(void* ctx, GrGLGetProc get) {
     GET_PROC(GetBufferParameteriv);
     GET_PROC(GetError);
     GET_PROC(GetIntegerv);
+    if (extensions.has("GL_EXT_disjoint_timer_query")) {
+        GET_PROC_SUFFIX(BeginQuery, EXT);
+        GET_PROC_SUFFIX(DeleteQueries, EXT);
+        GET_PROC_SUFFIX(EndQuery, EXT);
+        GET_PROC_SUFFIX(GenQueries, EXT);
+        GET_PROC_SUFFIX(GetQueryiv, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectiv, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectuiv, EXT);
+        GET_PROC_SUFFIX(GetQueryObjecti64v, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectui64v, EXT);
+        GET_PROC_SUFFIX(QueryCounter, EXT);
+    }
+    if (version >= GR_GL_VER(3,0)) {
+        GET_PROC(GetProgramBinary);
+        GET_PROC(ProgramBinary);
+    } else if (extensions.has("GL_OES_get_program_binary")) {
+        GET_PROC_SUFFIX(GetProgramBinary, OES);
+        GET_PROC_SUFFIX(ProgramBinary, OES);
+    }
     GET_PROC(GetProgramInfoLog);
     GET_PROC(GetProgramiv);
     GET_PROC(GetShaderInfoLog);
@@ -503,6 +559,31 @@ const GrGLInterface* GrGLAssembleGLESInterface(void* ctx, GrGLGetProc get) {
         GET_PROC_SUFFIX(FlushMappedBufferRange, EXT);
     }
 
+    if (version >= GR_GL_VER(3,0)) {
+        GET_PROC(DrawArraysInstanced);
+        GET_PROC(VertexAttribDivisor);
+    } else if (extensions.has("GL_EXT_instanced_arrays")) {
+        GET_PROC_SUFFIX(DrawArraysInstanced, EXT);
+        GET_PROC_SUFFIX(VertexAttribDivisor, EXT);
+    }
+
+    if (extensions.has("GL_EXT_multi_draw_indirect")) {
+        GET_PROC_SUFFIX(MultiDrawArraysIndirect, EXT);
+        GET_PROC_SUFFIX(MultiDrawElementsIndirect, EXT);
+    }
+
+    if (version >= GR_GL_VER(3,0)) {
+        GET_PROC(FenceSync);
+        GET_PROC(ClientWaitSync);
+        GET_PROC(DeleteSync);
+    }
+
+    if (version >= GR_GL_VER(3,0)) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
     if (extensions.has("GL_EXT_debug_marker")) {
         GET_PROC(InsertEventMarker);
         GET_PROC(PushGroupMarker);
@@ -23,7 +23,9 @@
 GrGLBufferImpl::GrGLBufferImpl(GrGLGpu* gpu, const Desc& desc, GrGLenum bufferType)
     : fDesc(desc)
     , fBufferType(bufferType)
-    , fMapPtr(NULL) {
+    , fMapPtr(NULL)
+    , fPersistentPtr(NULL)
+    , fSync(NULL) {
     if (0 == desc.fID) {
         fCPUData = sk_malloc_flags(desc.fSizeInBytes, SK_MALLOC_THROW);
         fGLSizeInBytes = 0;
@@ -31,6 +33,16 @@ GrGLBufferImpl::GrGLBufferImpl(GrGLGpu* gpu, const Desc& desc, GrGLenum bufferTy
         fCPUData = NULL;
         // We assume that the GL buffer was created at the desc's size initially.
         fGLSizeInBytes = fDesc.fSizeInBytes;
+        // Dynamic buffers on BufferStorage-capable contexts were allocated with immutable
+        // storage (see GrGLGpu::onCreateVertexBuffer). Map them once, coherently, for life.
+        if (desc.fDynamic && gpu->glCaps().bufferStorageSupport()) {
+            this->bind(gpu);
+            static const GrGLbitfield kAccess = GR_GL_MAP_WRITE_BIT |
+                                                GR_GL_MAP_PERSISTENT_BIT |
+                                                GR_GL_MAP_COHERENT_BIT;
+            GR_GL_CALL_RET(gpu->glInterface(), fPersistentPtr,
+                           MapBufferRange(fBufferType, 0, fGLSizeInBytes, kAccess));
+        }
     }
     VALIDATE();
 }
@@ -42,7 +54,13 @@ void GrGLBufferImpl::release(GrGLGpu* gpu) {
         sk_free(fCPUData);
         fCPUData = NULL;
     } else if (fDesc.fID) {
-        GL_CALL(gpu, DeleteBuffers(1, &fDesc.fID));
+        if (fSync) {
+            GL_CALL(gpu, DeleteSync(fSync));
+            fSync = NULL;
+        }
+        fPersistentPtr = NULL;  // Deleting the buffer implicitly unmaps it.
+        // The name pool batches the deletion with others at the next flush.
+        gpu->deleteBufferName(fDesc.fID);
         if (GR_GL_ARRAY_BUFFER == fBufferType) {
             gpu->notifyVertexBufferDelete(fDesc.fID);
         } else {
@@ -60,6 +78,8 @@ void GrGLBufferImpl::abandon() {
     fDesc.fID = 0;
     fGLSizeInBytes = 0;
     fMapPtr = NULL;
+    fPersistentPtr = NULL;
+    fSync = NULL;
     sk_free(fCPUData);
     fCPUData = NULL;
     VALIDATE();
@@ -81,6 +101,10 @@ void* GrGLBufferImpl::map(GrGLGpu* gpu) {
     SkASSERT(!this->isMapped());
     if (0 == fDesc.fID) {
         fMapPtr = fCPUData;
+    } else if (fPersistentPtr) {
+        // The mapping never went away; just make sure the GPU is done reading the old contents.
+        this->waitOnSync(gpu);
+        fMapPtr = fPersistentPtr;
     } else {
         switch (gpu->glCaps().mapBufferType()) {
             case GrGLCaps::kNone_MapBufferType:
@@ -136,6 +160,11 @@ void* GrGLBufferImpl::map(GrGLGpu* gpu) {
 void GrGLBufferImpl::unmap(GrGLGpu* gpu) {
     VALIDATE();
     SkASSERT(this->isMapped());
+    if (fPersistentPtr) {
+        // Coherent mapping: writes are visible to the GPU without an unmap or flush.
+        fMapPtr = NULL;
+        return;
+    }
     if (0 != fDesc.fID) {
         switch (gpu->glCaps().mapBufferType()) {
             case GrGLCaps::kNone_MapBufferType:
@@ -155,6 +184,31 @@ void GrGLBufferImpl::unmap(GrGLGpu* gpu) {
     fMapPtr = NULL;
 }
 
+void GrGLBufferImpl::notifyDrawsFlushed(GrGLGpu* gpu) {
+    SkASSERT(!this->isMapped());
+    if (NULL == fPersistentPtr) {
+        return;
+    }
+    if (fSync) {
+        // Replace any unconsumed fence; the new one covers strictly more commands.
+        GL_CALL(gpu, DeleteSync(fSync));
+    }
+    GR_GL_CALL_RET(gpu->glInterface(), fSync,
+                   FenceSync(GR_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+void GrGLBufferImpl::waitOnSync(GrGLGpu* gpu) {
+    if (NULL == fSync) {
+        return;
+    }
+    GrGLenum status;
+    GR_GL_CALL_RET(gpu->glInterface(), status,
+                   ClientWaitSync(fSync, GR_GL_SYNC_FLUSH_COMMANDS_BIT, GR_GL_TIMEOUT_IGNORED));
+    SkASSERT(GR_GL_WAIT_FAILED != status);
+    GL_CALL(gpu, DeleteSync(fSync));
+    fSync = NULL;
+}
+
 bool GrGLBufferImpl::isMapped() const {
     VALIDATE();
     return SkToBool(fMapPtr);
@@ -170,6 +224,13 @@ bool GrGLBufferImpl::updateData(GrGLGpu* gpu, const void* src, size_t srcSizeInB
         memcpy(fCPUData, src, srcSizeInBytes);
         return true;
     }
+    if (fPersistentPtr) {
+        // The storage is immutable so the BufferData paths below are illegal. Write through
+        // the standing mapping once any outstanding reads have drained.
+        this->waitOnSync(gpu);
+        memcpy(fPersistentPtr, src, srcSizeInBytes);
+        return true;
+    }
     this->bind(gpu);
     GrGLenum usage = fDesc.fDynamic ? DYNAMIC_USAGE_PARAM : GR_GL_STATIC_DRAW;
 
@@ -220,6 +281,7 @@ void GrGLBufferImpl::validate() const {
     // The following assert isn't valid when the buffer has been abandoned:
     // SkASSERT((0 == fDesc.fID) == (fCPUData));
     SkASSERT(NULL == fCPUData || 0 == fGLSizeInBytes);
+    SkASSERT(NULL == fPersistentPtr || (0 != fDesc.fID && NULL == fCPUData));
     SkASSERT(NULL == fMapPtr || fCPUData || fGLSizeInBytes == fDesc.fSizeInBytes);
     SkASSERT(NULL == fCPUData || NULL == fMapPtr || fCPUData == fMapPtr);
 }
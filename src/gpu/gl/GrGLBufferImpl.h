@@ -44,13 +44,29 @@ public:
     bool isMapped() const;
     bool updateData(GrGLGpu* gpu, const void* src, size_t srcSizeInBytes);
 
+    /**
+     * True when the buffer was allocated with BufferStorage and stays mapped for its entire
+     * lifetime. map() and unmap() make no GL calls for such buffers.
+     */
+    bool isPersistentlyMapped() const { return SkToBool(fPersistentPtr); }
+
+    /**
+     * Tells a persistently mapped buffer that every draw reading its current contents has been
+     * issued to GL. Inserts a fence; the next map() waits on it before handing out the pointer
+     * so the CPU can't scribble over data the GPU is still consuming. No-op for other buffers.
+     */
+    void notifyDrawsFlushed(GrGLGpu* gpu);
+
 private:
+    void waitOnSync(GrGLGpu* gpu);
     void validate() const;
 
     Desc         fDesc;
     GrGLenum     fBufferType; // GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
     void*        fCPUData;
     void*        fMapPtr;
+    void*        fPersistentPtr;     // lifetime mapping from BufferStorage, or NULL
+    GrGLsync     fSync;              // guards reuse of a persistently mapped buffer
     size_t       fGLSizeInBytes;     // In certain cases we make the size of the GL buffer object
                                      // smaller or larger than the size in fDesc.
 
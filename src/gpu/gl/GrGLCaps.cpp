@@ -48,6 +48,14 @@ void GrGLCaps::reset() {
     fIsCoreProfile = false;
     fFullClearIsFree = false;
     fFBMixedSamplesSupport = false;
+    fProgramBinarySupport = false;
+    fBufferStorageSupport = false;
+    fFenceSyncSupport = false;
+    fUniformBufferSupport = false;
+    fMultiDrawIndirectSupport = false;
+    fPixelBufferSupport = false;
+    fTimerQueriesSupport = false;
+    fUniformBufferOffsetAlignment = 0;
 
     fReadPixelsSupportedCache.reset();
 
@@ -90,6 +98,14 @@ GrGLCaps& GrGLCaps::operator= (const GrGLCaps& caps) {
     fIsCoreProfile = caps.fIsCoreProfile;
     fFullClearIsFree = caps.fFullClearIsFree;
     fFBMixedSamplesSupport = caps.fFBMixedSamplesSupport;
+    fProgramBinarySupport = caps.fProgramBinarySupport;
+    fBufferStorageSupport = caps.fBufferStorageSupport;
+    fFenceSyncSupport = caps.fFenceSyncSupport;
+    fUniformBufferSupport = caps.fUniformBufferSupport;
+    fMultiDrawIndirectSupport = caps.fMultiDrawIndirectSupport;
+    fPixelBufferSupport = caps.fPixelBufferSupport;
+    fTimerQueriesSupport = caps.fTimerQueriesSupport;
+    fUniformBufferOffsetAlignment = caps.fUniformBufferOffsetAlignment;
 
     *(reinterpret_cast<GrGLSLCaps*>(fShaderCaps.get())) = 
                                           *(reinterpret_cast<GrGLSLCaps*>(caps.fShaderCaps.get()));
@@ -249,6 +265,80 @@ bool GrGLCaps::init(const GrGLContextInfo& ctxInfo, const GrGLInterface* gli) {
         fES2CompatibilitySupport = true;
     }
 
+    if (kGL_GrGLStandard == standard) {
+        fProgramBinarySupport = version >= GR_GL_VER(4, 1) ||
+                                ctxInfo.hasExtension("GL_ARB_get_program_binary");
+    } else {
+        fProgramBinarySupport = version >= GR_GL_VER(3, 0) ||
+                                ctxInfo.hasExtension("GL_OES_get_program_binary");
+    }
+    if (fProgramBinarySupport) {
+        // A driver may expose the entry points yet support no binary formats at all.
+        GrGLint formatCount = 0;
+        GR_GL_GetIntegerv(gli, GR_GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        fProgramBinarySupport = formatCount > 0;
+    }
+
+    if (kGL_GrGLStandard == standard) {
+        fFenceSyncSupport = version >= GR_GL_VER(3, 2) || ctxInfo.hasExtension("GL_ARB_sync");
+    } else {
+        fFenceSyncSupport = version >= GR_GL_VER(3, 0);
+    }
+
+    if (kGL_GrGLStandard == standard) {
+        fUniformBufferSupport = version >= GR_GL_VER(3, 1) &&
+                                ctxInfo.glslGeneration() >= k140_GrGLSLGeneration;
+    } else {
+        fUniformBufferSupport = version >= GR_GL_VER(3, 0) &&
+                                ctxInfo.glslGeneration() >= k330_GrGLSLGeneration;
+    }
+    // An interface may claim a UBO-capable version but not actually provide the entry points
+    // (e.g. the null interface used for testing). Fall back to loose uniforms in that case.
+    if (NULL == gli->fFunctions.fBindBufferRange ||
+        NULL == gli->fFunctions.fGetUniformBlockIndex ||
+        NULL == gli->fFunctions.fUniformBlockBinding) {
+        fUniformBufferSupport = false;
+    }
+    if (fUniformBufferSupport) {
+        GR_GL_GetIntegerv(gli, GR_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,
+                          &fUniformBufferOffsetAlignment);
+    }
+
+    if (kGL_GrGLStandard == standard) {
+        fInstancedArraysSupport = version >= GR_GL_VER(3, 3) ||
+                                  (ctxInfo.hasExtension("GL_ARB_draw_instanced") &&
+                                   ctxInfo.hasExtension("GL_ARB_instanced_arrays"));
+    } else {
+        fInstancedArraysSupport = version >= GR_GL_VER(3, 0) ||
+                                  ctxInfo.hasExtension("GL_EXT_instanced_arrays");
+    }
+    // As with uniform buffers, don't trust a version claim that comes without the entry points.
+    if (NULL == gli->fFunctions.fDrawArraysInstanced ||
+        NULL == gli->fFunctions.fVertexAttribDivisor) {
+        fInstancedArraysSupport = false;
+    }
+
+    if (kGL_GrGLStandard == standard) {
+        fMultiDrawIndirectSupport = version >= GR_GL_VER(4, 3) ||
+                                    ctxInfo.hasExtension("GL_ARB_multi_draw_indirect");
+    } else {
+        fMultiDrawIndirectSupport = ctxInfo.hasExtension("GL_EXT_multi_draw_indirect");
+    }
+    if (NULL == gli->fFunctions.fMultiDrawArraysIndirect ||
+        NULL == gli->fFunctions.fMultiDrawElementsIndirect) {
+        fMultiDrawIndirectSupport = false;
+    }
+
+    // Persistent-coherent buffer mapping also needs sync objects so we can fence buffer reuse.
+    if (kGL_GrGLStandard == standard) {
+        fBufferStorageSupport = fFenceSyncSupport &&
+                                (version >= GR_GL_VER(4, 4) ||
+                                 ctxInfo.hasExtension("GL_ARB_buffer_storage"));
+    } else {
+        fBufferStorageSupport = fFenceSyncSupport &&
+                                ctxInfo.hasExtension("GL_EXT_buffer_storage");
+    }
+
     this->initFSAASupport(ctxInfo, gli);
     this->initStencilFormats(ctxInfo);
 
@@ -310,6 +400,36 @@ bool GrGLCaps::init(const GrGLContextInfo& ctxInfo, const GrGLInterface* gli) {
         }
     }
 
+    if (kGL_GrGLStandard == standard) {
+        fPixelBufferSupport = version >= GR_GL_VER(2, 1) ||
+                              ctxInfo.hasExtension("GL_ARB_pixel_buffer_object") ||
+                              ctxInfo.hasExtension("GL_EXT_pixel_buffer_object");
+    } else {
+        fPixelBufferSupport = version >= GR_GL_VER(3, 0) ||
+                              ctxInfo.hasExtension("GL_NV_pixel_buffer_object");
+    }
+    // The streaming upload path fills the pixel buffer through a mapping, so it also needs one of
+    // the full-buffer map entry points.
+    if (kMapBuffer_MapBufferType != fMapBufferType &&
+        kMapBufferRange_MapBufferType != fMapBufferType) {
+        fPixelBufferSupport = false;
+    }
+
+    if (kGL_GrGLStandard == standard) {
+        fTimerQueriesSupport = version >= GR_GL_VER(3, 3) ||
+                               ctxInfo.hasExtension("GL_ARB_timer_query") ||
+                               ctxInfo.hasExtension("GL_EXT_timer_query");
+    } else {
+        fTimerQueriesSupport = ctxInfo.hasExtension("GL_EXT_disjoint_timer_query");
+    }
+    if (NULL == gli->fFunctions.fGenQueries ||
+        NULL == gli->fFunctions.fBeginQuery ||
+        NULL == gli->fFunctions.fEndQuery ||
+        NULL == gli->fFunctions.fGetQueryObjectuiv ||
+        NULL == gli->fFunctions.fGetQueryObjectui64v) {
+        fTimerQueriesSupport = false;
+    }
+
     if (kGL_GrGLStandard == standard) {
         SkASSERT(ctxInfo.version() >= GR_GL_VER(2,0) ||
                  ctxInfo.hasExtension("GL_ARB_texture_non_power_of_two"));
@@ -890,6 +1010,13 @@ SkString GrGLCaps::dump() const {
     GR_STATIC_ASSERT(SK_ARRAY_COUNT(kMapBufferTypeStr) == kLast_MapBufferType + 1);
 
     r.appendf("Core Profile: %s\n", (fIsCoreProfile ? "YES" : "NO"));
+    r.appendf("Program Binary Support: %s\n", (fProgramBinarySupport ? "YES" : "NO"));
+    r.appendf("Buffer Storage Support: %s\n", (fBufferStorageSupport ? "YES" : "NO"));
+    r.appendf("Fence Sync Support: %s\n", (fFenceSyncSupport ? "YES" : "NO"));
+    r.appendf("Uniform Buffer Support: %s\n", (fUniformBufferSupport ? "YES" : "NO"));
+    r.appendf("Multi Draw Indirect Support: %s\n", (fMultiDrawIndirectSupport ? "YES" : "NO"));
+    r.appendf("Pixel Buffer Support: %s\n", (fPixelBufferSupport ? "YES" : "NO"));
+    r.appendf("Timer Queries Support: %s\n", (fTimerQueriesSupport ? "YES" : "NO"));
     r.appendf("MSAA Type: %s\n", kMSFBOExtStr[fMSFBOType]);
     r.appendf("Invalidate FB Type: %s\n", kInvalidateFBTypeStr[fInvalidateFBType]);
     r.appendf("Map Buffer Type: %s\n", kMapBufferTypeStr[fMapBufferType]);
@@ -253,6 +253,30 @@ public:
 
     bool fullClearIsFree() const { return fFullClearIsFree; }
 
+    /// Can program binaries be retrieved with GetProgramBinary and reloaded with ProgramBinary?
+    bool programBinarySupport() const { return fProgramBinarySupport; }
+
+    /// Can buffers be allocated with BufferStorage and kept persistently-coherently mapped?
+    bool bufferStorageSupport() const { return fBufferStorageSupport; }
+
+    /// Can sync objects be inserted with FenceSync and waited on with ClientWaitSync?
+    bool fenceSyncSupport() const { return fFenceSyncSupport; }
+
+    /// Can program uniforms be packed into a std140 uniform block and sourced from a buffer?
+    bool uniformBufferSupport() const { return fUniformBufferSupport; }
+
+    /// Required alignment of offsets passed to BindBufferRange for uniform buffers.
+    int uniformBufferOffsetAlignment() const { return fUniformBufferOffsetAlignment; }
+
+    /// Can several indirect draw records be submitted with one MultiDraw*Indirect call?
+    bool multiDrawIndirectSupport() const { return fMultiDrawIndirectSupport; }
+
+    /// Can texture uploads source their pixels from a mapped GL_PIXEL_UNPACK_BUFFER?
+    bool pixelBufferSupport() const { return fPixelBufferSupport; }
+
+    /// Can elapsed GPU time be measured with TIME_ELAPSED queries?
+    bool timerQueriesSupport() const { return fTimerQueriesSupport; }
+
     /**
      * Returns a string containing the caps info.
      */
@@ -332,6 +356,7 @@ private:
     int fMaxFragmentUniformVectors;
     int fMaxVertexAttributes;
     int fMaxFragmentTextureUnits;
+    int fUniformBufferOffsetAlignment;
 
     MSFBOType           fMSFBOType;
     InvalidateFBType    fInvalidateFBType;
@@ -357,6 +382,13 @@ private:
     bool fIsCoreProfile : 1;
     bool fFullClearIsFree : 1;
     bool fFBMixedSamplesSupport : 1;
+    bool fProgramBinarySupport : 1;
+    bool fBufferStorageSupport : 1;
+    bool fFenceSyncSupport : 1;
+    bool fUniformBufferSupport : 1;
+    bool fMultiDrawIndirectSupport : 1;
+    bool fPixelBufferSupport : 1;
+    bool fTimerQueriesSupport : 1;
 
     struct ReadPixelsSupportedFormat {
         GrGLenum fFormat;
@@ -111,7 +111,21 @@
 #define GR_GL_ARRAY_BUFFER_BINDING           0x8894
 #define GR_GL_ELEMENT_ARRAY_BUFFER_BINDING   0x8895
 
+/* Uniform Buffer Objects */
+#define GR_GL_UNIFORM_BUFFER                 0x8A11
+#define GR_GL_UNIFORM_BUFFER_BINDING         0x8A28
+#define GR_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GR_GL_INVALID_INDEX                  0xFFFFFFFFu
+
+/* Indirect Draws */
+#define GR_GL_DRAW_INDIRECT_BUFFER           0x8F3F
+
+/* Pixel Buffer Objects */
+#define GR_GL_PIXEL_UNPACK_BUFFER            0x88EC
+#define GR_GL_PIXEL_PACK_BUFFER              0x88EB
+
 #define GR_GL_STREAM_DRAW                    0x88E0
+#define GR_GL_STREAM_READ                    0x88E1
 #define GR_GL_STATIC_DRAW                    0x88E4
 #define GR_GL_DYNAMIC_DRAW                   0x88E8
 
@@ -437,6 +451,12 @@
 #define GR_GL_MAX_FRAGMENT_UNIFORM_COMPONENTS  0x8B49
 #define GR_GL_MAX_VERTEX_UNIFORM_COMPONENTS    0x8B4A
 
+/* Program Binary */
+#define GR_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  0x8257
+#define GR_GL_PROGRAM_BINARY_LENGTH            0x8741
+#define GR_GL_NUM_PROGRAM_BINARY_FORMATS       0x87FE
+#define GR_GL_PROGRAM_BINARY_FORMATS           0x87FF
+
 /* StencilFunction */
 #define GR_GL_NEVER                          0x0200
 #define GR_GL_LESS                           0x0201
@@ -701,6 +721,7 @@
 #define GR_GL_T4F_C4F_N3F_V4F                    0x2A2D
 
 /* Vertex Buffer Object */
+#define GR_GL_READ_ONLY                          0x88B8
 #define GR_GL_WRITE_ONLY                         0x88B9
 #define GR_GL_BUFFER_MAPPED                      0x88BC
 
@@ -710,6 +731,18 @@
 #define GR_GL_MAP_INVALIDATE_BUFFER_BIT          0x0008
 #define GR_GL_MAP_FLUSH_EXPLICIT_BIT             0x0010
 #define GR_GL_MAP_UNSYNCHRONIZED_BIT             0x0020
+#define GR_GL_MAP_PERSISTENT_BIT                 0x0040
+#define GR_GL_MAP_COHERENT_BIT                   0x0080
+#define GR_GL_DYNAMIC_STORAGE_BIT                0x0100
+
+/* Sync Objects */
+#define GR_GL_SYNC_GPU_COMMANDS_COMPLETE         0x9117
+#define GR_GL_ALREADY_SIGNALED                   0x911A
+#define GR_GL_TIMEOUT_EXPIRED                    0x911B
+#define GR_GL_CONDITION_SATISFIED                0x911C
+#define GR_GL_WAIT_FAILED                        0x911D
+#define GR_GL_SYNC_FLUSH_COMMANDS_BIT            0x00000001
+#define GR_GL_TIMEOUT_IGNORED                    0xFFFFFFFFFFFFFFFFull
 
 /* Read Format */
 #define GR_GL_IMPLEMENTATION_COLOR_READ_TYPE   0x8B9A
@@ -742,6 +775,7 @@
 #define GR_GL_ANY_SAMPLES_PASSED             0x8C2F
 #define GR_GL_TIME_ELAPSED                   0x88BF
 #define GR_GL_TIMESTAMP                      0x8E28
+#define GR_GL_GPU_DISJOINT                   0x8FBB
 #define GR_GL_PRIMITIVES_GENERATED           0x8C87
 #define GR_GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN 0x8C88
 
@@ -7,6 +7,8 @@
 
 
 #include "GrGLGpu.h"
+#include "GrGLNamePool.h"
+#include "GrGLProgramBinaryCache.h"
 #include "GrGLStencilAttachment.h"
 #include "GrGLTextureRenderTarget.h"
 #include "GrGpuResourcePriv.h"
@@ -189,6 +191,13 @@ GrGLGpu::GrGLGpu(const GrGLContext& ctx, GrContext* context)
 
     fProgramCache = SkNEW_ARGS(ProgramCache, (this));
 
+    fProgramBinaryCache = NULL;
+    if (this->glCaps().programBinarySupport()) {
+        fProgramBinaryCache = SkNEW_ARGS(GrGLProgramBinaryCache, (this));
+        // Parse the cache file off-thread while the rest of context setup proceeds.
+        fProgramBinaryCache->beginLoad();
+    }
+
     SkASSERT(this->glCaps().maxVertexAttributes() >= GrGeometryProcessor::kMaxVertexAttribs);
 
     fLastSuccessfulStencilFmtIdx = 0;
@@ -196,6 +205,18 @@ GrGLGpu::GrGLGpu(const GrGLContext& ctx, GrContext* context)
     fTempSrcFBOID = 0;
     fTempDstFBOID = 0;
     fStencilClearFBOID = 0;
+    fUniformRingBufferID = 0;
+    fUniformRingBufferSize = 0;
+    fUniformRingBufferOffset = 0;
+    fDrawIndirectBufferID = 0;
+    memset(fUploadPBOIDs, 0, sizeof(fUploadPBOIDs));
+    fUploadPBOIndex = 0;
+
+    fTextureNamePool.reset(new GrGLNamePool(this, GrGLNamePool::kTexture_PoolType));
+    fBufferNamePool.reset(new GrGLNamePool(this, GrGLNamePool::kBuffer_PoolType));
+
+    fBatchTimingEnabled = false;
+    fTimerQueryActive = false;
 
     if (this->glCaps().shaderCaps()->pathRenderingSupport()) {
         fPathRendering.reset(new GrGLPathRendering(this));
@@ -219,8 +240,29 @@ GrGLGpu::~GrGLGpu() {
     if (0 != fStencilClearFBOID) {
         GL_CALL(DeleteFramebuffers(1, &fStencilClearFBOID));
     }
+    if (0 != fUniformRingBufferID) {
+        GL_CALL(DeleteBuffers(1, &fUniformRingBufferID));
+    }
+    if (0 != fDrawIndirectBufferID) {
+        GL_CALL(DeleteBuffers(1, &fDrawIndirectBufferID));
+    }
+    if (0 != fUploadPBOIDs[0]) {
+        GL_CALL(DeleteBuffers(kNumUploadPBOs, fUploadPBOIDs));
+    }
+
+    while (fAsyncPixelReads.count()) {
+        this->deleteAsyncRead(fAsyncPixelReads[fAsyncPixelReads.count() - 1]);
+    }
+
+    for (int i = 0; i < fPendingTimerQueries.count(); ++i) {
+        GL_CALL(DeleteQueries(1, &fPendingTimerQueries[i].fQueryID));
+    }
+
+    fTextureNamePool->deleteAllNames();
+    fBufferNamePool->deleteAllNames();
 
     delete fProgramCache;
+    delete fProgramBinaryCache;
 }
 
 void GrGLGpu::contextAbandoned() {
@@ -230,11 +272,134 @@ void GrGLGpu::contextAbandoned() {
     fTempSrcFBOID = 0;
     fTempDstFBOID = 0;
     fStencilClearFBOID = 0;
+    fDrawIndirectBufferID = 0;
+    memset(fUploadPBOIDs, 0, sizeof(fUploadPBOIDs));
+    for (int i = 0; i < fAsyncPixelReads.count(); ++i) {
+        SkDELETE(fAsyncPixelReads[i]);
+    }
+    fAsyncPixelReads.reset();
+    fTextureNamePool->abandon();
+    fBufferNamePool->abandon();
+    fPendingTimerQueries.reset();
+    fTimerQueryActive = false;
     if (this->glCaps().shaderCaps()->pathRenderingSupport()) {
         this->glPathRendering()->abandonGpuResources();
     }
 }
 
+void GrGLGpu::didFlush() {
+    this->pollBatchTimerQueries();
+    fTextureNamePool->flushPendingDeletes();
+    fBufferNamePool->flushPendingDeletes();
+}
+
+void GrGLGpu::setBatchTimingEnabled(bool enabled) {
+    if (enabled && !this->glCaps().timerQueriesSupport()) {
+        return;
+    }
+    fBatchTimingEnabled = enabled;
+}
+
+void GrGLGpu::beginBatchTiming(const char* name) {
+    if (!fBatchTimingEnabled || fTimerQueryActive) {
+        return;
+    }
+
+    GrGLuint queryID = 0;
+    GL_CALL(GenQueries(1, &queryID));
+    if (0 == queryID) {
+        return;
+    }
+
+    int timingIndex = -1;
+    for (int i = 0; i < fBatchTimings.count(); ++i) {
+        if (fBatchTimings[i].fName.equals(name)) {
+            timingIndex = i;
+            break;
+        }
+    }
+    if (timingIndex < 0) {
+        BatchTiming& timing = fBatchTimings.push_back();
+        timing.fName = name;
+        timing.fGpuNanos = 0;
+        timing.fCount = 0;
+        timingIndex = fBatchTimings.count() - 1;
+    }
+
+    GL_CALL(BeginQuery(GR_GL_TIME_ELAPSED, queryID));
+    fTimerQueryActive = true;
+
+    BatchTimerQuery& query = fPendingTimerQueries.push_back();
+    query.fQueryID = queryID;
+    query.fTimingIndex = timingIndex;
+}
+
+void GrGLGpu::endBatchTiming() {
+    if (!fTimerQueryActive) {
+        return;
+    }
+    GL_CALL(EndQuery(GR_GL_TIME_ELAPSED));
+    fTimerQueryActive = false;
+}
+
+void GrGLGpu::getBatchTimings(SkTArray<BatchTiming>* timings) {
+    this->pollBatchTimerQueries();
+    for (int i = 0; i < fBatchTimings.count(); ++i) {
+        timings->push_back(fBatchTimings[i]);
+    }
+}
+
+void GrGLGpu::resetBatchTimings() {
+    // Pending queries index into fBatchTimings, so drop them along with the aggregates.
+    for (int i = 0; i < fPendingTimerQueries.count(); ++i) {
+        GL_CALL(DeleteQueries(1, &fPendingTimerQueries[i].fQueryID));
+    }
+    fPendingTimerQueries.reset();
+    fBatchTimings.reset();
+}
+
+void GrGLGpu::pollBatchTimerQueries() {
+    if (0 == fPendingTimerQueries.count()) {
+        return;
+    }
+
+    // On ES the driver reports whether the GPU clock was disturbed (e.g. by a frequency change)
+    // since it was last asked; results spanning a disjoint interval are meaningless.
+    bool disjoint = false;
+    if (kGLES_GrGLStandard == this->glStandard()) {
+        GrGLint value = 0;
+        GL_CALL(GetIntegerv(GR_GL_GPU_DISJOINT, &value));
+        disjoint = SkToBool(value);
+    }
+
+    int kept = 0;
+    for (int i = 0; i < fPendingTimerQueries.count(); ++i) {
+        const BatchTimerQuery& query = fPendingTimerQueries[i];
+        GrGLuint available = 0;
+        GL_CALL(GetQueryObjectuiv(query.fQueryID, GR_GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available) {
+            fPendingTimerQueries[kept++] = query;
+            continue;
+        }
+        if (!disjoint) {
+            GrGLuint64 nanos = 0;
+            GL_CALL(GetQueryObjectui64v(query.fQueryID, GR_GL_QUERY_RESULT, &nanos));
+            fBatchTimings[query.fTimingIndex].fGpuNanos += nanos;
+            ++fBatchTimings[query.fTimingIndex].fCount;
+        }
+        GL_CALL(DeleteQueries(1, &query.fQueryID));
+    }
+    fPendingTimerQueries.pop_back_n(fPendingTimerQueries.count() - kept);
+}
+
+void GrGLGpu::deleteTextureName(GrGLuint name) {
+    fTextureNamePool->release(name);
+}
+
+void GrGLGpu::deleteBufferName(GrGLuint name) {
+    fBufferNamePool->release(name);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 GrPixelConfig GrGLGpu::preferredReadPixelsConfig(GrPixelConfig readConfig,
                                                  GrPixelConfig surfaceConfig) const {
@@ -510,7 +675,7 @@ GrRenderTarget* GrGLGpu::onWrapBackendRenderTarget(const GrBackendRenderTargetDe
 bool GrGLGpu::onWriteTexturePixels(GrTexture* texture,
                                    int left, int top, int width, int height,
                                    GrPixelConfig config, const void* buffer,
-                                   size_t rowBytes) {
+                                   size_t rowBytes, bool streamingSrc) {
     if (NULL == buffer) {
         return false;
     }
@@ -527,7 +692,7 @@ bool GrGLGpu::onWriteTexturePixels(GrTexture* texture,
                                                 height);
     } else {
         success = this->uploadTexData(glTex->desc(), false, left, top, width, height, config,
-                                      buffer, rowBytes);
+                                      buffer, rowBytes, streamingSrc);
     }
 
     if (success) {
@@ -578,7 +743,8 @@ bool GrGLGpu::uploadTexData(const GrSurfaceDesc& desc,
                             int left, int top, int width, int height,
                             GrPixelConfig dataConfig,
                             const void* data,
-                            size_t rowBytes) {
+                            size_t rowBytes,
+                            bool streamingSrc) {
     SkASSERT(data || isNewTexture);
 
     // If we're uploading compressed data then we should be using uploadCompressedTexData
@@ -629,6 +795,16 @@ bool GrGLGpu::uploadTexData(const GrSurfaceDesc& desc,
         return false;
     }
 
+    // Stage streaming sources through a pixel unpack buffer so the texture update can overlap
+    // rendering rather than reading the client memory synchronously.
+    if (streamingSrc && data && !isNewTexture && this->glCaps().pixelBufferSupport()) {
+        if (this->uploadTexDataViaPBO(desc, left, top, width, height, dataConfig, data, rowBytes,
+                                      externalFormat, externalType)) {
+            return true;
+        }
+        // Fall through to the ordinary client-memory upload.
+    }
+
     /*
      *  check whether to allocate a temporary buffer for flipping y or
      *  because our srcData has extra bytes past each row. If so, we need
@@ -739,6 +915,94 @@ bool GrGLGpu::uploadTexData(const GrSurfaceDesc& desc,
     return succeeded;
 }
 
+bool GrGLGpu::uploadTexDataViaPBO(const GrSurfaceDesc& desc,
+                                  int left, int top, int width, int height,
+                                  GrPixelConfig dataConfig,
+                                  const void* data,
+                                  size_t rowBytes,
+                                  GrGLenum externalFormat,
+                                  GrGLenum externalType) {
+    SkASSERT(this->glCaps().pixelBufferSupport());
+    SkASSERT(data);
+
+    size_t bpp = GrBytesPerPixel(dataConfig);
+    size_t trimRowBytes = width * bpp;
+    size_t size = height * trimRowBytes;
+    bool flipY = kBottomLeft_GrSurfaceOrigin == desc.fOrigin;
+
+    if (0 == fUploadPBOIDs[0]) {
+        GL_CALL(GenBuffers(kNumUploadPBOs, fUploadPBOIDs));
+        if (0 == fUploadPBOIDs[0]) {
+            return false;
+        }
+    }
+
+    GrGLuint pbo = fUploadPBOIDs[fUploadPBOIndex];
+    fUploadPBOIndex = (fUploadPBOIndex + 1) % kNumUploadPBOs;
+
+    GL_CALL(BindBuffer(GR_GL_PIXEL_UNPACK_BUFFER, pbo));
+    // Orphan any contents still in flight from this buffer's last trip around the ring so the map
+    // below never waits on the GPU.
+    GL_CALL(BufferData(GR_GL_PIXEL_UNPACK_BUFFER, size, NULL, GR_GL_STREAM_DRAW));
+
+    void* mapPtr = NULL;
+    if (GrGLCaps::kMapBufferRange_MapBufferType == this->glCaps().mapBufferType()) {
+        GL_CALL_RET(mapPtr, MapBufferRange(GR_GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                           GR_GL_MAP_WRITE_BIT |
+                                           GR_GL_MAP_INVALIDATE_BUFFER_BIT));
+    } else {
+        SkASSERT(GrGLCaps::kMapBuffer_MapBufferType == this->glCaps().mapBufferType());
+        GL_CALL_RET(mapPtr, MapBuffer(GR_GL_PIXEL_UNPACK_BUFFER, GR_GL_WRITE_ONLY));
+    }
+    if (NULL == mapPtr) {
+        GL_CALL(BindBuffer(GR_GL_PIXEL_UNPACK_BUFFER, 0));
+        return false;
+    }
+
+    // Copy into the buffer tightly packed, inverting the rows here if the texture is bottom-left
+    // so no unpack state beyond the alignment is needed for the texture update.
+    const char* src = reinterpret_cast<const char*>(data);
+    char* dst = reinterpret_cast<char*>(mapPtr);
+    if (!flipY && rowBytes == trimRowBytes) {
+        memcpy(dst, src, size);
+    } else {
+        if (flipY) {
+            src += (height - 1) * rowBytes;
+        }
+        for (int y = 0; y < height; y++) {
+            memcpy(dst, src, trimRowBytes);
+            if (flipY) {
+                src -= rowBytes;
+            } else {
+                src += rowBytes;
+            }
+            dst += trimRowBytes;
+        }
+    }
+
+    GrGLboolean unmapped;
+    GL_CALL_RET(unmapped, UnmapBuffer(GR_GL_PIXEL_UNPACK_BUFFER));
+    if (!unmapped) {
+        // The buffer contents were corrupted while mapped (e.g. by a screen mode change).
+        GL_CALL(BindBuffer(GR_GL_PIXEL_UNPACK_BUFFER, 0));
+        return false;
+    }
+
+    if (flipY) {
+        top = desc.fHeight - (top + height);
+    }
+    GL_CALL(PixelStorei(GR_GL_UNPACK_ALIGNMENT,
+                        static_cast<GrGLint>(GrUnpackAlignment(dataConfig))));
+    GL_CALL(TexSubImage2D(GR_GL_TEXTURE_2D,
+                          0, // level
+                          left, top,
+                          width, height,
+                          externalFormat, externalType,
+                          NULL)); // sourced from offset 0 of the bound pixel unpack buffer
+    GL_CALL(BindBuffer(GR_GL_PIXEL_UNPACK_BUFFER, 0));
+    return true;
+}
+
 // TODO: This function is using a lot of wonky semantics like, if width == -1
 // then set width = desc.fWdith ... blah. A better way to do it might be to
 // create a CompressedTexData struct that takes a desc/ptr and figures out
@@ -982,7 +1246,7 @@ GrTexture* GrGLGpu::onCreateTexture(const GrSurfaceDesc& desc,
     bool renderTarget = SkToBool(desc.fFlags & kRenderTarget_GrSurfaceFlag);
 
     GrGLTexture::IDDesc idDesc;
-    GL_CALL(GenTextures(1, &idDesc.fTextureID));
+    idDesc.fTextureID = fTextureNamePool->get();
     idDesc.fLifeCycle = lifeCycle;
 
     if (!idDesc.fTextureID) {
@@ -1024,7 +1288,7 @@ GrTexture* GrGLGpu::onCreateTexture(const GrSurfaceDesc& desc,
     if (!this->uploadTexData(desc, true, 0, 0,
                              desc.fWidth, desc.fHeight,
                              desc.fConfig, srcData, rowBytes)) {
-        GL_CALL(DeleteTextures(1, &idDesc.fTextureID));
+        fTextureNamePool->release(idDesc.fTextureID);
         return return_null_texture();
     }
 
@@ -1035,7 +1299,7 @@ GrTexture* GrGLGpu::onCreateTexture(const GrSurfaceDesc& desc,
         GrGLRenderTarget::IDDesc rtIDDesc;
 
         if (!this->createRenderTargetObjects(desc, lifeCycle, idDesc.fTextureID, &rtIDDesc)) {
-            GL_CALL(DeleteTextures(1, &idDesc.fTextureID));
+            fTextureNamePool->release(idDesc.fTextureID);
             return return_null_texture();
         }
         tex = SkNEW_ARGS(GrGLTextureRenderTarget, (this, desc, idDesc, rtIDDesc));
@@ -1059,7 +1323,7 @@ GrTexture* GrGLGpu::onCreateCompressedTexture(const GrSurfaceDesc& desc,
     }
 
     GrGLTexture::IDDesc idDesc;
-    GL_CALL(GenTextures(1, &idDesc.fTextureID));
+    idDesc.fTextureID = fTextureNamePool->get();
     idDesc.fLifeCycle = lifeCycle;
 
     if (!idDesc.fTextureID) {
@@ -1093,7 +1357,7 @@ GrTexture* GrGLGpu::onCreateCompressedTexture(const GrSurfaceDesc& desc,
                           initialTexParams.fWrapT));
 
     if (!this->uploadCompressedTexData(desc, srcData)) {
-        GL_CALL(DeleteTextures(1, &idDesc.fTextureID));
+        fTextureNamePool->release(idDesc.fTextureID);
         return return_null_texture();
     }
 
@@ -1324,18 +1588,30 @@ GrVertexBuffer* GrGLGpu::onCreateVertexBuffer(size_t size, bool dynamic) {
         GrGLVertexBuffer* vertexBuffer = SkNEW_ARGS(GrGLVertexBuffer, (this, desc));
         return vertexBuffer;
     } else {
-        GL_CALL(GenBuffers(1, &desc.fID));
+        desc.fID = fBufferNamePool->get();
         if (desc.fID) {
             fHWGeometryState.setVertexBufferID(this, desc.fID);
             CLEAR_ERROR_BEFORE_ALLOC(this->glInterface());
             // make sure driver can allocate memory for this buffer
-            GL_ALLOC_CALL(this->glInterface(),
-                          BufferData(GR_GL_ARRAY_BUFFER,
-                                     (GrGLsizeiptr) desc.fSizeInBytes,
-                                     NULL,   // data ptr
-                                     desc.fDynamic ? GR_GL_DYNAMIC_DRAW : GR_GL_STATIC_DRAW));
+            if (desc.fDynamic && this->glCaps().bufferStorageSupport()) {
+                // Immutable storage that GrGLBufferImpl will keep persistently-coherently
+                // mapped, so streaming writes skip map/unmap entirely.
+                GL_ALLOC_CALL(this->glInterface(),
+                              BufferStorage(GR_GL_ARRAY_BUFFER,
+                                            (GrGLsizeiptr) desc.fSizeInBytes,
+                                            NULL,   // data ptr
+                                            GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT |
+                                            GR_GL_MAP_COHERENT_BIT));
+            } else {
+                GL_ALLOC_CALL(this->glInterface(),
+                              BufferData(GR_GL_ARRAY_BUFFER,
+                                         (GrGLsizeiptr) desc.fSizeInBytes,
+                                         NULL,   // data ptr
+                                         desc.fDynamic ? GR_GL_DYNAMIC_DRAW
+                                                       : GR_GL_STATIC_DRAW));
+            }
             if (CHECK_ALLOC_ERROR(this->glInterface()) != GR_GL_NO_ERROR) {
-                GL_CALL(DeleteBuffers(1, &desc.fID));
+                fBufferNamePool->release(desc.fID);
                 this->notifyVertexBufferDelete(desc.fID);
                 return NULL;
             }
@@ -1356,18 +1632,28 @@ GrIndexBuffer* GrGLGpu::onCreateIndexBuffer(size_t size, bool dynamic) {
         GrIndexBuffer* indexBuffer = SkNEW_ARGS(GrGLIndexBuffer, (this, desc));
         return indexBuffer;
     } else {
-        GL_CALL(GenBuffers(1, &desc.fID));
+        desc.fID = fBufferNamePool->get();
         if (desc.fID) {
             fHWGeometryState.setIndexBufferIDOnDefaultVertexArray(this, desc.fID);
             CLEAR_ERROR_BEFORE_ALLOC(this->glInterface());
             // make sure driver can allocate memory for this buffer
-            GL_ALLOC_CALL(this->glInterface(),
-                          BufferData(GR_GL_ELEMENT_ARRAY_BUFFER,
-                                     (GrGLsizeiptr) desc.fSizeInBytes,
-                                     NULL,  // data ptr
-                                     desc.fDynamic ? GR_GL_DYNAMIC_DRAW : GR_GL_STATIC_DRAW));
+            if (desc.fDynamic && this->glCaps().bufferStorageSupport()) {
+                GL_ALLOC_CALL(this->glInterface(),
+                              BufferStorage(GR_GL_ELEMENT_ARRAY_BUFFER,
+                                            (GrGLsizeiptr) desc.fSizeInBytes,
+                                            NULL,  // data ptr
+                                            GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT |
+                                            GR_GL_MAP_COHERENT_BIT));
+            } else {
+                GL_ALLOC_CALL(this->glInterface(),
+                              BufferData(GR_GL_ELEMENT_ARRAY_BUFFER,
+                                         (GrGLsizeiptr) desc.fSizeInBytes,
+                                         NULL,  // data ptr
+                                         desc.fDynamic ? GR_GL_DYNAMIC_DRAW
+                                                       : GR_GL_STATIC_DRAW));
+            }
             if (CHECK_ALLOC_ERROR(this->glInterface()) != GR_GL_NO_ERROR) {
-                GL_CALL(DeleteBuffers(1, &desc.fID));
+                fBufferNamePool->release(desc.fID);
                 this->notifyIndexBufferDelete(desc.fID);
                 return NULL;
             }
@@ -1472,31 +1758,65 @@ void GrGLGpu::setupGeometry(const GrPrimitiveProcessor& primProc,
     GrGLAttribArrayState* attribState =
         fHWGeometryState.bindArrayAndBuffersToDraw(this, vbuf, ibuf);
 
+    GrGLVertexBuffer* instanceBuffer = NULL;
+    if (vertices.isInstancedArrays()) {
+        SkASSERT(this->glCaps().instancedArraysSupport());
+        SkASSERT(primProc.hasInstanceAttribs());
+        instanceBuffer = (GrGLVertexBuffer*) vertices.instanceAttribBuffer();
+        SkASSERT(instanceBuffer);
+        SkASSERT(!instanceBuffer->isMapped());
+    }
+
     int vaCount = primProc.numAttribs();
     if (vaCount > 0) {
 
         GrGLsizei stride = static_cast<GrGLsizei>(primProc.getVertexStride());
+        GrGLsizei instanceStride = static_cast<GrGLsizei>(primProc.getInstanceStride());
 
         size_t vertexOffsetInBytes = stride * vertices.startVertex();
 
         vertexOffsetInBytes += vbuf->baseOffset();
 
+        // Like startVertex, startInstance is baked into the attrib pointers since neither GL ES
+        // nor EXT_instanced_arrays has a base-instance draw parameter.
+        size_t instanceOffsetInBytes = 0;
+        if (instanceBuffer) {
+            instanceOffsetInBytes = instanceStride * vertices.startInstance() +
+                                    instanceBuffer->baseOffset();
+        }
+
         uint32_t usedAttribArraysMask = 0;
         size_t offset = 0;
+        size_t instanceOffset = 0;
 
         for (int attribIndex = 0; attribIndex < vaCount; attribIndex++) {
             const GrGeometryProcessor::Attribute& attrib = primProc.getAttrib(attribIndex);
             usedAttribArraysMask |= (1 << attribIndex);
             GrVertexAttribType attribType = attrib.fType;
-            attribState->set(this,
-                             attribIndex,
-                             vbuf,
-                             GrGLAttribTypeToLayout(attribType).fCount,
-                             GrGLAttribTypeToLayout(attribType).fType,
-                             GrGLAttribTypeToLayout(attribType).fNormalized,
-                             stride,
-                             reinterpret_cast<GrGLvoid*>(vertexOffsetInBytes + offset));
-            offset += attrib.fOffset;
+            if (attrib.fPerInstance) {
+                SkASSERT(instanceBuffer);
+                attribState->set(this,
+                                 attribIndex,
+                                 instanceBuffer,
+                                 GrGLAttribTypeToLayout(attribType).fCount,
+                                 GrGLAttribTypeToLayout(attribType).fType,
+                                 GrGLAttribTypeToLayout(attribType).fNormalized,
+                                 instanceStride,
+                                 reinterpret_cast<GrGLvoid*>(instanceOffsetInBytes +
+                                                             instanceOffset),
+                                 1);
+                instanceOffset += attrib.fOffset;
+            } else {
+                attribState->set(this,
+                                 attribIndex,
+                                 vbuf,
+                                 GrGLAttribTypeToLayout(attribType).fCount,
+                                 GrGLAttribTypeToLayout(attribType).fType,
+                                 GrGLAttribTypeToLayout(attribType).fNormalized,
+                                 stride,
+                                 reinterpret_cast<GrGLvoid*>(vertexOffsetInBytes + offset));
+                offset += attrib.fOffset;
+            }
         }
         attribState->disableUnusedArrays(this, usedAttribArraysMask);
     }
@@ -1903,7 +2223,12 @@ void GrGLGpu::onDraw(const DrawArgs& args, const GrNonInstancedVertices& vertice
 
     SkASSERT((size_t)vertices.primitiveType() < SK_ARRAY_COUNT(gPrimitiveType2GLMode));
 
-    if (vertices.isIndexed()) {
+    if (vertices.isInstancedArrays()) {
+        // Both startVertex and startInstance were accounted for by setupGeometry.
+        GL_CALL(DrawArraysInstanced(gPrimitiveType2GLMode[vertices.primitiveType()], 0,
+                                    vertices.vertexCount(),
+                                    vertices.instanceAttribCount()));
+    } else if (vertices.isIndexed()) {
         GrGLvoid* indices =
             reinterpret_cast<GrGLvoid*>(indexOffsetInBytes + sizeof(uint16_t) *
                                         vertices.startIndex());
@@ -1933,6 +2258,74 @@ void GrGLGpu::onDraw(const DrawArgs& args, const GrNonInstancedVertices& vertice
 #endif
 }
 
+bool GrGLGpu::onMultiDraw(const DrawArgs& args, const GrVertices& vertices) {
+    if (!this->glCaps().multiDrawIndirectSupport()) {
+        return false;
+    }
+    // Only the indexed instance-pattern case is worth accelerating; it is what the iterator in
+    // GrGpu::draw would otherwise chop into a DrawElements call per max-sized chunk.
+    if (!vertices.isIndexed()) {
+        return false;
+    }
+
+    if (0 == fDrawIndirectBufferID) {
+        GL_CALL(GenBuffers(1, &fDrawIndirectBufferID));
+        if (0 == fDrawIndirectBufferID) {
+            return false;
+        }
+    }
+
+    if (!this->flushGLState(args)) {
+        // Nothing sensible can be drawn. Report the draw as handled so the caller doesn't
+        // re-attempt it one chunk at a time.
+        return true;
+    }
+
+    size_t indexOffsetInBytes = 0;
+    this->setupGeometry(*args.fPrimitiveProcessor, vertices, &indexOffsetInBytes);
+
+    SkASSERT((size_t)vertices.primitiveType() < SK_ARRAY_COUNT(gPrimitiveType2GLMode));
+
+    struct DrawElementsIndirectCommand {
+        GrGLuint fCount;
+        GrGLuint fInstanceCount;
+        GrGLuint fFirstIndex;
+        GrGLint  fBaseVertex;
+        GrGLuint fBaseInstance;
+    };
+    GR_STATIC_ASSERT(20 == sizeof(DrawElementsIndirectCommand));
+
+    // setupGeometry accounted for startVertex in the attrib pointers; each record walks forward
+    // from there via its base vertex. All records share the index pattern at the front of the
+    // index buffer.
+    SkASSERT(0 == indexOffsetInBytes % sizeof(uint16_t));
+    GrGLuint firstIndex = SkToU32(indexOffsetInBytes / sizeof(uint16_t) + vertices.startIndex());
+    SkSTArray<8, DrawElementsIndirectCommand, true> commands;
+    int instancesRemaining = vertices.instanceCount();
+    int baseVertex = 0;
+    while (instancesRemaining > 0) {
+        int instances = SkTMin(instancesRemaining, vertices.maxInstancesPerDraw());
+        DrawElementsIndirectCommand& cmd = commands.push_back();
+        cmd.fCount = instances * vertices.indicesPerInstance();
+        cmd.fInstanceCount = 1;
+        cmd.fFirstIndex = firstIndex;
+        cmd.fBaseVertex = baseVertex;
+        cmd.fBaseInstance = 0;
+        baseVertex += instances * vertices.verticesPerInstance();
+        instancesRemaining -= instances;
+    }
+
+    // The indirect buffer binding isn't tracked by fHWGeometryState, so just bind every time.
+    GL_CALL(BindBuffer(GR_GL_DRAW_INDIRECT_BUFFER, fDrawIndirectBufferID));
+    GL_CALL(BufferData(GR_GL_DRAW_INDIRECT_BUFFER,
+                       commands.count() * sizeof(DrawElementsIndirectCommand),
+                       commands.begin(),
+                       GR_GL_STREAM_DRAW));
+    GL_CALL(MultiDrawElementsIndirect(gPrimitiveType2GLMode[vertices.primitiveType()],
+                                      GR_GL_UNSIGNED_SHORT, NULL, commands.count(), 0));
+    return true;
+}
+
 void GrGLGpu::onStencilPath(const GrPath* path, const StencilPathState& state) {
     this->flushColorWrite(false);
     this->flushDrawFace(GrPipelineBuilder::kBoth_DrawFace);
@@ -2809,6 +3202,251 @@ void GrGLGpu::xferBarrier(GrRenderTarget* rt, GrXferBarrierType type) {
     }
 }
 
+GrFence GrGLGpu::insertFence() {
+    if (!this->glCaps().fenceSyncSupport()) {
+        return 0;
+    }
+    GrGLsync sync;
+    GL_CALL_RET(sync, FenceSync(GR_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    // Make sure the fence reaches the driver without requiring the client to flush again.
+    GL_CALL(Flush());
+    return reinterpret_cast<GrFence>(sync);
+}
+
+bool GrGLGpu::waitFence(GrFence fence, uint64_t timeoutNanos) {
+    GrGLenum result;
+    GL_CALL_RET(result, ClientWaitSync(reinterpret_cast<GrGLsync>(fence), 0, timeoutNanos));
+    return GR_GL_ALREADY_SIGNALED == result || GR_GL_CONDITION_SATISFIED == result;
+}
+
+void GrGLGpu::deleteFence(GrFence fence) {
+    GL_CALL(DeleteSync(reinterpret_cast<GrGLsync>(fence)));
+}
+
+GrAsyncPixelRead GrGLGpu::insertAsyncReadPixels(GrRenderTarget* target,
+                                                int left, int top, int width, int height,
+                                                GrPixelConfig config, size_t rowBytes,
+                                                AsyncReadPixelsProc proc, void* procCtx) {
+    if (!this->glCaps().fenceSyncSupport() || !this->glCaps().pixelBufferSupport()) {
+        return 0;
+    }
+    if (fAsyncPixelReads.count() >= kMaxAsyncPixelReads) {
+        // The ring is full; the caller can drain a readback or fall back to a sync read.
+        return 0;
+    }
+    if (GrPixelConfigIsCompressed(config)) {
+        return 0;
+    }
+    GrGLenum format = 0;
+    GrGLenum type = 0;
+    if (!this->configToGLFormats(config, false, NULL, &format, &type)) {
+        return 0;
+    }
+    // We read into a tightly packed buffer, so a read clipped by the target would shift rows
+    // out from under the caller. Require the rect to be fully contained instead.
+    if (left < 0 || top < 0 || width <= 0 || height <= 0 ||
+        left + width > target->width() || top + height > target->height()) {
+        return 0;
+    }
+    size_t tightRowBytes = GrBytesPerPixel(config) * width;
+    if (0 == rowBytes) {
+        rowBytes = tightRowBytes;
+    } else if (rowBytes < tightRowBytes) {
+        return 0;
+    }
+
+    // resolve the render target if necessary
+    GrGLRenderTarget* tgt = static_cast<GrGLRenderTarget*>(target);
+    switch (tgt->getResolveType()) {
+        case GrGLRenderTarget::kCantResolve_ResolveType:
+            return 0;
+        case GrGLRenderTarget::kAutoResolves_ResolveType:
+            this->flushRenderTarget(tgt, &SkIRect::EmptyIRect());
+            break;
+        case GrGLRenderTarget::kCanResolve_ResolveType:
+            this->onResolveRenderTarget(tgt);
+            // we don't track the state of the READ FBO ID.
+            fStats.incRenderTargetBinds();
+            GL_CALL(BindFramebuffer(GR_GL_READ_FRAMEBUFFER, tgt->textureFBOID()));
+            break;
+        default:
+            SkFAIL("Unknown resolve type");
+    }
+
+    GrGLuint pbo = 0;
+    GL_CALL(GenBuffers(1, &pbo));
+    if (0 == pbo) {
+        return 0;
+    }
+
+    bool flipY = kBottomLeft_GrSurfaceOrigin == target->origin();
+    const GrGLIRect& glvp = tgt->getViewport();
+    GrGLIRect readRect;
+    readRect.setRelativeTo(glvp, left, top, width, height, target->origin());
+
+    GL_CALL(BindBuffer(GR_GL_PIXEL_PACK_BUFFER, pbo));
+    GL_CALL(BufferData(GR_GL_PIXEL_PACK_BUFFER, tightRowBytes * height, NULL,
+                       GR_GL_STREAM_READ));
+    if (flipY && this->glCaps().packFlipYSupport()) {
+        GL_CALL(PixelStorei(GR_GL_PACK_REVERSE_ROW_ORDER, 1));
+    }
+    GL_CALL(ReadPixels(readRect.fLeft, readRect.fBottom, readRect.fWidth, readRect.fHeight,
+                       format, type, NULL));
+    if (flipY && this->glCaps().packFlipYSupport()) {
+        GL_CALL(PixelStorei(GR_GL_PACK_REVERSE_ROW_ORDER, 0));
+        flipY = false;
+    }
+    GL_CALL(BindBuffer(GR_GL_PIXEL_PACK_BUFFER, 0));
+
+    GrGLsync sync;
+    GL_CALL_RET(sync, FenceSync(GR_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    // Make sure the readback reaches the driver without requiring the client to flush again.
+    GL_CALL(Flush());
+
+    AsyncPixelRead* read = SkNEW(AsyncPixelRead);
+    read->fPBO = pbo;
+    read->fSync = sync;
+    read->fHeight = height;
+    read->fTightRowBytes = tightRowBytes;
+    read->fRowBytes = rowBytes;
+    read->fFlipY = flipY;
+    read->fProc = proc;
+    read->fProcCtx = procCtx;
+    *fAsyncPixelReads.append() = read;
+    return reinterpret_cast<GrAsyncPixelRead>(read);
+}
+
+bool GrGLGpu::asyncReadPixelsIsReady(GrAsyncPixelRead handle) {
+    AsyncPixelRead* read = reinterpret_cast<AsyncPixelRead*>(handle);
+    SkASSERT(fAsyncPixelReads.find(read) >= 0);
+    return this->waitFence(reinterpret_cast<GrFence>(read->fSync), 0);
+}
+
+bool GrGLGpu::finishAsyncReadPixels(GrAsyncPixelRead handle, void* buffer, bool wait) {
+    AsyncPixelRead* read = reinterpret_cast<AsyncPixelRead*>(handle);
+    SkASSERT(fAsyncPixelReads.find(read) >= 0);
+    return this->finishAsyncRead(read, buffer, wait);
+}
+
+int GrGLGpu::processAsyncReadPixels(bool wait) {
+    // Service oldest first so procs see frames in submission order. Fences signal in order,
+    // so once one isn't ready, none of the later ones can be either.
+    int i = 0;
+    while (i < fAsyncPixelReads.count()) {
+        AsyncPixelRead* read = fAsyncPixelReads[i];
+        if (NULL == read->fProc) {
+            i += 1;     // proc-less readback; its owner completes it
+            continue;
+        }
+        if (!this->finishAsyncRead(read, NULL, wait)) {
+            break;
+        }
+        // finishAsyncRead removed the entry, so i now names the next readback.
+    }
+    return fAsyncPixelReads.count();
+}
+
+bool GrGLGpu::finishAsyncRead(AsyncPixelRead* read, void* buffer, bool wait) {
+    static const uint64_t kWaitSliceNanos = 1000 * 1000 * 1000;
+    while (!this->waitFence(reinterpret_cast<GrFence>(read->fSync), wait ? kWaitSliceNanos : 0)) {
+        if (!wait) {
+            return false;
+        }
+    }
+
+    const size_t size = read->fTightRowBytes * read->fHeight;
+    GL_CALL(BindBuffer(GR_GL_PIXEL_PACK_BUFFER, read->fPBO));
+    void* mapPtr = NULL;
+    if (GrGLCaps::kMapBufferRange_MapBufferType == this->glCaps().mapBufferType()) {
+        GL_CALL_RET(mapPtr, MapBufferRange(GR_GL_PIXEL_PACK_BUFFER, 0, size,
+                                           GR_GL_MAP_READ_BIT));
+    } else {
+        SkASSERT(GrGLCaps::kMapBuffer_MapBufferType == this->glCaps().mapBufferType());
+        GL_CALL_RET(mapPtr, MapBuffer(GR_GL_PIXEL_PACK_BUFFER, GR_GL_READ_ONLY));
+    }
+    if (NULL == mapPtr) {
+        GL_CALL(BindBuffer(GR_GL_PIXEL_PACK_BUFFER, 0));
+        this->deleteAsyncRead(read);
+        return false;
+    }
+
+    const char* src = reinterpret_cast<const char*>(mapPtr);
+    if (read->fProc) {
+        if (read->fFlipY) {
+            SkAutoMalloc tmp(size);
+            char* dst = reinterpret_cast<char*>(tmp.get()) +
+                        (read->fHeight - 1) * read->fTightRowBytes;
+            for (int y = 0; y < read->fHeight; y++) {
+                memcpy(dst, src, read->fTightRowBytes);
+                src += read->fTightRowBytes;
+                dst -= read->fTightRowBytes;
+            }
+            read->fProc(read->fProcCtx, tmp.get(), read->fTightRowBytes);
+        } else {
+            read->fProc(read->fProcCtx, mapPtr, read->fTightRowBytes);
+        }
+    } else if (buffer) {
+        char* dst = reinterpret_cast<char*>(buffer);
+        ptrdiff_t dstStep = read->fRowBytes;
+        if (read->fFlipY) {
+            dst += (read->fHeight - 1) * read->fRowBytes;
+            dstStep = -dstStep;
+        }
+        for (int y = 0; y < read->fHeight; y++) {
+            memcpy(dst, src, read->fTightRowBytes);
+            src += read->fTightRowBytes;
+            dst += dstStep;
+        }
+    }
+
+    GL_CALL(UnmapBuffer(GR_GL_PIXEL_PACK_BUFFER));
+    GL_CALL(BindBuffer(GR_GL_PIXEL_PACK_BUFFER, 0));
+    this->deleteAsyncRead(read);
+    return true;
+}
+
+void GrGLGpu::deleteAsyncRead(AsyncPixelRead* read) {
+    const int index = fAsyncPixelReads.find(read);
+    SkASSERT(index >= 0);
+    fAsyncPixelReads.remove(index);
+    GL_CALL(DeleteSync(read->fSync));
+    GL_CALL(DeleteBuffers(1, &read->fPBO));
+    SkDELETE(read);
+}
+
+void GrGLGpu::bindUniformBufferRange(const void* data, size_t size) {
+    SkASSERT(this->glCaps().uniformBufferSupport());
+    static const size_t kDefaultRingSize = 64 * 1024;
+    size_t alignedSize = GrSizeAlignUp(size, this->glCaps().uniformBufferOffsetAlignment());
+    if (0 == fUniformRingBufferID) {
+        GL_CALL(GenBuffers(1, &fUniformRingBufferID));
+        if (0 == fUniformRingBufferID) {
+            return;
+        }
+        fUniformRingBufferSize = SkTMax(kDefaultRingSize, alignedSize);
+        GL_CALL(BindBuffer(GR_GL_UNIFORM_BUFFER, fUniformRingBufferID));
+        GL_CALL(BufferData(GR_GL_UNIFORM_BUFFER, (GrGLsizeiptr) fUniformRingBufferSize, NULL,
+                           GR_GL_STREAM_DRAW));
+        fUniformRingBufferOffset = 0;
+    } else {
+        GL_CALL(BindBuffer(GR_GL_UNIFORM_BUFFER, fUniformRingBufferID));
+        if (fUniformRingBufferOffset + alignedSize > fUniformRingBufferSize) {
+            // The ring wrapped. Orphan the old storage rather than overwriting ranges that
+            // pending draws may still be sourcing.
+            fUniformRingBufferSize = SkTMax(fUniformRingBufferSize, alignedSize);
+            GL_CALL(BufferData(GR_GL_UNIFORM_BUFFER, (GrGLsizeiptr) fUniformRingBufferSize, NULL,
+                               GR_GL_STREAM_DRAW));
+            fUniformRingBufferOffset = 0;
+        }
+    }
+    GL_CALL(BufferSubData(GR_GL_UNIFORM_BUFFER, (GrGLintptr) fUniformRingBufferOffset,
+                          (GrGLsizeiptr) size, data));
+    GL_CALL(BindBufferRange(GR_GL_UNIFORM_BUFFER, GrGLProgramDataManager::kUniformBlockBinding,
+                            fUniformRingBufferID, (GrGLintptr) fUniformRingBufferOffset,
+                            (GrGLsizeiptr) size));
+    fUniformRingBufferOffset += alignedSize;
+}
+
 void GrGLGpu::didAddGpuTraceMarker() {
     if (this->caps()->gpuTracingSupport()) {
         const GrTraceMarkerSet& markerArray = this->getActiveTraceMarkers();
@@ -21,8 +21,11 @@
 #include "GrGpu.h"
 #include "GrPipelineBuilder.h"
 #include "GrXferProcessor.h"
+#include "SkTDArray.h"
 #include "SkTypes.h"
 
+class GrGLNamePool;
+class GrGLProgramBinaryCache;
 class GrPipeline;
 class GrNonInstancedVertices;
 
@@ -37,6 +40,17 @@ public:
 
     void contextAbandoned() override;
 
+    void didFlush() override;
+
+    // GrGpu batch timing overrides. Submissions are bracketed in TIME_ELAPSED queries when the
+    // driver supports them.
+    void setBatchTimingEnabled(bool enabled) override;
+    bool batchTimingEnabled() const override { return fBatchTimingEnabled; }
+    void getBatchTimings(SkTArray<BatchTiming>* timings) override;
+    void resetBatchTimings() override;
+    void beginBatchTiming(const char* name) override;
+    void endBatchTiming() override;
+
     const GrGLContext& glContext() const { return fGLContext; }
 
     const GrGLInterface* glInterface() const { return fGLContext.interface(); }
@@ -46,6 +60,15 @@ public:
     GrGLSLGeneration glslGeneration() const { return fGLContext.glslGeneration(); }
     const GrGLCaps& glCaps() const { return *fGLContext.caps(); }
 
+    // NULL unless the driver supports program binaries.  Does nothing until the embedder
+    // names a cache file with GrGLProgramBinaryCache::SetCacheFilePath().
+    GrGLProgramBinaryCache* programBinaryCache() { return fProgramBinaryCache; }
+
+    // Copies a program's packed std140 uniform data into the shared uniform ring buffer and
+    // binds the written range to GrGLProgramDataManager::kUniformBlockBinding. Only called when
+    // glCaps().uniformBufferSupport() is true.
+    void bindUniformBufferRange(const void* data, size_t size);
+
     GrGLPathRendering* glPathRendering() {
         SkASSERT(glCaps().shaderCaps()->pathRenderingSupport());
         return static_cast<GrGLPathRendering*>(pathRendering());
@@ -92,6 +115,11 @@ public:
     void notifyVertexBufferDelete(GrGLuint id) {
         fHWGeometryState.notifyVertexBufferDelete(id);
     }
+
+    // These route GL object deletions from GrGLTexture and GrGLBufferImpl through the name pools
+    // so the glDelete* calls can be batched at the next flush.
+    void deleteTextureName(GrGLuint name);
+    void deleteBufferName(GrGLuint name);
     void notifyIndexBufferDelete(GrGLuint id) {
         fHWGeometryState.notifyIndexBufferDelete(id);
     }
@@ -108,6 +136,18 @@ public:
 
     void xferBarrier(GrRenderTarget*, GrXferBarrierType) override;
 
+    GrFence insertFence() override;
+    bool waitFence(GrFence, uint64_t timeoutNanos) override;
+    void deleteFence(GrFence) override;
+
+    GrAsyncPixelRead insertAsyncReadPixels(GrRenderTarget*, int left, int top,
+                                           int width, int height, GrPixelConfig,
+                                           size_t rowBytes, AsyncReadPixelsProc,
+                                           void* procCtx) override;
+    bool asyncReadPixelsIsReady(GrAsyncPixelRead) override;
+    bool finishAsyncReadPixels(GrAsyncPixelRead, void* buffer, bool wait) override;
+    int processAsyncReadPixels(bool wait) override;
+
     void buildProgramDesc(GrProgramDesc*,
                           const GrPrimitiveProcessor&,
                           const GrPipeline&,
@@ -145,11 +185,12 @@ private:
     bool onWriteTexturePixels(GrTexture* texture,
                               int left, int top, int width, int height,
                               GrPixelConfig config, const void* buffer,
-                              size_t rowBytes) override;
+                              size_t rowBytes, bool streamingSrc) override;
 
     void onResolveRenderTarget(GrRenderTarget* target) override;
 
     void onDraw(const DrawArgs&, const GrNonInstancedVertices&) override;
+    bool onMultiDraw(const DrawArgs&, const GrVertices&) override;
     void onStencilPath(const GrPath*, const StencilPathState&) override;
     void onDrawPath(const DrawArgs&, const GrPath*, const GrStencilSettings&) override;
     void onDrawPaths(const DrawArgs&,
@@ -267,7 +308,20 @@ private:
                        int left, int top, int width, int height,
                        GrPixelConfig dataConfig,
                        const void* data,
-                       size_t rowBytes);
+                       size_t rowBytes,
+                       bool streamingSrc = false);
+
+    // Attempts to stage a texture update through the ring of pixel unpack buffers so the copy of
+    // the client memory lands in driver-owned storage and the texture update can overlap
+    // rendering. Returns false if the upload couldn't be staged; the caller should then fall back
+    // to updating from client memory directly.
+    bool uploadTexDataViaPBO(const GrSurfaceDesc& desc,
+                             int left, int top, int width, int height,
+                             GrPixelConfig dataConfig,
+                             const void* data,
+                             size_t rowBytes,
+                             GrGLenum externalFormat,
+                             GrGLenum externalType);
 
     // helper for onCreateCompressedTexture. If width and height are
     // set to -1, then this function will use desc.fWidth and desc.fHeight
@@ -298,6 +352,7 @@ private:
 
     // GL program-related state
     ProgramCache*               fProgramCache;
+    GrGLProgramBinaryCache*     fProgramBinaryCache;
     SkAutoTUnref<GrGLProgram>   fCurrentProgram;
 
     ///////////////////////////////////////////////////////////////////////////
@@ -317,6 +372,63 @@ private:
 
     GrGLuint                    fStencilClearFBOID;
 
+    // Ring buffer that backs each program's std140 uniform block when UBOs are supported. We
+    // append each draw's uniform data and orphan the buffer's storage when the ring wraps.
+    GrGLuint                    fUniformRingBufferID;
+    size_t                      fUniformRingBufferSize;
+    size_t                      fUniformRingBufferOffset;
+
+    // Lazily created buffer that holds the command records for multi-draw-indirect submissions.
+    GrGLuint                    fDrawIndirectBufferID;
+
+    // Pools that bulk-generate texture and buffer object names and batch their deletions so they
+    // happen at flush boundaries.
+    SkAutoTDelete<GrGLNamePool> fTextureNamePool;
+    SkAutoTDelete<GrGLNamePool> fBufferNamePool;
+
+    // Reads back and aggregates the results of finished batch timer queries, deleting their
+    // query objects. Called at flush boundaries and before timings are reported.
+    void pollBatchTimerQueries();
+
+    // An in-flight TIME_ELAPSED query bracketing one batch submission.
+    struct BatchTimerQuery {
+        GrGLuint fQueryID;
+        int      fTimingIndex;  // index into fBatchTimings
+    };
+    bool                        fBatchTimingEnabled;
+    bool                        fTimerQueryActive;
+    SkTArray<BatchTimerQuery>   fPendingTimerQueries;
+    SkTArray<BatchTiming>       fBatchTimings;
+
+    // Ring of pixel unpack buffers used to stage streaming texture uploads, created lazily.
+    static const int kNumUploadPBOs = 3;
+    GrGLuint                    fUploadPBOIDs[kNumUploadPBOs];
+    int                         fUploadPBOIndex;
+
+    // An asynchronous readback in flight: ReadPixels has been issued into fPBO with fSync
+    // fenced behind it. The handle returned to callers is the struct's address.
+    struct AsyncPixelRead {
+        GrGLuint            fPBO;
+        GrGLsync            fSync;
+        int                 fHeight;
+        size_t              fTightRowBytes;
+        size_t              fRowBytes;      // destination stride
+        bool                fFlipY;         // rows come back bottom-to-top
+        AsyncReadPixelsProc fProc;
+        void*               fProcCtx;
+    };
+
+    // Maps the PBO and delivers the pixels once the fence has signaled, then retires the
+    // readback. Returns false without retiring it if wait is false and the GPU isn't done.
+    bool finishAsyncRead(AsyncPixelRead*, void* buffer, bool wait);
+
+    // Deletes the readback's GL objects and removes it from fAsyncPixelReads.
+    void deleteAsyncRead(AsyncPixelRead*);
+
+    // In-flight asynchronous readbacks, oldest first.
+    static const int kMaxAsyncPixelReads = 3;
+    SkTDArray<AsyncPixelRead*>  fAsyncPixelReads;
+
     // last scissor / viewport scissor state seen by the GL.
     struct {
         TriState    fEnabled;
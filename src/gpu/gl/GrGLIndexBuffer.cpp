@@ -48,3 +48,9 @@ bool GrGLIndexBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
         return false;
     }
 }
+
+void GrGLIndexBuffer::onFinishedWithData() {
+    if (!this->wasDestroyed()) {
+        fImpl.notifyDrawsFlushed(this->getGpuGL());
+    }
+}
@@ -38,6 +38,8 @@ private:
     void* onMap() override;
     void onUnmap() override;
     bool onUpdateData(const void* src, size_t srcSizeInBytes) override;
+    bool onIsPersistentlyMapped() const override { return fImpl.isPersistentlyMapped(); }
+    void onFinishedWithData() override;
 
     GrGLGpu* getGpuGL() const {
         SkASSERT(!this->wasDestroyed());
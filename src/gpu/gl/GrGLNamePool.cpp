@@ -0,0 +1,76 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrGLNamePool.h"
+#include "GrGLGpu.h"
+
+GrGLNamePool::GrGLNamePool(GrGLGpu* gpu, PoolType type)
+    : fGpu(gpu)
+    , fType(type) {
+}
+
+GrGLNamePool::~GrGLNamePool() {
+    // The names must have been deleted with deleteAllNames() or dropped with abandon() while the
+    // GL context was still current.
+    SkASSERT(0 == fFreeNames.count());
+    SkASSERT(0 == fPendingDeletes.count());
+}
+
+GrGLuint GrGLNamePool::get() {
+    if (0 == fFreeNames.count()) {
+        GrGLuint block[kNameBlockSize];
+        block[0] = 0;
+        if (kTexture_PoolType == fType) {
+            GR_GL_CALL(fGpu->glInterface(), GenTextures(kNameBlockSize, block));
+        } else {
+            GR_GL_CALL(fGpu->glInterface(), GenBuffers(kNameBlockSize, block));
+        }
+        if (0 == block[0]) {
+            return 0;
+        }
+        // Store the block reversed so names are handed out in the order the driver made them.
+        for (int i = kNameBlockSize - 1; i >= 0; --i) {
+            *fFreeNames.append() = block[i];
+        }
+    }
+    GrGLuint name = fFreeNames.top();
+    fFreeNames.pop();
+    return name;
+}
+
+void GrGLNamePool::release(GrGLuint name) {
+    SkASSERT(0 != name);
+    *fPendingDeletes.append() = name;
+}
+
+void GrGLNamePool::flushPendingDeletes() {
+    if (fPendingDeletes.count()) {
+        this->deleteNames(fPendingDeletes.count(), fPendingDeletes.begin());
+        fPendingDeletes.reset();
+    }
+}
+
+void GrGLNamePool::deleteAllNames() {
+    this->flushPendingDeletes();
+    if (fFreeNames.count()) {
+        this->deleteNames(fFreeNames.count(), fFreeNames.begin());
+        fFreeNames.reset();
+    }
+}
+
+void GrGLNamePool::abandon() {
+    fFreeNames.reset();
+    fPendingDeletes.reset();
+}
+
+void GrGLNamePool::deleteNames(int count, const GrGLuint* names) {
+    if (kTexture_PoolType == fType) {
+        GR_GL_CALL(fGpu->glInterface(), DeleteTextures(count, names));
+    } else {
+        GR_GL_CALL(fGpu->glInterface(), DeleteBuffers(count, names));
+    }
+}
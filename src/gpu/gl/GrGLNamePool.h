@@ -0,0 +1,61 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrGLNamePool_DEFINED
+#define GrGLNamePool_DEFINED
+
+#include "SkTDArray.h"
+#include "gl/GrGLFunctions.h"
+
+class GrGLGpu;
+
+/**
+ * Hands out texture or buffer object names that are generated by the driver in bulk and batches
+ * deletions until the next flush. Unlike GrGLNameAllocator, which manages a client-assigned name
+ * range, names here still come from glGen* -- just a block at a time, so creating thousands of
+ * objects at startup doesn't pay a server round trip per name on threaded drivers.
+ */
+class GrGLNamePool : SkNoncopyable {
+public:
+    enum PoolType {
+        kTexture_PoolType,
+        kBuffer_PoolType,
+    };
+
+    GrGLNamePool(GrGLGpu* gpu, PoolType type);
+
+    ~GrGLNamePool();
+
+    /** Returns a fresh object name, bulk-generating a new block if the pool is empty. Returns 0
+        if the driver would not supply names. */
+    GrGLuint get();
+
+    /** Queues a name for deletion at the next flush. The object's storage stays alive until
+        then. */
+    void release(GrGLuint name);
+
+    /** Deletes all names queued by release(). Called at flush boundaries. */
+    void flushPendingDeletes();
+
+    /** Deletes the pending and pooled names. Called before the GL context goes away. */
+    void deleteAllNames();
+
+    /** Drops all names without touching GL. Called when the context is abandoned. */
+    void abandon();
+
+private:
+    void deleteNames(int count, const GrGLuint* names);
+
+    static const int kNameBlockSize = 256;
+
+    GrGLGpu*            fGpu;
+    PoolType            fType;
+    SkTDArray<GrGLuint> fFreeNames;
+    SkTDArray<GrGLuint> fPendingDeletes;
+};
+
+#endif
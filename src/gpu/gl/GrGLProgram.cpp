@@ -116,6 +116,10 @@ void GrGLProgram::setData(const GrPrimitiveProcessor& primProc, const GrPipeline
 
     // Some of GrGLProgram subclasses need to update state here
     this->didSetData();
+
+    // On contexts with UBO support the values written above were staged CPU-side; push them to
+    // the uniform ring buffer and bind the range for this draw.
+    fProgramDataManager.uploadUniformBuffer();
 }
 
 void GrGLProgram::setFragmentData(const GrPrimitiveProcessor& primProc,
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrGLProgramBinaryCache.h"
+
+#include "GrGLGpu.h"
+#include "GrGLUtil.h"
+#include "SkChecksum.h"
+#include "SkData.h"
+#include "SkMutex.h"
+#include "SkStream.h"
+
+/*
+ * File layout (all fields little-endian uint32_t unless noted):
+ *
+ *   magic | version | driverHash | entryCount
+ *   entryCount * { keyLength | binaryFormat | binaryLength | key bytes | binary bytes }
+ *
+ * driverHash covers GL_VENDOR, GL_RENDERER and GL_VERSION, so a driver update orphans the
+ * whole file rather than feeding it stale binaries.
+ */
+
+static const uint32_t kMagic   = 0x47725042;  // 'GrPB'
+static const uint32_t kVersion = 1;
+
+// Program binaries run a few KB to a few hundred KB.  Caches big enough to hit this are
+// probably churning anyway, so we just stop persisting rather than implement eviction.
+static const int kMaxEntries = 256;
+
+SK_DECLARE_STATIC_MUTEX(gCachePathMutex);
+static SkString* gCachePath = NULL;
+
+void GrGLProgramBinaryCache::SetCacheFilePath(const char path[]) {
+    SkAutoMutexAcquire lock(gCachePathMutex);
+    if (path) {
+        if (NULL == gCachePath) {
+            gCachePath = SkNEW(SkString);
+        }
+        gCachePath->set(path);
+    } else {
+        SkDELETE(gCachePath);
+        gCachePath = NULL;
+    }
+}
+
+static SkString cache_file_path() {
+    SkAutoMutexAcquire lock(gCachePathMutex);
+    return gCachePath ? *gCachePath : SkString();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GrGLProgramBinaryCache::GrGLProgramBinaryCache(GrGLGpu* gpu)
+    : fGpu(gpu)
+    , fPath(cache_file_path())
+    , fDriverHash(0)
+    , fLoadPending(false) {
+}
+
+GrGLProgramBinaryCache::~GrGLProgramBinaryCache() {
+    this->ensureLoaded();  // Don't let the loader race our destruction.
+    fEntries.deleteAll();
+}
+
+uint32_t GrGLProgramBinaryCache::driverHash() const {
+    const GrGLInterface* gli = fGpu->glInterface();
+    const GrGLubyte* str;
+    SkString id;
+    GR_GL_CALL_RET(gli, str, GetString(GR_GL_VENDOR));
+    id.append((const char*)str);
+    GR_GL_CALL_RET(gli, str, GetString(GR_GL_RENDERER));
+    id.append((const char*)str);
+    GR_GL_CALL_RET(gli, str, GetString(GR_GL_VERSION));
+    id.append((const char*)str);
+    return SkChecksum::Murmur3(id.c_str(), id.size());
+}
+
+void GrGLProgramBinaryCache::beginLoad() {
+    if (fPath.isEmpty() || fLoadPending) {
+        return;
+    }
+    // GetString must happen on this thread; the file parse doesn't need GL at all.
+    fDriverHash = this->driverHash();
+    fLoadPending = true;
+    fTaskGroup.add(LoadProc, this);
+}
+
+void GrGLProgramBinaryCache::LoadProc(GrGLProgramBinaryCache* cache) {
+    cache->parseFile();
+}
+
+void GrGLProgramBinaryCache::ensureLoaded() {
+    if (fLoadPending) {
+        fTaskGroup.wait();
+        fLoadPending = false;
+    }
+}
+
+namespace {
+struct Reader {
+    const uint8_t* fPtr;
+    size_t         fLeft;
+
+    bool read(void* dst, size_t bytes) {
+        if (bytes > fLeft) {
+            return false;
+        }
+        memcpy(dst, fPtr, bytes);
+        fPtr  += bytes;
+        fLeft -= bytes;
+        return true;
+    }
+    bool readU32(uint32_t* v) { return this->read(v, sizeof(uint32_t)); }
+};
+}  // namespace
+
+void GrGLProgramBinaryCache::parseFile() {
+    SkAutoTUnref<SkData> data(SkData::NewFromFileName(fPath.c_str(),
+                                                      SkData::kSequential_AccessPattern));
+    if (!data) {
+        return;  // No cache file yet.  storeProgram() will create it.
+    }
+
+    Reader reader = { (const uint8_t*)data->data(), data->size() };
+    uint32_t magic, version, driverHash, entryCount;
+    if (!reader.readU32(&magic)      || kMagic != magic    ||
+        !reader.readU32(&version)    || kVersion != version ||
+        !reader.readU32(&driverHash) || fDriverHash != driverHash ||
+        !reader.readU32(&entryCount) || entryCount > (uint32_t)kMaxEntries) {
+        return;  // Corrupt, foreign, or written by a different driver.  Start over.
+    }
+
+    for (uint32_t i = 0; i < entryCount; i++) {
+        uint32_t keyLength, binaryFormat, binaryLength;
+        if (!reader.readU32(&keyLength)    ||
+            !reader.readU32(&binaryFormat) ||
+            !reader.readU32(&binaryLength) ||
+            keyLength > reader.fLeft || binaryLength > reader.fLeft - keyLength) {
+            fEntries.deleteAll();
+            fEntries.rewind();
+            return;  // Truncated mid-entry: distrust everything.
+        }
+        Entry* entry = SkNEW(Entry);
+        entry->fKey.setCount(SkToInt(keyLength));
+        entry->fBinaryFormat = binaryFormat;
+        entry->fBinary.setCount(SkToInt(binaryLength));
+        reader.read(entry->fKey.begin(), keyLength);
+        reader.read(entry->fBinary.begin(), binaryLength);
+        *fEntries.append() = entry;
+    }
+}
+
+void GrGLProgramBinaryCache::writeFile() const {
+    SkFILEWStream stream(fPath.c_str());
+    if (!stream.isValid()) {
+        return;
+    }
+    stream.write32(kMagic);
+    stream.write32(kVersion);
+    stream.write32(fDriverHash);
+    stream.write32(fEntries.count());
+    for (int i = 0; i < fEntries.count(); i++) {
+        const Entry* entry = fEntries[i];
+        stream.write32(entry->fKey.count());
+        stream.write32(entry->fBinaryFormat);
+        stream.write32(entry->fBinary.count());
+        stream.write(entry->fKey.begin(), entry->fKey.count());
+        stream.write(entry->fBinary.begin(), entry->fBinary.count());
+    }
+}
+
+GrGLProgramBinaryCache::Entry* GrGLProgramBinaryCache::find(const GrProgramDesc& desc) const {
+    const int keyLength = SkToInt(desc.keyLength());
+    for (int i = 0; i < fEntries.count(); i++) {
+        Entry* entry = fEntries[i];
+        if (entry->fKey.count() == keyLength &&
+            0 == memcmp(entry->fKey.begin(), desc.asKey(), keyLength)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool GrGLProgramBinaryCache::restoreProgram(const GrProgramDesc& desc, GrGLuint programID) {
+    if (fPath.isEmpty()) {
+        return false;
+    }
+    this->ensureLoaded();
+
+    Entry* entry = this->find(desc);
+    if (!entry) {
+        return false;
+    }
+
+    const GrGLInterface* gli = fGpu->glInterface();
+    GR_GL_CALL(gli, ProgramBinary(programID, entry->fBinaryFormat,
+                                  entry->fBinary.begin(), entry->fBinary.count()));
+    GrGLint linked = GR_GL_INIT_ZERO;
+    GR_GL_CALL(gli, GetProgramiv(programID, GR_GL_LINK_STATUS, &linked));
+    if (!linked) {
+        // The driver rejected its own binary (new blob format, different GPU in a multi-GPU
+        // system, ...).  Drop the entry so we relink from source and re-store.
+        int index = fEntries.find(entry);
+        SkASSERT(index >= 0);
+        fEntries.remove(index);
+        SkDELETE(entry);
+        this->writeFile();
+        return false;
+    }
+    return true;
+}
+
+void GrGLProgramBinaryCache::storeProgram(const GrProgramDesc& desc, GrGLuint programID) {
+    if (fPath.isEmpty()) {
+        return;
+    }
+    this->ensureLoaded();
+
+    if (this->find(desc) || fEntries.count() >= kMaxEntries) {
+        return;
+    }
+
+    const GrGLInterface* gli = fGpu->glInterface();
+    GrGLint binaryLength = GR_GL_INIT_ZERO;
+    GR_GL_CALL(gli, GetProgramiv(programID, GR_GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+    if (binaryLength <= 0) {
+        return;
+    }
+
+    SkAutoTDelete<Entry> entry(SkNEW(Entry));
+    entry->fKey.setCount(SkToInt(desc.keyLength()));
+    memcpy(entry->fKey.begin(), desc.asKey(), desc.keyLength());
+    entry->fBinary.setCount(binaryLength);
+
+    GrGLsizei written = GR_GL_INIT_ZERO;
+    entry->fBinaryFormat = GR_GL_INIT_ZERO;
+    GR_GL_CALL(gli, GetProgramBinary(programID, binaryLength, &written,
+                                     &entry->fBinaryFormat, entry->fBinary.begin()));
+    if (written <= 0) {
+        return;
+    }
+    entry->fBinary.setCount(written);
+
+    *fEntries.append() = entry.detach();
+    this->writeFile();
+}
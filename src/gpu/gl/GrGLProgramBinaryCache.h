@@ -0,0 +1,84 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrGLProgramBinaryCache_DEFINED
+#define GrGLProgramBinaryCache_DEFINED
+
+#include "GrProgramDesc.h"
+#include "gl/GrGLInterface.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
+#include "SkTDArray.h"
+
+class GrGLGpu;
+
+/**
+ * Persists linked GL program binaries to a file so later processes can skip compiling and
+ * linking shaders entirely.  Entries are keyed by the GrProgramDesc key plus a hash of the
+ * driver's identity strings; a driver update invalidates the whole file.  The cache is only
+ * active when the embedder has named a cache file with SetCacheFilePath() and the driver
+ * reports program binary support (see GrGLCaps::programBinarySupport()).
+ */
+class GrGLProgramBinaryCache : SkNoncopyable {
+public:
+    /**
+     * Names the file used to persist program binaries, or disables persistence when NULL.
+     * The path is sampled when a GrGLGpu is created, so call this before creating the
+     * GrContext.  The file is created on first store; a corrupt or mismatched file is
+     * silently discarded.
+     */
+    static void SetCacheFilePath(const char path[]);
+
+    GrGLProgramBinaryCache(GrGLGpu* gpu);
+    ~GrGLProgramBinaryCache();
+
+    /**
+     * Kicks off parsing of the cache file.  Runs on a background thread when the embedder
+     * has enabled Skia's thread pool; the first lookup blocks until parsing completes.
+     */
+    void beginLoad();
+
+    /**
+     * If a previous process persisted a binary for desc, installs it into programID with
+     * glProgramBinary.  Returns true if the program linked; the caller then owns a fully
+     * linked program and can skip compilation.  Stale entries (e.g. from a driver that
+     * changed its mind) are dropped on failure.
+     */
+    bool restoreProgram(const GrProgramDesc& desc, GrGLuint programID);
+
+    /**
+     * Reads back programID's binary and rewrites the cache file to include it.  Call after
+     * a successful link.  No-op if desc is already cached or the file is full.
+     */
+    void storeProgram(const GrProgramDesc& desc, GrGLuint programID);
+
+private:
+    struct Entry {
+        SkTDArray<uint8_t> fKey;     // GrProgramDesc::asKey() bytes
+        GrGLenum           fBinaryFormat;
+        SkTDArray<uint8_t> fBinary;
+    };
+
+    static void LoadProc(GrGLProgramBinaryCache*);
+
+    void ensureLoaded();
+    void parseFile();
+    void writeFile() const;
+    Entry* find(const GrProgramDesc& desc) const;
+    uint32_t driverHash() const;
+
+    GrGLGpu*          fGpu;
+    SkString          fPath;     // empty when the cache is disabled
+    uint32_t          fDriverHash;
+    SkTDArray<Entry*> fEntries;  // owned; linear scan -- program counts are small
+    SkTaskGroup       fTaskGroup;
+    bool              fLoadPending;
+
+    typedef SkNoncopyable INHERITED;
+};
+
+#endif
@@ -14,8 +14,43 @@
          SkASSERT(arrayCount <= uni.fArrayCount || \
                   (1 == arrayCount && GrGLShaderVar::kNonArray == uni.fArrayCount))
 
+const char GrGLProgramDataManager::kUniformBlockName[] = "UniformBlock";
+
+// Returns the std140 base alignment, total size, and array element stride (0 for non-arrays)
+// for the subset of uniform types Ganesh declares in its uniform block. This must mirror the
+// member order and types emitted by GrGLProgramBuilder::appendUniformDecls.
+static void get_std140_layout(GrSLType type, int arrayCount,
+                              size_t* alignment, size_t* size, GrGLint* arrayStride) {
+    size_t align, sz;
+    switch (type) {
+        case kFloat_GrSLType:  align = 4;  sz = 4;  break;
+        case kVec2f_GrSLType:  align = 8;  sz = 8;  break;
+        case kVec3f_GrSLType:  align = 16; sz = 12; break;
+        case kVec4f_GrSLType:  align = 16; sz = 16; break;
+        // Each mat3 column is padded out to a vec4.
+        case kMat33f_GrSLType: align = 16; sz = 48; break;
+        case kMat44f_GrSLType: align = 16; sz = 64; break;
+        default:
+            SkFAIL("Unexpected uniform type in uniform block.");
+            align = 16; sz = 16; break;
+    }
+    if (GrGLShaderVar::kNonArray == arrayCount) {
+        *arrayStride = 0;
+    } else {
+        // In std140 each array element's stride is rounded up to a vec4 boundary.
+        sz = GrSizeAlignUp(sz, 16);
+        *arrayStride = SkToInt(sz);
+        align = 16;
+        sz *= arrayCount;
+    }
+    *alignment = align;
+    *size = sz;
+}
+
 GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, const UniformInfoArray& uniforms)
-    : fGpu(gpu) {
+    : fGpu(gpu)
+    , fUsingUniformBuffer(gpu->glCaps().uniformBufferSupport())
+    , fUniformBufferSize(0) {
     int count = uniforms.count();
     fUniforms.push_back_n(count);
     for (int i = 0; i < count; i++) {
@@ -39,6 +74,62 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, const UniformInfoAr
         } else {
             uniform.fFSLocation = kUnusedUniform;
         }
+
+        uniform.fBufferOffset = kUnusedUniform;
+        uniform.fBufferArrayStride = 0;
+        if (fUsingUniformBuffer &&
+            kSampler2D_GrSLType != builderUniform.fVariable.getType()) {
+            size_t alignment;
+            size_t size;
+            get_std140_layout(builderUniform.fVariable.getType(),
+                              builderUniform.fVariable.getArrayCount(),
+                              &alignment, &size, &uniform.fBufferArrayStride);
+            fUniformBufferSize = GrSizeAlignUp(fUniformBufferSize, alignment);
+            uniform.fBufferOffset = SkToInt(fUniformBufferSize);
+            fUniformBufferSize += size;
+        }
+    }
+    if (fUniformBufferSize > 0) {
+        // Blocks are sized out to a vec4 boundary.
+        fUniformBufferSize = GrSizeAlignUp(fUniformBufferSize, 16);
+        fUniformData.reset(fUniformBufferSize);
+        memset(fUniformData.get(), 0, fUniformBufferSize);
+    }
+}
+
+void GrGLProgramDataManager::uploadUniformBuffer() {
+    if (!fUsingUniformBuffer || 0 == fUniformBufferSize) {
+        return;
+    }
+    fGpu->bindUniformBufferRange(fUniformData.get(), fUniformBufferSize);
+}
+
+void GrGLProgramDataManager::copyToUniformBuffer(const Uniform& uni, int arrayCount,
+                                                 size_t elemSize, const GrGLfloat v[]) const {
+    SkASSERT(kUnusedUniform != uni.fBufferOffset);
+    unsigned char* dst = fUniformData.get() + uni.fBufferOffset;
+    if (0 == uni.fBufferArrayStride) {
+        SkASSERT(1 == arrayCount);
+        memcpy(dst, v, elemSize);
+        return;
+    }
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(v);
+    for (int i = 0; i < arrayCount; ++i) {
+        memcpy(dst + i * uni.fBufferArrayStride, src + i * elemSize, elemSize);
+    }
+}
+
+void GrGLProgramDataManager::copyMatrix33ToUniformBuffer(const Uniform& uni, int arrayCount,
+                                                         const GrGLfloat m[]) const {
+    SkASSERT(kUnusedUniform != uni.fBufferOffset);
+    static const size_t kColumnStride = 4 * sizeof(GrGLfloat);  // columns pad out to vec4
+    static const size_t kMatrixStride = 3 * kColumnStride;
+    unsigned char* dst = fUniformData.get() + uni.fBufferOffset;
+    for (int i = 0; i < arrayCount; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            memcpy(dst + i * kMatrixStride + c * kColumnStride, m + i * 9 + c * 3,
+                   3 * sizeof(GrGLfloat));
+        }
     }
 }
 
@@ -62,6 +153,10 @@ void GrGLProgramDataManager::set1f(UniformHandle u, GrGLfloat v0) const {
     const Uniform& uni = fUniforms[u.toProgramDataIndex()];
     SkASSERT(uni.fType == kFloat_GrSLType);
     SkASSERT(GrGLShaderVar::kNonArray == uni.fArrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, 1, sizeof(v0), &v0);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1f(uni.fFSLocation, v0));
@@ -82,6 +177,10 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
     // Once the uniform manager is responsible for inserting the duplicate uniform
     // arrays in VS and FS driver bug workaround, this can be enabled.
     // this->printUni(uni);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, arrayCount, sizeof(GrGLfloat), v);
+        return;
+    }
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1fv(uni.fFSLocation, arrayCount, v));
     }
@@ -94,6 +193,11 @@ void GrGLProgramDataManager::set2f(UniformHandle u, GrGLfloat v0, GrGLfloat v1)
     const Uniform& uni = fUniforms[u.toProgramDataIndex()];
     SkASSERT(uni.fType == kVec2f_GrSLType);
     SkASSERT(GrGLShaderVar::kNonArray == uni.fArrayCount);
+    if (fUsingUniformBuffer) {
+        GrGLfloat v[2] = { v0, v1 };
+        this->copyToUniformBuffer(uni, 1, sizeof(v), v);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2f(uni.fFSLocation, v0, v1));
@@ -110,6 +214,10 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
     SkASSERT(uni.fType == kVec2f_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, arrayCount, 2 * sizeof(GrGLfloat), v);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2fv(uni.fFSLocation, arrayCount, v));
@@ -123,6 +231,11 @@ void GrGLProgramDataManager::set3f(UniformHandle u, GrGLfloat v0, GrGLfloat v1,
     const Uniform& uni = fUniforms[u.toProgramDataIndex()];
     SkASSERT(uni.fType == kVec3f_GrSLType);
     SkASSERT(GrGLShaderVar::kNonArray == uni.fArrayCount);
+    if (fUsingUniformBuffer) {
+        GrGLfloat v[3] = { v0, v1, v2 };
+        this->copyToUniformBuffer(uni, 1, sizeof(v), v);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3f(uni.fFSLocation, v0, v1, v2));
@@ -139,6 +252,10 @@ void GrGLProgramDataManager::set3fv(UniformHandle u,
     SkASSERT(uni.fType == kVec3f_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, arrayCount, 3 * sizeof(GrGLfloat), v);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3fv(uni.fFSLocation, arrayCount, v));
@@ -156,6 +273,11 @@ void GrGLProgramDataManager::set4f(UniformHandle u,
     const Uniform& uni = fUniforms[u.toProgramDataIndex()];
     SkASSERT(uni.fType == kVec4f_GrSLType);
     SkASSERT(GrGLShaderVar::kNonArray == uni.fArrayCount);
+    if (fUsingUniformBuffer) {
+        GrGLfloat v[4] = { v0, v1, v2, v3 };
+        this->copyToUniformBuffer(uni, 1, sizeof(v), v);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4f(uni.fFSLocation, v0, v1, v2, v3));
@@ -172,6 +294,10 @@ void GrGLProgramDataManager::set4fv(UniformHandle u,
     SkASSERT(uni.fType == kVec4f_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, arrayCount, 4 * sizeof(GrGLfloat), v);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4fv(uni.fFSLocation, arrayCount, v));
@@ -185,6 +311,10 @@ void GrGLProgramDataManager::setMatrix3f(UniformHandle u, const GrGLfloat matrix
     const Uniform& uni = fUniforms[u.toProgramDataIndex()];
     SkASSERT(uni.fType == kMat33f_GrSLType);
     SkASSERT(GrGLShaderVar::kNonArray == uni.fArrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyMatrix33ToUniformBuffer(uni, 1, matrix);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), UniformMatrix3fv(uni.fFSLocation, 1, false, matrix));
@@ -198,6 +328,10 @@ void GrGLProgramDataManager::setMatrix4f(UniformHandle u, const GrGLfloat matrix
     const Uniform& uni = fUniforms[u.toProgramDataIndex()];
     SkASSERT(uni.fType == kMat44f_GrSLType);
     SkASSERT(GrGLShaderVar::kNonArray == uni.fArrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, 1, 16 * sizeof(GrGLfloat), matrix);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(), UniformMatrix4fv(uni.fFSLocation, 1, false, matrix));
@@ -214,6 +348,10 @@ void GrGLProgramDataManager::setMatrix3fv(UniformHandle u,
     SkASSERT(uni.fType == kMat33f_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyMatrix33ToUniformBuffer(uni, arrayCount, matrices);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(),
@@ -232,6 +370,10 @@ void GrGLProgramDataManager::setMatrix4fv(UniformHandle u,
     SkASSERT(uni.fType == kMat44f_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
+    if (fUsingUniformBuffer) {
+        this->copyToUniformBuffer(uni, arrayCount, 16 * sizeof(GrGLfloat), matrices);
+        return;
+    }
     SkDEBUGCODE(this->printUnused(uni);)
     if (kUnusedUniform != uni.fFSLocation) {
         GR_GL_CALL(fGpu->glInterface(),
@@ -13,6 +13,7 @@
 #include "GrAllocator.h"
 
 #include "SkTArray.h"
+#include "SkTemplates.h"
 
 class GrGLGpu;
 class SkMatrix;
@@ -25,6 +26,16 @@ class GrGLProgramBuilder;
  */
 class GrGLProgramDataManager : public SkRefCnt {
 public:
+    enum {
+        // Fixed binding index shared by every program's std140 uniform block and the uniform
+        // ring buffer maintained by GrGLGpu.
+        kUniformBlockBinding = 0,
+    };
+
+    // Name of the std140 uniform block that GrGLProgramBuilder wraps non-sampler uniforms in
+    // when the GrGLCaps report uniformBufferSupport().
+    static const char kUniformBlockName[];
+
     // Opaque handle to a uniform
     class ShaderResourceHandle {
     public:
@@ -92,6 +103,11 @@ public:
     // convenience method for uploading a SkMatrix to a 3x3 matrix uniform
     void setSkMatrix(UniformHandle, const SkMatrix&) const;
 
+    /** When the uniform-buffer path is in use, appends the program's current uniform values to
+     *  the ring buffer and binds the written range to the uniform block's binding point. Called
+     *  once per draw, after the processors' setData. No-op when loose uniforms are in use. */
+    void uploadUniformBuffer();
+
 private:
     enum {
         kUnusedUniform = -1,
@@ -100,6 +116,8 @@ private:
     struct Uniform {
         GrGLint     fVSLocation;
         GrGLint     fFSLocation;
+        GrGLint     fBufferOffset;      // std140 offset into the uniform block, or kUnusedUniform
+        GrGLint     fBufferArrayStride; // std140 array element stride, 0 for non-array uniforms
         SkDEBUGCODE(
             GrSLType    fType;
             int         fArrayCount;
@@ -108,8 +126,18 @@ private:
 
     SkDEBUGCODE(void printUnused(const Uniform&) const;)
 
+    // Helpers for the uniform-buffer path. They write into fUniformData, the CPU shadow of the
+    // program's std140 uniform block.
+    void copyToUniformBuffer(const Uniform&, int arrayCount, size_t elemSize,
+                             const GrGLfloat v[]) const;
+    void copyMatrix33ToUniformBuffer(const Uniform&, int arrayCount, const GrGLfloat m[]) const;
+
     SkTArray<Uniform, true> fUniforms;
     GrGLGpu* fGpu;
+    bool fUsingUniformBuffer;
+    size_t fUniformBufferSize;  // std140 size of the uniform block, 0 if it has no members
+    // set* methods are const, so the block shadow they write to is mutable.
+    mutable SkAutoTMalloc<unsigned char> fUniformData;
 
     typedef SkRefCnt INHERITED;
 };
@@ -36,7 +36,8 @@ void GrGLTexture::init(const GrSurfaceDesc& desc, const IDDesc& idDesc) {
 void GrGLTexture::onRelease() {
     if (fTextureID) {
         if (!fIsWrapped) {
-            GL_CALL(DeleteTextures(1, &fTextureID));
+            // The name pool batches the deletion with others at the next flush.
+            GPUGL->deleteTextureName(fTextureID);
         }
         fTextureID = 0;
         fIsWrapped = false;
@@ -16,8 +16,10 @@ void GrGLAttribArrayState::set(const GrGLGpu* gpu,
                                GrGLenum type,
                                GrGLboolean normalized,
                                GrGLsizei stride,
-                               GrGLvoid* offset) {
+                               GrGLvoid* offset,
+                               GrGLuint divisor) {
     SkASSERT(index >= 0 && index < fAttribArrayStates.count());
+    SkASSERT(0 == divisor || gpu->caps()->instancedArraysSupport());
     AttribArrayState* array = &fAttribArrayStates[index];
     if (!array->fEnableIsValid || !array->fEnabled) {
         GR_GL_CALL(gpu->glInterface(), EnableVertexAttribArray(index));
@@ -45,6 +47,16 @@ void GrGLAttribArrayState::set(const GrGLGpu* gpu,
         array->fStride = stride;
         array->fOffset = offset;
     }
+    if (!array->fDivisorIsValid || array->fDivisor != divisor) {
+        // Even when no divisor has ever been set the GL default of 0 matches our cached
+        // assumption only on contexts where we can never have set one, so only skip the call on
+        // contexts without support.
+        if (gpu->caps()->instancedArraysSupport()) {
+            GR_GL_CALL(gpu->glInterface(), VertexAttribDivisor(index, divisor));
+        }
+        array->fDivisorIsValid = true;
+        array->fDivisor = divisor;
+    }
 }
 
 void GrGLAttribArrayState::disableUnusedArrays(const GrGLGpu* gpu, uint64_t usedMask) {
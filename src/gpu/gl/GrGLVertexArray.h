@@ -74,7 +74,8 @@ public:
              GrGLenum type,
              GrGLboolean normalized,
              GrGLsizei stride,
-             GrGLvoid* offset);
+             GrGLvoid* offset,
+             GrGLuint divisor = 0);
 
     /**
      * This function disables vertex attribs not present in the mask. It is assumed that the
@@ -112,10 +113,12 @@ private:
             void invalidate() {
                 fEnableIsValid = false;
                 fAttribPointerIsValid = false;
+                fDivisorIsValid = false;
             }
 
             bool        fEnableIsValid;
             bool        fAttribPointerIsValid;
+            bool        fDivisorIsValid;
             bool        fEnabled;
             GrGLuint    fVertexBufferID;
             GrGLint     fSize;
@@ -123,6 +126,7 @@ private:
             GrGLboolean fNormalized;
             GrGLsizei   fStride;
             GrGLvoid*   fOffset;
+            GrGLuint    fDivisor;
     };
 
     SkSTArray<16, AttribArrayState, true> fAttribArrayStates;
@@ -48,3 +48,9 @@ bool GrGLVertexBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
         return false;
     }
 }
+
+void GrGLVertexBuffer::onFinishedWithData() {
+    if (!this->wasDestroyed()) {
+        fImpl.notifyDrawsFlushed(this->getGpuGL());
+    }
+}
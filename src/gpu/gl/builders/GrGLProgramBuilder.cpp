@@ -11,6 +11,7 @@
 #include "gl/GrGLGpu.h"
 #include "gl/GrGLPathProcessor.h"
 #include "gl/GrGLProgram.h"
+#include "gl/GrGLProgramBinaryCache.h"
 #include "gl/GrGLSLPrettyPrint.h"
 #include "gl/GrGLUniformHandle.h"
 #include "gl/GrGLXferProcessor.h"
@@ -179,6 +180,37 @@ GrGLProgramDataManager::UniformHandle GrGLProgramBuilder::addUniformArray(
 
 void GrGLProgramBuilder::appendUniformDecls(ShaderVisibility visibility,
                                             SkString* out) const {
+    if (fGpu->glCaps().uniformBufferSupport()) {
+        // All non-sampler uniforms live in a single std140 block sourced from the uniform ring
+        // buffer. The block must be declared identically in every stage, so visibility is
+        // ignored for its members; unreferenced members don't perturb the std140 layout. The
+        // member order and types here must mirror the offsets computed by
+        // GrGLProgramDataManager.
+        SkString blockMembers;
+        for (int i = 0; i < fUniforms.count(); ++i) {
+            if (kSampler2D_GrSLType == fUniforms[i].fVariable.getType()) {
+                continue;
+            }
+            GrGLShaderVar member(fUniforms[i].fVariable);
+            member.setTypeModifier(GrGLShaderVar::kNone_TypeModifier);
+            blockMembers.append("    ");
+            member.appendDecl(this->ctxInfo(), &blockMembers);
+            blockMembers.append(";\n");
+        }
+        if (!blockMembers.isEmpty()) {
+            out->appendf("layout(std140) uniform %s {\n%s};\n",
+                         GrGLProgramDataManager::kUniformBlockName, blockMembers.c_str());
+        }
+        // Samplers cannot live in a uniform block; they stay loose.
+        for (int i = 0; i < fUniforms.count(); ++i) {
+            if (kSampler2D_GrSLType == fUniforms[i].fVariable.getType() &&
+                (fUniforms[i].fVisibility & visibility)) {
+                fUniforms[i].fVariable.appendDecl(this->ctxInfo(), out);
+                out->append(";\n");
+            }
+        }
+        return;
+    }
     for (int i = 0; i < fUniforms.count(); ++i) {
         if (fUniforms[i].fVisibility & visibility) {
             fUniforms[i].fVariable.appendDecl(this->ctxInfo(), out);
@@ -403,6 +435,16 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
         return NULL;
     }
 
+    // A binary persisted by an earlier process gives us a linked program without compiling
+    // anything.  Uniform locations are baked into the binary and are deterministic for a
+    // given desc and driver, so we query them rather than re-bind.
+    GrGLProgramBinaryCache* binaryCache = fGpu->programBinaryCache();
+    if (binaryCache && binaryCache->restoreProgram(this->desc(), programID)) {
+        this->resolveUniformLocations(programID);
+        this->bindUniformBlock(programID);
+        return this->createProgram(programID);
+    }
+
     // compile shaders and bind attributes / uniforms
     SkTDArray<GrGLuint> shadersToDelete;
 
@@ -440,6 +482,11 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
     if (!usingBindUniform) {
         this->resolveUniformLocations(programID);
     }
+    this->bindUniformBlock(programID);
+
+    if (binaryCache) {
+        binaryCache->storeProgram(this->desc(), programID);
+    }
 
     this->cleanupShaders(shadersToDelete);
 
@@ -478,6 +525,21 @@ bool GrGLProgramBuilder::checkLinkStatus(GrGLuint programID) {
     return SkToBool(linked);
 }
 
+void GrGLProgramBuilder::bindUniformBlock(GrGLuint programID) {
+    if (!fGpu->glCaps().uniformBufferSupport()) {
+        return;
+    }
+    // The block's index can differ from program to program; pin its binding to the fixed slot
+    // the uniform ring buffer is bound to.
+    GrGLuint blockIndex;
+    GL_CALL_RET(blockIndex,
+                GetUniformBlockIndex(programID, GrGLProgramDataManager::kUniformBlockName));
+    if (GR_GL_INVALID_INDEX != blockIndex) {
+        GL_CALL(UniformBlockBinding(programID, blockIndex,
+                                    GrGLProgramDataManager::kUniformBlockBinding));
+    }
+}
+
 void GrGLProgramBuilder::resolveUniformLocations(GrGLuint programID) {
     int count = fUniforms.count();
     for (int i = 0; i < count; ++i) {
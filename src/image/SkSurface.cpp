@@ -151,6 +151,18 @@ SkCanvas* SkSurface::getCanvas() {
     return asSB(this)->getCachedCanvas();
 }
 
+void SkSurface::setCollectDrawStats(bool collect) {
+    this->getCanvas()->setCollectDrawStats(collect);
+}
+
+const SkCanvas::DrawStats& SkSurface::drawStats() {
+    return this->getCanvas()->drawStats();
+}
+
+void SkSurface::resetDrawStats() {
+    this->getCanvas()->resetDrawStats();
+}
+
 SkImage* SkSurface::newImageSnapshot(Budgeted budgeted) {
     SkImage* image = asSB(this)->getCachedImage(budgeted);
     SkSafeRef(image);   // the caller will call unref() to balance this
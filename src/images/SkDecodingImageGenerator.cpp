@@ -11,6 +11,7 @@
 #include "SkImageInfo.h"
 #include "SkImageGenerator.h"
 #include "SkImagePriv.h"
+#include "SkRWBuffer.h"
 #include "SkStream.h"
 #include "SkUtils.h"
 
@@ -295,3 +296,16 @@ SkImageGenerator* SkDecodingImageGenerator::Create(
     }
     return CreateDecodingImageGenerator(NULL, stream, opts);
 }
+
+SkImageGenerator* SkDecodingImageGenerator::Create(
+        const SkRWBuffer* buffer,
+        const SkDecodingImageGenerator::Options& opts) {
+    SkASSERT(buffer != NULL);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    // The polling stream re-snapshots the buffer whenever it runs dry, so
+    // each decode below sees whatever has been appended by then.  Creation
+    // still fails (returns NULL) until enough bytes for the header are in.
+    return CreateDecodingImageGenerator(NULL, buffer->newPollingStream(), opts);
+}
@@ -1109,12 +1109,12 @@ private:
     bool doEncode(SkWStream* stream, const SkBitmap& bm,
                   const bool& hasAlpha, int colorType,
                   int bitDepth, SkColorType ct,
-                  png_color_8& sig_bit);
+                  png_color_8& sig_bit, int quality);
 
     typedef SkImageEncoder INHERITED;
 };
 
-bool SkPNGImageEncoder::onEncode(SkWStream* stream, const SkBitmap& bitmap, int /*quality*/) {
+bool SkPNGImageEncoder::onEncode(SkWStream* stream, const SkBitmap& bitmap, int quality) {
     SkColorType ct = bitmap.colorType();
 
     const bool hasAlpha = !bitmap.isOpaque();
@@ -1173,13 +1173,13 @@ bool SkPNGImageEncoder::onEncode(SkWStream* stream, const SkBitmap& bitmap, int
         bitDepth = computeBitDepth(ctable->count());
     }
 
-    return doEncode(stream, bitmap, hasAlpha, colorType, bitDepth, ct, sig_bit);
+    return doEncode(stream, bitmap, hasAlpha, colorType, bitDepth, ct, sig_bit, quality);
 }
 
 bool SkPNGImageEncoder::doEncode(SkWStream* stream, const SkBitmap& bitmap,
                   const bool& hasAlpha, int colorType,
                   int bitDepth, SkColorType ct,
-                  png_color_8& sig_bit) {
+                  png_color_8& sig_bit, int quality) {
 
     png_structp png_ptr;
     png_infop info_ptr;
@@ -1206,6 +1206,15 @@ bool SkPNGImageEncoder::doEncode(SkWStream* stream, const SkBitmap& bitmap,
 
     png_set_write_fn(png_ptr, (void*)stream, sk_write_fn, png_flush_ptr_NULL);
 
+    // Map the encoder quality onto zlib's compression levels: the bottom of
+    // the range asks for a fast encode, the top for a small one, and the
+    // middle keeps libpng's default tradeoff.
+    if (quality < 25) {
+        png_set_compression_level(png_ptr, 1);
+    } else if (quality > 95) {
+        png_set_compression_level(png_ptr, 9);
+    }
+
     /* Set the image information here.  Width and height are up to 2^31,
     * bit_depth is one of 1, 2, 4, 8, or 16, but valid values also depend on
     * the color_type selected. color_type is one of PNG_COLOR_TYPE_GRAY,
@@ -251,6 +251,8 @@ static bool webp_get_config_resize(WebPDecoderConfig* config,
     }
 
     config->output.colorspace = mode;
+    // Let libwebp split the decode across its internal worker threads.
+    config->options.use_threads = 1;
     config->output.u.RGBA.rgba = (uint8_t*)decodedBitmap->getPixels();
     config->output.u.RGBA.stride = (int) decodedBitmap->rowBytes();
     config->output.u.RGBA.size = decodedBitmap->getSize();
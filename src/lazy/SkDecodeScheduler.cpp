@@ -0,0 +1,148 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkDecodeScheduler.h"
+#include "SkImageGeneratorPriv.h"
+#include "SkLazyPtr.h"
+#include "SkTDArray.h"
+#include "SkTaskGroup.h"
+#include "SkThread.h"
+
+namespace {
+
+struct DecodeRequest : public SkRefCnt {
+    uint32_t fTicket;
+    SkDecodeScheduler::Priority fPriority;
+    SkBitmap fBitmap;
+};
+
+}  // namespace
+
+SK_DECLARE_STATIC_MUTEX(gRequestMutex);
+
+// All live requests, so tickets can be looked up.  Pending requests
+// additionally sit in gPending until a worker claims them.  Both arrays own
+// a ref on each entry.
+static SkTDArray<DecodeRequest*> gLive;
+static SkTDArray<DecodeRequest*> gPending;
+static uint32_t gNextTicket = 1;
+
+static SkTaskGroup* create_task_group() { return SkNEW(SkTaskGroup); }
+SK_DECLARE_STATIC_LAZY_PTR(SkTaskGroup, gTaskGroup, create_task_group);
+
+static int find_by_ticket(const SkTDArray<DecodeRequest*>& array, uint32_t ticket) {
+    for (int i = 0; i < array.count(); i++) {
+        if (array[i]->fTicket == ticket) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Each scheduled request posts one of these; it claims the highest-priority
+// request still pending, which is not necessarily the one that posted it.
+static void run_one_decode(int*) {
+    SkAutoTUnref<DecodeRequest> request;
+    {
+        SkAutoMutexAcquire lock(gRequestMutex);
+        int best = -1;
+        for (int i = 0; i < gPending.count(); i++) {
+            if (best < 0 || gPending[i]->fPriority > gPending[best]->fPriority) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            return;  // Everything pending was cancelled.
+        }
+        request.reset(gPending[best]);  // Adopt the pending list's ref.
+        gPending.remove(best);
+    }
+    // Locking the pixels decodes the generator into the discardable memory;
+    // the first draw of the bitmap then finds it already populated.
+    SkAutoLockPixels alp(request->fBitmap);
+}
+
+uint32_t SkDecodeScheduler::Schedule(SkImageGenerator* generator, Priority priority,
+                                     SkDiscardableMemory::Factory* factory) {
+    SkBitmap bitmap;
+    // Deletes the generator on failure.
+    if (!SkInstallDiscardablePixelRef(generator, &bitmap, factory)) {
+        return 0;
+    }
+    DecodeRequest* request = SkNEW(DecodeRequest);
+    request->fPriority = priority;
+    request->fBitmap = bitmap;
+    {
+        SkAutoMutexAcquire lock(gRequestMutex);
+        if (0 == gNextTicket) {
+            gNextTicket = 1;
+        }
+        request->fTicket = gNextTicket++;
+        *gLive.append() = request;     // Holds the initial ref.
+        *gPending.append() = SkRef(request);
+    }
+    // Idle requests wait for SkGraphics::PerformIdleWork() rather than
+    // competing with prefetch/urgent work for the pool.
+    if (priority != kIdle_Priority) {
+        gTaskGroup.get()->add(run_one_decode, (int*)NULL);
+    }
+    return request->fTicket;
+}
+
+bool SkDecodeScheduler::PerformIdleWork() {
+    SkAutoTUnref<DecodeRequest> request;
+    bool morePending;
+    {
+        SkAutoMutexAcquire lock(gRequestMutex);
+        int best = -1;
+        for (int i = 0; i < gPending.count(); i++) {
+            if (best < 0 || gPending[i]->fPriority > gPending[best]->fPriority) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            return false;
+        }
+        request.reset(gPending[best]);  // Adopt the pending list's ref.
+        gPending.remove(best);
+        morePending = gPending.count() > 0;
+    }
+    SkAutoLockPixels alp(request->fBitmap);
+    return morePending;
+}
+
+void SkDecodeScheduler::Cancel(uint32_t ticket) {
+    SkAutoMutexAcquire lock(gRequestMutex);
+    int pending = find_by_ticket(gPending, ticket);
+    if (pending >= 0) {
+        gPending[pending]->unref();
+        gPending.remove(pending);
+    }
+    int live = find_by_ticket(gLive, ticket);
+    if (live >= 0) {
+        gLive[live]->unref();
+        gLive.remove(live);
+    }
+}
+
+bool SkDecodeScheduler::TakeResult(uint32_t ticket, SkBitmap* dst) {
+    SkAutoTUnref<DecodeRequest> request;
+    {
+        SkAutoMutexAcquire lock(gRequestMutex);
+        int live = find_by_ticket(gLive, ticket);
+        if (live < 0) {
+            return false;
+        }
+        request.reset(gLive[live]);  // Adopt the live list's ref.
+        gLive.remove(live);
+        // Leave any pending entry in place: its worker will still warm the
+        // discardable memory this bitmap shares.
+    }
+    *dst = request->fBitmap;
+    return true;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDecodeScheduler_DEFINED
+#define SkDecodeScheduler_DEFINED
+
+#include "SkDiscardableMemory.h"
+#include "SkTypes.h"
+
+class SkBitmap;
+class SkImageGenerator;
+
+/**
+ *  A background predecode service for SkImageGenerator backed bitmaps.
+ *
+ *  Generator backed bitmaps decode lazily on first access, so the first
+ *  draw of each image stalls on a full decode.  Clients hand the scheduler
+ *  the generators they expect to draw soon (e.g. images just offscreen
+ *  during a scroll); each one is installed into an SkDiscardableMemory
+ *  backed bitmap and decoded on an SkTaskGroup worker, so the first draw
+ *  only locks the already populated discardable memory.  Requests can be
+ *  cancelled when the target scrolls away; a decode that has already
+ *  started is not interrupted, but its result is still usable.
+ *
+ *  Workers run on the SkTaskGroup thread pool, so decodes run synchronously
+ *  inside schedule() unless an SkTaskGroup::Enabler exists.
+ */
+class SkDecodeScheduler : SkNoncopyable {
+public:
+    enum Priority {
+        kIdle_Priority,      // decode only during PerformIdleWork(), or on first draw
+        kPrefetch_Priority,  // expected on screen soon
+        kUrgent_Priority,    // needed for the current frame
+    };
+
+    /**
+     *  Schedule generator for a background decode.  Takes ownership of the
+     *  generator.  Returns a nonzero ticket to pass to Cancel() or
+     *  TakeResult(), or 0 if a pixel ref could not be installed (the
+     *  generator is deleted either way on failure).
+     *
+     *  If factory is not NULL it supplies the discardable memory backing
+     *  the decode, as with SkInstallDiscardablePixelRef.
+     */
+    static uint32_t Schedule(SkImageGenerator*, Priority,
+                             SkDiscardableMemory::Factory* factory = NULL);
+
+    /**
+     *  Forget the request with this ticket.  If its decode has not started
+     *  it never will.  Tickets are single-use: after Cancel() or
+     *  TakeResult() the ticket is invalid.
+     */
+    static void Cancel(uint32_t ticket);
+
+    /**
+     *  Set *dst to the discardable bitmap for this ticket and forget the
+     *  ticket.  Returns false if the ticket is unknown (never issued, or
+     *  already cancelled or taken).  The bitmap is usable immediately even
+     *  if its decode has not run or its memory was purged; locking the
+     *  pixels decodes on demand as usual.
+     */
+    static bool TakeResult(uint32_t ticket, SkBitmap* dst);
+
+    /**
+     *  Run one pending decode on the calling thread, preferring the highest
+     *  priority request.  Returns true if more requests are still pending.
+     *  kIdle_Priority requests are never handed to the worker pool; this
+     *  (called from SkGraphics::PerformIdleWork()) is how they get decoded
+     *  ahead of their first draw.
+     */
+    static bool PerformIdleWork();
+};
+
+#endif  // SkDecodeScheduler_DEFINED
@@ -20,6 +20,32 @@ namespace {
 
 class PoolDiscardableMemory;
 
+// Purged allocations are parked on power-of-two size-class freelists for
+// reuse instead of going straight back to the heap; the pool's churn
+// (decode, purge, decode again) otherwise spends its time in malloc/free.
+// Requests smaller than the minimum share its class; requests larger than
+// the maximum are allocated exactly and never cached.
+static const size_t kMinBlockSize = 1 << 12;  // 4K
+static const int    kSizeClassCount = 12;     // largest class is 4K << 11 == 8M
+
+struct FreeBlock {
+    FreeBlock* fNext;
+};
+
+// Rounds *bytes up to its size class's block capacity and returns the class
+// index, or -1 (leaving *bytes alone) for requests too large to cache.
+static int size_class(size_t* bytes) {
+    size_t capacity = kMinBlockSize;
+    for (int i = 0; i < kSizeClassCount; ++i) {
+        if (*bytes <= capacity) {
+            *bytes = capacity;
+            return i;
+        }
+        capacity <<= 1;
+    }
+    return -1;
+}
+
 /**
  *  This non-global pool can be used for unit tests to verify that the
  *  pool works.
@@ -41,6 +67,8 @@ public:
     /** purges all unlocked DMs */
     void dumpPool() override;
 
+    void reclaimAsNeeded() override;
+
     #if SK_LAZY_CACHE_STATS  // Defined in SkDiscardableMemoryPool.h
     int getCacheHits() override { return fCacheHits; }
     int getCacheMisses() override { return fCacheMisses; }
@@ -55,10 +83,17 @@ private:
     SkBaseMutex* fMutex;
     size_t       fBudget;
     size_t       fUsed;
+    // Only unlocked allocations live in fList (head is most recently used),
+    // so eviction pops straight off the tail without scanning past locked
+    // entries.  Locked allocations wait off-list until unlock().
     SkTInternalLList<PoolDiscardableMemory> fList;
+    FreeBlock*   fFreeList[kSizeClassCount];
+    size_t       fCachedBytes;  // total block capacity parked in fFreeList
 
     /** Function called to free memory if needed */
     void dumpDownTo(size_t budget);
+    /** Parks a block on its size-class freelist, or frees it if uncacheable */
+    void recycleBlock(void* ptr, size_t capacity);
     /** called by DiscardableMemoryPool upon destruction */
     void free(PoolDiscardableMemory* dm);
     /** called by DiscardableMemoryPool::lock() */
@@ -78,7 +113,7 @@ private:
 class PoolDiscardableMemory : public SkDiscardableMemory {
 public:
     PoolDiscardableMemory(DiscardableMemoryPool* pool,
-                            void* pointer, size_t bytes);
+                            void* pointer, size_t bytes, size_t capacity);
     virtual ~PoolDiscardableMemory();
     bool lock() override;
     void* data() override;
@@ -89,19 +124,23 @@ private:
     DiscardableMemoryPool* const fPool;
     bool                         fLocked;
     void*                        fPointer;
-    const size_t                 fBytes;
+    const size_t                 fBytes;     // what the caller asked for; what we count
+    const size_t                 fCapacity;  // fBytes rounded up to its size class
 };
 
 PoolDiscardableMemory::PoolDiscardableMemory(DiscardableMemoryPool* pool,
                                              void* pointer,
-                                             size_t bytes)
+                                             size_t bytes,
+                                             size_t capacity)
     : fPool(pool)
     , fLocked(true)
     , fPointer(pointer)
-    , fBytes(bytes) {
+    , fBytes(bytes)
+    , fCapacity(capacity) {
     SkASSERT(fPool != NULL);
     SkASSERT(fPointer != NULL);
     SkASSERT(fBytes > 0);
+    SkASSERT(fCapacity >= fBytes);
     fPool->ref();
 }
 
@@ -132,7 +171,9 @@ DiscardableMemoryPool::DiscardableMemoryPool(size_t budget,
                                              SkBaseMutex* mutex)
     : fMutex(mutex)
     , fBudget(budget)
-    , fUsed(0) {
+    , fUsed(0)
+    , fCachedBytes(0) {
+    sk_bzero(fFreeList, sizeof(fFreeList));
     #if SK_LAZY_CACHE_STATS
     fCacheHits = 0;
     fCacheMisses = 0;
@@ -143,45 +184,91 @@ DiscardableMemoryPool::~DiscardableMemoryPool() {
     // always deleted before deleting this pool since each one has a
     // ref to the pool.
     SkASSERT(fList.isEmpty());
+    for (int i = 0; i < kSizeClassCount; ++i) {
+        FreeBlock* block = fFreeList[i];
+        while (block) {
+            FreeBlock* next = block->fNext;
+            sk_free(block);
+            block = next;
+        }
+    }
+}
+
+void DiscardableMemoryPool::recycleBlock(void* ptr, size_t capacity) {
+    size_t rounded = capacity;
+    const int sizeClass = size_class(&rounded);
+    if (sizeClass < 0) {
+        sk_free(ptr);
+        return;
+    }
+    SkASSERT(rounded == capacity);
+    FreeBlock* block = (FreeBlock*)ptr;
+    block->fNext = fFreeList[sizeClass];
+    fFreeList[sizeClass] = block;
+    fCachedBytes += capacity;
 }
 
 void DiscardableMemoryPool::dumpDownTo(size_t budget) {
     if (fMutex != NULL) {
         fMutex->assertHeld();
     }
-    if (fUsed <= budget) {
-        return;
-    }
+    // Everything in fList is unlocked, so eviction is a straight pop from the
+    // LRU tail.
     typedef SkTInternalLList<PoolDiscardableMemory>::Iter Iter;
-    Iter iter;
-    PoolDiscardableMemory* cur = iter.init(fList, Iter::kTail_IterStart);
-    while ((fUsed > budget) && (cur)) {
-        if (!cur->fLocked) {
-            PoolDiscardableMemory* dm = cur;
-            SkASSERT(dm->fPointer != NULL);
-            sk_free(dm->fPointer);
-            dm->fPointer = NULL;
-            SkASSERT(fUsed >= dm->fBytes);
-            fUsed -= dm->fBytes;
-            cur = iter.prev();
-            // Purged DMs are taken out of the list.  This saves times
-            // looking them up.  Purged DMs are NOT deleted.
-            fList.remove(dm);
-        } else {
-            cur = iter.prev();
+    while (fUsed > budget) {
+        Iter iter;
+        PoolDiscardableMemory* dm = iter.init(fList, Iter::kTail_IterStart);
+        if (NULL == dm) {
+            break;  // Everything still allocated is locked.
+        }
+        SkASSERT(!dm->fLocked);
+        SkASSERT(dm->fPointer != NULL);
+        // Purged DMs are taken out of the list.  This saves times
+        // looking them up.  Purged DMs are NOT deleted.
+        fList.remove(dm);
+        this->recycleBlock(dm->fPointer, dm->fCapacity);
+        dm->fPointer = NULL;
+        SkASSERT(fUsed >= dm->fBytes);
+        fUsed -= dm->fBytes;
+    }
+    // Cached free blocks give way (largest first) when the pool itself needs
+    // the room.
+    for (int i = kSizeClassCount - 1; i >= 0; --i) {
+        const size_t capacity = kMinBlockSize << i;
+        while (fFreeList[i] && fUsed + fCachedBytes > budget) {
+            FreeBlock* block = fFreeList[i];
+            fFreeList[i] = block->fNext;
+            sk_free(block);
+            SkASSERT(fCachedBytes >= capacity);
+            fCachedBytes -= capacity;
         }
     }
 }
 
 SkDiscardableMemory* DiscardableMemoryPool::create(size_t bytes) {
-    void* addr = sk_malloc_flags(bytes, 0);
+    size_t capacity = bytes;
+    const int sizeClass = size_class(&capacity);
+    void* addr = NULL;
+    if (sizeClass >= 0) {
+        SkAutoMutexAcquire autoMutexAcquire(fMutex);
+        if (fFreeList[sizeClass]) {
+            FreeBlock* block = fFreeList[sizeClass];
+            fFreeList[sizeClass] = block->fNext;
+            SkASSERT(fCachedBytes >= capacity);
+            fCachedBytes -= capacity;
+            addr = block;
+        }
+    }
     if (NULL == addr) {
-        return NULL;
+        addr = sk_malloc_flags(capacity, 0);
+        if (NULL == addr) {
+            return NULL;
+        }
     }
     PoolDiscardableMemory* dm = SkNEW_ARGS(PoolDiscardableMemory,
-                                             (this, addr, bytes));
+                                             (this, addr, bytes, capacity));
     SkAutoMutexAcquire autoMutexAcquire(fMutex);
-    fList.addToHead(dm);
+    // dm is born locked, so it stays off fList until its first unlock().
     fUsed += bytes;
     this->dumpDownTo(fBudget);
     return dm;
@@ -189,13 +276,14 @@ SkDiscardableMemory* DiscardableMemoryPool::create(size_t bytes) {
 
 void DiscardableMemoryPool::free(PoolDiscardableMemory* dm) {
     SkAutoMutexAcquire autoMutexAcquire(fMutex);
+    SkASSERT(!dm->fLocked);  // contract for SkDiscardableMemory
     // This is called by dm's destructor.
     if (dm->fPointer != NULL) {
-        sk_free(dm->fPointer);
+        fList.remove(dm);
+        this->recycleBlock(dm->fPointer, dm->fCapacity);
         dm->fPointer = NULL;
         SkASSERT(fUsed >= dm->fBytes);
         fUsed -= dm->fBytes;
-        fList.remove(dm);
     } else {
         SkASSERT(!fList.isInList(dm));
     }
@@ -219,8 +307,9 @@ bool DiscardableMemoryPool::lock(PoolDiscardableMemory* dm) {
         return false;
     }
     dm->fLocked = true;
+    // Locked allocations can't be evicted, so they wait off-list until
+    // unlock() returns them to the head.
     fList.remove(dm);
-    fList.addToHead(dm);
     #if SK_LAZY_CACHE_STATS
     ++fCacheHits;
     #endif  // SK_LAZY_CACHE_STATS
@@ -231,6 +320,7 @@ void DiscardableMemoryPool::unlock(PoolDiscardableMemory* dm) {
     SkASSERT(dm != NULL);
     SkAutoMutexAcquire autoMutexAcquire(fMutex);
     dm->fLocked = false;
+    fList.addToHead(dm);
     this->dumpDownTo(fBudget);
 }
 
@@ -246,6 +336,10 @@ void DiscardableMemoryPool::dumpPool() {
     SkAutoMutexAcquire autoMutexAcquire(fMutex);
     this->dumpDownTo(0);
 }
+void DiscardableMemoryPool::reclaimAsNeeded() {
+    SkAutoMutexAcquire autoMutexAcquire(fMutex);
+    this->dumpDownTo(fBudget);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 SK_DECLARE_STATIC_MUTEX(gMutex);
@@ -36,6 +36,13 @@ public:
     /** purges all unlocked DMs */
     virtual void dumpPool() = 0;
 
+    /**
+     *  Frees unlocked allocations (and cached free blocks) until the pool is
+     *  back within its budget.  A cheap no-op when already within budget;
+     *  called from SkGraphics::PerformIdleWork().
+     */
+    virtual void reclaimAsNeeded() = 0;
+
     #if SK_LAZY_CACHE_STATS
     /**
      * These two values are a count of the number of successful and
@@ -9,6 +9,10 @@
 #include "SkDiscardableMemory.h"
 #include "SkImageGenerator.h"
 
+// Images at least this many pixels are candidates for tile-granular decoding; anything
+// smaller is cheap enough to decode in one shot. 1 << 22 is 4M pixels (16MB at 8888).
+static const int64_t kMinPixelsForTiledDecode = 1 << 22;
+
 SkDiscardablePixelRef::SkDiscardablePixelRef(const SkImageInfo& info,
                                              SkImageGenerator* generator,
                                              size_t rowBytes,
@@ -19,6 +23,7 @@ SkDiscardablePixelRef::SkDiscardablePixelRef(const SkImageInfo& info,
     , fRowBytes(rowBytes)
     , fDiscardableMemory(NULL)
     , fDiscardableMemoryIsLocked(false)
+    , fHasPendingRegion(false)
 {
     SkASSERT(fGenerator != NULL);
     SkASSERT(fRowBytes > 0);
@@ -26,6 +31,20 @@ SkDiscardablePixelRef::SkDiscardablePixelRef(const SkImageInfo& info,
     // decode the same image on each call to getPixels().
     this->setImmutable();
     SkSafeRef(fDMFactory);
+
+    // Index8 stays on the full-decode path: the color table comes from the one-shot decode.
+    fTiled = kIndex_8_SkColorType != info.colorType() &&
+             info.width() >= kTileSize && info.height() >= kTileSize &&
+             sk_64_mul(info.width(), info.height()) >= kMinPixelsForTiledDecode;
+    if (fTiled) {
+        fTilesX = (info.width() + kTileSize - 1) / kTileSize;
+        fTilesY = (info.height() + kTileSize - 1) / kTileSize;
+        fTileResident.reset(fTilesX * fTilesY);
+        sk_bzero(fTileResident.get(), fTilesX * fTilesY * sizeof(bool));
+    } else {
+        fTilesX = fTilesY = 0;
+    }
+    fPendingRegion.setEmpty();
 }
 
 SkDiscardablePixelRef::~SkDiscardablePixelRef() {
@@ -38,35 +57,7 @@ SkDiscardablePixelRef::~SkDiscardablePixelRef() {
     SkDELETE(fGenerator);
 }
 
-bool SkDiscardablePixelRef::onNewLockPixels(LockRec* rec) {
-    if (fDiscardableMemory != NULL) {
-        if (fDiscardableMemory->lock()) {
-            fDiscardableMemoryIsLocked = true;
-            rec->fPixels = fDiscardableMemory->data();
-            rec->fColorTable = fCTable.get();
-            rec->fRowBytes = fRowBytes;
-            return true;
-        }
-        SkDELETE(fDiscardableMemory);
-        fDiscardableMemory = NULL;
-        fDiscardableMemoryIsLocked = false;
-    }
-
-    const size_t size = this->info().getSafeSize(fRowBytes);
-
-    if (fDMFactory != NULL) {
-        fDiscardableMemory = fDMFactory->create(size);
-        fDiscardableMemoryIsLocked = true;
-    } else {
-        fDiscardableMemory = SkDiscardableMemory::Create(size);
-        fDiscardableMemoryIsLocked = true;
-    }
-    if (NULL == fDiscardableMemory) {
-        fDiscardableMemoryIsLocked = false;
-        return false;  // Memory allocation failed.
-    }
-
-    void* pixels = fDiscardableMemory->data();
+bool SkDiscardablePixelRef::decodeFully(void* pixels) {
     const SkImageInfo& info = this->info();
     SkPMColor colors[256];
     int colorCount = 0;
@@ -78,10 +69,6 @@ bool SkDiscardablePixelRef::onNewLockPixels(LockRec* rec) {
         case SkImageGenerator::kIncompleteInput:
             break;
         default:
-            fDiscardableMemory->unlock();
-            fDiscardableMemoryIsLocked = false;
-            SkDELETE(fDiscardableMemory);
-            fDiscardableMemory = NULL;
             return false;
     }
 
@@ -96,6 +83,119 @@ bool SkDiscardablePixelRef::onNewLockPixels(LockRec* rec) {
         fCTable.reset(NULL);
     }
 
+    if (fTiled) {
+        memset(fTileResident.get(), true, fTilesX * fTilesY * sizeof(bool));
+    }
+    return true;
+}
+
+bool SkDiscardablePixelRef::decodeRegion(void* pixels, const SkIRect& region) {
+    SkASSERT(fTiled);
+    const SkImageInfo& info = this->info();
+    const int bpp = info.bytesPerPixel();
+
+    const int tileL = region.fLeft / kTileSize;
+    const int tileT = region.fTop / kTileSize;
+    const int tileR = (region.fRight + kTileSize - 1) / kTileSize;
+    const int tileB = (region.fBottom + kTileSize - 1) / kTileSize;
+
+    for (int ty = tileT; ty < tileB; ++ty) {
+        for (int tx = tileL; tx < tileR; ++tx) {
+            if (fTileResident[ty * fTilesX + tx]) {
+                continue;
+            }
+            SkIRect tile = SkIRect::MakeXYWH(tx * kTileSize, ty * kTileSize,
+                                             kTileSize, kTileSize);
+            SkAssertResult(tile.intersect(SkIRect::MakeWH(info.width(), info.height())));
+
+            SkImageGenerator::Options options;
+            options.fSubset = &tile;
+            void* addr = (char*)pixels + tile.fTop * fRowBytes + tile.fLeft * bpp;
+            const SkImageGenerator::Result result =
+                fGenerator->getPixels(info.makeWH(tile.width(), tile.height()), addr, fRowBytes,
+                                      &options, NULL, NULL);
+            switch (result) {
+                case SkImageGenerator::kSuccess:
+                case SkImageGenerator::kIncompleteInput:
+                    fTileResident[ty * fTilesX + tx] = true;
+                    break;
+                case SkImageGenerator::kUnimplemented:
+                    // The generator can't decode subsets after all. Fall back to one-shot
+                    // decodes for the life of this pixelref.
+                    fTiled = false;
+                    return this->decodeFully(pixels);
+                default:
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+void SkDiscardablePixelRef::onEnsureRegionResident(const SkIRect& region) {
+    if (!fTiled) {
+        return;
+    }
+    if (fHasPendingRegion) {
+        fPendingRegion.join(region);
+    } else {
+        fPendingRegion = region;
+        fHasPendingRegion = true;
+    }
+}
+
+bool SkDiscardablePixelRef::onNewLockPixels(LockRec* rec) {
+    bool freshBlock = false;
+
+    if (fDiscardableMemory != NULL) {
+        if (fDiscardableMemory->lock()) {
+            fDiscardableMemoryIsLocked = true;
+        } else {
+            SkDELETE(fDiscardableMemory);
+            fDiscardableMemory = NULL;
+            fDiscardableMemoryIsLocked = false;
+        }
+    }
+
+    if (NULL == fDiscardableMemory) {
+        const size_t size = this->info().getSafeSize(fRowBytes);
+
+        if (fDMFactory != NULL) {
+            fDiscardableMemory = fDMFactory->create(size);
+        } else {
+            fDiscardableMemory = SkDiscardableMemory::Create(size);
+        }
+        if (NULL == fDiscardableMemory) {
+            return false;  // Memory allocation failed.
+        }
+        fDiscardableMemoryIsLocked = true;
+        freshBlock = true;
+        if (fTiled) {
+            // The old contents are gone along with the purged block.
+            sk_bzero(fTileResident.get(), fTilesX * fTilesY * sizeof(bool));
+        }
+    }
+
+    void* pixels = fDiscardableMemory->data();
+    bool success;
+    if (fTiled) {
+        // With a residency hint, decode just the tiles that draw needs; without one we
+        // must produce the full image.
+        const SkIRect full = SkIRect::MakeWH(this->info().width(), this->info().height());
+        success = this->decodeRegion(pixels, fHasPendingRegion ? fPendingRegion : full);
+    } else {
+        success = freshBlock ? this->decodeFully(pixels) : true;
+    }
+    fHasPendingRegion = false;
+
+    if (!success) {
+        fDiscardableMemory->unlock();
+        fDiscardableMemoryIsLocked = false;
+        SkDELETE(fDiscardableMemory);
+        fDiscardableMemory = NULL;
+        return false;
+    }
+
     rec->fPixels = pixels;
     rec->fColorTable = fCTable.get();
     rec->fRowBytes = fRowBytes;
@@ -12,6 +12,7 @@
 #include "SkImageGenerator.h"
 #include "SkImageInfo.h"
 #include "SkPixelRef.h"
+#include "SkTemplates.h"
 
 /**
  *  A PixelRef backed by SkDiscardableMemory, with the ability to
@@ -28,11 +29,16 @@ protected:
     bool onNewLockPixels(LockRec*) override;
     void onUnlockPixels() override;
     bool onLockPixelsAreWritable() const override { return false; }
+    void onEnsureRegionResident(const SkIRect&) override;
 
     SkData* onRefEncodedData() override {
         return fGenerator->refEncodedData();
     }
 
+    GrTexture* generateTexture(GrContext* ctx) override {
+        return fGenerator->generateTexture(ctx);
+    }
+
 private:
     SkImageGenerator* const fGenerator;
     SkDiscardableMemory::Factory* const fDMFactory;
@@ -44,6 +50,22 @@ private:
     bool                 fDiscardableMemoryIsLocked;
     SkAutoTUnref<SkColorTable> fCTable;
 
+    // Tile-granular residency for large images. When enabled, the discardable block is
+    // allocated at full size but individual kTileSize x kTileSize tiles are only decoded
+    // (via the generator's subset support) once a draw declares it needs them through
+    // ensureRegionResident(). A lock with no preceding hint decodes everything, so callers
+    // that never hint see the same behavior as before.
+    enum { kTileSize = 256 };
+    bool                 fTiled;
+    int                  fTilesX;
+    int                  fTilesY;
+    SkAutoTMalloc<bool>  fTileResident;     // fTilesX * fTilesY flags
+    bool                 fHasPendingRegion;
+    SkIRect              fPendingRegion;
+
+    bool decodeRegion(void* pixels, const SkIRect& region);
+    bool decodeFully(void* pixels);
+
     /* Takes ownership of SkImageGenerator. */
     SkDiscardablePixelRef(const SkImageInfo&, SkImageGenerator*,
                           size_t rowBytes,
@@ -754,6 +754,107 @@ void S32_D16_filter_DXDY_SSSE3(const SkBitmapProcState& s,
     }
 }
 
+namespace {
+
+// Byte positions for building a PMColor from [R, G, B] held in the low three 32-bit lanes.
+#define PM_SHUFFLE_BYTE(i) ((i) == (SK_R32_SHIFT / 8) ? 0 : \
+                            (i) == (SK_G32_SHIFT / 8) ? 4 : \
+                            (i) == (SK_B32_SHIFT / 8) ? 8 : -1)
+
+// Bilinear-blend the 2x2 565 texel neighborhood of one destination pixel.  Returns the
+// blended 8-bit components in the low three 32-bit lanes as [R, G, B, 0], bit-exact with
+// the scalar Filter_565_Expanded()/SkExpanded_565_To_PMColor() path: the four texels get
+// 5-bit weights summing to 32, and each channel is doubled up front so one uniform
+// shift-by-3 at the end matches the scalar path's per-channel shifts.
+inline __m128i filter_565_pixel(const uint16_t* row0, const uint16_t* row1,
+                                uint32_t XX, unsigned subY) {
+    unsigned x0 = XX >> 14;
+    const unsigned x1 = XX & 0x3FFF;
+    const unsigned subX = x0 & 0xF;
+    x0 >>= 4;
+
+    // Texels in 16-bit lanes: [a00, a01, a10, a11].
+    __m128i t = _mm_cvtsi32_si128(row0[x0] | (row0[x1] << 16));
+    t = _mm_insert_epi16(t, row1[x0], 2);
+    t = _mm_insert_epi16(t, row1[x1], 3);
+
+    const __m128i mask_double5 = _mm_set1_epi16(0x3E);
+    __m128i rr = _mm_and_si128(_mm_srli_epi16(t, 10), mask_double5);        // 2*r5
+    __m128i gg = _mm_and_si128(_mm_srli_epi16(t, 5), _mm_set1_epi16(0x3F)); // g6
+    __m128i bb = _mm_and_si128(_mm_slli_epi16(t, 1), mask_double5);         // 2*b5
+
+    const int xy = (subX * subY) >> 3;
+    const __m128i weights = _mm_setr_epi16(32 - 2*subY - 2*subX + xy, 2*subX - xy,
+                                           2*subY - xy, xy,
+                                           32 - 2*subY - 2*subX + xy, 2*subX - xy,
+                                           2*subY - xy, xy);
+
+    const __m128i ones = _mm_set1_epi16(1);
+    // [2r x4 | g x4] * weights, summed pairwise into 32 bits.
+    __m128i sum_rg = _mm_madd_epi16(_mm_mullo_epi16(_mm_unpacklo_epi64(rr, gg), weights),
+                                    ones);
+    __m128i sum_b = _mm_madd_epi16(_mm_mullo_epi16(bb, weights), ones);
+    // [2*sumR, sumG, 2*sumB, 0] >> 3 == [sumR >> 2, sumG >> 3, sumB >> 2, 0].
+    return _mm_srli_epi32(_mm_hadd_epi32(sum_rg, sum_b), 3);
+}
+
+// Sampler for the 565-source bilinear DX case.  The scalar version in
+// SkBitmapProcState_sample.h filters in the expanded-565 domain one texel at a time;
+// here all four texels of a destination pixel are blended at once.
+template<bool has_alpha>
+void S16_generic_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                     const uint32_t* xy, int count, uint32_t* colors) {
+    SkASSERT(count > 0 && colors != NULL);
+    SkASSERT(s.fFilterLevel != kNone_SkFilterQuality);
+    SkASSERT(kRGB_565_SkColorType == s.fBitmap->colorType());
+    if (!has_alpha) {
+        SkASSERT(256 == s.fAlphaScale);
+    }
+
+    const char* srcAddr = static_cast<const char*>(s.fBitmap->getPixels());
+    const size_t rb = s.fBitmap->rowBytes();
+
+    uint32_t XY = *xy++;
+    const unsigned y0 = XY >> 14;
+    const uint16_t* row0 = reinterpret_cast<const uint16_t*>(srcAddr + (y0 >> 4) * rb);
+    const uint16_t* row1 = reinterpret_cast<const uint16_t*>(srcAddr + (XY & 0x3FFF) * rb);
+    const unsigned subY = y0 & 0xF;
+
+    const __m128i pack = _mm_setr_epi8(PM_SHUFFLE_BYTE(0), PM_SHUFFLE_BYTE(1),
+                                       PM_SHUFFLE_BYTE(2), PM_SHUFFLE_BYTE(3),
+                                       -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const unsigned alphaScale = s.fAlphaScale;
+    const __m128i alpha16 = _mm_set1_epi16(alphaScale);
+    const uint32_t packedAlpha =
+        (has_alpha ? (0xFF * alphaScale) >> 8 : 0xFFu) << SK_A32_SHIFT;
+
+    do {
+        __m128i rgb = filter_565_pixel(row0, row1, *xy++, subY);
+        if (has_alpha) {
+            // Components are at most 0xFF in the low half of each 32-bit lane, so a
+            // 16-bit multiply by the 0..256 scale cannot carry into the high half.
+            rgb = _mm_srli_epi32(_mm_mullo_epi16(rgb, alpha16), 8);
+        }
+        *colors++ = _mm_cvtsi128_si32(_mm_shuffle_epi8(rgb, pack)) | packedAlpha;
+    } while (--count > 0);
+}
+
+#undef PM_SHUFFLE_BYTE
+
+}  // namespace
+
+void S16_opaque_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                    const uint32_t* xy,
+                                    int count, uint32_t* colors) {
+    S16_generic_D32_filter_DX_SSSE3<false>(s, xy, count, colors);
+}
+
+void S16_alpha_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                   const uint32_t* xy,
+                                   int count, uint32_t* colors) {
+    S16_generic_D32_filter_DX_SSSE3<true>(s, xy, count, colors);
+}
+
 #else // SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
 
 void S32_opaque_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
@@ -792,4 +893,16 @@ void S32_D16_filter_DXDY_SSSE3(const SkBitmapProcState& s,
     sk_throw();
 }
 
+void S16_opaque_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                    const uint32_t* xy,
+                                    int count, uint32_t* colors) {
+    sk_throw();
+}
+
+void S16_alpha_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                   const uint32_t* xy,
+                                   int count, uint32_t* colors) {
+    sk_throw();
+}
+
 #endif
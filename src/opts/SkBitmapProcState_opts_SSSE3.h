@@ -30,4 +30,11 @@ void S32_D16_filter_DXDY_SSSE3(const SkBitmapProcState& s,
                                const uint32_t* xy,
                                int count, uint16_t* colors);
 
+void S16_opaque_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                    const uint32_t* xy,
+                                    int count, uint32_t* colors);
+void S16_alpha_D32_filter_DX_SSSE3(const SkBitmapProcState& s,
+                                   const uint32_t* xy,
+                                   int count, uint32_t* colors);
+
 #endif
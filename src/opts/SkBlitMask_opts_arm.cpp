@@ -48,5 +48,22 @@ SkBlitMask::BlitLCD16RowProc SkBlitMask::PlatformBlitRowProcs16(bool isOpaque) {
 SkBlitMask::RowProc SkBlitMask::PlatformRowProcs(SkColorType dstCT,
                                                  SkMask::Format maskFormat,
                                                  RowFlags flags) {
+#if SK_ARM_NEON_IS_NONE
     return NULL;
+#else
+#if SK_ARM_NEON_IS_DYNAMIC
+    if (!sk_cpu_arm_has_neon()) {
+        return NULL;
+    }
+#endif
+    if ((kN32_SkColorType == dstCT) &&
+        (SkMask::kLCD16_Format == maskFormat)) {
+        if (flags & kSrcIsOpaque_RowFlag) {
+            return (SkBlitMask::RowProc)SkBlitLCD16OpaquePMSrcRow_neon;
+        } else {
+            return (SkBlitMask::RowProc)SkBlitLCD16PMSrcRow_neon;
+        }
+    }
+    return NULL;
+#endif
 }
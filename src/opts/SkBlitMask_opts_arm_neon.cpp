@@ -252,3 +252,115 @@ void SkBlitLCD16Row_neon(SkPMColor dst[], const uint16_t src[],
         dst[i] = SkBlendLCD16(colA, colR, colG, colB, dst[i], src[i]);
     }
 }
+
+// Per-pixel-src variants of the two LCD16 rows above, for the
+// SkBlitMask::RowProc path (shader text): src is a row of premultiplied
+// colors rather than a single solid color.
+
+// dst + ((src - (srcA * dst >> 8)) * mask >> 5), for one channel of 8 pixels.
+// srcA is 0..256, mask is 0..32, so every product fits a 16 bit lane; the
+// final sum can overshoot 255 by a truncation bit, so narrow saturating.
+static inline uint8x8_t SkBlendLCD16PMSrc_neon8(uint8x8_t src, uint8x8_t dst,
+                                                uint16x8_t srcA,
+                                                uint16x8_t mask) {
+    uint16x8_t vdst_wide = vmovl_u8(dst);
+    int16x8_t vt = vreinterpretq_s16_u16(vshrq_n_u16(vmulq_u16(srcA, vdst_wide), 8));
+    int16x8_t vdiff = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(src)), vt);
+    vdiff = vmulq_s16(vdiff, vreinterpretq_s16_u16(mask));
+    return vqmovun_s16(vaddq_s16(vreinterpretq_s16_u16(vdst_wide),
+                                 vshrq_n_s16(vdiff, 5)));
+}
+
+void SkBlitLCD16PMSrcRow_neon(SkPMColor dst[], const uint16_t mask[],
+                              const SkPMColor src[], int width) {
+    while (width >= 8) {
+        uint8x8x4_t vdst, vsrc;
+        uint16x8_t vmask;
+        uint16x8_t vmaskR, vmaskG, vmaskB;
+        uint16x8_t vsrcA;
+
+        vdst = vld4_u8((uint8_t*)dst);
+        vsrc = vld4_u8((const uint8_t*)src);
+        vmask = vld1q_u16(mask);
+
+        // Get all the color masks on 5 bits
+        vmaskR = vshrq_n_u16(vmask, SK_R16_SHIFT);
+        vmaskG = vshrq_n_u16(vshlq_n_u16(vmask, SK_R16_BITS),
+                             SK_B16_BITS + SK_R16_BITS + 1);
+        vmaskB = vmask & vdupq_n_u16(SK_B16_MASK);
+
+        // Upscale to 0..32
+        vmaskR = vmaskR + vshrq_n_u16(vmaskR, 4);
+        vmaskG = vmaskG + vshrq_n_u16(vmaskG, 4);
+        vmaskB = vmaskB + vshrq_n_u16(vmaskB, 4);
+
+        // Per-pixel src alpha, upscaled to 0..256
+        vsrcA = vmovl_u8(vsrc.val[NEON_A]);
+        vsrcA = vaddq_u16(vsrcA, vshrq_n_u16(vsrcA, 7));
+
+        vdst.val[NEON_A] = vdup_n_u8(0xFF);
+        vdst.val[NEON_R] = SkBlendLCD16PMSrc_neon8(vsrc.val[NEON_R],
+                                                   vdst.val[NEON_R],
+                                                   vsrcA, vmaskR);
+        vdst.val[NEON_G] = SkBlendLCD16PMSrc_neon8(vsrc.val[NEON_G],
+                                                   vdst.val[NEON_G],
+                                                   vsrcA, vmaskG);
+        vdst.val[NEON_B] = SkBlendLCD16PMSrc_neon8(vsrc.val[NEON_B],
+                                                   vdst.val[NEON_B],
+                                                   vsrcA, vmaskB);
+
+        vst4_u8((uint8_t*)dst, vdst);
+
+        dst += 8;
+        src += 8;
+        mask += 8;
+        width -= 8;
+    }
+
+    for (int i = 0; i < width; i++) {
+        dst[i] = SkBlendLCD16PMSrc(src[i], dst[i], mask[i]);
+    }
+}
+
+void SkBlitLCD16OpaquePMSrcRow_neon(SkPMColor dst[], const uint16_t mask[],
+                                    const SkPMColor src[], int width) {
+    while (width >= 8) {
+        uint8x8x4_t vdst, vsrc;
+        uint16x8_t vmask;
+        uint16x8_t vmaskR, vmaskG, vmaskB;
+
+        vdst = vld4_u8((uint8_t*)dst);
+        vsrc = vld4_u8((const uint8_t*)src);
+        vmask = vld1q_u16(mask);
+
+        // Get all the color masks on 5 bits
+        vmaskR = vshrq_n_u16(vmask, SK_R16_SHIFT);
+        vmaskG = vshrq_n_u16(vshlq_n_u16(vmask, SK_R16_BITS),
+                             SK_B16_BITS + SK_R16_BITS + 1);
+        vmaskB = vmask & vdupq_n_u16(SK_B16_MASK);
+
+        // Upscale to 0..32
+        vmaskR = vmaskR + vshrq_n_u16(vmaskR, 4);
+        vmaskG = vmaskG + vshrq_n_u16(vmaskG, 4);
+        vmaskB = vmaskB + vshrq_n_u16(vmaskB, 4);
+
+        vdst.val[NEON_A] = vdup_n_u8(0xFF);
+        vdst.val[NEON_R] = SkBlend32_neon8(vsrc.val[NEON_R],
+                                           vdst.val[NEON_R], vmaskR);
+        vdst.val[NEON_G] = SkBlend32_neon8(vsrc.val[NEON_G],
+                                           vdst.val[NEON_G], vmaskG);
+        vdst.val[NEON_B] = SkBlend32_neon8(vsrc.val[NEON_B],
+                                           vdst.val[NEON_B], vmaskB);
+
+        vst4_u8((uint8_t*)dst, vdst);
+
+        dst += 8;
+        src += 8;
+        mask += 8;
+        width -= 8;
+    }
+
+    for (int i = 0; i < width; i++) {
+        dst[i] = SkBlendLCD16OpaquePMSrc(src[i], dst[i], mask[i]);
+    }
+}
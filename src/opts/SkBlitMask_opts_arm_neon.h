@@ -13,4 +13,11 @@ extern void SkBlitLCD16OpaqueRow_neon(SkPMColor dst[], const uint16_t src[],
 extern void SkBlitLCD16Row_neon(SkPMColor dst[], const uint16_t src[],
                                 SkColor color, int width, SkPMColor);
 
+extern void SkBlitLCD16PMSrcRow_neon(SkPMColor dst[], const uint16_t mask[],
+                                     const SkPMColor src[], int width);
+
+extern void SkBlitLCD16OpaquePMSrcRow_neon(SkPMColor dst[],
+                                           const uint16_t mask[],
+                                           const SkPMColor src[], int width);
+
 #endif // #ifndef SkBlitMask_opts_arm_neon_DEFINED
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBlitRow_opts_AVX2.h"
+
+// Some compilers can't compile AVX2 intrinsics.  We give them stub methods.
+// The stubs should never be called, so we make them crash just to confirm that.
+#if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+void S32A_Opaque_BlitRow32_AVX2(SkPMColor* SK_RESTRICT, const SkPMColor* SK_RESTRICT, int, U8CPU) {
+    sk_throw();
+}
+void S32_Blend_BlitRow32_AVX2(SkPMColor* SK_RESTRICT, const SkPMColor* SK_RESTRICT, int, U8CPU) {
+    sk_throw();
+}
+void Color32_AVX2(SkPMColor[], const SkPMColor[], int, SkPMColor) {
+    sk_throw();
+}
+
+#else
+
+#include <immintrin.h>      // AVX2 intrinsics
+#include "SkColorPriv.h"
+#include "SkUtils.h"
+
+// Portable implementation of SkPMSrcOver, 8 pixels at a time:
+// dst = src + dst*(255 - srcA), with the usual (x + (x >> 8) + 128) >> 8 rounding.
+static inline __m256i SkPMSrcOver_AVX2(const __m256i& src, const __m256i& dst) {
+    __m256i rb_mask = _mm256_set1_epi32(0x00FF00FF);
+    __m256i c_128 = _mm256_set1_epi16(128);
+    __m256i c_255 = _mm256_set1_epi16(255);
+
+    __m256i dst_rb = _mm256_and_si256(rb_mask, dst);
+    __m256i dst_ag = _mm256_srli_epi16(dst, 8);
+
+    // Broadcast each pixel's alpha into both 16-bit lanes of its quad.
+    __m256i alpha = _mm256_srli_epi32(src, 24);
+    alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+    alpha = _mm256_sub_epi16(c_255, alpha);
+
+    dst_rb = _mm256_mullo_epi16(dst_rb, alpha);
+    dst_ag = _mm256_mullo_epi16(dst_ag, alpha);
+
+    __m256i dst_rb_low = _mm256_srli_epi16(dst_rb, 8);
+    __m256i dst_ag_low = _mm256_srli_epi16(dst_ag, 8);
+
+    dst_rb = _mm256_add_epi16(dst_rb, dst_rb_low);
+    dst_rb = _mm256_add_epi16(dst_rb, c_128);
+    dst_rb = _mm256_srli_epi16(dst_rb, 8);
+
+    dst_ag = _mm256_add_epi16(dst_ag, dst_ag_low);
+    dst_ag = _mm256_add_epi16(dst_ag, c_128);
+    dst_ag = _mm256_andnot_si256(rb_mask, dst_ag);
+
+    return _mm256_add_epi8(src, _mm256_or_si256(dst_rb, dst_ag));
+}
+
+// Scale all four channels of each pixel by scale (0..256), 8 pixels at a time.
+static inline __m256i SkAlphaMulQ_AVX2(const __m256i& pixels, uint32_t scale) {
+    __m256i rb_mask = _mm256_set1_epi32(0x00FF00FF);
+    __m256i s = _mm256_set1_epi16(SkToU16(scale));
+
+    __m256i rb = _mm256_and_si256(rb_mask, pixels);
+    rb = _mm256_mullo_epi16(rb, s);
+    rb = _mm256_srli_epi16(rb, 8);
+
+    __m256i ag = _mm256_srli_epi16(pixels, 8);
+    ag = _mm256_mullo_epi16(ag, s);
+    ag = _mm256_andnot_si256(rb_mask, ag);
+
+    return _mm256_or_si256(rb, ag);
+}
+
+void S32A_Opaque_BlitRow32_AVX2(SkPMColor* SK_RESTRICT dst,
+                                const SkPMColor* SK_RESTRICT src,
+                                int count,
+                                U8CPU alpha) {
+    SkASSERT(alpha == 255);
+
+    int count8 = count / 8;
+    __m256i* dst8 = (__m256i*)dst;
+    const __m256i* src8 = (const __m256i*)src;
+
+    const __m256i alphaMask = _mm256_set1_epi32(0xFF << SK_A32_SHIFT);
+    for (int i = 0; i < count8; i++) {
+        __m256i s = _mm256_loadu_si256(src8 + i);
+
+        if (_mm256_testz_si256(s, alphaMask)) {
+            // All 8 source pixels are fully transparent.  There's nothing to do!
+            continue;
+        }
+        if (_mm256_testc_si256(s, alphaMask)) {
+            // All 8 source pixels are fully opaque.  No need to read or blend dst.
+            _mm256_storeu_si256(dst8 + i, s);
+            continue;
+        }
+        _mm256_storeu_si256(dst8 + i, SkPMSrcOver_AVX2(s, _mm256_loadu_si256(dst8 + i)));
+    }
+
+    // Wrap up the last <= 7 pixels.
+    for (int i = count8 * 8; i < count; i++) {
+        if (src[i] & (0xFF << SK_A32_SHIFT)) {
+            dst[i] = SkPMSrcOver(src[i], dst[i]);
+        }
+    }
+}
+
+void S32_Blend_BlitRow32_AVX2(SkPMColor* SK_RESTRICT dst,
+                              const SkPMColor* SK_RESTRICT src,
+                              int count,
+                              U8CPU alpha) {
+    SkASSERT(alpha <= 255);
+    if (count <= 0) {
+        return;
+    }
+
+    uint32_t src_scale = SkAlpha255To256(alpha);
+    uint32_t dst_scale = 256 - src_scale;
+
+    int count8 = count / 8;
+    __m256i* dst8 = (__m256i*)dst;
+    const __m256i* src8 = (const __m256i*)src;
+
+    for (int i = 0; i < count8; i++) {
+        __m256i s = SkAlphaMulQ_AVX2(_mm256_loadu_si256(src8 + i), src_scale);
+        __m256i d = SkAlphaMulQ_AVX2(_mm256_loadu_si256(dst8 + i), dst_scale);
+        _mm256_storeu_si256(dst8 + i, _mm256_add_epi8(s, d));
+    }
+
+    for (int i = count8 * 8; i < count; i++) {
+        dst[i] = SkAlphaMulQ(src[i], src_scale) + SkAlphaMulQ(dst[i], dst_scale);
+    }
+}
+
+// Uses the blend_256_round_alt algorithm, matching SkBlitRow::Color32:
+// per channel, prod = src*invA + 128; result = color + ((prod + (prod >> 8)) >> 8).
+void Color32_AVX2(SkPMColor dst[], const SkPMColor src[], int count, SkPMColor color) {
+    switch (SkGetPackedA32(color)) {
+        case   0: memmove(dst, src, count * sizeof(SkPMColor)); return;
+        case 255: sk_memset32(dst, color, count);               return;
+    }
+
+    unsigned invA = 255 - SkGetPackedA32(color);
+    invA += invA >> 7;
+    SkASSERT(invA < 256);
+
+    __m256i rb_mask = _mm256_set1_epi32(0x00FF00FF);
+    __m256i c_128 = _mm256_set1_epi16(128);
+    __m256i vInvA = _mm256_set1_epi16(SkToU16(invA));
+    __m256i vColor = _mm256_set1_epi32(color);
+
+    int count8 = count / 8;
+    __m256i* dst8 = (__m256i*)dst;
+    const __m256i* src8 = (const __m256i*)src;
+
+    for (int i = 0; i < count8; i++) {
+        __m256i s = _mm256_loadu_si256(src8 + i);
+
+        __m256i rb = _mm256_and_si256(rb_mask, s);
+        rb = _mm256_add_epi16(_mm256_mullo_epi16(rb, vInvA), c_128);
+        rb = _mm256_add_epi16(rb, _mm256_srli_epi16(rb, 8));
+        rb = _mm256_srli_epi16(rb, 8);
+
+        __m256i ag = _mm256_srli_epi16(s, 8);
+        ag = _mm256_add_epi16(_mm256_mullo_epi16(ag, vInvA), c_128);
+        ag = _mm256_add_epi16(ag, _mm256_srli_epi16(ag, 8));
+        ag = _mm256_andnot_si256(rb_mask, _mm256_slli_epi16(_mm256_srli_epi16(ag, 8), 8));
+
+        __m256i blended = _mm256_or_si256(rb, ag);
+        _mm256_storeu_si256(dst8 + i, _mm256_add_epi8(vColor, blended));
+    }
+
+    for (int i = count8 * 8; i < count; i++) {
+        unsigned rbProd = ((src[i] & 0x00FF00FF) * invA + 0x00800080);
+        // Scalar tail matches the vector math channel for channel.
+        unsigned rb = ((rbProd + ((rbProd >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        unsigned agProd = (((src[i] >> 8) & 0x00FF00FF) * invA + 0x00800080);
+        unsigned ag = (agProd + ((agProd >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+        dst[i] = color + (rb | ag);
+    }
+}
+
+#endif
@@ -1442,6 +1442,148 @@ void S32A_D565_Opaque_Dither_neon (uint16_t * SK_RESTRICT dst,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void S32A_D565_Blend_Dither_neon(uint16_t* SK_RESTRICT dst,
+                                 const SkPMColor* SK_RESTRICT src,
+                                 int count, U8CPU alpha, int x, int y) {
+    SkASSERT(255 > alpha);
+
+#define    UNROLL    8
+
+    if (count >= UNROLL) {
+        // rescale alpha to range 1 - 256
+        uint16x8_t vsrc_scale = vdupq_n_u16(SkAlpha255To256(alpha));
+
+        /* select row and offset for dither array */
+        const uint8_t *dstart = &gDitherMatrix_Neon[(y&3)*12 + (x&3)];
+
+        uint8x8_t vdither = vld1_u8(dstart);         // load dither values
+        uint8x8_t vdither_g = vshr_n_u8(vdither, 1); // calc. green dither values
+
+        do {
+            uint8x8x4_t vsrc;
+            uint8x8_t sa, sr, sg, sb;
+            uint16x8_t vsrc_dit_r, vsrc_dit_g, vsrc_dit_b;
+            uint16x8_t vsrc_res_r, vsrc_res_g, vsrc_res_b;
+            uint16x8_t vdst, vdst_r, vdst_g, vdst_b;
+            uint16x8_t vdst_scale, vzero_mask;
+            uint16x8_t vres_r, vres_g, vres_b;
+
+#ifdef SK_CPU_ARM64
+            vsrc = sk_vld4_u8_arm64_4(src);
+#else
+            {
+            register uint8x8_t d0 asm("d0");
+            register uint8x8_t d1 asm("d1");
+            register uint8x8_t d2 asm("d2");
+            register uint8x8_t d3 asm("d3");
+
+            asm ("vld4.8    {d0-d3},[%[src]]! "
+                : "=w" (d0), "=w" (d1), "=w" (d2), "=w" (d3), [src] "+r" (src)
+                :
+            );
+            vsrc.val[0] = d0;
+            vsrc.val[1] = d1;
+            vsrc.val[2] = d2;
+            vsrc.val[3] = d3;
+            }
+#endif
+            sa = vsrc.val[NEON_A];
+            sr = vsrc.val[NEON_R];
+            sg = vsrc.val[NEON_G];
+            sb = vsrc.val[NEON_B];
+
+            /* the scalar proc leaves dst alone wherever the whole src pixel
+             * is 0, so build that lane mask before mangling the channels
+             */
+            vzero_mask = vceqq_u16(vmovl_u8(vorr_u8(vorr_u8(sa, sr), vorr_u8(sg, sb))),
+                                   vdupq_n_u16(0));
+
+            // sr/sg/sb = SkDITHER_x32To565(s, dither), as in S32_D565_Blend_Dither
+            vsrc_dit_g = vaddl_u8(sg, vdither_g); // add in dither to green and widen
+            vsrc_dit_r = vaddl_u8(sr, vdither);   // add in dither to red and widen
+            vsrc_dit_b = vaddl_u8(sb, vdither);   // add in dither to blue and widen
+
+            vsrc_dit_r = vsubw_u8(vsrc_dit_r, vshr_n_u8(sr, 5));  // sub shifted red
+            vsrc_dit_g = vsubw_u8(vsrc_dit_g, vshr_n_u8(sg, 6));  // sub shifted green
+            vsrc_dit_b = vsubw_u8(vsrc_dit_b, vshr_n_u8(sb, 5));  // sub shifted blue
+
+            vsrc_res_r = vshrq_n_u16(vsrc_dit_r, 3);
+            vsrc_res_g = vshrq_n_u16(vsrc_dit_g, 2);
+            vsrc_res_b = vshrq_n_u16(vsrc_dit_b, 3);
+
+            // Load dst and unpack
+            vdst = vld1q_u16(dst);
+            vdst_b = vandq_u16(vdst, vdupq_n_u16(SK_B16_MASK));
+            vdst_g = vshrq_n_u16(vshlq_n_u16(vdst, SK_R16_BITS), SK_R16_BITS + SK_B16_BITS);
+            vdst_r = vshrq_n_u16(vdst, SK_R16_SHIFT);    // clearing hi bits
+
+            // dst_scale = SkAlpha255To256(255 - SkAlphaMul(sa, src_scale)), per pixel
+            vdst_scale = vsubq_u16(vdupq_n_u16(256),
+                                   vshrq_n_u16(vmulq_u16(vmovl_u8(sa), vsrc_scale), 8));
+
+            // res = (src * src_scale + dst * dst_scale) >> 8
+            vres_r = vshrq_n_u16(vmlaq_u16(vmulq_u16(vsrc_res_r, vsrc_scale),
+                                           vdst_r, vdst_scale), 8);
+            vres_g = vshrq_n_u16(vmlaq_u16(vmulq_u16(vsrc_res_g, vsrc_scale),
+                                           vdst_g, vdst_scale), 8);
+            vres_b = vshrq_n_u16(vmlaq_u16(vmulq_u16(vsrc_res_b, vsrc_scale),
+                                           vdst_b, vdst_scale), 8);
+
+            // keep the original dst where src was 0
+            vres_r = vbslq_u16(vzero_mask, vdst_r, vres_r);
+            vres_g = vbslq_u16(vzero_mask, vdst_g, vres_g);
+            vres_b = vbslq_u16(vzero_mask, vdst_b, vres_b);
+
+            // put result into 565 format
+            vdst = vsliq_n_u16(vres_b, vres_g, SK_G16_SHIFT); // shift up green, insert
+            vdst = vsliq_n_u16(vdst, vres_r, SK_R16_SHIFT);   // shift up red, insert
+
+            // Store result
+            vst1q_u16(dst, vdst);
+
+            // Next iteration
+            dst += UNROLL;
+            count -= UNROLL;
+            // skip x += UNROLL, since it's unchanged mod-4
+        } while (count >= UNROLL);
+    }
+#undef    UNROLL
+
+    // residuals
+    if (count > 0) {
+        int src_scale = SkAlpha255To256(alpha);
+        DITHER_565_SCAN(y);
+        do {
+            SkPMColor c = *src++;
+            SkPMColorAssert(c);
+            if (c)
+            {
+                unsigned d = *dst;
+                int sa = SkGetPackedA32(c);
+                int dst_scale = SkAlpha255To256(255 - SkAlphaMul(sa, src_scale));
+                int dither = DITHER_VALUE(x);
+
+                int sr = SkGetPackedR32(c);
+                int sg = SkGetPackedG32(c);
+                int sb = SkGetPackedB32(c);
+                sr = SkDITHER_R32To565(sr, dither);
+                sg = SkDITHER_G32To565(sg, dither);
+                sb = SkDITHER_B32To565(sb, dither);
+
+                int dr = (sr * src_scale + SkGetPackedR16(d) * dst_scale) >> 8;
+                int dg = (sg * src_scale + SkGetPackedG16(d) * dst_scale) >> 8;
+                int db = (sb * src_scale + SkGetPackedB16(d) * dst_scale) >> 8;
+
+                *dst = SkPackRGB16(dr, dg, db);
+            }
+            dst += 1;
+            DITHER_INC_X(x);
+        } while (--count != 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void S32_D565_Opaque_Dither_neon(uint16_t* SK_RESTRICT dst,
                                  const SkPMColor* SK_RESTRICT src,
                                  int count, U8CPU alpha, int x, int y) {
@@ -1548,7 +1690,7 @@ const SkBlitRow::Proc16 sk_blitrow_platform_565_procs_arm_neon[] = {
     S32_D565_Opaque_Dither_neon,
     S32_D565_Blend_Dither_neon,
     S32A_D565_Opaque_Dither_neon,
-    NULL,   // S32A_D565_Blend_Dither
+    S32A_D565_Blend_Dither_neon,
 };
 
 const SkBlitRow::ColorProc16 sk_blitrow_platform_565_colorprocs_arm_neon[] = {
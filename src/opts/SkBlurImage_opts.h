@@ -10,8 +10,14 @@
 
 #include "SkColorPriv.h"
 
+/*
+ * Procs that transpose on write step the destination by transposedStride per
+ * output pixel; it is the height of the whole pass, which may be larger than
+ * the height argument when the caller splits a pass into row chunks.
+ */
 typedef void (*SkBoxBlurProc)(const SkPMColor* src, int srcStride, SkPMColor* dst, int kernelSize,
-                              int leftOffset, int rightOffset, int width, int height);
+                              int leftOffset, int rightOffset, int width, int height,
+                              int transposedStride);
 
 bool SkBoxBlurGetPlatformProcs(SkBoxBlurProc* boxBlurX,
                                SkBoxBlurProc* boxBlurXY,
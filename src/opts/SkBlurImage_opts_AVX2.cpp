@@ -0,0 +1,158 @@
+/*
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkBlurImage_opts_AVX2.h"
+#include "SkColorPriv.h"
+#include "SkRect.h"
+
+// Some compilers can't compile AVX2 intrinsics.  We give them a stub method.
+// The stub should never be called, so we make it crash just to confirm that.
+#if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+
+bool SkBoxBlurGetPlatformProcs_AVX2(SkBoxBlurProc* boxBlurX,
+                                    SkBoxBlurProc* boxBlurXY,
+                                    SkBoxBlurProc* boxBlurYX) {
+    sk_throw();
+    return false;
+}
+
+#else
+
+#include <immintrin.h>
+
+namespace {
+enum BlurDirection {
+    kX, kY
+};
+
+/* Helper function to spread the components of two 32-bit pixels, one per
+ * 128-bit lane, into the lower 8 bits of each 32-bit element of an AVX
+ * register.  The pixels come from two adjacent blur rows.
+ */
+inline __m256i expand2(const SkPMColor* row0, const SkPMColor* row1) {
+    // xxxx xxxx ARGB argb
+    __m128i pair = _mm_insert_epi32(_mm_cvtsi32_si128(*row0), *row1, 1);
+    // 000A 000R 000G 000B | 000a 000r 000g 000b
+    return _mm256_cvtepu8_epi32(pair);
+}
+
+/* Single-row scalar cleanup, used when the row count is odd.  This mirrors the
+ * SSE4 kernel, which the AVX2 kernel is a two-rows-at-a-time version of.
+ */
+template<BlurDirection srcDirection, BlurDirection dstDirection>
+void box_blur_row(const SkPMColor* src, int srcStrideX, SkPMColor* dst, int dstStrideX,
+                  const __m128i& scale, const __m128i& half, int rightBorder,
+                  int leftOffset, int rightOffset, int width) {
+    __m128i sum = _mm_setzero_si128();
+    const SkPMColor* p = src;
+    for (int i = 0; i < rightBorder; ++i) {
+        sum = _mm_add_epi32(sum, _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*p)));
+        p += srcStrideX;
+    }
+
+    const SkPMColor* sptr = src;
+    SkColor* dptr = dst;
+    for (int x = 0; x < width; ++x) {
+        __m128i result = _mm_mullo_epi32(sum, scale);
+        result = _mm_add_epi32(result, half);
+
+        // Axxx Rxxx Gxxx Bxxx -> xxxx xxxx xxxx ARGB
+        const char _ = 0;  // Don't care what ends up in these bytes.  Happens to be byte 0.
+        result = _mm_shuffle_epi8(result, _mm_set_epi8(_,_,_,_, _,_,_,_, _,_,_,_, 15,11,7,3));
+        *dptr = _mm_cvtsi128_si32(result);
+
+        if (x >= leftOffset) {
+            SkColor l = *(sptr - leftOffset * srcStrideX);
+            sum = _mm_sub_epi32(sum, _mm_cvtepu8_epi32(_mm_cvtsi32_si128(l)));
+        }
+        if (x + rightOffset + 1 < width) {
+            SkColor r = *(sptr + (rightOffset + 1) * srcStrideX);
+            sum = _mm_add_epi32(sum, _mm_cvtepu8_epi32(_mm_cvtsi32_si128(r)));
+        }
+        sptr += srcStrideX;
+        dptr += dstStrideX;
+    }
+}
+
+/* Like the SSE4 kernel, but keeps two running sums, one blur row per 128-bit
+ * lane, so each trip through the inner loop produces two output pixels.
+ */
+template<BlurDirection srcDirection, BlurDirection dstDirection>
+void SkBoxBlur_AVX2(const SkPMColor* src, int srcStride, SkPMColor* dst, int kernelSize,
+                    int leftOffset, int rightOffset, int width, int height,
+                    int transposedStride)
+{
+    const int rightBorder = SkMin32(rightOffset + 1, width);
+    const int srcStrideX = srcDirection == kX ? 1 : srcStride;
+    const int dstStrideX = dstDirection == kX ? 1 : transposedStride;
+    const int srcStrideY = srcDirection == kX ? srcStride : 1;
+    const int dstStrideY = dstDirection == kX ? width : 1;
+    const __m256i scale = _mm256_set1_epi32((1 << 24) / kernelSize);
+    const __m256i half = _mm256_set1_epi32(1 << 23);
+    const char _ = 0;  // Don't care what ends up in these bytes.  Happens to be byte 0.
+    const __m256i pack = _mm256_set_epi8(_,_,_,_, _,_,_,_, _,_,_,_, 15,11,7,3,
+                                         _,_,_,_, _,_,_,_, _,_,_,_, 15,11,7,3);
+    int y = 0;
+    for (; y + 1 < height; y += 2) {
+        __m256i sum = _mm256_setzero_si256();
+        const SkPMColor* p = src;
+        for (int i = 0; i < rightBorder; ++i) {
+            sum = _mm256_add_epi32(sum, expand2(p, p + srcStrideY));
+            p += srcStrideX;
+        }
+
+        const SkPMColor* sptr = src;
+        SkColor* dptr = dst;
+        for (int x = 0; x < width; ++x) {
+            // Multiply each component by scale (i.e. divide by kernel size) and add half to round.
+            __m256i result = _mm256_mullo_epi32(sum, scale);
+            result = _mm256_add_epi32(result, half);
+
+            // Pack the top byte of each 32-bit element down into one color per lane.
+            result = _mm256_shuffle_epi8(result, pack);
+            *dptr = _mm_cvtsi128_si32(_mm256_castsi256_si128(result));
+            *(dptr + dstStrideY) = _mm_cvtsi128_si32(_mm256_extracti128_si256(result, 1));
+
+            if (x >= leftOffset) {
+                const SkPMColor* l = sptr - leftOffset * srcStrideX;
+                sum = _mm256_sub_epi32(sum, expand2(l, l + srcStrideY));
+            }
+            if (x + rightOffset + 1 < width) {
+                const SkPMColor* r = sptr + (rightOffset + 1) * srcStrideX;
+                sum = _mm256_add_epi32(sum, expand2(r, r + srcStrideY));
+            }
+            sptr += srcStrideX;
+            if (srcDirection == kY) {
+                _mm_prefetch(reinterpret_cast<const char*>(sptr + (rightOffset + 1) * srcStrideX),
+                             _MM_HINT_T0);
+            }
+            dptr += dstStrideX;
+        }
+        src += 2 * srcStrideY;
+        dst += 2 * dstStrideY;
+    }
+    if (y < height) {
+        box_blur_row<srcDirection, dstDirection>(src, srcStrideX, dst, dstStrideX,
+                                                 _mm256_castsi256_si128(scale),
+                                                 _mm256_castsi256_si128(half),
+                                                 rightBorder, leftOffset, rightOffset, width);
+    }
+}
+
+} // namespace
+
+bool SkBoxBlurGetPlatformProcs_AVX2(SkBoxBlurProc* boxBlurX,
+                                    SkBoxBlurProc* boxBlurXY,
+                                    SkBoxBlurProc* boxBlurYX) {
+    *boxBlurX = SkBoxBlur_AVX2<kX, kX>;
+    *boxBlurXY = SkBoxBlur_AVX2<kX, kY>;
+    *boxBlurYX = SkBoxBlur_AVX2<kY, kX>;
+    return true;
+}
+
+#endif // SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
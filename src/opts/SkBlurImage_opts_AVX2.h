@@ -0,0 +1,17 @@
+/*
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkBlurImage_opts_AVX2_DEFINED
+#define SkBlurImage_opts_AVX2_DEFINED
+
+#include "SkBlurImage_opts.h"
+
+bool SkBoxBlurGetPlatformProcs_AVX2(SkBoxBlurProc* boxBlurX,
+                                    SkBoxBlurProc* boxBlurXY,
+                                    SkBoxBlurProc* boxBlurYX);
+
+#endif
@@ -36,11 +36,12 @@ inline __m128i expand(int a) {
 
 template<BlurDirection srcDirection, BlurDirection dstDirection>
 void SkBoxBlur_SSE4(const SkPMColor* src, int srcStride, SkPMColor* dst, int kernelSize,
-                    int leftOffset, int rightOffset, int width, int height)
+                    int leftOffset, int rightOffset, int width, int height,
+                    int transposedStride)
 {
     const int rightBorder = SkMin32(rightOffset + 1, width);
     const int srcStrideX = srcDirection == kX ? 1 : srcStride;
-    const int dstStrideX = dstDirection == kX ? 1 : height;
+    const int dstStrideX = dstDirection == kX ? 1 : transposedStride;
     const int srcStrideY = srcDirection == kX ? srcStride : 1;
     const int dstStrideY = dstDirection == kX ? width : 1;
     const __m128i scale = _mm_set1_epi32((1 << 24) / kernelSize);
@@ -56,11 +56,12 @@ inline void store_2_pixels(uint16x8_t result16x8, SkPMColor* dst, int dstStride)
  */
 template<BlurDirection srcDirection, BlurDirection dstDirection>
 void SkDoubleRowBoxBlur_NEON(const SkPMColor** src, int srcStride, SkPMColor** dst, int kernelSize,
-                        int leftOffset, int rightOffset, int width, int* height)
+                        int leftOffset, int rightOffset, int width, int* height,
+                        int transposedStride)
 {
     const int rightBorder = SkMin32(rightOffset + 1, width);
     const int srcStrideX = srcDirection == kX ? 1 : srcStride;
-    const int dstStrideX = dstDirection == kX ? 1 : *height;
+    const int dstStrideX = dstDirection == kX ? 1 : transposedStride;
     const int srcStrideY = srcDirection == kX ? srcStride : 1;
     const int dstStrideY = dstDirection == kX ? width : 1;
     const uint16x8_t scale = vdupq_n_u16((1 << 15) / kernelSize);
@@ -113,11 +114,12 @@ static inline uint16x4_t expand(uint32_t a) {
 
 template<BlurDirection srcDirection, BlurDirection dstDirection>
 void SkBoxBlur_NEON(const SkPMColor* src, int srcStride, SkPMColor* dst, int kernelSize,
-                    int leftOffset, int rightOffset, int width, int height)
+                    int leftOffset, int rightOffset, int width, int height,
+                    int transposedStride)
 {
     const int rightBorder = SkMin32(rightOffset + 1, width);
     const int srcStrideX = srcDirection == kX ? 1 : srcStride;
-    const int dstStrideX = dstDirection == kX ? 1 : height;
+    const int dstStrideX = dstDirection == kX ? 1 : transposedStride;
     const int srcStrideY = srcDirection == kX ? srcStride : 1;
     const int dstStrideY = dstDirection == kX ? width : 1;
     const uint32x4_t scale = vdupq_n_u32((1 << 24) / kernelSize);
@@ -126,7 +128,7 @@ void SkBoxBlur_NEON(const SkPMColor* src, int srcStride, SkPMColor* dst, int ker
     if (1 < kernelSize && kernelSize < 128)
     {
         SkDoubleRowBoxBlur_NEON<srcDirection, dstDirection>(&src, srcStride, &dst, kernelSize,
-            leftOffset, rightOffset, width, &height);
+            leftOffset, rightOffset, width, &height, transposedStride);
     }
 
     for (; height > 0; height--) {
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkChecksum.h"
+#include "SkChecksum_opts_SSE42.h"
+
+#include <nmmintrin.h>
+
+/*
+ *  Hash implementation backing SkChecksum::Hash32 on CPUs with SSE 4.2:
+ *  fold the data through the crc32 instruction (~1 cycle per 8 bytes on
+ *  64-bit), then run the Murmur3 finalizer over the folded value to spread
+ *  it back out over all 32 bits.  The result is only ever used in-memory,
+ *  so it doesn't need to match Murmur3 or the CRC-32C specification.
+ */
+uint32_t SkChecksumHash_SSE42(const void* data, size_t bytes, uint32_t seed) {
+    // Use may_alias to remind the compiler we're intentionally violating strict aliasing,
+    // and so not to apply strict-aliasing-based optimizations.
+    typedef uint8_t SK_ATTRIBUTE(may_alias) aliased_uint8_t;
+    const aliased_uint8_t* ptr = (const aliased_uint8_t*)data;
+
+#if defined(__x86_64__) || defined(_M_X64)
+    typedef uint64_t SK_ATTRIBUTE(may_alias) aliased_uint64_t;
+    uint64_t hash = seed;
+    while (bytes >= 8) {
+        hash = _mm_crc32_u64(hash, *(const aliased_uint64_t*)ptr);
+        ptr   += 8;
+        bytes -= 8;
+    }
+    uint32_t hash32 = (uint32_t)hash;
+#else
+    typedef uint32_t SK_ATTRIBUTE(may_alias) aliased_uint32_t;
+    uint32_t hash32 = seed;
+    while (bytes >= 4) {
+        hash32 = _mm_crc32_u32(hash32, *(const aliased_uint32_t*)ptr);
+        ptr   += 4;
+        bytes -= 4;
+    }
+#endif
+
+    while (bytes > 0) {
+        hash32 = _mm_crc32_u8(hash32, *ptr);
+        ptr   += 1;
+        bytes -= 1;
+    }
+    return SkChecksum::Mix(hash32);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkHalf_opts_F16C.h"
+
+#include <immintrin.h>
+
+// The cvtph/cvtps instructions convert four values at a time and handle all
+// the denormal/infinity/NaN cases in hardware, so these are just load/store
+// loops with a scalar tail.
+
+void SkHalfToFloatRow_F16C(float dst[], const SkHalf src[], int count) {
+    while (count >= 4) {
+        __m128i h = _mm_loadl_epi64((const __m128i*)src);
+        _mm_storeu_ps(dst, _mm_cvtph_ps(h));
+        src   += 4;
+        dst   += 4;
+        count -= 4;
+    }
+    while (count > 0) {
+        *dst++ = SkHalfToFloat(*src++);
+        count--;
+    }
+}
+
+void SkFloatToHalfRow_F16C(SkHalf dst[], const float src[], int count) {
+    while (count >= 4) {
+        __m128i h = _mm_cvtps_ph(_mm_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storel_epi64((__m128i*)dst, h);
+        src   += 4;
+        dst   += 4;
+        count -= 4;
+    }
+    while (count > 0) {
+        *dst++ = SkFloatToHalf(*src++);
+        count--;
+    }
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkHalf_opts_F16C_DEFINED
+#define SkHalf_opts_F16C_DEFINED
+
+#include "SkHalf.h"
+
+void SkHalfToFloatRow_F16C(float dst[], const SkHalf src[], int count);
+void SkFloatToHalfRow_F16C(SkHalf dst[], const float src[], int count);
+
+#endif
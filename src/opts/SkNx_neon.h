@@ -297,6 +297,12 @@ public:
             || vgetq_lane_u32(v,2) || vgetq_lane_u32(v,3);
     }
 
+    SkNf thenElse(const SkNf& t, const SkNf& e) const {
+        return vreinterpretq_f32_u32(vbslq_u32(vreinterpretq_u32_f32(fVec),
+                                               vreinterpretq_u32_f32(t.fVec),
+                                               vreinterpretq_u32_f32(e.fVec)));
+    }
+
     float32x4_t fVec;
 };
 
@@ -362,6 +368,7 @@ public:
     SkNi operator - (const SkNi& o) const { return vsubq_u8(fVec, o.fVec); }
 
     static SkNi Min(const SkNi& a, const SkNi& b) { return vminq_u8(a.fVec, b.fVec); }
+    static SkNi Max(const SkNi& a, const SkNi& b) { return vmaxq_u8(a.fVec, b.fVec); }
     SkNi operator < (const SkNi& o) const { return vcltq_u8(fVec, o.fVec); }
 
     template <int k> uint8_t kth() const {
@@ -193,6 +193,11 @@ public:
     bool allTrue() const { return 0xffff == _mm_movemask_epi8(_mm_castps_si128(fVec)); }
     bool anyTrue() const { return 0x0000 != _mm_movemask_epi8(_mm_castps_si128(fVec)); }
 
+    SkNf thenElse(const SkNf& t, const SkNf& e) const {
+        return _mm_or_ps(_mm_and_ps   (fVec, t.fVec),
+                         _mm_andnot_ps(fVec, e.fVec));
+    }
+
     __m128 fVec;
 };
 
@@ -287,6 +292,7 @@ public:
     SkNi operator - (const SkNi& o) const { return _mm_sub_epi8(fVec, o.fVec); }
 
     static SkNi Min(const SkNi& a, const SkNi& b) { return _mm_min_epu8(a.fVec, b.fVec); }
+    static SkNi Max(const SkNi& a, const SkNi& b) { return _mm_max_epu8(a.fVec, b.fVec); }
     SkNi operator < (const SkNi& o) const {
         // There's no unsigned _mm_cmplt_epu8, so we flip the sign bits then use a signed compare.
         auto flip = _mm_set1_epi8(char(0x80));
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSwizzler_opts_DEFINED
+#define SkSwizzler_opts_DEFINED
+
+#include "SkSwizzler.h"
+
+/*
+ *  The swizzles that may have platform-specific implementations.  These are
+ *  the dominant conversions performed by the codecs.
+ */
+enum SkSwizzlerProcType {
+    // Also used for 3 byte per pixel kRGB sources (deltaSrc distinguishes).
+    kRGBX_To_N32_SwizzlerProcType,
+    kRGBA_To_N32_Premul_SwizzlerProcType,
+    kRGBA_To_N32_Premul_SkipZ_SwizzlerProcType,
+    kRGBA_To_N32_Unpremul_SwizzlerProcType,
+    kGray_To_N32_SwizzlerProcType,
+};
+
+/*
+ *  Returns a platform-specific proc for the requested swizzle, or NULL if
+ *  there is none, in which case the caller uses the portable version.
+ */
+SkSwizzler::RowProc SkSwizzlerGetPlatformProc(SkSwizzlerProcType type);
+
+#endif // SkSwizzler_opts_DEFINED
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSwizzler_opts_SSSE3.h"
+#include "SkCodecPriv.h"
+#include "SkColorPriv.h"
+
+#include <tmmintrin.h>
+
+// The byte within an SkPMColor that holds each component, in memory order.
+#define R_BYTE (SK_R32_SHIFT / 8)
+#define G_BYTE (SK_G32_SHIFT / 8)
+#define B_BYTE (SK_B32_SHIFT / 8)
+#define A_BYTE (SK_A32_SHIFT / 8)
+
+// pshufb control byte selecting the source for output byte j of output pixel
+// p, given the component offsets within a source pixel and the source bytes
+// per pixel.  Passing a negative alpha offset zeroes the alpha bytes (pshufb
+// zeroes output bytes whose control byte has the high bit set).
+#define SHUF(p, j, ro, go, bo, ao, bpp)                       \
+    ((j) == R_BYTE ? (char) ((p) * (bpp) + (ro)) :            \
+     (j) == G_BYTE ? (char) ((p) * (bpp) + (go)) :            \
+     (j) == B_BYTE ? (char) ((p) * (bpp) + (bo)) :            \
+     (ao) < 0      ? (char) 0x80                              \
+                   : (char) ((p) * (bpp) + (ao)))
+
+#define SHUF_PIXEL(p, ro, go, bo, ao, bpp)                    \
+    SHUF(p, 0, ro, go, bo, ao, bpp),                          \
+    SHUF(p, 1, ro, go, bo, ao, bpp),                          \
+    SHUF(p, 2, ro, go, bo, ao, bpp),                          \
+    SHUF(p, 3, ro, go, bo, ao, bpp)
+
+#define SHUF_4_PIXELS(ro, go, bo, ao, bpp)                    \
+    _mm_setr_epi8(SHUF_PIXEL(0, ro, go, bo, ao, bpp),         \
+                  SHUF_PIXEL(1, ro, go, bo, ao, bpp),         \
+                  SHUF_PIXEL(2, ro, go, bo, ao, bpp),         \
+                  SHUF_PIXEL(3, ro, go, bo, ao, bpp))
+
+// Replicates the alpha byte of each N32 pixel into its r, g and b bytes and
+// zeroes the alpha byte, used to build the premultiply multiplier.
+#define SPLAT(p, j) ((j) == A_BYTE ? (char) 0x80 : (char) ((p) * 4 + A_BYTE))
+#define SPLAT_PIXEL(p) SPLAT(p, 0), SPLAT(p, 1), SPLAT(p, 2), SPLAT(p, 3)
+
+static inline __m128i alpha_splat_mask() {
+    return _mm_setr_epi8(SPLAT_PIXEL(0), SPLAT_PIXEL(1), SPLAT_PIXEL(2), SPLAT_PIXEL(3));
+}
+
+static inline __m128i opaque_alpha_mask() {
+    return _mm_set1_epi32(0xFF << SK_A32_SHIFT);
+}
+
+// Reduces the accumulated OR/AND of four N32 pixels to a single pixel.
+static inline uint32_t reduce_or(__m128i v) {
+    v = _mm_or_si128(v, _mm_srli_si128(v, 8));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 4));
+    return (uint32_t) _mm_cvtsi128_si32(v);
+}
+
+static inline uint32_t reduce_and(__m128i v) {
+    v = _mm_and_si128(v, _mm_srli_si128(v, 8));
+    v = _mm_and_si128(v, _mm_srli_si128(v, 4));
+    return (uint32_t) _mm_cvtsi128_si32(v);
+}
+
+// Rounding multiply of 16 bit color lanes by 16 bit alpha lanes, matching
+// SkMulDiv255Round.
+static inline __m128i mul_div255_round(__m128i color, __m128i alpha) {
+    __m128i prod = _mm_mullo_epi16(color, alpha);
+    prod = _mm_add_epi16(prod, _mm_set1_epi16(128));
+    prod = _mm_add_epi16(prod, _mm_srli_epi16(prod, 8));
+    return _mm_srli_epi16(prod, 8);
+}
+
+SkSwizzler::ResultAlpha swizzle_rgbx_to_n32_SSSE3(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+
+    SkPMColor* SK_RESTRICT dst = (SkPMColor*) dstRow;
+    const __m128i opaque = opaque_alpha_mask();
+    int x = 0;
+    if (4 == deltaSrc) {
+        const __m128i ctl = SHUF_4_PIXELS(0, 1, 2, -1, 4);
+        for (; x + 4 <= width; x += 4) {
+            __m128i pixels = _mm_loadu_si128((const __m128i*) src);
+            pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, ctl), opaque);
+            _mm_storeu_si128((__m128i*) (dst + x), pixels);
+            src += 16;
+        }
+    } else {
+        SkASSERT(3 == deltaSrc);
+        const __m128i ctl = SHUF_4_PIXELS(0, 1, 2, -1, 3);
+        // The 16 byte load consumes more than the 12 bytes of the four pixels
+        // being swizzled, so stop early enough that it cannot read past the
+        // end of the row.
+        for (; x + 6 <= width; x += 4) {
+            __m128i pixels = _mm_loadu_si128((const __m128i*) src);
+            pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, ctl), opaque);
+            _mm_storeu_si128((__m128i*) (dst + x), pixels);
+            src += 12;
+        }
+    }
+    for (; x < width; x++) {
+        dst[x] = SkPackARGB32(0xFF, src[0], src[1], src[2]);
+        src += deltaSrc;
+    }
+    return SkSwizzler::kOpaque_ResultAlpha;
+}
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_unpremul_SSSE3(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+
+    uint32_t* SK_RESTRICT dst = (uint32_t*) dstRow;
+    INIT_RESULT_ALPHA;
+    const __m128i ctl = SHUF_4_PIXELS(0, 1, 2, 3, 4);
+    __m128i accOr = _mm_setzero_si128();
+    __m128i accAnd = _mm_set1_epi32(~0);
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i*) src);
+        pixels = _mm_shuffle_epi8(pixels, ctl);
+        accOr = _mm_or_si128(accOr, pixels);
+        accAnd = _mm_and_si128(accAnd, pixels);
+        _mm_storeu_si128((__m128i*) (dst + x), pixels);
+        src += 16;
+    }
+    zeroAlpha |= (uint8_t) (reduce_or(accOr) >> SK_A32_SHIFT);
+    maxAlpha  &= (uint8_t) (reduce_and(accAnd) >> SK_A32_SHIFT);
+    for (; x < width; x++) {
+        unsigned alpha = src[3];
+        UPDATE_RESULT_ALPHA(alpha);
+        dst[x] = SkPackARGB32NoCheck(alpha, src[0], src[1], src[2]);
+        src += deltaSrc;
+    }
+    return COMPUTE_RESULT_ALPHA;
+}
+
+// Shared body of the premul swizzles.  When skipZ is set, vectors whose four
+// destination pixels are all zero are not stored, leaving zero initialized
+// destination pages untouched.
+static inline SkSwizzler::ResultAlpha swizzle_rgba_premul(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, bool skipZ) {
+
+    SkPMColor* SK_RESTRICT dst = (SkPMColor*) dstRow;
+    INIT_RESULT_ALPHA;
+    const __m128i ctl = SHUF_4_PIXELS(0, 1, 2, 3, 4);
+    const __m128i splat = alpha_splat_mask();
+    const __m128i opaque = opaque_alpha_mask();
+    const __m128i zero = _mm_setzero_si128();
+    __m128i accOr = _mm_setzero_si128();
+    __m128i accAnd = _mm_set1_epi32(~0);
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i*) src);
+        src += 16;
+        pixels = _mm_shuffle_epi8(pixels, ctl);
+        accOr = _mm_or_si128(accOr, pixels);
+        accAnd = _mm_and_si128(accAnd, pixels);
+
+        // The multiplier has each pixel's alpha in its r, g and b bytes and
+        // 0xFF in its alpha byte, so the alpha channel is left as is.
+        __m128i mul = _mm_or_si128(_mm_shuffle_epi8(pixels, splat), opaque);
+        __m128i lo = mul_div255_round(_mm_unpacklo_epi8(pixels, zero),
+                                      _mm_unpacklo_epi8(mul, zero));
+        __m128i hi = mul_div255_round(_mm_unpackhi_epi8(pixels, zero),
+                                      _mm_unpackhi_epi8(mul, zero));
+        pixels = _mm_packus_epi16(lo, hi);
+
+        if (skipZ &&
+                0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero))) {
+            continue;
+        }
+        _mm_storeu_si128((__m128i*) (dst + x), pixels);
+    }
+    zeroAlpha |= (uint8_t) (reduce_or(accOr) >> SK_A32_SHIFT);
+    maxAlpha  &= (uint8_t) (reduce_and(accAnd) >> SK_A32_SHIFT);
+    for (; x < width; x++) {
+        unsigned alpha = src[3];
+        UPDATE_RESULT_ALPHA(alpha);
+        if (!skipZ || 0 != alpha) {
+            dst[x] = SkPreMultiplyARGB(alpha, src[0], src[1], src[2]);
+        }
+        src += deltaSrc;
+    }
+    return COMPUTE_RESULT_ALPHA;
+}
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_premul_SSSE3(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+    return swizzle_rgba_premul(dstRow, src, width, deltaSrc, false);
+}
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_premul_skipZ_SSSE3(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+    return swizzle_rgba_premul(dstRow, src, width, deltaSrc, true);
+}
+
+SkSwizzler::ResultAlpha swizzle_gray_to_n32_SSSE3(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+
+    SkPMColor* SK_RESTRICT dst = (SkPMColor*) dstRow;
+    const __m128i opaque = opaque_alpha_mask();
+    // Each control expands four of the sixteen loaded gray bytes into pixels.
+    // Adding four to a control byte moves to the next group; the 0x80 alpha
+    // slots keep their high bit set, so they continue to read as zero.
+    const __m128i ctl0 = SHUF_4_PIXELS(0, 0, 0, -1, 1);
+    const __m128i ctl1 = _mm_add_epi8(ctl0, _mm_set1_epi8(4));
+    const __m128i ctl2 = _mm_add_epi8(ctl1, _mm_set1_epi8(4));
+    const __m128i ctl3 = _mm_add_epi8(ctl2, _mm_set1_epi8(4));
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i grays = _mm_loadu_si128((const __m128i*) (src + x));
+        _mm_storeu_si128((__m128i*) (dst + x),
+                _mm_or_si128(_mm_shuffle_epi8(grays, ctl0), opaque));
+        _mm_storeu_si128((__m128i*) (dst + x + 4),
+                _mm_or_si128(_mm_shuffle_epi8(grays, ctl1), opaque));
+        _mm_storeu_si128((__m128i*) (dst + x + 8),
+                _mm_or_si128(_mm_shuffle_epi8(grays, ctl2), opaque));
+        _mm_storeu_si128((__m128i*) (dst + x + 12),
+                _mm_or_si128(_mm_shuffle_epi8(grays, ctl3), opaque));
+    }
+    for (; x < width; x++) {
+        dst[x] = SkPackARGB32NoCheck(0xFF, src[x], src[x], src[x]);
+    }
+    return SkSwizzler::kOpaque_ResultAlpha;
+}
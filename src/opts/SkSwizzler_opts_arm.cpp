@@ -0,0 +1,39 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSwizzler_opts.h"
+#include "SkUtilsArm.h"
+
+#if !SK_ARM_NEON_IS_NONE
+#include "SkSwizzler_opts_neon.h"
+#endif
+
+SkSwizzler::RowProc SkSwizzlerGetPlatformProc(SkSwizzlerProcType type) {
+#if SK_ARM_NEON_IS_NONE
+    return NULL;
+#else
+#if SK_ARM_NEON_IS_DYNAMIC
+    if (!sk_cpu_arm_has_neon()) {
+        return NULL;
+    }
+#endif
+    switch (type) {
+        case kRGBX_To_N32_SwizzlerProcType:
+            return swizzle_rgbx_to_n32_neon;
+        case kRGBA_To_N32_Premul_SwizzlerProcType:
+            return swizzle_rgba_to_n32_premul_neon;
+        case kRGBA_To_N32_Premul_SkipZ_SwizzlerProcType:
+            return swizzle_rgba_to_n32_premul_skipZ_neon;
+        case kRGBA_To_N32_Unpremul_SwizzlerProcType:
+            return swizzle_rgba_to_n32_unpremul_neon;
+        case kGray_To_N32_SwizzlerProcType:
+            return swizzle_gray_to_n32_neon;
+        default:
+            return NULL;
+    }
+#endif
+}
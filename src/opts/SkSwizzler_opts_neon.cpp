@@ -0,0 +1,181 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSwizzler_opts_neon.h"
+#include "SkCodecPriv.h"
+#include "SkColorPriv.h"
+
+#include <arm_neon.h>
+
+// The lane of a vst4 that lands in the byte holding each component of an
+// SkPMColor in memory.
+#define R_LANE (SK_R32_SHIFT / 8)
+#define G_LANE (SK_G32_SHIFT / 8)
+#define B_LANE (SK_B32_SHIFT / 8)
+#define A_LANE (SK_A32_SHIFT / 8)
+
+// Reduces the accumulated OR/AND of eight alpha values to one.
+static inline uint8_t reduce_or(uint8x8_t v) {
+    v = vorr_u8(v, vext_u8(v, v, 4));
+    v = vorr_u8(v, vext_u8(v, v, 2));
+    v = vorr_u8(v, vext_u8(v, v, 1));
+    return vget_lane_u8(v, 0);
+}
+
+static inline uint8_t reduce_and(uint8x8_t v) {
+    v = vand_u8(v, vext_u8(v, v, 4));
+    v = vand_u8(v, vext_u8(v, v, 2));
+    v = vand_u8(v, vext_u8(v, v, 1));
+    return vget_lane_u8(v, 0);
+}
+
+// Rounding multiply of eight color bytes by eight alpha bytes, matching
+// SkMulDiv255Round.
+static inline uint8x8_t mul_div255_round(uint8x8_t color, uint8x8_t alpha) {
+    uint16x8_t prod = vmull_u8(color, alpha);
+    prod = vaddq_u16(prod, vdupq_n_u16(128));
+    prod = vaddq_u16(prod, vshrq_n_u16(prod, 8));
+    return vshrn_n_u16(prod, 8);
+}
+
+SkSwizzler::ResultAlpha swizzle_rgbx_to_n32_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+
+    SkPMColor* SK_RESTRICT dst = (SkPMColor*) dstRow;
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        uint8x8x3_t rgb;
+        if (4 == deltaSrc) {
+            const uint8x8x4_t rgbx = vld4_u8(src);
+            rgb.val[0] = rgbx.val[0];
+            rgb.val[1] = rgbx.val[1];
+            rgb.val[2] = rgbx.val[2];
+            src += 32;
+        } else {
+            rgb = vld3_u8(src);
+            src += 24;
+        }
+        uint8x8x4_t pixels;
+        pixels.val[R_LANE] = rgb.val[0];
+        pixels.val[G_LANE] = rgb.val[1];
+        pixels.val[B_LANE] = rgb.val[2];
+        pixels.val[A_LANE] = vdup_n_u8(0xFF);
+        vst4_u8((uint8_t*) (dst + x), pixels);
+    }
+    for (; x < width; x++) {
+        dst[x] = SkPackARGB32(0xFF, src[0], src[1], src[2]);
+        src += deltaSrc;
+    }
+    return SkSwizzler::kOpaque_ResultAlpha;
+}
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_unpremul_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+
+    uint32_t* SK_RESTRICT dst = (uint32_t*) dstRow;
+    INIT_RESULT_ALPHA;
+    uint8x8_t accOr = vdup_n_u8(0);
+    uint8x8_t accAnd = vdup_n_u8(0xFF);
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const uint8x8x4_t rgba = vld4_u8(src);
+        src += 32;
+        accOr = vorr_u8(accOr, rgba.val[3]);
+        accAnd = vand_u8(accAnd, rgba.val[3]);
+        uint8x8x4_t pixels;
+        pixels.val[R_LANE] = rgba.val[0];
+        pixels.val[G_LANE] = rgba.val[1];
+        pixels.val[B_LANE] = rgba.val[2];
+        pixels.val[A_LANE] = rgba.val[3];
+        vst4_u8((uint8_t*) (dst + x), pixels);
+    }
+    zeroAlpha |= reduce_or(accOr);
+    maxAlpha  &= reduce_and(accAnd);
+    for (; x < width; x++) {
+        unsigned alpha = src[3];
+        UPDATE_RESULT_ALPHA(alpha);
+        dst[x] = SkPackARGB32NoCheck(alpha, src[0], src[1], src[2]);
+        src += deltaSrc;
+    }
+    return COMPUTE_RESULT_ALPHA;
+}
+
+// Shared body of the premul swizzles.  When skipZ is set, groups of eight
+// pixels that are entirely transparent are not stored, leaving zero
+// initialized destination pages untouched.
+static inline SkSwizzler::ResultAlpha swizzle_rgba_premul(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, bool skipZ) {
+
+    SkPMColor* SK_RESTRICT dst = (SkPMColor*) dstRow;
+    INIT_RESULT_ALPHA;
+    uint8x8_t accOr = vdup_n_u8(0);
+    uint8x8_t accAnd = vdup_n_u8(0xFF);
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const uint8x8x4_t rgba = vld4_u8(src);
+        src += 32;
+        const uint8x8_t alpha = rgba.val[3];
+        accOr = vorr_u8(accOr, alpha);
+        accAnd = vand_u8(accAnd, alpha);
+        if (skipZ && 0 == reduce_or(alpha)) {
+            continue;
+        }
+        uint8x8x4_t pixels;
+        pixels.val[R_LANE] = mul_div255_round(rgba.val[0], alpha);
+        pixels.val[G_LANE] = mul_div255_round(rgba.val[1], alpha);
+        pixels.val[B_LANE] = mul_div255_round(rgba.val[2], alpha);
+        pixels.val[A_LANE] = alpha;
+        vst4_u8((uint8_t*) (dst + x), pixels);
+    }
+    zeroAlpha |= reduce_or(accOr);
+    maxAlpha  &= reduce_and(accAnd);
+    for (; x < width; x++) {
+        unsigned alpha = src[3];
+        UPDATE_RESULT_ALPHA(alpha);
+        if (!skipZ || 0 != alpha) {
+            dst[x] = SkPreMultiplyARGB(alpha, src[0], src[1], src[2]);
+        }
+        src += deltaSrc;
+    }
+    return COMPUTE_RESULT_ALPHA;
+}
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_premul_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+    return swizzle_rgba_premul(dstRow, src, width, deltaSrc, false);
+}
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_premul_skipZ_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+    return swizzle_rgba_premul(dstRow, src, width, deltaSrc, true);
+}
+
+SkSwizzler::ResultAlpha swizzle_gray_to_n32_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]) {
+
+    SkPMColor* SK_RESTRICT dst = (SkPMColor*) dstRow;
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const uint8x8_t gray = vld1_u8(src + x);
+        uint8x8x4_t pixels;
+        pixels.val[R_LANE] = gray;
+        pixels.val[G_LANE] = gray;
+        pixels.val[B_LANE] = gray;
+        pixels.val[A_LANE] = vdup_n_u8(0xFF);
+        vst4_u8((uint8_t*) (dst + x), pixels);
+    }
+    for (; x < width; x++) {
+        dst[x] = SkPackARGB32NoCheck(0xFF, src[x], src[x], src[x]);
+    }
+    return SkSwizzler::kOpaque_ResultAlpha;
+}
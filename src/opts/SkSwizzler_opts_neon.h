@@ -0,0 +1,33 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSwizzler_opts_neon_DEFINED
+#define SkSwizzler_opts_neon_DEFINED
+
+#include "SkSwizzler.h"
+
+SkSwizzler::ResultAlpha swizzle_rgbx_to_n32_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]);
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_premul_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]);
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_premul_skipZ_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]);
+
+SkSwizzler::ResultAlpha swizzle_rgba_to_n32_unpremul_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]);
+
+SkSwizzler::ResultAlpha swizzle_gray_to_n32_neon(
+        void* SK_RESTRICT dstRow, const uint8_t* SK_RESTRICT src, int width,
+        int deltaSrc, int y, const SkPMColor ctable[]);
+
+#endif // SkSwizzler_opts_neon_DEFINED
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2015 The Android Open Source Project
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkUtils_opts_AVX2.h"
+
+// Some compilers can't compile AVX2 intrinsics.  We give them stub methods.
+// The stubs should never be called, so we make them crash just to confirm that.
+#if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+void sk_memset16_AVX2(uint16_t*, uint16_t, int) {
+    sk_throw();
+}
+void sk_memset32_AVX2(uint32_t*, uint32_t, int) {
+    sk_throw();
+}
+
+#else
+
+#include <immintrin.h>      // AVX2 intrinsics
+
+// Fills at least this many bytes are unlikely to be re-read before they would
+// have been evicted anyway, so they use non-temporal stores rather than
+// flushing useful data out of the caches. Roughly half a typical
+// last-level-cache slice.
+enum {
+    kNonTemporalFillBytes = 512 * 1024,
+};
+
+void sk_memset16_AVX2(uint16_t *dst, uint16_t value, int count)
+{
+    SkASSERT(dst != NULL && count >= 0);
+
+    // dst must be 2-byte aligned.
+    SkASSERT((((size_t) dst) & 0x01) == 0);
+
+    if (count >= 64) {
+        while (((size_t)dst) & 0x1F) {
+            *dst++ = value;
+            --count;
+        }
+        __m256i *d = reinterpret_cast<__m256i*>(dst);
+        __m256i value_wide = _mm256_set1_epi16(value);
+        if (count * sizeof(uint16_t) >= kNonTemporalFillBytes) {
+            while (count >= 64) {
+                _mm256_stream_si256(d    , value_wide);
+                _mm256_stream_si256(d + 1, value_wide);
+                _mm256_stream_si256(d + 2, value_wide);
+                _mm256_stream_si256(d + 3, value_wide);
+                d += 4;
+                count -= 64;
+            }
+            _mm_sfence();
+        } else {
+            while (count >= 64) {
+                _mm256_store_si256(d    , value_wide);
+                _mm256_store_si256(d + 1, value_wide);
+                _mm256_store_si256(d + 2, value_wide);
+                _mm256_store_si256(d + 3, value_wide);
+                d += 4;
+                count -= 64;
+            }
+        }
+        dst = reinterpret_cast<uint16_t*>(d);
+    }
+    while (count > 0) {
+        *dst++ = value;
+        --count;
+    }
+}
+
+void sk_memset32_AVX2(uint32_t *dst, uint32_t value, int count)
+{
+    SkASSERT(dst != NULL && count >= 0);
+
+    // dst must be 4-byte aligned.
+    SkASSERT((((size_t) dst) & 0x03) == 0);
+
+    if (count >= 32) {
+        while (((size_t)dst) & 0x1F) {
+            *dst++ = value;
+            --count;
+        }
+        __m256i *d = reinterpret_cast<__m256i*>(dst);
+        __m256i value_wide = _mm256_set1_epi32(value);
+        if (count * sizeof(uint32_t) >= kNonTemporalFillBytes) {
+            while (count >= 32) {
+                _mm256_stream_si256(d    , value_wide);
+                _mm256_stream_si256(d + 1, value_wide);
+                _mm256_stream_si256(d + 2, value_wide);
+                _mm256_stream_si256(d + 3, value_wide);
+                d += 4;
+                count -= 32;
+            }
+            _mm_sfence();
+        } else {
+            while (count >= 32) {
+                _mm256_store_si256(d    , value_wide);
+                _mm256_store_si256(d + 1, value_wide);
+                _mm256_store_si256(d + 2, value_wide);
+                _mm256_store_si256(d + 3, value_wide);
+                d += 4;
+                count -= 32;
+            }
+        }
+        dst = reinterpret_cast<uint32_t*>(d);
+    }
+    while (count > 0) {
+        *dst++ = value;
+        --count;
+    }
+}
+
+#endif
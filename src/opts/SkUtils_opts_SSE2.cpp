@@ -8,6 +8,14 @@
 #include <emmintrin.h>
 #include "SkUtils_opts_SSE2.h"
 
+// Fills at least this many bytes are unlikely to be re-read before they would
+// have been evicted anyway, so they use non-temporal stores rather than
+// flushing useful data out of the caches. Roughly half a typical
+// last-level-cache slice.
+enum {
+    kNonTemporalFillBytes = 512 * 1024,
+};
+
 void sk_memset16_SSE2(uint16_t *dst, uint16_t value, int count)
 {
     SkASSERT(dst != NULL && count >= 0);
@@ -22,13 +30,25 @@ void sk_memset16_SSE2(uint16_t *dst, uint16_t value, int count)
         }
         __m128i *d = reinterpret_cast<__m128i*>(dst);
         __m128i value_wide = _mm_set1_epi16(value);
-        while (count >= 32) {
-            _mm_store_si128(d    , value_wide);
-            _mm_store_si128(d + 1, value_wide);
-            _mm_store_si128(d + 2, value_wide);
-            _mm_store_si128(d + 3, value_wide);
-            d += 4;
-            count -= 32;
+        if (count * sizeof(uint16_t) >= kNonTemporalFillBytes) {
+            while (count >= 32) {
+                _mm_stream_si128(d    , value_wide);
+                _mm_stream_si128(d + 1, value_wide);
+                _mm_stream_si128(d + 2, value_wide);
+                _mm_stream_si128(d + 3, value_wide);
+                d += 4;
+                count -= 32;
+            }
+            _mm_sfence();
+        } else {
+            while (count >= 32) {
+                _mm_store_si128(d    , value_wide);
+                _mm_store_si128(d + 1, value_wide);
+                _mm_store_si128(d + 2, value_wide);
+                _mm_store_si128(d + 3, value_wide);
+                d += 4;
+                count -= 32;
+            }
         }
         dst = reinterpret_cast<uint16_t*>(d);
     }
@@ -52,13 +72,25 @@ void sk_memset32_SSE2(uint32_t *dst, uint32_t value, int count)
         }
         __m128i *d = reinterpret_cast<__m128i*>(dst);
         __m128i value_wide = _mm_set1_epi32(value);
-        while (count >= 16) {
-            _mm_store_si128(d    , value_wide);
-            _mm_store_si128(d + 1, value_wide);
-            _mm_store_si128(d + 2, value_wide);
-            _mm_store_si128(d + 3, value_wide);
-            d += 4;
-            count -= 16;
+        if (count * sizeof(uint32_t) >= kNonTemporalFillBytes) {
+            while (count >= 16) {
+                _mm_stream_si128(d    , value_wide);
+                _mm_stream_si128(d + 1, value_wide);
+                _mm_stream_si128(d + 2, value_wide);
+                _mm_stream_si128(d + 3, value_wide);
+                d += 4;
+                count -= 16;
+            }
+            _mm_sfence();
+        } else {
+            while (count >= 16) {
+                _mm_store_si128(d    , value_wide);
+                _mm_store_si128(d + 1, value_wide);
+                _mm_store_si128(d + 2, value_wide);
+                _mm_store_si128(d + 3, value_wide);
+                d += 4;
+                count -= 16;
+            }
         }
         dst = reinterpret_cast<uint32_t*>(d);
     }
@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "SkChecksum.h"
+#include "SkHalf.h"
 #include "SkUtils.h"
 #include "SkUtilsArm.h"
 
@@ -34,3 +36,19 @@ SkMemset32Proc SkMemset32GetPlatformProc() {
 SkMemcpy32Proc SkMemcpy32GetPlatformProc() {
     return NULL;
 }
+
+SkChecksumHashProc SkChecksumHashGetPlatformProc() {
+    // ARMv7 has no CRC32 extension (that arrived with ARMv8), so fall back
+    // to the portable hash.
+    return NULL;
+}
+
+SkHalfToFloatRowProc SkHalfToFloatRowGetPlatformProc() {
+    // NEON vcvt.f32.f16 needs the half-precision extension, which our ARMv7
+    // baseline doesn't guarantee, so fall back to the portable converters.
+    return NULL;
+}
+
+SkFloatToHalfRowProc SkFloatToHalfRowGetPlatformProc() {
+    return NULL;
+}
@@ -7,6 +7,8 @@
  */
 
 
+#include "SkChecksum.h"
+#include "SkHalf.h"
 #include "SkUtils.h"
 
 SkMemset16Proc SkMemset16GetPlatformProc() {
@@ -20,3 +22,15 @@ SkMemset32Proc SkMemset32GetPlatformProc() {
 SkMemcpy32Proc SkMemcpy32GetPlatformProc() {
     return NULL;
 }
+
+SkChecksumHashProc SkChecksumHashGetPlatformProc() {
+    return NULL;
+}
+
+SkHalfToFloatRowProc SkHalfToFloatRowGetPlatformProc() {
+    return NULL;
+}
+
+SkFloatToHalfRowProc SkFloatToHalfRowGetPlatformProc() {
+    return NULL;
+}
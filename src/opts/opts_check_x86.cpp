@@ -12,14 +12,23 @@
 #include "SkBlitMask.h"
 #include "SkBlitRow.h"
 #include "SkBlitRow_opts_SSE2.h"
+#include "SkBlitRow_opts_AVX2.h"
 #include "SkBlitRow_opts_SSE4.h"
+#include "SkBlurImage_opts_AVX2.h"
 #include "SkBlurImage_opts_SSE2.h"
 #include "SkBlurImage_opts_SSE4.h"
+#include "SkChecksum.h"
+#include "SkChecksum_opts_SSE42.h"
+#include "SkHalf.h"
+#include "SkHalf_opts_F16C.h"
 #include "SkLazyPtr.h"
 #include "SkMorphology_opts.h"
 #include "SkMorphology_opts_SSE2.h"
 #include "SkRTConf.h"
+#include "SkSwizzler_opts.h"
+#include "SkSwizzler_opts_SSSE3.h"
 #include "SkUtils.h"
+#include "SkUtils_opts_AVX2.h"
 #include "SkUtils_opts_SSE2.h"
 #include "SkXfermode.h"
 #include "SkXfermode_proccoeff.h"
@@ -74,11 +83,70 @@ static inline void getcpuid(int info_type, int info[4]) {
 }
 #endif
 
+/* cpuid leaf 7 (with ecx == 0) carries the AVX2 bit. */
+#ifdef _MSC_VER
+static inline void getcpuid7(int info[4]) {
+#if defined(_WIN64)
+    __cpuidex(info, 7, 0);
+#else
+    __asm {
+        mov    eax, 7
+        mov    ecx, 0
+        cpuid
+        mov    edi, [info]
+        mov    [edi], eax
+        mov    [edi+4], ebx
+        mov    [edi+8], ecx
+        mov    [edi+12], edx
+    }
+#endif
+}
+static inline uint64_t xgetbv(uint32_t xcr) {
+    return _xgetbv(xcr);
+}
+#elif defined(__x86_64__)
+static inline void getcpuid7(int info[4]) {
+    asm volatile (
+        "cpuid \n\t"
+        : "=a"(info[0]), "=b"(info[1]), "=c"(info[2]), "=d"(info[3])
+        : "a"(7), "c"(0)
+    );
+}
+static inline uint64_t xgetbv(uint32_t xcr) {
+    uint32_t eax, edx;
+    // Spelled as bytes so this assembles with toolchains that predate xgetbv.
+    asm volatile (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(xcr));
+    return (uint64_t)edx << 32 | eax;
+}
+#else
+static inline void getcpuid7(int info[4]) {
+    asm volatile (
+        "pushl %%ebx      \n\t"
+        "cpuid            \n\t"
+        "movl %%ebx, %1   \n\t"
+        "popl %%ebx       \n\t"
+        : "=a"(info[0]), "=r"(info[1]), "=c"(info[2]), "=d"(info[3])
+        : "a"(7), "c"(0)
+    );
+}
+static inline uint64_t xgetbv(uint32_t xcr) {
+    uint32_t eax, edx;
+    asm volatile (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(xcr));
+    return (uint64_t)edx << 32 | eax;
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /* Fetch the SIMD level directly from the CPU, at run-time.
  * Only checks the levels needed by the optimizations in this file.
  */
+// Caps the SIMD tier we report at runtime, so a fleet can fall back to (say) SSE2 blitters
+// from a config file when chasing a suspect kernel.  Only caps runtime *detection*: procs the
+// build already assumes via SK_CPU_SSE_LEVEL are unaffected.
+SK_CONF_DECLARE(int, c_simdLevelCap, "options.simdLevelCap", 0,
+                "Cap the detected x86 SIMD level at this SK_CPU_SSE_LEVEL value; 0 = no cap");
+
 namespace {  // get_SIMD_level() technically must have external linkage, so no static.
 int* get_SIMD_level() {
     int cpu_info[4] = { 0, 0, 0, 0 };
@@ -86,7 +154,20 @@ int* get_SIMD_level() {
 
     int* level = SkNEW(int);
 
-    if ((cpu_info[2] & (1<<20)) != 0) {
+    // AVX2 needs the AVX2 cpuid bit, plus OS support for saving the ymm
+    // registers (OSXSAVE set and XCR0 reporting xmm+ymm state enabled).
+    bool avx2 = false;
+    if ((cpu_info[2] & (1<<28)) != 0 &&         // AVX
+        (cpu_info[2] & (1<<27)) != 0) {         // OSXSAVE
+        int cpu_info7[4] = { 0, 0, 0, 0 };
+        getcpuid7(cpu_info7);
+        avx2 = (cpu_info7[1] & (1<<5)) != 0 &&  // AVX2
+               (xgetbv(0) & 6) == 6;            // xmm and ymm state enabled
+    }
+
+    if (avx2) {
+        *level = SK_CPU_SSE_LEVEL_AVX2;
+    } else if ((cpu_info[2] & (1<<20)) != 0) {
         *level = SK_CPU_SSE_LEVEL_SSE42;
     } else if ((cpu_info[2] & (1<<19)) != 0) {
         *level = SK_CPU_SSE_LEVEL_SSE41;
@@ -97,11 +178,31 @@ int* get_SIMD_level() {
     } else {
         *level = 0;
     }
+    if (c_simdLevelCap > 0 && *level > c_simdLevelCap) {
+        *level = c_simdLevelCap;
+    }
     return level;
 }
 } // namespace
 
+namespace {  // see get_SIMD_level() above for why this isn't static.
+bool* get_has_f16c() {
+    int cpu_info[4] = { 0, 0, 0, 0 };
+    getcpuid(1, cpu_info);
+
+    bool* has = SkNEW(bool);
+    // F16C instructions are VEX encoded, so like AVX they need the OS to have
+    // enabled saving the ymm registers.
+    *has = (cpu_info[2] & (1<<29)) != 0 &&  // F16C
+           (cpu_info[2] & (1<<28)) != 0 &&  // AVX
+           (cpu_info[2] & (1<<27)) != 0 &&  // OSXSAVE
+           (xgetbv(0) & 6) == 6;            // xmm and ymm state enabled
+    return has;
+}
+} // namespace
+
 SK_DECLARE_STATIC_LAZY_PTR(int, gSIMDLevel, get_SIMD_level);
+SK_DECLARE_STATIC_LAZY_PTR(bool, gHasF16C, get_has_f16c);
 
 /* Verify that the requested SIMD level is supported in the build.
  * If not, check if the platform supports it.
@@ -169,6 +270,10 @@ void SkBitmapProcState::platformProcs() {
         if (ssse3) {
             fSampleProc32 = S32_alpha_D32_filter_DXDY_SSSE3;
         }
+    } else if (ssse3 && fSampleProc32 == S16_opaque_D32_filter_DX) {
+        fSampleProc32 = S16_opaque_D32_filter_DX_SSSE3;
+    } else if (ssse3 && fSampleProc32 == S16_alpha_D32_filter_DX) {
+        fSampleProc32 = S16_alpha_D32_filter_DX_SSSE3;
     }
 
     /* Check fSampleProc16 */
@@ -202,9 +307,9 @@ static const SkBlitRow::Proc16 platform_16_procs[] = {
     S32A_D565_Opaque_SSE2,              // S32A_D565_Opaque
     NULL,                               // S32A_D565_Blend
     S32_D565_Opaque_Dither_SSE2,        // S32_D565_Opaque_Dither
-    NULL,                               // S32_D565_Blend_Dither
+    S32_D565_Blend_Dither_SSE2,         // S32_D565_Blend_Dither
     S32A_D565_Opaque_Dither_SSE2,       // S32A_D565_Opaque_Dither
-    NULL,                               // S32A_D565_Blend_Dither
+    S32A_D565_Blend_Dither_SSE2,        // S32A_D565_Blend_Dither
 };
 
 SkBlitRow::Proc16 SkBlitRow::PlatformFactory565(unsigned flags) {
@@ -247,7 +352,24 @@ static const SkBlitRow::Proc32 platform_32_procs_SSE4[] = {
     S32A_Blend_BlitRow32_SSE2,          // S32A_Blend,
 };
 
+static const SkBlitRow::Proc32 platform_32_procs_AVX2[] = {
+    NULL,                               // S32_Opaque,
+    S32_Blend_BlitRow32_AVX2,           // S32_Blend,
+    S32A_Opaque_BlitRow32_AVX2,         // S32A_Opaque
+    S32A_Blend_BlitRow32_SSE2,          // S32A_Blend,
+};
+
+SkBlitRow::Color32Proc SkBlitRow::PlatformColor32Proc() {
+    if (supports_simd(SK_CPU_SSE_LEVEL_AVX2)) {
+        return Color32_AVX2;
+    }
+    return NULL;
+}
+
 SkBlitRow::Proc32 SkBlitRow::PlatformProcs32(unsigned flags) {
+    if (supports_simd(SK_CPU_SSE_LEVEL_AVX2)) {
+        return platform_32_procs_AVX2[flags];
+    } else
     if (supports_simd(SK_CPU_SSE_LEVEL_SSE41)) {
         return platform_32_procs_SSE4[flags];
     } else
@@ -297,14 +419,25 @@ SkBlitMask::BlitLCD16RowProc SkBlitMask::PlatformBlitRowProcs16(bool isOpaque) {
 
 }
 
-SkBlitMask::RowProc SkBlitMask::PlatformRowProcs(SkColorType, SkMask::Format, RowFlags) {
+SkBlitMask::RowProc SkBlitMask::PlatformRowProcs(SkColorType dstCT, SkMask::Format maskFormat,
+                                                 RowFlags flags) {
+    if (kN32_SkColorType == dstCT && SkMask::kLCD16_Format == maskFormat &&
+            supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+        if (flags & kSrcIsOpaque_RowFlag) {
+            return (SkBlitMask::RowProc)SkBlitLCD16OpaquePMSrcRow_SSE2;
+        } else {
+            return (SkBlitMask::RowProc)SkBlitLCD16PMSrcRow_SSE2;
+        }
+    }
     return NULL;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 SkMemset16Proc SkMemset16GetPlatformProc() {
-    if (supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+    if (supports_simd(SK_CPU_SSE_LEVEL_AVX2)) {
+        return sk_memset16_AVX2;
+    } else if (supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
         return sk_memset16_SSE2;
     } else {
         return NULL;
@@ -312,7 +445,9 @@ SkMemset16Proc SkMemset16GetPlatformProc() {
 }
 
 SkMemset32Proc SkMemset32GetPlatformProc() {
-    if (supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
+    if (supports_simd(SK_CPU_SSE_LEVEL_AVX2)) {
+        return sk_memset32_AVX2;
+    } else if (supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
         return sk_memset32_SSE2;
     } else {
         return NULL;
@@ -327,6 +462,22 @@ SkMemcpy32Proc SkMemcpy32GetPlatformProc() {
     }
 }
 
+SkChecksumHashProc SkChecksumHashGetPlatformProc() {
+    if (supports_simd(SK_CPU_SSE_LEVEL_SSE42)) {
+        return SkChecksumHash_SSE42;
+    } else {
+        return NULL;
+    }
+}
+
+SkHalfToFloatRowProc SkHalfToFloatRowGetPlatformProc() {
+    return *gHasF16C.get() ? SkHalfToFloatRow_F16C : NULL;
+}
+
+SkFloatToHalfRowProc SkFloatToHalfRowGetPlatformProc() {
+    return *gHasF16C.get() ? SkFloatToHalfRow_F16C : NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 SkMorphologyImageFilter::Proc SkMorphologyGetPlatformProc(SkMorphologyProcType type) {
@@ -349,10 +500,35 @@ SkMorphologyImageFilter::Proc SkMorphologyGetPlatformProc(SkMorphologyProcType t
 
 ////////////////////////////////////////////////////////////////////////////////
 
+SkSwizzler::RowProc SkSwizzlerGetPlatformProc(SkSwizzlerProcType type) {
+    if (!supports_simd(SK_CPU_SSE_LEVEL_SSSE3)) {
+        return NULL;
+    }
+    switch (type) {
+        case kRGBX_To_N32_SwizzlerProcType:
+            return swizzle_rgbx_to_n32_SSSE3;
+        case kRGBA_To_N32_Premul_SwizzlerProcType:
+            return swizzle_rgba_to_n32_premul_SSSE3;
+        case kRGBA_To_N32_Premul_SkipZ_SwizzlerProcType:
+            return swizzle_rgba_to_n32_premul_skipZ_SSSE3;
+        case kRGBA_To_N32_Unpremul_SwizzlerProcType:
+            return swizzle_rgba_to_n32_unpremul_SSSE3;
+        case kGray_To_N32_SwizzlerProcType:
+            return swizzle_gray_to_n32_SSSE3;
+        default:
+            return NULL;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool SkBoxBlurGetPlatformProcs(SkBoxBlurProc* boxBlurX,
                                SkBoxBlurProc* boxBlurXY,
                                SkBoxBlurProc* boxBlurYX) {
-    if (supports_simd(SK_CPU_SSE_LEVEL_SSE41)) {
+    if (supports_simd(SK_CPU_SSE_LEVEL_AVX2)) {
+        return SkBoxBlurGetPlatformProcs_AVX2(boxBlurX, boxBlurXY, boxBlurYX);
+    }
+    else if (supports_simd(SK_CPU_SSE_LEVEL_SSE41)) {
         return SkBoxBlurGetPlatformProcs_SSE4(boxBlurX, boxBlurXY, boxBlurYX);
     }
     else if (supports_simd(SK_CPU_SSE_LEVEL_SSE2)) {
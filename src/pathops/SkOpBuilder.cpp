@@ -8,6 +8,34 @@
 #include "SkMatrix.h"
 #include "SkPath.h"
 #include "SkPathOps.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
+
+namespace {
+
+/*  Work items for SkTaskGroup. Each Op()/Simplify() call builds its own
+    SkChunkAlloc and global state, so workers share no allocator or
+    intersection bookkeeping. */
+struct SimplifyTask {
+    SkPath* fPath;
+    bool    fFailed;
+};
+
+struct UnionPairTask {
+    SkPath*       fDst;
+    const SkPath* fSrc;
+    bool          fFailed;
+};
+
+void simplify_task(SimplifyTask* task) {
+    task->fFailed = !Simplify(*task->fPath, task->fPath);
+}
+
+void union_pair_task(UnionPairTask* task) {
+    task->fFailed = !Op(*task->fDst, *task->fSrc, kUnion_SkPathOp, task->fDst);
+}
+
+}  // namespace
 
 void SkOpBuilder::add(const SkPath& path, SkPathOp op) {
     if (0 == fOps.count() && op != kUnion_SkPathOp) {
@@ -64,6 +92,46 @@ bool SkOpBuilder::resolve(SkPath* result) {
         }
     }
     if (!allUnion) {
+        bool allUnionOps = true;
+        for (int index = 0; index < count; ++index) {
+            if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+                allUnionOps = false;
+                break;
+            }
+        }
+        if (allUnionOps && count > 2) {
+            // Union is associative, so instead of folding paths into the
+            // accumulated (and ever larger) result one at a time, reduce
+            // pairwise: each round unions disjoint pairs on SkTaskGroup
+            // workers, halving the list.
+            int live = count;
+            while (live > 1) {
+                const int pairs = live / 2;
+                SkAutoSTMalloc<8, UnionPairTask> tasks(pairs);
+                for (int i = 0; i < pairs; ++i) {
+                    tasks[i].fDst = &fPathRefs[2 * i];
+                    tasks[i].fSrc = &fPathRefs[2 * i + 1];
+                    tasks[i].fFailed = false;
+                }
+                SkTaskGroup().batch(union_pair_task, tasks.get(), pairs);
+                for (int i = 0; i < pairs; ++i) {
+                    if (tasks[i].fFailed) {
+                        reset();
+                        *result = original;
+                        return false;
+                    }
+                }
+                // survivors sit at the even slots (plus any odd leftover)
+                int dst = 0;
+                for (int i = 0; i < live; i += 2) {
+                    fPathRefs[dst++] = fPathRefs[i];
+                }
+                live = dst;
+            }
+            *result = fPathRefs[0];
+            reset();
+            return true;
+        }
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
             if (!Op(*result, fPathRefs[index], fOps[index], result)) {
@@ -76,12 +144,23 @@ bool SkOpBuilder::resolve(SkPath* result) {
         return true;
     }
     SkPath sum;
-    for (int index = 0; index < count; ++index) {
-        if (!Simplify(fPathRefs[index], &fPathRefs[index])) {
-            reset();
-            *result = original;
-            return false;
+    {
+        // The per-path simplifies are independent; farm them out.
+        SkAutoSTMalloc<8, SimplifyTask> tasks(count);
+        for (int index = 0; index < count; ++index) {
+            tasks[index].fPath = &fPathRefs[index];
+            tasks[index].fFailed = false;
         }
+        SkTaskGroup().batch(simplify_task, tasks.get(), count);
+        for (int index = 0; index < count; ++index) {
+            if (tasks[index].fFailed) {
+                reset();
+                *result = original;
+                return false;
+            }
+        }
+    }
+    for (int index = 0; index < count; ++index) {
         sum.addPath(fPathRefs[index]);
     }
     reset();
@@ -10,6 +10,7 @@
 #include "SkPathOpsCommon.h"
 #include "SkPathWriter.h"
 #include "SkTSort.h"
+#include "SkThreadArena.h"
 
 const SkOpAngle* AngleWinding(SkOpSpanBase* start, SkOpSpanBase* end, int* windingPtr,
         bool* sortablePtr) {
@@ -196,7 +197,8 @@ public:
         reassemble contour pieces into new path
     */
 void Assemble(const SkPathWriter& path, SkPathWriter* simple) {
-    SkChunkAlloc allocator(4096);  // FIXME: constant-ize, tune
+    SkAutoThreadArena arena(4096);
+    SkChunkAlloc& allocator = *arena;
     SkOpContourHead contour;
     SkOpGlobalState globalState(NULL, &contour);
 #if DEBUG_SHOW_TEST_NAME
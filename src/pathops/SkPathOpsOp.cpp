@@ -9,6 +9,7 @@
 #include "SkOpEdgeBuilder.h"
 #include "SkPathOpsCommon.h"
 #include "SkPathWriter.h"
+#include "SkThreadArena.h"
 
 static SkOpSegment* findChaseOp(SkTDArray<SkOpSpanBase*>& chase, SkOpSpanBase** startPtr,
         SkOpSpanBase** endPtr) {
@@ -224,7 +225,8 @@ static void dump_op(const SkPath& one, const SkPath& two, SkPathOp op) {
 
 bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
         bool expectSuccess) {
-    SkChunkAlloc allocator(4096);  // FIXME: add a constant expression here, tune
+    SkAutoThreadArena arena(4096);
+    SkChunkAlloc& allocator = *arena;
     SkOpContour contour;
     SkOpContourHead* contourList = static_cast<SkOpContourHead*>(&contour);
     SkOpCoincidence coincidence;
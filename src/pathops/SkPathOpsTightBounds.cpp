@@ -6,9 +6,11 @@
  */
 #include "SkOpEdgeBuilder.h"
 #include "SkPathOpsCommon.h"
+#include "SkThreadArena.h"
 
 bool TightBounds(const SkPath& path, SkRect* result) {
-    SkChunkAlloc allocator(4096);  // FIXME: constant-ize, tune
+    SkAutoThreadArena arena(4096);
+    SkChunkAlloc& allocator = *arena;
     SkOpContour contour;
     SkOpContourHead* contourList = static_cast<SkOpContourHead*>(&contour);
     SkOpGlobalState globalState(NULL, contourList);
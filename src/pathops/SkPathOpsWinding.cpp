@@ -23,6 +23,7 @@
 
 #include "SkOpContour.h"
 #include "SkOpSegment.h"
+#include "SkThreadArena.h"
 #include "SkPathOpsCurve.h"
 
 enum class SkOpRayDir {
@@ -233,7 +234,8 @@ static double get_t_guess(int tTry, int* dirOffset) {
 }
 
 bool SkOpSpan::sortableTop(SkOpContour* contourHead) {
-    SkChunkAlloc allocator(1024);
+    SkAutoThreadArena arena(1024);
+    SkChunkAlloc& allocator = *arena;
     int dirOffset;
     double t = get_t_guess(fTopTTry++, &dirOffset);
     SkOpRayHit hitBase;
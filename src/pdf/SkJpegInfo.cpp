@@ -78,18 +78,32 @@ private:
 bool SkIsJFIF(const SkData* skdata, SkJFIFInfo* info) {
     static const uint16_t kSOI = 0xFFD8;
     static const uint16_t kAPP0 = 0xFFE0;
+    static const uint16_t kAPP1 = 0xFFE1;
     JpegSegment segment(skdata);
     if (!segment.read() || segment.marker() != kSOI) {
         return false;  // not a JPEG
     }
-    if (!segment.read() || segment.marker() != kAPP0) {
-        return false;  // not an APP0 segment
+    if (!segment.read()) {
+        return false;  // no segment after SOI
     }
-    static const char kJfif[] = {'J', 'F', 'I', 'F', '\0'};
-    SkASSERT(segment.data());
-    if (SkToSizeT(segment.length()) < sizeof(kJfif) ||
-        0 != memcmp(segment.data(), kJfif, sizeof(kJfif))) {
-        return false;  // Not JFIF JPEG
+    // Accept both JFIF (APP0) and Exif (APP1) files: DCTDecode handles either,
+    // and most camera JPEGs lead with an Exif segment instead of JFIF.
+    if (segment.marker() == kAPP0) {
+        static const char kJfif[] = {'J', 'F', 'I', 'F', '\0'};
+        SkASSERT(segment.data());
+        if (SkToSizeT(segment.length()) < sizeof(kJfif) ||
+            0 != memcmp(segment.data(), kJfif, sizeof(kJfif))) {
+            return false;  // Not JFIF JPEG
+        }
+    } else if (segment.marker() == kAPP1) {
+        static const char kExif[] = {'E', 'x', 'i', 'f', '\0'};
+        SkASSERT(segment.data());
+        if (SkToSizeT(segment.length()) < sizeof(kExif) ||
+            0 != memcmp(segment.data(), kExif, sizeof(kExif))) {
+            return false;  // Not Exif JPEG
+        }
+    } else {
+        return false;  // not an APP0 or APP1 segment
     }
     do {
         if (!segment.read()) {
@@ -18,7 +18,8 @@ struct SkJFIFInfo {
     } fType;
 };
 
-/** Returns true iff the data seems to be a valid JFIF JPEG image.  
+/** Returns true iff the data seems to be a valid JPEG image that a PDF
+    DCTDecode filter can decode directly (JFIF or Exif flavored).
     If so and if info is not NULL, populate info.
 
     JPEG/JFIF References:
@@ -455,7 +455,8 @@ SkPDFBitmap* SkPDFBitmap::Create(SkPDFCanon* canon, const SkBitmap& bitmap) {
         // Requires the bitmap to be backed by lazy pixels.
         SkAutoTUnref<SkData> data(bm.pixelRef()->refEncodedData());
         SkJFIFInfo info;
-        if (data && SkIsJFIF(data, &info)) {
+        if (data && SkIsJFIF(data, &info) &&
+            info.fWidth == bm.width() && info.fHeight == bm.height()) {
             bool yuv = info.fType == SkJFIFInfo::kYCbCr;
             SkPDFBitmap* pdfBitmap = SkNEW_ARGS(PDFJpegBitmap, (bm, data, yuv));
             canon->addBitmap(pdfBitmap);
@@ -1409,6 +1409,13 @@ void SkPDFDevice::writeContent(SkWStream* out) const {
     SkPDFDevice::copyContentEntriesToData(fContentEntries.get(), out);
 }
 
+void SkPDFDevice::dropContent() {
+    fContentEntries.free();
+    fLastContentEntry = NULL;
+    fMarginContentEntries.free();
+    fLastMarginContentEntry = NULL;
+}
+
 /* Draws an inverse filled path by using Path Ops to compute the positive
  * inverse using the current clip as the inverse bounds.
  * Return true if this was an inverse path and was properly handled,
@@ -1714,37 +1721,41 @@ ContentEntry* SkPDFDevice::setUpContentEntry(const SkClipStack* clipStack,
         return NULL;
     }
 
-    ContentEntry* entry;
-    SkAutoTDelete<ContentEntry> newEntry;
+    // Build the new graphic state on the stack, so draws that join the
+    // current run (the common case on text-heavy pages) never pay for a
+    // ContentEntry allocation that would be thrown away right after the
+    // comparison.
+    GraphicStateEntry newState;
+    populateGraphicStateEntryFromPaint(matrix, *clipStack, clipRegion, paint,
+                                       hasText, &newState);
 
     ContentEntry* lastContentEntry = getLastContentEntry();
-    if (lastContentEntry && lastContentEntry->fContent.getOffset() == 0) {
-        entry = lastContentEntry;
-    } else {
-        newEntry.reset(new ContentEntry);
-        entry = newEntry.get();
+    if (lastContentEntry && xfermode != SkXfermode::kDstOver_Mode) {
+        if (lastContentEntry->fContent.getOffset() == 0) {
+            // The last entry is still empty; just take over its state.
+            lastContentEntry->fState = newState;
+            return lastContentEntry;
+        }
+        if (newState.compareInitialState(lastContentEntry->fState)) {
+            return lastContentEntry;
+        }
     }
 
-    populateGraphicStateEntryFromPaint(matrix, *clipStack, clipRegion, paint,
-                                       hasText, &entry->fState);
-    if (lastContentEntry && xfermode != SkXfermode::kDstOver_Mode &&
-            entry->fState.compareInitialState(lastContentEntry->fState)) {
-        return lastContentEntry;
-    }
+    SkAutoTDelete<ContentEntry> entry(new ContentEntry);
+    entry->fState = newState;
 
     SkAutoTDelete<ContentEntry>* contentEntries = getContentEntries();
     if (!lastContentEntry) {
-        contentEntries->reset(entry);
-        setLastContentEntry(entry);
+        contentEntries->reset(entry.get());
+        setLastContentEntry(entry.get());
     } else if (xfermode == SkXfermode::kDstOver_Mode) {
         entry->fNext.reset(contentEntries->detach());
-        contentEntries->reset(entry);
+        contentEntries->reset(entry.get());
     } else {
-        lastContentEntry->fNext.reset(entry);
-        setLastContentEntry(entry);
+        lastContentEntry->fNext.reset(entry.get());
+        setLastContentEntry(entry.get());
     }
-    newEntry.detach();
-    return entry;
+    return entry.detach();
 }
 
 void SkPDFDevice::finishContentEntry(SkXfermode::Mode xfermode,
@@ -167,6 +167,13 @@ public:
     /** Writes the page contents to the stream. */
     void writeContent(SkWStream*) const;
 
+    /** Deletes the accumulated content entries to reclaim their memory once
+     *  the page's content has been written out (streaming document mode).
+     *  content() returns an empty stream afterwards; resources, glyph usage
+     *  and annotations are unaffected.
+     */
+    void dropContent();
+
     const SkMatrix& initialTransform() const {
         return fInitialTransform;
     }
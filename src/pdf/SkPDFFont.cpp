@@ -7,8 +7,10 @@
 
 #include <ctype.h>
 
+#include "SkChecksum.h"
 #include "SkData.h"
 #include "SkGlyphCache.h"
+#include "SkMutex.h"
 #include "SkPaint.h"
 #include "SkPDFCanon.h"
 #include "SkPDFDevice.h"
@@ -584,12 +586,82 @@ static void sk_delete_array(const void* ptr, size_t, void*) {
     // Use C-style cast to cast away const and cast type simultaneously.
     delete[] (unsigned char*)ptr;
 }
+
+// Process-level cache of subset font programs.  Running the sfntly subsetter
+// is by far the most expensive part of font embedding, and documents that use
+// the same typefaces with the same glyph usage (e.g. template-driven reports)
+// produce byte-identical subsets, so the resulting data is kept for the life
+// of the process.  Only the immutable bytes are shared; each document still
+// builds its own SkPDFStream and descriptor around them, since live PDF
+// objects belong to a single canon (one canon per thread).
+SK_DECLARE_STATIC_MUTEX(gSubsetFontCacheMutex);
+
+namespace {
+struct SubsetFontCacheEntry {
+    uint32_t fFontID;
+    uint32_t fGlyphIDHash;
+    SkData* fGlyphIDs;  // the sorted glyph ID list used as the subset key
+    SkData* fFontData;  // the subset font program
+};
+}  // namespace
+
+// Callers must hold gSubsetFontCacheMutex.
+static SkTDArray<SubsetFontCacheEntry>& subset_font_cache() {
+    static SkTDArray<SubsetFontCacheEntry>* gCache = NULL;
+    if (NULL == gCache) {
+        gCache = SkNEW(SkTDArray<SubsetFontCacheEntry>);
+    }
+    return *gCache;
+}
+
+static SkData* find_subset_font_data(uint32_t fontID, uint32_t glyphIDHash,
+                                     const SkTDArray<uint32_t>& subset) {
+    SkAutoMutexAcquire lock(gSubsetFontCacheMutex);
+    const SkTDArray<SubsetFontCacheEntry>& cache = subset_font_cache();
+    const size_t glyphIDBytes = subset.count() * sizeof(uint32_t);
+    for (int i = 0; i < cache.count(); ++i) {
+        const SubsetFontCacheEntry& entry = cache[i];
+        // The full glyph ID list is compared so a hash collision can never
+        // substitute the wrong subset.
+        if (entry.fFontID == fontID && entry.fGlyphIDHash == glyphIDHash &&
+                entry.fGlyphIDs->size() == glyphIDBytes &&
+                0 == memcmp(entry.fGlyphIDs->data(), subset.begin(), glyphIDBytes)) {
+            return SkRef(entry.fFontData);
+        }
+    }
+    return NULL;
+}
+
+static void add_subset_font_data(uint32_t fontID, uint32_t glyphIDHash,
+                                 const SkTDArray<uint32_t>& subset,
+                                 SkData* fontData) {
+    SkAutoMutexAcquire lock(gSubsetFontCacheMutex);
+    // A concurrent document may have raced us to subset the same font; the
+    // duplicate entry is harmless (the first match wins on lookup).
+    SubsetFontCacheEntry* entry = subset_font_cache().append();
+    entry->fFontID = fontID;
+    entry->fGlyphIDHash = glyphIDHash;
+    entry->fGlyphIDs =
+            SkData::NewWithCopy(subset.begin(), subset.count() * sizeof(uint32_t));
+    entry->fFontData = SkRef(fontData);
+}
 #endif
 
 static size_t get_subset_font_stream(const char* fontName,
                                      const SkTypeface* typeface,
                                      const SkTDArray<uint32_t>& subset,
                                      SkPDFStream** fontStream) {
+#if defined (SK_SFNTLY_SUBSETTER)
+    const uint32_t fontID = typeface->uniqueID();
+    const uint32_t glyphIDHash =
+            SkChecksum::Murmur3(subset.begin(), subset.count() * sizeof(uint32_t));
+    SkAutoTUnref<SkData> cached(find_subset_font_data(fontID, glyphIDHash, subset));
+    if (cached) {
+        *fontStream = new SkPDFStream(cached.get());
+        return cached->size();
+    }
+#endif
+
     int ttcIndex;
     SkAutoTDelete<SkStream> fontData(typeface->openStream(&ttcIndex));
     SkASSERT(fontData.get());
@@ -618,6 +690,7 @@ static size_t get_subset_font_stream(const char* fontName,
                                                      subsetFontSize,
                                                      sk_delete_array,
                                                      NULL));
+            add_subset_font_data(fontID, glyphIDHash, subset, data.get());
             subsetFontStream = new SkPDFStream(data.get());
             fontSize = subsetFontSize;
         }
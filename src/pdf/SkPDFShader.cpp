@@ -9,6 +9,7 @@
 
 #include "SkPDFShader.h"
 
+#include "SkChecksum.h"
 #include "SkData.h"
 #include "SkPDFCanon.h"
 #include "SkPDFDevice.h"
@@ -434,19 +435,36 @@ public:
     uint32_t fPixelGeneration;
     SkShader::TileMode fImageTileModes[2];
 
+    // Set when the source shader has no PDF analog and must be rasterized.
+    // The bitmap is only drawn once the canon lookup misses; see
+    // rasterizeFallback().
+    SkAutoTUnref<const SkShader> fFallbackShader;
+
     State(const SkShader& shader, const SkMatrix& canvasTransform,
           const SkIRect& bbox, SkScalar rasterScale);
 
     bool operator==(const State& b) const;
 
+    // Cheap key checked before the deep operator== in canon lookups.
+    uint32_t hash() const { return fHash; }
+
+    // Draw fFallbackShader into fImage; no-op if already rasterized.
+    void rasterizeFallback();
+
     SkPDFShader::State* CreateAlphaToLuminosityState() const;
     SkPDFShader::State* CreateOpaqueState() const;
 
     bool GradientHasAlpha() const;
 
 private:
+    SkRect fFallbackRect;   // fBBox mapped into shader space
+    SkISize fFallbackSize;  // raster dimensions for the fallback bitmap
+    uint32_t fHash;         // fixed at construction; see computeHash()
+
     State(const State& other);
     State operator=(const State& rhs);
+    uint32_t computeHash() const;
+    void updateHash() { fHash = this->computeHash(); }
     void AllocateGradientInfoStorage();
 };
 
@@ -458,7 +476,7 @@ SkPDFFunctionShader::SkPDFFunctionShader(SkPDFShader::State* state)
 SkPDFFunctionShader::~SkPDFFunctionShader() {}
 
 bool SkPDFFunctionShader::equals(const SkPDFShader::State& state) const {
-    return state == *fShaderState;
+    return state.hash() == fShaderState->hash() && state == *fShaderState;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -467,7 +485,7 @@ SkPDFAlphaFunctionShader::SkPDFAlphaFunctionShader(SkPDFShader::State* state)
     : fShaderState(state) {}
 
 bool SkPDFAlphaFunctionShader::equals(const SkPDFShader::State& state) const {
-    return state == *fShaderState;
+    return state.hash() == fShaderState->hash() && state == *fShaderState;
 }
 
 SkPDFAlphaFunctionShader::~SkPDFAlphaFunctionShader() {}
@@ -478,7 +496,7 @@ SkPDFImageShader::SkPDFImageShader(SkPDFShader::State* state)
     : fShaderState(state) {}
 
 bool SkPDFImageShader::equals(const SkPDFShader::State& state) const {
-    return state == *fShaderState;
+    return state.hash() == fShaderState->hash() && state == *fShaderState;
 }
 
 SkPDFImageShader::~SkPDFImageShader() {}
@@ -490,7 +508,8 @@ static SkPDFObject* get_pdf_shader_by_state(
         SkScalar dpi,
         SkAutoTDelete<SkPDFShader::State>* autoState) {
     const SkPDFShader::State& state = **autoState;
-    if (state.fType == SkShader::kNone_GradientType && state.fImage.isNull()) {
+    if (state.fType == SkShader::kNone_GradientType && state.fImage.isNull() &&
+            NULL == state.fFallbackShader.get()) {
         // TODO(vandebo) This drops SKComposeShader on the floor.  We could
         // handle compose shader by pulling things up to a layer, drawing with
         // the first shader, applying the xfer mode and drawing again with the
@@ -498,8 +517,12 @@ static SkPDFObject* get_pdf_shader_by_state(
         return NULL;
     } else if (state.fType == SkShader::kNone_GradientType) {
         SkPDFObject* shader = canon->findImageShader(state);
-        return shader ? SkRef(shader)
-                      : SkPDFImageShader::Create(canon, dpi, autoState);
+        if (shader) {
+            return SkRef(shader);
+        }
+        // Only rasterize the fallback once the canon lookup misses.
+        (*autoState)->rasterizeFallback();
+        return SkPDFImageShader::Create(canon, dpi, autoState);
     } else if (state.GradientHasAlpha()) {
         SkPDFObject* shader = canon->findAlphaShader(state);
         return shader ? SkRef(shader)
@@ -1052,12 +1075,20 @@ bool SkPDFShader::State::operator==(const SkPDFShader::State& b) const {
     }
 
     if (fType == SkShader::kNone_GradientType) {
-        if (fPixelGeneration != b.fPixelGeneration ||
-                fPixelGeneration == 0 ||
-                fImageTileModes[0] != b.fImageTileModes[0] ||
+        if (fImageTileModes[0] != b.fImageTileModes[0] ||
                 fImageTileModes[1] != b.fImageTileModes[1]) {
             return false;
         }
+        if (fFallbackShader.get() || b.fFallbackShader.get()) {
+            // Rasterized fallbacks are shared only when they come from the
+            // same immutable shader object; the pixels have no cheap
+            // content key.
+            return fFallbackShader.get() == b.fFallbackShader.get();
+        }
+        if (fPixelGeneration != b.fPixelGeneration ||
+                fPixelGeneration == 0) {
+            return false;
+        }
     } else {
         if (fInfo.fColorCount != b.fInfo.fColorCount ||
                 memcmp(fInfo.fColors, b.fInfo.fColors,
@@ -1101,9 +1132,9 @@ SkPDFShader::State::State(const SkShader& shader, const SkMatrix& canvasTransfor
         : fCanvasTransform(canvasTransform),
           fBBox(bbox),
           fPixelGeneration(0) {
-    fInfo.fColorCount = 0;
-    fInfo.fColors = NULL;
-    fInfo.fColorOffsets = NULL;
+    // Zero the whole struct so fields a gradient type leaves untouched still
+    // hash deterministically.
+    sk_bzero(&fInfo, sizeof(fInfo));
     fShaderTransform = shader.getLocalMatrix();
     fImageTileModes[0] = fImageTileModes[1] = SkShader::kClamp_TileMode;
 
@@ -1118,6 +1149,8 @@ SkPDFShader::State::State(const SkShader& shader, const SkMatrix& canvasTransfor
             //  * allocate a bbox-sized bitmap
             //  * shade the whole area
             //  * use the result as a bitmap shader
+            // Only the geometry is computed here; the (expensive) shading is
+            // deferred until the canon lookup misses.  See rasterizeFallback().
 
             // bbox is in device space. While that's exactly what we want for sizing our bitmap,
             // we need to map it into shader space for adjustments (to match
@@ -1125,6 +1158,7 @@ SkPDFShader::State::State(const SkShader& shader, const SkMatrix& canvasTransfor
             SkRect shaderRect = SkRect::Make(bbox);
             if (!inverse_transform_bbox(canvasTransform, &shaderRect)) {
                 fImage.reset();
+                this->updateHash();
                 return;
             }
 
@@ -1140,27 +1174,82 @@ SkPDFShader::State::State(const SkShader& shader, const SkMatrix& canvasTransfor
             SkSize scale = SkSize::Make(SkIntToScalar(size.width()) / shaderRect.width(),
                                         SkIntToScalar(size.height()) / shaderRect.height());
 
-            fImage.allocN32Pixels(size.width(), size.height());
-            fImage.eraseColor(SK_ColorTRANSPARENT);
-
-            SkPaint p;
-            p.setShader(const_cast<SkShader*>(&shader));
-
-            SkCanvas canvas(fImage);
-            canvas.scale(scale.width(), scale.height());
-            canvas.translate(-shaderRect.x(), -shaderRect.y());
-            canvas.drawPaint(p);
+            fFallbackShader.reset(SkRef(&shader));
+            fFallbackRect = shaderRect;
+            fFallbackSize = size;
 
             fShaderTransform.setTranslate(shaderRect.x(), shaderRect.y());
             fShaderTransform.preScale(1 / scale.width(), 1 / scale.height());
         } else {
             SkASSERT(matrix.isIdentity());
+            fPixelGeneration = fImage.getGenerationID();
         }
-        fPixelGeneration = fImage.getGenerationID();
     } else {
         AllocateGradientInfoStorage();
         shader.asAGradient(&fInfo);
     }
+    this->updateHash();
+}
+
+void SkPDFShader::State::rasterizeFallback() {
+    if (NULL == fFallbackShader.get() || !fImage.isNull()) {
+        return;
+    }
+    SkSize scale =
+            SkSize::Make(SkIntToScalar(fFallbackSize.width()) / fFallbackRect.width(),
+                         SkIntToScalar(fFallbackSize.height()) / fFallbackRect.height());
+
+    fImage.allocN32Pixels(fFallbackSize.width(), fFallbackSize.height());
+    fImage.eraseColor(SK_ColorTRANSPARENT);
+
+    SkPaint p;
+    p.setShader(const_cast<SkShader*>(fFallbackShader.get()));
+
+    SkCanvas canvas(fImage);
+    canvas.scale(scale.width(), scale.height());
+    canvas.translate(-fFallbackRect.x(), -fFallbackRect.y());
+    canvas.drawPaint(p);
+
+    // Note: fHash is not recomputed; fallback states hash and compare by the
+    // source shader, not by the pixels.
+    fPixelGeneration = fImage.getGenerationID();
+}
+
+uint32_t SkPDFShader::State::computeHash() const {
+    SkScalar matrixValues[18];
+    for (int i = 0; i < 9; ++i) {
+        matrixValues[i] = fCanvasTransform.get(i);
+        matrixValues[9 + i] = fShaderTransform.get(i);
+    }
+    uint32_t hash = SkChecksum::Murmur3(matrixValues, sizeof(matrixValues));
+    hash = SkChecksum::Murmur3(&fBBox, sizeof(fBBox), hash);
+    uint32_t type = SkToU32(fType);
+    hash = SkChecksum::Murmur3(&type, sizeof(type), hash);
+    if (fType == SkShader::kNone_GradientType) {
+        uint32_t imageValues[3] = {
+            fPixelGeneration,
+            SkToU32(fImageTileModes[0]),
+            SkToU32(fImageTileModes[1]),
+        };
+        hash = SkChecksum::Murmur3(imageValues, sizeof(imageValues), hash);
+        const SkShader* fallback = fFallbackShader.get();
+        hash = SkChecksum::Murmur3(&fallback, sizeof(fallback), hash);
+    } else {
+        uint32_t colorCount = SkToU32(fInfo.fColorCount);
+        hash = SkChecksum::Murmur3(&colorCount, sizeof(colorCount), hash);
+        hash = SkChecksum::Murmur3(fInfo.fColors,
+                                   sizeof(SkColor) * fInfo.fColorCount, hash);
+        hash = SkChecksum::Murmur3(fInfo.fColorOffsets,
+                                   sizeof(SkScalar) * fInfo.fColorCount, hash);
+        SkScalar gradientValues[7] = {
+            fInfo.fPoint[0].x(), fInfo.fPoint[0].y(),
+            fInfo.fPoint[1].x(), fInfo.fPoint[1].y(),
+            fInfo.fRadius[0], fInfo.fRadius[1],
+            SkIntToScalar(fInfo.fTileMode),
+        };
+        hash = SkChecksum::Murmur3(gradientValues, sizeof(gradientValues), hash);
+    }
+    return hash;
 }
 
 SkPDFShader::State::State(const SkPDFShader::State& other)
@@ -1182,6 +1271,7 @@ SkPDFShader::State::State(const SkPDFShader::State& other)
             fInfo.fColorOffsets[i] = other.fInfo.fColorOffsets[i];
         }
     }
+    this->updateHash();
 }
 
 /**
@@ -1197,6 +1287,7 @@ SkPDFShader::State* SkPDFShader::State::CreateAlphaToLuminosityState() const {
         SkAlpha alpha = SkColorGetA(fInfo.fColors[i]);
         newState->fInfo.fColors[i] = SkColorSetARGB(255, alpha, alpha, alpha);
     }
+    newState->updateHash();
 
     return newState;
 }
@@ -1213,6 +1304,7 @@ SkPDFShader::State* SkPDFShader::State::CreateOpaqueState() const {
         newState->fInfo.fColors[i] = SkColorSetA(fInfo.fColors[i],
                                                  SK_AlphaOPAQUE);
     }
+    newState->updateHash();
 
     return newState;
 }
@@ -23,9 +23,7 @@ SkPDFStream::SkPDFStream(SkData* data) : fState(kUnused_State) {
 
 SkPDFStream::~SkPDFStream() {}
 
-void SkPDFStream::emitObject(SkWStream* stream,
-                             const SkPDFObjNumMap& objNumMap,
-                             const SkPDFSubstituteMap& substitutes) {
+void SkPDFStream::deflateData() {
     if (fState == kUnused_State) {
         fState = kNoCompression_State;
         SkDynamicMemoryWStream compressedData;
@@ -42,6 +40,12 @@ void SkPDFStream::emitObject(SkWStream* stream,
         fState = kCompressed_State;
         this->insertInt("Length", this->dataSize());
     }
+}
+
+void SkPDFStream::emitObject(SkWStream* stream,
+                             const SkPDFObjNumMap& objNumMap,
+                             const SkPDFSubstituteMap& substitutes) {
+    this->deflateData();
     this->INHERITED::emitObject(stream, objNumMap, substitutes);
     stream->writeText(" stream\n");
     stream->writeStream(fDataStream.get(), fDataStream->getLength());
@@ -39,6 +39,12 @@ public:
 
     virtual ~SkPDFStream();
 
+    /** Deflate the stream data now instead of lazily at emit time.  Useful
+     *  for compressing many streams on SkTaskGroup workers; call it before
+     *  the stream is handed to the (serial) serialization pass.
+     */
+    void deflateData();
+
     // The SkPDFObject interface.
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap,
@@ -92,6 +92,11 @@ public:
         fSilent = silent;
     }
 
+    void setBitmapHandleResolver(SkGPipeReader::BitmapHandleProc proc, void* context) {
+        fHandleProc = proc;
+        fHandleContext = context;
+    }
+
     bool shouldDraw() {
         return !fSilent;
     }
@@ -157,6 +162,29 @@ public:
         fReader->readBitmap(bm);
     }
 
+    /**
+     * Add a bitmap whose pixels the writer's controller moved out-of-band,
+     * asking the installed resolver proc to map the handle back to pixels.
+     * This is only used when in cross process mode without a shared heap.
+     */
+    void addSharedBitmap(int index, int32_t handle, const SkImageInfo& info, size_t rowBytes) {
+        SkASSERT(shouldFlattenBitmaps(fFlags));
+        SkBitmap* bm;
+        if (fBitmaps.count() == index) {
+            bm = SkNEW(SkBitmap);
+            *fBitmaps.append() = bm;
+        } else {
+            bm = fBitmaps[index];
+        }
+        bm->reset();
+        if (NULL == fHandleProc
+                || !fHandleProc(fHandleContext, handle, info, rowBytes, bm)) {
+            // Keep the geometry so later draw commands referencing this slot
+            // stay consistent; with no pixels they will draw nothing.
+            bm->setInfo(info, rowBytes);
+        }
+    }
+
     /**
      * Override of SkBitmapHeapReader, so that SkReadBuffer can use
      * these SkBitmaps for bitmap shaders. Used only in cross process mode
@@ -236,6 +264,8 @@ private:
     // Only used when sharing bitmaps with the writer.
     SkBitmapHeap*             fSharedHeap;
     SkAutoTUnref<SkImageHeap> fImageHeap;
+    SkGPipeReader::BitmapHandleProc fHandleProc;
+    void*                     fHandleContext;
     unsigned                  fFlags;
 };
 
@@ -793,6 +823,19 @@ static void def_Bitmap_rp(SkCanvas*, SkReader32*, uint32_t op32,
     state->addBitmap(index);
 }
 
+static void def_SharedBitmap_rp(SkCanvas*, SkReader32* reader, uint32_t op32,
+                                SkGPipeState* state) {
+    unsigned index = DrawOp_unpackData(op32);
+    int32_t handle = reader->readS32();
+    int width = reader->readS32();
+    int height = reader->readS32();
+    SkColorType colorType = (SkColorType)reader->readU32();
+    SkAlphaType alphaType = (SkAlphaType)reader->readU32();
+    size_t rowBytes = reader->readU32();
+    state->addSharedBitmap(index, handle,
+                           SkImageInfo::Make(width, height, colorType, alphaType), rowBytes);
+}
+
 static void def_Factory_rp(SkCanvas*, SkReader32* reader, uint32_t,
                            SkGPipeState* state) {
     state->defFactory(reader->readString());
@@ -868,6 +911,7 @@ static const ReadProc gReadTable[] = {
     def_Typeface_rp,
     def_PaintFlat_rp,
     def_Bitmap_rp,
+    def_SharedBitmap_rp,
     def_Factory_rp,
 
     reportFlags_rp,
@@ -882,6 +926,8 @@ SkGPipeState::SkGPipeState()
     : fReader(0)
     , fSilent(false)
     , fSharedHeap(NULL)
+    , fHandleProc(NULL)
+    , fHandleContext(NULL)
     , fFlags(0) {
 
 }
@@ -901,6 +947,8 @@ SkGPipeReader::SkGPipeReader() {
     fCanvas = NULL;
     fState = NULL;
     fProc = NULL;
+    fHandleProc = NULL;
+    fHandleContext = NULL;
 }
 
 SkGPipeReader::SkGPipeReader(SkCanvas* target) {
@@ -908,6 +956,8 @@ SkGPipeReader::SkGPipeReader(SkCanvas* target) {
     this->setCanvas(target);
     fState = NULL;
     fProc = NULL;
+    fHandleProc = NULL;
+    fHandleContext = NULL;
 }
 
 void SkGPipeReader::setCanvas(SkCanvas *target) {
@@ -930,6 +980,7 @@ SkGPipeReader::Status SkGPipeReader::playback(const void* data, size_t length,
     }
 
     fState->setSilent(playbackFlags & kSilent_PlaybackFlag);
+    fState->setBitmapHandleResolver(fHandleProc, fHandleContext);
 
     SkASSERT(SK_ARRAY_COUNT(gReadTable) == (kDone_DrawOp + 1));
 
@@ -959,7 +1010,8 @@ SkGPipeReader::Status SkGPipeReader::playback(const void* data, size_t length,
             (table[op] != paintOp_rp &&
              table[op] != def_Typeface_rp &&
              table[op] != def_PaintFlat_rp &&
-             table[op] != def_Bitmap_rp
+             table[op] != def_Bitmap_rp &&
+             table[op] != def_SharedBitmap_rp
              )) {
                 status = kReadAtom_Status;
                 break;
@@ -377,6 +377,25 @@ void SkGPipeCanvas::flattenFactoryNames() {
 
 bool SkGPipeCanvas::shuttleBitmap(const SkBitmap& bm, int32_t slot) {
     SkASSERT(shouldFlattenBitmaps(fFlags));
+
+    // Give the controller a chance to move the pixels out-of-band (e.g. into
+    // shared memory), in which case only the handle and the geometry needed
+    // to map the pixels back travel through the pipe.
+    int32_t handle = fController->transportBitmap(bm);
+    if (handle >= 0) {
+        if (this->needOpBytes(6 * sizeof(uint32_t))) {
+            this->writeOp(kDef_SharedBitmap_DrawOp, 0, slot);
+            fWriter.write32(handle);
+            fWriter.write32(bm.width());
+            fWriter.write32(bm.height());
+            fWriter.write32(bm.colorType());
+            fWriter.write32(bm.alphaType());
+            fWriter.write32(SkToU32(bm.rowBytes()));
+            return true;
+        }
+        return false;
+    }
+
     SkWriteBuffer buffer;
     buffer.setNamedFactoryRecorder(fFactorySet);
     buffer.writeBitmap(bm);
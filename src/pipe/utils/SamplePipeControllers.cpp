@@ -116,3 +116,107 @@ void ThreadSafePipeController::draw(SkCanvas* target) {
         reader.playback(fBlock, fBytesWritten);
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+RingBufferPipeController::RingBufferPipeController(SkCanvas* target, size_t capacity,
+                                                   SkPicture::InstallPixelRefProc proc)
+: fReader(target) {
+    fBuffer = (char*) sk_malloc_throw(capacity);
+    fCapacity = capacity;
+    fBlockOffset = fBlockCommitted = fBytesPending = 0;
+    fLowWaterProc = NULL;
+    fLowWaterContext = NULL;
+    fReader.setBitmapDecoder(proc);
+}
+
+RingBufferPipeController::~RingBufferPipeController() {
+    this->drain();
+    sk_free(fBuffer);
+}
+
+bool RingBufferPipeController::findSpan(size_t minRequest, size_t* offset, size_t* span) const {
+    if (0 == fRecords.count()) {
+        // Ring is empty; the writer commits everything it writes before
+        // requesting a new block, so the whole ring is free.
+        if (minRequest > fCapacity) {
+            return false;
+        }
+        *offset = 0;
+        *span = fCapacity;
+        return true;
+    }
+    size_t head = fBlockOffset + fBlockCommitted;
+    size_t tail = fRecords[0].fOffset;
+    if (head > tail) {
+        // Live records occupy [tail, head). Prefer the gap at the end of the
+        // ring; otherwise wrap, abandoning the too-small gap. Records never
+        // span the wrap, so playback is unaffected.
+        if (fCapacity - head >= minRequest) {
+            *offset = head;
+            *span = fCapacity - head;
+            return true;
+        }
+        if (tail >= minRequest) {
+            *offset = 0;
+            *span = tail;
+            return true;
+        }
+    } else if (head < tail) {
+        // Already wrapped; the only free space is the gap [head, tail).
+        if (tail - head >= minRequest) {
+            *offset = head;
+            *span = tail - head;
+            return true;
+        }
+    }
+    // head == tail with records pending: the ring is completely full.
+    return false;
+}
+
+void* RingBufferPipeController::requestBlock(size_t minRequest, size_t* actual) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        size_t offset, span;
+        if (this->findSpan(minRequest, &offset, &span)) {
+            fBlockOffset = offset;
+            fBlockCommitted = 0;
+            *actual = span;
+            return fBuffer + offset;
+        }
+        // Out of space. Give the embedder a chance to drive its consumer,
+        // then drain inline as back-pressure and try once more.
+        if (fLowWaterProc) {
+            fLowWaterProc(fLowWaterContext);
+        }
+        if (fRecords.count() > 0) {
+            this->drain();
+        }
+    }
+    // A single op needs more space than the ring holds; stop the writer.
+    return NULL;
+}
+
+void RingBufferPipeController::notifyWritten(size_t bytes) {
+    if (bytes > 0) {
+        Record* record = fRecords.append();
+        record->fOffset = fBlockOffset + fBlockCommitted;
+        record->fBytes = bytes;
+        fBlockCommitted += bytes;
+        fBytesPending += bytes;
+    }
+    if (fLowWaterProc && fBytesPending > fCapacity - fCapacity / 4) {
+        fLowWaterProc(fLowWaterContext);
+    }
+}
+
+size_t RingBufferPipeController::drain() {
+    size_t consumed = 0;
+    for (int i = 0; i < fRecords.count(); i++) {
+        fStatus = fReader.playback(fBuffer + fRecords[i].fOffset, fRecords[i].fBytes);
+        SkASSERT(SkGPipeReader::kError_Status != fStatus);
+        consumed += fRecords[i].fBytes;
+    }
+    fRecords.rewind();
+    fBytesPending = 0;
+    return consumed;
+}
@@ -85,3 +85,65 @@ private:
     SkTDArray<PipeBlock> fBlockList;
     int fNumberOfReaders;
 };
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Streams the pipe through a fixed-size ring buffer instead of growing
+ * storage until flush. Each notifyWritten() becomes a commit record, so the
+ * reader can consume completed ops while the writer keeps recording, and
+ * records never wrap so playback resumes cleanly across the end of the ring.
+ * When free space runs out the controller first invokes an optional
+ * low-water callback (letting the embedder drive its consumer) and then
+ * drains inline as back-pressure, so memory stays bounded by the ring.
+ */
+class RingBufferPipeController : public SkGPipeController {
+public:
+    typedef void (*LowWaterProc)(void* context);
+
+    RingBufferPipeController(SkCanvas* target, size_t capacity,
+                             SkPicture::InstallPixelRefProc proc = NULL);
+    virtual ~RingBufferPipeController();
+    void* requestBlock(size_t minRequest, size_t* actual) override;
+    void notifyWritten(size_t bytes) override;
+
+    /**
+     * Install a callback invoked when pending data exceeds three quarters of
+     * the ring, and again before the controller drains inline for space.
+     * The context pointer is owned by the caller and passed back to proc.
+     */
+    void setLowWaterCallback(LowWaterProc proc, void* context) {
+        fLowWaterProc = proc;
+        fLowWaterContext = context;
+    }
+
+    /**
+     * Play back and release every committed record, emptying the ring.
+     * Returns the number of bytes consumed.
+     */
+    size_t drain();
+
+    /** Bytes committed by the writer but not yet played back. */
+    size_t bytesPending() const { return fBytesPending; }
+
+private:
+    struct Record {
+        size_t fOffset;  // start of the committed run within the ring
+        size_t fBytes;   // length of the run; runs never wrap
+    };
+
+    // Find a contiguous free span of at least minRequest bytes, wrapping to
+    // the front of the ring if the gap at the end is too small.
+    bool findSpan(size_t minRequest, size_t* offset, size_t* span) const;
+
+    SkGPipeReader fReader;
+    char* fBuffer;
+    size_t fCapacity;
+    SkTDArray<Record> fRecords;
+    size_t fBlockOffset;
+    size_t fBlockCommitted;
+    size_t fBytesPending;
+    LowWaterProc fLowWaterProc;
+    void* fLowWaterContext;
+    SkGPipeReader::Status fStatus;
+};
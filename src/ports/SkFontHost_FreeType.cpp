@@ -198,6 +198,10 @@ protected:
     void generateAdvance(SkGlyph* glyph) override;
     void generateMetrics(SkGlyph* glyph) override;
     void generateImage(const SkGlyph& glyph) override;
+    void generateMetricsBatch(SkGlyph* glyphs[], int count) override;
+    void generateImageBatch(const SkGlyph* glyphs[], int count) override;
+    void generateAdvanceBatch(uint16_t firstGlyphID, int count,
+                              SkFixed advancesX[], SkFixed advancesY[]) override;
     void generatePath(const SkGlyph& glyph, SkPath* path) override;
     void generateFontMetrics(SkPaint::FontMetrics*) override;
     SkUnichar generateGlyphToChar(uint16_t glyph) override;
@@ -221,6 +225,9 @@ private:
     void getBBoxForCurrentGlyph(SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
+    // Caller must lock gFTMutex and call setupSize() before calling these.
+    void generateMetricsForCurrentSize(SkGlyph* glyph);
+    void generateImageForCurrentSize(const SkGlyph& glyph);
     // Caller must lock gFTMutex before calling this function.
     void updateGlyphIfLCD(SkGlyph* glyph);
     // Caller must lock gFTMutex before calling this function.
@@ -1027,6 +1034,42 @@ void SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
     return;
 }
 
+void SkScalerContext_FreeType::generateAdvanceBatch(uint16_t firstGlyphID, int count,
+                                                    SkFixed advancesX[], SkFixed advancesY[]) {
+    SkAutoMutexAcquire  ac(gFTMutex);
+
+    if (this->setupSize()) {
+        sk_bzero(advancesX, count * sizeof(SkFixed));
+        sk_bzero(advancesY, count * sizeof(SkFixed));
+        return;
+    }
+
+    if (fDoLinearMetrics) {
+        // one FT_Get_Advances call covers the whole range without loading
+        // (or hinting) any outlines
+        SkAutoSTMalloc<64, FT_Fixed> advances(count);
+        if (0 == FT_Get_Advances(fFace, firstGlyphID, count,
+                                 fLoadGlyphFlags | FT_ADVANCE_FLAG_FAST_ONLY,
+                                 advances.get())) {
+            for (int i = 0; i < count; ++i) {
+                advancesX[i] = SkFixedMul(fMatrix22.xx, advances[i]);
+                advancesY[i] = -SkFixedMul(fMatrix22.yx, advances[i]);
+            }
+            return;
+        }
+    }
+
+    /* otherwise, we need to load/hint the glyphs, which is slower */
+    for (int i = 0; i < count; ++i) {
+        SkGlyph glyph;
+        glyph.initWithGlyphID(firstGlyphID + i);
+        glyph.fMaskFormat = MASK_FORMAT_JUST_ADVANCE;
+        this->generateMetricsForCurrentSize(&glyph);
+        advancesX[i] = glyph.fAdvanceX;
+        advancesY[i] = glyph.fAdvanceY;
+    }
+}
+
 void SkScalerContext_FreeType::getBBoxForCurrentGlyph(SkGlyph* glyph,
                                                       FT_BBox* bbox,
                                                       bool snapToPixelBoundary) {
@@ -1105,15 +1148,36 @@ inline void scaleGlyphMetrics(SkGlyph& glyph, SkScalar scale) {
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
     SkAutoMutexAcquire  ac(gFTMutex);
 
+    if (this->setupSize()) {
+        glyph->zeroMetrics();
+        return;
+    }
+    this->generateMetricsForCurrentSize(glyph);
+}
+
+void SkScalerContext_FreeType::generateMetricsBatch(SkGlyph* glyphs[], int count) {
+    SkAutoMutexAcquire  ac(gFTMutex);
+
+    // Take the library mutex and activate the size once for the whole run,
+    // rather than once per glyph.
+    const bool sizeOK = (0 == this->setupSize());
+    for (int i = 0; i < count; ++i) {
+        if (sizeOK) {
+            this->generateMetricsForCurrentSize(glyphs[i]);
+        } else {
+            glyphs[i]->zeroMetrics();
+        }
+    }
+}
+
+void SkScalerContext_FreeType::generateMetricsForCurrentSize(SkGlyph* glyph) {
+    gFTMutex.assertHeld();
+
     glyph->fRsbDelta = 0;
     glyph->fLsbDelta = 0;
 
     FT_Error    err;
 
-    if (this->setupSize()) {
-        goto ERROR;
-    }
-
     err = FT_Load_Glyph( fFace, glyph->getGlyphID(), fLoadGlyphFlags );
     if (err != 0) {
 #if 0
@@ -1218,6 +1282,24 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
         clear_glyph_image(glyph);
         return;
     }
+    this->generateImageForCurrentSize(glyph);
+}
+
+void SkScalerContext_FreeType::generateImageBatch(const SkGlyph* glyphs[], int count) {
+    SkAutoMutexAcquire  ac(gFTMutex);
+
+    const bool sizeOK = (0 == this->setupSize());
+    for (int i = 0; i < count; ++i) {
+        if (sizeOK) {
+            this->generateImageForCurrentSize(*glyphs[i]);
+        } else {
+            clear_glyph_image(*glyphs[i]);
+        }
+    }
+}
+
+void SkScalerContext_FreeType::generateImageForCurrentSize(const SkGlyph& glyph) {
+    gFTMutex.assertHeld();
 
     FT_Error err = FT_Load_Glyph(fFace, glyph.getGlyphID(), fLoadGlyphFlags);
     if (err != 0) {
@@ -80,6 +80,39 @@ void* sk_fdmmap(int fd, size_t* size) {
     return addr;
 }
 
+bool sk_fmadvise(const void* addr, size_t length, SkFILE_MemoryAdvice advice) {
+    int posixAdvice;
+    switch (advice) {
+        case kNormal_SkFILE_MemoryAdvice:
+            posixAdvice = MADV_NORMAL;
+            break;
+        case kSequential_SkFILE_MemoryAdvice:
+            posixAdvice = MADV_SEQUENTIAL;
+            break;
+        case kRandom_SkFILE_MemoryAdvice:
+            posixAdvice = MADV_RANDOM;
+            break;
+        case kWillNeed_SkFILE_MemoryAdvice:
+            posixAdvice = MADV_WILLNEED;
+            break;
+        case kDontNeed_SkFILE_MemoryAdvice:
+            // The mapping is PROT_READ MAP_PRIVATE of a file, so dropped pages
+            // are simply refetched from the file on the next touch.
+            posixAdvice = MADV_DONTNEED;
+            break;
+        default:
+            return false;
+    }
+
+    // madvise() requires a page-aligned address; widen the range to cover the
+    // pages the caller's range touches.
+    const uintptr_t pageMask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+    const uintptr_t start = reinterpret_cast<uintptr_t>(addr) & ~pageMask;
+    length += reinterpret_cast<uintptr_t>(addr) - start;
+
+    return 0 == madvise(reinterpret_cast<void*>(start), length, posixAdvice);
+}
+
 int sk_fileno(SkFILE* f) {
     return fileno((FILE*)f);
 }
@@ -108,6 +108,11 @@ void* sk_fdmmap(int fileno, size_t* length) {
     return addr;
 }
 
+bool sk_fmadvise(const void*, size_t, SkFILE_MemoryAdvice) {
+    // Views mapped with MapViewOfFile offer no madvise() analogue.
+    return false;
+}
+
 int sk_fileno(SkFILE* f) {
     return _fileno((FILE*)f);
 }
@@ -12,6 +12,10 @@
 #include <sys/time.h>
 #include <time.h>
 
+#if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    #include <mach/mach_time.h>
+#endif
+
 void SkTime::GetDateTime(DateTime* dt)
 {
     if (dt)
@@ -41,3 +45,20 @@ SkMSec SkTime::GetMSecs()
     gettimeofday(&tv, NULL);
     return (SkMSec) (tv.tv_sec * 1000 + tv.tv_usec / 1000 ); // microseconds to milliseconds
 }
+
+double SkTime::GetNSecs()
+{
+#if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    // clock_gettime() is not available on Mac/iOS; mach_absolute_time() is
+    // the monotonic counter there.
+    static mach_timebase_info_data_t gTimebase;
+    if (0 == gTimebase.denom) {
+        (void)mach_timebase_info(&gTimebase);
+    }
+    return (double)mach_absolute_time() * gTimebase.numer / gTimebase.denom;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
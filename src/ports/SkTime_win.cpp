@@ -50,3 +50,16 @@ SkMSec SkTime::GetMSecs()
     __int64 t  = li.QuadPart;       /* In 100-nanosecond intervals */
     return (SkMSec)(t / 10000);               /* In milliseconds */
 }
+
+double SkTime::GetNSecs()
+{
+    static double gNSecsPerTick;
+    if (0 == gNSecsPerTick) {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        gNSecsPerTick = 1e9 / (double)freq.QuadPart;
+    }
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * gNSecsPerTick;
+}
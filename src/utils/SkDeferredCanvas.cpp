@@ -11,6 +11,7 @@
 #include "SkBitmapDevice.h"
 #include "SkChunkAlloc.h"
 #include "SkColorFilter.h"
+#include "SkCondVar.h"
 #include "SkDrawFilter.h"
 #include "SkGPipe.h"
 #include "SkPaint.h"
@@ -18,6 +19,7 @@
 #include "SkRRect.h"
 #include "SkShader.h"
 #include "SkSurface.h"
+#include "SkThreadUtils.h"
 
 enum {
     // Deferred canvas will auto-flush when recording reaches this limit
@@ -25,6 +27,14 @@ enum {
     kDeferredCanvasBitmapSizeThreshold = ~0U, // Disables this feature
 
     kNoSaveLayerIndex = -1,
+
+    // With asynchronous playback, the recording thread blocks when this many
+    // chunks are waiting to be played back, to bound memory consumption.
+    kMaxQueuedPlaybackChunks = 4,
+    // With asynchronous playback, accumulated commands are handed off to the
+    // playback thread once they reach this size, so that playback overlaps
+    // with the recording of the remainder of the frame.
+    kAsyncHandOffStorageBytes = 256*1024,
 };
 
 enum PlaybackMode {
@@ -79,6 +89,25 @@ static bool should_draw_immediately(const SkBitmap* bitmap, const SkImage* image
 // DeferredPipeController
 //-----------------------------------------------------------------------------
 
+struct PipeBlock {
+    PipeBlock(void* block, size_t size) { fBlock = block, fSize = size; }
+    void* fBlock;
+    size_t fSize;
+};
+
+// A detached run of recorded commands, ready to be played back out of line on
+// the playback thread.  Owns its backing storage.
+struct PlaybackChunk {
+    explicit PlaybackChunk(SkChunkAlloc* allocator)
+        : fAllocator(allocator)
+        , fSilent(false) {}
+    ~PlaybackChunk() { SkDELETE(fAllocator); }
+
+    SkChunkAlloc* fAllocator;
+    SkTDArray<PipeBlock> fBlockList;
+    bool fSilent; // overdraw-eliminated: replay state without drawing
+};
+
 class DeferredPipeController : public SkGPipeController {
 public:
     DeferredPipeController();
@@ -87,32 +116,29 @@ public:
     void* requestBlock(size_t minRequest, size_t* actual) override;
     void notifyWritten(size_t bytes) override;
     void playback(bool silent);
-    bool hasPendingCommands() const { return fAllocator.totalUsed() != 0; }
-    size_t storageAllocatedForRecording() const { return fAllocator.totalCapacity(); }
+    PlaybackChunk* detachChunk();
+    void playbackChunk(PlaybackChunk*);
+    bool hasPendingCommands() const { return fAllocator->totalUsed() != 0; }
+    size_t storageAllocatedForRecording() const { return fAllocator->totalCapacity(); }
 private:
     enum {
         kMinBlockSize = 4096
     };
-    struct PipeBlock {
-        PipeBlock(void* block, size_t size) { fBlock = block, fSize = size; }
-        void* fBlock;
-        size_t fSize;
-    };
     void* fBlock;
     size_t fBytesWritten;
-    SkChunkAlloc fAllocator;
+    SkChunkAlloc* fAllocator;
     SkTDArray<PipeBlock> fBlockList;
     SkGPipeReader fReader;
 };
 
-DeferredPipeController::DeferredPipeController() :
-    fAllocator(kMinBlockSize) {
+DeferredPipeController::DeferredPipeController() {
     fBlock = NULL;
     fBytesWritten = 0;
+    fAllocator = SkNEW_ARGS(SkChunkAlloc, (kMinBlockSize));
 }
 
 DeferredPipeController::~DeferredPipeController() {
-    fAllocator.reset();
+    SkDELETE(fAllocator);
 }
 
 void DeferredPipeController::setPlaybackCanvas(SkCanvas* canvas) {
@@ -126,7 +152,7 @@ void* DeferredPipeController::requestBlock(size_t minRequest, size_t *actual) {
         fBlockList.push(previousBloc);
     }
     size_t blockSize = SkTMax<size_t>(minRequest, kMinBlockSize);
-    fBlock = fAllocator.allocThrow(blockSize);
+    fBlock = fAllocator->allocThrow(blockSize);
     fBytesWritten = 0;
     *actual = blockSize;
     return fBlock;
@@ -150,7 +176,34 @@ void DeferredPipeController::playback(bool silent) {
     }
 
     // Release all allocated blocks
-    fAllocator.reset();
+    fAllocator->reset();
+}
+
+PlaybackChunk* DeferredPipeController::detachChunk() {
+    if (!this->hasPendingCommands()) {
+        return NULL;
+    }
+    PlaybackChunk* chunk = SkNEW_ARGS(PlaybackChunk, (fAllocator));
+    chunk->fBlockList.swap(fBlockList);
+    if (fBlock) {
+        PipeBlock lastBlock(fBlock, fBytesWritten);
+        chunk->fBlockList.push(lastBlock);
+        fBlock = NULL;
+        fBytesWritten = 0;
+    }
+    // Recording continues into a fresh allocator; the chunk now owns the
+    // old one and releases it when playback completes.
+    fAllocator = SkNEW_ARGS(SkChunkAlloc, (kMinBlockSize));
+    return chunk;
+}
+
+void DeferredPipeController::playbackChunk(PlaybackChunk* chunk) {
+    uint32_t flags = chunk->fSilent ? SkGPipeReader::kSilent_PlaybackFlag : 0;
+    for (int currentBlock = 0; currentBlock < chunk->fBlockList.count(); currentBlock++) {
+        fReader.playback(chunk->fBlockList[currentBlock].fBlock,
+                         chunk->fBlockList[currentBlock].fSize, flags);
+    }
+    SkDELETE(chunk);
 }
 
 //-----------------------------------------------------------------------------
@@ -176,6 +229,8 @@ public:
     void setMaxRecordingStorage(size_t);
     void recordedDrawCommand();
     void setIsDrawingToLayer(bool value) {fIsDrawingToLayer = value;}
+    bool setAsyncPlayback(bool enable);
+    bool asyncPlayback() const { return NULL != fPlaybackThread; }
 
     SkImageInfo imageInfo() const override;
 
@@ -272,6 +327,16 @@ private:
     void aboutToDraw();
     void prepareForImmediatePixelWrite();
 
+    // Asynchronous playback plumbing. The chunk queue, fPlaybackBusy and
+    // fQuitPlayback are guarded by fQueueCondVar.
+    static void PlaybackThreadProc(void* arg);
+    void playbackLoop();
+    void handOffPendingCommands(PlaybackMode);
+    void enqueueChunk(bool silent);
+    void markQueuedChunksSilent();
+    void drainPlayback();
+    void stopPlaybackThread();
+
     DeferredPipeController fPipeController;
     SkGPipeWriter  fPipeWriter;
     SkCanvas* fImmediateCanvas;
@@ -283,6 +348,12 @@ private:
     bool fIsDrawingToLayer;
     size_t fMaxRecordingStorageBytes;
     size_t fPreviousStorageAllocated;
+
+    SkThread* fPlaybackThread;
+    SkCondVar* fQueueCondVar;
+    SkTDArray<PlaybackChunk*> fChunkQueue;
+    bool fPlaybackBusy;
+    bool fQuitPlayback;
 };
 
 SkDeferredDevice::SkDeferredDevice(SkSurface* surface) {
@@ -290,11 +361,20 @@ SkDeferredDevice::SkDeferredDevice(SkSurface* surface) {
     fNotificationClient = NULL;
     fImmediateCanvas = NULL;
     fSurface = NULL;
+    fPlaybackThread = NULL;
+    fQueueCondVar = NULL;
+    fPlaybackBusy = false;
+    fQuitPlayback = false;
     this->setSurface(surface);
     this->init();
 }
 
 void SkDeferredDevice::setSurface(SkSurface* surface) {
+    if (this->asyncPlayback()) {
+        // The playback thread draws into the old surface through the pipe
+        // reader; let it finish before swapping the canvas out from under it.
+        this->drainPlayback();
+    }
     SkRefCnt_SafeAssign(fImmediateCanvas, surface->getCanvas());
     SkRefCnt_SafeAssign(fSurface, surface);
     fPipeController.setPlaybackCanvas(fImmediateCanvas);
@@ -313,6 +393,9 @@ void SkDeferredDevice::init() {
 
 SkDeferredDevice::~SkDeferredDevice() {
     this->flushPendingCommands(kSilent_PlaybackMode);
+    if (this->asyncPlayback()) {
+        this->stopPlaybackThread();
+    }
     SkSafeUnref(fImmediateCanvas);
     SkSafeUnref(fSurface);
 }
@@ -336,9 +419,16 @@ void SkDeferredDevice::setNotificationClient(
 void SkDeferredDevice::skipPendingCommands() {
     if (!fIsDrawingToLayer) {
         fCanDiscardCanvasContents = true;
+        if (this->asyncPlayback()) {
+            // The incoming frame covers the whole canvas: anything still
+            // waiting in the queue will never be visible, so demote it to
+            // silent playback.  The playback thread still replays the
+            // stream to keep the pipe reader's state consistent.
+            this->markQueuedChunksSilent();
+        }
         if (fPipeController.hasPendingCommands()) {
             fFreshFrame = true;
-            flushPendingCommands(kSilent_PlaybackMode);
+            this->handOffPendingCommands(kSilent_PlaybackMode);
         }
     }
 }
@@ -367,6 +457,16 @@ void SkDeferredDevice::aboutToDraw()
 }
 
 void SkDeferredDevice::flushPendingCommands(PlaybackMode playbackMode) {
+    if (this->asyncPlayback()) {
+        // Hand off whatever has been recorded, then wait for the playback
+        // thread to catch up: callers of this method need the immediate
+        // canvas to be up to date (readbacks, going live, ...).
+        this->handOffPendingCommands(playbackMode);
+        if (kNormal_PlaybackMode == playbackMode) {
+            this->drainPlayback();
+        }
+        return;
+    }
     if (!fPipeController.hasPendingCommands()) {
         return;
     }
@@ -387,11 +487,150 @@ void SkDeferredDevice::flushPendingCommands(PlaybackMode playbackMode) {
 }
 
 void SkDeferredDevice::flush() {
+    if (this->asyncPlayback()) {
+        // Hand the frame off without waiting for it to land; operations that
+        // read the surface back drain the queue first.
+        this->handOffPendingCommands(kNormal_PlaybackMode);
+        return;
+    }
     this->flushPendingCommands(kNormal_PlaybackMode);
     fImmediateCanvas->flush();
 }
 
+bool SkDeferredDevice::setAsyncPlayback(bool enable) {
+    if (enable == this->asyncPlayback()) {
+        return enable;
+    }
+    if (!enable) {
+        this->stopPlaybackThread();
+        return false;
+    }
+    if (!SkCondVar::Supported()) {
+        return false;
+    }
+    if (immediateDevice()->accessRenderTarget()) {
+        // GPU contexts are not usable from another thread.
+        return false;
+    }
+    fQueueCondVar = SkNEW(SkCondVar);
+    fQuitPlayback = false;
+    fPlaybackBusy = false;
+    fPlaybackThread = SkNEW_ARGS(SkThread, (PlaybackThreadProc, this));
+    if (!fPlaybackThread->start()) {
+        SkDELETE(fPlaybackThread);
+        fPlaybackThread = NULL;
+        SkDELETE(fQueueCondVar);
+        fQueueCondVar = NULL;
+        return false;
+    }
+    return true;
+}
+
+void SkDeferredDevice::PlaybackThreadProc(void* arg) {
+    static_cast<SkDeferredDevice*>(arg)->playbackLoop();
+}
+
+void SkDeferredDevice::playbackLoop() {
+    fQueueCondVar->lock();
+    for (;;) {
+        while (0 == fChunkQueue.count() && !fQuitPlayback) {
+            fQueueCondVar->wait();
+        }
+        if (0 == fChunkQueue.count()) {
+            break; // Told to quit, and nothing left to play back.
+        }
+        PlaybackChunk* chunk = fChunkQueue[0];
+        fChunkQueue.remove(0);
+        fPlaybackBusy = true;
+        bool silent = chunk->fSilent;
+        // Wake a recording thread that may be throttled on a full queue.
+        fQueueCondVar->broadcast();
+        fQueueCondVar->unlock();
+
+        fPipeController.playbackChunk(chunk);
+        if (fNotificationClient) {
+            if (silent) {
+                fNotificationClient->skippedPendingDrawCommands();
+            } else {
+                fNotificationClient->flushedDrawCommands();
+            }
+        }
+
+        fQueueCondVar->lock();
+        fPlaybackBusy = false;
+        fQueueCondVar->broadcast(); // Wake drainPlayback().
+    }
+    fQueueCondVar->unlock();
+}
+
+void SkDeferredDevice::handOffPendingCommands(PlaybackMode playbackMode) {
+    if (!this->asyncPlayback()) {
+        this->flushPendingCommands(playbackMode);
+        return;
+    }
+    if (!fPipeController.hasPendingCommands()) {
+        return;
+    }
+    if (kNormal_PlaybackMode == playbackMode) {
+        this->aboutToDraw();
+    }
+    fPipeWriter.flushRecording(true);
+    this->enqueueChunk(kSilent_PlaybackMode == playbackMode);
+    fPreviousStorageAllocated = storageAllocatedForRecording();
+}
+
+void SkDeferredDevice::enqueueChunk(bool silent) {
+    PlaybackChunk* chunk = fPipeController.detachChunk();
+    if (NULL == chunk) {
+        return;
+    }
+    chunk->fSilent = silent;
+    fQueueCondVar->lock();
+    while (fChunkQueue.count() >= kMaxQueuedPlaybackChunks) {
+        fQueueCondVar->wait();
+    }
+    *fChunkQueue.append() = chunk;
+    fQueueCondVar->broadcast();
+    fQueueCondVar->unlock();
+}
+
+void SkDeferredDevice::markQueuedChunksSilent() {
+    fQueueCondVar->lock();
+    for (int i = 0; i < fChunkQueue.count(); i++) {
+        fChunkQueue[i]->fSilent = true;
+    }
+    fQueueCondVar->unlock();
+}
+
+void SkDeferredDevice::drainPlayback() {
+    SkASSERT(this->asyncPlayback());
+    fQueueCondVar->lock();
+    while (fChunkQueue.count() > 0 || fPlaybackBusy) {
+        fQueueCondVar->wait();
+    }
+    fQueueCondVar->unlock();
+}
+
+void SkDeferredDevice::stopPlaybackThread() {
+    SkASSERT(this->asyncPlayback());
+    fQueueCondVar->lock();
+    fQuitPlayback = true;
+    fQueueCondVar->broadcast();
+    fQueueCondVar->unlock();
+    fPlaybackThread->join(); // Drains whatever is left in the queue.
+    SkASSERT(0 == fChunkQueue.count());
+    SkDELETE(fPlaybackThread);
+    fPlaybackThread = NULL;
+    SkDELETE(fQueueCondVar);
+    fQueueCondVar = NULL;
+}
+
 size_t SkDeferredDevice::freeMemoryIfPossible(size_t bytesToFree) {
+    if (this->asyncPlayback()) {
+        // The writer's purgeable resources (e.g. bitmap heap entries) may
+        // still be referenced by chunks waiting in the playback queue.
+        this->drainPlayback();
+    }
     size_t val = fPipeWriter.freeMemoryIfPossible(bytesToFree);
     fPreviousStorageAllocated = storageAllocatedForRecording();
     return val;
@@ -405,6 +644,15 @@ size_t SkDeferredDevice::storageAllocatedForRecording() const {
 void SkDeferredDevice::recordedDrawCommand() {
     size_t storageAllocated = this->storageAllocatedForRecording();
 
+    if (this->asyncPlayback()
+        && fPipeController.storageAllocatedForRecording() > kAsyncHandOffStorageBytes) {
+        // Keep the playback thread fed rather than batching up the whole
+        // frame; handing off also transfers the accumulated storage to the
+        // detached chunk, which is released once it has been played back.
+        this->handOffPendingCommands(kNormal_PlaybackMode);
+        storageAllocated = this->storageAllocatedForRecording();
+    }
+
     if (storageAllocated > fMaxRecordingStorageBytes) {
         // First, attempt to reduce cache without flushing
         size_t tryFree = storageAllocated - fMaxRecordingStorageBytes;
@@ -430,7 +678,10 @@ SkCanvas* SkDeferredDevice::recordingCanvas() {
 }
 
 SkImage* SkDeferredDevice::newImageSnapshot() {
-    this->flush();
+    // Not this->flush(): with asynchronous playback the snapshot must wait
+    // for queued chunks to land, which flushPendingCommands guarantees.
+    this->flushPendingCommands(kNormal_PlaybackMode);
+    fImmediateCanvas->flush();
     return fSurface ? fSurface->newImageSnapshot() : NULL;
 }
 
@@ -450,6 +701,11 @@ void SkDeferredDevice::prepareForImmediatePixelWrite() {
     if (fPipeController.hasPendingCommands()) {
         this->flushPendingCommands(kNormal_PlaybackMode);
     } else {
+        if (this->asyncPlayback()) {
+            // Nothing newly recorded, but queued chunks may still be in
+            // flight to the surface we are about to write to.
+            this->drainPlayback();
+        }
         bool mustNotifyDirectly = !fCanDiscardCanvasContents;
         this->aboutToDraw();
         if (mustNotifyDirectly) {
@@ -559,6 +815,11 @@ void SkDeferredCanvas::setMaxRecordingStorage(size_t maxStorage) {
     this->getDeferredDevice()->setMaxRecordingStorage(maxStorage);
 }
 
+bool SkDeferredCanvas::setAsyncPlayback(bool enable) {
+    this->validate();
+    return this->getDeferredDevice()->setAsyncPlayback(enable);
+}
+
 size_t SkDeferredCanvas::storageAllocatedForRecording() const {
     return this->getDeferredDevice()->storageAllocatedForRecording();
 }
@@ -921,6 +1182,13 @@ void SkDeferredCanvas::onDrawSprite(const SkBitmap& bitmap, int left, int top,
     this->recordedDrawCommand();
 }
 
+void SkDeferredCanvas::onDrawSpriteBatch(const SkBitmap& bitmap, const SkIRect src[],
+                                         const SkIPoint dst[], int count, const SkPaint* paint) {
+    AutoImmediateDrawIfNeeded autoDraw(*this, &bitmap, paint);
+    this->drawingCanvas()->drawSpriteBatch(bitmap, src, dst, count, paint);
+    this->recordedDrawCommand();
+}
+
 void SkDeferredCanvas::onDrawText(const void* text, size_t byteLength, SkScalar x, SkScalar y,
                                   const SkPaint& paint) {
     AutoImmediateDrawIfNeeded autoDraw(*this, &paint);
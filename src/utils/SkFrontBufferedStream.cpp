@@ -5,19 +5,25 @@
  * found in the LICENSE file.
  */
 
+#include "SkCondVar.h"
 #include "SkFrontBufferedStream.h"
 #include "SkStream.h"
 #include "SkTemplates.h"
+#include "SkThreadUtils.h"
 
 class FrontBufferedStream : public SkStreamRewindable {
 public:
     // Called by Create.
-    FrontBufferedStream(SkStream*, size_t bufferSize);
+    FrontBufferedStream(SkStream*, size_t bufferSize, size_t readAheadBytes);
+
+    virtual ~FrontBufferedStream();
 
     size_t read(void* buffer, size_t size) override;
 
     bool peek(void* buffer, size_t size) const override;
 
+    const void* peekBytes(size_t size) const override;
+
     bool isAtEnd() const override;
 
     bool rewind() override;
@@ -47,6 +53,39 @@ private:
     // NULL stream.
     SkAutoTMalloc<char>     fBuffer;
 
+    // Readahead state, guarded by fCondVar's mutex while the worker thread is
+    // alive. The worker is the only thread that touches fStream and the only
+    // writer of fBuffer at or beyond fBufferedSoFar. fBufferedSoFar only
+    // grows and fOffset is only written by the reading thread, so the
+    // occasional unlocked read of either can only see a stale (conservative)
+    // value, never a torn one.
+    const size_t             fReadAhead;
+    SkAutoTDelete<SkCondVar> fCondVar;
+    SkAutoTDelete<SkThread>  fReadAheadThread;
+    // How far the reading thread needs fBufferedSoFar to reach; may exceed
+    // fOffset + fReadAhead for large reads.
+    size_t                   fWantedByReader;
+    bool                     fStopReadAhead;
+    // Set by the worker just before it exits its loop; once true the worker
+    // touches none of the shared state again.
+    bool                     fReadAheadDone;
+    // Set by the worker when the underlying stream returned zero bytes.
+    bool                     fStreamAtEnd;
+
+    static void ReadAheadMain(void*);
+    void readAheadLoop();
+
+    // Block until the next size bytes are buffered (or the underlying stream
+    // is exhausted). If the read will extend past the buffer, stops the
+    // worker so the caller regains exclusive use of fStream.
+    void waitForReadAhead(size_t size);
+
+    // Wake the worker so it tops the buffer back up to fOffset + fReadAhead.
+    void pokeReadAhead();
+
+    // Ask the worker to exit and join it. Safe to call when it never started.
+    void stopReadAhead();
+
     // Read up to size bytes from already buffered data, and copy to
     // dst, if non-NULL. Updates fOffset. Assumes that fOffset is less
     // than fBufferedSoFar.
@@ -65,21 +104,109 @@ private:
     typedef SkStream INHERITED;
 };
 
-SkStreamRewindable* SkFrontBufferedStream::Create(SkStream* stream, size_t bufferSize) {
+SkStreamRewindable* SkFrontBufferedStream::Create(SkStream* stream, size_t bufferSize,
+                                                  size_t readAheadBytes) {
     if (NULL == stream) {
         return NULL;
     }
-    return SkNEW_ARGS(FrontBufferedStream, (stream, bufferSize));
+    return SkNEW_ARGS(FrontBufferedStream, (stream, bufferSize, readAheadBytes));
 }
 
-FrontBufferedStream::FrontBufferedStream(SkStream* stream, size_t bufferSize)
+FrontBufferedStream::FrontBufferedStream(SkStream* stream, size_t bufferSize,
+                                         size_t readAheadBytes)
     : fStream(stream)
     , fHasLength(stream->hasPosition() && stream->hasLength())
     , fLength(stream->getLength() - stream->getPosition())
     , fOffset(0)
     , fBufferedSoFar(0)
     , fBufferSize(bufferSize)
-    , fBuffer(bufferSize) {}
+    , fBuffer(bufferSize)
+    , fReadAhead(SkTMin(readAheadBytes, bufferSize))
+    , fWantedByReader(0)
+    , fStopReadAhead(false)
+    , fReadAheadDone(false)
+    , fStreamAtEnd(false) {
+    if (fReadAhead > 0 && SkCondVar::Supported()) {
+        fCondVar.reset(SkNEW(SkCondVar));
+        fReadAheadThread.reset(SkNEW_ARGS(SkThread, (ReadAheadMain, this)));
+        if (!fReadAheadThread->start()) {
+            fReadAheadThread.free();
+            fCondVar.free();
+        }
+    }
+}
+
+FrontBufferedStream::~FrontBufferedStream() {
+    this->stopReadAhead();
+}
+
+void FrontBufferedStream::ReadAheadMain(void* arg) {
+    static_cast<FrontBufferedStream*>(arg)->readAheadLoop();
+}
+
+void FrontBufferedStream::readAheadLoop() {
+    fCondVar->lock();
+    while (!fStopReadAhead && !fStreamAtEnd && fBufferedSoFar < fBufferSize) {
+        const size_t target = SkTMin(SkTMax(fOffset + fReadAhead, fWantedByReader), fBufferSize);
+        if (fBufferedSoFar >= target) {
+            fCondVar->wait();
+            continue;
+        }
+        const size_t start = fBufferedSoFar;
+        const size_t bytesToRead = target - start;
+        // Drop the lock while blocked on the underlying stream, so the
+        // reading thread can consume already buffered data in parallel.
+        fCondVar->unlock();
+        const size_t bytes = fStream->read(fBuffer + start, bytesToRead);
+        fCondVar->lock();
+        fBufferedSoFar = start + bytes;
+        if (0 == bytes) {
+            fStreamAtEnd = true;
+        }
+        fCondVar->broadcast();
+    }
+    fReadAheadDone = true;
+    fCondVar->broadcast();
+    fCondVar->unlock();
+}
+
+void FrontBufferedStream::waitForReadAhead(size_t size) {
+    SkASSERT(fReadAheadThread.get());
+    const size_t wantEnd = SkTMin(fOffset + size, fBufferSize);
+    fCondVar->lock();
+    fWantedByReader = wantEnd;
+    while (!fReadAheadDone && fBufferedSoFar < wantEnd) {
+        fCondVar->broadcast();
+        fCondVar->wait();
+    }
+    fCondVar->unlock();
+    if (fOffset + size > fBufferSize) {
+        // About to read past what the buffer can ever hold; take back
+        // exclusive use of fStream before reading from it directly.
+        this->stopReadAhead();
+    }
+}
+
+void FrontBufferedStream::pokeReadAhead() {
+    if (fReadAheadThread.get()) {
+        fCondVar->lock();
+        fWantedByReader = 0;
+        fCondVar->broadcast();
+        fCondVar->unlock();
+    }
+}
+
+void FrontBufferedStream::stopReadAhead() {
+    if (NULL == fReadAheadThread.get()) {
+        return;
+    }
+    fCondVar->lock();
+    fStopReadAhead = true;
+    fCondVar->broadcast();
+    fCondVar->unlock();
+    fReadAheadThread->join();
+    fReadAheadThread.free();
+}
 
 bool FrontBufferedStream::isAtEnd() const {
     if (fOffset < fBufferedSoFar) {
@@ -88,6 +215,28 @@ bool FrontBufferedStream::isAtEnd() const {
         return false;
     }
 
+    if (fReadAheadThread.get()) {
+        // Only the worker may touch fStream while it runs; it publishes what
+        // it learns through fBufferedSoFar and fStreamAtEnd.
+        FrontBufferedStream* nonConstThis = const_cast<FrontBufferedStream*>(this);
+        nonConstThis->fCondVar->lock();
+        while (!fReadAheadDone && fBufferedSoFar <= fOffset) {
+            nonConstThis->fCondVar->broadcast();
+            nonConstThis->fCondVar->wait();
+        }
+        bool atEnd;
+        if (fBufferedSoFar > fOffset) {
+            atEnd = false;
+        } else if (fStreamAtEnd) {
+            atEnd = true;
+        } else {
+            // The worker is done (buffer full), so fStream is safe to query.
+            atEnd = fStream->isAtEnd();
+        }
+        nonConstThis->fCondVar->unlock();
+        return atEnd;
+    }
+
     return fStream->isAtEnd();
 }
 
@@ -95,6 +244,7 @@ bool FrontBufferedStream::rewind() {
     // Only allow a rewind if we have not exceeded the buffer.
     if (fOffset <= fBufferSize) {
         fOffset = 0;
+        this->pokeReadAhead();
         return true;
     }
     return false;
@@ -157,17 +307,36 @@ size_t FrontBufferedStream::readDirectlyFromStream(char* dst, size_t size) {
     return bytesReadDirectly;
 }
 
-bool FrontBufferedStream::peek(void* dst, size_t size) const {
-    // Keep track of the offset so we can return to it.
+const void* FrontBufferedStream::peekBytes(size_t size) const {
+    if (NULL == fBuffer.get()) {
+        // A read has gone past the buffer, so the data is no longer held here.
+        return NULL;
+    }
     const size_t start = fOffset;
     if (start + size > fBufferSize) {
         // This stream is not able to buffer enough.
+        return NULL;
+    }
+    if (fBufferedSoFar < start + size) {
+        // Pull the bytes into the buffer (a skip-style read), then restore
+        // the offset so the stream appears untouched.
+        FrontBufferedStream* nonConstThis = const_cast<FrontBufferedStream*>(this);
+        const size_t bytesRead = nonConstThis->read(NULL, size);
+        nonConstThis->fOffset = start;
+        if (bytesRead < size) {
+            return NULL;
+        }
+    }
+    return fBuffer + start;
+}
+
+bool FrontBufferedStream::peek(void* dst, size_t size) const {
+    SkASSERT(dst != NULL);
+    const void* bytes = this->peekBytes(size);
+    if (NULL == bytes) {
         return false;
     }
-    FrontBufferedStream* nonConstThis = const_cast<FrontBufferedStream*>(this);
-    SkDEBUGCODE(const size_t bytesRead =) nonConstThis->read(dst, size);
-    SkASSERT(bytesRead == size);
-    nonConstThis->fOffset = start;
+    memcpy(dst, bytes, size);
     return true;
 }
 
@@ -177,6 +346,10 @@ size_t FrontBufferedStream::read(void* voidDst, size_t size) {
     SkDEBUGCODE(const size_t totalSize = size;)
     const size_t start = fOffset;
 
+    if (fReadAheadThread.get()) {
+        this->waitForReadAhead(size);
+    }
+
     // First, read any data that was previously buffered.
     if (fOffset < fBufferedSoFar) {
         const size_t bytesCopied = this->readFromBuffer(dst, size);
@@ -210,5 +383,7 @@ size_t FrontBufferedStream::read(void* voidDst, size_t size) {
         SkASSERT(size + (fOffset - start) == totalSize);
     }
 
+    this->pokeReadAhead();
+
     return fOffset - start;
 }
@@ -251,53 +251,6 @@ void SkNinePatch::DrawMesh(SkCanvas* canvas, const SkRect& bounds,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static void drawNineViaRects(SkCanvas* canvas, const SkRect& dst,
-                             const SkBitmap& bitmap, const SkIRect& margins,
-                             const SkPaint* paint) {
-    const int32_t srcX[4] = {
-        0, margins.fLeft, bitmap.width() - margins.fRight, bitmap.width()
-    };
-    const int32_t srcY[4] = {
-        0, margins.fTop, bitmap.height() - margins.fBottom, bitmap.height()
-    };
-    SkScalar dstX[4] = {
-        dst.fLeft, dst.fLeft + SkIntToScalar(margins.fLeft),
-        dst.fRight - SkIntToScalar(margins.fRight), dst.fRight
-    };
-    SkScalar dstY[4] = {
-        dst.fTop, dst.fTop + SkIntToScalar(margins.fTop),
-        dst.fBottom - SkIntToScalar(margins.fBottom), dst.fBottom
-    };
-
-    if (dstX[1] > dstX[2]) {
-        dstX[1] = dstX[0] + (dstX[3] - dstX[0]) * SkIntToScalar(margins.fLeft) /
-            (SkIntToScalar(margins.fLeft) + SkIntToScalar(margins.fRight));
-        dstX[2] = dstX[1];
-    }
-
-    if (dstY[1] > dstY[2]) {
-        dstY[1] = dstY[0] + (dstY[3] - dstY[0]) * SkIntToScalar(margins.fTop) /
-            (SkIntToScalar(margins.fTop) + SkIntToScalar(margins.fBottom));
-        dstY[2] = dstY[1];
-    }
-
-    SkIRect s;
-    SkRect  d;
-    for (int y = 0; y < 3; y++) {
-        s.fTop = srcY[y];
-        s.fBottom = srcY[y+1];
-        d.fTop = dstY[y];
-        d.fBottom = dstY[y+1];
-        for (int x = 0; x < 3; x++) {
-            s.fLeft = srcX[x];
-            s.fRight = srcX[x+1];
-            d.fLeft = dstX[x];
-            d.fRight = dstX[x+1];
-            canvas->drawBitmapRect(bitmap, &s, d, paint);
-        }
-    }
-}
-
 void SkNinePatch::DrawNine(SkCanvas* canvas, const SkRect& bounds,
                            const SkBitmap& bitmap, const SkIRect& margins,
                            const SkPaint* paint) {
@@ -330,6 +283,11 @@ void SkNinePatch::DrawNine(SkCanvas* canvas, const SkRect& bounds,
         SkNinePatch::DrawMesh(canvas, bounds, bitmap,
                               xDivs, 2, yDivs, 2, paint);
     } else {
-        drawNineViaRects(canvas, bounds, bitmap, margins, paint);
+        // One canvas op: records as a single DrawBitmapNine and lets the
+        // raster backend blit all nine patches with one state setup.
+        const SkIRect center = SkIRect::MakeLTRB(margins.fLeft, margins.fTop,
+                                                 bitmap.width() - margins.fRight,
+                                                 bitmap.height() - margins.fBottom);
+        canvas->drawBitmapNine(bitmap, center, bounds, paint);
     }
 }
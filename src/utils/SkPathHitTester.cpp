@@ -0,0 +1,257 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPathHitTester.h"
+
+#include "SkChecksum.h"
+#include "SkGeometry.h"
+#include "SkPath.h"
+#include "SkRTree.h"
+#include "SkTSort.h"
+#include "SkTemplates.h"
+
+// Curves are flattened until the chord deviation drops below this, so a hit test can disagree
+// with SkPath::contains() only within this distance of a curved edge.
+static const SkScalar kFlattenTol = SK_Scalar1 / 4;
+
+static int compute_segments(SkScalar controlLen) {
+    // The max deviation of an n-piece flattening of a quad is about len/(8*n^2); solve for
+    // deviation <= kFlattenTol. Cubics reuse this as a (slightly loose) estimate.
+    SkScalar n = SkScalarSqrt(controlLen / (8 * kFlattenTol));
+    return SkTMax(1, SkTMin(64, SkScalarCeilToInt(n)));
+}
+
+/**
+ *  The per-path acceleration record: the path flattened into line segments, plus the bits of
+ *  path state a crossing count needs. Tables are shared (and reference counted) across every
+ *  tester entry with the same generation ID.
+ */
+class SkPathHitTester::CrossingTable : public SkRefCnt {
+public:
+    static CrossingTable* Create(const SkPath& path);
+
+    // SkTDynamicHash interface
+    static const uint32_t& GetKey(const CrossingTable& table) { return table.fGenID; }
+    static uint32_t Hash(const uint32_t& genID) { return SkChecksum::Mix(genID); }
+
+    const SkRect& bounds() const { return fBounds; }
+    bool isInverseFillType() const { return fInverse; }
+
+    bool contains(SkScalar x, SkScalar y) const {
+        if (!fInverse && !(fBounds.fLeft <= x && x < fBounds.fRight &&
+                           fBounds.fTop <= y && y < fBounds.fBottom)) {
+            return false;
+        }
+        int winding = 0;
+        const SkPoint* pts = fPts.begin();
+        for (int i = 0; i < fPts.count(); i += 2) {
+            const SkPoint& p0 = pts[i];
+            const SkPoint& p1 = pts[i + 1];
+            if ((p0.fY > y) == (p1.fY > y)) {
+                continue;   // the ray from (x,y) towards +x cannot cross this segment
+            }
+            SkScalar xint = p0.fX + (y - p0.fY) * (p1.fX - p0.fX) / (p1.fY - p0.fY);
+            if (x < xint) {
+                winding += (p1.fY > p0.fY) ? 1 : -1;
+            }
+        }
+        bool inside = fEvenOdd ? SkToBool(winding & 1) : (0 != winding);
+        return fInverse ? !inside : inside;
+    }
+
+private:
+    CrossingTable(uint32_t genID) : fGenID(genID) {}
+
+    void appendSegment(const SkPoint& p0, const SkPoint& p1) {
+        if (p0.fY == p1.fY) {
+            return;     // horizontal segments can never cross the test ray
+        }
+        *fPts.append() = p0;
+        *fPts.append() = p1;
+    }
+
+    void appendQuad(const SkPoint quad[3]) {
+        int n = compute_segments(SkPoint::Distance(quad[0], quad[1]) +
+                                 SkPoint::Distance(quad[1], quad[2]));
+        SkAutoSTArray<64, SkScalar> ts(n);
+        SkAutoSTArray<64, SkPoint> flat(n);
+        for (int i = 0; i < n; ++i) {
+            ts[i] = SkIntToScalar(i + 1) / n;
+        }
+        SkEvalQuadAts(quad, ts.get(), n, flat.get());
+        SkPoint prev = quad[0];
+        for (int i = 0; i < n; ++i) {
+            this->appendSegment(prev, flat[i]);
+            prev = flat[i];
+        }
+    }
+
+    void appendCubic(const SkPoint cubic[4]) {
+        int n = compute_segments(SkPoint::Distance(cubic[0], cubic[1]) +
+                                 SkPoint::Distance(cubic[1], cubic[2]) +
+                                 SkPoint::Distance(cubic[2], cubic[3]));
+        SkAutoSTArray<64, SkScalar> ts(n);
+        SkAutoSTArray<64, SkPoint> flat(n);
+        for (int i = 0; i < n; ++i) {
+            ts[i] = SkIntToScalar(i + 1) / n;
+        }
+        SkEvalCubicAts(cubic, ts.get(), n, flat.get());
+        SkPoint prev = cubic[0];
+        for (int i = 0; i < n; ++i) {
+            this->appendSegment(prev, flat[i]);
+            prev = flat[i];
+        }
+    }
+
+    uint32_t            fGenID;
+    SkRect              fBounds;
+    bool                fEvenOdd;
+    bool                fInverse;
+    SkTDArray<SkPoint>  fPts;       // segment endpoint pairs: (fPts[2i], fPts[2i+1])
+
+    typedef SkRefCnt INHERITED;
+};
+
+SkPathHitTester::CrossingTable* SkPathHitTester::CrossingTable::Create(const SkPath& path) {
+    CrossingTable* table = SkNEW_ARGS(CrossingTable, (path.getGenerationID()));
+    table->fBounds = path.getBounds();
+    SkPath::FillType ft = path.getFillType();
+    table->fEvenOdd = SkPath::kEvenOdd_FillType == ft || SkPath::kInverseEvenOdd_FillType == ft;
+    table->fInverse = path.isInverseFillType();
+
+    // forceClose so open contours hit-test the same way the scan converter fills them.
+    SkPath::Iter iter(path, true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kLine_Verb:
+                table->appendSegment(pts[0], pts[1]);
+                break;
+            case SkPath::kQuad_Verb:
+                table->appendQuad(pts);
+                break;
+            case SkPath::kConic_Verb: {
+                SkAutoConicToQuads quadder;
+                const SkPoint* quads = quadder.computeQuads(pts, iter.conicWeight(),
+                                                            kFlattenTol);
+                for (int i = 0; i < quadder.countQuads(); ++i) {
+                    table->appendQuad(&quads[i * 2]);
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb:
+                table->appendCubic(pts);
+                break;
+            default:
+                break;
+        }
+    }
+    return table;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkPathHitTester::SkPathHitTester() : fTree(NULL), fTreeDirty(false) {}
+
+SkPathHitTester::~SkPathHitTester() {
+    this->reset();
+    SkSafeUnref(fTree);
+}
+
+void SkPathHitTester::reset() {
+    SkTDynamicHash<CrossingTable, uint32_t>::Iter iter(&fTables);
+    while (!iter.done()) {
+        CrossingTable* table = &*iter;
+        ++iter;
+        table->unref();
+    }
+    fTables.reset();
+    fRecs.rewind();
+    fTreeRecs.rewind();
+    fAlwaysTest.rewind();
+    fTreeDirty = false;
+    if (fTree) {
+        fTree->reset();
+    }
+}
+
+int SkPathHitTester::addPath(const SkPath& path) {
+    uint32_t genID = path.getGenerationID();
+    CrossingTable* table = fTables.find(genID);
+    if (NULL == table) {
+        table = CrossingTable::Create(path);
+        fTables.add(table);     // the hash keeps the creation ref
+    }
+    *fRecs.append() = table;
+    fTreeDirty = true;
+    return fRecs.count() - 1;
+}
+
+void SkPathHitTester::updateTree() const {
+    if (!fTreeDirty) {
+        return;
+    }
+    fTreeDirty = false;
+    fTreeRecs.rewind();
+    fAlwaysTest.rewind();
+    SkTDArray<SkRect> bounds;
+    for (int i = 0; i < fRecs.count(); ++i) {
+        if (fRecs[i]->isInverseFillType()) {
+            *fAlwaysTest.append() = i;
+        } else {
+            *fTreeRecs.append() = i;
+            *bounds.append() = fRecs[i]->bounds();
+        }
+    }
+    if (NULL == fTree) {
+        fTree = SkNEW(SkRTree);
+    } else {
+        fTree->reset();
+    }
+    if (bounds.count()) {
+        fTree->insert(bounds.begin(), bounds.count());
+    }
+}
+
+void SkPathHitTester::hitTest(SkScalar x, SkScalar y, SkTDArray<int>* results) const {
+    SkASSERT(results);
+    this->updateTree();
+
+    if (fTreeRecs.count()) {
+        // SkRect::Intersects rejects empty rects, so query with a tiny box around the point.
+        const SkScalar dim = SK_ScalarNearlyZero;
+        SkTDArray<unsigned> hits;
+        fTree->search(SkRect::MakeLTRB(x - dim, y - dim, x + dim, y + dim), &hits);
+        for (int i = 0; i < hits.count(); ++i) {
+            int index = fTreeRecs[hits[i]];
+            if (fRecs[index]->contains(x, y)) {
+                *results->append() = index;
+            }
+        }
+    }
+    for (int i = 0; i < fAlwaysTest.count(); ++i) {
+        int index = fAlwaysTest[i];
+        if (fRecs[index]->contains(x, y)) {
+            *results->append() = index;
+        }
+    }
+    if (results->count() > 1) {
+        SkTQSort(results->begin(), results->end() - 1);
+    }
+}
+
+void SkPathHitTester::hitTest(const SkPoint pts[], int count, SkTDArray<int> results[]) const {
+    for (int i = 0; i < count; ++i) {
+        this->hitTest(pts[i].fX, pts[i].fY, &results[i]);
+    }
+}
+
+bool SkPathHitTester::pathContains(int index, SkScalar x, SkScalar y) const {
+    SkASSERT((unsigned)index < (unsigned)fRecs.count());
+    return fRecs[index]->contains(x, y);
+}
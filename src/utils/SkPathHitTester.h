@@ -0,0 +1,78 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPathHitTester_DEFINED
+#define SkPathHitTester_DEFINED
+
+#include "SkScalar.h"
+#include "SkTDArray.h"
+#include "SkTDynamicHash.h"
+
+class SkPath;
+class SkRTree;
+struct SkPoint;
+
+/**
+ *  Accelerates point-in-path queries against a large set of paths, e.g. hit-testing a pointer
+ *  event against every pickable shape in a scene.
+ *
+ *  SkPath::contains() walks the full verb array on every call, so testing one point against N
+ *  paths costs O(total verbs). SkPathHitTester instead flattens each path once into a table of
+ *  line segments (cached by the path's generation ID, so re-adding an unchanged path reuses the
+ *  table) and indexes the path bounds in an R-tree. A query then prunes to the few paths whose
+ *  bounds overlap the point and runs an even-odd/winding crossing count over the precomputed
+ *  segments.
+ *
+ *  Results match SkPath::contains() up to the curve flattening tolerance (a small fraction of a
+ *  unit; see kFlattenTol in the implementation), which is well inside a pixel for typical
+ *  device-space hit testing.
+ */
+class SkPathHitTester : SkNoncopyable {
+public:
+    SkPathHitTester();
+    ~SkPathHitTester();
+
+    /** The number of paths added since construction or the last reset(). */
+    int count() const { return fRecs.count(); }
+
+    /** Forget all added paths and their cached tables. */
+    void reset();
+
+    /**
+     *  Add a path to the set, returning the index that hitTest() will report for it. The path
+     *  is flattened immediately; paths sharing a generation ID share one cached table.
+     */
+    int addPath(const SkPath& path);
+
+    /** Append the index of every path containing (x,y) to results, in increasing order. */
+    void hitTest(SkScalar x, SkScalar y, SkTDArray<int>* results) const;
+
+    /**
+     *  Batch form: results must point to count arrays; results[i] receives the indices of the
+     *  paths containing pts[i], in increasing order.
+     */
+    void hitTest(const SkPoint pts[], int count, SkTDArray<int> results[]) const;
+
+    /** Test a single previously added path, without consulting the bounds tree. */
+    bool pathContains(int index, SkScalar x, SkScalar y) const;
+
+private:
+    class CrossingTable;
+
+    void updateTree() const;
+
+    SkTDArray<CrossingTable*>                   fRecs;      // borrowed from fTables
+    SkTDynamicHash<CrossingTable, uint32_t>     fTables;    // owns one ref per table
+
+    // Lazily rebuilt by updateTree() when queried after adds.
+    mutable SkRTree*        fTree;
+    mutable SkTDArray<int>  fTreeRecs;      // maps R-tree slots back to fRecs indices
+    mutable SkTDArray<int>  fAlwaysTest;    // inverse fills: bounds cannot prune these
+    mutable bool            fTreeDirty;
+};
+
+#endif
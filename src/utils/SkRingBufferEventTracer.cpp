@@ -0,0 +1,217 @@
+/*
+ * Copyright 2015 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkRingBufferEventTracer.h"
+
+#include "SkStream.h"
+#include "SkTLS.h"
+#include "SkTemplates.h"
+#include "SkTime.h"
+#include "SkTraceEvent.h"
+
+// The cheapest monotonic-ish counter we can read at each event.  The raw unit doesn't
+// matter: snapshot() rescales ticks to microseconds using two (ticks, wall-clock) pairs.
+static uint64_t now_ticks() {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    // 32-bit ARM can't read its cycle counter from user mode; fall back to the OS clock.
+    return (uint64_t)SkTime::GetNSecs();
+#endif
+}
+
+// SkTLS create procs don't get a context pointer, so the (single) installed tracer
+// parks itself here for CreateRing() to find.
+static SkRingBufferEventTracer* gActiveRingTracer = NULL;
+
+SkRingBufferEventTracer::SkRingBufferEventTracer(int eventsPerThread)
+    : fEventsPerThread(eventsPerThread)
+    , fBaseTicks(now_ticks())
+    , fBaseNSecs(SkTime::GetNSecs())
+    , fRings(NULL)
+    , fNextTid(0)
+    , fCategoryCount(0)
+    , fFilter("*") {
+    SkASSERT(NULL == gActiveRingTracer);
+    gActiveRingTracer = this;
+}
+
+SkRingBufferEventTracer::~SkRingBufferEventTracer() {
+    gActiveRingTracer = NULL;
+    Ring* ring = fRings;
+    while (ring) {
+        Ring* next = ring->fNext;
+        SkDELETE_ARRAY(ring->fEvents);
+        SkDELETE(ring);
+        ring = next;
+    }
+}
+
+void* SkRingBufferEventTracer::CreateRing() {
+    SkRingBufferEventTracer* tracer = gActiveRingTracer;
+    SkASSERT(tracer);
+
+    Ring* ring = SkNEW(Ring);
+    ring->fLock.release();   // SkPODSpinlock has no constructor; this zero-initializes it.
+    ring->fCursor = 0;
+    ring->fEvents = SkNEW_ARRAY(Event, tracer->fEventsPerThread);
+
+    // The tracer keeps every ring alive (and snapshottable) even after its thread exits,
+    // which is why we don't give SkTLS a delete proc.
+    SkAutoSpinlock lock(tracer->fRingsLock);
+    ring->fTid = tracer->fNextTid++;
+    ring->fNext = tracer->fRings;
+    tracer->fRings = ring;
+    return ring;
+}
+
+SkRingBufferEventTracer::Ring* SkRingBufferEventTracer::currentRing() {
+    return (Ring*)SkTLS::Get(CreateRing, NULL);
+}
+
+void SkRingBufferEventTracer::append(Ring* ring, char phase,
+                                     const uint8_t* categoryEnabledFlag, const char* name) {
+    // The only thread that ever writes this ring is us; the lock just keeps a
+    // concurrent snapshot() from reading a half-written event.
+    SkAutoSpinlock lock(ring->fLock);
+    Event* e = &ring->fEvents[ring->fCursor % fEventsPerThread];
+    e->fTicks = now_ticks();
+    e->fName = name;
+    e->fCategoryEnabled = categoryEnabledFlag;
+    e->fPhase = phase;
+    ring->fCursor += 1;
+}
+
+SkEventTracer::Handle
+SkRingBufferEventTracer::addTraceEvent(char phase,
+                                       const uint8_t* categoryEnabledFlag,
+                                       const char* name,
+                                       uint64_t id,
+                                       int32_t numArgs,
+                                       const char** argNames,
+                                       const uint8_t* argTypes,
+                                       const uint64_t* argValues,
+                                       uint8_t flags) {
+    if (!(*categoryEnabledFlag & kEnabledForRecording_CategoryGroupEnabledFlags)) {
+        return 0;
+    }
+    // Scoped events arrive as COMPLETE; we log them as a begin and let
+    // updateTraceEventDuration() log the matching end.  Arguments are dropped to keep
+    // the event record fixed-size.
+    if (TRACE_EVENT_PHASE_COMPLETE == phase) {
+        phase = TRACE_EVENT_PHASE_BEGIN;
+    }
+    this->append(this->currentRing(), phase, categoryEnabledFlag, name);
+    return 0;
+}
+
+void SkRingBufferEventTracer::updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                                       const char* name,
+                                                       SkEventTracer::Handle handle) {
+    if (!(*categoryEnabledFlag & kEnabledForRecording_CategoryGroupEnabledFlags)) {
+        return;
+    }
+    this->append(this->currentRing(), TRACE_EVENT_PHASE_END, categoryEnabledFlag, name);
+}
+
+bool SkRingBufferEventTracer::categoryPassesFilter(const char* name) const {
+    if (fFilter.equals("*")) {
+        return true;
+    }
+    const char* filter = fFilter.c_str();
+    while (*filter) {
+        const char* comma = strchr(filter, ',');
+        SkString token = comma ? SkString(filter, comma - filter) : SkString(filter);
+        if (!token.isEmpty() && strstr(name, token.c_str())) {
+            return true;
+        }
+        filter = comma ? comma + 1 : filter + strlen(filter);
+    }
+    return false;
+}
+
+const uint8_t* SkRingBufferEventTracer::getCategoryGroupEnabled(const char* name) {
+    SkAutoSpinlock lock(fCategoryLock);
+    for (int i = 0; i < fCategoryCount; i++) {
+        if (0 == strcmp(fCategories[i].fName, name)) {
+            return &fCategories[i].fEnabled;
+        }
+    }
+    if (fCategoryCount == kMaxCategories) {
+        static uint8_t gFull = 0;
+        return &gFull;
+    }
+    CategoryState* state = &fCategories[fCategoryCount++];
+    state->fName = name;   // always a string literal at the macro site
+    state->fEnabled = this->categoryPassesFilter(name)
+                              ? kEnabledForRecording_CategoryGroupEnabledFlags : 0;
+    return &state->fEnabled;
+}
+
+const char* SkRingBufferEventTracer::getCategoryGroupName(const uint8_t* categoryEnabledFlag) {
+    SkAutoSpinlock lock(fCategoryLock);
+    for (int i = 0; i < fCategoryCount; i++) {
+        if (categoryEnabledFlag == &fCategories[i].fEnabled) {
+            return fCategories[i].fName;
+        }
+    }
+    return "unknown";
+}
+
+void SkRingBufferEventTracer::setEnabledCategories(const char* categories) {
+    SkAutoSpinlock lock(fCategoryLock);
+    fFilter.set(categories);
+    for (int i = 0; i < fCategoryCount; i++) {
+        fCategories[i].fEnabled = this->categoryPassesFilter(fCategories[i].fName)
+                                          ? kEnabledForRecording_CategoryGroupEnabledFlags : 0;
+    }
+}
+
+void SkRingBufferEventTracer::snapshot(SkWStream* stream) {
+    // Rescale: two (ticks, wall-clock) pairs give us ticks-per-nanosecond.
+    const uint64_t nowTicks = now_ticks();
+    const double nowNSecs = SkTime::GetNSecs();
+    const double ticksPerNSec = (nowTicks > fBaseTicks && nowNSecs > fBaseNSecs)
+            ? (double)(nowTicks - fBaseTicks) / (nowNSecs - fBaseNSecs) : 1.0;
+
+    SkAutoTMalloc<Event> copy(fEventsPerThread);
+
+    stream->writeText("{\"traceEvents\":[");
+    bool first = true;
+    SkAutoSpinlock ringsLock(fRingsLock);
+    for (Ring* ring = fRings; ring; ring = ring->fNext) {
+        int count;
+        {
+            // Copy the ring out under its lock, then serialize at leisure.
+            SkAutoSpinlock lock(ring->fLock);
+            count = SkTMin(ring->fCursor, (uint32_t)fEventsPerThread);
+            const uint32_t start = ring->fCursor >= (uint32_t)fEventsPerThread
+                                           ? ring->fCursor % fEventsPerThread : 0;
+            for (int i = 0; i < count; i++) {
+                copy[i] = ring->fEvents[(start + i) % fEventsPerThread];
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            const Event& e = copy[i];
+            const double ts = (double)(e.fTicks - fBaseTicks) / ticksPerNSec / 1000.0;
+            SkString line;
+            line.printf("%s\n{\"ph\":\"%c\",\"name\":\"%s\",\"cat\":\"%s\","
+                        "\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                        first ? "" : ",", e.fPhase, e.fName,
+                        this->getCategoryGroupName(e.fCategoryEnabled), ts, ring->fTid);
+            stream->writeText(line.c_str());
+            first = false;
+        }
+    }
+    stream->writeText("\n]}\n");
+}
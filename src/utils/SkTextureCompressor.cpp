@@ -14,6 +14,8 @@
 #include "SkBitmapProcShader.h"
 #include "SkData.h"
 #include "SkEndian.h"
+#include "SkTaskGroup.h"
+#include "SkTDArray.h"
 
 #include "SkTextureCompression_opts.h"
 
@@ -119,6 +121,81 @@ int GetCompressedDataSize(Format fmt, int width, int height) {
     return -1;
 }
 
+namespace {
+
+// One horizontal band of whole block rows, compressed independently of the
+// other bands.
+struct CompressorBand {
+    CompressionProc fProc;
+    uint8_t*        fDst;
+    const uint8_t*  fSrc;
+    int             fWidth;
+    int             fHeight;
+    size_t          fRowBytes;
+    bool            fResult;
+};
+
+void compress_band(CompressorBand* band) {
+    band->fResult = band->fProc(band->fDst, band->fSrc, band->fWidth, band->fHeight,
+                                band->fRowBytes);
+}
+
+}  // namespace
+
+// Minimum pixel rows per band, so small images don't pay dispatch overhead
+// for bands that compress in microseconds anyway.
+static const int kMinBandHeight = 64;
+
+// Run proc over the image in bands of whole block rows, fanned out across
+// SkTaskGroup threads.  Blocks don't depend on each other and each band
+// writes a disjoint range of dst, so the bands are independent.  Falls back
+// to one synchronous call when the geometry doesn't split cleanly (or the
+// image is too small to be worth it); likewise, without an
+// SkTaskGroup::Enabler the bands just run serially on the calling thread.
+static bool compress_in_bands(CompressionProc proc, uint8_t* dst, const uint8_t* src,
+                              int width, int height, size_t rowBytes, Format format) {
+    int specX, specY;
+    GetBlockDimensions(format, &specX, &specY, true);
+    int dimX, dimY;
+    GetBlockDimensions(format, &dimX, &dimY);
+
+    // Band boundaries must land on whole spec block rows (for the dst offset
+    // math) and on the operable height of optimized procs.
+    const int bandUnit = SkTMax(dimY, specY);
+    if (height < 2 * SkTMax(bandUnit, kMinBandHeight) ||
+        0 != (width % specX) || 0 != (height % specY) ||
+        0 != (bandUnit % specY) || 0 != (height % bandUnit)) {
+        return proc(dst, src, width, height, rowBytes);
+    }
+
+    const int bytesPerBlockRow = GetCompressedDataSize(format, width, specY);
+    SkASSERT(bytesPerBlockRow > 0);
+
+    int rowsPerBand = SkTMax(kMinBandHeight, bandUnit);
+    rowsPerBand -= rowsPerBand % bandUnit;
+
+    SkTDArray<CompressorBand> bands;
+    for (int row = 0; row < height; row += rowsPerBand) {
+        CompressorBand* band = bands.append();
+        band->fProc = proc;
+        band->fDst = dst + (row / specY) * bytesPerBlockRow;
+        band->fSrc = src + row * rowBytes;
+        band->fWidth = width;
+        band->fHeight = SkTMin(rowsPerBand, height - row);
+        band->fRowBytes = rowBytes;
+        band->fResult = false;
+    }
+
+    SkTaskGroup().batch(compress_band, bands.begin(), bands.count());
+
+    for (int i = 0; i < bands.count(); i++) {
+        if (!bands[i].fResult) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool CompressBufferToFormat(uint8_t* dst, const uint8_t* src, SkColorType srcColorType,
                             int width, int height, size_t rowBytes, Format format, bool opt) {
     CompressionProc proc = NULL;
@@ -167,7 +244,7 @@ bool CompressBufferToFormat(uint8_t* dst, const uint8_t* src, SkColorType srcCol
     }
 
     if (proc) {
-        return proc(dst, src, width, height, rowBytes);
+        return compress_in_bands(proc, dst, src, width, height, rowBytes, format);
     }
 
     return false;
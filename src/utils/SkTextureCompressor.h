@@ -63,6 +63,9 @@ namespace SkTextureCompressor {
     // Compresses the given src data into dst. The src data is assumed to be
     // large enough to hold width*height pixels. The dst data is expected to
     // be large enough to hold the compressed data according to the format.
+    // Large images are split into bands of block rows that are compressed
+    // in parallel on SkTaskGroup threads when an SkTaskGroup::Enabler is
+    // active; otherwise everything runs on the calling thread as before.
     bool CompressBufferToFormat(uint8_t* dst, const uint8_t* src, SkColorType srcColorType,
                                 int width, int height, size_t rowBytes, Format format,
                                 bool opt = true /* Use optimization if available */);
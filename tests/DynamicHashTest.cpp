@@ -121,14 +121,14 @@ DEF_TEST(DynamicHash_remove, reporter) {
     hash.add(&a);
     hash.add(&b);
     hash.remove(1);
-    // a should be marked deleted, and b should still be findable.
+    // b should have been shifted back into a's old slot, and still be findable.
 
     ASSERT(hash.find(1) == NULL);
     ASSERT(hash.find(5) != NULL);
     ASSERT(hash.find(5)->value == 3.0);
 
-    // This will go in the same slot as 'a' did before.
-    ASSERT(hash.countCollisions(9) == 0);
+    // b now sits in 9's preferred slot, so this will go one step past it.
+    ASSERT(hash.countCollisions(9) == 1);
     hash.add(&c);
     ASSERT(hash.find(9) != NULL);
     ASSERT(hash.find(9)->value == 4.0);
@@ -43,6 +43,11 @@ static bool verify_query(SkRect query, SkRect rects[], SkTDArray<unsigned>& foun
     return found == expected;
 }
 
+static bool append_hit(unsigned opIndex, void* context) {
+    ((SkTDArray<unsigned>*)context)->push(opIndex);
+    return true;
+}
+
 static void run_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rects[],
                         const SkRTree& tree) {
     for (size_t i = 0; i < NUM_QUERIES; ++i) {
@@ -50,6 +55,11 @@ static void run_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rec
         SkRect query = random_rect(rand);
         tree.search(query, &hits);
         REPORTER_ASSERT(reporter, verify_query(query, rects, hits));
+
+        // the callback search must visit the same hits, in the same order
+        SkTDArray<unsigned> visited;
+        tree.search(query, append_hit, &visited);
+        REPORTER_ASSERT(reporter, visited == hits);
     }
 }
 
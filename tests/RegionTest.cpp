@@ -217,6 +217,21 @@ static bool test_rects(const SkIRect rect[], int count) {
     }
     rgn1.setRects(rect, count);
 
+    // bulk op with union(rects) must match the sequential ops; this holds
+    // for difference too, since A - r0 - r1 ... == A - union(rects).
+    SkRegion seqU, bulkU, seqD, bulkD;
+    seqU.setRect(0, 0, 40, 40);
+    bulkU = seqD = bulkD = seqU;
+    for (int i = 0; i < count; i++) {
+        seqU.op(rect[i], SkRegion::kUnion_Op);
+        seqD.op(rect[i], SkRegion::kDifference_Op);
+    }
+    bulkU.op(rect, count, SkRegion::kUnion_Op);
+    bulkD.op(rect, count, SkRegion::kDifference_Op);
+    if (seqU != bulkU || seqD != bulkD) {
+        return false;
+    }
+
     if (rgn0 != rgn1) {
         SkDebugf("\n");
         for (int i = 0; i < count; i++) {